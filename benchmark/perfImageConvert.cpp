@@ -0,0 +1,186 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the image conversions.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfImageConvert.cpp
+
+  \brief Benchmark of the color space and type conversions of vpImageConvert on
+  synthetic VGA and full HD images.
+*/
+
+#include <vector>
+
+#include <visp3/core/vpImageConvert.h>
+
+#include "vpBenchmark.h"
+
+namespace {
+  class vpRGBaToGrey : public vpBenchmarkCase
+  {
+  public:
+    vpRGBaToGrey(const unsigned int height, const unsigned int width)
+      : vpBenchmarkCase(caseName("RGBaToGrey", height, width)), m_src(), m_dst(height, width)
+    {
+      vpBenchmark::generateImage(m_src, height, width);
+    }
+    void run() { vpImageConvert::convert(m_src, m_dst); }
+
+  private:
+    vpImage<vpRGBa> m_src;
+    vpImage<unsigned char> m_dst;
+  };
+
+  class vpGreyToRGBa : public vpBenchmarkCase
+  {
+  public:
+    vpGreyToRGBa(const unsigned int height, const unsigned int width)
+      : vpBenchmarkCase(caseName("GreyToRGBa", height, width)), m_src(), m_dst(height, width)
+    {
+      vpBenchmark::generateImage(m_src, height, width);
+    }
+    void run() { vpImageConvert::convert(m_src, m_dst); }
+
+  private:
+    vpImage<unsigned char> m_src;
+    vpImage<vpRGBa> m_dst;
+  };
+
+  class vpRGBToRGBa : public vpBenchmarkCase
+  {
+  public:
+    vpRGBToRGBa(const unsigned int height, const unsigned int width)
+      : vpBenchmarkCase(caseName("RGBToRGBa", height, width)), m_rgb(height * width * 3), m_dst(height, width)
+    {
+      vpImage<vpRGBa> I;
+      vpBenchmark::generateImage(I, height, width);
+      vpImageConvert::RGBaToRGB((unsigned char *) I.bitmap, &m_rgb[0], I.getSize());
+    }
+    void run() { vpImageConvert::RGBToRGBa(&m_rgb[0], (unsigned char *) m_dst.bitmap, m_dst.getSize()); }
+
+  private:
+    std::vector<unsigned char> m_rgb;
+    vpImage<vpRGBa> m_dst;
+  };
+
+  class vpYUYVToRGBa : public vpBenchmarkCase
+  {
+  public:
+    vpYUYVToRGBa(const unsigned int height, const unsigned int width)
+      : vpBenchmarkCase(caseName("YUYVToRGBa", height, width)), m_yuyv(height * width * 2), m_dst(height, width)
+    {
+      vpImage<unsigned char> I;
+      vpBenchmark::generateImage(I, height, width * 2);
+      m_yuyv.assign(I.bitmap, I.bitmap + I.getSize());
+    }
+    void run() { vpImageConvert::YUYVToRGBa(&m_yuyv[0], (unsigned char *) m_dst.bitmap, m_dst.getWidth(), m_dst.getHeight()); }
+
+  private:
+    std::vector<unsigned char> m_yuyv;
+    vpImage<vpRGBa> m_dst;
+  };
+
+  class vpSplitMerge : public vpBenchmarkCase
+  {
+  public:
+    vpSplitMerge(const unsigned int height, const unsigned int width)
+      : vpBenchmarkCase(caseName("SplitMerge", height, width)), m_src(), m_dst(height, width), m_R(), m_G(), m_B()
+    {
+      vpBenchmark::generateImage(m_src, height, width);
+    }
+    void run()
+    {
+      vpImageConvert::split(m_src, &m_R, &m_G, &m_B);
+      vpImageConvert::merge(&m_R, &m_G, &m_B, NULL, m_dst);
+    }
+
+  private:
+    vpImage<vpRGBa> m_src;
+    vpImage<vpRGBa> m_dst;
+    vpImage<unsigned char> m_R, m_G, m_B;
+  };
+
+  class vpGreyToFloat : public vpBenchmarkCase
+  {
+  public:
+    vpGreyToFloat(const unsigned int height, const unsigned int width)
+      : vpBenchmarkCase(caseName("GreyToFloatToGrey", height, width)), m_src(), m_float(), m_dst()
+    {
+      vpBenchmark::generateImage(m_src, height, width);
+    }
+    void run()
+    {
+      vpImageConvert::convert(m_src, m_float);
+      vpImageConvert::convert(m_float, m_dst);
+    }
+
+  private:
+    vpImage<unsigned char> m_src;
+    vpImage<float> m_float;
+    vpImage<unsigned char> m_dst;
+  };
+}
+
+int main(int argc, const char **argv)
+{
+  try {
+    vpBenchmark bench("perfImageConvert", argc, argv);
+    if (!bench.isValid()) {
+      return EXIT_FAILURE;
+    }
+
+    const unsigned int sizes[][2] = { {480, 640}, {1080, 1920} };
+    for (unsigned int s = 0; s < 2; s++) {
+      const unsigned int h = sizes[s][0], w = sizes[s][1];
+      vpRGBaToGrey rgbaToGrey(h, w);
+      bench.run(rgbaToGrey);
+      vpGreyToRGBa greyToRgba(h, w);
+      bench.run(greyToRgba);
+      vpRGBToRGBa rgbToRgba(h, w);
+      bench.run(rgbToRgba);
+      vpYUYVToRGBa yuyvToRgba(h, w);
+      bench.run(yuyvToRgba);
+      vpSplitMerge splitMerge(h, w);
+      bench.run(splitMerge);
+      vpGreyToFloat greyToFloat(h, w);
+      bench.run(greyToFloat);
+    }
+
+    return bench.finish();
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
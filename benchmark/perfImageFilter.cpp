@@ -0,0 +1,161 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the image filters.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfImageFilter.cpp
+
+  \brief Benchmark of the Gaussian, gradient and Canny filters of vpImageFilter and
+  of the image pyramid construction on synthetic VGA and full HD images.
+*/
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImagePyramid.h>
+
+#include "vpBenchmark.h"
+
+namespace {
+  class vpGreyFilterCase : public vpBenchmarkCase
+  {
+  public:
+    vpGreyFilterCase(const std::string &name, const unsigned int height, const unsigned int width)
+      : vpBenchmarkCase(caseName(name, height, width)), m_I(), m_Id()
+    {
+      vpBenchmark::generateImage(m_I, height, width);
+    }
+
+  protected:
+    vpImage<unsigned char> m_I;
+    vpImage<double> m_Id;
+  };
+
+  class vpGaussianBlur : public vpGreyFilterCase
+  {
+  public:
+    vpGaussianBlur(const unsigned int height, const unsigned int width)
+      : vpGreyFilterCase("GaussianBlur7", height, width) {}
+    void run() { vpImageFilter::gaussianBlur(m_I, m_Id, 7); }
+  };
+
+  class vpGradients : public vpGreyFilterCase
+  {
+  public:
+    vpGradients(const unsigned int height, const unsigned int width)
+      : vpGreyFilterCase("GradXY", height, width), m_Idy() {}
+    void run()
+    {
+      vpImageFilter::getGradX(m_I, m_Id);
+      vpImageFilter::getGradY(m_I, m_Idy);
+    }
+
+  private:
+    vpImage<double> m_Idy;
+  };
+
+  class vpGradientsGauss : public vpGreyFilterCase
+  {
+  public:
+    vpGradientsGauss(const unsigned int height, const unsigned int width)
+      : vpGreyFilterCase("GradXYGauss2D", height, width), m_Idy()
+    {
+      vpImageFilter::getGaussianKernel(m_gauss, 5);
+      vpImageFilter::getGaussianDerivativeKernel(m_gaussDerivative, 5);
+    }
+    void run()
+    {
+      vpImageFilter::getGradXGauss2D(m_I, m_Id, m_gauss, m_gaussDerivative, 5);
+      vpImageFilter::getGradYGauss2D(m_I, m_Idy, m_gauss, m_gaussDerivative, 5);
+    }
+
+  private:
+    vpImage<double> m_Idy;
+    double m_gauss[3];
+    double m_gaussDerivative[3];
+  };
+
+  class vpCanny : public vpGreyFilterCase
+  {
+  public:
+    vpCanny(const unsigned int height, const unsigned int width)
+      : vpGreyFilterCase("Canny", height, width), m_Ic() {}
+    void run() { vpImageFilter::canny(m_I, m_Ic, 5, 15, 3); }
+
+  private:
+    vpImage<unsigned char> m_Ic;
+  };
+
+  class vpPyramid : public vpGreyFilterCase
+  {
+  public:
+    vpPyramid(const unsigned int height, const unsigned int width)
+      : vpGreyFilterCase("Pyramid4", height, width), m_pyramid(4) {}
+    // A new frame at each iteration so that the levels are computed again
+    void setUp(const unsigned int iteration) { m_pyramid.setImage(m_I, iteration + 1); }
+    void run() { m_pyramid.build(); }
+
+  private:
+    vpImagePyramid m_pyramid;
+  };
+}
+
+int main(int argc, const char **argv)
+{
+  try {
+    vpBenchmark bench("perfImageFilter", argc, argv);
+    if (!bench.isValid()) {
+      return EXIT_FAILURE;
+    }
+
+    const unsigned int sizes[][2] = { {480, 640}, {1080, 1920} };
+    for (unsigned int s = 0; s < 2; s++) {
+      const unsigned int h = sizes[s][0], w = sizes[s][1];
+      vpGaussianBlur blur(h, w);
+      bench.run(blur);
+      vpGradients grad(h, w);
+      bench.run(grad);
+      vpGradientsGauss gradGauss(h, w);
+      bench.run(gradGauss);
+      vpCanny canny(h, w);
+      bench.run(canny);
+      vpPyramid pyramid(h, w);
+      bench.run(pyramid);
+    }
+
+    return bench.finish();
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
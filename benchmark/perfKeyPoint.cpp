@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the keypoint detection and matching.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfKeyPoint.cpp
+
+  \brief Benchmark of vpKeyPoint::buildReference() and vpKeyPoint::matchPoint() with
+  ORB features on synthetic images.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#include "vpBenchmark.h"
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020301)
+
+#include <visp3/vision/vpKeyPoint.h>
+
+namespace {
+  // Current image: the reference image translated by (di, dj) pixels with a new noise
+  void generateCurrentImage(const vpImage<unsigned char> &Iref, vpImage<unsigned char> &Icur, const int di,
+                            const int dj)
+  {
+    vpImage<unsigned char> noise;
+    vpBenchmark::generateImage(noise, Iref.getHeight(), Iref.getWidth(), 7);
+    Icur.resize(Iref.getHeight(), Iref.getWidth());
+    for (int i = 0; i < (int) Icur.getHeight(); i++) {
+      for (int j = 0; j < (int) Icur.getWidth(); j++) {
+        int si = std::min(std::max(i - di, 0), (int) Iref.getHeight() - 1);
+        int sj = std::min(std::max(j - dj, 0), (int) Iref.getWidth() - 1);
+        Icur[i][j] = (unsigned char) ((3 * Iref[si][sj] + noise[i][j]) / 4);
+      }
+    }
+  }
+
+  class vpBuildReference : public vpBenchmarkCase
+  {
+  public:
+    explicit vpBuildReference(const vpImage<unsigned char> &I)
+      : vpBenchmarkCase(caseName("BuildReferenceORB", I.getHeight(), I.getWidth())), m_I(I),
+        m_keypoint("ORB", "ORB", "BruteForce-Hamming") {}
+    void run() { m_keypoint.buildReference(m_I); }
+
+  private:
+    const vpImage<unsigned char> &m_I;
+    vpKeyPoint m_keypoint;
+  };
+
+  class vpMatchPoint : public vpBenchmarkCase
+  {
+  public:
+    vpMatchPoint(const std::string &matcher, const vpImage<unsigned char> &Iref, const vpImage<unsigned char> &Icur)
+      : vpBenchmarkCase(caseName("MatchORB" + matcher, Icur.getHeight(), Icur.getWidth())), m_I(Icur),
+        m_keypoint("ORB", "ORB", matcher)
+    {
+      m_keypoint.buildReference(Iref);
+    }
+    void run() { m_keypoint.matchPoint(m_I); }
+
+  private:
+    const vpImage<unsigned char> &m_I;
+    vpKeyPoint m_keypoint;
+  };
+}
+
+int main(int argc, const char **argv)
+{
+  try {
+    vpBenchmark bench("perfKeyPoint", argc, argv);
+    if (!bench.isValid()) {
+      return EXIT_FAILURE;
+    }
+
+    vpImage<unsigned char> Iref, Icur;
+    vpBenchmark::generateImage(Iref, 480, 640);
+    generateCurrentImage(Iref, Icur, 5, -8);
+
+    vpBuildReference build(Iref);
+    bench.run(build);
+    vpMatchPoint bruteForce("BruteForce-Hamming", Iref, Icur);
+    bench.run(bruteForce);
+    vpMatchPoint flann("FlannBased", Iref, Icur);
+    bench.run(flann);
+
+    return bench.finish();
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+#else
+int main(int argc, const char **argv)
+{
+  vpBenchmark bench("perfKeyPoint", argc, argv);
+  if (!bench.isValid()) {
+    return EXIT_FAILURE;
+  }
+  std::cout << "vpKeyPoint requires OpenCV, nothing to benchmark." << std::endl;
+  return bench.finish();
+}
+#endif
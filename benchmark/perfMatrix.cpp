@@ -0,0 +1,182 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the matrix operations.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfMatrix.cpp
+
+  \brief Benchmark of the vpMatrix operations used by the pose estimation and the
+  model-based trackers: products, \f$A^T A\f$, pseudo-inverse and inverse.
+*/
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpUniRand.h>
+
+#include "vpBenchmark.h"
+
+namespace {
+  void generateMatrix(vpMatrix &M, const unsigned int rows, const unsigned int cols, const long seed)
+  {
+    vpUniRand rand(seed);
+    M.resize(rows, cols, false, false);
+    for (unsigned int i = 0; i < M.size(); i++) {
+      M.data[i] = 2. * rand() - 1.;
+    }
+  }
+
+  // Matrix case named "name/rowsxcols"
+  class vpMatrixCase : public vpBenchmarkCase
+  {
+  public:
+    vpMatrixCase(const std::string &name, const unsigned int rows, const unsigned int cols)
+      : vpBenchmarkCase(caseName(name, cols, rows)), m_A(), m_R()
+    {
+      generateMatrix(m_A, rows, cols, 1);
+    }
+
+  protected:
+    vpMatrix m_A;
+    vpMatrix m_R;
+  };
+
+  class vpMatrixProduct : public vpMatrixCase
+  {
+  public:
+    vpMatrixProduct(const unsigned int rows, const unsigned int cols)
+      : vpMatrixCase("Product", rows, cols), m_B()
+    {
+      generateMatrix(m_B, cols, rows, 2);
+    }
+    void run() { vpMatrix::mult2Matrices(m_A, m_B, m_R); }
+
+  private:
+    vpMatrix m_B;
+  };
+
+  class vpMatrixVector : public vpMatrixCase
+  {
+  public:
+    vpMatrixVector(const unsigned int rows, const unsigned int cols)
+      : vpMatrixCase("MatrixVector", rows, cols), m_v(cols, 1.), m_w() {}
+    void run() { vpMatrix::multMatrixVector(m_A, m_v, m_w); }
+
+  private:
+    vpColVector m_v;
+    vpColVector m_w;
+  };
+
+  class vpMatrixAtA : public vpMatrixCase
+  {
+  public:
+    vpMatrixAtA(const unsigned int rows, const unsigned int cols)
+      : vpMatrixCase("AtA", rows, cols) {}
+    void run() { m_A.AtA(m_R); }
+  };
+
+  class vpMatrixPseudoInverse : public vpMatrixCase
+  {
+  public:
+    vpMatrixPseudoInverse(const unsigned int rows, const unsigned int cols)
+      : vpMatrixCase("PseudoInverse", rows, cols) {}
+    void run() { m_A.pseudoInverse(m_R); }
+  };
+
+  class vpMatrixInverse : public vpMatrixCase
+  {
+  public:
+    explicit vpMatrixInverse(const unsigned int size)
+      : vpMatrixCase("InverseByLU", size, size) {}
+    void run() { m_R = m_A.inverseByLU(); }
+  };
+
+  // Gauss-Newton step of the virtual visual servoing: (L^T L)^-1 L^T e
+  class vpGaussNewtonStep : public vpMatrixCase
+  {
+  public:
+    explicit vpGaussNewtonStep(const unsigned int rows)
+      : vpMatrixCase("GaussNewtonStep", rows, 6), m_e(rows, 0.5), m_LTL(), m_LTe(), m_v() {}
+    void run()
+    {
+      m_A.AtA(m_LTL);
+      m_LTe = m_A.t() * m_e;
+      m_v = m_LTL.inverseByLU() * m_LTe;
+    }
+
+  private:
+    vpColVector m_e;
+    vpMatrix m_LTL;
+    vpColVector m_LTe;
+    vpColVector m_v;
+  };
+}
+
+int main(int argc, const char **argv)
+{
+  try {
+    vpBenchmark bench("perfMatrix", argc, argv);
+    if (!bench.isValid()) {
+      return EXIT_FAILURE;
+    }
+
+    // Stacked interaction matrices of the trackers (N x 6) and square matrices
+    const unsigned int tallRows[] = { 500, 5000, 50000 };
+    for (unsigned int i = 0; i < 3; i++) {
+      vpMatrixAtA ata(tallRows[i], 6);
+      bench.run(ata);
+      vpMatrixVector mv(tallRows[i], 6);
+      bench.run(mv);
+      vpMatrixPseudoInverse pinv(tallRows[i], 6);
+      bench.run(pinv);
+      vpGaussNewtonStep gn(tallRows[i]);
+      bench.run(gn);
+    }
+
+    const unsigned int squareSizes[] = { 6, 64, 256 };
+    for (unsigned int i = 0; i < 3; i++) {
+      vpMatrixProduct product(squareSizes[i], squareSizes[i]);
+      bench.run(product);
+      vpMatrixInverse inverse(squareSizes[i]);
+      bench.run(inverse);
+    }
+    vpMatrixPseudoInverse pinv(100, 80);
+    bench.run(pinv);
+
+    return bench.finish();
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,226 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the generic model-based tracker on a simulated scene.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfMbGenericTracker.cpp
+
+  \brief Benchmark of vpMbGenericTracker::track() with the edge and depth features on
+  a simulated sequence.
+
+  The tea box of vpMbtTeaBox is rendered by ray casting along a known camera trajectory,
+  with noise added to the images. The tracker is initialized from the ground truth pose
+  on the first frame, then tracks one frame per iteration. The tracking error is checked so that a regression that makes the tracker
+  diverge is not hidden by a speed up.
+*/
+
+#include <algorithm>
+#include <map>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpBenchmark.h"
+#include "vpMbtTeaBox.h"
+
+namespace {
+  /*
+    Simulated sequence: grey level images and point clouds of the tea box seen along a
+    closed camera trajectory.
+  */
+  class vpScene
+  {
+  public:
+    vpScene(const unsigned int nbFrames, const unsigned int height, const unsigned int width)
+      : m_cam(600, 600, width / 2., height / 2.), m_poses(nbFrames), m_images(nbFrames), m_clouds(nbFrames),
+        m_height(height), m_width(width)
+    {
+      for (unsigned int k = 0; k < nbFrames; k++) {
+        const double a = 2. * M_PI * k / nbFrames;
+        m_poses[k] = vpMbtTeaBox::getPose(vpTranslationVector(0.02 * std::sin(a), 0.01 * std::cos(a),
+                                                              0.45 + 0.03 * std::sin(a)),
+                                          vpThetaUVector(vpMath::rad(-35. + 10. * std::sin(a)),
+                                                         vpMath::rad(30. + 10. * std::cos(a)), vpMath::rad(10.)));
+        m_images[k].resize(m_height, m_width);
+        vpMbtTeaBox::render(m_poses[k], m_cam, m_images[k], m_clouds[k]);
+
+        // Sensor noise
+        vpUniRand rand(k);
+        vpImage<unsigned char> &I = m_images[k];
+        for (unsigned int i = 0; i < I.getSize(); i++) {
+          I.bitmap[i] = (unsigned char) vpMath::saturate<unsigned char>(I.bitmap[i] + 8. * (rand() - 0.5));
+        }
+      }
+    }
+
+    const vpCameraParameters &getCameraParameters() const { return m_cam; }
+    unsigned int getNbFrames() const { return (unsigned int) m_poses.size(); }
+    unsigned int getHeight() const { return m_height; }
+    unsigned int getWidth() const { return m_width; }
+    const vpHomogeneousMatrix &getPose(const unsigned int k) const { return m_poses[k]; }
+    const vpImage<unsigned char> &getImage(const unsigned int k) const { return m_images[k]; }
+    const std::vector<vpColVector> &getPointCloud(const unsigned int k) const { return m_clouds[k]; }
+
+  private:
+    vpCameraParameters m_cam;
+    std::vector<vpHomogeneousMatrix> m_poses;
+    std::vector<vpImage<unsigned char> > m_images;
+    std::vector<std::vector<vpColVector> > m_clouds;
+    unsigned int m_height;
+    unsigned int m_width;
+  };
+
+  class vpTrackerCase : public vpBenchmarkCase
+  {
+  public:
+    vpTrackerCase(const std::string &name, const vpScene &scene, const std::string &modelFile,
+                  const int trackerType, const bool scanLine)
+      : vpBenchmarkCase(caseName(name, scene.getHeight(), scene.getWidth())), m_scene(scene),
+        m_tracker(1, trackerType), m_useDepth((trackerType & (vpMbGenericTracker::DEPTH_DENSE_TRACKER |
+                                                               vpMbGenericTracker::DEPTH_NORMAL_TRACKER)) != 0),
+        m_frame(0), m_tracked(false), m_maxError(0)
+    {
+      vpMe me;
+      me.setMaskSize(5);
+      me.setMaskNumber(180);
+      me.setRange(8);
+      me.setThreshold(10000);
+      me.setMu1(0.5);
+      me.setMu2(0.5);
+      me.setSampleStep(4);
+      m_tracker.setMovingEdge(me);
+      m_tracker.setCameraParameters(scene.getCameraParameters());
+      m_tracker.setAngleAppear(vpMath::rad(70));
+      m_tracker.setAngleDisappear(vpMath::rad(80));
+      m_tracker.setNearClippingDistance(0.1);
+      m_tracker.setFarClippingDistance(100.0);
+      m_tracker.setClipping(m_tracker.getClipping() | vpMbtPolygon::FOV_CLIPPING);
+      m_tracker.setOgreVisibilityTest(false);
+      m_tracker.setScanLineVisibilityTest(scanLine);
+      m_tracker.loadModel(modelFile);
+    }
+
+    // Translation error in meter of the worst tracked frame
+    double getMaxError()
+    {
+      updateError();
+      return m_maxError;
+    }
+
+    void setUp(const unsigned int iteration)
+    {
+      updateError();
+      m_frame = iteration % m_scene.getNbFrames();
+      if (m_frame == 0) {
+        m_tracker.initFromPose(m_scene.getImage(0), m_scene.getPose(0));
+      }
+    }
+
+    void run()
+    {
+      if (m_useDepth) {
+        std::map<std::string, const vpImage<unsigned char> *> images;
+        std::map<std::string, const std::vector<vpColVector> *> clouds;
+        std::map<std::string, unsigned int> widths, heights;
+        images["Camera"] = &m_scene.getImage(m_frame);
+        clouds["Camera"] = &m_scene.getPointCloud(m_frame);
+        widths["Camera"] = m_scene.getWidth();
+        heights["Camera"] = m_scene.getHeight();
+        m_tracker.track(images, clouds, widths, heights);
+      }
+      else {
+        m_tracker.track(m_scene.getImage(m_frame));
+      }
+      m_tracked = true;
+    }
+
+  private:
+    void updateError()
+    {
+      if (m_tracked) {
+        vpHomogeneousMatrix cMo;
+        m_tracker.getPose(cMo);
+        vpTranslationVector dt = cMo.getTranslationVector() - m_scene.getPose(m_frame).getTranslationVector();
+        m_maxError = std::max(m_maxError, dt.euclideanNorm());
+        m_tracked = false;
+      }
+    }
+
+    const vpScene &m_scene;
+    vpMbGenericTracker m_tracker;
+    bool m_useDepth;
+    unsigned int m_frame;
+    bool m_tracked;
+    double m_maxError;
+  };
+}
+
+int main(int argc, const char **argv)
+{
+  try {
+    vpBenchmark bench("perfMbGenericTracker", argc, argv);
+    if (!bench.isValid()) {
+      return EXIT_FAILURE;
+    }
+
+    std::string modelFile = vpIoTools::createFilePath(bench.getOutputPath(), "perfMbGenericTracker-teabox.cao");
+    vpMbtTeaBox::writeModel(modelFile);
+    vpScene scene(60, 480, 640);
+
+    const char *names[] = { "MbtEdge", "MbtEdgeScanLine", "MbtDepthDense", "MbtDepthNormal", "MbtEdgeDepthDense" };
+    const int types[] = { vpMbGenericTracker::EDGE_TRACKER, vpMbGenericTracker::EDGE_TRACKER,
+                          vpMbGenericTracker::DEPTH_DENSE_TRACKER, vpMbGenericTracker::DEPTH_NORMAL_TRACKER,
+                          vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER };
+    const bool scanLines[] = { false, true, false, false, false };
+
+    bool diverged = false;
+    for (unsigned int c = 0; c < 5; c++) {
+      vpTrackerCase tracker(names[c], scene, modelFile, types[c], scanLines[c]);
+      bench.run(tracker);
+      if (tracker.getMaxError() > 0.01) {
+        std::cerr << names[c] << " diverged: translation error of " << tracker.getMaxError() << " m" << std::endl;
+        diverged = true;
+      }
+    }
+
+    int ret = bench.finish();
+    return diverged ? EXIT_FAILURE : ret;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,365 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Minimal benchmark harness shared by the ViSP benchmarks.
+ *
+ *****************************************************************************/
+
+#ifndef __vpBenchmark_h_
+#define __vpBenchmark_h_
+
+/*!
+  \file vpBenchmark.h
+  \brief Minimal benchmark harness shared by the ViSP benchmarks.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/io/vpParseArgv.h>
+
+#ifdef VISP_HAVE_OPENMP
+#  include <omp.h>
+#endif
+
+/*!
+  \class vpBenchmarkCase
+
+  \brief Code whose execution time is measured by vpBenchmark::run().
+
+  The inputs are built once in the constructor from synthetic data generated with a
+  fixed seed, so that two runs of a benchmark process the same data. setUp() is
+  called before each iteration, and is not timed.
+*/
+class vpBenchmarkCase
+{
+public:
+  explicit vpBenchmarkCase(const std::string &name) : m_name(name) {}
+  virtual ~vpBenchmarkCase() {}
+
+  //! Name used in the reports.
+  const std::string &getName() const { return m_name; }
+  //! Prepare the iteration \e iteration (warmup iterations included). Not timed.
+  virtual void setUp(const unsigned int /*iteration*/) {}
+  //! Code to benchmark.
+  virtual void run() = 0;
+
+protected:
+  //! Name of a case processing a \e height x \e width input: "name/widthxheight".
+  static std::string caseName(const std::string &name, const unsigned int height, const unsigned int width)
+  {
+    std::ostringstream ss;
+    ss << name << "/" << width << "x" << height;
+    return ss.str();
+  }
+
+private:
+  std::string m_name;
+};
+
+/*!
+  \class vpBenchmark
+
+  \brief Run benchmark cases and report their latencies.
+
+  Each case is run for a number of warmup iterations that are not measured, then for
+  a number of measured iterations. The mean, standard deviation, min, max and the
+  50th, 90th and 99th percentiles of the latencies are printed, and optionally
+  written in a JSON file to compare the results between two builds:
+
+  \code
+  int main(int argc, const char **argv)
+  {
+    vpBenchmark bench("perfMatrix", argc, argv);
+    if (!bench.isValid()) {
+      return EXIT_FAILURE;
+    }
+    MyCase c;
+    bench.run(c);
+    return bench.finish();
+  }
+  \endcode
+
+  Command line options:
+  - -n <iterations>: number of measured iterations (default 100),
+  - -w <iterations>: number of warmup iterations (default 10),
+  - -f <filter>: run only the cases whose name contains \e filter,
+  - -j <file>: write the results in the JSON file \e file,
+  - -o <path>: directory where temporary files are written,
+  - -h: print the help.
+*/
+class vpBenchmark
+{
+public:
+  vpBenchmark(const std::string &suite, int argc, const char **argv)
+    : m_suite(suite), m_iterations(100), m_warmup(10), m_filter(), m_json(), m_opath(), m_results(),
+      m_valid(true)
+  {
+#if defined(_WIN32)
+    m_opath = "C:/temp";
+#else
+    m_opath = "/tmp";
+#endif
+    const char *optarg_;
+    int c;
+    while ((c = vpParseArgv::parse(argc, argv, "f:hj:n:o:w:", &optarg_)) > 1) {
+      switch (c) {
+      case 'f': m_filter = optarg_; break;
+      case 'j': m_json = optarg_; break;
+      case 'n': m_iterations = (unsigned int) atoi(optarg_); break;
+      case 'o': m_opath = optarg_; break;
+      case 'w': m_warmup = (unsigned int) atoi(optarg_); break;
+      case 'h': usage(argv[0], NULL); m_valid = false; break;
+      default: usage(argv[0], optarg_); m_valid = false; break;
+      }
+    }
+    if (c == 1 || c == -1) {
+      usage(argv[0], optarg_);
+      m_valid = false;
+    }
+    if (m_iterations == 0) {
+      m_iterations = 1;
+    }
+  }
+
+  /*!
+    Fill \e I with a reproducible synthetic texture: smooth waves, a grid of blocks
+    providing corners and edges, and a uniform noise drawn from \e seed.
+  */
+  static void generateImage(vpImage<unsigned char> &I, const unsigned int height, const unsigned int width,
+                            const long seed = 1)
+  {
+    I.resize(height, width);
+    vpUniRand rand(seed);
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        double v = 64. * (std::sin(0.05 * j) + std::cos(0.07 * i)) + (((i / 32 + j / 32) % 2) ? 60. : -60.);
+        v += 128. + 20. * (rand() - 0.5);
+        I[i][j] = (unsigned char) std::max(0., std::min(255., v));
+      }
+    }
+  }
+
+  /*!
+    Color version of generateImage(), each channel using a different seed.
+  */
+  static void generateImage(vpImage<vpRGBa> &I, const unsigned int height, const unsigned int width,
+                            const long seed = 1)
+  {
+    vpImage<unsigned char> R, G, B;
+    generateImage(R, height, width, seed);
+    generateImage(G, height, width, seed + 1);
+    generateImage(B, height, width, seed + 2);
+    I.resize(height, width);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I.bitmap[i] = vpRGBa(R.bitmap[i], G.bitmap[width * height - 1 - i], B.bitmap[(i * 7) % (width * height)]);
+    }
+  }
+
+  //! Directory where the benchmarks can write temporary files.
+  std::string getOutputPath() const { return m_opath; }
+  //! Number of measured iterations.
+  unsigned int getIterations() const { return m_iterations; }
+  //! Number of warmup iterations.
+  unsigned int getWarmup() const { return m_warmup; }
+  //! false when the help was requested or the command line is not valid.
+  bool isValid() const { return m_valid; }
+
+  /*!
+    Run a case if its name matches the filter, and store its latencies.
+  */
+  void run(vpBenchmarkCase &bc)
+  {
+    if (!m_filter.empty() && bc.getName().find(m_filter) == std::string::npos) {
+      return;
+    }
+
+    for (unsigned int i = 0; i < m_warmup; i++) {
+      bc.setUp(i);
+      bc.run();
+    }
+    std::vector<double> times(m_iterations);
+    for (unsigned int i = 0; i < m_iterations; i++) {
+      bc.setUp(m_warmup + i);
+      double t = vpTime::measureTimeMicros();
+      bc.run();
+      times[i] = (vpTime::measureTimeMicros() - t) / 1000.;
+    }
+
+    Result r;
+    r.name = bc.getName();
+    r.iterations = m_iterations;
+    double sum = 0, sum2 = 0;
+    for (size_t i = 0; i < times.size(); i++) {
+      sum += times[i];
+      sum2 += times[i] * times[i];
+    }
+    r.mean = sum / times.size();
+    r.stddev = std::sqrt(std::max(0., sum2 / times.size() - r.mean * r.mean));
+    std::sort(times.begin(), times.end());
+    r.min = times.front();
+    r.max = times.back();
+    r.p50 = percentile(times, 50);
+    r.p90 = percentile(times, 90);
+    r.p99 = percentile(times, 99);
+    m_results.push_back(r);
+
+    std::cout << std::left << std::setw(40) << r.name << std::right << std::fixed << std::setprecision(3)
+              << " mean " << std::setw(10) << r.mean << " ms  p50 " << std::setw(10) << r.p50 << " ms  p90 "
+              << std::setw(10) << r.p90 << " ms  p99 " << std::setw(10) << r.p99 << " ms" << std::endl;
+  }
+
+  /*!
+    Write the JSON report if requested.
+    \return EXIT_SUCCESS, or EXIT_FAILURE if the report cannot be written.
+  */
+  int finish() const
+  {
+    if (m_json.empty()) {
+      return EXIT_SUCCESS;
+    }
+    std::ofstream file(m_json.c_str());
+    if (!file) {
+      std::cerr << "Cannot write " << m_json << std::endl;
+      return EXIT_FAILURE;
+    }
+    file << std::setprecision(6) << std::fixed;
+    file << "{\n";
+    file << "  \"suite\": \"" << m_suite << "\",\n";
+    file << "  \"visp_version\": \"" << VISP_VERSION_MAJOR << "." << VISP_VERSION_MINOR << "."
+         << VISP_VERSION_PATCH << "\",\n";
+    file << "  \"config\": {\n";
+    file << "    \"sse2\": " << (vpCPUFeatures::checkSSE2() ? "true" : "false") << ",\n";
+#ifdef VISP_HAVE_OPENMP
+    file << "    \"openmp_threads\": " << omp_get_max_threads() << ",\n";
+#else
+    file << "    \"openmp_threads\": 0,\n";
+#endif
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
+    file << "    \"blas\": true,\n";
+#else
+    file << "    \"blas\": false,\n";
+#endif
+#ifdef VISP_HAVE_OPENCV
+    file << "    \"opencv\": true\n";
+#else
+    file << "    \"opencv\": false\n";
+#endif
+    file << "  },\n";
+    file << "  \"warmup\": " << m_warmup << ",\n";
+    file << "  \"unit\": \"ms\",\n";
+    file << "  \"results\": [";
+    for (size_t i = 0; i < m_results.size(); i++) {
+      const Result &r = m_results[i];
+      file << (i == 0 ? "\n" : ",\n");
+      file << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations << ", \"mean\": " << r.mean
+           << ", \"stddev\": " << r.stddev << ", \"min\": " << r.min << ", \"max\": " << r.max << ", \"p50\": "
+           << r.p50 << ", \"p90\": " << r.p90 << ", \"p99\": " << r.p99 << "}";
+    }
+    file << "\n  ]\n";
+    file << "}\n";
+    return file ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+private:
+  struct Result {
+    std::string name;
+    unsigned int iterations;
+    double mean, stddev, min, max, p50, p90, p99;
+  };
+
+  // Nearest-rank percentile of sorted values
+  static double percentile(const std::vector<double> &sorted, const double p)
+  {
+    size_t rank = (size_t) std::ceil(p / 100. * sorted.size());
+    return sorted[rank > 0 ? rank - 1 : 0];
+  }
+
+  void usage(const char *name, const char *badparam) const
+  {
+    fprintf(stdout, "\n\
+Benchmark %s.\n\
+\n\
+SYNOPSIS\n\
+  %s [-n <iterations>] [-w <warmup iterations>] [-f <filter>]\n\
+     [-j <json file>] [-o <output path>] [-h]\n", m_suite.c_str(), name);
+
+    fprintf(stdout, "\n\
+OPTIONS:                                               Default\n\
+  -n <iterations>                                      %u\n\
+     Number of measured iterations of each case.\n\
+\n\
+  -w <warmup iterations>                               %u\n\
+     Number of iterations run before the measures.\n\
+\n\
+  -f <filter>\n\
+     Run only the cases whose name contains this string.\n\
+\n\
+  -j <json file>\n\
+     Write the latencies in this JSON file.\n\
+\n\
+  -o <output path>                                     %s\n\
+     Directory where temporary files are written.\n\
+\n\
+  -h\n\
+     Print the help.\n\n", m_iterations, m_warmup, m_opath.c_str());
+
+    if (badparam) {
+      fprintf(stdout, "\nERROR: Bad parameter [%s]\n", badparam);
+    }
+  }
+
+  std::string m_suite;
+  unsigned int m_iterations;
+  unsigned int m_warmup;
+  std::string m_filter;
+  std::string m_json;
+  std::string m_opath;
+  std::vector<Result> m_results;
+  bool m_valid;
+};
+
+#endif
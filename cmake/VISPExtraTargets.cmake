@@ -106,6 +106,16 @@ if(BUILD_TUTORIALS)
   endif()
 endif()
 
+# ----------------------------------------------------------------------------
+#   Benchmarks target, for make visp_benchmarks
+# ----------------------------------------------------------------------------
+if(BUILD_BENCHMARKS)
+  add_custom_target(visp_benchmarks)
+  if(ENABLE_SOLUTION_FOLDERS)
+    set_target_properties(visp_benchmarks PROPERTIES FOLDER "extra")
+  endif()
+endif()
+
 # ----------------------------------------------------------------------------
 #   Target building all ViSP modules
 # ----------------------------------------------------------------------------
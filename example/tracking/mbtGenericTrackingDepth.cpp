@@ -322,8 +322,12 @@ namespace {
     dynamic_cast<vpMbGenericTracker*>(tracker)->setMovingEdge(me);
 
     //Klt
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#  if defined(VISP_HAVE_OPENCV)
     vpKltOpencv klt;
+#  else
+    vpKltTracker klt;
+#  endif
     klt.setMaxFeatures(10000);
     klt.setWindowSize(5);
     klt.setQuality(0.01);
@@ -332,7 +336,11 @@ namespace {
     klt.setBlockSize(3);
     klt.setPyramidLevels(3);
 
+#  if defined(VISP_HAVE_OPENCV)
     dynamic_cast<vpMbGenericTracker*>(tracker)->setKltOpencv(klt);
+#  else
+    dynamic_cast<vpMbGenericTracker*>(tracker)->setKltTracker(klt);
+#  endif
     dynamic_cast<vpMbGenericTracker*>(tracker)->setKltMaskBorder(5);
 #endif
 
@@ -442,9 +450,9 @@ int main(int argc, const char ** argv) {
       return EXIT_FAILURE;
     }
 
-#if !defined(VISP_HAVE_MODULE_KLT) || (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION < 0x020100))
+#if !defined(VISP_HAVE_MODULE_KLT) || (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020100))
     if (trackerType_image == /*vpMbGenericTracker::KLT_TRACKER*/2) {
-      std::cout << "KLT only features cannot be used: ViSP is not built with KLT module or OpenCV is not available." << std::endl;
+      std::cout << "KLT only features cannot be used: ViSP is not built with KLT module or OpenCV is too old." << std::endl;
       return EXIT_SUCCESS;
     }
 #endif
@@ -49,6 +49,7 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpMemory.h>
 
 /*!
   \class vpArray2D
@@ -66,6 +67,10 @@
   - concerning vectors, vpColVector, vpRowVector but also specific containers describing
     the pose (vpPoseVector) and the rotation (vpRotationVector) inherit also from
     vpArray2D<double>.
+
+  The data array is allocated with vpMemory::allocate() and is thus aligned on
+  vpMemory::alignment bytes. Enabling the vpMemory pool recycles the data arrays
+  of temporaries that are created again and again with the same size.
 */
 template<class Type>
 class vpArray2D
@@ -79,6 +84,8 @@ protected:
   Type **rowPtrs;
   //! Current array size (rowNum * colNum)
   unsigned int dsize;
+  //! False if data and rowPtrs point to a fixed size storage, see vpFixedArray2D
+  bool ownData;
 
 public:
   //! Address of the first element of the data array
@@ -90,13 +97,13 @@ public:
   Number of columns and rows are set to zero.
   */
   vpArray2D<Type>()
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), ownData(true), data(NULL)
   {}
   /*!
   Copy constructor of a 2D array.
   */
   vpArray2D<Type>(const vpArray2D<Type> & A)
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), ownData(true), data(NULL)
   {
     resize(A.rowNum, A.colNum, false, false);
     memcpy(data, A.data, rowNum*colNum*sizeof(Type));
@@ -108,7 +115,7 @@ public:
   \param c : Array number of columns.
   */
   vpArray2D<Type>(unsigned int r, unsigned int c)
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), ownData(true), data(NULL)
   {
     resize(r, c);
   }
@@ -120,7 +127,7 @@ public:
   \param val : Each element of the array is set to \e val.
   */
   vpArray2D<Type>(unsigned int r, unsigned int c, Type val)
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), ownData(true), data(NULL)
   {
     resize(r, c, false, false);
     *this = val;
@@ -130,8 +137,13 @@ public:
   */
   virtual ~vpArray2D<Type>()
   {
+    if (!ownData) {
+      data = NULL;
+      rowPtrs = NULL;
+    }
+
     if (data != NULL ) {
-      free(data);
+      vpMemory::deallocate(data);
       data=NULL;
     }
 
@@ -173,10 +185,17 @@ public:
   Default value is true.
   \param recopy_ : if true, will perform an explicit recopy of the old data
   if needed and if flagNullify is set to false.
+
+  \exception vpException::dimensionError : The array has a fixed size different
+  from the new one.
   */
   void resize(const unsigned int nrows, const unsigned int ncols,
               const bool flagNullify=true, const bool recopy_=true)
   {
+    if (!ownData && ((nrows != rowNum) || (ncols != colNum))) {
+      throw(vpException(vpException::dimensionError,
+        "Cannot resize a fixed size (%ux%u) array to (%ux%u)", rowNum, colNum, nrows, ncols));
+    }
     if ((nrows == rowNum) && (ncols == colNum)) {
       if (flagNullify && this->data != NULL) {
         memset(this->data, 0, this->dsize*sizeof(Type));
@@ -185,29 +204,29 @@ public:
     else {
       bool recopy = !flagNullify && recopy_; //priority to flagNullify
       const bool recopyNeeded = ( ncols != this->colNum && this->colNum > 0 && ncols > 0 && (!flagNullify || recopy) );
-      Type * copyTmp = NULL;
-      unsigned int rowTmp = 0, colTmp=0;
-
-      // Recopy case per case is required if number of cols has changed;
-      // structure of Type array is not the same in this case.
-      if (recopyNeeded && this->data != NULL) {
-        copyTmp = new Type[this->dsize];
-        memcpy (copyTmp, this ->data, sizeof(Type)*this->dsize);
-        rowTmp=this->rowNum; colTmp=this->colNum;
-      }
-
-      // Reallocation of this->data array
-      this->dsize = nrows*ncols;
-      this->data = (Type*)realloc(this->data, this->dsize*sizeof(Type));
-      if ((NULL == this->data) && (0 != this->dsize)) {
-        if (copyTmp != NULL) delete [] copyTmp;
-        throw(vpException(vpException::memoryAllocationError,
-          "Memory allocation error when allocating 2D array data"));
+      const unsigned int rowTmp = this->rowNum, colTmp = this->colNum;
+      const unsigned int newSize = nrows*ncols;
+      Type *oldData = this->data;
+
+      // Reallocation of this->data array. The buffer comes from vpMemory to be aligned
+      // and recycled by the pool. The current buffer is reused when it fits without
+      // wasting more than half of it. Otherwise the old buffer is kept until the end
+      // to recopy the values: case per case if the number of cols has changed since
+      // the structure of Type array is not the same, else only the common part as
+      // realloc() would do.
+      const size_t newBytes = newSize*sizeof(Type);
+      const size_t oldCapacity = vpMemory::capacity(oldData);
+      if (recopyNeeded || newBytes > oldCapacity || 2*newBytes < oldCapacity) {
+        this->data = static_cast<Type *>(vpMemory::allocate(newBytes));
+        if (!recopyNeeded && !flagNullify && oldData != NULL && this->data != NULL) {
+          memcpy(this->data, oldData, ((this->dsize < newSize) ? this->dsize : newSize)*sizeof(Type));
+        }
       }
+      this->dsize = newSize;
 
       this->rowPtrs = (Type**)realloc (this->rowPtrs, nrows*sizeof(Type*));
       if ((NULL == this->rowPtrs) && (0 != this->dsize)) {
-        if (copyTmp != NULL) delete [] copyTmp;
+        if (oldData != this->data) vpMemory::deallocate(oldData);
         throw(vpException(vpException::memoryAllocationError,
           "Memory allocation error when allocating 2D array rowPtrs"));
       }
@@ -233,7 +252,7 @@ public:
         for (unsigned int i=0; i<this->rowNum; ++i) {
           for (unsigned int j=0; j<this->colNum; ++j) {
             if ((minRow > i) && (minCol > j)) {
-              (*this)[i][j] = copyTmp [i*colTmp+j];
+              (*this)[i][j] = oldData [i*colTmp+j];
             }
             else {
               (*this)[i][j] = 0;
@@ -242,8 +261,8 @@ public:
         }
       }
 
-      if (copyTmp != NULL)
-        delete [] copyTmp;
+      if (oldData != this->data)
+        vpMemory::deallocate(oldData);
     }
   }
   //! Set all the elements of the array to \e x.
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * 2D array with a size fixed at compile time and an inline storage.
+ *
+ *****************************************************************************/
+#ifndef __vpFixedArray2D_h_
+#define __vpFixedArray2D_h_
+
+/*!
+  \file vpFixedArray2D.h
+  \brief 2D array with a size fixed at compile time and an inline storage.
+*/
+
+#include <string.h>
+
+#include <visp3/core/vpArray2D.h>
+
+/*!
+  \class vpFixedArray2D
+  \ingroup group_core_matrices
+
+  \brief 2D array whose size is fixed at compile time and whose elements are
+  stored inside the object.
+
+  Contrary to vpArray2D, constructing, copying or destroying a vpFixedArray2D
+  does not allocate memory: the elements are stored in the object itself, on the
+  stack for a local variable. The dimensions being compile time constants, the
+  loops of multiply() are fully unrolled by the compiler.
+
+  This class is the base of the small matrices and vectors used for rigid
+  transformations: vpHomogeneousMatrix (4x4), vpRotationMatrix (3x3),
+  vpVelocityTwistMatrix and vpForceTwistMatrix (6x6) and vpTranslationVector
+  (3x1). Since it inherits from vpArray2D, a vpFixedArray2D can be used
+  everywhere a vpArray2D is expected, except that it cannot be resized to
+  another size (vpArray2D::resize() throws vpException::dimensionError).
+*/
+template<class Type, unsigned int R, unsigned int C>
+class vpFixedArray2D : public vpArray2D<Type>
+{
+public:
+  /*!
+    Construct an array with all the elements set to 0.
+  */
+  vpFixedArray2D()
+    : vpArray2D<Type>()
+  {
+    init();
+    memset(m_storage, 0, sizeof(m_storage));
+  }
+  /*!
+    Copy constructor.
+  */
+  vpFixedArray2D(const vpFixedArray2D<Type, R, C> &A)
+    : vpArray2D<Type>()
+  {
+    init();
+    memcpy(m_storage, A.m_storage, sizeof(m_storage));
+  }
+  virtual ~vpFixedArray2D() {}
+
+  /*!
+    Copy operator.
+  */
+  vpFixedArray2D<Type, R, C> &operator=(const vpFixedArray2D<Type, R, C> &A)
+  {
+    memcpy(m_storage, A.m_storage, sizeof(m_storage));
+    return *this;
+  }
+
+  /*!
+    Compute the product \f$ {\bf P} = {\bf A} {\bf B} \f$ of two fixed size arrays.
+    \e P should not be \e A or \e B.
+  */
+  template<unsigned int K>
+  static void multiply(const vpFixedArray2D<Type, R, K> &A, const vpFixedArray2D<Type, K, C> &B,
+                       vpFixedArray2D<Type, R, C> &P)
+  {
+    const Type *a = A.data;
+    const Type *b = B.data;
+    Type *p = P.data;
+    for (unsigned int i = 0; i < R; i++) {
+      for (unsigned int j = 0; j < C; j++) {
+        Type s = 0;
+        for (unsigned int k = 0; k < K; k++) {
+          s += a[i*K + k] * b[k*C + j];
+        }
+        p[i*C + j] = s;
+      }
+    }
+  }
+
+private:
+  void init()
+  {
+    this->rowNum = R;
+    this->colNum = C;
+    this->dsize = R*C;
+    this->ownData = false;
+    this->data = m_storage;
+    this->rowPtrs = m_rows;
+    for (unsigned int i = 0; i < R; i++) {
+      m_rows[i] = m_storage + i*C;
+    }
+  }
+
+  //! Elements of the array stored row by row
+  Type m_storage[R*C];
+  //! Address of the first element of each row
+  Type *m_rows[R];
+};
+
+#endif
@@ -41,6 +41,7 @@
 #define vpForceTwistMatrix_h
 
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedArray2D.h>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpRotationMatrix.h>
@@ -107,7 +108,7 @@ int main()
 }
   \endcode
 */
-class VISP_EXPORT vpForceTwistMatrix : public vpArray2D<double>
+class VISP_EXPORT vpForceTwistMatrix : public vpFixedArray2D<double, 6, 6>
 {
  public:
   // basic constructor
@@ -60,6 +60,7 @@ class vpPoint;
 #include <fstream>
 
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedArray2D.h>
 #include <visp3/core/vpRotationMatrix.h>
 #include <visp3/core/vpThetaUVector.h>
 //#include <visp3/core/vpTranslationVector.h>
@@ -91,7 +92,7 @@ class vpPoint;
   \f$ ^a{\bf t}_b \f$ is a translation vector.
 
 */
-class VISP_EXPORT vpHomogeneousMatrix : public vpArray2D<double>
+class VISP_EXPORT vpHomogeneousMatrix : public vpFixedArray2D<double, 4, 4>
 {
  public:
   vpHomogeneousMatrix();
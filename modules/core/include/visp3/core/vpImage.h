@@ -50,15 +50,18 @@
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpMemory.h>
 #include <visp3/core/vpRGBa.h>
 #if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
 #  include <visp3/core/vpThread.h>
 #endif
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <iomanip>      // std::setw
 #include <math.h>
+#include <new>
 #include <string.h>
 
 class vpDisplay;
@@ -87,6 +90,35 @@ class vpDisplay;
   if i is the ith rows and j the jth columns the value of this pixel
   is given by I[i][j] (that is equivalent to row[i][j]).
 
+  <h3>Views over external memory</h3>
+  An image can also be a view over memory it does not own, for example a
+  buffer mapped by a frame grabber, a padded camera buffer or a region of
+  another image. In that case, consecutive rows may be separated by a pitch
+  greater than the width (row[i] = bitmap + i*pitch) and the memory is not
+  released when the image is destroyed. See initView().
+
+\code
+unsigned char *buffer; // 640x480 image with rows of 704 bytes provided by a grabber
+vpImage<unsigned char> I;
+I.initView(buffer, 480, 640, 704); // no copy
+vpImage<unsigned char> roi;
+roi.initView(I, 100, 200, 120, 160); // 160x120 region starting at row 100, column 200, no copy
+\endcode
+
+  Pixel accesses through I[i][j], I(i, j), the methods of this class,
+  vpImageConvert and vpImageFilter handle views. vpDisplay and vpImageIo
+  work on a contiguous copy of a view. Other code that uses the bitmap array
+  as a single block of width*height pixels requires isContiguous() to be true;
+  copy the view (vpImage copy constructor) to get a contiguous image.
+  Resizing a view to a different size, or assigning another image to it, makes
+  the image allocate and own a new bitmap.
+
+  <h3>Memory allocation</h3>
+  The bitmap allocated by the image is aligned on vpMemory::alignment bytes.
+  When vpMemory::setPoolEnabled() is used, the bitmaps of destroyed or resized
+  images are recycled by the next images of the same size class, which avoids
+  reallocating temporaries at each iteration of a tracking loop.
+
   <h3>Example</h3>
   The following example available in tutorial-image-manipulation.cpp shows how
   to create gray level and color images and how to access to the pixels.
@@ -152,6 +184,9 @@ public:
   vpImage(unsigned int height, unsigned int width, Type value);
   //! constructor from an image stored as a continuous array in memory
   vpImage(Type * const array, const unsigned int height, const unsigned int width, const bool copyData=false);
+  //! constructor of a view over external memory with a row pitch
+  vpImage(Type * const array, const unsigned int height, const unsigned int width, const unsigned int rowPitch,
+          const bool copyData);
   //! destructor
   virtual ~vpImage();
 
@@ -201,6 +236,14 @@ public:
    */
   inline unsigned int getNumberOfPixel() const{ return npixels; }
 
+  /*!
+    Get the number of elements between the beginning of two consecutive rows.
+    It is equal to the width except for views over external memory.
+
+    \sa isContiguous(), initView()
+  */
+  inline unsigned int getPitch() const { return pitch; }
+
   /*!
 
     Get the number of rows in the image.
@@ -242,8 +285,27 @@ public:
   void init(unsigned int height, unsigned int width, Type value);
   //! init from an image stored as a continuous array in memory
   void init(Type * const array, const unsigned int height, const unsigned int width, const bool copyData=false);
+  //! init as a view over external memory
+  void initView(Type * const array, const unsigned int height, const unsigned int width, const unsigned int rowPitch=0);
+  //! init as a view over a region of another image
+  void initView(vpImage<Type> &src, const unsigned int top, const unsigned int left,
+                const unsigned int height, const unsigned int width);
   void insert(const vpImage<Type> &src, const vpImagePoint &topLeft);
 
+  /*!
+    Return true if the rows are stored one after the other without padding, that is if
+    the bitmap can be accessed as a single array of width*height pixels.
+
+    \sa getPitch()
+  */
+  inline bool isContiguous() const { return pitch == width || height <= 1; }
+  /*!
+    Return true if the image is a view over memory that it does not own.
+
+    \sa initView()
+  */
+  inline bool isView() const { return !ownBitmap; }
+
   //------------------------------------------------------------------
   //         Acces to the image
 
@@ -264,7 +326,7 @@ public:
   */
   inline Type operator()(const unsigned int i, const  unsigned int j) const
   {
-    return bitmap[i*width+j];
+    return bitmap[i*pitch+j];
   }
   /*!
     Set the value \e v of an image point with coordinates (i, j), with i the row position and j
@@ -274,7 +336,7 @@ public:
   inline void  operator()(const unsigned int i, const  unsigned int j,
          const Type &v)
   {
-    bitmap[i*width+j] = v;
+    bitmap[i*pitch+j] = v;
   }
   /*!
     Get the value of an image point.
@@ -292,7 +354,7 @@ public:
     unsigned int i = (unsigned int) ip.get_i();
     unsigned int j = (unsigned int) ip.get_j();
 
-    return bitmap[i*width+j];
+    return bitmap[i*pitch+j];
   }
   /*!
     Set the value of an image point.
@@ -308,7 +370,7 @@ public:
     unsigned int i = (unsigned int) ip.get_i();
     unsigned int j = (unsigned int) ip.get_j();
 
-    bitmap[i*width+j] = v;
+    bitmap[i*pitch+j] = v;
   }
 
   vpImage<Type> operator-(const vpImage<Type> &B);
@@ -349,6 +411,12 @@ private:
   unsigned int width;   ///! number of columns
   unsigned int height;  ///! number of rows
   Type **row;           ///! points the row pointer array
+  unsigned int pitch;   ///! number of elements between two consecutive rows
+  bool ownBitmap;       ///! true if the bitmap is allocated by the image
+  bool alignedBitmap;   ///! true if the bitmap is allocated with vpMemory::allocate()
+
+  void allocateBitmap();
+  void releaseBitmap();
 };
 
 template<class Type>
@@ -639,8 +707,9 @@ vpImage<Type>::init(unsigned int h, unsigned int w, Type value)
 {
   init(h,w);
 
-  for (unsigned int i=0  ; i < npixels ;  i++)
-    bitmap[i] = value;
+  for (unsigned int i=0  ; i < height ;  i++)
+    for (unsigned int j=0  ; j < width ;  j++)
+      row[i][j] = value;
 }
 
 
@@ -677,8 +746,7 @@ vpImage<Type>::init(unsigned int h, unsigned int w)
   {
     if (bitmap != NULL) {
       vpDEBUG_TRACE(10,"Destruction bitmap[]");
-      delete [] bitmap;
-      bitmap = NULL;
+      releaseBitmap();
     }
   }
 
@@ -687,7 +755,11 @@ vpImage<Type>::init(unsigned int h, unsigned int w)
 
   npixels=width*height;
 
-  if (bitmap == NULL)  bitmap = new  Type[npixels];
+  // A view keeps its external memory and pitch when the size does not change
+  if (bitmap == NULL) {
+    allocateBitmap();
+    pitch = width;
+  }
 
   if (bitmap == NULL)
   {
@@ -704,7 +776,7 @@ vpImage<Type>::init(unsigned int h, unsigned int w)
 
   unsigned int i;
   for ( i =0  ; i < height ; i++)
-    row[i] = bitmap + i*width;
+    row[i] = bitmap + i*pitch;
 }
 
 /*!
@@ -730,21 +802,22 @@ vpImage<Type>::init(Type * const array, const unsigned int h, const unsigned int
     }
   }
 
-  //Delete bitmap if copyData==false, otherwise only if the dimension differs
-  if ( (copyData && ((h != this->height) || (w != this->width))) || !copyData ) {
+  //Delete bitmap if copyData==false, otherwise only if the dimension differs or if it is a view
+  if ( (copyData && ((h != this->height) || (w != this->width) || !ownBitmap || pitch != w)) || !copyData ) {
     if (bitmap != NULL) {
-      delete [] bitmap;
-      bitmap = NULL;
+      releaseBitmap();
     }
   }
 
   this->width = w;
   this->height = h;
+  this->pitch = w;
+  this->ownBitmap = true;
 
   npixels = width*height;
 
   if(copyData) {
-    if (bitmap == NULL)  bitmap = new  Type[npixels];
+    if (bitmap == NULL)  allocateBitmap();
 
     if (bitmap == NULL) {
       throw(vpException(vpException::memoryAllocationError,
@@ -769,6 +842,93 @@ vpImage<Type>::init(Type * const array, const unsigned int h, const unsigned int
   }
 }
 
+/*!
+  \brief Image initialization as a view
+
+  Init the image as a view over external memory, without any copy. The memory is
+  not released when the image is destroyed and has to remain valid while the image is used.
+
+  \param array : Address of the first pixel.
+  \param h : Image height.
+  \param w : Image width.
+  \param rowPitch : Number of elements between the beginning of two consecutive rows.
+  If 0, the rows are considered contiguous (\e rowPitch = \e w).
+
+  \exception vpException::dimensionError : \e rowPitch is lower than \e w.
+  \exception vpException::memoryAllocationError
+
+  \sa isView(), getPitch()
+*/
+template<class Type>
+void
+vpImage<Type>::initView(Type * const array, const unsigned int h, const unsigned int w, const unsigned int rowPitch)
+{
+  const unsigned int p = (rowPitch == 0) ? w : rowPitch;
+  if (p < w) {
+    throw(vpException(vpException::dimensionError,
+          "The row pitch (%u) should not be lower than the width (%u)", p, w));
+  }
+
+  if (h != this->height) {
+    if (row != NULL)  {
+      delete [] row;
+      row = NULL;
+    }
+  }
+
+  releaseBitmap();
+
+  bitmap = array;
+  ownBitmap = false;
+  width = w;
+  height = h;
+  pitch = p;
+  npixels = width*height;
+
+  if (row == NULL)  row = new Type*[height];
+  if (row == NULL) {
+    throw(vpException(vpException::memoryAllocationError,
+          "cannot allocate row "));
+  }
+
+  for (unsigned int i = 0  ; i < height ; i++) {
+    row[i] = bitmap + i*pitch;
+  }
+}
+
+/*!
+  \brief Image initialization as a view
+
+  Init the image as a view over a region of another image, without any copy. Modifying
+  the pixels of the view modifies the pixels of \e src. The memory of \e src has to remain
+  valid while the view is used.
+
+  \param src : Image that contains the region.
+  \param top : Row of the top left corner of the region in \e src.
+  \param left : Column of the top left corner of the region in \e src.
+  \param h : Region height.
+  \param w : Region width.
+
+  \exception vpException::dimensionError : The region is not inside \e src.
+  \exception vpException::badValue : \e src is the image itself.
+*/
+template<class Type>
+void
+vpImage<Type>::initView(vpImage<Type> &src, const unsigned int top, const unsigned int left,
+                        const unsigned int h, const unsigned int w)
+{
+  if (&src == this) {
+    throw(vpException(vpException::badValue, "Cannot create a view over the image itself"));
+  }
+  if (top + h > src.getHeight() || left + w > src.getWidth()) {
+    throw(vpException(vpException::dimensionError,
+          "The region [%u, %u] %ux%u is outside the %ux%u image", top, left, w, h,
+          src.getWidth(), src.getHeight()));
+  }
+
+  initView(src.bitmap + top*src.pitch + left, h, w, src.pitch);
+}
+
 /*!
   \brief Constructor
 
@@ -789,7 +949,7 @@ vpImage<Type>::init(Type * const array, const unsigned int h, const unsigned int
 */
 template<class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), pitch(0), ownBitmap(true), alignedBitmap(false)
 {
   init(h,w,0);
 }
@@ -813,7 +973,7 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w)
 */
 template<class Type>
 vpImage<Type>::vpImage (unsigned int h, unsigned int w, Type value)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), pitch(0), ownBitmap(true), alignedBitmap(false)
 {
   init(h,w,value);
 }
@@ -834,11 +994,40 @@ vpImage<Type>::vpImage (unsigned int h, unsigned int w, Type value)
 */
 template<class Type>
 vpImage<Type>::vpImage (Type * const array, const unsigned int h, const unsigned int w, const bool copyData)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), pitch(0), ownBitmap(true), alignedBitmap(false)
 {
   init(array, h, w, copyData);
 }
 
+/*!
+  \brief Constructor
+
+  Construct a vpImage from an array in memory whose rows are separated by \e rowPitch elements.
+
+  \param array : Address of the first pixel.
+  \param h : Image height.
+  \param w : Image width.
+  \param rowPitch : Number of elements between the beginning of two consecutive rows.
+  \param copyData : If false, the image is a view over \e array that is not released when the
+  image is destroyed. Otherwise the data are copied in a contiguous bitmap.
+
+  \sa initView()
+*/
+template<class Type>
+vpImage<Type>::vpImage (Type * const array, const unsigned int h, const unsigned int w, const unsigned int rowPitch,
+                        const bool copyData)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), pitch(0), ownBitmap(true), alignedBitmap(false)
+{
+  if (copyData) {
+    vpImage<Type> view;
+    view.initView(array, h, w, rowPitch);
+    *this = view;
+  }
+  else {
+    initView(array, h, w, rowPitch);
+  }
+}
+
 /*!
   \brief Constructor
 
@@ -850,7 +1039,7 @@ vpImage<Type>::vpImage (Type * const array, const unsigned int h, const unsigned
 */
 template<class Type>
 vpImage<Type>::vpImage()
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), pitch(0), ownBitmap(true), alignedBitmap(false)
 {
 }
 
@@ -908,6 +1097,50 @@ vpImage<Type>::resize(unsigned int h, unsigned int w, const Type &val)
 }
 
 
+/*!
+  Allocate an aligned bitmap of npixels elements with vpMemory::allocate(), so that
+  the buffer can be recycled by the vpMemory pool.
+
+  \exception vpException::memoryAllocationError
+*/
+template<class Type>
+void
+vpImage<Type>::allocateBitmap()
+{
+  // Keep a non NULL bitmap for empty images
+  void *buffer = vpMemory::allocate((npixels > 0 ? npixels : 1) * sizeof(Type));
+  bitmap = static_cast<Type *>(buffer);
+  for (unsigned int i = 0; i < npixels; i++) {
+    ::new (static_cast<void *>(bitmap + i)) Type;
+  }
+  ownBitmap = true;
+  alignedBitmap = true;
+}
+
+/*!
+  Release the bitmap if it is owned by the image and set it to NULL. npixels should
+  still correspond to the released bitmap.
+*/
+template<class Type>
+void
+vpImage<Type>::releaseBitmap()
+{
+  if (bitmap != NULL && ownBitmap) {
+    if (alignedBitmap) {
+      for (unsigned int i = 0; i < npixels; i++) {
+        bitmap[i].~Type();
+      }
+      vpMemory::deallocate(bitmap);
+    }
+    else {
+      // Bitmap given to init(array, h, w) without copy
+      delete [] bitmap;
+    }
+  }
+  bitmap = NULL;
+  alignedBitmap = false;
+}
+
 /*!
   \brief Destructor : Memory de-allocation
 
@@ -925,9 +1158,10 @@ vpImage<Type>::destroy()
   {
   //  vpERROR_TRACE("Deallocate bitmap memory %p",bitmap);
 //    vpDEBUG_TRACE(20,"Deallocate bitmap memory %p",bitmap);
-    delete [] bitmap;
-    bitmap = NULL;
+    releaseBitmap();
   }
+  ownBitmap = true;
+  pitch = 0;
 
 
   if (row!=NULL)
@@ -957,10 +1191,16 @@ vpImage<Type>::~vpImage()
 */
 template<class Type>
 vpImage<Type>::vpImage(const vpImage<Type>& I)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), pitch(0), ownBitmap(true), alignedBitmap(false)
 {
   resize(I.getHeight(),I.getWidth());
-  memcpy(bitmap, I.bitmap, I.npixels*sizeof(Type));
+  if (I.isContiguous()) {
+    memcpy(bitmap, I.bitmap, I.npixels*sizeof(Type));
+  }
+  else {
+    for (unsigned int i = 0; i < height; i++)
+      std::copy(I.row[i], I.row[i] + width, row[i]);
+  }
 }
 
 #ifdef VISP_HAVE_CPP11_COMPATIBILITY
@@ -969,7 +1209,8 @@ vpImage<Type>::vpImage(const vpImage<Type>& I)
 */
 template<class Type>
 vpImage<Type>::vpImage(vpImage<Type> &&I)
-  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row)
+  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row),
+    pitch(I.pitch), ownBitmap(I.ownBitmap), alignedBitmap(I.alignedBitmap)
 {
   I.bitmap = NULL;
   I.display = NULL;
@@ -977,6 +1218,9 @@ vpImage<Type>::vpImage(vpImage<Type> &&I)
   I.width = 0;
   I.height = 0;
   I.row = NULL;
+  I.pitch = 0;
+  I.ownBitmap = true;
+  I.alignedBitmap = false;
 }
 #endif
 
@@ -989,9 +1233,11 @@ template<class Type>
 Type vpImage<Type>::getMaxValue() const
 {
   Type m = bitmap[0];
-  for (unsigned int i=0 ; i < npixels ; i++)
+  for (unsigned int i=0 ; i < height ; i++)
   {
-    if (bitmap[i]>m) m = bitmap[i];
+    const Type *p = row[i];
+    for (unsigned int j=0 ; j < width ; j++)
+      if (p[j]>m) m = p[j];
   }
   return m;
 }
@@ -1005,8 +1251,12 @@ template<class Type>
 Type vpImage<Type>::getMinValue() const
 {
   Type m =  bitmap[0];
-  for (unsigned int i=0 ; i < npixels ; i++)
-    if (bitmap[i]<m) m = bitmap[i];
+  for (unsigned int i=0 ; i < height ; i++)
+  {
+    const Type *p = row[i];
+    for (unsigned int j=0 ; j < width ; j++)
+      if (p[j]<m) m = p[j];
+  }
   return m;
 }
 
@@ -1021,10 +1271,14 @@ template<class Type>
 void vpImage<Type>::getMinMaxValue(Type &min, Type &max) const
 {
   min = max =  bitmap[0];
-  for (unsigned int i=0 ; i < npixels ; i++)
+  for (unsigned int i=0 ; i < height ; i++)
   {
-    if (bitmap[i]<min) min = bitmap[i];
-    if (bitmap[i]>max) max = bitmap[i];
+    const Type *p = row[i];
+    for (unsigned int j=0 ; j < width ; j++)
+    {
+      if (p[j]<min) min = p[j];
+      if (p[j]>max) max = p[j];
+    }
   }
 }
 
@@ -1054,8 +1308,9 @@ vpImage<Type> & vpImage<Type>::operator=(vpImage<Type> other)
 template<class Type>
 vpImage<Type>& vpImage<Type>::operator=(const Type &v)
 {
-  for (unsigned int i=0 ; i < npixels ; i++)
-    bitmap[i] = v;
+  for (unsigned int i=0 ; i < height ; i++)
+    for (unsigned int j=0 ; j < width ; j++)
+      row[i][j] = v;
 
   return *this;
 }
@@ -1074,11 +1329,13 @@ bool vpImage<Type>::operator==(const vpImage<Type> &I)
     return false;
 
 //  printf("wxh: %dx%d bitmap: %p I.bitmap %p\n", width, height, bitmap, I.bitmap);
-  for (unsigned int i=0 ; i < npixels ; i++)
+  for (unsigned int i=0 ; i < height ; i++)
   {
-    if (bitmap[i] != I.bitmap[i]) {
-//      std::cout << "differ for pixel " << i << " (" << i%this->height << ", " << i - i%this->height << ")" << std::endl;
-      return false;
+    for (unsigned int j=0 ; j < width ; j++)
+    {
+      if (row[i][j] != I.row[i][j]) {
+        return false;
+      }
     }
   }
   return true;
@@ -1189,8 +1446,8 @@ void vpImage<Type>::insert(const vpImage<Type> &src, const vpImagePoint &topLeft
 
   for (int i = 0; i < hsize; i++)
   {
-    Type *srcBitmap = src.bitmap + ((src_ibegin+i)*src_w+src_jbegin);
-    Type *destBitmap = this->bitmap + ((dest_ibegin+i)*dest_w+dest_jbegin);
+    Type *srcBitmap = src.row[src_ibegin+i] + src_jbegin;
+    Type *destBitmap = this->row[dest_ibegin+i] + dest_jbegin;
 
     memcpy(destBitmap, srcBitmap, (size_t)wsize*sizeof(Type));
   }
@@ -1699,9 +1956,10 @@ void vpImage<Type>::sub(const vpImage<Type> &B, vpImage<Type> &C)
           "vpImage mismatch in vpImage/vpImage substraction "));
   }
 
-  for (unsigned int i=0;i<this->getWidth()*this->getHeight();i++)
+  for (unsigned int i=0;i<this->getHeight();i++)
   {
-    *(C.bitmap + i) = *(bitmap + i) - *(B.bitmap + i);
+    for (unsigned int j=0;j<this->getWidth();j++)
+      C.row[i][j] = row[i][j] - B.row[i][j];
   }
 }
 
@@ -1739,9 +1997,10 @@ void vpImage<Type>::sub(const vpImage<Type> &A, const vpImage<Type> &B,
                       "vpImage mismatch in vpImage/vpImage substraction "));
   }
 
-  for (unsigned int i=0;i<A.getWidth()*A.getHeight();i++)
+  for (unsigned int i=0;i<A.getHeight();i++)
   {
-    *(C.bitmap + i) = *(A.bitmap + i) - *(B.bitmap + i);
+    for (unsigned int j=0;j<A.getWidth();j++)
+      C.row[i][j] = A.row[i][j] - B.row[i][j];
   }
 }
 
@@ -1768,6 +2027,15 @@ void vpImage<Type>::performLut(const Type (&)[256], const unsigned int)
 */
 template<>
 inline void vpImage<unsigned char>::performLut(const unsigned char (&lut)[256], const unsigned int nbThreads) {
+  if (!isContiguous()) {
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        row[i][j] = lut[row[i][j]];
+      }
+    }
+    return;
+  }
+
   unsigned int size = getWidth()*getHeight();
   unsigned char *ptrStart = (unsigned char*) bitmap;
   unsigned char *ptrEnd = ptrStart + size;
@@ -1846,6 +2114,19 @@ inline void vpImage<unsigned char>::performLut(const unsigned char (&lut)[256],
 */
 template<>
 inline void vpImage<vpRGBa>::performLut(const vpRGBa (&lut)[256], const unsigned int nbThreads) {
+  if (!isContiguous()) {
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        vpRGBa &p = row[i][j];
+        p.R = lut[p.R].R;
+        p.G = lut[p.G].G;
+        p.B = lut[p.B].B;
+        p.A = lut[p.A].A;
+      }
+    }
+    return;
+  }
+
   unsigned int size = getWidth()*getHeight();
   unsigned char *ptrStart = (unsigned char*) bitmap;
   unsigned char *ptrEnd = ptrStart + size*4;
@@ -1932,6 +2213,9 @@ void swap(vpImage<Type> &first, vpImage<Type> &second) {
   swap(first.width, second.width);
   swap(first.height, second.height);
   swap(first.row, second.row);
+  swap(first.pitch, second.pitch);
+  swap(first.ownBitmap, second.ownBitmap);
+  swap(first.alignedBitmap, second.alignedBitmap);
 }
 
 #endif
@@ -68,13 +68,17 @@
 class VISP_EXPORT vpImageFilter
 {
 public:
-#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   static void canny(const vpImage<unsigned char>& I,
                     vpImage<unsigned char>& Ic,
                     const unsigned int gaussianFilterSize,
                     const double thresholdCanny,
                     const unsigned int apertureSobel);
-#endif
+  static void canny(const vpImage<unsigned char>& I,
+                    vpImage<unsigned char>& Ic,
+                    const unsigned int gaussianFilterSize,
+                    const double lowerThreshold,
+                    const double upperThreshold,
+                    const unsigned int apertureSobel);
 
   /*!
    Apply a 1x3 derivative filter to an image pixel.
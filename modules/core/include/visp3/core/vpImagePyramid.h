@@ -0,0 +1,131 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Gaussian image pyramid with lazy level construction.
+ *
+ *****************************************************************************/
+
+#ifndef vpImagePyramid_H
+#define vpImagePyramid_H
+
+/*!
+  \file vpImagePyramid.h
+  \brief Gaussian image pyramid with lazy level construction.
+*/
+
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+
+/*!
+  \class vpImagePyramid
+
+  \ingroup group_core_image
+
+  \brief Gaussian pyramid of a grayscale image whose levels are computed on demand
+  and cached until the source frame changes.
+
+  Level 0 is the source image itself (no copy is done, the source image has to
+  remain valid while the pyramid is used). Level \f$ l \f$ is obtained from level
+  \f$ l-1 \f$ using vpImageFilter::getGaussPyramidal() and has a size divided by
+  \f$ 2^l \f$.
+
+  The pyramid is keyed on the source frame: setImage(I, frameId) only invalidates the
+  cached levels when the image or the frame identifier changes. This allows to share a
+  single pyramid between several consumers (for example several vpTemplateTracker
+  instances) that process the same frame, the levels being computed only once.
+
+  \code
+#include <visp3/core/vpImagePyramid.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640);
+  vpImagePyramid pyramid(4);
+  unsigned long frame = 0;
+
+  for (;;) {
+    // ... acquire I
+    pyramid.setImage(I, frame++);
+    const vpImage<unsigned char> &I2 = pyramid.getLevel(2); // levels 1 and 2 are computed
+    const vpImage<unsigned char> &I1 = pyramid.getLevel(1); // already available
+    // ...
+  }
+}
+  \endcode
+
+  \warning Levels are computed lazily by getLevel() which modifies the pyramid. When
+  the pyramid is shared between threads, call build() before reading the levels.
+*/
+class VISP_EXPORT vpImagePyramid
+{
+public:
+  explicit vpImagePyramid(const unsigned int nbLevels=4);
+  vpImagePyramid(const vpImage<unsigned char> &I, const unsigned int nbLevels);
+  virtual ~vpImagePyramid() {}
+
+  void build();
+  void clear();
+
+  /*!
+    Return the identifier of the frame given to setImage(), or 0 if not set.
+  */
+  inline unsigned long getFrameId() const { return m_frameId; }
+  const vpImage<unsigned char> &getLevel(const unsigned int level);
+  /*!
+    Return the number of levels of the pyramid, including the source image.
+  */
+  inline unsigned int getNbLevels() const { return m_nbLevels; }
+  /*!
+    Return a pointer to the source image, or NULL if no image was set.
+  */
+  inline const vpImage<unsigned char> *getImage() const { return m_image; }
+
+  bool isComputed(const unsigned int level) const;
+
+  void setImage(const vpImage<unsigned char> &I);
+  bool setImage(const vpImage<unsigned char> &I, const unsigned long frameId);
+  void setNbLevels(const unsigned int nbLevels);
+
+private:
+  //! Source image (level 0)
+  const vpImage<unsigned char> *m_image;
+  //! Identifier of the source frame
+  unsigned long m_frameId;
+  //! Number of levels including the source image
+  unsigned int m_nbLevels;
+  //! Cached levels, m_levels[l-1] corresponding to level l
+  std::vector<vpImage<unsigned char> > m_levels;
+  //! Number of levels above the source image that are up to date
+  unsigned int m_nbComputed;
+};
+
+#endif
@@ -59,6 +59,7 @@
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpCameraParameters.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <math.h>
@@ -430,13 +431,15 @@ inline void vpImageTools::binarise(vpImage<Type> &I,
   }
 
   Type v;
-  Type *p = I.bitmap;
-  Type *pend = I.bitmap + I.getWidth()*I.getHeight();
-  for (; p < pend; p ++) {
-    v = *p;
-    if (v < threshold1) *p = value1;
-    else if (v > threshold2) *p = value3;
-    else *p = value2;
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    Type *p = I[i];
+    Type *pend = p + I.getWidth();
+    for (; p < pend; p ++) {
+      v = *p;
+      if (v < threshold1) *p = value1;
+      else if (v > threshold2) *p = value3;
+      else *p = value2;
+    }
   }
 }
 
@@ -466,13 +469,15 @@ inline void vpImageTools::binarise(vpImage<unsigned char> &I,
 
     I.performLut(lut);
   } else {
-    unsigned char *p = I.bitmap;
-    unsigned char *pend = I.bitmap + I.getWidth()*I.getHeight();
-    for (; p < pend; p ++) {
-      unsigned char v = *p;
-      if (v < threshold1) *p = value1;
-      else if (v > threshold2) *p = value3;
-      else *p = value2;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      unsigned char *p = I[i];
+      unsigned char *pend = p + I.getWidth();
+      for (; p < pend; p ++) {
+        unsigned char v = *p;
+        if (v < threshold1) *p = value1;
+        else if (v > threshold2) *p = value3;
+        else *p = value2;
+      }
     }
   }
 }
@@ -610,6 +615,15 @@ void vpImageTools::undistort(const vpImage<Type> &I,
                              const vpCameraParameters &cam,
                              vpImage<Type> &undistI)
 {
+  if (!I.isContiguous() || !undistI.isContiguous()) {
+    // Undistort a contiguous copy, the result is then copied row by row
+    vpImage<Type> Iundist;
+    undistort(vpImage<Type>(I), cam, Iundist);
+    undistI.resize(Iundist.getHeight(), Iundist.getWidth());
+    undistI.insert(Iundist, vpImagePoint(0, 0));
+    return;
+  }
+
 #ifdef VISP_HAVE_PTHREAD
   //
   // Optimized version using pthreads
@@ -788,8 +802,7 @@ void vpImageTools::flip(const vpImage<Type> &I,
 
     for (unsigned int i = 0; i < height; i++)
     {
-      memcpy(newI.bitmap+i*width, I.bitmap+(height-1-i)*width,
-             width*sizeof(Type));
+      std::copy(I[height-1-i], I[height-1-i] + width, newI[i]);
     }
 }
 
@@ -829,21 +842,13 @@ void vpImageTools::flip(vpImage<Type> &I)
 {
     unsigned int height = 0, width = 0;
     unsigned int i = 0;
-    vpImage<Type> Ibuf;
 
     height = I.getHeight();
     width = I.getWidth();
-    Ibuf.resize(1, width);
 
     for ( i = 0; i < height/2; i++)
     {
-      memcpy(Ibuf.bitmap, I.bitmap+i*width,
-             width*sizeof(Type));
-
-      memcpy(I.bitmap+i*width, I.bitmap+(height-1-i)*width,
-             width*sizeof(Type));
-      memcpy(I.bitmap+(height-1-i)*width, Ibuf.bitmap,
-             width*sizeof(Type));
+      std::swap_ranges(I[i], I[i] + width, I[height-1-i]);
     }
 }
 
@@ -158,7 +158,7 @@ class VISP_EXPORT vpMatrix : public vpArray2D<double>
   void clear()
   {
     if (data != NULL ) {
-      free(data);
+      vpMemory::deallocate(data);
       data=NULL;
     }
 
@@ -534,12 +534,14 @@ class VISP_EXPORT vpMatrix : public vpArray2D<double>
   static void add2Matrices(const vpColVector &A, const vpColVector &B, vpColVector &C);
   static void add2WeightedMatrices(const vpMatrix &A, const double &wA, const vpMatrix &B,const double &wB, vpMatrix &C);
   static void computeHLM(const vpMatrix &H, const double &alpha, vpMatrix &HLM);
+  static unsigned int getLapackMatrixMinSize();
   static void mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C);
   static void mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpRotationMatrix &C);
   static void mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpHomogeneousMatrix &C);
   static void mult2Matrices(const vpMatrix &A, const vpColVector &B, vpColVector &C);
   static void multMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVector &w);
   static void negateMatrix(const vpMatrix &A, vpMatrix &C);
+  static void setLapackMatrixMinSize(const unsigned int min_size);
   static void sub2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C);
   static void sub2Matrices(const vpColVector &A, const vpColVector &B, vpColVector &C);
   //@}
@@ -696,7 +698,13 @@ class VISP_EXPORT vpMatrix : public vpArray2D<double>
                          const int incx, double beta, double * y_data, const int incy);
 #endif
 
+  static void builtin_dgemm(const vpMatrix &A, const vpMatrix &B, vpMatrix &C);
+  static void builtin_dgemv(const vpMatrix &A, const vpColVector &v, vpColVector &w);
+  static void builtin_dsyrk(const vpMatrix &A, vpMatrix &B);
+
   static void computeCovarianceMatrixVVS(const vpHomogeneousMatrix &cMo, const vpColVector &deltaS, const vpMatrix &Ls, vpMatrix &Js, vpColVector &deltaP);
+
+  static unsigned int m_lapack_min_size;
 };
 
 
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Aligned memory allocation with an optional per-thread buffer pool.
+ *
+ *****************************************************************************/
+
+#ifndef __vpMemory_h_
+#define __vpMemory_h_
+
+/*!
+  \file vpMemory.h
+  \brief Aligned memory allocation with an optional per-thread buffer pool.
+*/
+
+#include <cstddef>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \ingroup group_core_tools
+  \brief Aligned memory allocation used for the storage of vpImage and vpArray2D.
+
+  All the buffers returned by vpMemory::allocate() are aligned on
+  vpMemory::alignment bytes, which allows aligned SIMD loads and stores on the
+  first element of an image or a matrix.
+
+  When the pool is enabled with vpMemory::setPoolEnabled(), released buffers are
+  not given back to the system but kept in a pool owned by the calling thread,
+  sorted by size classes. A later allocation of a similar size done by the same
+  thread reuses a pooled buffer. This removes most of the allocations done in
+  tracking loops where temporaries of the same shape (gradient images, Jacobians,
+  residual vectors) are created at each frame.
+
+  \code
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMemory.h>
+
+int main()
+{
+  vpMemory::setPoolEnabled(true);
+  for (unsigned int i = 0; i < 100; i++) {
+    vpImage<unsigned char> I(480, 640); // The bitmap is recycled after the first iteration
+    // ...
+  }
+  vpMemory::clearPool();
+}
+  \endcode
+
+  Each thread owns its pool, so that no lock is needed. A buffer released by
+  another thread than the one that allocated it goes to the pool of the releasing
+  thread. The pooled buffers are released when the thread exits or when
+  clearPool() is called. The pool is only available when ViSP is built with
+  pthread support, otherwise setPoolEnabled() has no effect.
+*/
+namespace vpMemory {
+  //! Alignment in bytes of the buffers returned by allocate()
+  static const size_t alignment = 64;
+
+  VISP_EXPORT void *allocate(const size_t size);
+  VISP_EXPORT size_t capacity(const void *ptr);
+  VISP_EXPORT void clearPool();
+  VISP_EXPORT void deallocate(void *ptr);
+  VISP_EXPORT size_t getPoolMaxSize();
+  VISP_EXPORT size_t getPoolSize();
+  VISP_EXPORT bool isPoolEnabled();
+  VISP_EXPORT void setPoolEnabled(const bool enable);
+  VISP_EXPORT void setPoolMaxSize(const size_t size);
+}
+
+#endif
@@ -0,0 +1,178 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Point cloud with a contiguous storage of the coordinates.
+ *
+ *****************************************************************************/
+#ifndef __vpPointCloud_h_
+#define __vpPointCloud_h_
+
+/*!
+  \file vpPointCloud.h
+  \brief Point cloud with a contiguous storage of the coordinates.
+*/
+
+#include <stdint.h>
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+/*!
+  \class vpPointCloud
+  \ingroup group_core_geometry
+
+  \brief Point cloud whose X, Y, Z coordinates are packed as floats in a single
+  contiguous buffer.
+
+  Contrary to a std::vector<vpColVector>, which needs one memory allocation per
+  point, filling a vpPointCloud does not allocate memory once the buffer has
+  reached its size. Reusing the same vpPointCloud from one frame to the next of a
+  RGB-D sequence is thus allocation free.
+
+  A point cloud acquired by a depth camera is organized: it has the width and
+  the height of the depth image and the point (i, j) is stored at the index
+  i*getWidth()+j. An unorganized cloud has a height of 1.
+
+  A point is valid when its depth is strictly positive, which is the convention
+  used by the depth trackers and the RGB-D grabbers to mark missing
+  measurements. An optional validity mask, allocated at the first call to
+  setValid(), allows to also discard points having a positive depth.
+
+  \code
+#include <visp3/core/vpPointCloud.h>
+
+int main()
+{
+  vpPointCloud cloud(640, 480);
+  for (unsigned int i = 0; i < cloud.getHeight(); i++) {
+    for (unsigned int j = 0; j < cloud.getWidth(); j++) {
+      cloud.set(i*cloud.getWidth() + j, 0.001f*j, 0.001f*i, 1.0f);
+    }
+  }
+  const float *p = cloud(240, 320); // X, Y, Z of the point seen by the pixel (240, 320)
+  (void) p;
+}
+  \endcode
+
+  The depth trackers of the mbt module (vpMbGenericTracker,
+  vpMbDepthDenseTracker, vpMbDepthNormalTracker) accept a vpPointCloud as input.
+*/
+class VISP_EXPORT vpPointCloud
+{
+public:
+  vpPointCloud();
+  vpPointCloud(const unsigned int width, const unsigned int height=1);
+  vpPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height);
+
+  void buildFrom(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height);
+  void buildFrom(const vpImage<float> &depth, const vpCameraParameters &cam, const float depth_scale=1.0f);
+  void buildFrom(const vpImage<uint16_t> &depth, const vpCameraParameters &cam, const float depth_scale);
+
+  void clear();
+  void clearValidityMask();
+
+  /*!
+    Return the address of the coordinates, stored as X0, Y0, Z0, X1, Y1, Z1, ...
+  */
+  inline float *data() { return m_points.empty() ? NULL : &m_points[0]; }
+  //! \copydoc data()
+  inline const float *data() const { return m_points.empty() ? NULL : &m_points[0]; }
+
+  inline bool empty() const { return m_points.empty(); }
+  inline unsigned int getHeight() const { return m_height; }
+  unsigned int getNbValidPoints() const;
+  inline unsigned int getWidth() const { return m_width; }
+  inline bool hasValidityMask() const { return !m_mask.empty(); }
+  inline bool isOrganized() const { return m_height > 1; }
+
+  /*!
+    Return true if the point at index \e index has a positive depth and is not
+    discarded by the validity mask.
+  */
+  inline bool isValid(const unsigned int index) const
+  {
+    return m_points[3*index + 2] > 0 && (m_mask.empty() || m_mask[index] != 0);
+  }
+
+  void resize(const unsigned int width, const unsigned int height=1);
+
+  /*!
+    Set the coordinates of the point at index \e index.
+  */
+  inline void set(const unsigned int index, const float X, const float Y, const float Z)
+  {
+    float *p = &m_points[3*index];
+    p[0] = X;
+    p[1] = Y;
+    p[2] = Z;
+  }
+
+  void setValid(const unsigned int index, const bool valid);
+
+  inline unsigned int size() const { return m_width*m_height; }
+
+  void toVector(std::vector<vpColVector> &point_cloud) const;
+
+  /*!
+    Return the address of the X, Y, Z coordinates of the point at index \e index,
+    so that cloud[index][2] is the depth of the point like for a
+    std::vector<vpColVector>.
+  */
+  inline float *operator[](const unsigned int index) { return &m_points[3*index]; }
+  //! \copydoc operator[]()
+  inline const float *operator[](const unsigned int index) const { return &m_points[3*index]; }
+
+  /*!
+    Return the address of the X, Y, Z coordinates of the point seen by the pixel
+    (\e i, \e j) of an organized point cloud.
+  */
+  inline float *operator()(const unsigned int i, const unsigned int j) { return &m_points[3*(i*m_width + j)]; }
+  //! \copydoc operator()()
+  inline const float *operator()(const unsigned int i, const unsigned int j) const
+  {
+    return &m_points[3*(i*m_width + j)];
+  }
+
+private:
+  //! X, Y, Z coordinates of the points
+  std::vector<float> m_points;
+  //! Optional validity flag of each point
+  std::vector<unsigned char> m_mask;
+  //! Number of points per row
+  unsigned int m_width;
+  //! Number of rows
+  unsigned int m_height;
+};
+
+#endif
@@ -134,6 +134,7 @@ class VISP_EXPORT vpPolygon
     void initClick(const vpImage<vpRGBa>& I, unsigned int size=5, const vpColor &color=vpColor::red, unsigned int thickness=1);
 
     bool isInside(const vpImagePoint &iP, const PointInPolygonMethod &method=PnPolyRayCasting) const;
+    void getScanLineIntersections(const double v, std::vector<double> &u) const;
 
     void display(const vpImage<unsigned char>& I, const vpColor& color, unsigned int thickness=1) const;
 
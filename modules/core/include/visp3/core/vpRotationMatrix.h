@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedArray2D.h>
 #include <visp3/core/vpRxyzVector.h>
 #include <visp3/core/vpRzyxVector.h>
 #include <visp3/core/vpRzyzVector.h>
@@ -68,7 +69,7 @@
   The vpRotationMatrix class is derived from vpArray2D<double>.
 
 */
-class VISP_EXPORT vpRotationMatrix : public vpArray2D<double>
+class VISP_EXPORT vpRotationMatrix : public vpFixedArray2D<double, 3, 3>
 {
 public:
   vpRotationMatrix();
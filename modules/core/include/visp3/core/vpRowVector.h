@@ -96,7 +96,7 @@ public:
   void clear()
   {
     if (data != NULL ) {
-      free(data);
+      vpMemory::deallocate(data);
       data=NULL;
     }
 
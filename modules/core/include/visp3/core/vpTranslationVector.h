@@ -48,6 +48,7 @@
 */
 
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedArray2D.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpPoseVector.h>
@@ -91,7 +92,7 @@ int main()
 }
   \endcode
 */
-class VISP_EXPORT vpTranslationVector : public vpArray2D<double>
+class VISP_EXPORT vpTranslationVector : public vpFixedArray2D<double, 3, 1>
 {
 public:
 
@@ -99,7 +100,7 @@ public:
       Default constructor.
       The translation vector is initialized to zero.
     */
-  vpTranslationVector() : vpArray2D<double>(3, 1) {};
+  vpTranslationVector() : vpFixedArray2D<double, 3, 1>() {};
   vpTranslationVector(const double tx, const double ty, const double tz) ;
   vpTranslationVector(const vpTranslationVector &tv);
   explicit vpTranslationVector(const vpHomogeneousMatrix &M);
@@ -41,6 +41,7 @@
 #define vpVelocityRwistMatrix_h
 
 #include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpFixedArray2D.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
@@ -109,7 +110,7 @@ int main()
 }
   \endcode
 */
-class VISP_EXPORT vpVelocityTwistMatrix : public vpArray2D<double>
+class VISP_EXPORT vpVelocityTwistMatrix : public vpFixedArray2D<double, 6, 6>
 {
   friend class vpMatrix;
 
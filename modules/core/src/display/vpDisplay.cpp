@@ -148,6 +148,13 @@ int main()
 void
 vpDisplay::getImage(const vpImage<unsigned  char> &Isrc, vpImage<vpRGBa> &Idest )
 {
+  if (!Idest.isContiguous()) {
+    vpImage<vpRGBa> Icopy;
+    vpDisplay::getImage(Isrc, Icopy);
+    Idest = Icopy;
+    return;
+  }
+
   if ( Isrc.display != NULL )
   {
     ( Isrc.display )->getImage ( Idest );
@@ -226,6 +233,13 @@ int main()
 void
 vpDisplay::getImage(const vpImage<vpRGBa> &Isrc, vpImage<vpRGBa> &Idest)
 {
+  if (!Idest.isContiguous()) {
+    vpImage<vpRGBa> Icopy;
+    vpDisplay::getImage(Isrc, Icopy);
+    Idest = Icopy;
+    return;
+  }
+
   if ( Isrc.display != NULL )
   {
     ( Isrc.display )->getImage ( Idest );
@@ -17,7 +17,13 @@ vp_display_display(const vpImage<Type> &I)
 {
   if ( I.display != NULL )
   {
-    ( I.display )->displayImage ( I );
+    if (I.isContiguous()) {
+      ( I.display )->displayImage ( I );
+    }
+    else {
+      // The display back-ends read the bitmap as width*height consecutive pixels
+      ( I.display )->displayImage ( vpImage<Type>(I) );
+    }
   }
 
 }
@@ -488,7 +494,12 @@ vp_display_display_roi(const vpImage<Type> &I, const vpRect &roi)
 
   if ( I.display != NULL )
   {
-    ( I.display )->displayImageROI ( I , vpImagePoint(top,left), (unsigned int)roiwidth,(unsigned int)roiheight );
+    if (I.isContiguous()) {
+      ( I.display )->displayImageROI ( I , vpImagePoint(top,left), (unsigned int)roiwidth,(unsigned int)roiheight );
+    }
+    else {
+      ( I.display )->displayImageROI ( vpImage<Type>(I) , vpImagePoint(top,left), (unsigned int)roiwidth,(unsigned int)roiheight );
+    }
   }
 }
 
@@ -72,6 +72,241 @@ int vpImageConvert::vpCgb[256];
 int vpImageConvert::vpCgr[256];
 int vpImageConvert::vpCbb[256];
 
+namespace {
+// Below this number of pixels, the conversions are done using a single thread
+const unsigned int vpImageConvertParallelMinSize = 640*480;
+
+#if VISP_HAVE_SSE2
+/*!
+  Compute (int)((c - 128) * coef) for 8 chroma values stored as 16-bit lanes. The product is done
+  on integers as (|c - 128| * m) >> 16, \e m being chosen to give exactly the same result as the
+  double precision expression for all the values of c.
+*/
+inline __m128i scaleChroma(const __m128i &c, const __m128i &m)
+{
+  const __m128i x = _mm_sub_epi16(c, _mm_set1_epi16(128));
+  const __m128i sign = _mm_srai_epi16(x, 15);
+  const __m128i ax = _mm_sub_epi16(_mm_xor_si128(x, sign), sign);
+  const __m128i q = _mm_mulhi_epu16(ax, m);
+  return _mm_sub_epi16(_mm_xor_si128(q, sign), sign);
+}
+
+/*!
+  Compute the chroma contributions V2 = 2*V, UV = -U-V and U5 = 5*U of the YUV to RGB
+  conversion used by YUV422ToRGBa() and YUV420ToRGBa() for 8 (u, v) samples stored
+  as 16-bit lanes.
+*/
+inline void computeChroma(const __m128i &u, const __m128i &v, __m128i &V2, __m128i &UV, __m128i &U5)
+{
+  // 23199 / 65536 ~ 0.354 and 46328 / 65536 ~ 0.707
+  const __m128i U = scaleChroma(u, _mm_set1_epi16(23199));
+  const __m128i V = scaleChroma(v, _mm_set1_epi16((short)46328));
+  V2 = _mm_add_epi16(V, V);
+  UV = _mm_sub_epi16(_mm_setzero_si128(), _mm_add_epi16(U, V));
+  U5 = _mm_add_epi16(_mm_slli_epi16(U, 2), U);
+}
+
+/*!
+  Interleave 16 R, G, B and A values and store the 16 RGBa pixels.
+*/
+inline void storeRGBa(unsigned char *rgba, const __m128i &r, const __m128i &g, const __m128i &b, const __m128i &a)
+{
+  const __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+  const __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+  const __m128i ba_lo = _mm_unpacklo_epi8(b, a);
+  const __m128i ba_hi = _mm_unpackhi_epi8(b, a);
+  _mm_storeu_si128((__m128i *) rgba,        _mm_unpacklo_epi16(rg_lo, ba_lo));
+  _mm_storeu_si128((__m128i *) (rgba + 16), _mm_unpackhi_epi16(rg_lo, ba_lo));
+  _mm_storeu_si128((__m128i *) (rgba + 32), _mm_unpacklo_epi16(rg_hi, ba_hi));
+  _mm_storeu_si128((__m128i *) (rgba + 48), _mm_unpackhi_epi16(rg_hi, ba_hi));
+}
+
+/*!
+  Convert 16 pixels to RGBa, each chroma contribution of the 16-bit lanes of \e V2, \e UV
+  and \e U5 being shared by two consecutive pixels. Values are saturated in [0, 255].
+*/
+inline void YUVToRGBa16(const __m128i &y, const __m128i &V2, const __m128i &UV, const __m128i &U5,
+                        unsigned char *rgba)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i y_lo = _mm_unpacklo_epi8(y, zero);
+  const __m128i y_hi = _mm_unpackhi_epi8(y, zero);
+  const __m128i r = _mm_packus_epi16(_mm_add_epi16(y_lo, _mm_unpacklo_epi16(V2, V2)),
+                                     _mm_add_epi16(y_hi, _mm_unpackhi_epi16(V2, V2)));
+  const __m128i g = _mm_packus_epi16(_mm_add_epi16(y_lo, _mm_unpacklo_epi16(UV, UV)),
+                                     _mm_add_epi16(y_hi, _mm_unpackhi_epi16(UV, UV)));
+  const __m128i b = _mm_packus_epi16(_mm_add_epi16(y_lo, _mm_unpacklo_epi16(U5, U5)),
+                                     _mm_add_epi16(y_hi, _mm_unpackhi_epi16(U5, U5)));
+  storeRGBa(rgba, r, g, b, _mm_set1_epi8((char)vpRGBa::alpha_default));
+}
+#endif
+
+/*!
+  Convert a row of \e n floating point values to unsigned char as
+  255 * (src - min) / (max - min) saturated in [0, 255].
+*/
+void normalizeRow(const float *src, unsigned char *dst, const unsigned int n, const float min, const float max)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128 vmin = _mm_set1_ps(min);
+    const __m128 range = _mm_set1_ps(max - min);
+    const __m128 scale = _mm_set1_ps(255.f);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+      __m128 v0 = _mm_div_ps(_mm_mul_ps(scale, _mm_sub_ps(_mm_loadu_ps(src + i), vmin)), range);
+      __m128 v1 = _mm_div_ps(_mm_mul_ps(scale, _mm_sub_ps(_mm_loadu_ps(src + i + 4), vmin)), range);
+      v0 = _mm_min_ps(_mm_max_ps(v0, zero), scale);
+      v1 = _mm_min_ps(_mm_max_ps(v1, zero), scale);
+      const __m128i v = _mm_packs_epi32(_mm_cvttps_epi32(v0), _mm_cvttps_epi32(v1));
+      _mm_storel_epi64((__m128i *) (dst + i), _mm_packus_epi16(v, v));
+    }
+  }
+#endif
+
+  for (; i < n; i++) {
+    float val = 255.f * (src[i] - min) / (max - min);
+    if(val < 0)
+      dst[i] = 0;
+    else if(val > 255)
+      dst[i] = 255;
+    else
+      dst[i] = (unsigned char)val;
+  }
+}
+
+/*!
+  Convert a row of \e n double values to unsigned char as
+  255 * (src - min) / (max - min) saturated in [0, 255].
+*/
+void normalizeRow(const double *src, unsigned char *dst, const unsigned int n, const double min, const double max)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128d vmin = _mm_set1_pd(min);
+    const __m128d range = _mm_set1_pd(max - min);
+    const __m128d scale = _mm_set1_pd(255.);
+    const __m128d zero = _mm_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+      __m128d v0 = _mm_div_pd(_mm_mul_pd(scale, _mm_sub_pd(_mm_loadu_pd(src + i), vmin)), range);
+      __m128d v1 = _mm_div_pd(_mm_mul_pd(scale, _mm_sub_pd(_mm_loadu_pd(src + i + 2), vmin)), range);
+      v0 = _mm_min_pd(_mm_max_pd(v0, zero), scale);
+      v1 = _mm_min_pd(_mm_max_pd(v1, zero), scale);
+      const __m128i v = _mm_unpacklo_epi64(_mm_cvttpd_epi32(v0), _mm_cvttpd_epi32(v1));
+      const __m128i v16 = _mm_packs_epi32(v, v);
+      const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+      memcpy(dst + i, &packed, 4);
+    }
+  }
+#endif
+
+  for (; i < n; i++) {
+    double val = 255. * (src[i] - min) / (max - min);
+    if(val < 0)
+      dst[i] = 0;
+    else if(val > 255)
+      dst[i] = 255;
+    else
+      dst[i] = (unsigned char)val;
+  }
+}
+
+/*!
+  Convert a row of \e n unsigned char values to float.
+*/
+void castRow(const unsigned char *src, float *dst, const unsigned int n)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+      const __m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+      const __m128i lo = _mm_unpacklo_epi8(v, zero);
+      const __m128i hi = _mm_unpackhi_epi8(v, zero);
+      _mm_storeu_ps(dst + i,      _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)));
+      _mm_storeu_ps(dst + i + 4,  _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)));
+      _mm_storeu_ps(dst + i + 8,  _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)));
+      _mm_storeu_ps(dst + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)));
+    }
+  }
+#endif
+
+  for (; i < n; i++) {
+    dst[i] = (float)src[i];
+  }
+}
+
+/*!
+  Convert a row of \e n unsigned char values to double.
+*/
+void castRow(const unsigned char *src, double *dst, const unsigned int n)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+      const __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (src + i)), zero);
+      const __m128i lo = _mm_unpacklo_epi16(v, zero);
+      const __m128i hi = _mm_unpackhi_epi16(v, zero);
+      _mm_storeu_pd(dst + i,     _mm_cvtepi32_pd(lo));
+      _mm_storeu_pd(dst + i + 2, _mm_cvtepi32_pd(_mm_srli_si128(lo, 8)));
+      _mm_storeu_pd(dst + i + 4, _mm_cvtepi32_pd(hi));
+      _mm_storeu_pd(dst + i + 6, _mm_cvtepi32_pd(_mm_srli_si128(hi, 8)));
+    }
+  }
+#endif
+
+  for (; i < n; i++) {
+    dst[i] = (double)src[i];
+  }
+}
+
+/*!
+  Convert a row of \e n 16-bit values to unsigned char keeping the most significant byte.
+*/
+void shiftRow(const uint16_t *src, unsigned char *dst, const unsigned int n)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    for (; i + 16 <= n; i += 16) {
+      const __m128i lo = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (src + i)), 8);
+      const __m128i hi = _mm_srli_epi16(_mm_loadu_si128((const __m128i *) (src + i + 8)), 8);
+      _mm_storeu_si128((__m128i *) (dst + i), _mm_packus_epi16(lo, hi));
+    }
+  }
+#endif
+
+  for (; i < n; i++)
+    dst[i] = (src[i] >> 8);
+}
+
+/*!
+  Convert a row of \e n unsigned char values to 16-bit values stored in the most significant byte.
+*/
+void shiftRow(const unsigned char *src, uint16_t *dst, const unsigned int n)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+      const __m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+      _mm_storeu_si128((__m128i *) (dst + i),     _mm_slli_epi16(_mm_unpacklo_epi8(v, zero), 8));
+      _mm_storeu_si128((__m128i *) (dst + i + 8), _mm_slli_epi16(_mm_unpackhi_epi8(v, zero), 8));
+    }
+  }
+#endif
+
+  for (; i < n; i++)
+    dst[i] = (src[i] << 8);
+}
+}
+
 
 /*!
   Convert a vpImage\<unsigned char\> to a vpImage\<vpRGBa\>.
@@ -84,7 +319,13 @@ vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<vpRGBa> & des
 {
   dest.resize(src.getHeight(), src.getWidth()) ;
 
-  GreyToRGBa(src.bitmap, (unsigned char *)dest.bitmap, src.getHeight() * src.getWidth() );
+  if (src.isContiguous() && dest.isContiguous()) {
+    GreyToRGBa(src.bitmap, (unsigned char *)dest.bitmap, src.getHeight() * src.getWidth() );
+  }
+  else {
+    for (unsigned int i = 0; i < src.getHeight(); i++)
+      GreyToRGBa(src.bitmap + i*src.getPitch(), (unsigned char *)dest[i], src.getWidth());
+  }
 }
 
 /*!
@@ -97,7 +338,13 @@ vpImageConvert::convert(const vpImage<vpRGBa> &src, vpImage<unsigned char> & des
 {
   dest.resize(src.getHeight(), src.getWidth()) ;
 
-  RGBaToGrey((unsigned char *)src.bitmap, dest.bitmap, src.getHeight() * src.getWidth());
+  if (src.isContiguous() && dest.isContiguous()) {
+    RGBaToGrey((unsigned char *)src.bitmap, dest.bitmap, src.getHeight() * src.getWidth());
+  }
+  else {
+    for (unsigned int i = 0; i < src.getHeight(); i++)
+      RGBaToGrey((unsigned char *)(src.bitmap + i*src.getPitch()), dest[i], src.getWidth());
+  }
 }
 
 
@@ -110,19 +357,17 @@ void
 vpImageConvert::convert(const vpImage<float> &src, vpImage<unsigned char> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth()) ;
-  unsigned int max_xy = src.getWidth()*src.getHeight();
+  const unsigned int width = src.getWidth();
+  const int height = (int) src.getHeight();
   float min, max;
 
   src.getMinMaxValue(min,max);
-  
-  for (unsigned int i = 0; i < max_xy; i++) {
-    float val = 255.f * (src.bitmap[i] - min) / (max - min);
-    if(val < 0)
-      dest.bitmap[i] = 0;
-    else if(val > 255)
-      dest.bitmap[i] = 255;
-    else
-      dest.bitmap[i] = (unsigned char)val;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (src.getSize() >= vpImageConvertParallelMinSize)
+#endif
+  for (int i = 0; i < height; i++) {
+    normalizeRow(src[(unsigned int) i], dest[(unsigned int) i], width, min, max);
   }
 }
 
@@ -135,8 +380,13 @@ void
 vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<float> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth()) ;
-  for (unsigned int i = 0; i < src.getHeight()*src.getWidth(); i++)
-    dest.bitmap[i] = (float)src.bitmap[i];
+  if (src.isContiguous() && dest.isContiguous()) {
+    castRow(src.bitmap, dest.bitmap, src.getSize());
+  }
+  else {
+    for (unsigned int i = 0; i < src.getHeight(); i++)
+      castRow(src[i], dest[i], src.getWidth());
+  }
 }
 
 /*!
@@ -148,19 +398,17 @@ void
 vpImageConvert::convert(const vpImage<double> &src, vpImage<unsigned char> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth()) ;
-  unsigned int max_xy = src.getWidth()*src.getHeight();
+  const unsigned int width = src.getWidth();
+  const int height = (int) src.getHeight();
   double min, max;
 
   src.getMinMaxValue(min,max);
-  
-  for (unsigned int i = 0; i < max_xy; i++) {
-    double val = 255. * (src.bitmap[i] - min) / (max - min);
-    if(val < 0)
-      dest.bitmap[i] = 0;
-    else if(val > 255)
-      dest.bitmap[i] = 255;
-    else
-      dest.bitmap[i] = (unsigned char)val;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (src.getSize() >= vpImageConvertParallelMinSize)
+#endif
+  for (int i = 0; i < height; i++) {
+    normalizeRow(src[(unsigned int) i], dest[(unsigned int) i], width, min, max);
   }
 }
 
@@ -173,9 +421,13 @@ void
 vpImageConvert::convert(const vpImage<uint16_t> &src, vpImage<unsigned char> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth()) ;
-
-  for (unsigned int i=0; i< src.getSize(); i++)
-    dest.bitmap[i] = (src.bitmap[i] >> 8);
+  if (src.isContiguous() && dest.isContiguous()) {
+    shiftRow(src.bitmap, dest.bitmap, src.getSize());
+  }
+  else {
+    for (unsigned int i = 0; i < src.getHeight(); i++)
+      shiftRow(src[i], dest[i], src.getWidth());
+  }
 }
 
 /*!
@@ -187,9 +439,13 @@ void
 vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<uint16_t> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth()) ;
-
-  for (unsigned int i=0; i< src.getSize(); i++)
-    dest.bitmap[i] = (src.bitmap[i] << 8);
+  if (src.isContiguous() && dest.isContiguous()) {
+    shiftRow(src.bitmap, dest.bitmap, src.getSize());
+  }
+  else {
+    for (unsigned int i = 0; i < src.getHeight(); i++)
+      shiftRow(src[i], dest[i], src.getWidth());
+  }
 }
 
 /*!
@@ -201,8 +457,13 @@ void
 vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<double> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth()) ;
-  for (unsigned int i = 0; i < src.getHeight()*src.getWidth(); i++)
-    dest.bitmap[i] = (double)src.bitmap[i];
+  if (src.isContiguous() && dest.isContiguous()) {
+    castRow(src.bitmap, dest.bitmap, src.getSize());
+  }
+  else {
+    for (unsigned int i = 0; i < src.getHeight(); i++)
+      castRow(src[i], dest[i], src.getWidth());
+  }
 }
 
 /*!
@@ -219,26 +480,31 @@ vpImageConvert::createDepthHistogram(const vpImage<uint16_t> &src_depth, vpImage
   static uint32_t histogram[0x10000];
   memset(histogram, 0, sizeof(histogram));
 
-  for(unsigned int i = 0; i < src_depth.getSize(); ++i) ++histogram[src_depth.bitmap[i]];
+  for(unsigned int i = 0; i < src_depth.getHeight(); ++i)
+    for(unsigned int j = 0; j < src_depth.getWidth(); ++j) ++histogram[src_depth[i][j]];
   for(int i = 2; i < 0x10000; ++i) histogram[i] += histogram[i-1]; // Build a cumulative histogram for the indices in [1,0xFFFF]
 
-  for(unsigned int i = 0; i < src_depth.getSize(); ++i)
+  for(unsigned int i = 0; i < src_depth.getHeight(); ++i)
   {
-    uint16_t d = src_depth.bitmap[i];
-    if(d)
-    {
-      int f = (int)(histogram[d] * 255 / histogram[0xFFFF]); // 0-255 based on histogram location
-      dest_rgba.bitmap[i].R = 255 - f;
-      dest_rgba.bitmap[i].G = 0;
-      dest_rgba.bitmap[i].B = f;
-      dest_rgba.bitmap[i].A = vpRGBa::alpha_default;
-    }
-    else
+    for(unsigned int j = 0; j < src_depth.getWidth(); ++j)
     {
-      dest_rgba.bitmap[i].R = 20;
-      dest_rgba.bitmap[i].G = 5;
-      dest_rgba.bitmap[i].B = 0;
-      dest_rgba.bitmap[i].A = vpRGBa::alpha_default;
+      uint16_t d = src_depth[i][j];
+      vpRGBa &dest = dest_rgba[i][j];
+      if(d)
+      {
+        int f = (int)(histogram[d] * 255 / histogram[0xFFFF]); // 0-255 based on histogram location
+        dest.R = 255 - f;
+        dest.G = 0;
+        dest.B = f;
+        dest.A = vpRGBa::alpha_default;
+      }
+      else
+      {
+        dest.R = 20;
+        dest.G = 5;
+        dest.B = 0;
+        dest.A = vpRGBa::alpha_default;
+      }
     }
   }
 }
@@ -256,20 +522,24 @@ vpImageConvert::createDepthHistogram(const vpImage<uint16_t> &src_depth, vpImage
   static uint32_t histogram2[0x10000];
   memset(histogram2, 0, sizeof(histogram2));
 
-  for(unsigned int i = 0; i < src_depth.getSize(); ++i) ++histogram2[src_depth.bitmap[i]];
+  for(unsigned int i = 0; i < src_depth.getHeight(); ++i)
+    for(unsigned int j = 0; j < src_depth.getWidth(); ++j) ++histogram2[src_depth[i][j]];
   for(int i = 2; i < 0x10000; ++i) histogram2[i] += histogram2[i-1]; // Build a cumulative histogram for the indices in [1,0xFFFF]
 
-  for(unsigned int i = 0; i < src_depth.getSize(); ++i)
+  for(unsigned int i = 0; i < src_depth.getHeight(); ++i)
   {
-    uint16_t d = src_depth.bitmap[i];
-    if(d)
+    for(unsigned int j = 0; j < src_depth.getWidth(); ++j)
     {
-      int f = (int)(histogram2[d] * 255 / histogram2[0xFFFF]); // 0-255 based on histogram location
-      dest_depth.bitmap[i] = f;
-    }
-    else
-    {
-      dest_depth.bitmap[i] = 0;
+      uint16_t d = src_depth[i][j];
+      if(d)
+      {
+        int f = (int)(histogram2[d] * 255 / histogram2[0xFFFF]); // 0-255 based on histogram location
+        dest_depth[i][j] = f;
+      }
+      else
+      {
+        dest_depth[i][j] = 0;
+      }
     }
   }
 }
@@ -566,7 +836,7 @@ vpImageConvert::convert(const vpImage<vpRGBa> & src, IplImage *&dest)
       line+=4;
     }
     //go to the next line
-    input+=4*width;
+    input+=4*src.getPitch();
   }
 }
 
@@ -633,13 +903,13 @@ vpImageConvert::convert(const vpImage<unsigned char> & src, IplImage* &dest)
 
   unsigned int widthStep = (unsigned int)dest->widthStep;
 
-  if ( width == widthStep){
+  if ( width == widthStep && src.isContiguous()){
     memcpy(dest->imageData,src.bitmap, width*height);
   }
   else{
-    //copying each line taking account of the widthStep
+    //copying each line taking account of the widthStep and of the pitch of a view
     for (unsigned int i =0  ; i < height ; i++){
-      memcpy(dest->imageData + i*widthStep, src.bitmap + i*width,
+      memcpy(dest->imageData + i*widthStep, src[i],
              width);
     }
   }
@@ -868,7 +1138,7 @@ int main()
 void
 vpImageConvert::convert(const vpImage<vpRGBa> & src, cv::Mat& dest)
 {
-  cv::Mat vpToMat((int)src.getRows(), (int)src.getCols(), CV_8UC4, (void*)src.bitmap);
+  cv::Mat vpToMat((int)src.getRows(), (int)src.getCols(), CV_8UC4, (void*)src.bitmap, src.getPitch()*sizeof(vpRGBa));
 
   dest = cv::Mat((int)src.getRows(), (int)src.getCols(), CV_8UC3);
   cv::Mat alpha((int)src.getRows(), (int)src.getCols(), CV_8UC1);
@@ -923,10 +1193,10 @@ void
 vpImageConvert::convert(const vpImage<unsigned char> & src, cv::Mat& dest, const bool copyData)
 {
   if(copyData){
-    cv::Mat tmpMap((int)src.getRows(), (int)src.getCols(), CV_8UC1, (void*)src.bitmap);
+    cv::Mat tmpMap((int)src.getRows(), (int)src.getCols(), CV_8UC1, (void*)src.bitmap, src.getPitch()*sizeof(unsigned char));
     dest = tmpMap.clone();
   }else{
-    dest = cv::Mat((int)src.getRows(), (int)src.getCols(), CV_8UC1, (void*)src.bitmap);
+    dest = cv::Mat((int)src.getRows(), (int)src.getCols(), CV_8UC1, (void*)src.bitmap, src.getPitch()*sizeof(unsigned char));
   }
 }
 
@@ -1225,17 +1495,43 @@ void vpImageConvert::convert(const yarp::sig::ImageOf< yarp::sig::PixelRgb > *sr
 void vpImageConvert::YUYVToRGBa(unsigned char* yuyv, unsigned char* rgba,
                                 unsigned int width, unsigned int height)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int w, h;
-  int r, g, b, cr, cg, cb, y1, y2;
+  const int h = (int)height;
+  const int nbPairs = (int)(width >> 1);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (width*height >= vpImageConvertParallelMinSize)
+#endif
+  for (int row = 0; row < h; row++) {
+    unsigned char *s = yuyv + 4*(size_t)row*(size_t)nbPairs;
+    unsigned char *d = rgba + 8*(size_t)row*(size_t)nbPairs;
+    int r, g, b, cr, cg, cb, y1, y2;
+    int c = nbPairs;
+
+#if VISP_HAVE_SSE2
+    if (vpCPUFeatures::checkSSE2()) {
+      const __m128i mask = _mm_set1_epi16(0x00FF);
+      const __m128i offset = _mm_set1_epi16(128);
+      // (u, v) pairs coefficients for cb = u*454, cg = u*88 + v*183 and cr = v*359
+      const __m128i coef_b = _mm_set_epi16(0, 454, 0, 454, 0, 454, 0, 454);
+      const __m128i coef_g = _mm_set_epi16(183, 88, 183, 88, 183, 88, 183, 88);
+      const __m128i coef_r = _mm_set_epi16(359, 0, 359, 0, 359, 0, 359, 0);
+      for (; c >= 8; c -= 8, s += 32, d += 64) {
+        const __m128i a0 = _mm_loadu_si128((const __m128i *) s);
+        const __m128i a1 = _mm_loadu_si128((const __m128i *) (s + 16));
+        const __m128i y = _mm_packus_epi16(_mm_and_si128(a0, mask), _mm_and_si128(a1, mask));
+        const __m128i uv0 = _mm_sub_epi16(_mm_srli_epi16(a0, 8), offset);
+        const __m128i uv1 = _mm_sub_epi16(_mm_srli_epi16(a1, 8), offset);
+        const __m128i vcb = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(uv0, coef_b), 8),
+                                            _mm_srai_epi32(_mm_madd_epi16(uv1, coef_b), 8));
+        const __m128i vcg = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(uv0, coef_g), 8),
+                                            _mm_srai_epi32(_mm_madd_epi16(uv1, coef_g), 8));
+        const __m128i vcr = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(uv0, coef_r), 8),
+                                            _mm_srai_epi32(_mm_madd_epi16(uv1, coef_r), 8));
+        YUVToRGBa16(y, vcr, _mm_sub_epi16(_mm_setzero_si128(), vcg), vcb, d);
+      }
+    }
+#endif
 
-  h = (int)height;
-  w = (int)width;
-  s = yuyv;
-  d = rgba;
-  while (h--) {
-    int c = w >> 1;
     while (c--) {
       y1 = *s++;
       cb = ((*s - 128) * 454) >> 8;
@@ -1335,9 +1631,20 @@ void vpImageConvert::YUYVToGrey(unsigned char* yuyv, unsigned char* grey, unsign
 {
   unsigned int i=0,j=0;
 
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    for (; i + 16 <= size; i += 16, j += 32) {
+      const __m128i a = _mm_loadu_si128((const __m128i *) (yuyv + j));
+      const __m128i b = _mm_loadu_si128((const __m128i *) (yuyv + j + 16));
+      _mm_storeu_si128((__m128i *) (grey + i), _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+    }
+  }
+#endif
+
   while( j < size*2)
   {
-    grey[i++] = yuyv[j];
+    grey[i++] = yuyv[j+0];
     grey[i++] = yuyv[j+2];
     j+=4;
   }
@@ -1479,10 +1786,28 @@ void vpImageConvert::YUV411ToRGBa(unsigned char* yuv, unsigned char* rgba, unsig
 */
 void vpImageConvert::YUV422ToRGBa(unsigned char* yuv, unsigned char* rgba, unsigned int size)
 {
+  unsigned int i = size / 2;
+
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    const __m128i mask_lo = _mm_set1_epi32(0x0000FFFF);
+    for (; i >= 8; i -= 8, yuv += 32, rgba += 64) {
+      const __m128i a = _mm_loadu_si128((const __m128i *) yuv);
+      const __m128i b = _mm_loadu_si128((const __m128i *) (yuv + 16));
+      const __m128i y = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+      const __m128i uv_a = _mm_and_si128(a, mask);
+      const __m128i uv_b = _mm_and_si128(b, mask);
+      const __m128i u = _mm_packs_epi32(_mm_and_si128(uv_a, mask_lo), _mm_and_si128(uv_b, mask_lo));
+      const __m128i v = _mm_packs_epi32(_mm_srli_epi32(uv_a, 16), _mm_srli_epi32(uv_b, 16));
+      __m128i V2, UV, U5;
+      computeChroma(u, v, V2, UV, U5);
+      YUVToRGBa16(y, V2, UV, U5, rgba);
+    }
+  }
+#endif
 
-#if 1
-  //  std::cout << "call optimized convertYUV422ToRGBa()" << std::endl;
-  for( unsigned int i = size / 2; i; i-- ) {
+  for( ; i; i-- ) {
     int U   = (int)((*yuv++ - 128) * 0.354);
     int U5  = 5*U;
     int Y0  = *yuv++;
@@ -1521,32 +1846,6 @@ void vpImageConvert::YUV422ToRGBa(unsigned char* yuv, unsigned char* rgba, unsig
     *rgba++ = (unsigned char)B;
     *rgba++ = vpRGBa::alpha_default;
   }
-
-#else
-  // tres tres lent ....
-  unsigned int i=0,j=0;
-  unsigned char r, g, b;
-
-  while( j < size*2)
-  {
-
-    YUVToRGB (yuv[j+1], yuv[j], yuv[j+2], r, g, b);
-    rgba[i]   = r;
-    rgba[i+1] = g;
-    rgba[i+2] = b;
-    rgba[i+3] = vpRGBa::alpha_default;
-    i+=4;
-
-    YUVToRGB (yuv[j+3], yuv[j], yuv[j+2], r, g, b);
-    rgba[i]   = r;
-    rgba[i+1] = g;
-    rgba[i+2] = b;
-    rgba[i+3] = vpRGBa::alpha_default;
-    i+=4;
-    j+=4;
-
-  }
-#endif
 }
 
 /*!
@@ -1659,6 +1958,16 @@ void vpImageConvert::YUV422ToGrey(unsigned char* yuv, unsigned char* grey, unsig
 {
   unsigned int i=0,j=0;
 
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    for (; i + 16 <= size; i += 16, j += 32) {
+      const __m128i a = _mm_loadu_si128((const __m128i *) (yuv + j));
+      const __m128i b = _mm_loadu_si128((const __m128i *) (yuv + j + 16));
+      _mm_storeu_si128((__m128i *) (grey + i), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+    }
+  }
+#endif
+
   while( j < size*2)
   {
     grey[i++] = yuv[j+1];
@@ -1798,95 +2107,66 @@ void vpImageConvert::YUV411ToRGB(unsigned char* yuv, unsigned char* rgb, unsigne
 void vpImageConvert::YUV420ToRGBa(unsigned char* yuv, unsigned char* rgba,
                                   unsigned int width, unsigned int height)
 {
-  //  std::cout << "call optimized ConvertYUV420ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width*height;
-  unsigned char* iU = yuv + size;
-  unsigned char* iV = yuv + 5*size/4;
-  for(unsigned int i = 0; i<height/2; i++)
-  {
-    for(unsigned int j = 0; j < width/2 ; j++)
-    {
-      U   = (int)((*iU++ - 128) * 0.354);
-      U5  = 5*U;
-      V   = (int)((*iV++ - 128) * 0.707);
-      V2  = 2*V;
-      UV  = - U - V;
-      Y0  = *yuv++;
-      Y1  = *yuv;
-      yuv = yuv+width-1;
-      Y2  = *yuv++;
-      Y3  = *yuv;
-      yuv = yuv-width+1;
+  const unsigned int size = width*height;
+  const unsigned int halfWidth = width/2;
+  const int halfHeight = (int)(height/2);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (size >= vpImageConvertParallelMinSize)
+#endif
+  for (int r = 0; r < halfHeight; r++) {
+    const unsigned int i = (unsigned int) r;
+    const unsigned char *y0 = yuv + 2*i*width;
+    const unsigned char *y1 = y0 + width;
+    const unsigned char *iU = yuv + size + i*halfWidth;
+    const unsigned char *iV = yuv + 5*size/4 + i*halfWidth;
+    unsigned char *d0 = rgba + 8*i*width;
+    unsigned char *d1 = d0 + 4*width;
+    unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+    if (vpCPUFeatures::checkSSE2()) {
+      const __m128i zero = _mm_setzero_si128();
+      for (; j + 8 <= halfWidth; j += 8) {
+        const __m128i u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (iU + j)), zero);
+        const __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (iV + j)), zero);
+        __m128i V2, UV, U5;
+        computeChroma(u, v, V2, UV, U5);
+        YUVToRGBa16(_mm_loadu_si128((const __m128i *) (y0 + 2*j)), V2, UV, U5, d0 + 8*j);
+        YUVToRGBa16(_mm_loadu_si128((const __m128i *) (y1 + 2*j)), V2, UV, U5, d1 + 8*j);
+      }
+    }
+#endif
+
+    for (; j < halfWidth; j++) {
+      int U   = (int)((iU[j] - 128) * 0.354);
+      int U5  = 5*U;
+      int V   = (int)((iV[j] - 128) * 0.707);
+      int V2  = 2*V;
+      int UV  = - U - V;
+      const int Y[4] = { y0[2*j], y0[2*j+1], y1[2*j], y1[2*j+1] };
+      unsigned char *d[4] = { d0 + 8*j, d0 + 8*j + 4, d1 + 8*j, d1 + 8*j + 4 };
 
       // Original equations
       // R = Y           + 1.402 V
       // G = Y - 0.344 U - 0.714 V
       // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0) R = 255; else if (R < 0) R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0) G = 255; else if (G < 0) G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0) B = 255; else if (B < 0) B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0) R = 255; else if (R < 0) R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0) G = 255; else if (G < 0) G = 0;
+      for (unsigned int k = 0; k < 4; k++) {
+        int R = Y[k] + V2;
+        if ((R >> 8) > 0) R = 255; else if (R < 0) R = 0;
 
-      B = Y1 + U5;
-      if ((B >> 8) > 0) B = 255; else if (B < 0) B = 0;
+        int G = Y[k] + UV;
+        if ((G >> 8) > 0) G = 255; else if (G < 0) G = 0;
 
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba + 4*width-7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0) R = 255; else if (R < 0) R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0) G = 255; else if (G < 0) G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0) B = 255; else if (B < 0) B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0) R = 255; else if (R < 0) R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0) G = 255; else if (G < 0) G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0) B = 255; else if (B < 0) B = 0;
+        int B = Y[k] + U5;
+        if ((B >> 8) > 0) B = 255; else if (B < 0) B = 0;
 
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba -4*width+1;
+        d[k][0] = (unsigned char)R;
+        d[k][1] = (unsigned char)G;
+        d[k][2] = (unsigned char)B;
+        d[k][3] = vpRGBa::alpha_default;
+      }
     }
-    yuv+=width;
-    rgba+=4*width;
   }
 }
 /*!
@@ -3173,6 +3453,18 @@ vpImageConvert::GreyToRGBa(unsigned char* grey, unsigned char* rgba, unsigned in
   unsigned char *pt_end = grey + size;
   unsigned char *pt_output = rgba;
 
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i a = _mm_set1_epi8((char)vpRGBa::alpha_default);
+    for (unsigned int i = size / 16; i; i--) {
+      const __m128i g = _mm_loadu_si128((const __m128i *) pt_input);
+      storeRGBa(pt_output, g, g, g, a);
+      pt_input += 16;
+      pt_output += 64;
+    }
+  }
+#endif
+
   while(pt_input != pt_end) {
     unsigned char p =  *pt_input ;
     *(pt_output     ) = p ; // R
@@ -4046,6 +4338,18 @@ void vpImageConvert::split(const vpImage<vpRGBa> &src,
   tabChannel[2] = pB;
   tabChannel[3] = pa;
 
+  if (!src.isContiguous()) {
+    for(unsigned int c = 0;c < 4;c++){
+      if(tabChannel[c]!=NULL){
+        tabChannel[c]->resize(height,width);
+        for (unsigned int i = 0; i < height; i++)
+          for (unsigned int j = 0; j < width; j++)
+            (*tabChannel[c])[i][j] = ((const unsigned char *) &src[i][j])[c];
+      }
+    }
+    return;
+  }
+
   size_t    i;    /* ordre    */
   for(unsigned int j = 0;j < 4;j++){
     if(tabChannel[j]!=NULL){
@@ -4053,10 +4357,31 @@ void vpImageConvert::split(const vpImage<vpRGBa> &src,
          tabChannel[j]->getWidth() != width){
         tabChannel[j]->resize(height,width);
       }
+      if (!tabChannel[j]->isContiguous()) {
+        for (unsigned int r = 0; r < height; r++)
+          for (unsigned int c = 0; c < width; c++)
+            (*tabChannel[j])[r][c] = ((const unsigned char *) &src[r][c])[j];
+        continue;
+      }
       dst = (unsigned char*)tabChannel[j]->bitmap;
 
       input = (unsigned char*)src.bitmap+j;
       i = 0;
+#if VISP_HAVE_SSE2
+      if (vpCPUFeatures::checkSSE2()) {
+        const __m128i mask = _mm_set1_epi32(0x000000FF);
+        const __m128i shift = _mm_cvtsi32_si128((int)(8*j));
+        const unsigned char *s = (const unsigned char*)src.bitmap;
+        for (; i + 16 <= n; i += 16, s += 64, dst += 16) {
+          const __m128i c0 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *) s), shift), mask);
+          const __m128i c1 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *) (s + 16)), shift), mask);
+          const __m128i c2 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *) (s + 32)), shift), mask);
+          const __m128i c3 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *) (s + 48)), shift), mask);
+          _mm_storeu_si128((__m128i *) dst, _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3)));
+        }
+        input += 4*i;
+      }
+#endif
 #if 1 //optimization
       if (n >= 4) {    /* boucle deroulee lsize fois    */
         n -= 3;
@@ -4117,8 +4442,34 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R,
 
     RGBa.resize(height, width);
 
+    if (!RGBa.isContiguous() || (R != NULL && !R->isContiguous()) || (G != NULL && !G->isContiguous()) ||
+        (B != NULL && !B->isContiguous()) || (a != NULL && !a->isContiguous())) {
+      for (unsigned int i = 0; i < height; i++) {
+        for (unsigned int j = 0; j < width; j++) {
+          if (R != NULL) RGBa[i][j].R = (*R)[i][j];
+          if (G != NULL) RGBa[i][j].G = (*G)[i][j];
+          if (B != NULL) RGBa[i][j].B = (*B)[i][j];
+          if (a != NULL) RGBa[i][j].A = (*a)[i][j];
+        }
+      }
+      return;
+    }
+
     unsigned int size = width*height;
-    for(unsigned int i = 0; i < size; i++) {
+    unsigned int i = 0;
+#if VISP_HAVE_SSE2
+    if (R != NULL && G != NULL && B != NULL && a != NULL && vpCPUFeatures::checkSSE2()) {
+      for (; i + 16 <= size; i += 16) {
+        storeRGBa((unsigned char *) (RGBa.bitmap + i),
+                  _mm_loadu_si128((const __m128i *) (R->bitmap + i)),
+                  _mm_loadu_si128((const __m128i *) (G->bitmap + i)),
+                  _mm_loadu_si128((const __m128i *) (B->bitmap + i)),
+                  _mm_loadu_si128((const __m128i *) (a->bitmap + i)));
+      }
+    }
+#endif
+
+    for(; i < size; i++) {
       if(R != NULL) {
         RGBa.bitmap[i].R = R->bitmap[i];
       }
@@ -4152,12 +4503,22 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R,
 */
 void vpImageConvert::MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size)
 {
-  int i = (((int)size)<<1)-1;
-  int j = (int)size-1;
+  unsigned int k = 0;
+#if VISP_HAVE_SSE2
+  // Forward processing is safe when converting in place since grey[k] is written after
+  // grey16[2k] and grey16[2k+1] are read
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    for (; k + 16 <= size; k += 16) {
+      const __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *) (grey16 + 2*k)), mask);
+      const __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *) (grey16 + 2*k + 16)), mask);
+      _mm_storeu_si128((__m128i *) (grey + k), _mm_packus_epi16(a, b));
+    }
+  }
+#endif
 
-  while (i >= 0) {
-    int y = grey16[i--];
-    grey[j--] = static_cast<unsigned char>( (y+(grey16[i--]<<8))>>8 );
+  for (; k < size; k++) {
+    grey[k] = grey16[2*k];
   }
 }
 
@@ -38,6 +38,12 @@
 
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpCPUFeatures.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
 #  include <opencv2/imgproc/imgproc.hpp>
 #elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020101)
@@ -46,6 +52,240 @@
 #  include <cv.h>
 #endif
 
+namespace {
+// Below this number of pixels, the filters are applied using a single thread
+const unsigned int vpImageFilterParallelMinSize = 160*120;
+
+/*!
+  Apply a symmetric (or anti-symmetric when \e derivative is true) 1D kernel along a row,
+  for the columns in [begin, end[:
+  dst[j] = sum_k filter[k] * (src[j+k] +/- src[j-k]) + filter[0] * src[j]
+  The center coefficient is not used for the derivative kernels.
+*/
+void filterRow(const double *src, double *dst, const unsigned int begin, const unsigned int end,
+               const double *filter, const unsigned int half, const bool derivative)
+{
+  unsigned int j = begin;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2() && end >= begin + 2) {
+    for (; j + 1 < end; j += 2) {
+      __m128d acc = _mm_setzero_pd();
+      for (unsigned int k = 1; k <= half; k++) {
+        const __m128d right = _mm_loadu_pd(src + j + k);
+        const __m128d left = _mm_loadu_pd(src + j - k);
+        const __m128d sum = derivative ? _mm_sub_pd(right, left) : _mm_add_pd(right, left);
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(filter[k]), sum));
+      }
+      if (!derivative) {
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(filter[0]), _mm_loadu_pd(src + j)));
+      }
+      _mm_storeu_pd(dst + j, acc);
+    }
+  }
+#endif
+
+  for (; j < end; j++) {
+    double result = 0;
+    for (unsigned int k = 1; k <= half; k++) {
+      result += filter[k] * (derivative ? (src[j+k] - src[j-k]) : (src[j+k] + src[j-k]));
+    }
+    dst[j] = derivative ? result : result + filter[0]*src[j];
+  }
+}
+
+/*!
+  Apply a symmetric (or anti-symmetric when \e derivative is true) 1D kernel along the columns
+  for all the pixels of a row. \e rows points to the 2*half+1 rows covered by the kernel, the
+  current row being rows[half].
+*/
+void filterColumns(const double * const *rows, double *dst, const unsigned int width,
+                   const double *filter, const unsigned int half, const bool derivative)
+{
+  const double *center = rows[half];
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    for (; j + 1 < width; j += 2) {
+      __m128d acc = _mm_setzero_pd();
+      for (unsigned int k = 1; k <= half; k++) {
+        const __m128d bottom = _mm_loadu_pd(rows[half+k] + j);
+        const __m128d top = _mm_loadu_pd(rows[half-k] + j);
+        const __m128d sum = derivative ? _mm_sub_pd(bottom, top) : _mm_add_pd(bottom, top);
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(filter[k]), sum));
+      }
+      if (!derivative) {
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(filter[0]), _mm_loadu_pd(center + j)));
+      }
+      _mm_storeu_pd(dst + j, acc);
+    }
+  }
+#endif
+
+  for (; j < width; j++) {
+    double result = 0;
+    for (unsigned int k = 1; k <= half; k++) {
+      result += filter[k] * (derivative ? (rows[half+k][j] - rows[half-k][j]) : (rows[half+k][j] + rows[half-k][j]));
+    }
+    dst[j] = derivative ? result : result + filter[0]*center[j];
+  }
+}
+
+/*!
+  Apply a 1D kernel along the rows of an image, the columns close to the borders being
+  processed by \e leftBorder and \e rightBorder. When they are not provided, the border pixels
+  are set to 0.
+*/
+template<class T>
+void filterImageX(const vpImage<T> &I, vpImage<double> &dIx, const double *filter, const unsigned int size,
+                  const bool derivative,
+                  double (*leftBorder)(const vpImage<T> &, unsigned int, unsigned int, const double *, unsigned int),
+                  double (*rightBorder)(const vpImage<T> &, unsigned int, unsigned int, const double *, unsigned int))
+{
+  const unsigned int half = (size-1)/2;
+  const unsigned int width = I.getWidth();
+  const int height = (int) I.getHeight();
+  dIx.resize(I.getHeight(), width);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+  {
+    std::vector<double> row(width);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int r = 0; r < height; r++) {
+      const unsigned int i = (unsigned int) r;
+      for (unsigned int j = 0; j < width; j++) {
+        row[j] = I[i][j];
+      }
+
+      for (unsigned int j = 0; j < half; j++) {
+        dIx[i][j] = leftBorder ? leftBorder(I, i, j, filter, size) : 0;
+      }
+      filterRow(&row[0], dIx[i], half, width-half, filter, half, derivative);
+      for (unsigned int j = width-half; j < width; j++) {
+        dIx[i][j] = rightBorder ? rightBorder(I, i, j, filter, size) : 0;
+      }
+    }
+  }
+}
+
+/*!
+  Apply a 1D kernel along the columns of a double image, the rows close to the borders being
+  processed by \e topBorder and \e bottomBorder. When they are not provided, the border pixels
+  are set to 0.
+*/
+void filterImageY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, const unsigned int size,
+                  const bool derivative,
+                  double (*topBorder)(const vpImage<double> &, unsigned int, unsigned int, const double *, unsigned int),
+                  double (*bottomBorder)(const vpImage<double> &, unsigned int, unsigned int, const double *, unsigned int))
+{
+  const unsigned int half = (size-1)/2;
+  const unsigned int width = I.getWidth();
+  const unsigned int height = I.getHeight();
+  dIy.resize(height, width);
+
+  for (unsigned int i = 0; i < half; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      dIy[i][j] = topBorder ? topBorder(I, i, j, filter, size) : 0;
+    }
+  }
+
+  const int begin = (int) half;
+  const int end = (int) (height-half);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+  {
+    std::vector<const double *> rows(2*half+1);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int r = begin; r < end; r++) {
+      const unsigned int i = (unsigned int) r;
+      for (unsigned int k = 0; k < 2*half+1; k++) {
+        rows[k] = I[i+k-half];
+      }
+      filterColumns(&rows[0], dIy[i], width, filter, half, derivative);
+    }
+  }
+
+  for (unsigned int i = height-half; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      dIy[i][j] = bottomBorder ? bottomBorder(I, i, j, filter, size) : 0;
+    }
+  }
+}
+
+/*!
+  Apply the 1-4-6-4-1 pyramidal kernel along a row and keep one pixel out of two:
+  dst[j] = (src[2j-2] + 4*src[2j-1] + 6*src[2j] + 4*src[2j+1] + src[2j+2]) / 16 for j in [1, w-1[.
+  The computation is done on integers, which gives the same result than the truncated
+  double precision expression used by vpImageFilter::filterGaussXPyramidal().
+*/
+void pyrDownRow(const unsigned char *src, unsigned char *dst, const unsigned int w)
+{
+  unsigned int j = 1;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    const __m128i six = _mm_set1_epi16(6);
+    const __m128i zero = _mm_setzero_si128();
+    // The three 16 bytes loads read up to src[2j+17] that has to be lower than 2w
+    for (; j + 9 <= w; j += 8) {
+      const __m128i a = _mm_loadu_si128((const __m128i *) (src + 2*j - 2));
+      const __m128i b = _mm_loadu_si128((const __m128i *) (src + 2*j));
+      const __m128i c = _mm_loadu_si128((const __m128i *) (src + 2*j + 2));
+      __m128i sum = _mm_add_epi16(_mm_and_si128(a, mask), _mm_and_si128(c, mask));
+      sum = _mm_add_epi16(sum, _mm_slli_epi16(_mm_add_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)), 2));
+      sum = _mm_add_epi16(sum, _mm_mullo_epi16(_mm_and_si128(b, mask), six));
+      _mm_storel_epi64((__m128i *) (dst + j), _mm_packus_epi16(_mm_srli_epi16(sum, 4), zero));
+    }
+  }
+#endif
+
+  for (; j + 1 < w; j++) {
+    const unsigned char *s = src + 2*j;
+    dst[j] = (unsigned char) ((s[-2] + 4*s[-1] + 6*s[0] + 4*s[1] + s[2]) >> 4);
+  }
+}
+
+/*!
+  Apply the 1-4-6-4-1 pyramidal kernel along the columns. \e rows points to the 5 rows
+  covered by the kernel.
+*/
+void pyrDownColumns(const unsigned char * const *rows, unsigned char *dst, const unsigned int width)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128i six = _mm_set1_epi16(6);
+    const __m128i zero = _mm_setzero_si128();
+    for (; j + 16 <= width; j += 16) {
+      __m128i r[5];
+      for (unsigned int k = 0; k < 5; k++) {
+        r[k] = _mm_loadu_si128((const __m128i *) (rows[k] + j));
+      }
+      __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(r[0], zero), _mm_unpacklo_epi8(r[4], zero));
+      __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(r[0], zero), _mm_unpackhi_epi8(r[4], zero));
+      lo = _mm_add_epi16(lo, _mm_slli_epi16(_mm_add_epi16(_mm_unpacklo_epi8(r[1], zero), _mm_unpacklo_epi8(r[3], zero)), 2));
+      hi = _mm_add_epi16(hi, _mm_slli_epi16(_mm_add_epi16(_mm_unpackhi_epi8(r[1], zero), _mm_unpackhi_epi8(r[3], zero)), 2));
+      lo = _mm_add_epi16(lo, _mm_mullo_epi16(_mm_unpacklo_epi8(r[2], zero), six));
+      hi = _mm_add_epi16(hi, _mm_mullo_epi16(_mm_unpackhi_epi8(r[2], zero), six));
+      _mm_storeu_si128((__m128i *) (dst + j), _mm_packus_epi16(_mm_srli_epi16(lo, 4), _mm_srli_epi16(hi, 4)));
+    }
+  }
+#endif
+
+  for (; j < width; j++) {
+    dst[j] = (unsigned char) ((rows[0][j] + 4*rows[1][j] + 6*rows[2][j] + 4*rows[3][j] + rows[4][j]) >> 4);
+  }
+}
+}
+
 
 /*!
   Apply a filter to an image.
@@ -82,8 +322,14 @@ vpImageFilter::filter(const vpImage<unsigned char> &I,
 
   If.resize(I.getHeight(),I.getWidth(), 0.0);
 
+  const int begin = (int) half_size_y;
+  const int end = (int) (I.getHeight()-half_size_y);
   if (convolve) {
-    for (unsigned int i = half_size_y; i < I.getHeight()-half_size_y; i++) {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+    for (int r = begin; r < end; r++) {
+      const unsigned int i = (unsigned int) r;
       for (unsigned int j = half_size_x; j < I.getWidth()-half_size_x; j++) {
         double conv = 0;
 
@@ -97,7 +343,11 @@ vpImageFilter::filter(const vpImage<unsigned char> &I,
       }
     }
   } else {
-    for (unsigned int i = half_size_y; i < I.getHeight()-half_size_y; i++) {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+    for (int r = begin; r < end; r++) {
+      const unsigned int i = (unsigned int) r;
       for (unsigned int j = half_size_x; j < I.getWidth()-half_size_x; j++) {
         double corr = 0;
 
@@ -137,8 +387,14 @@ vpImageFilter::filter(const vpImage<double> &I,
   Iu.resize(I.getHeight(),I.getWidth(), 0.0);
   Iv.resize(I.getHeight(),I.getWidth(), 0.0);
 
+  const int begin = (int) half_size;
+  const int end = (int) (I.getHeight()-half_size);
   if (convolve) {
-    for (unsigned int v = half_size ; v < I.getHeight()-half_size ; v++) {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+    for (int r = begin; r < end; r++) {
+      const unsigned int v = (unsigned int) r;
       for (unsigned int u = half_size ; u < I.getWidth()-half_size ; u++) {
         double conv_u = 0;
         double conv_v = 0;
@@ -155,7 +411,11 @@ vpImageFilter::filter(const vpImage<double> &I,
       }
     }
   } else {
-    for (unsigned int v = half_size ; v < I.getHeight()-half_size ; v++) {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+    for (int r = begin; r < end; r++) {
+      const unsigned int v = (unsigned int) r;
       for (unsigned int u = half_size ; u < I.getWidth()-half_size ; u++) {
         double conv_u = 0;
         double conv_v = 0;
@@ -235,7 +495,12 @@ vpImageFilter::sepFilter(const vpImage<unsigned char> &I,
   If.resize(I.getHeight(),I.getWidth(), 0.0);
   vpImage<double> I_filter(I.getHeight(),I.getWidth(), 0.0);
 
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
+  const int height = (int) I.getHeight();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+  for (int r = 0; r < height; r++) {
+    const unsigned int i = (unsigned int) r;
     for (unsigned int j = half_size; j < I.getWidth()-half_size; j++) {
       double conv = 0.0;
       for (unsigned int a = 0; a < kernelH.size(); a++) {
@@ -246,7 +511,12 @@ vpImageFilter::sepFilter(const vpImage<unsigned char> &I,
     }
   }
 
-  for (unsigned int i = half_size; i < I.getHeight()-half_size; i++) {
+  const int end = (int) (I.getHeight()-half_size);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+  for (int r = (int) half_size; r < end; r++) {
+    const unsigned int i = (unsigned int) r;
     for (unsigned int j = 0; j < I.getWidth(); j++) {
       double conv = 0.0;
       for (unsigned int a = 0; a < kernelV.size(); a++) {
@@ -258,7 +528,6 @@ vpImageFilter::sepFilter(const vpImage<unsigned char> &I,
   }
 }
 
-#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 /*!
   Apply the Canny edge operator on the image \e Isrc and return the resulting
   image \e Ires.
@@ -272,7 +541,6 @@ vpImageFilter::sepFilter(const vpImage<unsigned char> &I,
 
 int main()
 {
-#if VISP_HAVE_OPENCV_VERSION >= 0x020100 // Canny uses OpenCV >=2.1.0
   // Constants for the Canny operator.
   const unsigned int gaussianFilterSize = 5;
   const double thresholdCanny = 15;
@@ -286,18 +554,28 @@ int main()
 
   //Apply the Canny edge operator and set the Icanny image.
   vpImageFilter::canny(Isrc, Icanny, gaussianFilterSize, thresholdCanny, apertureSobel);
-#endif
   return (0);
 }
   \endcode
 
+  The image is first smoothed with a Gaussian filter, then the gradients are
+  computed with the Sobel operator. The edges are the local maxima of the L1
+  gradient magnitude along the gradient direction that are greater than
+  \e thresholdCanny. The same threshold is used for both hysteresis thresholds,
+  as done by the previous OpenCV based implementation.
+
   \param Isrc : Image to apply the Canny edge detector to.
   \param Ires : Filtered image (255 means an edge, 0 otherwise).
   \param gaussianFilterSize : The size of the mask of the Gaussian filter to
   apply (an odd number).
   \param thresholdCanny : The threshold for the Canny operator. Only value
   greater than this value are marked as an edge).
-  \param apertureSobel : Size of the mask for the Sobel operator (odd number).
+  \param apertureSobel : Size of the mask for the Sobel operator (3, 5 or 7).
+
+  \note This function does not require OpenCV. The filtering and the non-maximum
+  suppression stages use the SSE2 and multithreaded (OpenMP) code paths when available.
+
+  \sa canny(const vpImage<unsigned char>&, vpImage<unsigned char>&, const unsigned int, const double, const double, const unsigned int)
 */
 void
 vpImageFilter:: canny(const vpImage<unsigned char>& Isrc,
@@ -306,27 +584,157 @@ vpImageFilter:: canny(const vpImage<unsigned char>& Isrc,
                       const double thresholdCanny,
                       const unsigned int apertureSobel)
 {
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
-  IplImage* img_ipl = NULL;
-  vpImageConvert::convert(Isrc, img_ipl);
-  IplImage* edges_ipl;
-  edges_ipl = cvCreateImage(cvSize(img_ipl->width, img_ipl->height), img_ipl->depth, img_ipl->nChannels);
-
-  cvSmooth(img_ipl, img_ipl, CV_GAUSSIAN, (int)gaussianFilterSize, (int)gaussianFilterSize, 0, 0);
-  cvCanny(img_ipl, edges_ipl, thresholdCanny, thresholdCanny, (int)apertureSobel);
-
-  vpImageConvert::convert(edges_ipl, Ires);
-  cvReleaseImage(&img_ipl);
-  cvReleaseImage(&edges_ipl);
-#else
-  cv::Mat img_cvmat, edges_cvmat;
-  vpImageConvert::convert(Isrc, img_cvmat);
-  cv::GaussianBlur(img_cvmat, img_cvmat, cv::Size((int)gaussianFilterSize, (int)gaussianFilterSize), 0, 0);
-  cv::Canny(img_cvmat, edges_cvmat, thresholdCanny, thresholdCanny, (int)apertureSobel);
-  vpImageConvert::convert(edges_cvmat, Ires);
-#endif
+  canny(Isrc, Ires, gaussianFilterSize, thresholdCanny, thresholdCanny, apertureSobel);
 }
+
+/*!
+  Apply the Canny edge operator with hysteresis on the image \e Isrc and return
+  the resulting image \e Ires.
+
+  The local maxima of the L1 gradient magnitude greater than \e upperThreshold
+  are edges. The local maxima greater than \e lowerThreshold are edges only if
+  they are connected to another edge.
+
+  \param Isrc : Image to apply the Canny edge detector to.
+  \param Ires : Filtered image (255 means an edge, 0 otherwise).
+  \param gaussianFilterSize : The size of the mask of the Gaussian filter to
+  apply (an odd number).
+  \param lowerThreshold : Lower threshold of the hysteresis.
+  \param upperThreshold : Upper threshold of the hysteresis.
+  \param apertureSobel : Size of the mask for the Sobel operator (3, 5 or 7).
+*/
+void
+vpImageFilter:: canny(const vpImage<unsigned char>& Isrc,
+                      vpImage<unsigned char>& Ires,
+                      const unsigned int gaussianFilterSize,
+                      const double lowerThreshold,
+                      const double upperThreshold,
+                      const unsigned int apertureSobel)
+{
+  if (lowerThreshold > upperThreshold) {
+    throw (vpImageException(vpImageException::incorrectInitializationError,
+                            "The lower threshold of the Canny operator is greater than the upper one"));
+  }
+
+  if (apertureSobel != 3 && apertureSobel != 5 && apertureSobel != 7) {
+    throw (vpImageException(vpImageException::incorrectInitializationError,
+                            "Bad Sobel aperture size: %d (should be 3, 5 or 7)", apertureSobel));
+  }
+
+  const unsigned int height = Isrc.getHeight(), width = Isrc.getWidth();
+  if (height < apertureSobel || width < apertureSobel) {
+    Ires.resize(height, width, 0);
+    return;
+  }
+
+  // Gaussian smoothing, the standard deviation is computed from the kernel size as done by OpenCV
+  double sigma = 0.3*((gaussianFilterSize-1)*0.5 - 1) + 0.8;
+  vpImage<double> Iblur;
+  vpImageFilter::gaussianBlur(Isrc, Iblur, gaussianFilterSize, sigma);
+
+  // Separable Sobel kernels: the smoothing kernel is made of binomial coefficients
+  // and the derivative kernel is the convolution of binomial coefficients with [-1 0 1]
+  const unsigned int half = (apertureSobel-1)/2;
+  std::vector<double> binomial(apertureSobel, 0.0), smoothKernel(half+1), derivativeKernel(half+1);
+  binomial[0] = 1.0;
+  for (unsigned int n = 1; n < apertureSobel - 2; n++) {
+    for (unsigned int k = n; k > 0; k--) {
+      binomial[k] += binomial[k-1];
+    }
+  }
+  // derivative kernel: D[p] = B[p-2] - B[p] with B the binomial coefficients of order apertureSobel-3
+  for (unsigned int k = 1; k <= half; k++) {
+    const unsigned int p = half + k;
+    derivativeKernel[k] = binomial[p-2] - (p < apertureSobel-2 ? binomial[p] : 0.0);
+  }
+  derivativeKernel[0] = 0.0;
+  std::vector<double> binomialSmooth(apertureSobel, 0.0);
+  binomialSmooth[0] = 1.0;
+  for (unsigned int n = 1; n < apertureSobel; n++) {
+    for (unsigned int k = n; k > 0; k--) {
+      binomialSmooth[k] += binomialSmooth[k-1];
+    }
+  }
+  for (unsigned int k = 0; k <= half; k++) {
+    smoothKernel[k] = binomialSmooth[half+k];
+  }
+
+  vpImage<double> Itmp, Igx, Igy;
+  vpImageFilter::getGradX(Iblur, Itmp, &derivativeKernel[0], apertureSobel);
+  vpImageFilter::filterY(Itmp, Igx, &smoothKernel[0], apertureSobel);
+  vpImageFilter::getGradY(Iblur, Itmp, &derivativeKernel[0], apertureSobel);
+  vpImageFilter::filterX(Itmp, Igy, &smoothKernel[0], apertureSobel);
+
+  // L1 gradient magnitude
+  vpImage<double> Imag(height, width);
+  for (unsigned int i = 0; i < Imag.getSize(); i++) {
+    Imag.bitmap[i] = std::fabs(Igx.bitmap[i]) + std::fabs(Igy.bitmap[i]);
+  }
+
+  // Non-maximum suppression: 0 is not an edge, 1 is a weak edge candidate and 2 a strong edge
+  const double tan22_5 = 0.4142135623730950488;
+  const double tan67_5 = 2.4142135623730950488;
+  vpImage<unsigned char> Ilabel(height, width, 0);
+  const int begin = (int) half + 1, end = (int) (height - half - 1);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (Isrc.getSize() >= vpImageFilterParallelMinSize)
 #endif
+  for (int r = begin; r < end; r++) {
+    const unsigned int i = (unsigned int) r;
+    const double *mag_p = Imag[i-1], *mag = Imag[i], *mag_n = Imag[i+1];
+    for (unsigned int j = half + 1; j < width - half - 1; j++) {
+      const double m = mag[j];
+      if (m <= lowerThreshold) {
+        continue;
+      }
+
+      const double gx = Igx[i][j], gy = Igy[i][j];
+      const double ax = std::fabs(gx), ay = std::fabs(gy);
+      bool isMax = false;
+      if (ay < ax*tan22_5) {
+        isMax = m > mag[j-1] && m >= mag[j+1];
+      } else if (ay > ax*tan67_5) {
+        isMax = m > mag_p[j] && m >= mag_n[j];
+      } else {
+        const unsigned int jp = (gx*gy < 0) ? j+1 : j-1;
+        const unsigned int jn = (gx*gy < 0) ? j-1 : j+1;
+        isMax = m > mag_p[jp] && m > mag_n[jn];
+      }
+
+      if (isMax) {
+        Ilabel[i][j] = (m > upperThreshold) ? 2 : 1;
+      }
+    }
+  }
+
+  // Hysteresis: propagate the strong edges to the connected weak edges using a worklist
+  Ires.resize(height, width);
+  Ires = 0;
+  std::vector<unsigned int> worklist;
+  for (unsigned int i = 0; i < Ilabel.getSize(); i++) {
+    if (Ilabel.bitmap[i] == 2) {
+      Ires[i / width][i % width] = 255;
+      worklist.push_back(i);
+    }
+  }
+
+  while (!worklist.empty()) {
+    const unsigned int index = worklist.back();
+    worklist.pop_back();
+    const unsigned int i = index / width, j = index % width;
+
+    for (int di = -1; di <= 1; di++) {
+      for (int dj = -1; dj <= 1; dj++) {
+        // Labeled pixels are never on the image border
+        const unsigned int ni = (unsigned int) ((int) i + di), nj = (unsigned int) ((int) j + dj);
+        if (Ilabel[ni][nj] == 1 && Ires[ni][nj] == 0) {
+          Ires[ni][nj] = 255;
+          worklist.push_back(ni*width + nj);
+        }
+      }
+    }
+  }
+}
 
 /*!
   Apply a separable filter.
@@ -350,97 +758,61 @@ void vpImageFilter::filter(const vpImage<double> &I, vpImage<double>& GI, const
   GIx.destroy();
 }
 
+/*!
+  Apply a 1D symmetric kernel along the rows of an image. Pixels close to the left and right
+  borders are computed by mirroring the image.
+
+  \param I : Input image.
+  \param dIx : Filtered image.
+  \param filter : Kernel coefficients as computed by vpImageFilter::getGaussianKernel(): the first
+  value is the central coefficient and the next ones the right coefficients.
+  \param size : Kernel size. This value should be odd.
+
+  \note The rows are processed in parallel when OpenMP is available, and SSE2 is used when the
+  CPU supports it.
+ */
 void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<double>& dIx, const double *filter,unsigned  int size)
 {
-  dIx.resize(I.getHeight(),I.getWidth()) ;
-  for (unsigned int i=0 ; i < I.getHeight() ; i++)
-  {
-    for (unsigned int j=0 ; j < (size-1)/2 ; j++)
-    {
-      dIx[i][j]=vpImageFilter::filterXLeftBorder(I,i,j,filter,size);
-      //dIx[i][j]=0;
-    }
-    for (unsigned int j=(size-1)/2 ; j < I.getWidth()-(size-1)/2 ; j++)
-    {
-      dIx[i][j]=vpImageFilter::filterX(I,i,j,filter,size);
-    }
-    for (unsigned int j=I.getWidth()-(size-1)/2 ; j < I.getWidth() ; j++)
-    {
-      dIx[i][j]=vpImageFilter::filterXRightBorder(I,i,j,filter,size);
-      //dIx[i][j]=0;
-    }
-  }
+  filterImageX<unsigned char>(I, dIx, filter, size, false, vpImageFilter::filterXLeftBorder, vpImageFilter::filterXRightBorder);
 }
+
+/*!
+  Apply a 1D symmetric kernel along the rows of a double image.
+
+  \sa filterX(const vpImage<unsigned char> &, vpImage<double>&, const double *, unsigned int)
+ */
 void vpImageFilter::filterX(const vpImage<double> &I, vpImage<double>& dIx, const double *filter,unsigned  int size)
 {
-  dIx.resize(I.getHeight(),I.getWidth()) ;
-  for (unsigned int i=0 ; i < I.getHeight() ; i++)
-  {
-    for (unsigned int j=0 ; j < (size-1)/2 ; j++)
-    {
-      dIx[i][j]=vpImageFilter::filterXLeftBorder(I,i,j,filter,size);
-      //dIx[i][j]=0;
-    }
-    for (unsigned int j=(size-1)/2 ; j < I.getWidth()-(size-1)/2 ; j++)
-    {
-      dIx[i][j]=vpImageFilter::filterX(I,i,j,filter,size);
-    }
-    for (unsigned int j=I.getWidth()-(size-1)/2 ; j < I.getWidth() ; j++)
-    {
-      dIx[i][j]=vpImageFilter::filterXRightBorder(I,i,j,filter,size);
-      //dIx[i][j]=0;
-    }
-  }
+  filterImageX<double>(I, dIx, filter, size, false, vpImageFilter::filterXLeftBorder, vpImageFilter::filterXRightBorder);
 }
+/*!
+  Apply a 1D symmetric kernel along the columns of an image. Pixels close to the top and bottom
+  borders are computed by mirroring the image.
+
+  \param I : Input image.
+  \param dIy : Filtered image.
+  \param filter : Kernel coefficients as computed by vpImageFilter::getGaussianKernel(): the first
+  value is the central coefficient and the next ones the bottom coefficients.
+  \param size : Kernel size. This value should be odd.
+
+  \note The rows are processed in parallel when OpenMP is available, and SSE2 is used when the
+  CPU supports it.
+ */
 void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<double>& dIy, const double *filter,unsigned  int size)
 {
-  dIy.resize(I.getHeight(),I.getWidth()) ;
-  for (unsigned int i=0 ; i < (size-1)/2 ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=vpImageFilter::filterYTopBorder(I,i,j,filter,size);
-    }
-  }
-  for (unsigned int i=(size-1)/2 ; i < I.getHeight()-(size-1)/2 ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=vpImageFilter::filterY(I,i,j,filter,size);
-    }
-  }
-  for (unsigned int i=I.getHeight()-(size-1)/2 ; i < I.getHeight() ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=vpImageFilter::filterYBottomBorder(I,i,j,filter,size);
-    }
-  }
+  vpImage<double> I_double;
+  vpImageConvert::convert(I, I_double);
+  filterImageY(I_double, dIy, filter, size, false, vpImageFilter::filterYTopBorder, vpImageFilter::filterYBottomBorder);
 }
+
+/*!
+  Apply a 1D symmetric kernel along the columns of a double image.
+
+  \sa filterY(const vpImage<unsigned char> &, vpImage<double>&, const double *, unsigned int)
+ */
 void vpImageFilter::filterY(const vpImage<double> &I, vpImage<double>& dIy, const double *filter,unsigned  int size)
 {
-  dIy.resize(I.getHeight(),I.getWidth()) ;
-  for (unsigned int i=0 ; i < (size-1)/2 ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=vpImageFilter::filterYTopBorder(I,i,j,filter,size);
-    }
-  }
-  for (unsigned int i=(size-1)/2 ; i < I.getHeight()-(size-1)/2 ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=vpImageFilter::filterY(I,i,j,filter,size);
-    }
-  }
-  for (unsigned int i=I.getHeight()-(size-1)/2 ; i < I.getHeight() ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=vpImageFilter::filterYBottomBorder(I,i,j,filter,size);
-    }
-  }
+  filterImageY(I, dIy, filter, size, false, vpImageFilter::filterYTopBorder, vpImageFilter::filterYBottomBorder);
 }
 
 /*!
@@ -568,9 +940,13 @@ void vpImageFilter::getGaussianDerivativeKernel(double *filter, unsigned int siz
 void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<double>& dIx)
 {
   dIx.resize(I.getHeight(),I.getWidth()) ;
-  //dIx=0;
-  for (unsigned int i=0 ; i < I.getHeight() ; i++)
+  const int height = (int) I.getHeight();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+  for (int r=0 ; r < height ; r++)
   {
+    const unsigned int i = (unsigned int) r;
     for (unsigned int j=0 ; j < 3 ; j++)
     {
       dIx[i][j]=0;
@@ -597,8 +973,13 @@ void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double>& d
       dIy[i][j]=0;
     }
   }
-  for (unsigned int i=3 ; i < I.getHeight()-3 ; i++)
+  const int end = (int) I.getHeight()-3;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+  for (int r=3 ; r < end ; r++)
   {
+    const unsigned int i = (unsigned int) r;
     for (unsigned int j=0 ; j < I.getWidth() ; j++)
     {
       dIy[i][j]=vpImageFilter::derivativeFilterY(I,i,j);
@@ -615,99 +996,23 @@ void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double>& d
 
 void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<double>& dIx, const double *filter,unsigned  int size)
 {
-  dIx.resize(I.getHeight(),I.getWidth()) ;
-  //#pragma omp parallel for
-  for (unsigned int i=0 ; i < I.getHeight() ; i++)
-  {
-    for (unsigned int j=0 ; j < (size-1)/2 ; j++)
-    {
-      dIx[i][j]=0;
-    }
-    for (unsigned int j=(size-1)/2 ; j < I.getWidth()-(size-1)/2 ; j++)
-    {
-      dIx[i][j]=vpImageFilter::derivativeFilterX(I,i,j,filter,size);
-    }
-    for (unsigned int j=I.getWidth()-(size-1)/2 ; j < I.getWidth() ; j++)
-    {
-      dIx[i][j]=0;
-    }
-  }
+  filterImageX<unsigned char>(I, dIx, filter, size, true, NULL, NULL);
 }
 void vpImageFilter::getGradX(const vpImage<double> &I, vpImage<double>& dIx, const double *filter,unsigned  int size)
 {
-  dIx.resize(I.getHeight(),I.getWidth()) ;
-  //dIx=0;
-  for (unsigned int i=0 ; i < I.getHeight() ; i++)
-  {
-    for (unsigned int j=0 ; j < (size-1)/2 ; j++)
-    {
-      dIx[i][j]=0;
-    }
-    for (unsigned int j=(size-1)/2 ; j < I.getWidth()-(size-1)/2 ; j++)
-    {
-      dIx[i][j]=vpImageFilter::derivativeFilterX(I,i,j,filter,size);
-    }
-    for (unsigned int j=I.getWidth()-(size-1)/2 ; j < I.getWidth() ; j++)
-    {
-      dIx[i][j]=0;
-    }
-  }
+  filterImageX<double>(I, dIx, filter, size, true, NULL, NULL);
 }
 
 void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double>& dIy, const double *filter,unsigned  int size)
 {
-  dIy.resize(I.getHeight(),I.getWidth()) ;
-  //#pragma omp parallel for
-  for (unsigned int i=0 ; i < (size-1)/2 ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=0;
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i=(size-1)/2 ; i < I.getHeight()-(size-1)/2 ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=vpImageFilter::derivativeFilterY(I,i,j,filter,size);
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i=I.getHeight()-(size-1)/2 ; i < I.getHeight() ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=0;
-    }
-  }
+  vpImage<double> I_double;
+  vpImageConvert::convert(I, I_double);
+  filterImageY(I_double, dIy, filter, size, true, NULL, NULL);
 }
 
 void vpImageFilter::getGradY(const vpImage<double> &I, vpImage<double>& dIy, const double *filter,unsigned  int size)
 {
-  dIy.resize(I.getHeight(),I.getWidth()) ;
-  //dIy=0;
-  for (unsigned int i=0 ; i < (size-1)/2 ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=0;
-    }
-  }
-  for (unsigned int i=(size-1)/2 ; i < I.getHeight()-(size-1)/2 ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=vpImageFilter::derivativeFilterY(I,i,j,filter,size);
-    }
-  }
-  for (unsigned int i=I.getHeight()-(size-1)/2 ; i < I.getHeight() ; i++)
-  {
-    for (unsigned int j=0 ; j < I.getWidth() ; j++)
-    {
-      dIy[i][j]=0;
-    }
-  }
+  filterImageY(I, dIy, filter, size, true, NULL, NULL);
 }
 
 /*!
@@ -773,64 +1078,63 @@ void vpImageFilter::getGaussPyramidal(const vpImage<unsigned char> &I, vpImage<u
 #endif
 }
 
+/*!
+  Apply the 1-4-6-4-1 pyramidal kernel along the rows and divide the width by 2.
+  The first and last columns are copied from the input image.
+  \param I : Input image.
+  \param GI : Filtered image of size I.getHeight() x I.getWidth()/2.
+ */
 void vpImageFilter::getGaussXPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char>& GI)
 {
-#if 0
-  GI.resize(I.getHeight(),(int)((I.getWidth()+1.)/2.)) ;
-  for (unsigned int i=0 ; i < I.getHeight() ; i++)
-  {
-    GI[i][0]=I[i][0];
-    for (unsigned int j=1 ; j < ((I.getWidth()+1.)/2.)-1 ; j++)
-    {
-      GI[i][j]=vpImageFilter::filterGaussXPyramidal(I,i,2*j);
-    }
-    GI[i][(int)((I.getWidth()+1.)/2.)-1]=I[i][2*((int)((I.getWidth()+1.)/2.)-1)];
-  }
-#else
-  unsigned int w = I.getWidth()/2;
+  const unsigned int w = I.getWidth()/2;
+  const int height = (int) I.getHeight();
 
   GI.resize(I.getHeight(), w) ;
-  for (unsigned int i=0 ; i < I.getHeight() ; i++)
+  if (w == 0) {
+    return;
+  }
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static) if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+  for (int r = 0 ; r < height ; r++)
   {
+    const unsigned int i = (unsigned int) r;
     GI[i][0]=I[i][0];
-    for (unsigned int j=1 ; j < w-1 ; j++)
-    {
-      GI[i][j]=vpImageFilter::filterGaussXPyramidal(I,i,2*j);
-    }
+    pyrDownRow(I[i], GI[i], w);
     GI[i][w-1]=I[i][2*w-1];
   }
-
-#endif
 }
+
+/*!
+  Apply the 1-4-6-4-1 pyramidal kernel along the columns and divide the height by 2.
+  The first and last rows are copied from the input image.
+  \param I : Input image.
+  \param GI : Filtered image of size I.getHeight()/2 x I.getWidth().
+ */
 void vpImageFilter::getGaussYPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char>& GI)
 {
+  const unsigned int h = I.getHeight()/2;
+  const unsigned int width = I.getWidth();
 
-#ifdef ORIG
-  GI.resize((int)((I.getHeight()+1.)/2.),I.getWidth()) ;
-  for (unsigned int j=0 ; j < I.getWidth() ; j++)
-  {
-    GI[0][j]=I[0][j];
-    for (unsigned int i=1 ; i < ((I.getHeight()+1.)/2.)-1 ; i++)
-    {
-      GI[i][j]=vpImageFilter::filterGaussYPyramidal(I,2*i,j);
-    }
-    GI[(int)((I.getHeight()+1.)/2.)-1][j]=I[2*((int)((I.getHeight()+1.)/2.)-1)][j];
+  GI.resize(h, width) ;
+  if (h == 0) {
+    return;
   }
 
-#else
-  unsigned int h = I.getHeight()/2;
+  memcpy(GI[0], I[0], width*sizeof(unsigned char));
 
-  GI.resize(h, I.getWidth()) ;
-  for (unsigned int j=0 ; j < I.getWidth() ; j++)
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static) if (I.getSize() >= vpImageFilterParallelMinSize)
+#endif
+  for (int r = 1 ; r < (int) h - 1 ; r++)
   {
-    GI[0][j]=I[0][j];
-    for (unsigned int i=1 ; i < h-1 ; i++)
-    {
-         GI[i][j]=vpImageFilter::filterGaussYPyramidal(I,2*i,j);
-    }
-    GI[h-1][j]=I[2*h-1][j];
+    const unsigned int i = (unsigned int) r;
+    const unsigned char *rows[5] = { I[2*i-2], I[2*i-1], I[2*i], I[2*i+1], I[2*i+2] };
+    pyrDownColumns(rows, GI[i], width);
   }
-#endif
+
+  memcpy(GI[h-1], I[2*h-1], width*sizeof(unsigned char));
 }
 
 
@@ -0,0 +1,169 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Gaussian image pyramid with lazy level construction.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageFilter.h>
+
+/*!
+  Create an empty pyramid.
+  \param nbLevels : Number of levels including the source image. Should be greater than 0.
+*/
+vpImagePyramid::vpImagePyramid(const unsigned int nbLevels)
+  : m_image(NULL), m_frameId(0), m_nbLevels(0), m_levels(), m_nbComputed(0)
+{
+  setNbLevels(nbLevels);
+}
+
+/*!
+  Create a pyramid from an image. The levels are computed on demand.
+  \param I : Source image, used as level 0. It has to remain valid while the pyramid is used.
+  \param nbLevels : Number of levels including the source image. Should be greater than 0.
+*/
+vpImagePyramid::vpImagePyramid(const vpImage<unsigned char> &I, const unsigned int nbLevels)
+  : m_image(NULL), m_frameId(0), m_nbLevels(0), m_levels(), m_nbComputed(0)
+{
+  setNbLevels(nbLevels);
+  setImage(I);
+}
+
+/*!
+  Compute all the levels of the pyramid that are not yet available.
+  After this call, getLevel() only reads the pyramid and can be used concurrently.
+*/
+void vpImagePyramid::build()
+{
+  getLevel(m_nbLevels-1);
+}
+
+/*!
+  Detach the pyramid from its source image. The memory used by the levels is kept to be
+  reused with the next image.
+*/
+void vpImagePyramid::clear()
+{
+  m_image = NULL;
+  m_frameId = 0;
+  m_nbComputed = 0;
+}
+
+/*!
+  Return a level of the pyramid, computing it and the levels below if needed.
+  \param level : Level to return, 0 corresponding to the source image.
+  \exception vpImageException::notInitializedError : No source image.
+  \exception vpImageException::incorrectInitializationError : \e level is not lower than getNbLevels().
+*/
+const vpImage<unsigned char> &vpImagePyramid::getLevel(const unsigned int level)
+{
+  if (m_image == NULL) {
+    throw(vpImageException(vpImageException::notInitializedError,
+                           "No image in the pyramid"));
+  }
+  if (level >= m_nbLevels) {
+    throw(vpImageException(vpImageException::incorrectInitializationError,
+                           "Pyramid level %u is out of range [0, %u]", level, m_nbLevels-1));
+  }
+  if (level == 0) {
+    return *m_image;
+  }
+
+  for (; m_nbComputed < level; m_nbComputed++) {
+    const vpImage<unsigned char> &src = (m_nbComputed == 0) ? *m_image : m_levels[m_nbComputed-1];
+    vpImageFilter::getGaussPyramidal(src, m_levels[m_nbComputed]);
+  }
+
+  return m_levels[level-1];
+}
+
+/*!
+  Return true if the level is available without any computation.
+  \param level : Level to consider, 0 corresponding to the source image.
+*/
+bool vpImagePyramid::isComputed(const unsigned int level) const
+{
+  if (m_image == NULL || level >= m_nbLevels) {
+    return false;
+  }
+  return level <= m_nbComputed;
+}
+
+/*!
+  Set the source image of the pyramid. The cached levels are always invalidated.
+  \param I : Source image, used as level 0. It has to remain valid while the pyramid is used.
+*/
+void vpImagePyramid::setImage(const vpImage<unsigned char> &I)
+{
+  m_image = &I;
+  m_frameId = 0;
+  m_nbComputed = 0;
+}
+
+/*!
+  Set the source image of the pyramid identified by a frame number. The cached levels are
+  kept when the same image and frame identifier were already given, which allows several
+  consumers to share the pyramid of a frame.
+  \param I : Source image, used as level 0. It has to remain valid while the pyramid is used.
+  \param frameId : Identifier of the frame, typically a frame counter.
+  \return true if the cached levels were invalidated, false if they are reused.
+*/
+bool vpImagePyramid::setImage(const vpImage<unsigned char> &I, const unsigned long frameId)
+{
+  if (m_image == &I && m_frameId == frameId) {
+    return false;
+  }
+  m_image = &I;
+  m_frameId = frameId;
+  m_nbComputed = 0;
+  return true;
+}
+
+/*!
+  Set the number of levels of the pyramid, including the source image.
+  The levels already computed are kept.
+  \param nbLevels : Number of levels. Should be greater than 0.
+  \exception vpImageException::incorrectInitializationError : \e nbLevels is 0.
+*/
+void vpImagePyramid::setNbLevels(const unsigned int nbLevels)
+{
+  if (nbLevels == 0) {
+    throw(vpImageException(vpImageException::incorrectInitializationError,
+                           "The pyramid should have at least one level"));
+  }
+  m_nbLevels = nbLevels;
+  m_levels.resize(nbLevels-1);
+  if (m_nbComputed > nbLevels-1) {
+    m_nbComputed = nbLevels-1;
+  }
+}
@@ -154,11 +154,15 @@ void vpImageTools::imageDifference(const vpImage<unsigned char> &I1,
   if ((I1.getHeight() != Idiff.getHeight()) || (I1.getWidth() != Idiff.getWidth()))
     Idiff.resize(I1.getHeight(), I1.getWidth());
 
-  unsigned int n = I1.getHeight() * I1.getWidth() ;
-  for (unsigned int b = 0; b < n ; b++)
+  for (unsigned int i = 0; i < I1.getHeight(); i++)
   {
-    int diff = I1.bitmap[b] - I2.bitmap[b] + 128;
-    Idiff.bitmap[b] = (unsigned char) (vpMath::maximum(vpMath::minimum(diff, 255), 0));
+    const unsigned char *p1 = I1[i], *p2 = I2[i];
+    unsigned char *pdiff = Idiff[i];
+    for (unsigned int j = 0; j < I1.getWidth(); j++)
+    {
+      int diff = p1[j] - p2[j] + 128;
+      pdiff[j] = (unsigned char) (vpMath::maximum(vpMath::minimum(diff, 255), 0));
+    }
   }
 }
 
@@ -188,17 +192,21 @@ void vpImageTools::imageDifference(const vpImage<vpRGBa> &I1,
   if ((I1.getHeight() != Idiff.getHeight()) || (I1.getWidth() != Idiff.getWidth()))
     Idiff.resize(I1.getHeight(), I1.getWidth());
 
-  unsigned int n = I1.getHeight() * I1.getWidth() ;
-  for (unsigned int b = 0; b < n ; b++)
+  for (unsigned int i = 0; i < I1.getHeight(); i++)
   {
-    int diffR = I1.bitmap[b].R - I2.bitmap[b].R + 128;
-    int diffG = I1.bitmap[b].G - I2.bitmap[b].G + 128;
-    int diffB = I1.bitmap[b].B - I2.bitmap[b].B + 128;
-    int diffA = I1.bitmap[b].A - I2.bitmap[b].A + 128;
-    Idiff.bitmap[b].R = (unsigned char) (vpMath::maximum(vpMath::minimum(diffR, 255), 0));
-    Idiff.bitmap[b].G = (unsigned char) (vpMath::maximum(vpMath::minimum(diffG, 255), 0));
-    Idiff.bitmap[b].B = (unsigned char) (vpMath::maximum(vpMath::minimum(diffB, 255), 0));
-    Idiff.bitmap[b].A = (unsigned char) (vpMath::maximum(vpMath::minimum(diffA, 255), 0));
+    const vpRGBa *p1 = I1[i], *p2 = I2[i];
+    vpRGBa *pdiff = Idiff[i];
+    for (unsigned int j = 0; j < I1.getWidth(); j++)
+    {
+      int diffR = p1[j].R - p2[j].R + 128;
+      int diffG = p1[j].G - p2[j].G + 128;
+      int diffB = p1[j].B - p2[j].B + 128;
+      int diffA = p1[j].A - p2[j].A + 128;
+      pdiff[j].R = (unsigned char) (vpMath::maximum(vpMath::minimum(diffR, 255), 0));
+      pdiff[j].G = (unsigned char) (vpMath::maximum(vpMath::minimum(diffG, 255), 0));
+      pdiff[j].B = (unsigned char) (vpMath::maximum(vpMath::minimum(diffB, 255), 0));
+      pdiff[j].A = (unsigned char) (vpMath::maximum(vpMath::minimum(diffA, 255), 0));
+    }
   }
 }
 
@@ -225,11 +233,15 @@ vpImageTools::imageDifferenceAbsolute(const vpImage<unsigned char> &I1,
   if ((I1.getHeight() != Idiff.getHeight()) || (I1.getWidth() != Idiff.getWidth()))
     Idiff.resize(I1.getHeight(), I1.getWidth());
 
-  unsigned int n = I1.getHeight() * I1.getWidth() ;
-  for (unsigned int b = 0; b < n ; b++)
+  for (unsigned int i = 0; i < I1.getHeight(); i++)
   {
-    int diff = I1.bitmap[b] - I2.bitmap[b];
-    Idiff.bitmap[b] = diff;
+    const unsigned char *p1 = I1[i], *p2 = I2[i];
+    unsigned char *pdiff = Idiff[i];
+    for (unsigned int j = 0; j < I1.getWidth(); j++)
+    {
+      int diff = p1[j] - p2[j];
+      pdiff[j] = diff;
+    }
   }
 }
 
@@ -259,18 +271,22 @@ vpImageTools::imageDifferenceAbsolute(const vpImage<vpRGBa> &I1,
   if ((I1.getHeight() != Idiff.getHeight()) || (I1.getWidth() != Idiff.getWidth()))
     Idiff.resize(I1.getHeight(), I1.getWidth());
 
-  unsigned int n = I1.getHeight() * I1.getWidth() ;
-  for (unsigned int b = 0; b < n ; b++)
+  for (unsigned int i = 0; i < I1.getHeight(); i++)
   {
-    int diffR = I1.bitmap[b].R - I2.bitmap[b].R;
-    int diffG = I1.bitmap[b].G - I2.bitmap[b].G;
-    int diffB = I1.bitmap[b].B - I2.bitmap[b].B;
-    //int diffA = I1.bitmap[b].A - I2.bitmap[b].A;
-    Idiff.bitmap[b].R = diffR;
-    Idiff.bitmap[b].G = diffG;
-    Idiff.bitmap[b].B = diffB;
-    //Idiff.bitmap[b].A = diffA;
-    Idiff.bitmap[b].A = 0;
+    const vpRGBa *p1 = I1[i], *p2 = I2[i];
+    vpRGBa *pdiff = Idiff[i];
+    for (unsigned int j = 0; j < I1.getWidth(); j++)
+    {
+      int diffR = p1[j].R - p2[j].R;
+      int diffG = p1[j].G - p2[j].G;
+      int diffB = p1[j].B - p2[j].B;
+      //int diffA = p1[j].A - p2[j].A;
+      pdiff[j].R = diffR;
+      pdiff[j].G = diffG;
+      pdiff[j].B = diffB;
+      //pdiff[j].A = diffA;
+      pdiff[j].A = 0;
+    }
   }
 }
 
@@ -296,25 +312,32 @@ vpImageTools::imageAdd(const vpImage<unsigned char> &I1,
     Ires.resize(I1.getHeight(), I1.getWidth());
   }
 
-  unsigned char *ptr_I1   = I1.bitmap;
-  unsigned char *ptr_I2   = I2.bitmap;
-  unsigned char *ptr_Ires = Ires.bitmap;
-  unsigned int cpt = 0;
+  // Contiguous images are processed as a single row
+  const bool contiguous = I1.isContiguous() && I2.isContiguous() && Ires.isContiguous();
+  const unsigned int nbRows = contiguous ? 1 : Ires.getHeight();
+  const unsigned int rowSize = contiguous ? Ires.getSize() : Ires.getWidth();
 
-#if VISP_HAVE_SSE2
-  if (vpCPUFeatures::checkSSE2() && Ires.getSize() >= 16) {
-    for (; cpt <= Ires.getSize() - 16 ; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
-      const __m128i v1   = _mm_loadu_si128( (const __m128i*) ptr_I1);
-      const __m128i v2   = _mm_loadu_si128( (const __m128i*) ptr_I2);
-      const __m128i vres = saturate ? _mm_adds_epu8(v1, v2) : _mm_add_epi8(v1, v2);
+  for (unsigned int i = 0; i < nbRows; i++) {
+    const unsigned char *ptr_I1 = contiguous ? I1.bitmap : I1[i];
+    const unsigned char *ptr_I2 = contiguous ? I2.bitmap : I2[i];
+    unsigned char *ptr_Ires = contiguous ? Ires.bitmap : Ires[i];
+    unsigned int cpt = 0;
 
-      _mm_storeu_si128( (__m128i*) ptr_Ires, vres );
+#if VISP_HAVE_SSE2
+    if (vpCPUFeatures::checkSSE2() && rowSize >= 16) {
+      for (; cpt <= rowSize - 16 ; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
+        const __m128i v1   = _mm_loadu_si128( (const __m128i*) ptr_I1);
+        const __m128i v2   = _mm_loadu_si128( (const __m128i*) ptr_I2);
+        const __m128i vres = saturate ? _mm_adds_epu8(v1, v2) : _mm_add_epi8(v1, v2);
+
+        _mm_storeu_si128( (__m128i*) ptr_Ires, vres );
+      }
     }
-  }
 #endif
 
-  for (; cpt < Ires.getSize(); cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
-    *ptr_Ires = saturate ? vpMath::saturate<unsigned char>( (short int) *ptr_I1 + (short int) *ptr_I2 ) : *ptr_I1 + *ptr_I2;
+    for (; cpt < rowSize; cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
+      *ptr_Ires = saturate ? vpMath::saturate<unsigned char>( (short int) *ptr_I1 + (short int) *ptr_I2 ) : *ptr_I1 + *ptr_I2;
+    }
   }
 }
 
@@ -340,25 +363,32 @@ vpImageTools::imageSubtract(const vpImage<unsigned char> &I1,
     Ires.resize(I1.getHeight(), I1.getWidth());
   }
 
-  unsigned char *ptr_I1   = I1.bitmap;
-  unsigned char *ptr_I2   = I2.bitmap;
-  unsigned char *ptr_Ires = Ires.bitmap;
-  unsigned int cpt = 0;
+  // Contiguous images are processed as a single row
+  const bool contiguous = I1.isContiguous() && I2.isContiguous() && Ires.isContiguous();
+  const unsigned int nbRows = contiguous ? 1 : Ires.getHeight();
+  const unsigned int rowSize = contiguous ? Ires.getSize() : Ires.getWidth();
 
-#if VISP_HAVE_SSE2
-  if (vpCPUFeatures::checkSSE2() && Ires.getSize() >= 16) {
-    for (; cpt <= Ires.getSize() - 16 ; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
-      const __m128i v1   = _mm_loadu_si128( (const __m128i*) ptr_I1);
-      const __m128i v2   = _mm_loadu_si128( (const __m128i*) ptr_I2);
-      const __m128i vres = saturate ? _mm_subs_epu8(v1, v2) : _mm_sub_epi8(v1, v2);
+  for (unsigned int i = 0; i < nbRows; i++) {
+    const unsigned char *ptr_I1 = contiguous ? I1.bitmap : I1[i];
+    const unsigned char *ptr_I2 = contiguous ? I2.bitmap : I2[i];
+    unsigned char *ptr_Ires = contiguous ? Ires.bitmap : Ires[i];
+    unsigned int cpt = 0;
 
-      _mm_storeu_si128( (__m128i*) ptr_Ires, vres );
+#if VISP_HAVE_SSE2
+    if (vpCPUFeatures::checkSSE2() && rowSize >= 16) {
+      for (; cpt <= rowSize - 16 ; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
+        const __m128i v1   = _mm_loadu_si128( (const __m128i*) ptr_I1);
+        const __m128i v2   = _mm_loadu_si128( (const __m128i*) ptr_I2);
+        const __m128i vres = saturate ? _mm_subs_epu8(v1, v2) : _mm_sub_epi8(v1, v2);
+
+        _mm_storeu_si128( (__m128i*) ptr_Ires, vres );
+      }
     }
-  }
 #endif
 
-  for (; cpt < Ires.getSize(); cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
-    *ptr_Ires = saturate ? vpMath::saturate<unsigned char>( (short int) *ptr_I1 - (short int) *ptr_I2 ) : *ptr_I1 - *ptr_I2;
+    for (; cpt < rowSize; cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
+      *ptr_Ires = saturate ? vpMath::saturate<unsigned char>( (short int) *ptr_I1 - (short int) *ptr_I2 ) : *ptr_I1 - *ptr_I2;
+    }
   }
 }
 
@@ -649,7 +649,7 @@ vpColVector & vpColVector::operator=(double x)
 #ifdef VISP_HAVE_CPP11_COMPATIBILITY
 vpColVector & vpColVector::operator=(vpColVector &&other) {
   if (this != &other) {
-    free(data);
+    vpMemory::deallocate(data);
     free(rowPtrs);
 
     rowNum = other.rowNum;
@@ -79,6 +79,8 @@
 //Prototypes of specific functions
 vpMatrix subblock(const vpMatrix &, unsigned int, unsigned int);
 
+unsigned int vpMatrix::m_lapack_min_size = 0;
+
 void compute_pseudo_inverse(const vpMatrix &a, const vpColVector &sv, const vpMatrix &v,
                             unsigned int nrows, unsigned int ncols,
                             unsigned int nrows_orig, unsigned int ncols_orig,
@@ -479,48 +481,29 @@ void vpMatrix::AAt(vpMatrix &B) const
   results in a speed gain if used many times with the same result matrix
   size.
 
-  \sa AtA()
+  \e B is always filled as a full symmetric matrix. Without Blas, the sums are computed
+  for the upper triangle only and then copied to the lower triangle. A matrix with a few
+  columns, like the interaction matrix stacked over all the features in the virtual
+  visual servoing, is read row by row only once.
+
+  \sa AtA(), setLapackMatrixMinSize()
 */
 void vpMatrix::AtA(vpMatrix &B) const
 {
   if ((B.rowNum != colNum) || (B.colNum != colNum)) B.resize(colNum, colNum, false, false);
 
 #if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
-  double alpha = 1.0;
-  double beta = 0.0;
-  char transa = 'n';
-  char transb = 't';
+  if (rowNum >= m_lapack_min_size || colNum >= m_lapack_min_size) {
+    double alpha = 1.0;
+    double beta = 0.0;
+    char transa = 'n';
+    char transb = 't';
 
-  vpMatrix::blas_dgemm(transa, transb, colNum, colNum, rowNum, alpha, data, colNum, data, colNum, beta, B.data, colNum);
-#else
-  unsigned int i,j,k;
-  double s;
-  double *ptr;
-  for (i=0;i<colNum;i++)
-  {
-    double *Bi = B[i];
-    for (j=0;j<i;j++)
-    {
-      ptr=data;
-      s = 0;
-      for (k=0;k<rowNum;k++)
-      {
-        s +=(*(ptr+i)) * (*(ptr+j));
-        ptr+=colNum;
-      }
-      *Bi++ = s;
-      B[j][i] = s;
-    }
-    ptr=data;
-    s = 0;
-    for (k=0;k<rowNum;k++)
-    {
-      s +=(*(ptr+i)) * (*(ptr+i));
-      ptr+=colNum;
-    }
-    *Bi = s;
+    vpMatrix::blas_dgemm(transa, transb, colNum, colNum, rowNum, alpha, data, colNum, data, colNum, beta, B.data, colNum);
+    return;
   }
 #endif
+  vpMatrix::builtin_dsyrk(*this, B);
 }
 
 
@@ -576,7 +559,7 @@ vpMatrix::operator=(const vpMatrix &A)
 vpMatrix &
 vpMatrix::operator=(vpMatrix &&other) {
   if (this != &other) {
-    free(data);
+    vpMemory::deallocate(data);
     free(rowPtrs);
 
     rowNum = other.rowNum;
@@ -788,21 +771,17 @@ void vpMatrix::multMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVe
   if (A.rowNum != w.rowNum) w.resize(A.rowNum, false);
 
 #if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
-  double alpha = 1.0;
-  double beta = 0.0;
-  char trans = 't';
-  int incr = 1;
+  if (A.rowNum >= m_lapack_min_size || A.colNum >= m_lapack_min_size) {
+    double alpha = 1.0;
+    double beta = 0.0;
+    char trans = 't';
+    int incr = 1;
 
-  vpMatrix::blas_dgemv(trans, A.colNum, A.rowNum, alpha, A.data, A.colNum, v.data, incr, beta, w.data, incr);
-#else
-  w = 0.0;
-  for (unsigned int j=0;j<A.colNum;j++) {
-    double vj = v[j] ; // optimization em 5/12/2006
-    for (unsigned int i=0;i<A.rowNum;i++) {
-      w[i]+=A.rowPtrs[i][j] * vj;
-    }
+    vpMatrix::blas_dgemv(trans, A.colNum, A.rowNum, alpha, A.data, A.colNum, v.data, incr, beta, w.data, incr);
+    return;
   }
 #endif
+  vpMatrix::builtin_dgemv(A, v, w);
 }
 
 //---------------------------------
@@ -816,7 +795,10 @@ void vpMatrix::multMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVe
   A new matrix won't be allocated for every use of the function
   (speed gain if used many times with the same result matrix size).
 
-  \sa operator*()
+  Without Blas, the product is computed by blocks that fit in cache and the rows
+  of \e C are distributed over the threads when OpenMP is available.
+
+  \sa operator*(), setLapackMatrixMinSize()
 */
 void vpMatrix::mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
 {
@@ -829,29 +811,16 @@ void vpMatrix::mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
   }
 
 #if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
-  double alpha = 1.0;
-  double beta = 0.0;
-  char trans = 'n';
+  if (A.rowNum >= m_lapack_min_size || A.colNum >= m_lapack_min_size || B.colNum >= m_lapack_min_size) {
+    double alpha = 1.0;
+    double beta = 0.0;
+    char trans = 'n';
 
-  vpMatrix::blas_dgemm(trans, trans, B.colNum, A.rowNum, A.colNum, alpha, B.data, B.colNum, A.data, A.colNum, beta, C.data, B.colNum);
-#else
-  // 5/12/06 some "very" simple optimization to avoid indexation
-  unsigned int BcolNum = B.colNum;
-  unsigned int BrowNum = B.rowNum;
-  unsigned int i,j,k;
-  double **BrowPtrs = B.rowPtrs;
-  for (i=0;i<A.rowNum;i++)
-  {
-    double *rowptri = A.rowPtrs[i];
-    double *ci = C[i];
-    for (j=0;j<BcolNum;j++)
-    {
-      double s = 0;
-      for (k=0;k<BrowNum;k++) s += rowptri[k] * BrowPtrs[k][j];
-      ci[j] = s;
-    }
+    vpMatrix::blas_dgemm(trans, trans, B.colNum, A.rowNum, A.colNum, alpha, B.data, B.colNum, A.data, A.colNum, beta, C.data, B.colNum);
+    return;
   }
 #endif
+  vpMatrix::builtin_dgemm(A, B, C);
 }
 
 /*!
@@ -5052,6 +5021,31 @@ void vpMatrix::computeHLM(const vpMatrix &H, const double &alpha, vpMatrix &HLM)
   }
 }
 
+/*!
+  Return the matrix size from which the products use the Blas library.
+  \sa setLapackMatrixMinSize()
+*/
+unsigned int vpMatrix::getLapackMatrixMinSize()
+{
+  return m_lapack_min_size;
+}
+
+/*!
+  Set the matrix size from which mult2Matrices(), multMatrixVector() and AtA() use the
+  Blas library when ViSP is built with Lapack. When all the dimensions involved in a
+  product are lower than \e min_size, the product is computed by the built-in kernels
+  used when Blas is not available: cache blocked, vectorized with SSE2 and multithreaded
+  with OpenMP when the matrices are large enough. Calling Blas is costly compared to
+  the product of small matrices.
+
+  \param min_size : Minimal number of rows or columns. The default value 0 means that
+  Blas is always used when available.
+*/
+void vpMatrix::setLapackMatrixMinSize(const unsigned int min_size)
+{
+  m_lapack_min_size = min_size;
+}
+
 /*!
   Compute and return the Euclidean norm \f$ ||x|| = \sqrt{ \sum{A_{ij}^2}} \f$.
 
@@ -29,13 +29,28 @@
  * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
  *
  * Description:
- * BLAS subroutines.
+ * BLAS subroutines and built-in matrix multiplication kernels.
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <string.h>
+#include <utility>
+#include <vector>
+
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpMatrix.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
+#ifdef VISP_HAVE_OPENMP
+#  include <omp.h>
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 #  if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
@@ -64,9 +79,300 @@ void vpMatrix::blas_dgemv(char trans, const int M_, const int N_, double alpha,
   dgemv_(&trans, &M, &N, &alpha, a_data, &lda, x_data, &incx, &beta, y_data, &incy);
 }
 
-#  else
-// Work arround to avoid warning LNK4221: This object file does not define any previously undefined public symbols
-void dummy_vpMatrix_blas() {};
 #  endif
 
+namespace {
+// Rows of A processed by a thread at once in the matrix product
+const unsigned int vpGemmBlockRows = 32;
+// Rows of B kept in cache while they are multiplied by a block of A
+const unsigned int vpGemmBlockDepth = 128;
+// Columns of B and C kept in cache
+const unsigned int vpGemmBlockCols = 256;
+// Size of the square blocks of A^T A computed by a thread when A has many columns
+const unsigned int vpSyrkBlockSize = 32;
+// Up to this number of columns, A^T A is computed by a single rank-1 update per row of A
+const unsigned int vpSyrkNarrowCols = 32;
+// Below this number of multiplications, the products are computed using a single thread
+const double vpMatrixParallelMinOps = 1 << 20;
+
+// y[0..n[ += a * x[0..n[
+inline void axpy(const double a, const double *x, double *y, const unsigned int n, const bool useSSE2)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  if (useSSE2) {
+    const __m128d va = _mm_set1_pd(a);
+    for (; j + 1 < n; j += 2) {
+      _mm_storeu_pd(y + j, _mm_add_pd(_mm_loadu_pd(y + j), _mm_mul_pd(va, _mm_loadu_pd(x + j))));
+    }
+  }
+#else
+  (void)useSSE2;
+#endif
+  for (; j < n; j++) {
+    y[j] += a * x[j];
+  }
+}
+
+// y0[0..n[ += a0 * x[0..n[ and y1[0..n[ += a1 * x[0..n[, x being loaded only once
+inline void axpy2(const double a0, const double a1, const double *x, double *y0, double *y1,
+                  const unsigned int n, const bool useSSE2)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  if (useSSE2) {
+    const __m128d va0 = _mm_set1_pd(a0);
+    const __m128d va1 = _mm_set1_pd(a1);
+    for (; j + 1 < n; j += 2) {
+      const __m128d vx = _mm_loadu_pd(x + j);
+      _mm_storeu_pd(y0 + j, _mm_add_pd(_mm_loadu_pd(y0 + j), _mm_mul_pd(va0, vx)));
+      _mm_storeu_pd(y1 + j, _mm_add_pd(_mm_loadu_pd(y1 + j), _mm_mul_pd(va1, vx)));
+    }
+  }
+#else
+  (void)useSSE2;
+#endif
+  for (; j < n; j++) {
+    y0[j] += a0 * x[j];
+    y1[j] += a1 * x[j];
+  }
+}
+
+inline double dot(const double *x, const double *y, const unsigned int n, const bool useSSE2)
+{
+  unsigned int j = 0;
+  double s = 0;
+#if VISP_HAVE_SSE2
+  if (useSSE2 && n >= 4) {
+    __m128d s0 = _mm_setzero_pd();
+    __m128d s1 = _mm_setzero_pd();
+    for (; j + 3 < n; j += 4) {
+      s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(x + j), _mm_loadu_pd(y + j)));
+      s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(x + j + 2), _mm_loadu_pd(y + j + 2)));
+    }
+    double tmp[2];
+    _mm_storeu_pd(tmp, _mm_add_pd(s0, s1));
+    s = tmp[0] + tmp[1];
+  }
+#else
+  (void)useSSE2;
+#endif
+  for (; j < n; j++) {
+    s += x[j] * y[j];
+  }
+  return s;
+}
+
+/*
+  Add a[i] * b[j] to c[i][j] for i in [0, ni[ and j in [0, nj[, c having a row stride of ldc.
+  When upper is true, a and b are the same vector and only the upper triangle is updated (plus
+  at most one element below the diagonal per row to keep the SSE2 loads aligned on pairs).
+*/
+inline void rank1Update(const double *a, const unsigned int ni, const double *b, const unsigned int nj,
+                        double *c, const unsigned int ldc, const bool upper, const bool useSSE2)
+{
+  for (unsigned int i = 0; i < ni; i++) {
+    const unsigned int j = upper ? (i & ~1u) : 0;
+    axpy(a[i], b + j, c + i*ldc + j, nj - j, useSSE2);
+  }
+}
+
+/*
+  Upper triangle of A^T A for the rows [0, rows[ of a matrix with 6 columns, added to b.
+  The 12 pairs of accumulators stay in SSE2 registers for the whole loop.
+*/
+void syrk6(const double *a, const unsigned int rows, double *b, const bool useSSE2)
+{
+  unsigned int r = 0;
+#if VISP_HAVE_SSE2
+  if (useSSE2) {
+    __m128d b00 = _mm_loadu_pd(b), b02 = _mm_loadu_pd(b + 2), b04 = _mm_loadu_pd(b + 4);
+    __m128d b10 = _mm_loadu_pd(b + 6), b12 = _mm_loadu_pd(b + 8), b14 = _mm_loadu_pd(b + 10);
+    __m128d b22 = _mm_loadu_pd(b + 14), b24 = _mm_loadu_pd(b + 16);
+    __m128d b32 = _mm_loadu_pd(b + 20), b34 = _mm_loadu_pd(b + 22);
+    __m128d b44 = _mm_loadu_pd(b + 28);
+    __m128d b54 = _mm_loadu_pd(b + 34);
+    for (; r < rows; r++, a += 6) {
+      const __m128d a01 = _mm_loadu_pd(a), a23 = _mm_loadu_pd(a + 2), a45 = _mm_loadu_pd(a + 4);
+      __m128d x = _mm_set1_pd(a[0]);
+      b00 = _mm_add_pd(b00, _mm_mul_pd(x, a01));
+      b02 = _mm_add_pd(b02, _mm_mul_pd(x, a23));
+      b04 = _mm_add_pd(b04, _mm_mul_pd(x, a45));
+      x = _mm_set1_pd(a[1]);
+      b10 = _mm_add_pd(b10, _mm_mul_pd(x, a01));
+      b12 = _mm_add_pd(b12, _mm_mul_pd(x, a23));
+      b14 = _mm_add_pd(b14, _mm_mul_pd(x, a45));
+      x = _mm_set1_pd(a[2]);
+      b22 = _mm_add_pd(b22, _mm_mul_pd(x, a23));
+      b24 = _mm_add_pd(b24, _mm_mul_pd(x, a45));
+      x = _mm_set1_pd(a[3]);
+      b32 = _mm_add_pd(b32, _mm_mul_pd(x, a23));
+      b34 = _mm_add_pd(b34, _mm_mul_pd(x, a45));
+      b44 = _mm_add_pd(b44, _mm_mul_pd(_mm_set1_pd(a[4]), a45));
+      b54 = _mm_add_pd(b54, _mm_mul_pd(_mm_set1_pd(a[5]), a45));
+    }
+    _mm_storeu_pd(b, b00); _mm_storeu_pd(b + 2, b02); _mm_storeu_pd(b + 4, b04);
+    _mm_storeu_pd(b + 6, b10); _mm_storeu_pd(b + 8, b12); _mm_storeu_pd(b + 10, b14);
+    _mm_storeu_pd(b + 14, b22); _mm_storeu_pd(b + 16, b24);
+    _mm_storeu_pd(b + 20, b32); _mm_storeu_pd(b + 22, b34);
+    _mm_storeu_pd(b + 28, b44);
+    _mm_storeu_pd(b + 34, b54);
+  }
+#endif
+  for (; r < rows; r++, a += 6) {
+    rank1Update(a, 6, a, 6, b, 6, true, false);
+  }
+}
+
+// Upper triangle of A^T A for the rows [0, rows[ of a matrix with n columns, added to b
+void syrkRows(const double *a, const unsigned int rows, const unsigned int n, double *b, const bool useSSE2)
+{
+  if (n == 6) {
+    syrk6(a, rows, b, useSSE2);
+    return;
+  }
+  for (unsigned int r = 0; r < rows; r++, a += n) {
+    rank1Update(a, n, a, n, b, n, true, useSSE2);
+  }
+}
+}
+
+/*
+  Built-in C = A * B. The rows of A are processed by blocks distributed over the threads,
+  and the product is computed by blocks of B that fit in cache. Each element of C is
+  accumulated in the same order as with the naive triple loop.
+*/
+void vpMatrix::builtin_dgemm(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
+{
+  const unsigned int M = A.rowNum, K = A.colNum, N = B.colNum;
+  if (C.size() == 0) {
+    return;
+  }
+  memset(C.data, 0, C.size()*sizeof(double));
+
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+  const int nbBlocks = (int) ((M + vpGemmBlockRows - 1) / vpGemmBlockRows);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic) if ((double) M * N * K >= vpMatrixParallelMinOps)
+#endif
+  for (int blk = 0; blk < nbBlocks; blk++) {
+    const unsigned int i0 = (unsigned int) blk * vpGemmBlockRows;
+    const unsigned int i1 = std::min(i0 + vpGemmBlockRows, M);
+    for (unsigned int k0 = 0; k0 < K; k0 += vpGemmBlockDepth) {
+      const unsigned int k1 = std::min(k0 + vpGemmBlockDepth, K);
+      for (unsigned int j0 = 0; j0 < N; j0 += vpGemmBlockCols) {
+        const unsigned int nj = std::min(vpGemmBlockCols, N - j0);
+        unsigned int i = i0;
+        for (; i + 1 < i1; i += 2) {
+          const double *a0 = A.rowPtrs[i], *a1 = A.rowPtrs[i + 1];
+          double *c0 = C.rowPtrs[i] + j0, *c1 = C.rowPtrs[i + 1] + j0;
+          for (unsigned int k = k0; k < k1; k++) {
+            axpy2(a0[k], a1[k], B.rowPtrs[k] + j0, c0, c1, nj, useSSE2);
+          }
+        }
+        if (i < i1) {
+          const double *a0 = A.rowPtrs[i];
+          double *c0 = C.rowPtrs[i] + j0;
+          for (unsigned int k = k0; k < k1; k++) {
+            axpy(a0[k], B.rowPtrs[k] + j0, c0, nj, useSSE2);
+          }
+        }
+      }
+    }
+  }
+}
+
+/*
+  Built-in w = A * v, the rows of A being distributed over the threads.
+*/
+void vpMatrix::builtin_dgemv(const vpMatrix &A, const vpColVector &v, vpColVector &w)
+{
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+  const int rows = (int) A.rowNum;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for if ((double) A.rowNum * A.colNum >= vpMatrixParallelMinOps)
+#endif
+  for (int i = 0; i < rows; i++) {
+    w.data[i] = dot(A.rowPtrs[i], v.data, A.colNum, useSSE2);
+  }
+}
+
+/*
+  Built-in B = A^T A, A being a m-by-n matrix. B is filled as a full symmetric matrix: the
+  sums are computed for the upper triangle, then copied to the lower one.
+
+  - When n is small, which is the case of the stacked interaction matrices (m-by-6) used
+    in the virtual visual servoing, the rows of A are read once and the upper triangle is
+    updated by each row. For large m, the rows are split between the threads that update
+    their own copy of B, the copies being summed afterwards.
+  - Otherwise, B is split in square blocks computed in parallel, each one being updated
+    by all the rows of A.
+*/
+void vpMatrix::builtin_dsyrk(const vpMatrix &A, vpMatrix &B)
+{
+  const unsigned int m = A.rowNum, n = A.colNum;
+  if (n == 0) {
+    return;
+  }
+  memset(B.data, 0, B.size()*sizeof(double));
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+  const double nbOps = (double) m * n * (n + 1) / 2;
+
+  if (n <= vpSyrkNarrowCols) {
+#ifdef VISP_HAVE_OPENMP
+    const int nbThreads = omp_get_max_threads();
+    if (nbOps >= vpMatrixParallelMinOps && nbThreads > 1) {
+      std::vector<double> partial((size_t) nbThreads * n * n, 0.);
+#pragma omp parallel num_threads(nbThreads)
+      {
+        const unsigned int t = (unsigned int) omp_get_thread_num();
+        const unsigned int nt = (unsigned int) omp_get_num_threads();
+        const unsigned int r0 = (unsigned int) ((size_t) m * t / nt);
+        const unsigned int r1 = (unsigned int) ((size_t) m * (t + 1) / nt);
+        syrkRows(A.data + (size_t) r0 * n, r1 - r0, n, &partial[(size_t) t * n * n], useSSE2);
+      }
+      for (int t = 0; t < nbThreads; t++) {
+        const double *p = &partial[(size_t) t * n * n];
+        for (unsigned int k = 0; k < n * n; k++) {
+          B.data[k] += p[k];
+        }
+      }
+    }
+    else
+#endif
+    {
+      syrkRows(A.data, m, n, B.data, useSSE2);
+    }
+  }
+  else {
+    // Blocks (bi, bj) with bi <= bj of the upper triangle
+    const unsigned int nbBlocks = (n + vpSyrkBlockSize - 1) / vpSyrkBlockSize;
+    std::vector<std::pair<unsigned int, unsigned int> > blocks;
+    for (unsigned int bi = 0; bi < nbBlocks; bi++) {
+      for (unsigned int bj = bi; bj < nbBlocks; bj++) {
+        blocks.push_back(std::make_pair(bi * vpSyrkBlockSize, bj * vpSyrkBlockSize));
+      }
+    }
+    const int nbTasks = (int) blocks.size();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic) if (nbOps >= vpMatrixParallelMinOps)
+#endif
+    for (int task = 0; task < nbTasks; task++) {
+      const unsigned int i0 = blocks[(size_t) task].first, j0 = blocks[(size_t) task].second;
+      const unsigned int ni = std::min(vpSyrkBlockSize, n - i0), nj = std::min(vpSyrkBlockSize, n - j0);
+      double *b = B.rowPtrs[i0] + j0;
+      for (unsigned int r = 0; r < m; r++) {
+        const double *a = A.rowPtrs[r];
+        rank1Update(a + i0, ni, a + j0, nj, b, n, i0 == j0, useSSE2);
+      }
+    }
+  }
+
+  for (unsigned int i = 1; i < n; i++) {
+    for (unsigned int j = 0; j < i; j++) {
+      B.rowPtrs[i][j] = B.rowPtrs[j][i];
+    }
+  }
+}
+
 #endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
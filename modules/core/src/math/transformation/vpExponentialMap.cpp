@@ -77,6 +77,8 @@ vpExponentialMap::direct(const vpColVector &v)
   velocity \f$ \bf v \f$, where \f${\bf M} = \exp^{({\bf v},\Delta t)} \f$ is the displacement
   of the object when the velocity \f$ \bf v \f$ is applied during \f$\Delta t\f$ seconds.
 
+  \exception vpException::dimensionError : If \e v is not a 6-dimension vector.
+
   \sa inverse(const vpHomogeneousMatrix &, const double &)
 */
 vpHomogeneousMatrix
@@ -87,7 +89,13 @@ vpExponentialMap::direct(const vpColVector &v, const double &delta_t)
   vpRotationMatrix rd ;
   vpTranslationVector dt ;
 
-  vpColVector v_dt = v * delta_t;
+  if (v.size() != 6) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot compute the exponential map of a %u-dimension vector", v.size()));
+  }
+  double v_dt[6];
+  for (unsigned int i = 0; i < 6; i++)
+    v_dt[i] = v[i] * delta_t;
 
   u[0] = v_dt[3];
   u[1] = v_dt[4];
@@ -92,7 +92,7 @@ vpForceTwistMatrix::eye()
   Initialize a force/torque twist transformation matrix to identity.
 */
 vpForceTwistMatrix::vpForceTwistMatrix()
-  : vpArray2D<double>(6,6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   eye() ;
 }
@@ -105,7 +105,7 @@ vpForceTwistMatrix::vpForceTwistMatrix()
   \param F : Force/torque twist matrix used as initializer.
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F)
-  : vpArray2D<double>(6,6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   *this = F ;
 }
@@ -140,7 +140,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F)
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full)
-  : vpArray2D<double>(6,6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   if (full)
     buildFrom(M);
@@ -169,7 +169,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full)
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t,
                                        const vpThetaUVector &thetau)
-  : vpArray2D<double>(6,6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   buildFrom(t, thetau) ;
 }
@@ -191,7 +191,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t,
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau)
-  : vpArray2D<double>(6,6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   buildFrom(thetau) ;
 }
@@ -217,7 +217,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau)
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t,
                                        const vpRotationMatrix &R)
-  : vpArray2D<double>(6,6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   buildFrom(t, R) ;
 }
@@ -241,7 +241,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t,
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R)
-  : vpArray2D<double>(6,6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   buildFrom(R) ;
 }
@@ -266,7 +266,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R)
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const double tx, const double ty, const double tz,
                                        const double tux, const double tuy, const double tuz)
-  : vpArray2D<double>(6,6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   vpTranslationVector T(tx,ty,tz) ;
   vpThetaUVector tu(tux,tuy,tuz) ;
@@ -295,15 +295,7 @@ vpForceTwistMatrix
 vpForceTwistMatrix::operator*(const vpForceTwistMatrix &F) const
 {
   vpForceTwistMatrix Fout ;
-
-  for (unsigned int i=0;i<6;i++) {
-    for (unsigned int j=0;j<6;j++) {
-      double s =0 ;
-      for (unsigned int k=0;k<6;k++)
-        s +=rowPtrs[i][k] * F.rowPtrs[k][j];
-      Fout[i][j] = s ;
-    }
-  }
+  multiply(*this, F, Fout);
   return Fout;
 }
 
@@ -428,7 +420,13 @@ vpForceTwistMatrix
 vpForceTwistMatrix::buildFrom(const vpTranslationVector &t,
                               const vpRotationMatrix &R)
 {
-  vpMatrix skewaR = t.skew(t)*R ;
+  // [t]_x R
+  double skewaR[3][3];
+  for (unsigned int j=0 ; j < 3 ; j++) {
+    skewaR[0][j] = -t[2]*R[1][j] + t[1]*R[2][j];
+    skewaR[1][j] =  t[2]*R[0][j] - t[0]*R[2][j];
+    skewaR[2][j] = -t[1]*R[0][j] + t[0]*R[1][j];
+  }
 
   for (unsigned int i=0 ; i < 3 ; i++) {
     for (unsigned int j=0 ; j < 3 ; j++)	{
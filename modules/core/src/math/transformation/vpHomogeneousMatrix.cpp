@@ -55,7 +55,7 @@
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t,
                                          const vpQuaternionVector &q)
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   buildFrom(t,q);
   (*this)[3][3] = 1.;
@@ -65,7 +65,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t,
   Default constructor that initialize an homogeneous matrix as identity.
 */
 vpHomogeneousMatrix::vpHomogeneousMatrix()
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   eye() ;
 }
@@ -74,7 +74,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix()
   Copy constructor that initialize an homogeneous matrix from another homogeneous matrix.
 */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M)
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   *this = M;
 }
@@ -84,7 +84,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M)
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t,
                                          const vpThetaUVector &tu)
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   buildFrom(t, tu);
   (*this)[3][3] = 1.;
@@ -95,7 +95,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t,
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t,
                                          const vpRotationMatrix &R)
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   insert(R);
   insert(t);
@@ -106,7 +106,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t,
   Construct an homogeneous matrix from a pose vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpPoseVector &p)
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   buildFrom(p[0], p[1], p[2], p[3], p[4], p[5]) ;
   (*this)[3][3] = 1.;
@@ -151,7 +151,7 @@ M:
   \endcode
   */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<float> &v)
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   buildFrom(v) ;
   (*this)[3][3] = 1.;
@@ -196,7 +196,7 @@ M:
   \endcode
   */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v)
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   buildFrom(v) ;
   (*this)[3][3] = 1.;
@@ -212,7 +212,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const double tx,
                                          const double tux,
                                          const double tuy,
                                          const double tuz)
-  : vpArray2D<double>(4, 4)
+  : vpFixedArray2D<double, 4, 4>()
 {
   buildFrom(tx, ty, tz, tux, tuy, tuz);
   (*this)[3][3] = 1.;
@@ -423,21 +423,16 @@ vpHomogeneousMatrix::operator*(const vpHomogeneousMatrix &M) const
 {
   vpHomogeneousMatrix p;
 
-  vpRotationMatrix R1, R2, R ;
-  vpTranslationVector T1, T2 , T;
-
-  extract(T1) ;
-  M.extract(T2) ;
-
-  extract (R1) ;
-  M.extract (R2) ;
-
-  R = R1*R2 ;
-
-  T = R1*T2 + T1 ;
-
-  p.insert(T) ;
-  p.insert(R) ;
+  // R = R1*R2 and T = R1*T2 + T1, the last row of p is kept to [0 0 0 1]
+  const double *a = data;
+  const double *b = M.data;
+  double *c = p.data;
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 4; j++) {
+      c[4*i+j] = a[4*i]*b[j] + a[4*i+1]*b[4+j] + a[4*i+2]*b[8+j];
+    }
+    c[4*i+3] += a[4*i+3];
+  }
 
   return p;
 }
@@ -505,7 +500,7 @@ vpPoint vpHomogeneousMatrix::operator*(const vpPoint& bP) const
 {
   vpPoint aP ;
 
-  vpColVector v(4),v1(4) ;
+  double v[4], v1[4] ;
 
   v[0] = bP.get_X() ;
   v[1] = bP.get_Y() ;
@@ -517,7 +512,9 @@ vpPoint vpHomogeneousMatrix::operator*(const vpPoint& bP) const
   v1[2] = (*this)[2][0]*v[0] + (*this)[2][1]*v[1]+ (*this)[2][2]*v[2]+ (*this)[2][3]*v[3] ;
   v1[3] = (*this)[3][0]*v[0] + (*this)[3][1]*v[1]+ (*this)[3][2]*v[2]+ (*this)[3][3]*v[3] ;
 
-  v1 /= v1[3] ;
+  const double w = v1[3] ;
+  for (unsigned int i = 0; i < 4; i++)
+    v1[i] /= w ;
 
   //  v1 = M*v ;
   aP.set_X(v1[0]) ;
@@ -675,14 +672,14 @@ vpHomogeneousMatrix::inverse() const
 {
   vpHomogeneousMatrix Mi ;
 
-  vpRotationMatrix R ;      extract(R) ;
-  vpTranslationVector T ;   extract(T) ;
-
-  vpTranslationVector RtT ; RtT = -(R.t()*T) ;
-
-
-  Mi.insert(R.t()) ;
-  Mi.insert(RtT) ;
+  const double *m = data;
+  double *mi = Mi.data;
+  for (unsigned int i = 0; i < 3; i++) {
+    mi[4*i]   = m[i];
+    mi[4*i+1] = m[4+i];
+    mi[4*i+2] = m[8+i];
+    mi[4*i+3] = -(m[i]*m[3] + m[4+i]*m[7] + m[8+i]*m[11]);
+  }
 
   return Mi ;
 }
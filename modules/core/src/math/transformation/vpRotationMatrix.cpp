@@ -142,15 +142,7 @@ vpRotationMatrix
 vpRotationMatrix::operator*(const vpRotationMatrix &R) const
 {
   vpRotationMatrix p ;
-
-  for (unsigned int i=0;i<3;i++) {
-    for (unsigned int j=0;j<3;j++) {
-      double s =0 ;
-      for (unsigned int k=0;k<3;k++)
-        s +=rowPtrs[i][k] * R.rowPtrs[k][j];
-      p[i][j] = s ;
-    }
-  }
+  multiply(*this, R, p);
   return p;
 }
 /*! 
@@ -332,7 +324,7 @@ vpRotationMatrix::isARotationMatrix() const
 /*!
   Default constructor that initialise a 3-by-3 rotation matrix to identity.
 */
-vpRotationMatrix::vpRotationMatrix() : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix() : vpFixedArray2D<double, 3, 3>()
 {
   eye();
 }
@@ -341,14 +333,14 @@ vpRotationMatrix::vpRotationMatrix() : vpArray2D<double>(3,3)
 /*!
   Copy contructor that construct a 3-by-3 rotation matrix from another rotation matrix.
 */
-vpRotationMatrix::vpRotationMatrix(const vpRotationMatrix &M) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const vpRotationMatrix &M) : vpFixedArray2D<double, 3, 3>()
 {
   (*this) = M ;
 }
 /*!
   Construct a 3-by-3 rotation matrix from an homogeneous matrix.
 */
-vpRotationMatrix::vpRotationMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const vpHomogeneousMatrix &M) : vpFixedArray2D<double, 3, 3>()
 {
   buildFrom(M);
 }
@@ -356,7 +348,7 @@ vpRotationMatrix::vpRotationMatrix(const vpHomogeneousMatrix &M) : vpArray2D<dou
 /*!
   Construct a 3-by-3 rotation matrix from \f$ \theta {\bf u}\f$ angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpThetaUVector &tu) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const vpThetaUVector &tu) : vpFixedArray2D<double, 3, 3>()
 {
   buildFrom(tu) ;
 }
@@ -364,7 +356,7 @@ vpRotationMatrix::vpRotationMatrix(const vpThetaUVector &tu) : vpArray2D<double>
 /*!
   Construct a 3-by-3 rotation matrix from a pose vector.
  */
-vpRotationMatrix::vpRotationMatrix(const vpPoseVector &p) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const vpPoseVector &p) : vpFixedArray2D<double, 3, 3>()
 {
   buildFrom(p) ;
 }
@@ -372,7 +364,7 @@ vpRotationMatrix::vpRotationMatrix(const vpPoseVector &p) : vpArray2D<double>(3,
 /*!
   Construct a 3-by-3 rotation matrix from \f$ R(z,y,z) \f$ Euler angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRzyzVector &euler) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const vpRzyzVector &euler) : vpFixedArray2D<double, 3, 3>()
 {
   buildFrom(euler) ;
 }
@@ -380,7 +372,7 @@ vpRotationMatrix::vpRotationMatrix(const vpRzyzVector &euler) : vpArray2D<double
 /*!
   Construct a 3-by-3 rotation matrix from \f$ R(x,y,z) \f$ Euler angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRxyzVector &Rxyz) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const vpRxyzVector &Rxyz) : vpFixedArray2D<double, 3, 3>()
 {
   buildFrom(Rxyz) ;
 }
@@ -388,7 +380,7 @@ vpRotationMatrix::vpRotationMatrix(const vpRxyzVector &Rxyz) : vpArray2D<double>
 /*!
   Construct a 3-by-3 rotation matrix from \f$ R(z,y,x) \f$ Euler angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRzyxVector &Rzyx) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const vpRzyxVector &Rzyx) : vpFixedArray2D<double, 3, 3>()
 {
   buildFrom(Rzyx) ;
 }
@@ -396,7 +388,7 @@ vpRotationMatrix::vpRotationMatrix(const vpRzyxVector &Rzyx) : vpArray2D<double>
 /*!
   Construct a 3-by-3 rotation matrix from \f$ \theta {\bf u}=(\theta u_x, \theta u_y, \theta u_z)^T\f$ angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const double tux, const double tuy, const double tuz) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const double tux, const double tuy, const double tuz) : vpFixedArray2D<double, 3, 3>()
 {
   buildFrom(tux, tuy, tuz) ;
 }
@@ -404,7 +396,7 @@ vpRotationMatrix::vpRotationMatrix(const double tux, const double tuy, const dou
 /*!
   Construct a 3-by-3 rotation matrix from quaternion angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpQuaternionVector& q) : vpArray2D<double>(3,3)
+vpRotationMatrix::vpRotationMatrix(const vpQuaternionVector& q) : vpFixedArray2D<double, 3, 3>()
 {
   buildFrom(q);
 }
@@ -55,7 +55,7 @@
 
 */
 vpTranslationVector::vpTranslationVector(const double tx, const double ty, const double tz)
-  : vpArray2D<double>(3, 1)
+  : vpFixedArray2D<double, 3, 1>()
 {
   (*this)[0] = tx;
   (*this)[1] = ty;
@@ -70,7 +70,7 @@ vpTranslationVector::vpTranslationVector(const double tx, const double ty, const
 
 */
 vpTranslationVector::vpTranslationVector(const vpHomogeneousMatrix &M)
-  : vpArray2D<double>(3, 1)
+  : vpFixedArray2D<double, 3, 1>()
 {
   M.extract( *this );
 }
@@ -83,7 +83,7 @@ vpTranslationVector::vpTranslationVector(const vpHomogeneousMatrix &M)
 
 */
 vpTranslationVector::vpTranslationVector(const vpPoseVector &p)
-  : vpArray2D<double>(3, 1)
+  : vpFixedArray2D<double, 3, 1>()
 {
   (*this)[0] = p[0];
   (*this)[1] = p[1];
@@ -101,7 +101,7 @@ vpTranslationVector::vpTranslationVector(const vpPoseVector &p)
   \endcode
 */
 vpTranslationVector::vpTranslationVector (const vpTranslationVector &tv)
-  : vpArray2D<double>(tv)
+  : vpFixedArray2D<double, 3, 1>(tv)
 {
 }
 
@@ -119,12 +119,13 @@ vpTranslationVector::vpTranslationVector (const vpTranslationVector &tv)
 
 */
 vpTranslationVector::vpTranslationVector (const vpColVector &v)
-  : vpArray2D<double>(v)
+  : vpFixedArray2D<double, 3, 1>()
 {
   if (v.size() != 3) {
     throw(vpException(vpException::dimensionError,
                       "Cannot construct a translation vector from a %d-dimension column vector", v.size()));
   }
+  memcpy(data, v.data, 3*sizeof(double));
 }
 
 /*!
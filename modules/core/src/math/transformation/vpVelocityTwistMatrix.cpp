@@ -90,7 +90,7 @@ vpVelocityTwistMatrix::eye()
   Initialize a velocity twist transformation matrix as identity.
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix()
-  : vpArray2D<double>(6, 6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   eye() ;
 }
@@ -101,7 +101,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix()
   \param V : Velocity twist matrix used as initializer.
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V)
-  : vpArray2D<double>(6, 6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   *this = V;
 }
@@ -124,7 +124,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V)
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool full)
-  : vpArray2D<double>(6, 6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   if (full)
     buildFrom(M);
@@ -146,7 +146,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t,
                                              const vpThetaUVector &thetau)
-  : vpArray2D<double>(6, 6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   buildFrom(t, thetau) ;
 }
@@ -162,7 +162,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t,
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau)
-  : vpArray2D<double>(6, 6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   buildFrom(thetau) ;
 }
@@ -181,7 +181,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau)
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t,
                                              const vpRotationMatrix &R)
-  : vpArray2D<double>(6, 6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   buildFrom(t,R);
 }
@@ -197,7 +197,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t,
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R)
-  : vpArray2D<double>(6, 6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   buildFrom(R);
 }
@@ -221,7 +221,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const double tx,
                                              const double tux,
                                              const double tuy,
                                              const double tuz)
-  : vpArray2D<double>(6, 6)
+  : vpFixedArray2D<double, 6, 6>()
 {
   vpTranslationVector t(tx,ty,tz) ;
   vpThetaUVector tu(tux,tuy,tuz) ;
@@ -238,15 +238,7 @@ vpVelocityTwistMatrix
 vpVelocityTwistMatrix::operator*(const vpVelocityTwistMatrix &V) const
 {
   vpVelocityTwistMatrix p ;
-
-  for (unsigned int i=0;i<6;i++) {
-    for (unsigned int j=0;j<6;j++) {
-      double s =0 ;
-      for (int k=0;k<6;k++)
-        s +=rowPtrs[i][k] * V.rowPtrs[k][j];
-      p[i][j] = s ;
-    }
-  }
+  multiply(*this, V, p);
   return p;
 }
 
@@ -383,7 +375,13 @@ vpVelocityTwistMatrix
 vpVelocityTwistMatrix::buildFrom(const vpTranslationVector &t,
                                  const vpRotationMatrix &R)
 {
-  vpMatrix skewaR = t.skew(t)*R ;
+  // [t]_x R
+  double skewaR[3][3];
+  for (unsigned int j=0 ; j < 3 ; j++) {
+    skewaR[0][j] = -t[2]*R[1][j] + t[1]*R[2][j];
+    skewaR[1][j] =  t[2]*R[0][j] - t[0]*R[2][j];
+    skewaR[2][j] = -t[1]*R[0][j] + t[0]*R[1][j];
+  }
 
   for (unsigned int  i=0 ; i < 3 ; i++) {
     for (unsigned int j=0 ; j < 3 ; j++) {
@@ -498,16 +496,11 @@ vpVelocityTwistMatrix::extract( vpRotationMatrix &R) const
 void
 vpVelocityTwistMatrix::extract(vpTranslationVector &tv) const
 {
-  vpRotationMatrix R;extract(R);
-  vpMatrix skTR(3,3);
-  for (unsigned int i=0 ; i < 3 ; i++)
-    for (unsigned int j=0 ; j < 3; j++)
-    skTR[i][j] = (*this)[i][j+3];
-
-  vpMatrix skT = skTR*R.t();
-  tv[0] = skT[2][1];
-  tv[1] = skT[0][2];
-  tv[2] = skT[1][0];
+  // [t]_x = ([t]_x R) R^T, only the needed elements are computed
+  const double *v = data;
+  tv[0] = v[15]*v[6] + v[16]*v[7] + v[17]*v[8];
+  tv[1] = v[3]*v[12] + v[4]*v[13] + v[5]*v[14];
+  tv[2] = v[9]*v[0] + v[10]*v[1] + v[11]*v[2];
 }
 
 /*!
@@ -0,0 +1,264 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Point cloud with a contiguous storage of the coordinates.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPointCloud.cpp
+  \brief Point cloud with a contiguous storage of the coordinates.
+*/
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpPointCloud.h>
+
+namespace {
+  // Back-project a depth image, the depth of a pixel being depth[i][j]*depth_scale
+  template<class Type>
+  void backProject(const vpImage<Type> &depth, const vpCameraParameters &cam, const float depth_scale,
+                   float *points)
+  {
+    const unsigned int width = depth.getWidth();
+    std::vector<float> x(width);
+    for (unsigned int j = 0; j < width; j++) {
+      x[j] = (float) ((j - cam.get_u0()) * cam.get_px_inverse());
+    }
+
+    for (unsigned int i = 0; i < depth.getHeight(); i++) {
+      const float y = (float) ((i - cam.get_v0()) * cam.get_py_inverse());
+      const Type *d = depth[i];
+      float *p = points + 3*i*width;
+      for (unsigned int j = 0; j < width; j++, p += 3) {
+        const float Z = d[j] * depth_scale;
+        if (Z > 0) {
+          p[0] = x[j] * Z;
+          p[1] = y * Z;
+          p[2] = Z;
+        }
+        else {
+          p[0] = p[1] = p[2] = 0;
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Construct an empty point cloud.
+*/
+vpPointCloud::vpPointCloud()
+  : m_points(), m_mask(), m_width(0), m_height(0)
+{
+}
+
+/*!
+  Construct a point cloud of \e width x \e height points whose coordinates are
+  set to 0.
+
+  \param width : Number of points per row, the width of the depth image for an
+  organized point cloud.
+  \param height : Number of rows, 1 for an unorganized point cloud.
+*/
+vpPointCloud::vpPointCloud(const unsigned int width, const unsigned int height)
+  : m_points(), m_mask(), m_width(0), m_height(0)
+{
+  resize(width, height);
+}
+
+/*!
+  Construct a point cloud from a vector of points.
+
+  \sa buildFrom(const std::vector<vpColVector> &, const unsigned int, const unsigned int)
+*/
+vpPointCloud::vpPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width,
+                           const unsigned int height)
+  : m_points(), m_mask(), m_width(0), m_height(0)
+{
+  buildFrom(point_cloud, width, height);
+}
+
+/*!
+  Copy the points stored as a vector of column vectors of at least 3 elements
+  (X, Y, Z, and possibly a fourth homogeneous coordinate that is ignored).
+
+  \param point_cloud : Points, of size \e width x \e height.
+  \param width : Number of points per row.
+  \param height : Number of rows.
+*/
+void vpPointCloud::buildFrom(const std::vector<vpColVector> &point_cloud, const unsigned int width,
+                             const unsigned int height)
+{
+  if (point_cloud.size() != (size_t) width*height) {
+    throw(vpException(vpException::dimensionError, "Cannot build a %dx%d point cloud from %d points", width,
+                      height, (int) point_cloud.size()));
+  }
+
+  resize(width, height);
+  float *p = data();
+  for (size_t i = 0; i < point_cloud.size(); i++, p += 3) {
+    const vpColVector &P = point_cloud[i];
+    if (P.getRows() < 3) {
+      throw(vpException(vpException::dimensionError, "Point %d has %d coordinates", (int) i, P.getRows()));
+    }
+    p[0] = (float) P[0];
+    p[1] = (float) P[1];
+    p[2] = (float) P[2];
+  }
+}
+
+/*!
+  Build an organized point cloud from a depth image by back-projecting each
+  pixel with the pinhole model of the depth camera. Distortion is not taken
+  into account.
+
+  The pixels with a null or negative depth, for example the -1 value used by
+  vpKinect when no depth is available, lead to invalid points with null
+  coordinates.
+
+  \param depth : Depth image.
+  \param cam : Intrinsic parameters of the depth camera.
+  \param depth_scale : Factor that converts the values of the depth image into meters.
+*/
+void vpPointCloud::buildFrom(const vpImage<float> &depth, const vpCameraParameters &cam, const float depth_scale)
+{
+  resize(depth.getWidth(), depth.getHeight());
+  if (!empty()) {
+    backProject(depth, cam, depth_scale, data());
+  }
+}
+
+/*!
+  Build an organized point cloud from a raw 16 bits depth image, as acquired by
+  vpRealSense.
+
+  \param depth : Depth image.
+  \param cam : Intrinsic parameters of the depth camera.
+  \param depth_scale : Factor that converts the values of the depth image into meters.
+*/
+void vpPointCloud::buildFrom(const vpImage<uint16_t> &depth, const vpCameraParameters &cam, const float depth_scale)
+{
+  resize(depth.getWidth(), depth.getHeight());
+  if (!empty()) {
+    backProject(depth, cam, depth_scale, data());
+  }
+}
+
+/*!
+  Remove all the points. The memory is released.
+*/
+void vpPointCloud::clear()
+{
+  std::vector<float>().swap(m_points);
+  std::vector<unsigned char>().swap(m_mask);
+  m_width = m_height = 0;
+}
+
+/*!
+  Remove the validity mask: only the points with a null or negative depth are
+  then invalid.
+*/
+void vpPointCloud::clearValidityMask()
+{
+  std::vector<unsigned char>().swap(m_mask);
+}
+
+/*!
+  Return the number of valid points.
+
+  \sa isValid()
+*/
+unsigned int vpPointCloud::getNbValidPoints() const
+{
+  unsigned int nb = 0;
+  for (unsigned int i = 0; i < size(); i++) {
+    if (isValid(i)) {
+      nb++;
+    }
+  }
+  return nb;
+}
+
+/*!
+  Change the number of points. The coordinates of the points are not modified
+  when the size is unchanged, and no memory is allocated when the cloud becomes
+  smaller. New points have null coordinates. When a validity mask exists, all
+  the points are marked valid.
+
+  \param width : Number of points per row.
+  \param height : Number of rows.
+*/
+void vpPointCloud::resize(const unsigned int width, const unsigned int height)
+{
+  m_width = width;
+  m_height = height;
+  m_points.resize(3*(size_t) width*height, 0.0f);
+  if (!m_mask.empty()) {
+    m_mask.assign((size_t) width*height, 1);
+  }
+}
+
+/*!
+  Mark the point at index \e index as valid or not. The validity mask is created
+  at the first call, with all the other points marked as valid.
+*/
+void vpPointCloud::setValid(const unsigned int index, const bool valid)
+{
+  if (index >= size()) {
+    throw(vpException(vpException::dimensionError, "Point index %d out of a cloud of %d points", index, size()));
+  }
+  if (m_mask.empty()) {
+    m_mask.assign(size(), 1);
+  }
+  m_mask[index] = valid ? 1 : 0;
+}
+
+/*!
+  Copy the points to a vector of 3-dimension column vectors. The invalid points
+  are copied with null coordinates.
+*/
+void vpPointCloud::toVector(std::vector<vpColVector> &point_cloud) const
+{
+  point_cloud.resize(size());
+  const float *p = data();
+  for (unsigned int i = 0; i < size(); i++, p += 3) {
+    vpColVector &P = point_cloud[i];
+    P.resize(3, false);
+    if (isValid(i)) {
+      P[0] = p[0];
+      P[1] = p[1];
+      P[2] = p[2];
+    }
+    else {
+      P = 0;
+    }
+  }
+}
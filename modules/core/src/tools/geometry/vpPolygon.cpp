@@ -45,6 +45,7 @@
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpUniRand.h>
+#include <algorithm>
 #include <set>
 #include <limits>
 /*!
@@ -388,6 +389,38 @@ vpPolygon::isInside(const vpImagePoint& ip, const PointInPolygonMethod &method)
   return test;
 }
 
+/*!
+  Compute the abscissae where the horizontal line of ordinate \f$ v \f$
+  crosses the edges of the polygon, sorted in ascending order.
+
+  The crossings are computed with the same rule as isInside() with the
+  PnPolyRayCasting method, so that a point \f$ (u, v) \f$ is inside the polygon
+  if and only if \f$ u_{2k} < u \le u_{2k+1} \f$ for some \f$ k \f$. This allows
+  to rasterize a polygon row by row without testing each pixel against all the
+  edges.
+
+  \param v : Ordinate of the horizontal line.
+  \param u : Sorted abscissae of the crossings. Their number is even.
+*/
+void
+vpPolygon::getScanLineIntersections(const double v, std::vector<double> &u) const
+{
+  u.clear();
+  if (_corners.size() < 3) {
+    return;
+  }
+
+  for (size_t i = 0, j = _corners.size()-1; i < _corners.size(); i++) {
+    if ((_corners[i].get_v() < v && _corners[j].get_v() >= v) || (_corners[j].get_v() < v && _corners[i].get_v() >= v)) {
+      u.push_back(v*m_PnPolyMultiples[i] + m_PnPolyConstants[i]);
+    }
+
+    j=i;
+  }
+
+  std::sort(u.begin(), u.end());
+}
+
 void
 vpPolygon::precalcValuesPnPoly() {
   if (_corners.size() < 3) {
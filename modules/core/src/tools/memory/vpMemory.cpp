@@ -0,0 +1,324 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Aligned memory allocation with an optional per-thread buffer pool.
+ *
+ *****************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMemory.h>
+
+#if defined(VISP_HAVE_PTHREAD)
+#  include <pthread.h>
+#  define VISP_HAVE_MEMORY_POOL 1
+#else
+#  define VISP_HAVE_MEMORY_POOL 0
+#endif
+
+namespace {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  /*
+    Header stored just before each buffer returned to the user. The buffer is
+    aligned inside a block allocated with malloc().
+  */
+  struct vpMemoryBlock {
+    void *raw;
+    size_t capacity;
+    vpMemoryBlock *next;
+  };
+
+  /*
+    Size classes: 4 classes per power of two starting from 64 bytes, that is
+    64, 80, 96, 112, 128, 160, 192, 224, 256... up to 56 MB. A pooled buffer wastes
+    at most 25% of its size.
+  */
+  const int vpMemoryNbClasses = 80;
+  const size_t vpMemoryMinClassSize = 64;
+
+  struct vpMemoryPool {
+    vpMemoryBlock *heads[vpMemoryNbClasses];
+    size_t size;
+  };
+
+  bool g_poolEnabled = false;
+  size_t g_poolMaxSize = 256*1024*1024;
+
+  inline vpMemoryBlock *getBlock(const void *ptr)
+  {
+    return reinterpret_cast<vpMemoryBlock *>(const_cast<char *>(static_cast<const char *>(ptr))) - 1;
+  }
+
+  inline unsigned int highestBit(size_t v)
+  {
+    unsigned int n = 0;
+    while (v >>= 1) {
+      n++;
+    }
+    return n;
+  }
+
+  inline size_t classSize(const int k)
+  {
+    return (size_t) (4 + k % 4) << (k / 4 + 4);
+  }
+
+  // Smallest class able to hold size bytes, -1 if size is too large
+  int classUp(const size_t size)
+  {
+    if (size <= vpMemoryMinClassSize) {
+      return 0;
+    }
+    unsigned int e = highestBit(size - 1);
+    int k = (int) (e - 6) * 4 + (int) ((size - 1) >> (e - 2)) - 3;
+    return k < vpMemoryNbClasses ? k : -1;
+  }
+
+  // Largest class that fits in a buffer of cap bytes, -1 if cap is too small
+  int classDown(const size_t cap)
+  {
+    if (cap < vpMemoryMinClassSize) {
+      return -1;
+    }
+    unsigned int e = highestBit(cap);
+    int k = (int) (e - 6) * 4 + (int) (cap >> (e - 2)) - 4;
+    return k < vpMemoryNbClasses ? k : vpMemoryNbClasses - 1;
+  }
+
+  void *allocateBlock(const size_t cap)
+  {
+    void *raw = malloc(cap + sizeof(vpMemoryBlock) + vpMemory::alignment - 1);
+    if (raw == NULL) {
+      throw(vpException(vpException::memoryAllocationError,
+                        "Cannot allocate %lu bytes", (unsigned long) cap));
+    }
+    size_t addr = reinterpret_cast<size_t>(raw) + sizeof(vpMemoryBlock) + vpMemory::alignment - 1;
+    addr -= addr % vpMemory::alignment;
+    void *ptr = reinterpret_cast<void *>(addr);
+    vpMemoryBlock *block = getBlock(ptr);
+    block->raw = raw;
+    block->capacity = cap;
+    block->next = NULL;
+    return ptr;
+  }
+
+  void releasePool(vpMemoryPool *pool)
+  {
+    for (int k = 0; k < vpMemoryNbClasses; k++) {
+      vpMemoryBlock *block = pool->heads[k];
+      while (block != NULL) {
+        vpMemoryBlock *next = block->next;
+        free(block->raw);
+        block = next;
+      }
+      pool->heads[k] = NULL;
+    }
+    pool->size = 0;
+  }
+
+#if VISP_HAVE_MEMORY_POOL
+  pthread_key_t g_poolKey;
+  pthread_once_t g_poolKeyOnce = PTHREAD_ONCE_INIT;
+
+  void vpMemoryReleaseThreadPool(void *pool)
+  {
+    releasePool(static_cast<vpMemoryPool *>(pool));
+    delete static_cast<vpMemoryPool *>(pool);
+  }
+
+  void vpMemoryCreatePoolKey()
+  {
+    pthread_key_create(&g_poolKey, vpMemoryReleaseThreadPool);
+  }
+
+  // Pool of the calling thread, created on first use when create is true
+  vpMemoryPool *getPool(const bool create)
+  {
+    pthread_once(&g_poolKeyOnce, vpMemoryCreatePoolKey);
+    vpMemoryPool *pool = static_cast<vpMemoryPool *>(pthread_getspecific(g_poolKey));
+    if (pool == NULL && create) {
+      pool = new vpMemoryPool;
+      memset(pool->heads, 0, sizeof(pool->heads));
+      pool->size = 0;
+      pthread_setspecific(g_poolKey, pool);
+    }
+    return pool;
+  }
+#else
+  vpMemoryPool *getPool(const bool)
+  {
+    return NULL;
+  }
+#endif
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+}
+
+/*!
+  Allocate a buffer aligned on vpMemory::alignment bytes. When the pool is enabled, a
+  buffer previously released by the calling thread is reused if its size class matches.
+  The content of the buffer is not initialized.
+
+  \param size : Size of the buffer in bytes.
+  \return Pointer to the buffer, NULL if \e size is 0. The buffer has to be released with
+  vpMemory::deallocate().
+
+  \exception vpException::memoryAllocationError : Not enough memory.
+*/
+void *vpMemory::allocate(const size_t size)
+{
+  if (size == 0) {
+    return NULL;
+  }
+
+  if (g_poolEnabled) {
+    int k = classUp(size);
+    if (k >= 0) {
+      vpMemoryPool *pool = getPool(true);
+      if (pool != NULL) {
+        vpMemoryBlock *block = pool->heads[k];
+        if (block != NULL) {
+          pool->heads[k] = block->next;
+          pool->size -= block->capacity;
+          block->next = NULL;
+          return block + 1;
+        }
+        // Round up to the size class so that the buffer can be recycled for the same class
+        return allocateBlock(classSize(k));
+      }
+    }
+  }
+
+  return allocateBlock(size);
+}
+
+/*!
+  Return the usable size in bytes of a buffer returned by vpMemory::allocate(). It is
+  greater than or equal to the requested size.
+
+  \param ptr : Buffer returned by vpMemory::allocate(), or NULL.
+*/
+size_t vpMemory::capacity(const void *ptr)
+{
+  return ptr == NULL ? 0 : getBlock(ptr)->capacity;
+}
+
+/*!
+  Give back to the system all the buffers kept in the pool of the calling thread.
+*/
+void vpMemory::clearPool()
+{
+  vpMemoryPool *pool = getPool(false);
+  if (pool != NULL) {
+    releasePool(pool);
+  }
+}
+
+/*!
+  Release a buffer returned by vpMemory::allocate(). When the pool is enabled and the
+  pool of the calling thread is not full, the buffer is kept for a later allocation.
+
+  \param ptr : Buffer to release. Nothing is done if NULL.
+*/
+void vpMemory::deallocate(void *ptr)
+{
+  if (ptr == NULL) {
+    return;
+  }
+
+  vpMemoryBlock *block = getBlock(ptr);
+  if (g_poolEnabled) {
+    int k = classDown(block->capacity);
+    if (k >= 0) {
+      vpMemoryPool *pool = getPool(true);
+      if (pool != NULL && pool->size + block->capacity <= g_poolMaxSize) {
+        block->next = pool->heads[k];
+        pool->heads[k] = block;
+        pool->size += block->capacity;
+        return;
+      }
+    }
+  }
+
+  free(block->raw);
+}
+
+/*!
+  Return the maximum number of bytes kept in the pool of each thread.
+  \sa setPoolMaxSize()
+*/
+size_t vpMemory::getPoolMaxSize()
+{
+  return g_poolMaxSize;
+}
+
+/*!
+  Return the number of bytes currently kept in the pool of the calling thread.
+*/
+size_t vpMemory::getPoolSize()
+{
+  vpMemoryPool *pool = getPool(false);
+  return pool == NULL ? 0 : pool->size;
+}
+
+/*!
+  Return true if released buffers are pooled.
+  \sa setPoolEnabled()
+*/
+bool vpMemory::isPoolEnabled()
+{
+  return g_poolEnabled;
+}
+
+/*!
+  Enable or disable the pooling of released buffers. The pool is disabled by default.
+  Disabling the pool does not release the buffers already pooled, use clearPool() for
+  that. This setting is shared by all the threads and should be changed before they
+  are started.
+
+  \param enable : true to enable the pool. Ignored if ViSP is built without pthread.
+*/
+void vpMemory::setPoolEnabled(const bool enable)
+{
+  g_poolEnabled = enable && VISP_HAVE_MEMORY_POOL;
+}
+
+/*!
+  Set the maximum number of bytes kept in the pool of each thread. Buffers released
+  while the pool is full are given back to the system. The default value is 256 MB.
+
+  \param size : Maximum pool size in bytes.
+*/
+void vpMemory::setPoolMaxSize(const size_t size)
+{
+  g_poolMaxSize = size;
+}
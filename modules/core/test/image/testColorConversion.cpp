@@ -0,0 +1,209 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpImageConvert color conversions on synthetic images.
+ *
+ *****************************************************************************/
+/*!
+  \example testColorConversion.cpp
+
+  \brief Compare the results of vpImageConvert color and type conversions with per-pixel
+  reference implementations.
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpTime.h>
+
+namespace {
+unsigned char saturate(int v)
+{
+  return (unsigned char) (v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+void YUYVToRGBaRef(const unsigned char *yuyv, unsigned char *rgba, unsigned int size)
+{
+  for (unsigned int k = 0; k < size/2; k++) {
+    const unsigned char *s = yuyv + 4*k;
+    int cb = ((s[1] - 128) * 454) >> 8;
+    int cg = ((s[1] - 128) * 88 + (s[3] - 128) * 183) >> 8;
+    int cr = ((s[3] - 128) * 359) >> 8;
+    for (unsigned int p = 0; p < 2; p++) {
+      int y = s[2*p];
+      unsigned char *d = rgba + 8*k + 4*p;
+      d[0] = saturate(y + cr); d[1] = saturate(y - cg); d[2] = saturate(y + cb); d[3] = vpRGBa::alpha_default;
+    }
+  }
+}
+
+void YUVToRGBaRef(int y, int u, int v, unsigned char *d)
+{
+  int U = (int)((u - 128) * 0.354);
+  int V = (int)((v - 128) * 0.707);
+  d[0] = saturate(y + 2*V); d[1] = saturate(y - U - V); d[2] = saturate(y + 5*U); d[3] = vpRGBa::alpha_default;
+}
+
+bool compare(const unsigned char *a, const unsigned char *b, unsigned int n, const std::string &name)
+{
+  for (unsigned int i = 0; i < n; i++) {
+    if (a[i] != b[i]) {
+      std::cerr << name << ": difference at " << i << " (" << (int) a[i] << " != " << (int) b[i] << ")" << std::endl;
+      return false;
+    }
+  }
+  std::cout << name << " ok" << std::endl;
+  return true;
+}
+}
+
+int main()
+{
+  // Odd width to check the vectorized loops tails
+  const unsigned int width = 646, height = 482, size = width*height;
+  std::vector<unsigned char> raw(4*size);
+  unsigned int seed = 1;
+  for (size_t i = 0; i < raw.size(); i++) {
+    seed = seed * 1103515245 + 12345;
+    raw[i] = (unsigned char) (seed >> 16);
+  }
+  unsigned char *src = &raw[0];
+  std::vector<unsigned char> res(4*size), ref(4*size);
+  bool ok = true;
+
+  vpImageConvert::YUYVToRGBa(src, &res[0], width, height);
+  YUYVToRGBaRef(src, &ref[0], size);
+  ok = compare(&res[0], &ref[0], 4*size, "YUYVToRGBa") && ok;
+
+  vpImageConvert::YUV422ToRGBa(src, &res[0], size);
+  for (unsigned int k = 0; k < size/2; k++) {
+    const unsigned char *s = src + 4*k;
+    YUVToRGBaRef(s[1], s[0], s[2], &ref[8*k]);
+    YUVToRGBaRef(s[3], s[0], s[2], &ref[8*k+4]);
+  }
+  ok = compare(&res[0], &ref[0], 4*size, "YUV422ToRGBa") && ok;
+
+  vpImageConvert::YUV420ToRGBa(src, &res[0], width, height);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      unsigned int c = (i/2)*(width/2) + j/2;
+      YUVToRGBaRef(src[i*width+j], src[size+c], src[5*size/4+c], &ref[4*(i*width+j)]);
+    }
+  }
+  ok = compare(&res[0], &ref[0], 4*size, "YUV420ToRGBa") && ok;
+
+  vpImageConvert::YUYVToGrey(src, &res[0], size);
+  vpImageConvert::YUV422ToGrey(src, &res[size], size);
+  for (unsigned int k = 0; k < size; k++) {
+    ref[k] = src[2*k];
+    ref[size+k] = src[2*k+1];
+  }
+  ok = compare(&res[0], &ref[0], 2*size, "YUYVToGrey and YUV422ToGrey") && ok;
+
+  vpImageConvert::MONO16ToGrey(src, &res[0], size);
+  ok = compare(&res[0], &ref[0], size, "MONO16ToGrey") && ok;
+
+  vpImage<unsigned char> I(src, height, width, true);
+  vpImage<vpRGBa> I_rgba;
+  vpImageConvert::convert(I, I_rgba);
+  for (unsigned int k = 0; k < size; k++) {
+    ref[4*k] = ref[4*k+1] = ref[4*k+2] = src[k];
+    ref[4*k+3] = vpRGBa::alpha_default;
+  }
+  ok = compare((unsigned char *) I_rgba.bitmap, &ref[0], 4*size, "GreyToRGBa") && ok;
+
+  vpImage<vpRGBa> I_color((vpRGBa *) src, height, width, true);
+  vpImage<unsigned char> channels[4];
+  vpImageConvert::split(I_color, &channels[0], &channels[1], &channels[2], &channels[3]);
+  for (unsigned int c = 0; c < 4; c++) {
+    for (unsigned int k = 0; k < size; k++) {
+      ref[k] = src[4*k+c];
+    }
+    ok = compare(channels[c].bitmap, &ref[0], size, "split") && ok;
+  }
+  vpImage<vpRGBa> I_merge;
+  vpImageConvert::merge(&channels[0], &channels[1], &channels[2], &channels[3], I_merge);
+  ok = compare((unsigned char *) I_merge.bitmap, src, 4*size, "merge") && ok;
+
+  vpImage<float> I_float;
+  vpImage<double> I_double;
+  vpImage<uint16_t> I_uint16;
+  vpImageConvert::convert(I, I_float);
+  vpImageConvert::convert(I, I_double);
+  vpImageConvert::convert(I, I_uint16);
+  for (unsigned int k = 0; k < size; k++) {
+    if (I_float.bitmap[k] != (float) src[k] || I_double.bitmap[k] != (double) src[k] ||
+        I_uint16.bitmap[k] != (uint16_t) (src[k] << 8)) {
+      std::cerr << "Conversion from unsigned char differs at " << k << std::endl;
+      ok = false;
+      break;
+    }
+  }
+
+  vpImage<unsigned char> I_uchar;
+  vpImageConvert::convert(I_uint16, I_uchar);
+  ok = compare(I_uchar.bitmap, src, size, "uint16_t to unsigned char") && ok;
+
+  for (unsigned int k = 0; k < size; k++) {
+    I_float.bitmap[k] = (float) src[k] * 0.37f - 12.3f;
+    I_double.bitmap[k] = (double) src[k] * 1.7 + 0.1;
+  }
+  float fmin, fmax;
+  double dmin, dmax;
+  I_float.getMinMaxValue(fmin, fmax);
+  I_double.getMinMaxValue(dmin, dmax);
+  vpImageConvert::convert(I_float, I_uchar);
+  for (unsigned int k = 0; k < size; k++) {
+    ref[k] = (unsigned char) (255.f * (I_float.bitmap[k] - fmin) / (fmax - fmin));
+  }
+  ok = compare(I_uchar.bitmap, &ref[0], size, "float to unsigned char") && ok;
+  vpImageConvert::convert(I_double, I_uchar);
+  for (unsigned int k = 0; k < size; k++) {
+    ref[k] = (unsigned char) (255. * (I_double.bitmap[k] - dmin) / (dmax - dmin));
+  }
+  ok = compare(I_uchar.bitmap, &ref[0], size, "double to unsigned char") && ok;
+
+  unsigned int nbIterations = 50;
+  double t = vpTime::measureTimeMs();
+  for (unsigned int cpt = 0; cpt < nbIterations; cpt++) {
+    vpImageConvert::YUYVToRGBa(src, &res[0], width, height);
+  }
+  t = vpTime::measureTimeMs() - t;
+  std::cout << "YUYVToRGBa " << width << "x" << height << ": " << t / nbIterations << " ms" << std::endl;
+
+  if (!ok) {
+    return EXIT_FAILURE;
+  }
+  std::cout << "testColorConversion ok !" << std::endl;
+  return EXIT_SUCCESS;
+}
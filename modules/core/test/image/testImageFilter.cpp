@@ -299,6 +299,110 @@ int main(int argc, const char *argv[]) {
 #endif
 
 
+    //Test separable filters against the per-pixel implementation
+    {
+      vpImage<unsigned char> I_sep(240, 320);
+      for (unsigned int i = 0; i < I_sep.getHeight(); i++) {
+        for (unsigned int j = 0; j < I_sep.getWidth(); j++) {
+          I_sep[i][j] = (unsigned char) ((i*7 + j*13 + (i*j)%17) % 256);
+        }
+      }
+
+      const unsigned int gaussian_size = 7;
+      double gaussian_kernel[(gaussian_size+1)/2], gaussian_derivative_kernel[(gaussian_size+1)/2];
+      vpImageFilter::getGaussianKernel(gaussian_kernel, gaussian_size);
+      vpImageFilter::getGaussianDerivativeKernel(gaussian_derivative_kernel, gaussian_size);
+      const unsigned int half_size = (gaussian_size-1)/2;
+
+      vpImage<double> I_filter_x, I_filter_xy, I_grad_x, I_grad_y;
+      vpImageFilter::filterX(I_sep, I_filter_x, gaussian_kernel, gaussian_size);
+      vpImageFilter::filterY(I_filter_x, I_filter_xy, gaussian_kernel, gaussian_size);
+      vpImageFilter::getGradX(I_sep, I_grad_x, gaussian_derivative_kernel, gaussian_size);
+      vpImageFilter::getGradY(I_sep, I_grad_y, gaussian_derivative_kernel, gaussian_size);
+
+      double max_error = 0.0;
+      for (unsigned int i = half_size; i < I_sep.getHeight()-half_size; i++) {
+        for (unsigned int j = half_size; j < I_sep.getWidth()-half_size; j++) {
+          max_error = std::max(max_error, std::fabs(I_filter_x[i][j] - vpImageFilter::filterX(I_sep, i, j, gaussian_kernel, gaussian_size)));
+          max_error = std::max(max_error, std::fabs(I_filter_xy[i][j] - vpImageFilter::filterY(I_filter_x, i, j, gaussian_kernel, gaussian_size)));
+          max_error = std::max(max_error, std::fabs(I_grad_x[i][j] - vpImageFilter::derivativeFilterX(I_sep, i, j, gaussian_derivative_kernel, gaussian_size)));
+          max_error = std::max(max_error, std::fabs(I_grad_y[i][j] - vpImageFilter::derivativeFilterY(I_sep, i, j, gaussian_derivative_kernel, gaussian_size)));
+        }
+      }
+
+      std::cout << "\nMax error between separable filters and per-pixel filters: " << max_error << std::endl;
+      if (max_error > 1e-9) {
+        std::cerr << "Failed separable filters test!" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+
+    //Test Canny edge detector on a synthetic square
+    {
+      vpImage<unsigned char> I_square(120, 160, 0), I_canny;
+      for (unsigned int i = 40; i < 80; i++) {
+        for (unsigned int j = 60; j < 100; j++) {
+          I_square[i][j] = 255;
+        }
+      }
+
+      vpImageFilter::canny(I_square, I_canny, 5, 15, 3);
+
+      unsigned int nb_edges = 0, nb_false_edges = 0;
+      for (unsigned int i = 0; i < I_canny.getHeight(); i++) {
+        for (unsigned int j = 0; j < I_canny.getWidth(); j++) {
+          if (I_canny[i][j] == 255) {
+            nb_edges++;
+            if (i < 37 || i > 82 || j < 57 || j > 102 || (i > 42 && i < 77 && j > 62 && j < 97)) {
+              nb_false_edges++;
+            }
+          }
+        }
+      }
+
+      std::cout << "\nCanny on synthetic square: " << nb_edges << " edge pixels, " << nb_false_edges << " outside the square borders" << std::endl;
+      if (nb_edges < 4*30 || nb_false_edges > 0) {
+        std::cerr << "Failed Canny test!" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    //Test Canny hysteresis: a vertical edge whose contrast fades from top to bottom is only
+    //kept on its whole length when the low contrast part is connected to the high contrast one
+    {
+      vpImage<unsigned char> I_edge(120, 160, 0), I_canny;
+      for (unsigned int i = 0; i < I_edge.getHeight(); i++) {
+        for (unsigned int j = 80; j < I_edge.getWidth(); j++) {
+          I_edge[i][j] = (unsigned char)(200 - 180*i/119);
+        }
+      }
+
+      unsigned int nb_weak_edges[2] = { 0, 0 };
+      for (unsigned int k = 0; k < 2; k++) {
+        if (k == 0) {
+          vpImageFilter::canny(I_edge, I_canny, 5, 300, 3);
+        } else {
+          vpImageFilter::canny(I_edge, I_canny, 5, 10, 300, 3);
+        }
+
+        // Bottom part of the edge, where the gradient is below the upper threshold
+        for (unsigned int i = 70; i < 110; i++) {
+          for (unsigned int j = 77; j < 84; j++) {
+            nb_weak_edges[k] += I_canny[i][j] == 255 ? 1 : 0;
+          }
+        }
+      }
+
+      std::cout << "Canny hysteresis: " << nb_weak_edges[0] << " low contrast edge pixels without hysteresis, "
+                << nb_weak_edges[1] << " with hysteresis" << std::endl;
+      if (nb_weak_edges[0] != 0 || nb_weak_edges[1] != 40) {
+        std::cerr << "Failed Canny hysteresis test!" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+
     //Test on real image
     if (opt_ppath.empty()) {
       filename = vpIoTools::createFilePath(ipath, "Klimt/Klimt.pgm");
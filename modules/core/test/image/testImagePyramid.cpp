@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpImagePyramid.
+ *
+ *****************************************************************************/
+/*!
+  \example testImagePyramid.cpp
+
+  \brief Test vpImagePyramid lazy level construction and vpImageFilter::getGaussPyramidal().
+
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/core/vpTime.h>
+
+namespace {
+// Reference implementation using the per-pixel functions
+void getGaussPyramidalRef(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
+{
+  unsigned int w = I.getWidth()/2;
+  vpImage<unsigned char> GIx(I.getHeight(), w);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    GIx[i][0] = I[i][0];
+    for (unsigned int j = 1; j < w-1; j++) {
+      GIx[i][j] = vpImageFilter::filterGaussXPyramidal(I, i, 2*j);
+    }
+    GIx[i][w-1] = I[i][2*w-1];
+  }
+
+  unsigned int h = I.getHeight()/2;
+  GI.resize(h, w);
+  for (unsigned int j = 0; j < w; j++) {
+    GI[0][j] = GIx[0][j];
+    for (unsigned int i = 1; i < h-1; i++) {
+      GI[i][j] = vpImageFilter::filterGaussYPyramidal(GIx, 2*i, j);
+    }
+    GI[h-1][j] = GIx[2*h-1][j];
+  }
+}
+}
+
+int main()
+{
+  try {
+    // Odd sizes to check the vectorized loops tails
+    vpImage<unsigned char> I(483, 645);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        I[i][j] = (unsigned char) ((i*7 + j*13 + (i*j) % 31) % 256);
+      }
+    }
+
+    vpImagePyramid pyramid(4);
+    pyramid.setImage(I, 1);
+    if (pyramid.isComputed(1)) {
+      std::cerr << "Level 1 should not be computed yet" << std::endl;
+      return EXIT_FAILURE;
+    }
+    const vpImage<unsigned char> &I2 = pyramid.getLevel(2);
+    if (!pyramid.isComputed(1) || !pyramid.isComputed(2) || pyramid.isComputed(3)) {
+      std::cerr << "Levels 1 and 2 only should be computed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpImage<unsigned char> ref = I;
+    for (unsigned int l = 1; l < pyramid.getNbLevels(); l++) {
+      vpImage<unsigned char> tmp;
+      getGaussPyramidalRef(ref, tmp);
+      ref = tmp;
+      if (!(ref == pyramid.getLevel(l))) {
+        std::cerr << "Pyramid level " << l << " differs from the reference" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    std::cout << "Level 2 size: " << I2.getWidth() << "x" << I2.getHeight() << std::endl;
+
+    // Same frame: the levels are reused
+    if (pyramid.setImage(I, 1) || !pyramid.isComputed(3)) {
+      std::cerr << "The levels of the same frame should be reused" << std::endl;
+      return EXIT_FAILURE;
+    }
+    // New frame: the levels are invalidated
+    if (!pyramid.setImage(I, 2) || pyramid.isComputed(1)) {
+      std::cerr << "The levels of a new frame should be invalidated" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpImage<unsigned char> I_big(1024, 1280);
+    for (unsigned int i = 0; i < I_big.getSize(); i++) {
+      I_big.bitmap[i] = (unsigned char) (i % 251);
+    }
+    unsigned int nbIterations = 20;
+    double t = vpTime::measureTimeMs();
+    for (unsigned int cpt = 0; cpt < nbIterations; cpt++) {
+      pyramid.setImage(I_big, cpt);
+      pyramid.build();
+    }
+    t = vpTime::measureTimeMs() - t;
+    std::cout << "Pyramid of " << I_big.getWidth() << "x" << I_big.getHeight() << ": "
+              << t / nbIterations << " ms" << std::endl;
+
+    std::cout << "testImagePyramid ok !" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,250 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpImage views over external memory.
+ *
+ *****************************************************************************/
+/*!
+  \example testImageView.cpp
+
+  \brief Test vpImage views with a row pitch and views over a region of an image.
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+
+int main()
+{
+  try {
+    // 320x240 image stored in a buffer with rows of 352 pixels
+    const unsigned int width = 320, height = 240, pitch = 352;
+    std::vector<unsigned char> buffer(pitch*height, 7);
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        buffer[i*pitch+j] = (unsigned char) ((i*3 + j*5) % 200 + ((i/40 + j/40) % 2) * 50);
+      }
+    }
+
+    vpImage<unsigned char> I;
+    I.initView(&buffer[0], height, width, pitch);
+    if (!I.isView() || I.isContiguous() || I.getPitch() != pitch) {
+      std::cerr << "The image should be a non contiguous view" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Contiguous copy
+    vpImage<unsigned char> I_copy(&buffer[0], height, width, pitch, true);
+    vpImage<unsigned char> I_copy2 = I;
+    if (I_copy.isView() || !I_copy.isContiguous() || !(I_copy == I) || !(I_copy2 == I)) {
+      std::cerr << "The copy of the view should be a contiguous image with the same pixels" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        if (I(i, j) != buffer[i*pitch+j] || I[i][j] != buffer[i*pitch+j]) {
+          std::cerr << "Bad pixel access in the view at " << i << ", " << j << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    unsigned char min, max;
+    I.getMinMaxValue(min, max);
+    if (min != 0 || max != 249) {
+      std::cerr << "Bad min/max in the view: " << (int) min << " " << (int) max << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Conversions and filters give the same results on the view and on its copy
+    vpImage<vpRGBa> I_rgba, I_rgba_copy;
+    vpImageConvert::convert(I, I_rgba);
+    vpImageConvert::convert(I_copy, I_rgba_copy);
+    vpImage<double> I_double, I_double_copy;
+    vpImageConvert::convert(I, I_double);
+    vpImageConvert::convert(I_copy, I_double_copy);
+    vpImage<unsigned char> I_canny, I_canny_copy;
+    vpImageFilter::canny(I, I_canny, 3, 30, 3);
+    vpImageFilter::canny(I_copy, I_canny_copy, 3, 30, 3);
+    vpImage<unsigned char> I_pyr, I_pyr_copy;
+    vpImageFilter::getGaussPyramidal(I, I_pyr);
+    vpImageFilter::getGaussPyramidal(I_copy, I_pyr_copy);
+    if (!(I_rgba == I_rgba_copy) || !(I_double == I_double_copy) || !(I_canny == I_canny_copy) || !(I_pyr == I_pyr_copy)) {
+      std::cerr << "Conversions or filters differ between the view and its copy" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+#if defined(VISP_HAVE_OPENCV)
+    // Conversions to OpenCV images follow the pitch of the view
+    vpImage<vpRGBa> rgba_roi;
+    rgba_roi.initView(I_rgba_copy, 10, 20, 100, 120);
+    vpImage<vpRGBa> rgba_roi_copy = rgba_roi;
+    IplImage *ipl = NULL, *ipl_copy = NULL;
+    vpImage<unsigned char> I_ipl, I_ipl_copy;
+    vpImageConvert::convert(I, ipl);
+    vpImageConvert::convert(I_copy, ipl_copy);
+    vpImageConvert::convert(ipl, I_ipl);
+    vpImageConvert::convert(ipl_copy, I_ipl_copy);
+    vpImage<vpRGBa> rgba_ipl, rgba_ipl_copy;
+    vpImageConvert::convert(rgba_roi, ipl);
+    vpImageConvert::convert(rgba_roi_copy, ipl_copy);
+    vpImageConvert::convert(ipl, rgba_ipl);
+    vpImageConvert::convert(ipl_copy, rgba_ipl_copy);
+    cvReleaseImage(&ipl);
+    cvReleaseImage(&ipl_copy);
+    if (!(I_ipl == I_copy) || !(I_ipl_copy == I_copy) || !(rgba_ipl == rgba_ipl_copy)) {
+      std::cerr << "The conversion of the view to an IplImage differs from its copy" << std::endl;
+      return EXIT_FAILURE;
+    }
+#  if (VISP_HAVE_OPENCV_VERSION >= 0x020100)
+    cv::Mat mat, mat_shared, mat_rgba, mat_rgba_copy;
+    vpImageConvert::convert(I, mat);
+    vpImageConvert::convert(I, mat_shared, false);
+    vpImageConvert::convert(rgba_roi, mat_rgba);
+    vpImageConvert::convert(rgba_roi_copy, mat_rgba_copy);
+    vpImage<unsigned char> I_mat, I_mat_shared;
+    vpImageConvert::convert(mat, I_mat);
+    vpImageConvert::convert(mat_shared, I_mat_shared);
+    vpImage<vpRGBa> rgba_mat, rgba_mat_copy;
+    vpImageConvert::convert(mat_rgba, rgba_mat);
+    vpImageConvert::convert(mat_rgba_copy, rgba_mat_copy);
+    if (!(I_mat == I_copy) || !(I_mat_shared == I_copy) || mat_shared.data != I.bitmap || !(rgba_mat == rgba_mat_copy)) {
+      std::cerr << "The conversion of the view to a cv::Mat differs from its copy" << std::endl;
+      return EXIT_FAILURE;
+    }
+#  endif
+#endif
+
+    // Conversion written into a view of the same size
+    std::vector<unsigned char> grey_buffer(pitch*height, 0);
+    vpImage<unsigned char> I_grey;
+    I_grey.initView(&grey_buffer[0], height, width, pitch);
+    vpImage<unsigned char> I_grey_ref;
+    vpImageConvert::convert(I_rgba, I_grey);
+    vpImageConvert::convert(I_rgba_copy, I_grey_ref);
+    if (!I_grey.isView() || !(I_grey == I_grey_ref) || grey_buffer[width] != 0) {
+      std::cerr << "The conversion should be written in the view" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Image tools give the same results on the view and on its copy, and write into an output view
+    vpImage<unsigned char> I_add, I_add_copy, I_diff, I_diff_copy, I_flip, I_flip_copy;
+    vpImageTools::imageAdd(I, I_grey, I_add, true);
+    vpImageTools::imageAdd(I_copy, I_grey_ref, I_add_copy, true);
+    vpImageTools::imageDifference(I, I_grey, I_diff);
+    vpImageTools::imageDifference(I_copy, I_grey_ref, I_diff_copy);
+    vpImageTools::flip(I, I_flip);
+    vpImageTools::flip(I_copy, I_flip_copy);
+    if (!(I_add == I_add_copy) || !(I_diff == I_diff_copy) || !(I_flip == I_flip_copy)) {
+      std::cerr << "Image tools differ between the view and its copy" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpImageTools::imageSubtract(I, I_copy, I_grey, false);
+    vpImageTools::binarise(I_copy, (unsigned char) 100, (unsigned char) 150, (unsigned char) 0, (unsigned char) 1,
+                           (unsigned char) 2);
+    vpImageTools::binarise(I, (unsigned char) 100, (unsigned char) 150, (unsigned char) 0, (unsigned char) 1,
+                           (unsigned char) 2);
+    vpImageTools::flip(I);
+    vpImageTools::flip(I_copy);
+    I_grey_ref = 0;
+    if (!I_grey.isView() || !(I_grey == I_grey_ref) || !(I == I_copy) || buffer[width] != 7) {
+      std::cerr << "Image tools should write into the view" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Reading and writing a view
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testImageView");
+    vpIoTools::makeDirectory(directory);
+    std::string filename = vpIoTools::createFilePath(directory, "view.pgm");
+    vpImageIo::write(I, filename);
+    vpImage<unsigned char> I_read;
+    vpImageIo::read(I_read, filename);
+    if (!(I_read == I_copy)) {
+      std::cerr << "The view was not written as an image" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpImageIo::read(I_grey, filename);
+    if (I_grey.isView() || !(I_grey == I_copy) || grey_buffer[0] != 0) {
+      std::cerr << "Reading into a view should give an image that owns its bitmap" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpIoTools::remove(directory);
+
+    // Region of interest
+    vpImage<unsigned char> roi;
+    roi.initView(I_copy, 40, 60, 100, 120);
+    if (roi.getPitch() != width || roi[0][0] != I_copy[40][60] || roi[99][119] != I_copy[139][179]) {
+      std::cerr << "Bad region of interest" << std::endl;
+      return EXIT_FAILURE;
+    }
+    roi = 255;
+    if (I_copy[40][60] != 255 || I_copy[139][179] != 255 || I_copy[39][60] == 255 || I_copy[40][180] == 255) {
+      std::cerr << "Modifying the region should modify the image" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Resizing a view to another size allocates a new bitmap
+    roi.resize(10, 10);
+    if (roi.isView() || !roi.isContiguous()) {
+      std::cerr << "The resized view should own its bitmap" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    bool exception = false;
+    try {
+      roi.initView(I_copy, 200, 300, 100, 120);
+    } catch (const vpException &) {
+      exception = true;
+    }
+    if (!exception) {
+      std::cerr << "A region outside the image should be rejected" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testImageView ok !" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
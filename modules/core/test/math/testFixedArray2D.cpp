@@ -0,0 +1,149 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test fixed size matrices used for rigid transformations.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testFixedArray2D.cpp
+
+  \brief Test fixed size matrices used for rigid transformations against the
+  generic vpMatrix computations.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpForceTwistMatrix.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+namespace {
+  bool equal(const vpArray2D<double> &A, const vpArray2D<double> &B, const double eps = 1e-12)
+  {
+    if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
+      return false;
+    }
+    for (unsigned int i = 0; i < A.size(); i++) {
+      if (std::fabs(A.data[i] - B.data[i]) > eps) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    vpHomogeneousMatrix aMb(0.1, -0.2, 0.3, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+    vpHomogeneousMatrix bMc(-0.4, 0.5, 1.2, vpMath::rad(-45), vpMath::rad(5), vpMath::rad(60));
+
+    // Products and inverses compared to the generic matrix code
+    vpMatrix aMc_ref = vpMatrix(aMb) * vpMatrix(bMc);
+    if (!equal(aMb * bMc, aMc_ref)) {
+      std::cerr << "Bad homogeneous matrix product" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!equal(aMb.inverse(), vpMatrix(aMb).inverseByLU(), 1e-9)) {
+      std::cerr << "Bad homogeneous matrix inverse" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpRotationMatrix R1 = aMb.getRotationMatrix(), R2 = bMc.getRotationMatrix();
+    if (!equal(R1 * R2, vpMatrix(R1) * vpMatrix(R2))) {
+      std::cerr << "Bad rotation matrix product" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpVelocityTwistMatrix V1(aMb), V2(bMc);
+    if (!equal(V1 * V2, vpMatrix(V1) * vpMatrix(V2)) || !equal(V1 * V2, vpVelocityTwistMatrix(aMb * bMc))) {
+      std::cerr << "Bad velocity twist matrix product" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpTranslationVector t;
+    V1.extract(t);
+    if (!equal(t, aMb.getTranslationVector())) {
+      std::cerr << "Bad translation extracted from a velocity twist matrix" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpForceTwistMatrix F1(aMb), F2(bMc);
+    if (!equal(F1 * F2, vpMatrix(F1) * vpMatrix(F2)) || !equal(F1 * F2, vpForceTwistMatrix(aMb * bMc))) {
+      std::cerr << "Bad force twist matrix product" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Exponential map round trip
+    vpColVector v = vpExponentialMap::inverse(aMb, 0.5);
+    if (!equal(vpExponentialMap::direct(v, 0.5), aMb, 1e-9)) {
+      std::cerr << "Bad exponential map" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Copies do not share their storage
+    vpHomogeneousMatrix M(aMb), N;
+    N = M;
+    M[0][3] = 10.;
+    if (N[0][3] != aMb[0][3] || M.data == N.data) {
+      std::cerr << "Copies share their storage" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A fixed size array cannot be resized through vpArray2D
+    vpArray2D<double> &A = N;
+    try {
+      A.resize(3, 3);
+      std::cerr << "A fixed size array should not be resized" << std::endl;
+      return EXIT_FAILURE;
+    }
+    catch(vpException &e) {
+      if (e.getCode() != vpException::dimensionError) {
+        return EXIT_FAILURE;
+      }
+    }
+    A = vpMatrix(aMb);
+    if (!equal(N, aMb)) {
+      std::cerr << "Bad copy through vpArray2D" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testFixedArray2D is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
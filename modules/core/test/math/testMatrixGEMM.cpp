@@ -0,0 +1,176 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the built-in matrix products used when Blas is not available.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMatrixGEMM.cpp
+
+  \brief Test the built-in matrix products (A*B, A*v and A^T*A) used when Blas
+  is not available, against naive implementations.
+*/
+
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpMatrix.h>
+
+namespace {
+  void fill(vpMatrix &M, const unsigned int rows, const unsigned int cols, const unsigned int seed)
+  {
+    M.resize(rows, cols);
+    for (unsigned int i = 0; i < M.size(); i++) {
+      M.data[i] = std::sin(0.37 * (i + 1) + seed) * 10.;
+    }
+  }
+
+  bool equal(const vpArray2D<double> &A, const vpArray2D<double> &B, const double eps = 1e-9)
+  {
+    if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
+      return false;
+    }
+    for (unsigned int i = 0; i < A.size(); i++) {
+      if (std::fabs(A.data[i] - B.data[i]) > eps * (1. + std::fabs(B.data[i]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  vpMatrix naiveProduct(const vpMatrix &A, const vpMatrix &B)
+  {
+    vpMatrix C(A.getRows(), B.getCols());
+    for (unsigned int i = 0; i < A.getRows(); i++) {
+      for (unsigned int j = 0; j < B.getCols(); j++) {
+        double s = 0;
+        for (unsigned int k = 0; k < A.getCols(); k++) {
+          s += A[i][k] * B[k][j];
+        }
+        C[i][j] = s;
+      }
+    }
+    return C;
+  }
+
+  vpMatrix naiveAtA(const vpMatrix &A)
+  {
+    vpMatrix B(A.getCols(), A.getCols());
+    for (unsigned int i = 0; i < A.getCols(); i++) {
+      for (unsigned int j = 0; j < A.getCols(); j++) {
+        double s = 0;
+        for (unsigned int k = 0; k < A.getRows(); k++) {
+          s += A[k][i] * A[k][j];
+        }
+        B[i][j] = s;
+      }
+    }
+    return B;
+  }
+
+  bool testProducts()
+  {
+    const unsigned int sizes[][3] = { {1, 1, 1}, {3, 5, 7}, {6, 6, 6}, {33, 129, 257}, {300, 200, 301}, {2000, 6, 6},
+                                      {6, 2000, 6}, {5, 0, 4} };
+    for (unsigned int t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+      vpMatrix A, B, C;
+      fill(A, sizes[t][0], sizes[t][1], 1);
+      fill(B, sizes[t][1], sizes[t][2], 2);
+      vpMatrix::mult2Matrices(A, B, C);
+      if (!equal(C, naiveProduct(A, B))) {
+        std::cerr << "Bad product of (" << A.getRows() << "x" << A.getCols() << ") by ("
+                  << B.getRows() << "x" << B.getCols() << ") matrices" << std::endl;
+        return false;
+      }
+
+      vpColVector v = B.getCols() > 0 ? B.getCol(0) : vpColVector(B.getRows());
+      if (A.getCols() > 0 && !equal(A * v, naiveProduct(A, v))) {
+        std::cerr << "Bad product of a (" << A.getRows() << "x" << A.getCols() << ") matrix by a vector" << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool testAtA(const bool symmetric)
+  {
+    // Narrow matrices with 6 columns like the stacked interaction matrices, up to the
+    // multithreaded case, and wider matrices computed by blocks
+    const unsigned int sizes[][2] = { {1, 1}, {7, 3}, {10, 6}, {2000, 6}, {200000, 6}, {1000, 7}, {50000, 12},
+                                      {100, 70}, {513, 130}, {0, 4} };
+    for (unsigned int t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+      vpMatrix A;
+      fill(A, sizes[t][0], sizes[t][1], 3);
+      vpMatrix B = A.AtA();
+      if (!equal(B, naiveAtA(A))) {
+        std::cerr << "Bad AtA of a (" << A.getRows() << "x" << A.getCols() << ") matrix" << std::endl;
+        return false;
+      }
+      for (unsigned int i = 0; i < B.getRows() && symmetric; i++) {
+        for (unsigned int j = 0; j < i; j++) {
+          if (B[i][j] != B[j][i]) {
+            std::cerr << "AtA is not symmetric" << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    // Built-in kernels, used whatever the matrix size
+    vpMatrix::setLapackMatrixMinSize(UINT_MAX);
+    if (!testProducts() || !testAtA(true)) {
+      return EXIT_FAILURE;
+    }
+
+    // Blas when available, A^T*A being not exactly symmetric with some implementations
+    vpMatrix::setLapackMatrixMinSize(0);
+    if (!testProducts() || !testAtA(false)) {
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testMatrixGEMM is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpPointCloud.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPointCloud.cpp
+
+  \brief Test the point cloud container and its conversions.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpPointCloud.h>
+
+int main()
+{
+  try {
+    const unsigned int width = 8, height = 6;
+    vpCameraParameters cam(100, 120, 4, 3);
+
+    // Back-projection of a depth image
+    vpImage<float> depth(height, width, 2.0f);
+    depth[1][2] = -1.0f; // no measurement
+    depth[4][5] = 0.0f;
+    vpPointCloud cloud;
+    cloud.buildFrom(depth, cam);
+    if (cloud.getWidth() != width || cloud.getHeight() != height || !cloud.isOrganized() ||
+        cloud.getNbValidPoints() != width*height - 2) {
+      std::cerr << "Bad point cloud built from a depth map" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        const float *p = cloud(i, j);
+        if (!cloud.isValid(i*width + j)) {
+          if (p[0] != 0 || p[1] != 0 || p[2] != 0) {
+            std::cerr << "Invalid point with non null coordinates" << std::endl;
+            return EXIT_FAILURE;
+          }
+          continue;
+        }
+        double u = cam.get_u0() + cam.get_px() * p[0] / p[2];
+        double v = cam.get_v0() + cam.get_py() * p[1] / p[2];
+        if (std::fabs(u - j) > 1e-4 || std::fabs(v - i) > 1e-4 || p[2] != 2.0f) {
+          std::cerr << "Point (" << i << ", " << j << ") is not projected on its pixel" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    // Raw depth image with a scale factor
+    vpImage<uint16_t> raw(height, width, 1500);
+    vpPointCloud cloud_raw;
+    cloud_raw.buildFrom(raw, cam, 0.001f);
+    if (std::fabs(cloud_raw[7][2] - 1.5f) > 1e-6) {
+      std::cerr << "Bad depth scale" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Round trip with a vector of column vectors
+    std::vector<vpColVector> points;
+    cloud.toVector(points);
+    vpPointCloud cloud2(points, width, height);
+    if (points.size() != cloud.size() || cloud2.getNbValidPoints() != cloud.getNbValidPoints()) {
+      std::cerr << "Bad conversion to or from std::vector<vpColVector>" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < 3*cloud.size(); i++) {
+      if (cloud.data()[i] != cloud2.data()[i]) {
+        std::cerr << "Coordinates changed by the conversions" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // The storage is reused when the size does not change
+    const float *ptr = cloud2.data();
+    cloud2.buildFrom(depth, cam);
+    if (cloud2.data() != ptr) {
+      std::cerr << "Point cloud reallocated" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Validity mask
+    cloud2.setValid(3, false);
+    if (!cloud2.hasValidityMask() || cloud2.isValid(3) || !cloud2.isValid(4) ||
+        cloud2.getNbValidPoints() != cloud.getNbValidPoints() - 1) {
+      std::cerr << "Bad validity mask" << std::endl;
+      return EXIT_FAILURE;
+    }
+    cloud2.clearValidityMask();
+    if (!cloud2.isValid(3)) {
+      std::cerr << "Validity mask not cleared" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    try {
+      vpPointCloud bad(points, width + 1, height);
+      std::cerr << "Size mismatch not detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+    catch(vpException &e) {
+      if (e.getCode() != vpException::dimensionError) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << "testPointCloud is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -192,6 +192,32 @@ main(int argc, const char** argv)
     std::cout << " area : " << p3.getArea() << std::endl;
     std::cout << " center : " << p3.getCenter() << std::endl;
 
+    // The scan line rasterization must select the same pixels as the ray casting test
+    vpPolygon polygons[3] = { p1, p2, p3 };
+    std::vector<double> intersections;
+    for (unsigned int k = 0; k < 3; k++) {
+      for (unsigned int i = 0; i < I.getHeight(); i++) {
+        polygons[k].getScanLineIntersections(i, intersections);
+        if (intersections.size() % 2 != 0) {
+          std::cerr << "Odd number of scan line intersections for polygon " << k+1 << std::endl;
+          return 1;
+        }
+
+        for (unsigned int j = 0; j < I.getWidth(); j++) {
+          bool inside = false;
+          for (size_t l = 0; l < intersections.size(); l += 2) {
+            inside = inside || (intersections[l] < j && j <= intersections[l+1]);
+          }
+
+          if (inside != polygons[k].isInside(vpImagePoint(i, j), vpPolygon::PnPolyRayCasting)) {
+            std::cerr << "Scan line rasterization differs from isInside() for polygon " << k+1
+                      << " at " << vpImagePoint(i, j) << std::endl;
+            return 1;
+          }
+        }
+      }
+    }
+
 
     if(opt_display) {
 #if (defined VISP_HAVE_X11) || (defined VISP_HAVE_GTK) || (defined VISP_HAVE_GDI)
@@ -0,0 +1,218 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test aligned and pooled allocation of images and matrices.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMemory.cpp
+
+  \brief Test aligned and pooled allocation of images and matrices.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMemory.h>
+
+namespace {
+  bool isAligned(const void *ptr)
+  {
+    return reinterpret_cast<size_t>(ptr) % vpMemory::alignment == 0;
+  }
+
+  bool testAlignment()
+  {
+    for (size_t size = 1; size < 100000; size = size*3 + 1) {
+      void *ptr = vpMemory::allocate(size);
+      bool ok = isAligned(ptr) && vpMemory::capacity(ptr) >= size;
+      memset(ptr, 0, size);
+      vpMemory::deallocate(ptr);
+      if (!ok) {
+        std::cerr << "Bad buffer of " << size << " bytes" << std::endl;
+        return false;
+      }
+    }
+
+    vpImage<unsigned char> I(3, 7);
+    vpImage<vpRGBa> Irgba;
+    Irgba.resize(101, 33);
+    vpMatrix M(5, 3);
+    vpColVector v(6);
+    if (!isAligned(I.bitmap) || !isAligned(Irgba.bitmap) || !isAligned(M.data) || !isAligned(v.data)) {
+      std::cerr << "Image or matrix storage is not aligned" << std::endl;
+      return false;
+    }
+    // vpRGBa default constructor is still called on each pixel
+    if (Irgba[100][32] != vpRGBa()) {
+      std::cerr << "vpRGBa pixels are not initialized" << std::endl;
+      return false;
+    }
+
+    // Image that takes the ownership of an array allocated with new[]
+    vpImage<unsigned char> Iarray(new unsigned char[12], 3, 4, false);
+    Iarray = 5;
+    Iarray.resize(8, 8);
+    if (!isAligned(Iarray.bitmap)) {
+      std::cerr << "Resized image is not aligned" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  bool testResize()
+  {
+    vpMatrix M(3, 4);
+    for (unsigned int i = 0; i < M.size(); i++) {
+      M.data[i] = i;
+    }
+
+    // Same number of columns: the common part is kept
+    M.resize(50, 4, false);
+    for (unsigned int i = 0; i < 12; i++) {
+      if (M.data[i] != i) {
+        std::cerr << "Values lost when adding rows" << std::endl;
+        return false;
+      }
+    }
+    M.resize(2, 4, false);
+    for (unsigned int i = 0; i < 8; i++) {
+      if (M.data[i] != i) {
+        std::cerr << "Values lost when removing rows" << std::endl;
+        return false;
+      }
+    }
+
+    // Different number of columns: values recopied case per case
+    M.resize(3, 6, false);
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 6; j++) {
+        double expected = (i < 2 && j < 4) ? i*4 + j : 0;
+        if (M[i][j] != expected) {
+          std::cerr << "Bad value after changing the number of columns" << std::endl;
+          return false;
+        }
+      }
+    }
+
+    M.resize(0, 0);
+    if (M.data != NULL) {
+      std::cerr << "Empty matrix should not have data" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  bool testPool()
+  {
+    vpMemory::setPoolEnabled(true);
+    if (!vpMemory::isPoolEnabled()) {
+      std::cout << "Memory pool not available" << std::endl;
+      return true;
+    }
+
+    vpMemory::clearPool();
+    void *ptr = vpMemory::allocate(1000);
+    vpMemory::deallocate(ptr);
+    if (vpMemory::getPoolSize() < 1000) {
+      std::cerr << "Released buffer not pooled" << std::endl;
+      return false;
+    }
+    void *ptr2 = vpMemory::allocate(990);
+    vpMemory::deallocate(ptr2);
+    if (ptr2 != ptr) {
+      std::cerr << "Pooled buffer not reused" << std::endl;
+      return false;
+    }
+
+    // Temporaries created at each iteration reuse the same buffers
+    const unsigned char *bitmap = NULL;
+    const double *data = NULL;
+    for (unsigned int iter = 0; iter < 10; iter++) {
+      vpImage<unsigned char> I(240, 320, iter);
+      vpMatrix J(200, 6);
+      if (iter == 0) {
+        bitmap = I.bitmap;
+        data = J.data;
+      }
+      else if (I.bitmap != bitmap || J.data != data) {
+        std::cerr << "Temporaries not recycled" << std::endl;
+        return false;
+      }
+      if (I[239][319] != iter || J[199][5] != 0) {
+        std::cerr << "Bad content of recycled buffers" << std::endl;
+        return false;
+      }
+    }
+
+    // A full pool gives the buffers back to the system
+    vpMemory::clearPool();
+    size_t maxSize = vpMemory::getPoolMaxSize();
+    vpMemory::setPoolMaxSize(500);
+    vpMemory::deallocate(vpMemory::allocate(1000));
+    vpMemory::setPoolMaxSize(maxSize);
+    if (vpMemory::getPoolSize() != 0) {
+      std::cerr << "Pool max size not respected" << std::endl;
+      return false;
+    }
+
+    vpMemory::deallocate(vpMemory::allocate(1000));
+    vpMemory::clearPool();
+    vpMemory::setPoolEnabled(false);
+    if (vpMemory::getPoolSize() != 0) {
+      std::cerr << "Pool not cleared" << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    if (!testAlignment() || !testResize()) {
+      return EXIT_FAILURE;
+    }
+    if (!testPool()) {
+      return EXIT_FAILURE;
+    }
+    std::cout << "testMemory is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -60,6 +60,10 @@ vpDetectorDataMatrixCode::vpDetectorDataMatrixCode()
  */
 bool vpDetectorDataMatrixCode::detect(const vpImage<unsigned char> &I)
 {
+  if (!I.isContiguous()) {
+    return detect(vpImage<unsigned char>(I));
+  }
+
   bool detected = false;
   m_message.clear();
   m_polygon.clear();
@@ -59,6 +59,11 @@ vpDetectorQRCode::vpDetectorQRCode() : m_scanner()
  */
 bool vpDetectorQRCode::detect(const vpImage<unsigned char> &I)
 {
+  if (!I.isContiguous()) {
+    // zbar scans a single block of width*height pixels
+    return detect(vpImage<unsigned char>(I));
+  }
+
   bool detected = false;
   m_message.clear();
   m_polygon.clear();
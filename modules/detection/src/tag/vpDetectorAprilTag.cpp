@@ -133,7 +133,7 @@ public:
 
     image_u8_t im = { /*.width =*/ (int32_t) I.getWidth(),
                       /*.height =*/ (int32_t) I.getHeight(),
-                      /*.stride =*/ (int32_t) I.getWidth(),
+                      /*.stride =*/ (int32_t) I.getPitch(),
                       /*.buf =*/ I.bitmap
                     };
 
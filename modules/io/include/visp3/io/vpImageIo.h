@@ -89,6 +89,10 @@
     OpenCV is also used to consider these image formats. Installation instructions are
     provided here https://visp.inria.fr/3rd_opencv.
 
+  Images that are views with a pitch (see vpImage::initView()) are accepted:
+  they are written through a contiguous copy, and reading a file into such a
+  view makes the image allocate and own a new bitmap.
+
   The code below shows how to convert an PPM P6 image file format into
   a PGM P5 image file format. The extension of the filename is here
   used in read() and write() functions to set the image file format
@@ -491,6 +491,11 @@ vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename)
 void
 vpImageIo::writePFM(const vpImage<float> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    writePFM(vpImage<float>(I), filename);
+    return;
+  }
+
   FILE* fd;
 
   // Test the filename
@@ -541,6 +546,10 @@ vpImageIo::writePFM(const vpImage<float> &I, const std::string &filename)
 void
 vpImageIo::writePGM(const vpImage<unsigned char> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    writePGM(vpImage<unsigned char>(I), filename);
+    return;
+  }
 
   FILE* fd;
 
@@ -587,6 +596,11 @@ vpImageIo::writePGM(const vpImage<unsigned char> &I, const std::string &filename
 void
 vpImageIo::writePGM(const vpImage<short> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    writePGM(vpImage<short>(I), filename);
+    return;
+  }
+
   vpImage<unsigned char> Iuc ;
   unsigned int nrows = I.getHeight();
   unsigned int ncols = I.getWidth();
@@ -610,6 +624,10 @@ vpImageIo::writePGM(const vpImage<short> &I, const std::string &filename)
 void
 vpImageIo::writePGM(const vpImage<vpRGBa> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    writePGM(vpImage<vpRGBa>(I), filename);
+    return;
+  }
 
   FILE* fd;
 
@@ -668,6 +686,13 @@ vpImageIo::writePGM(const vpImage<vpRGBa> &I, const std::string &filename)
 void
 vpImageIo::readPFM(vpImage<float> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    vpImage<float> Iread;
+    readPFM(Iread, filename);
+    I = Iread;
+    return;
+  }
+
   unsigned int w=0, h=0, maxval=0;
   unsigned int w_max = 100000, h_max = 100000, maxval_max = 255;
   std::string magic("P8");
@@ -726,6 +751,13 @@ vpImageIo::readPFM(vpImage<float> &I, const std::string &filename)
 void
 vpImageIo::readPGM(vpImage<unsigned char> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    vpImage<unsigned char> Iread;
+    readPGM(Iread, filename);
+    I = Iread;
+    return;
+  }
+
   unsigned int w=0, h=0, maxval=0;
   unsigned int w_max = 100000, h_max = 100000, maxval_max = 255;
   std::string magic("P5");
@@ -978,6 +1010,11 @@ vpImageIo::writePPM(const vpImage<vpRGBa> &I, const std::string &filename)
 void
 vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    writeJPEG(vpImage<unsigned char>(I), filename);
+    return;
+  }
+
   struct jpeg_compress_struct cinfo;
   struct jpeg_error_mgr jerr;
   FILE *file;
@@ -1040,6 +1077,11 @@ vpImageIo::writeJPEG(const vpImage<unsigned char> &I, const std::string &filenam
 void
 vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    writeJPEG(vpImage<vpRGBa>(I), filename);
+    return;
+  }
+
   struct jpeg_compress_struct cinfo;
   struct jpeg_error_mgr jerr;
   FILE *file;
@@ -1113,6 +1155,13 @@ vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename)
 void
 vpImageIo::readJPEG(vpImage<unsigned char> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    vpImage<unsigned char> Iread;
+    readJPEG(Iread, filename);
+    I = Iread;
+    return;
+  }
+
   struct jpeg_decompress_struct cinfo;
   struct jpeg_error_mgr jerr;
   FILE *file;
@@ -1199,6 +1248,13 @@ vpImageIo::readJPEG(vpImage<unsigned char> &I, const std::string &filename)
 void
 vpImageIo::readJPEG(vpImage<vpRGBa> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    vpImage<vpRGBa> Iread;
+    readJPEG(Iread, filename);
+    I = Iread;
+    return;
+  }
+
   struct jpeg_decompress_struct cinfo;
   struct jpeg_error_mgr jerr;
   FILE *file;
@@ -1429,6 +1485,11 @@ vpImageIo::readJPEG(vpImage<vpRGBa> &I, const std::string &filename)
 void
 vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    writePNG(vpImage<unsigned char>(I), filename);
+    return;
+  }
+
   FILE *file;
 
   // Test the filename
@@ -1538,6 +1599,11 @@ vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename
 void
 vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    writePNG(vpImage<vpRGBa>(I), filename);
+    return;
+  }
+
   FILE *file;
 
   // Test the filename
@@ -1658,6 +1724,13 @@ vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename)
 void
 vpImageIo::readPNG(vpImage<unsigned char> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    vpImage<unsigned char> Iread;
+    readPNG(Iread, filename);
+    I = Iread;
+    return;
+  }
+
   FILE *file;
   png_byte magic[8];
   // Test the filename
@@ -1850,6 +1923,13 @@ vpImageIo::readPNG(vpImage<unsigned char> &I, const std::string &filename)
 void
 vpImageIo::readPNG(vpImage<vpRGBa> &I, const std::string &filename)
 {
+  if (!I.isContiguous()) {
+    vpImage<vpRGBa> Iread;
+    readPNG(Iread, filename);
+    I = Iread;
+    return;
+  }
+
   FILE *file;
   png_byte magic[8];
 
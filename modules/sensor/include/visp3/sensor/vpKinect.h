@@ -54,6 +54,7 @@
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpPointCloud.h>
 
 /*!
 
@@ -136,6 +137,7 @@ public:
 
   bool getDepthMap(vpImage<float>& map);
   bool getDepthMap(vpImage<float>& map, vpImage<unsigned char>& Imap);
+  bool getPointCloud(vpPointCloud &pointcloud);
   bool getRGB(vpImage<vpRGBa>& IRGB);
 
 
@@ -186,6 +186,25 @@ bool vpKinect::getDepthMap(vpImage<float>& map)
 }
 
 
+/*!
+  Get the organized point cloud computed from the last metric depth map and the
+  IR camera parameters. Pixels without depth lead to invalid points.
+
+  \param pointcloud : Point cloud. Reusing the same point cloud from one call to
+  the next one avoids any memory allocation.
+  \return false if no new depth map is available.
+*/
+bool vpKinect::getPointCloud(vpPointCloud &pointcloud)
+{
+  vpMutex::vpScopedLock lock(m_depth_mutex);
+  if (!m_new_depth_map)
+    return false;
+  pointcloud.buildFrom(this->dmap, IRcam);
+  m_new_depth_map = false;
+  return true;
+}
+
+
 /*!
  *   Get metric depth map (float) and corresponding image.
  */
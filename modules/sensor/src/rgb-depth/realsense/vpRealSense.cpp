@@ -399,6 +399,71 @@ void vpRealSense::acquire(std::vector<vpColVector> &pointcloud)
   vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_invalidDepthValue);
 }
 
+/*!
+  Acquire data from RealSense device.
+  \param grey : Grey level image.
+  \param pointcloud : Organized point cloud. Reusing the same point cloud from one acquisition to the next one avoids any memory allocation.
+ */
+void vpRealSense::acquire(vpImage<unsigned char> &grey, vpPointCloud &pointcloud)
+{
+  if (m_device == NULL) {
+    throw vpException(vpException::fatalError, "RealSense Camera - Device not opened!");
+  }
+  if (! m_device->is_streaming()) {
+    open();
+  }
+
+  m_device->wait_for_frames();
+
+  // Retrieve grey image
+  vp_rs_get_grey_impl(m_device, m_intrinsics, grey);
+
+  // Retrieve point cloud
+  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_invalidDepthValue);
+}
+
+/*!
+  Acquire data from RealSense device.
+  \param pointcloud : Organized point cloud. Reusing the same point cloud from one acquisition to the next one avoids any memory allocation.
+ */
+void vpRealSense::acquire(vpPointCloud &pointcloud)
+{
+  if (m_device == NULL) {
+    throw vpException(vpException::fatalError, "RealSense Camera - Device not opened!");
+  }
+  if (! m_device->is_streaming()) {
+    open();
+  }
+
+  m_device->wait_for_frames();
+
+  // Retrieve point cloud
+  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_invalidDepthValue);
+}
+
+/*!
+  Acquire data from RealSense device.
+  \param color : Color image.
+  \param pointcloud : Organized point cloud. Reusing the same point cloud from one acquisition to the next one avoids any memory allocation.
+ */
+void vpRealSense::acquire(vpImage<vpRGBa> &color, vpPointCloud &pointcloud)
+{
+  if (m_device == NULL) {
+    throw vpException(vpException::fatalError, "RealSense Camera - Device not opened!");
+  }
+  if (! m_device->is_streaming()) {
+    open();
+  }
+
+  m_device->wait_for_frames();
+
+  // Retrieve color image
+  vp_rs_get_color_impl(m_device, m_intrinsics, color);
+
+  // Retrieve point cloud
+  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_invalidDepthValue);
+}
+
 /*!
   Acquire data from RealSense device.
   \param color : Color image.
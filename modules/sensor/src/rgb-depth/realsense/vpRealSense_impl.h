@@ -244,6 +244,44 @@ void vp_rs_get_pointcloud_impl(const rs::device *m_device, const std::map <rs::s
   }
 }
 
+// Retrieve point cloud
+void vp_rs_get_pointcloud_impl(const rs::device *m_device, const std::map <rs::stream, rs::intrinsics> &m_intrinsics, float max_Z, vpPointCloud &pointcloud,
+                               const float invalidDepthValue=0.0f, const rs::stream &stream_depth=rs::stream::depth)
+{
+  if (m_device->is_stream_enabled(rs::stream::depth)) {
+    std::map<rs::stream, rs::intrinsics>::const_iterator it_intrinsics = m_intrinsics.find(stream_depth);
+    if (it_intrinsics == m_intrinsics.end()) {
+      throw vpException(vpException::fatalError, "Cannot find intrinsics for depth stream!");
+    }
+
+    const float depth_scale = m_device->get_depth_scale();
+
+    rs::float3 depth_point;
+    uint16_t * depth = (uint16_t *)m_device->get_frame_data(stream_depth);
+    int width = it_intrinsics->second.width;
+    int height = it_intrinsics->second.height;
+    // No allocation when the size of the point cloud is unchanged
+    pointcloud.resize((unsigned int) width, (unsigned int) height);
+
+    for (int i = 0; i < height; i++) {
+      for (int j = 0; j < width; j++) {
+        float scaled_depth = depth[i*width + j] * depth_scale;
+
+        rs::float2 depth_pixel = { (float) j, (float) i};
+        depth_point = it_intrinsics->second.deproject(depth_pixel, scaled_depth);
+
+        if (depth_point.z <= 0 || depth_point.z > max_Z) {
+          depth_point.x = depth_point.y = depth_point.z = invalidDepthValue;
+        }
+        pointcloud.set((unsigned int) (i*width + j), depth_point.x, depth_point.y, depth_point.z);
+      }
+    }
+  }
+  else {
+    pointcloud.clear();
+  }
+}
+
 #ifdef VISP_HAVE_PCL
 // Retrieve point cloud
 void vp_rs_get_pointcloud_impl(const rs::device *m_device, const std::map<rs::stream, rs::intrinsics> &m_intrinsics, float max_Z, pcl::PointCloud<pcl::PointXYZ>::Ptr &pointcloud,
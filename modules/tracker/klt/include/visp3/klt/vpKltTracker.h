@@ -0,0 +1,207 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pyramidal KLT (Kanade-Lucas-Tomasi) feature tracker working on vpImage.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKltTracker.h
+
+  \brief Pyramidal KLT (Kanade-Lucas-Tomasi) feature tracker working on
+  vpImage, without third party library.
+*/
+
+#ifndef vpKltTracker_h
+#define vpKltTracker_h
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpColor.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpImagePyramid.h>
+
+/*!
+  \class vpKltTracker
+  \ingroup module_klt
+
+  \brief KLT (Kanade-Lucas-Tomasi) feature tracker working directly on
+  vpImage.
+
+  Features are detected with the Shi-Tomasi (minimal eigenvalue) or the
+  Harris corner detector, see detectFeatures(), and tracked with the
+  iterative pyramidal Lucas-Kanade method. The parameters and the feature
+  identifiers follow the ones of vpKltOpencv: each feature keeps its id
+  during the tracking, the lost features are removed after each call to
+  track() and the ids of the new features are unique. Unlike vpKltOpencv, the
+  features are vpImagePoint.
+
+  The Gaussian pyramid of the current image can be shared with other
+  consumers of the same frame through track(vpImagePyramid &). The features
+  are tracked in parallel when OpenMP is available, and SSE2 is used for the
+  image matching when available.
+
+  \code
+#include <visp3/klt/vpKltTracker.h>
+
+int main()
+{
+  vpImage<unsigned char> I;
+  vpKltTracker tracker;
+  tracker.setMaxFeatures(200);
+  tracker.setWindowSize(10);
+  tracker.setPyramidLevels(3);
+
+  // ... acquire I
+  tracker.initTracking(I);
+  for (;;) {
+    // ... acquire I
+    tracker.track(I);
+    std::vector<vpImagePoint> features = tracker.getFeatures();
+    std::vector<long> ids = tracker.getFeaturesId();
+  }
+}
+  \endcode
+*/
+class VISP_EXPORT vpKltTracker
+{
+public:
+  vpKltTracker();
+  virtual ~vpKltTracker();
+
+  void addFeature(const float &x, const float &y);
+  void addFeature(const long &id, const float &x, const float &y);
+  void addFeature(const vpImagePoint &ip);
+
+  void detectFeatures(const vpImage<unsigned char> &I, std::vector<vpImagePoint> &features,
+                      const vpImage<unsigned char> *mask = NULL) const;
+
+  void display(const vpImage<unsigned char> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1);
+  static void display(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &features,
+                      const vpColor &color = vpColor::green, unsigned int thickness = 1);
+  static void display(const vpImage<vpRGBa> &I, const std::vector<vpImagePoint> &features,
+                      const vpColor &color = vpColor::green, unsigned int thickness = 1);
+  static void display(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &features,
+                      const std::vector<long> &featuresid, const vpColor &color = vpColor::green,
+                      unsigned int thickness = 1);
+  static void display(const vpImage<vpRGBa> &I, const std::vector<vpImagePoint> &features,
+                      const std::vector<long> &featuresid, const vpColor &color = vpColor::green,
+                      unsigned int thickness = 1);
+
+  //! Get the size of the averaging block used to detect the features.
+  int getBlockSize() const { return m_blockSize; }
+  void getFeature(const int &index, long &id, float &x, float &y) const;
+  //! Get the list of current features.
+  std::vector<vpImagePoint> getFeatures() const { return m_points[1]; }
+  //! Get the unique id of each feature.
+  std::vector<long> getFeaturesId() const { return m_points_id; }
+  //! Get the free parameter of the Harris detector.
+  double getHarrisFreeParameter() const { return m_harris_k; }
+  //! Get the maximum number of features to track in the image.
+  int getMaxFeatures() const { return m_maxCount; }
+  //! Get the maximal number of iterations of the Lucas-Kanade method at each pyramid level.
+  int getMaxIterations() const { return m_maxIterations; }
+  //! Get the minimal Euclidean distance between detected corners during initialization.
+  double getMinDistance() const { return m_minDistance; }
+  //! Get the minimal eigen value threshold used to reject a point during the tracking.
+  double getMinEigThreshold() const { return m_minEigThreshold; }
+  //! Get the number of current features
+  int getNbFeatures() const { return (int)m_points[1].size(); }
+  //! Get the number of previous features.
+  int getNbPrevFeatures() const { return (int)m_points[0].size(); }
+  //! Get the list of previous features
+  std::vector<vpImagePoint> getPrevFeatures() const { return m_points[0]; }
+  //! Get the maximal pyramid level.
+  int getPyramidLevels() const { return m_pyrMaxLevel; }
+  //! Get the parameter characterizing the minimal accepted quality of image corners.
+  double getQuality() const { return m_qualityLevel; }
+  //! Get the displacement in pixel below which the Lucas-Kanade iterations stop.
+  double getStopEpsilon() const { return m_epsilon; }
+  //! Return true if the Harris detector is used, false for the minimal eigenvalue.
+  int getUseHarris() const { return m_useHarrisDetector; }
+  //! Get the size of the window used to track the features.
+  int getWindowSize() const { return m_winSize; }
+
+  void initTracking(const vpImage<unsigned char> &I, const vpImage<unsigned char> *mask = NULL);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                    const std::vector<long> &ids);
+
+  void setBlockSize(const int blockSize);
+  void setHarrisFreeParameter(double harris_k);
+  void setInitialGuess(const std::vector<vpImagePoint> &guess_pts);
+  void setInitialGuess(const std::vector<vpImagePoint> &init_pts, const std::vector<vpImagePoint> &guess_pts,
+                       const std::vector<long> &fid);
+  void setMaxFeatures(const int maxCount);
+  void setMinDistance(double minDistance);
+  void setMinEigThreshold(double minEigThreshold);
+  void setPyramidLevels(const int pyrMaxLevel);
+  void setQuality(double qualityLevel);
+  void setTermCriteria(const int maxIterations, const double epsilon);
+  void setUseHarris(const int useHarrisDetector);
+  void setWindowSize(const int winSize);
+  void suppressFeature(const int &index);
+
+  void track(const vpImage<unsigned char> &I);
+  void track(vpImagePyramid &pyramid);
+
+protected:
+  unsigned int getNbLevels(const vpImagePyramid &pyramid) const;
+  void setPreviousPyramid(vpImagePyramid &pyramid);
+  bool trackFeature(const std::vector<const vpImage<unsigned char> *> &levels, const vpImagePoint &prevPt,
+                    vpImagePoint &nextPt, std::vector<float> &buffer) const;
+
+  //! Pyramid of the last image given to initTracking() or track()
+  vpImagePyramid m_pyramid;
+  //! Copy of the levels of the previous image
+  std::vector<vpImage<unsigned char> > m_prevLevels;
+  //! Number of available levels in m_prevLevels
+  unsigned int m_nbPrevLevels;
+  std::vector<vpImagePoint> m_points[2]; //!< Previous [0] and current [1] keypoint location
+  std::vector<long> m_points_id;        //!< Keypoint id
+  int m_maxCount;
+  int m_winSize;
+  double m_qualityLevel;
+  double m_minDistance;
+  double m_minEigThreshold;
+  double m_harris_k;
+  int m_blockSize;
+  int m_useHarrisDetector;
+  int m_pyrMaxLevel;
+  int m_maxIterations;
+  double m_epsilon;
+  long m_next_points_id;
+  bool m_initial_guess;
+};
+
+#endif
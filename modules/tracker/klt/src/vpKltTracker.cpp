@@ -0,0 +1,1016 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pyramidal KLT (Kanade-Lucas-Tomasi) feature tracker working on vpImage.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKltTracker.cpp
+
+  \brief Pyramidal KLT (Kanade-Lucas-Tomasi) feature tracker working on
+  vpImage, without third party library.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/klt/vpKltTracker.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
+namespace {
+// Scale of the minimal eigenvalue of the spatial gradient matrix computed by
+// OpenCV with Scharr derivatives, used to share the thresholds with vpKltOpencv
+const double vpKltMinEigScale = 1. / 1024.;
+
+struct vpKltCorner
+{
+  float response;
+  unsigned int i;
+  unsigned int j;
+};
+
+bool compareCorners(const vpKltCorner &c1, const vpKltCorner &c2)
+{
+  return c1.response > c2.response;
+}
+
+#if VISP_HAVE_SSE2
+// Load 4 consecutive unsigned char as float
+inline __m128 load4(const unsigned char *p)
+{
+  int v;
+  memcpy(&v, p, sizeof(int));
+  const __m128i zero = _mm_setzero_si128();
+  __m128i x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero);
+  x = _mm_unpacklo_epi16(x, zero);
+  return _mm_cvtepi32_ps(x);
+}
+#endif
+
+// Return true if the size x size window at (i, j) and its bilinear interpolation neighbours are in the image
+inline bool isInside(const vpImage<unsigned char> &I, const int i, const int j, const unsigned int size)
+{
+  return i >= 0 && j >= 0 && i + (int)size < (int)I.getHeight() && j + (int)size < (int)I.getWidth();
+}
+
+// Bilinear interpolation at (i, j) + fractional part, the border of the image being replicated
+inline float getClampedValue(const vpImage<unsigned char> &I, const int i, const int j, const float *w)
+{
+  const int maxI = (int)I.getHeight() - 1, maxJ = (int)I.getWidth() - 1;
+  const unsigned int i0 = (unsigned int)std::max(0, std::min(i, maxI)), i1 = (unsigned int)std::max(0, std::min(i + 1, maxI));
+  const unsigned int j0 = (unsigned int)std::max(0, std::min(j, maxJ)), j1 = (unsigned int)std::max(0, std::min(j + 1, maxJ));
+  return w[0] * I[i0][j0] + w[1] * I[i0][j1] + w[2] * I[i1][j0] + w[3] * I[i1][j1];
+}
+
+/*!
+  Compute \f$ \sum (I - J) \nabla I \f$ over the window, J being bilinearly
+  interpolated with the weights \e w at the position (jy, jx) + fractional part.
+*/
+void computeMismatch(const vpImage<unsigned char> &J, const unsigned int jy, const unsigned int jx, const float *w,
+                     const float *patchI, const float *patchIx, const float *patchIy, const unsigned int side,
+                     double &b1, double &b2)
+{
+  float s1 = 0, s2 = 0;
+#if VISP_HAVE_SSE2
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+  __m128 acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps();
+  const __m128 w00 = _mm_set1_ps(w[0]), w01 = _mm_set1_ps(w[1]), w10 = _mm_set1_ps(w[2]), w11 = _mm_set1_ps(w[3]);
+#endif
+
+  for (unsigned int r = 0; r < side; r++) {
+    const unsigned char *row0 = J[jy + r] + jx;
+    const unsigned char *row1 = J[jy + r + 1] + jx;
+    const float *I = patchI + r * side;
+    const float *Ix = patchIx + r * side;
+    const float *Iy = patchIy + r * side;
+    unsigned int c = 0;
+#if VISP_HAVE_SSE2
+    if (useSSE2) {
+      for (; c + 4 <= side; c += 4) {
+        __m128 val = _mm_mul_ps(w00, load4(row0 + c));
+        val = _mm_add_ps(val, _mm_mul_ps(w01, load4(row0 + c + 1)));
+        val = _mm_add_ps(val, _mm_mul_ps(w10, load4(row1 + c)));
+        val = _mm_add_ps(val, _mm_mul_ps(w11, load4(row1 + c + 1)));
+        const __m128 diff = _mm_sub_ps(_mm_loadu_ps(I + c), val);
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(diff, _mm_loadu_ps(Ix + c)));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(diff, _mm_loadu_ps(Iy + c)));
+      }
+    }
+#endif
+    for (; c < side; c++) {
+      const float val = w[0] * row0[c] + w[1] * row0[c + 1] + w[2] * row1[c] + w[3] * row1[c + 1];
+      const float diff = I[c] - val;
+      s1 += diff * Ix[c];
+      s2 += diff * Iy[c];
+    }
+  }
+
+#if VISP_HAVE_SSE2
+  if (useSSE2) {
+    float v1[4], v2[4];
+    _mm_storeu_ps(v1, acc1);
+    _mm_storeu_ps(v2, acc2);
+    s1 += v1[0] + v1[1] + v1[2] + v1[3];
+    s2 += v2[0] + v2[1] + v2[2] + v2[3];
+  }
+#endif
+  b1 = s1;
+  b2 = s2;
+}
+}
+
+/*!
+  Default constructor.
+ */
+vpKltTracker::vpKltTracker()
+  : m_pyramid(4), m_prevLevels(), m_nbPrevLevels(0), m_points_id(), m_maxCount(500), m_winSize(10),
+    m_qualityLevel(0.01), m_minDistance(15), m_minEigThreshold(1e-4), m_harris_k(0.04), m_blockSize(3),
+    m_useHarrisDetector(1), m_pyrMaxLevel(3), m_maxIterations(20), m_epsilon(0.03), m_next_points_id(0),
+    m_initial_guess(false)
+{
+}
+
+vpKltTracker::~vpKltTracker()
+{
+}
+
+/*!
+  Add a keypoint at the end of the feature list. The id of the feature is set to ensure that it is unique.
+  \param x,y : Coordinates of the feature in the image.
+*/
+void vpKltTracker::addFeature(const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+  Add a keypoint at the end of the feature list.
+
+  \warning This function doesn't ensure that the id of the feature is unique.
+  You should rather use addFeature(const float &, const float &) or addFeature(const vpImagePoint &).
+
+  \param id : Feature id. Should be unique
+  \param x,y : Coordinates of the feature in the image.
+*/
+void vpKltTracker::addFeature(const long &id, const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(id);
+  if (id >= m_next_points_id)
+    m_next_points_id = id + 1;
+}
+
+/*!
+  Add a keypoint at the end of the feature list. The id of the feature is set to ensure that it is unique.
+  \param ip : Coordinates of the feature in the image.
+*/
+void vpKltTracker::addFeature(const vpImagePoint &ip)
+{
+  m_points[1].push_back(ip);
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+  Detect the corners of an image with the current detector parameters: the
+  minimal eigenvalue (Shi-Tomasi) or the Harris response of the gradient
+  matrix averaged over a block of getBlockSize() pixels is computed for each
+  pixel, the local maxima above getQuality() times the best response are kept
+  from the strongest to the weakest if they are at least getMinDistance()
+  pixels away from the corners already kept, up to getMaxFeatures() corners.
+  The corners are refined to a sub-pixel position by a quadratic fit of the
+  response.
+
+  \param I : Image in which the corners are detected.
+  \param features : Detected corners, sorted by decreasing response.
+  \param mask : If not NULL, the corners are only detected where the mask is
+  not zero. The mask has to be of the size of the image.
+*/
+void vpKltTracker::detectFeatures(const vpImage<unsigned char> &I, std::vector<vpImagePoint> &features,
+                                  const vpImage<unsigned char> *mask) const
+{
+  features.clear();
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  const unsigned int half = (unsigned int)std::max(m_blockSize, 1) / 2;
+  // Border of the image where the response is not computed
+  const unsigned int border = half + 2;
+  if (height <= 2 * border || width <= 2 * border) {
+    return;
+  }
+  if (mask != NULL && (mask->getHeight() != height || mask->getWidth() != width)) {
+    throw(vpException(vpException::dimensionError, "The mask (%dx%d) and the image (%dx%d) sizes differ",
+                      mask->getWidth(), mask->getHeight(), width, height));
+  }
+
+  // Products of the Sobel derivatives
+  const unsigned int size = height * width;
+  std::vector<float> dxx(size, 0.f), dxy(size, 0.f), dyy(size, 0.f);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 1; i < (int)height - 1; i++) {
+    const unsigned char *r0 = I[i - 1], *r1 = I[i], *r2 = I[i + 1];
+    for (unsigned int j = 1; j < width - 1; j++) {
+      const float gx = ((r0[j + 1] - r0[j - 1]) + 2.f * (r1[j + 1] - r1[j - 1]) + (r2[j + 1] - r2[j - 1])) / 8.f;
+      const float gy = ((r2[j - 1] - r0[j - 1]) + 2.f * (r2[j] - r0[j]) + (r2[j + 1] - r0[j + 1])) / 8.f;
+      const unsigned int idx = (unsigned int)i * width + j;
+      dxx[idx] = gx * gx;
+      dxy[idx] = gx * gy;
+      dyy[idx] = gy * gy;
+    }
+  }
+
+  // Sum of the products over the block and response of the detector
+  std::vector<float> response(size, 0.f);
+  const float k = (float)m_harris_k;
+  const bool useHarris = m_useHarrisDetector != 0;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = (int)border - 1; i < (int)(height - border + 1); i++) {
+    for (unsigned int j = border - 1; j < width - border + 1; j++) {
+      float a = 0, b = 0, c = 0;
+      for (unsigned int r = (unsigned int)i - half; r <= (unsigned int)i + half; r++) {
+        const unsigned int idx = r * width;
+        for (unsigned int col = j - half; col <= j + half; col++) {
+          a += dxx[idx + col];
+          b += dxy[idx + col];
+          c += dyy[idx + col];
+        }
+      }
+      float &resp = response[(unsigned int)i * width + j];
+      if (useHarris) {
+        resp = a * c - b * b - k * (a + c) * (a + c);
+      } else {
+        resp = ((a + c) - std::sqrt((a - c) * (a - c) + 4.f * b * b)) / 2.f;
+      }
+    }
+  }
+
+  float maxResponse = 0;
+  for (unsigned int idx = 0; idx < size; idx++) {
+    maxResponse = std::max(maxResponse, response[idx]);
+  }
+  if (maxResponse <= 0) {
+    return;
+  }
+  const float threshold = (float)(m_qualityLevel * maxResponse);
+
+  // Local maxima above the threshold
+  std::vector<vpKltCorner> corners;
+  for (unsigned int i = border; i < height - border; i++) {
+    for (unsigned int j = border; j < width - border; j++) {
+      const float *r = &response[i * width + j];
+      const float val = *r;
+      if (val <= threshold || (mask != NULL && (*mask)[i][j] == 0)) {
+        continue;
+      }
+      if (val >= r[-1] && val >= r[1] && val >= r[-(int)width - 1] && val >= r[-(int)width] &&
+          val >= r[-(int)width + 1] && val >= r[width - 1] && val >= r[width] && val >= r[width + 1]) {
+        vpKltCorner corner;
+        corner.response = val;
+        corner.i = i;
+        corner.j = j;
+        corners.push_back(corner);
+      }
+    }
+  }
+  std::stable_sort(corners.begin(), corners.end(), compareCorners);
+
+  // Minimal distance between the corners, the kept corners being stored in a grid of cells of
+  // the minimal distance size
+  const double minDist = std::max(m_minDistance, 0.);
+  const unsigned int cellSize = std::max(1u, (unsigned int)std::ceil(minDist));
+  const unsigned int gridWidth = (width + cellSize - 1) / cellSize, gridHeight = (height + cellSize - 1) / cellSize;
+  std::vector<std::vector<vpImagePoint> > grid(minDist > 0 ? gridWidth * gridHeight : 0);
+
+  for (size_t n = 0; n < corners.size(); n++) {
+    if (m_maxCount > 0 && features.size() >= (size_t)m_maxCount) {
+      break;
+    }
+    const unsigned int i = corners[n].i, j = corners[n].j;
+
+    // Quadratic fit of the response around the maximum
+    const float *r = &response[i * width + j];
+    double di = 0, dj = 0;
+    const double d2j = r[-1] - 2 * r[0] + r[1], d2i = r[-(int)width] - 2 * r[0] + r[width];
+    if (d2j < 0) {
+      dj = vpMath::maximum(-0.5, vpMath::minimum(0.5, 0.5 * (r[-1] - r[1]) / d2j));
+    }
+    if (d2i < 0) {
+      di = vpMath::maximum(-0.5, vpMath::minimum(0.5, 0.5 * (r[-(int)width] - r[width]) / d2i));
+    }
+    vpImagePoint ip(i + di, j + dj);
+
+    if (minDist > 0) {
+      const int gi = (int)(i / cellSize), gj = (int)(j / cellSize);
+      bool tooClose = false;
+      for (int ci = std::max(gi - 1, 0); ci <= std::min(gi + 1, (int)gridHeight - 1) && !tooClose; ci++) {
+        for (int cj = std::max(gj - 1, 0); cj <= std::min(gj + 1, (int)gridWidth - 1) && !tooClose; cj++) {
+          const std::vector<vpImagePoint> &cell = grid[(unsigned int)(ci * (int)gridWidth + cj)];
+          for (size_t m = 0; m < cell.size(); m++) {
+            if (vpImagePoint::sqrDistance(cell[m], ip) < minDist * minDist) {
+              tooClose = true;
+              break;
+            }
+          }
+        }
+      }
+      if (tooClose) {
+        continue;
+      }
+      grid[(unsigned int)(gi * (int)gridWidth + gj)].push_back(ip);
+    }
+    features.push_back(ip);
+  }
+}
+
+/*!
+  Display features position and id.
+
+  \param I : Image used as background. Display should be initialized on it.
+  \param color : Color used to display the features.
+  \param thickness : Thickness of the drawings.
+*/
+void vpKltTracker::display(const vpImage<unsigned char> &I, const vpColor &color, unsigned int thickness)
+{
+  vpKltTracker::display(I, m_points[1], m_points_id, color, thickness);
+}
+
+/*!
+  Display features list.
+
+  \param I : The image used as background.
+  \param features : Vector of features.
+  \param color : Color used to display the points.
+  \param thickness : Thickness of the points.
+*/
+void vpKltTracker::display(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &features,
+                           const vpColor &color, unsigned int thickness)
+{
+  for (size_t i = 0; i < features.size(); i++) {
+    vpDisplay::displayCross(I, features[i], 10 + thickness, color, thickness);
+  }
+}
+
+/*!
+  Display features list.
+
+  \param I : The image used as background.
+  \param features : Vector of features.
+  \param color : Color used to display the points.
+  \param thickness : Thickness of the points.
+*/
+void vpKltTracker::display(const vpImage<vpRGBa> &I, const std::vector<vpImagePoint> &features,
+                           const vpColor &color, unsigned int thickness)
+{
+  for (size_t i = 0; i < features.size(); i++) {
+    vpDisplay::displayCross(I, features[i], 10 + thickness, color, thickness);
+  }
+}
+
+/*!
+  Display features list with ids.
+
+  \param I : The image used as background.
+  \param features : Vector of features.
+  \param featuresid : Vector of ids corresponding to the features.
+  \param color : Color used to display the points.
+  \param thickness : Thickness of the points
+*/
+void vpKltTracker::display(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &features,
+                           const std::vector<long> &featuresid, const vpColor &color, unsigned int thickness)
+{
+  for (size_t i = 0; i < features.size(); i++) {
+    vpDisplay::displayCross(I, features[i], 10, color, thickness);
+
+    std::ostringstream id;
+    id << featuresid[i];
+    vpDisplay::displayText(I, features[i] + vpImagePoint(0, 5), id.str(), color);
+  }
+}
+
+/*!
+  Display features list with ids.
+
+  \param I : The image used as background.
+  \param features : Vector of features.
+  \param featuresid : Vector of ids corresponding to the features.
+  \param color : Color used to display the points.
+  \param thickness : Thickness of the points
+*/
+void vpKltTracker::display(const vpImage<vpRGBa> &I, const std::vector<vpImagePoint> &features,
+                           const std::vector<long> &featuresid, const vpColor &color, unsigned int thickness)
+{
+  for (size_t i = 0; i < features.size(); i++) {
+    vpDisplay::displayCross(I, features[i], 10, color, thickness);
+
+    std::ostringstream id;
+    id << featuresid[i];
+    vpDisplay::displayText(I, features[i] + vpImagePoint(0, 5), id.str(), color);
+  }
+}
+
+/*!
+  Get the 'index'th feature image coordinates. Beware that getFeature(i,...)
+  may not represent the same feature before and after a tracking iteration
+  (if a feature is lost, features are shifted in the array).
+
+  \param index : Index of feature.
+  \param id : id of the feature.
+  \param x : x coordinate (column).
+  \param y : y coordinate (row).
+*/
+void vpKltTracker::getFeature(const int &index, long &id, float &x, float &y) const
+{
+  if (index < 0 || (size_t)index >= m_points[1].size()) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  x = (float)m_points[1][(size_t)index].get_u();
+  y = (float)m_points[1][(size_t)index].get_v();
+  id = m_points_id[(size_t)index];
+}
+
+/*!
+  Return the number of pyramid levels used with a pyramid: at most
+  getPyramidLevels()+1, the levels smaller than the tracking window being
+  ignored.
+*/
+unsigned int vpKltTracker::getNbLevels(const vpImagePyramid &pyramid) const
+{
+  const vpImage<unsigned char> *I = pyramid.getImage();
+  if (I == NULL) {
+    return 0;
+  }
+  const unsigned int side = 2 * (unsigned int)(m_winSize / 2) + 1;
+  unsigned int maxLevel = std::min((unsigned int)std::max(m_pyrMaxLevel, 0), pyramid.getNbLevels() - 1);
+  while (maxLevel > 0 && ((I->getWidth() >> maxLevel) < side + 2 || (I->getHeight() >> maxLevel) < side + 2)) {
+    maxLevel--;
+  }
+  return maxLevel + 1;
+}
+
+/*!
+  Initialise the tracking by detecting corners in the provided image, see
+  detectFeatures(). The ids of the features start from 0.
+
+  \param I : Grey level image.
+  \param mask : If not NULL, the corners are only detected where the mask is
+  not zero.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const vpImage<unsigned char> *mask)
+{
+  m_next_points_id = 0;
+  m_initial_guess = false;
+  m_points[0].clear();
+  m_points_id.clear();
+
+  detectFeatures(I, m_points[1], mask);
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    m_points_id.push_back(m_next_points_id++);
+  }
+
+  m_pyramid.setImage(I);
+  setPreviousPyramid(m_pyramid);
+  m_pyramid.clear();
+}
+
+/*!
+  Set the points that will be tracked from the provided image during the next
+  call to track(). The ids of the features start from 0.
+
+  \param I : Grey level image.
+  \param pts : Vector of points that should be tracked.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts)
+{
+  m_initial_guess = false;
+  m_points[1] = pts;
+  m_next_points_id = 0;
+  m_points_id.clear();
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    m_points_id.push_back(m_next_points_id++);
+  }
+
+  m_pyramid.setImage(I);
+  setPreviousPyramid(m_pyramid);
+  m_pyramid.clear();
+}
+
+/*!
+  Set the points and their ids that will be tracked from the provided image
+  during the next call to track().
+
+  \param I : Grey level image.
+  \param pts : Vector of points that should be tracked.
+  \param ids : Ids of the points. If the size of this vector differs from the
+  size of \e pts, the ids start from 0.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                                const std::vector<long> &ids)
+{
+  m_initial_guess = false;
+  m_points[1] = pts;
+  m_points_id.clear();
+
+  if (ids.size() != pts.size()) {
+    m_next_points_id = 0;
+    for (size_t i = 0; i < m_points[1].size(); i++)
+      m_points_id.push_back(m_next_points_id++);
+  } else {
+    long max = 0;
+    for (size_t i = 0; i < m_points[1].size(); i++) {
+      m_points_id.push_back(ids[i]);
+      if (ids[i] > max)
+        max = ids[i];
+    }
+    m_next_points_id = max + 1;
+  }
+
+  m_pyramid.setImage(I);
+  setPreviousPyramid(m_pyramid);
+  m_pyramid.clear();
+}
+
+/*!
+  Set the size of the averaging block used to detect the features.
+
+  \param blockSize : Size of an average block for computing a derivative
+  covariation matrix over each pixel neighborhood. Default value is set to 3.
+*/
+void vpKltTracker::setBlockSize(const int blockSize)
+{
+  m_blockSize = blockSize;
+}
+
+/*!
+  Set the free parameter of the Harris detector.
+
+  \param harris_k : Free parameter of the Harris detector. Default value is set to 0.04.
+*/
+void vpKltTracker::setHarrisFreeParameter(double harris_k)
+{
+  m_harris_k = harris_k;
+}
+
+/*!
+  Set the points that will be used as initial guess during the next call to track().
+  A typical usage of this function is to predict the position of the features before the
+  next call to track().
+
+  \param guess_pts : Vector of points that should be tracked. The size of this
+  vector should be the same as the one returned by getFeatures(). If this is not the case,
+  an exception is returned. Note also that the id of the points is not modified.
+*/
+void vpKltTracker::setInitialGuess(const std::vector<vpImagePoint> &guess_pts)
+{
+  if (guess_pts.size() != m_points[1].size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size feature vector [%d] and guess vector [%d] doesn't match",
+                      m_points[1].size(), guess_pts.size()));
+  }
+
+  m_points[0] = m_points[1];
+  m_points[1] = guess_pts;
+  m_initial_guess = true;
+}
+
+/*!
+  Set the points that will be used as initial guess during the next call to track().
+
+  \param init_pts : Initial points (could be obtained from getPrevFeatures() or getFeatures()).
+  \param guess_pts : Prediction of the new position of the initial points. The size of this vector must be the same
+  as the size of the vector of initial points.
+  \param fid : Identifiers of the initial points.
+*/
+void vpKltTracker::setInitialGuess(const std::vector<vpImagePoint> &init_pts,
+                                   const std::vector<vpImagePoint> &guess_pts, const std::vector<long> &fid)
+{
+  if (guess_pts.size() != init_pts.size() || fid.size() != init_pts.size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size init vector [%d], guess vector [%d] and id vector [%d] "
+                      "don't match",
+                      init_pts.size(), guess_pts.size(), fid.size()));
+  }
+
+  m_points[0] = init_pts;
+  m_points[1] = guess_pts;
+  m_points_id = fid;
+  m_initial_guess = true;
+}
+
+/*!
+  Set the maximum number of features to track in the image.
+
+  \param maxCount : Maximum number of features to detect and track. Default value is set to 500.
+*/
+void vpKltTracker::setMaxFeatures(const int maxCount)
+{
+  m_maxCount = maxCount;
+}
+
+/*!
+  Set the minimal Euclidean distance between detected corners during initialization.
+
+  \param minDistance : Minimal possible Euclidean distance between the detected corners.
+  Default value is set to 15.
+*/
+void vpKltTracker::setMinDistance(double minDistance)
+{
+  m_minDistance = minDistance;
+}
+
+/*!
+  Set the minimal eigen value threshold used to reject a point during the tracking.
+  The minimal eigenvalue of the spatial gradient matrix of the tracking window
+  is divided by the number of pixels of the window and has the scale of the
+  one used by OpenCV, so that the threshold is the same as with vpKltOpencv.
+
+  \param minEigThreshold : Minimal eigen value threshold. Default value is set to 1e-4.
+*/
+void vpKltTracker::setMinEigThreshold(double minEigThreshold)
+{
+  m_minEigThreshold = minEigThreshold;
+}
+
+/*!
+  Set the maximal pyramid level. If the level is zero, then no pyramid is
+  computed for the optical flow. The levels smaller than the tracking window
+  are not used.
+
+  \param pyrMaxLevel : 0-based maximal pyramid level number; if set to 0, pyramids are not used (single level),
+  if set to 1, two levels are used, and so on. Default value is set to 3.
+*/
+void vpKltTracker::setPyramidLevels(const int pyrMaxLevel)
+{
+  m_pyrMaxLevel = std::max(pyrMaxLevel, 0);
+  m_pyramid.setNbLevels((unsigned int)m_pyrMaxLevel + 1);
+}
+
+/*!
+  Set the parameter characterizing the minimal accepted quality of image corners.
+
+  \param qualityLevel : Quality level parameter. Default value is set to 0.01. The parameter value is multiplied by
+  the best corner quality measure, which is the minimal eigenvalue or the Harris function response. The corners with
+  the quality measure less than the product are rejected.
+*/
+void vpKltTracker::setQuality(double qualityLevel)
+{
+  m_qualityLevel = qualityLevel;
+}
+
+/*!
+  Set the termination criteria of the Lucas-Kanade iterations at each pyramid level.
+
+  \param maxIterations : Maximal number of iterations. Default value is set to 20.
+  \param epsilon : The iterations stop when the displacement of the feature is below this value in pixel.
+  Default value is set to 0.03.
+*/
+void vpKltTracker::setTermCriteria(const int maxIterations, const double epsilon)
+{
+  m_maxIterations = maxIterations;
+  m_epsilon = epsilon;
+}
+
+/*!
+  Set the parameter indicating whether to use a Harris detector or
+  the minimal eigenvalue of gradient matrices for corner detection.
+  \param useHarrisDetector : If 1 (default value), use the Harris detector. If 0 use the eigenvalue.
+*/
+void vpKltTracker::setUseHarris(const int useHarrisDetector)
+{
+  m_useHarrisDetector = useHarrisDetector;
+}
+
+/*!
+  Set the size of the window used to track the features.
+
+  \param winSize : Side of the square window, in pixel, rounded to the upper
+  odd value. Default value is set to 10.
+
+  \exception vpException::badValue : If the size is lower than 3.
+*/
+void vpKltTracker::setWindowSize(const int winSize)
+{
+  if (winSize < 3) {
+    throw(vpException(vpException::badValue, "The window size (%d) should be at least 3", winSize));
+  }
+  m_winSize = winSize;
+}
+
+/*!
+  Keep a copy of the levels of a pyramid, used as the previous image by the
+  next call to track().
+*/
+void vpKltTracker::setPreviousPyramid(vpImagePyramid &pyramid)
+{
+  m_nbPrevLevels = getNbLevels(pyramid);
+  if (m_prevLevels.size() < m_nbPrevLevels) {
+    m_prevLevels.resize(m_nbPrevLevels);
+  }
+  for (unsigned int level = 0; level < m_nbPrevLevels; level++) {
+    m_prevLevels[level] = pyramid.getLevel(level);
+  }
+}
+
+/*!
+  Remove the feature with the given index as parameter.
+  \param index : Index of the feature to remove.
+*/
+void vpKltTracker::suppressFeature(const int &index)
+{
+  if (index < 0 || (size_t)index >= m_points[1].size()) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  m_points[1].erase(m_points[1].begin() + index);
+  m_points_id.erase(m_points_id.begin() + index);
+}
+
+/*!
+  Track the features using the iterative Lucas-Kanade method with pyramids.
+  The features that are lost are removed.
+
+  \param I : Grey level image.
+
+  \exception vpTrackingException::fatalError : If there is no feature to track.
+*/
+void vpKltTracker::track(const vpImage<unsigned char> &I)
+{
+  m_pyramid.setImage(I);
+  try {
+    track(m_pyramid);
+  } catch (...) {
+    m_pyramid.clear();
+    throw;
+  }
+  m_pyramid.clear();
+}
+
+/*!
+  Track the features using the iterative Lucas-Kanade method with pyramids,
+  the levels of the current image being read from a pyramid that can be
+  shared with other consumers of the same frame. The missing levels of the
+  pyramid are computed. The features that are lost are removed.
+
+  \param pyramid : Pyramid of the current grey level image. It should have at
+  least getPyramidLevels()+1 levels to use all the pyramid levels.
+
+  \exception vpTrackingException::fatalError : If there is no feature to track.
+  \exception vpTrackingException::initializationError : If the size of the
+  image differs from the size of the previous one.
+*/
+void vpKltTracker::track(vpImagePyramid &pyramid)
+{
+  if (m_points[1].size() == 0)
+    throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
+
+  if (m_nbPrevLevels == 0) {
+    setPreviousPyramid(pyramid);
+  }
+  const vpImage<unsigned char> &I = pyramid.getLevel(0);
+  if (I.getHeight() != m_prevLevels[0].getHeight() || I.getWidth() != m_prevLevels[0].getWidth()) {
+    throw vpTrackingException(vpTrackingException::initializationError,
+                              "The size of the image (%dx%d) differs from the previous one (%dx%d)", I.getWidth(),
+                              I.getHeight(), m_prevLevels[0].getWidth(), m_prevLevels[0].getHeight());
+  }
+
+  if (m_initial_guess) {
+    m_initial_guess = false;
+  } else {
+    std::swap(m_points[1], m_points[0]);
+    m_points[1] = m_points[0];
+  }
+
+  // The levels are computed before the parallel section, including the previous levels that are missing
+  // when the number of pyramid levels was increased
+  const unsigned int nbLevels = getNbLevels(pyramid);
+  if (m_prevLevels.size() < nbLevels) {
+    m_prevLevels.resize(nbLevels);
+  }
+  for (; m_nbPrevLevels < nbLevels; m_nbPrevLevels++) {
+    vpImageFilter::getGaussPyramidal(m_prevLevels[m_nbPrevLevels - 1], m_prevLevels[m_nbPrevLevels]);
+  }
+  std::vector<const vpImage<unsigned char> *> levels(nbLevels);
+  for (unsigned int level = 0; level < nbLevels; level++) {
+    levels[level] = &pyramid.getLevel(level);
+  }
+
+  const int nbFeatures = (int)m_points[1].size();
+  std::vector<unsigned char> status((size_t)nbFeatures, 0);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (nbFeatures > 1)
+#endif
+  {
+    std::vector<float> buffer;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(dynamic, 8)
+#endif
+    for (int i = 0; i < nbFeatures; i++) {
+      status[(size_t)i] = trackFeature(levels, m_points[0][(size_t)i], m_points[1][(size_t)i], buffer) ? 1 : 0;
+    }
+  }
+
+  // Remove points that are lost
+  size_t nbKept = 0;
+  for (size_t i = 0; i < status.size(); i++) {
+    if (status[i]) {
+      m_points[0][nbKept] = m_points[0][i];
+      m_points[1][nbKept] = m_points[1][i];
+      m_points_id[nbKept] = m_points_id[i];
+      nbKept++;
+    }
+  }
+  m_points[0].resize(nbKept);
+  m_points[1].resize(nbKept);
+  m_points_id.resize(nbKept);
+
+  setPreviousPyramid(pyramid);
+}
+
+/*!
+  Track a feature from the previous pyramid to the current one.
+
+  \param levels : Levels of the current pyramid.
+  \param prevPt : Position of the feature in the previous image.
+  \param nextPt : Initial guess of the position in the current image, updated
+  with the tracked position.
+  \param buffer : Working memory.
+
+  \return false if the feature is lost: out of the image or on a
+  non-textured area.
+*/
+bool vpKltTracker::trackFeature(const std::vector<const vpImage<unsigned char> *> &levels,
+                                const vpImagePoint &prevPt, vpImagePoint &nextPt, std::vector<float> &buffer) const
+{
+  const unsigned int half = (unsigned int)(m_winSize / 2);
+  const unsigned int side = 2 * half + 1, ext = side + 2;
+  const unsigned int nbPixels = side * side;
+  buffer.resize(3 * nbPixels + ext * ext);
+  float *patchI = &buffer[0];
+  float *patchIx = patchI + nbPixels;
+  float *patchIy = patchIx + nbPixels;
+  float *patchExt = patchIy + nbPixels;
+
+  const int topLevel = (int)levels.size() - 1;
+  // Displacement at the current level
+  double u = (nextPt.get_u() - prevPt.get_u()) / (1 << topLevel);
+  double v = (nextPt.get_v() - prevPt.get_v()) / (1 << topLevel);
+
+  for (int level = topLevel; level >= 0; level--) {
+    const vpImage<unsigned char> &P = m_prevLevels[(size_t)level];
+    const vpImage<unsigned char> &J = *levels[(size_t)level];
+    const double scale = 1. / (1 << level);
+    const double px = prevPt.get_u() * scale, py = prevPt.get_v() * scale;
+
+    // Previous image around the feature, with a one pixel margin for the derivatives.
+    // The window can be partially outside of the image, the border being replicated.
+    const double x0 = px - half - 1, y0 = py - half - 1;
+    if (x0 < -(double)ext || y0 < -(double)ext || x0 >= P.getWidth() || y0 >= P.getHeight()) {
+      if (level == 0) {
+        return false;
+      }
+      u *= 2;
+      v *= 2;
+      continue;
+    }
+    const int ix = (int)std::floor(x0), iy = (int)std::floor(y0);
+    float fx = (float)(x0 - ix), fy = (float)(y0 - iy);
+    float w[4] = { (1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy };
+    if (isInside(P, iy, ix, ext)) {
+      for (unsigned int r = 0; r < ext; r++) {
+        const unsigned char *row0 = P[(unsigned int)iy + r] + ix;
+        const unsigned char *row1 = P[(unsigned int)iy + r + 1] + ix;
+        float *dst = patchExt + r * ext;
+        for (unsigned int c = 0; c < ext; c++) {
+          dst[c] = w[0] * row0[c] + w[1] * row0[c + 1] + w[2] * row1[c] + w[3] * row1[c + 1];
+        }
+      }
+    } else {
+      for (unsigned int r = 0; r < ext; r++) {
+        for (unsigned int c = 0; c < ext; c++) {
+          patchExt[r * ext + c] = getClampedValue(P, iy + (int)r, ix + (int)c, w);
+        }
+      }
+    }
+
+    // Template, its gradient and the spatial gradient matrix
+    double A11 = 0, A12 = 0, A22 = 0;
+    for (int r = 0; r < (int)side; r++) {
+      const float *row = patchExt + (r + 1) * (int)ext + 1;
+      for (int c = 0; c < (int)side; c++) {
+        const int idx = r * (int)side + c;
+        const float gx = 0.5f * (row[c + 1] - row[c - 1]);
+        const float gy = 0.5f * (row[c + (int)ext] - row[c - (int)ext]);
+        patchI[idx] = row[c];
+        patchIx[idx] = gx;
+        patchIy[idx] = gy;
+        A11 += gx * gx;
+        A12 += gx * gy;
+        A22 += gy * gy;
+      }
+    }
+
+    const double D = A11 * A22 - A12 * A12;
+    const double minEig =
+        (A22 + A11 - std::sqrt((A11 - A22) * (A11 - A22) + 4 * A12 * A12)) / (2 * nbPixels) * vpKltMinEigScale;
+    if (minEig < m_minEigThreshold || D < std::numeric_limits<float>::epsilon()) {
+      if (level == 0) {
+        return false;
+      }
+      u *= 2;
+      v *= 2;
+      continue;
+    }
+
+    for (int iter = 0; iter < m_maxIterations; iter++) {
+      const double qx = px + u - half, qy = py + v - half;
+      if (qx < -(double)side || qy < -(double)side || qx >= J.getWidth() || qy >= J.getHeight()) {
+        if (level == 0) {
+          return false;
+        }
+        break;
+      }
+      const int jx = (int)std::floor(qx), jy = (int)std::floor(qy);
+      fx = (float)(qx - jx);
+      fy = (float)(qy - jy);
+      w[0] = (1 - fx) * (1 - fy);
+      w[1] = fx * (1 - fy);
+      w[2] = (1 - fx) * fy;
+      w[3] = fx * fy;
+
+      double b1 = 0, b2 = 0;
+      if (isInside(J, jy, jx, side)) {
+        computeMismatch(J, (unsigned int)jy, (unsigned int)jx, w, patchI, patchIx, patchIy, side, b1, b2);
+      } else {
+        for (unsigned int r = 0; r < side; r++) {
+          for (unsigned int c = 0; c < side; c++) {
+            const unsigned int idx = r * side + c;
+            const float diff = patchI[idx] - getClampedValue(J, jy + (int)r, jx + (int)c, w);
+            b1 += diff * patchIx[idx];
+            b2 += diff * patchIy[idx];
+          }
+        }
+      }
+      const double du = (A22 * b1 - A12 * b2) / D;
+      const double dv = (A11 * b2 - A12 * b1) / D;
+      u += du;
+      v += dv;
+      if (du * du + dv * dv <= m_epsilon * m_epsilon) {
+        break;
+      }
+    }
+
+    if (level > 0) {
+      u *= 2;
+      v *= 2;
+    }
+  }
+
+  nextPt.set_uv(prevPt.get_u() + u, prevPt.get_v() + v);
+  return nextPt.get_u() >= 0 && nextPt.get_v() >= 0 && nextPt.get_u() <= levels[0]->getWidth() - 1 &&
+         nextPt.get_v() <= levels[0]->getHeight() - 1;
+}
@@ -0,0 +1,233 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the native pyramidal KLT tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testKltTracker.cpp
+
+  \brief Detect and track features with vpKltTracker in synthetic images of a
+  translated texture, and check the tracked positions and the feature ids.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/klt/vpKltTracker.h>
+
+namespace {
+  struct Blob
+  {
+    double i, j, sigma, amplitude;
+  };
+
+  // Texture made of Gaussian blobs, translated by (ti, tj)
+  void render(const std::vector<Blob> &blobs, double ti, double tj, vpImage<unsigned char> &I)
+  {
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double val = 128;
+        for (size_t k = 0; k < blobs.size(); k++) {
+          double di = i - ti - blobs[k].i, dj = j - tj - blobs[k].j;
+          double d2 = di * di + dj * dj;
+          if (d2 < 16 * blobs[k].sigma * blobs[k].sigma) {
+            val += blobs[k].amplitude * std::exp(-d2 / (2 * blobs[k].sigma * blobs[k].sigma));
+          }
+        }
+        I[i][j] = (unsigned char)vpMath::round(std::max(0., std::min(255., val)));
+      }
+    }
+  }
+
+  // Check that the features are at their initial position translated by (ti, tj) and that the ids are kept.
+  // The features whose window was partially outside of the image may drift, so that the median error is
+  // checked with a tight threshold and the maximal error with a loose one.
+  bool checkFeatures(const vpKltTracker &tracker, const std::vector<vpImagePoint> &initFeatures, double ti, double tj,
+                     size_t minNbFeatures)
+  {
+    std::vector<vpImagePoint> features = tracker.getFeatures();
+    std::vector<long> ids = tracker.getFeaturesId();
+    if (features.size() != ids.size() || features.size() < minNbFeatures) {
+      std::cerr << "Bad number of features: " << features.size() << std::endl;
+      return false;
+    }
+    std::vector<double> errors;
+    for (size_t k = 0; k < features.size(); k++) {
+      if (ids[k] < 0 || ids[k] >= (long)initFeatures.size() || (k > 0 && ids[k] <= ids[k - 1])) {
+        std::cerr << "Bad feature id " << ids[k] << std::endl;
+        return false;
+      }
+      vpImagePoint expected = initFeatures[(size_t)ids[k]] + vpImagePoint(ti, tj);
+      errors.push_back(vpImagePoint::distance(expected, features[k]));
+      if (errors.back() > 1) {
+        std::cerr << "Feature " << ids[k] << " at " << features[k] << " instead of " << expected << std::endl;
+        return false;
+      }
+    }
+    std::nth_element(errors.begin(), errors.begin() + errors.size() / 2, errors.end());
+    if (errors[errors.size() / 2] > 0.05) {
+      std::cerr << "Median error " << errors[errors.size() / 2] << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    vpUniRand rand(42);
+    std::vector<Blob> blobs(250);
+    for (size_t k = 0; k < blobs.size(); k++) {
+      blobs[k].i = -40 + 320 * rand();
+      blobs[k].j = -40 + 400 * rand();
+      blobs[k].sigma = 2 + 4 * rand();
+      blobs[k].amplitude = (rand() > 0.5 ? 1 : -1) * (40 + 60 * rand());
+    }
+
+    vpImage<unsigned char> I(240, 320);
+    render(blobs, 0, 0, I);
+
+    vpKltTracker tracker;
+    tracker.setMaxFeatures(100);
+    tracker.setWindowSize(11);
+    tracker.setQuality(0.01);
+    tracker.setMinDistance(10);
+    tracker.setUseHarris(0);
+    tracker.setPyramidLevels(3);
+
+    // Mask out the left part of the image
+    vpImage<unsigned char> mask(I.getHeight(), I.getWidth(), 255);
+    for (unsigned int i = 0; i < mask.getHeight(); i++) {
+      for (unsigned int j = 0; j < 40; j++) {
+        mask[i][j] = 0;
+      }
+    }
+    tracker.initTracking(I, &mask);
+    std::vector<vpImagePoint> initFeatures = tracker.getFeatures();
+    if (initFeatures.size() < 50 || initFeatures.size() > 100) {
+      std::cerr << "Bad number of detected features: " << initFeatures.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (size_t k = 0; k < initFeatures.size(); k++) {
+      if (initFeatures[k].get_j() < 39.5) {
+        std::cerr << "Feature detected in the mask" << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (size_t l = 0; l < k; l++) {
+        if (vpImagePoint::distance(initFeatures[k], initFeatures[l]) < 10) {
+          std::cerr << "Features closer than the minimal distance" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    std::cout << initFeatures.size() << " features detected" << std::endl;
+
+    // Small and large translations, the large ones requiring the pyramid
+    const double translations[][2] = { { 0.4, -0.7 }, { 1.5, 0.6 }, { 7.3, 5.2 }, { 2.1, 14.6 }, { -3.2, 9.8 } };
+    double ti = 0, tj = 0;
+    vpImagePyramid pyramid(4);
+    for (unsigned int n = 0; n < 5; n++) {
+      ti += translations[n][0];
+      tj += translations[n][1];
+      render(blobs, ti, tj, I);
+      if (n % 2 == 0) {
+        tracker.track(I);
+      } else {
+        // Pyramid shared with other consumers of the frame
+        pyramid.setImage(I, n);
+        tracker.track(pyramid);
+      }
+      if (!checkFeatures(tracker, initFeatures, ti, tj, (initFeatures.size() * 8) / 10)) {
+        std::cerr << "Failure after the translation " << n << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // A large motion without pyramid is only tracked with an initial guess
+    std::vector<vpImagePoint> guess = tracker.getFeatures();
+    for (size_t k = 0; k < guess.size(); k++) {
+      guess[k] += vpImagePoint(12, -10);
+    }
+    ti += 12.6;
+    tj -= 10.4;
+    render(blobs, ti, tj, I);
+    tracker.setPyramidLevels(0);
+    tracker.setInitialGuess(guess);
+    tracker.track(I);
+    if (!checkFeatures(tracker, initFeatures, ti, tj, (initFeatures.size() * 7) / 10)) {
+      std::cerr << "Failure with an initial guess" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The features that leave the image are lost
+    tracker.setPyramidLevels(3);
+    tj += 12;
+    render(blobs, ti, tj, I);
+    tracker.track(I);
+    if (!checkFeatures(tracker, initFeatures, ti, tj, 1)) {
+      std::cerr << "Failure when features leave the image" << std::endl;
+      return EXIT_FAILURE;
+    }
+    size_t nbInside = 0;
+    for (size_t k = 0; k < initFeatures.size(); k++) {
+      if (initFeatures[k].get_j() + tj <= I.getWidth() - 1 && initFeatures[k].get_i() + ti <= I.getHeight() - 1) {
+        nbInside++;
+      }
+    }
+    if ((size_t)tracker.getNbFeatures() > nbInside) {
+      std::cerr << "Features out of the image are not lost" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    tracker.addFeature(100.f, 50.f);
+    long id;
+    float x, y;
+    tracker.getFeature(tracker.getNbFeatures() - 1, id, x, y);
+    if (id != (long)initFeatures.size() || x != 100.f || y != 50.f) {
+      std::cerr << "Bad added feature: " << id << " " << x << " " << y << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testKltTracker is ok" << std::endl;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
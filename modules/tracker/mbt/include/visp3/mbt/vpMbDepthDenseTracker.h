@@ -37,6 +37,7 @@
 #define __vpMbDepthDenseTracker_h_
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtFaceDepthDense.h>
 #include <visp3/mbt/vpMbtTukeyEstimator.h>
@@ -111,11 +112,14 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height);
+  virtual void track(const vpPointCloud &point_cloud);
 
 
 protected:
   //! Set of faces describing the object used only for display with scan line.
   vpMbHiddenFaces<vpMbtPolygon> m_depthDenseHiddenFacesDisplay;
+  //! True if the faces used for display must be copied again from the model faces
+  bool m_depthDenseHiddenFacesDisplayOutdated;
   //! Dummy image used to compute the visibility
   vpImage<unsigned char> m_depthDenseI_dummyVisibility;
   //! List of current active (visible and features extracted) faces
@@ -168,5 +172,8 @@ protected:
   void segmentPointCloud(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height);
+  void segmentPointCloud(const vpPointCloud &point_cloud);
+  template<class PointCloud>
+  void segmentPointCloudImpl(const PointCloud &point_cloud, const unsigned int width, const unsigned int height);
 };
 #endif
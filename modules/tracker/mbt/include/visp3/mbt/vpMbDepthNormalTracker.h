@@ -38,6 +38,7 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtFaceDepthNormal.h>
 
@@ -114,6 +115,7 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height);
+  virtual void track(const vpPointCloud &point_cloud);
 
 
 protected:
@@ -121,6 +123,8 @@ protected:
   vpMbtFaceDepthNormal::vpFeatureEstimationType m_depthNormalFeatureEstimationMethod;
   //! Set of faces describing the object used only for display with scan line.
   vpMbHiddenFaces<vpMbtPolygon> m_depthNormalHiddenFacesDisplay;
+  //! True if the faces used for display must be copied again from the model faces
+  bool m_depthNormalHiddenFacesDisplayOutdated;
   //! Dummy image used to compute the visibility
   vpImage<unsigned char> m_depthNormalI_dummyVisibility;
   //! List of current active (visible and with features extracted) faces
@@ -179,5 +183,8 @@ protected:
   void segmentPointCloud(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height);
+  void segmentPointCloud(const vpPointCloud &point_cloud);
+  template<class PointCloud>
+  void segmentPointCloudImpl(const PointCloud &point_cloud, const unsigned int width, const unsigned int height);
 };
 #endif
@@ -47,13 +47,17 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 #include <visp3/core/vpSubMatrix.h>
 #include <visp3/core/vpSubColVector.h>
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/mbt/vpMbTracker.h>
-#include <visp3/klt/vpKltOpencv.h>
+#if defined(VISP_HAVE_OPENCV)
+#  include <visp3/klt/vpKltOpencv.h>
+#else
+#  include <visp3/klt/vpKltTracker.h>
+#endif
 #include <visp3/mbt/vpMbEdgeTracker.h>
 #include <visp3/core/vpPoseVector.h>
 #include <visp3/mbt/vpMbtEdgeKltXmlParser.h>
@@ -62,7 +66,8 @@
 /*!
   \class vpMbEdgeKltTracker
   \ingroup group_mbt_trackers
-  \warning This class is only available if OpenCV is installed, and used.
+  \warning This class is only available if the klt module is built. Without OpenCV,
+  the points are tracked with vpKltTracker instead of vpKltOpencv.
 
   \brief Hybrid tracker based on moving-edges and keypoints tracked using KLT
   tracker.
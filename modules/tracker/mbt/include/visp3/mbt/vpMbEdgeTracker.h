@@ -324,6 +324,8 @@ class VISP_EXPORT vpMbEdgeTracker: public virtual vpMbTracker
     vpColVector m_weightedError_edge;
     //! Robust
     vpRobust m_robust_edge;
+    //! If true, track the moving edges of the lines in parallel when OpenMP is available
+    bool m_useParallelMovingEdgeTracking;
 
 
 public:
@@ -381,6 +383,13 @@ public:
     return m_w_edge;
   }
 
+  /*!
+    \return True if the moving edges of the lines are tracked in parallel.
+
+    \sa setUseParallelMovingEdgeTracking()
+  */
+  inline bool getUseParallelMovingEdgeTracking() const { return m_useParallelMovingEdgeTracking; }
+
   void loadConfigFile(const std::string &configFile);
   void loadConfigFile(const char* configFile);
   virtual void reInitModel(const vpImage<unsigned char>& I, const std::string &cad_name, const vpHomogeneousMatrix& cMo_,
@@ -473,6 +482,8 @@ public:
 
   void setUseEdgeTracking(const std::string &name, const bool &useEdgeTracking);
 
+  virtual void setUseParallelMovingEdgeTracking(const bool use);
+
   void track(const vpImage<unsigned char> &I);
   //@}
 
@@ -510,6 +521,7 @@ protected:
   unsigned int initMbtTracking(unsigned int &nberrors_lines, unsigned int &nberrors_cylinders, unsigned int &nberrors_circles);
   void initMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &_cMo);
   void initPyramid(const vpImage<unsigned char>& _I, std::vector<const vpImage<unsigned char>* >& _pyramid);
+  bool isMovingEdgeDisplayed() const;
   void reInitLevel(const unsigned int _lvl);
   void reinitMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &_cMo);
   void removeCircle(const std::string& name);
@@ -40,17 +40,20 @@
 #ifndef __vpMbGenericTracker_h_
 #define __vpMbGenericTracker_h_
 
+#include <visp3/core/vpRect.h>
 #include <visp3/mbt/vpMbEdgeTracker.h>
 #include <visp3/mbt/vpMbKltTracker.h>
 #include <visp3/mbt/vpMbDepthNormalTracker.h>
 #include <visp3/mbt/vpMbDepthDenseTracker.h>
+#include <visp3/mbt/vpMbtPosePredictor.h>
+#include <visp3/mbt/vpMbtTrackingStatistics.h>
 
 
 class VISP_EXPORT vpMbGenericTracker : public vpMbTracker {
 public:
   enum vpTrackerType {
     EDGE_TRACKER          = 1 << 0,    /*!< Model-based tracking using moving edges features. */
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     KLT_TRACKER           = 1 << 1,    /*!< Model-based tracking using KLT features. */
 #endif
     DEPTH_NORMAL_TRACKER  = 1 << 2,    /*!< Model-based tracking using depth normal features. */
@@ -104,7 +107,7 @@ public:
   virtual vpMbHiddenFaces<vpMbtPolygon>& getFaces();
   virtual vpMbHiddenFaces<vpMbtPolygon>& getFaces(const std::string &cameraName);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   virtual std::list<vpMbtDistanceCircle*>& getFeaturesCircle();
   virtual std::list<vpMbtDistanceKltCylinder*>& getFeaturesKltCylinder();
   virtual std::list<vpMbtDistanceKltPoints*>& getFeaturesKlt();
@@ -112,18 +115,26 @@ public:
 
   virtual double getGoodMovingEdgesRatioThreshold() const;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   virtual std::vector<vpImagePoint> getKltImagePoints() const;
   virtual std::map<int, vpImagePoint> getKltImagePointsWithId() const;
 
   virtual unsigned int getKltMaskBorder() const;
   virtual int getKltNbPoints() const;
 
+#  if defined(VISP_HAVE_OPENCV)
   virtual vpKltOpencv getKltOpencv() const;
   virtual void getKltOpencv(vpKltOpencv &klt1, vpKltOpencv &klt2) const;
   virtual void getKltOpencv(std::map<std::string, vpKltOpencv> &mapOfKlts) const;
+#  else
+  virtual vpKltTracker getKltTracker() const;
+  virtual void getKltTracker(vpKltTracker &klt1, vpKltTracker &klt2) const;
+  virtual void getKltTracker(std::map<std::string, vpKltTracker> &mapOfKlts) const;
+#  endif
 
-#  if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#  if !defined(VISP_HAVE_OPENCV)
+  virtual std::vector<vpImagePoint> getKltPoints() const;
+#  elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   virtual std::vector<cv::Point2f> getKltPoints() const;
 #  endif
 
@@ -157,10 +168,28 @@ public:
   virtual void getPose(vpHomogeneousMatrix &c1Mo, vpHomogeneousMatrix &c2Mo) const;
   virtual void getPose(std::map<std::string, vpHomogeneousMatrix> &mapOfCameraPoses) const;
 
+  /*! Return the predictor of the pose of the reference camera for the next image. */
+  virtual inline const vpMbtPosePredictor &getPosePredictor() const {
+    return m_posePredictor;
+  }
+
+  virtual vpRect getPredictedRoi() const;
+  virtual void getPredictedRoi(std::map<std::string, vpRect> &mapOfRois) const;
+  virtual unsigned int getPredictedRoiMargin() const;
+
   virtual inline vpColVector getRobustWeights() const {
     return m_w;
   }
 
+  /*! Return the timings and the counters of the tracking, see setUseTrackingStatistics(). */
+  virtual inline const vpMbtTrackingStatistics &getTrackingStatistics() const {
+    return m_trackingStatistics;
+  }
+
+  virtual bool getUseParallelTracking() const;
+  virtual bool getUsePredictedRoi() const;
+  virtual bool getUseTrackingStatistics() const;
+
   virtual void init(const vpImage<unsigned char>& I);
 
 #ifdef VISP_HAVE_MODULE_GUI
@@ -205,6 +234,7 @@ public:
                            const std::map<std::string, vpHomogeneousMatrix> &mapOfCameraPoses, const bool verbose=false);
 
   virtual void resetTracker();
+  virtual void resetTrackingStatistics();
 
   virtual void setAngleAppear(const double &a);
   virtual void setAngleAppear(const double &a1, const double &a2);
@@ -246,6 +276,8 @@ public:
 
   virtual void setFeatureFactors(const std::map<vpTrackerType, double> &mapOfFeatureFactors);
 
+  virtual void setFrameTimestamp(const double timestamp);
+
   virtual void setGoodMovingEdgesRatioThreshold(const double  threshold);
 
 #ifdef VISP_HAVE_OGRE
@@ -253,14 +285,20 @@ public:
   virtual void setNbRayCastingAttemptsForVisibility(const unsigned int &attempts);
 #endif
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   virtual void setKltMaskBorder(const unsigned int &e);
   virtual void setKltMaskBorder(const unsigned int &e1, const unsigned int &e2);
   virtual void setKltMaskBorder(const std::map<std::string, unsigned int> &mapOfErosions);
 
+#  if defined(VISP_HAVE_OPENCV)
   virtual void setKltOpencv(const vpKltOpencv &t);
   virtual void setKltOpencv(const vpKltOpencv &t1, const vpKltOpencv &t2);
   virtual void setKltOpencv(const std::map<std::string, vpKltOpencv> &mapOfKlts);
+#  else
+  virtual void setKltTracker(const vpKltTracker &t);
+  virtual void setKltTracker(const vpKltTracker &t1, const vpKltTracker &t2);
+  virtual void setKltTracker(const std::map<std::string, vpKltTracker> &mapOfKlts);
+#  endif
 
   virtual void setKltThresholdAcceptation(const double th);
 
@@ -271,9 +309,12 @@ public:
   virtual void setMinLineLengthThresh(const double minLineLengthThresh, const std::string &name="");
   virtual void setMinPolygonAreaThresh(const double minPolygonAreaThresh, const std::string &name="");
 
+  virtual void setModelCacheDirectory(const std::string &directory);
+
   virtual void setMovingEdge(const vpMe &me);
   virtual void setMovingEdge(const vpMe &me1, const vpMe &me2);
   virtual void setMovingEdge(const std::map<std::string, vpMe> &mapOfMe);
+  virtual void setMovingEdgeMaxRange(const unsigned int maxRange);
 
   virtual void setNearClippingDistance(const double &dist);
   virtual void setNearClippingDistance(const double &dist1, const double &dist2);
@@ -288,6 +329,10 @@ public:
   virtual void setPose(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2, const vpHomogeneousMatrix &c1Mo, const vpHomogeneousMatrix &c2Mo);
   virtual void setPose(const std::map<std::string, const vpImage<unsigned char> *> &mapOfImages, const std::map<std::string, vpHomogeneousMatrix> &mapOfCameraPoses);
 
+  virtual void setPosePrediction(const vpMbtPosePredictor::vpPredictionType &type);
+
+  virtual void setPredictedRoiMargin(const unsigned int margin);
+
   virtual void setProjectionErrorComputation(const bool &flag);
 
   virtual void setReferenceCameraName(const std::string &referenceCameraName);
@@ -297,11 +342,18 @@ public:
   virtual void setTrackerType(const int type);
   virtual void setTrackerType(const std::map<std::string, int> &mapOfTrackerTypes);
 
+  virtual void setTrackingStatisticsWindowSize(const unsigned int windowSize);
+
   virtual void setUseEdgeTracking(const std::string &name, const bool &useEdgeTracking);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   virtual void setUseKltTracking(const std::string &name, const bool &useKltTracking);
 #endif
 
+  virtual void setUseParallelMovingEdgeTracking(const bool use);
+  virtual void setUseParallelTracking(const bool use);
+  virtual void setUsePredictedRoi(const bool use);
+  virtual void setUseTrackingStatistics(const bool use);
+
   virtual void testTracking();
 
   virtual void track(const vpImage<unsigned char> &I);
@@ -315,6 +367,8 @@ public:
                      std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                      std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+  virtual void track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                     std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
 
 
 protected:
@@ -340,6 +394,21 @@ protected:
 
   virtual void initFaceFromLines(vpMbtPolygon &polygon);
 
+  bool isMovingEdgeDisplayed() const;
+
+#ifdef VISP_HAVE_PCL
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                            std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
+#endif
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                            std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                            std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+
+  virtual void predictPose();
+  virtual void resetStageTimings();
+  virtual void updatePosePrediction();
+  virtual void updateTrackingStatistics(const double trackingStart);
+
 #ifdef VISP_HAVE_PCL
   virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                            std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
@@ -349,10 +418,21 @@ protected:
                            std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                            std::map<std::string, unsigned int> &mapOfPointCloudHeights);
 
+  template<class PointCloud>
+  void preTrackingImpl(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                       std::map<std::string, const PointCloud *> &mapOfPointClouds,
+                       std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                       std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+  template<class PointCloud>
+  void trackImpl(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                 std::map<std::string, const PointCloud *> &mapOfPointClouds,
+                 std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                 std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+
 
 private:
   class TrackerWrapper : public vpMbEdgeTracker,
-                      #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                      #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                          public vpMbKltTracker,
                       #endif
                          public vpMbDepthNormalTracker,
@@ -458,6 +538,30 @@ private:
     virtual void postTracking(const vpImage<unsigned char> * const ptr_I=NULL, const unsigned int pointcloud_width=0, const unsigned int pointcloud_height=0);
     virtual void preTracking(const vpImage<unsigned char> * const ptr_I=NULL, const std::vector<vpColVector> * const point_cloud=NULL,
                              const unsigned int pointcloud_width=0, const unsigned int pointcloud_height=0);
+
+    template<class PointCloud>
+    void preTrackingImpl(const vpImage<unsigned char> * const ptr_I, const PointCloud * const point_cloud,
+                         const unsigned int pointcloud_width, const unsigned int pointcloud_height);
+
+    double computeImageMotion(const vpHomogeneousMatrix &cMo_pred) const;
+    void updatePredictedRoi(const unsigned int width, const unsigned int height, const bool useMotion);
+
+    //! If true, the features are extracted only in m_predictedRoi
+    bool m_usePredictedRoi;
+    //! Margin in pixels added to the projected model bounding box
+    unsigned int m_predictedRoiMargin;
+    //! Region of the next image that contains the model and the features
+    vpRect m_predictedRoi;
+    //! Pose used to compute m_predictedRoi, to get the displacement of the model between two frames
+    vpHomogeneousMatrix m_predictedRoiPose;
+    //! True if m_predictedRoiPose is the pose of the previous frame
+    bool m_predictedRoiPoseAvailable;
+    //! Moving-edges range adapted to the predicted motion for the next image, 0 to use the range of vpMe
+    unsigned int m_predictedMeRange;
+    //! If true, the duration of the tracking stages is measured
+    bool m_useTrackingStatistics;
+    //! Duration in ms of the tracking stages of the current image
+    std::map<std::string, double> m_stageTimings;
   };
 
 
@@ -478,9 +582,27 @@ protected:
   std::string m_referenceCameraName;
   //! Threshold below which the weight associated to a point to consider this one as an outlier (only for KLT tracking).
   double m_thresholdOutlier;
+  //! If true, each camera is processed by its own thread during the tracking stages
+  bool m_useParallelTracking;
   //! Robust weights
   vpColVector m_w;
   //! Weighted error
   vpColVector m_weightedError;
+  //! Predictor of the pose of the reference camera for the next image
+  vpMbtPosePredictor m_posePredictor;
+  //! Timestamp of the next image, see setFrameTimestamp()
+  double m_frameTimestamp;
+  //! True if the timestamp of the next image has been set
+  bool m_frameTimestampAvailable;
+  //! Maximum moving-edges range when it is adapted to the predicted motion
+  unsigned int m_maxMovingEdgeRange;
+  //! If true, the timings and the counters of the tracking are recorded
+  bool m_useTrackingStatistics;
+  //! Timings and counters of the tracking
+  vpMbtTrackingStatistics m_trackingStatistics;
+  //! Duration in ms of the tracking stages of the current images
+  std::map<std::string, double> m_stageTimings;
+  //! Number of iterations of the last virtual visual servoing
+  unsigned int m_nbVVSIterations;
 };
 #endif
@@ -45,6 +45,7 @@
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/mbt/vpMbtBoundingVolumeHierarchy.h>
 #include <visp3/mbt/vpMbtPolygon.h>
 #include <visp3/mbt/vpMbScanLine.h>
 
@@ -52,6 +53,7 @@
   #include <visp3/ar/vpAROgre.h>
 #endif
 
+#include <algorithm>
 #include <vector>
 #include <limits>
 
@@ -77,6 +79,16 @@ private:
   //! Number of visible polygon
   unsigned int nbVisiblePolygon;
   vpMbScanLine scanlineRender;
+  //! Bounding volume hierarchy over the polygons
+  vpMbtBoundingVolumeHierarchy bvh;
+  //! True if the hierarchy has to be built again before being used
+  bool bvhOutdated;
+  //! True if the hierarchy is used to cull the polygons
+  bool useBvh;
+  //! Back-facing polygons found with the hierarchy for the current pose
+  std::vector<bool> bvhBackFacing;
+  //! Clipping planes each polygon is outside of for the current pose
+  std::vector<unsigned int> bvhOutsideFrustum;
 
 #ifdef VISP_HAVE_OGRE
   vpImage<unsigned char> ogreBackground;
@@ -94,6 +106,8 @@ private:
                            const vpImage<unsigned char> &I = vpImage<unsigned char>(),
                            const vpCameraParameters &cam = vpCameraParameters());
 
+  void updateBvh();
+
 public :
   vpMbHiddenFaces();
   ~vpMbHiddenFaces();
@@ -120,6 +134,14 @@ public :
 
     vpMbScanLine& getMbScanLineRenderer() { return scanlineRender; }
 
+    /*!
+      Return true if the bounding volume hierarchy over the polygons is used to
+      cull them in setVisible() and computeClippedPolygons().
+
+      \sa setUseBoundingVolumeHierarchy()
+    */
+    bool getUseBoundingVolumeHierarchy() const { return useBvh; }
+
 #ifdef VISP_HAVE_OGRE
     void          displayOgre(const vpHomogeneousMatrix &cMo);
 #endif
@@ -247,6 +269,17 @@ public :
     }
 #endif
 
+    /*!
+      Enable or disable the use of a bounding volume hierarchy over the polygons.
+      When enabled (the default), setVisible() and computeClippedPolygons() find
+      the back-facing polygons and the polygons outside the camera frustum by
+      groups, and run the per-polygon tests only for the other ones. The
+      results are the same in both cases.
+
+      \param use : True to use the hierarchy.
+    */
+    void          setUseBoundingVolumeHierarchy(const bool use) { useBvh = use; }
+
     unsigned int  setVisible(const vpImage<unsigned char>& I, const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo, const double &angle, bool &changed);
     unsigned int  setVisible(const vpImage<unsigned char>& I, const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo, const double &angleAppears, const double &angleDisappears, bool &changed);
     unsigned int  setVisible(const vpHomogeneousMatrix &cMo, const double &angleAppears, const double &angleDisappears, bool &changed);
@@ -268,7 +301,8 @@ public :
 */
 template<class PolygonType>
 vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces()
-  : Lpol(), nbVisiblePolygon(0), scanlineRender()
+  : Lpol(), nbVisiblePolygon(0), scanlineRender(), bvh(), bvhOutdated(true), useBvh(true), bvhBackFacing(),
+    bvhOutsideFrustum()
 {
 #ifdef VISP_HAVE_OGRE
   ogreInitialised = false;
@@ -317,7 +351,8 @@ vpMbHiddenFaces<PolygonType>::~vpMbHiddenFaces()
 */
 template<class PolygonType>
 vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces(const vpMbHiddenFaces<PolygonType> &copy) :
-  Lpol(), nbVisiblePolygon(copy.nbVisiblePolygon), scanlineRender(copy.scanlineRender)
+  Lpol(), nbVisiblePolygon(copy.nbVisiblePolygon), scanlineRender(copy.scanlineRender), bvh(copy.bvh),
+  bvhOutdated(copy.bvhOutdated), useBvh(copy.useBvh), bvhBackFacing(), bvhOutsideFrustum()
 #ifdef VISP_HAVE_OGRE
   ,  ogreBackground(copy.ogreBackground), ogreInitialised(copy.ogreInitialised), nbRayAttempts(copy.nbRayAttempts),
   ratioVisibleRay(copy.ratioVisibleRay), ogre(NULL), lOgrePolygons(), ogreShowConfigDialog(copy.ogreShowConfigDialog)
@@ -336,6 +371,9 @@ void swap(vpMbHiddenFaces<PolygonType> &first, vpMbHiddenFaces<PolygonType> &sec
   swap(first.Lpol, second.Lpol);
   swap(first.nbVisiblePolygon, second.nbVisiblePolygon);
   swap(first.scanlineRender, second.scanlineRender);
+  swap(first.bvh, second.bvh);
+  swap(first.bvhOutdated, second.bvhOutdated);
+  swap(first.useBvh, second.useBvh);
 #ifdef VISP_HAVE_OGRE
   swap(first.ogreInitialised, second.ogreInitialised);
   swap(first.nbRayAttempts, second.nbRayAttempts);
@@ -378,6 +416,7 @@ vpMbHiddenFaces<PolygonType>::addPolygon(PolygonType *p)
   for(unsigned int i = 0; i < p->nbpt; i++)
     p_new->p[i]= p->p[i];
   Lpol.push_back(p_new);
+  bvhOutdated = true;
 }
 
 /*!
@@ -395,6 +434,8 @@ vpMbHiddenFaces<PolygonType>::reset()
     Lpol[i] = NULL;
   }
   Lpol.resize(0);
+  bvh.clear();
+  bvhOutdated = true;
 
 #ifdef VISP_HAVE_OGRE
   if(ogre != NULL){
@@ -420,9 +461,27 @@ vpMbHiddenFaces<PolygonType>::reset()
 #endif
 }
 
+/*!
+  Build the bounding volume hierarchy over the polygons if it is outdated.
+*/
+template<class PolygonType>
+void
+vpMbHiddenFaces<PolygonType>::updateBvh()
+{
+  if (bvhOutdated || bvh.getNbPolygons() != Lpol.size()) {
+    std::vector<vpMbtPolygon *> polygons(Lpol.begin(), Lpol.end());
+    bvh.build(polygons);
+    bvhOutdated = false;
+  }
+}
+
 /*!
   Compute the clipped points of the polygons that have been added via addPolygon().
 
+  The polygons that lie entirely outside one of their clipping planes are found
+  with the bounding volume hierarchy (see setUseBoundingVolumeHierarchy()) and
+  get an empty clipped polygon without being clipped.
+
   \param cMo : Pose that will be used to clip the polygons.
   \param cam : Camera parameters that will be used to clip the polygons.
 */
@@ -430,13 +489,39 @@ template<class PolygonType>
 void
 vpMbHiddenFaces<PolygonType>::computeClippedPolygons(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam)
 {
+  bool useHierarchy = useBvh && !Lpol.empty();
+  double nearDist = 0, farDist = 0;
+  if (useHierarchy) {
+    updateBvh();
+    nearDist = Lpol[0]->distNearClip;
+    farDist = Lpol[0]->distFarClip;
+    bvh.cullFrustum(cMo, cam, nearDist, farDist, bvhOutsideFrustum);
+  }
+
   for (unsigned int i = 0; i < Lpol.size(); i++){
     // For fast result we could just clip visible polygons.
     // However clipping all of them gives us the possibility to return more information in the scanline visibility results
 //    if(Lpol[i]->isVisible())
     {
       Lpol[i]->changeFrame(cMo);
-      Lpol[i]->computePolygonClipped(cam);
+
+      unsigned int outside = useHierarchy ? bvhOutsideFrustum[i] : 0;
+      if (outside != 0) {
+        // Planes used by computePolygonClipped(), the near clipping is implied by the FOV clipping
+        unsigned int planes = Lpol[i]->clippingFlag;
+        if (planes > vpPolygon3D::FAR_CLIPPING)
+          planes |= vpPolygon3D::NEAR_CLIPPING;
+        if (Lpol[i]->distNearClip != nearDist)
+          planes &= ~(unsigned int)vpPolygon3D::NEAR_CLIPPING;
+        if (Lpol[i]->distFarClip != farDist)
+          planes &= ~(unsigned int)vpPolygon3D::FAR_CLIPPING;
+        outside &= planes;
+      }
+
+      if (outside != 0)
+        Lpol[i]->polyClipped.clear();
+      else
+        Lpol[i]->computePolygonClipped(cam);
     }
   }
 }
@@ -495,6 +580,10 @@ vpMbHiddenFaces<PolygonType>::computeScanLineQuery(const vpPoint &a, const vpPoi
 /*!
   Compute the number of visible polygons.
 
+  When Ogre is not used, the polygons that are back-facing for both angles are
+  found with the bounding volume hierarchy (see setUseBoundingVolumeHierarchy())
+  and are set as not visible without being tested individually.
+
   \param cMo : The pose of the camera
   \param angleAppears : Angle used to test the appearance of a face
   \param angleDisappears : Angle used to test the disappearance of a face
@@ -528,9 +617,24 @@ vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneousMatrix &cMo,
 #endif
   }
 
+  bool useHierarchy = useBvh && !useOgre && !Lpol.empty();
+  if (useHierarchy) {
+    updateBvh();
+    // Faces above this angle are neither visible nor appearing, see vpMbtPolygon::isVisible()
+    bvh.cullBackFaces(cMo, (std::max)(angleAppears, angleDisappears) + vpMath::rad(1), bvhBackFacing);
+  }
+
   for (unsigned int i = 0; i < Lpol.size(); i++){
     //std::cout << "Calling poly: " << i << std::endl;
-    if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, I, cam, cameraPos, i))
+    if (useHierarchy && bvhBackFacing[i]) {
+      // Same result as computeVisibility() for a back-facing face
+      Lpol[i]->changeFrame(cMo);
+      if (Lpol[i]->isvisible)
+        changed = true;
+      Lpol[i]->isvisible = false;
+      Lpol[i]->isappearing = false;
+    }
+    else if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, I, cam, cameraPos, i))
       nbVisiblePolygon ++;
   }
   return nbVisiblePolygon;
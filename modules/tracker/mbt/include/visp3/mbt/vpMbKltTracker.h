@@ -46,12 +46,17 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 #include <visp3/mbt/vpMbTracker.h>
-#include <visp3/klt/vpKltOpencv.h>
+#if defined(VISP_HAVE_OPENCV)
+#  include <visp3/klt/vpKltOpencv.h>
+#else
+#  include <visp3/klt/vpKltTracker.h>
+#endif
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpRect.h>
 #include <visp3/mbt/vpMbtKltXmlParser.h>
 #include <visp3/vision/vpHomography.h>
 #include <visp3/core/vpSubColVector.h>
@@ -64,7 +69,8 @@
 /*!
   \class vpMbKltTracker
   \ingroup group_mbt_trackers
-  \warning This class is only available if OpenCV is installed, and used.
+  \warning This class is only available if the klt module is built. Without OpenCV,
+  the points are tracked with vpKltTracker instead of vpKltOpencv.
 
   \brief Model based tracker using only KLT.
 
@@ -229,11 +235,13 @@ class VISP_EXPORT vpMbKltTracker: public virtual vpMbTracker
   friend class vpMbEdgeKltMultiTracker;
 
 protected:
+#if defined(VISP_HAVE_OPENCV)
   //! Temporary OpenCV image for fast conversion.
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#  if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   cv::Mat cur;
-#else
+#  else
   IplImage *cur;
+#  endif
 #endif
   //! Initial pose.
   vpHomogeneousMatrix c0Mo;
@@ -248,7 +256,11 @@ protected:
   //! The estimated displacement of the pose between the current instant and the initial position.
   vpHomogeneousMatrix ctTc0;
   //! Points tracker.
+#if defined(VISP_HAVE_OPENCV)
   vpKltOpencv tracker;
+#else
+  vpKltTracker tracker;
+#endif
   //!
   std::list<vpMbtDistanceKltPoints*> kltPolygons;
   //!
@@ -294,9 +306,11 @@ public:
   /*!
     Get the current list of KLT points.
 
-     \return the list of KLT points through vpKltOpencv.
+     \return the list of KLT points through vpKltOpencv, or vpKltTracker without OpenCV.
    */
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+  inline  std::vector<vpImagePoint> getKltPoints() const {return tracker.getFeatures();}
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   inline  std::vector<cv::Point2f> getKltPoints() const {return tracker.getFeatures();}
 #else
   inline  CvPoint2D32f*   getKltPoints() {return tracker.getFeatures();}
@@ -306,12 +320,21 @@ public:
 
   std::map<int, vpImagePoint> getKltImagePointsWithId() const;
 
+#if defined(VISP_HAVE_OPENCV)
   /*!
     Get the klt tracker at the current state.
 
     \return klt tracker.
    */
   inline  vpKltOpencv getKltOpencv() const { return tracker; }
+#else
+  /*!
+    Get the klt tracker at the current state.
+
+    \return klt tracker.
+   */
+  inline  vpKltTracker getKltTracker() const { return tracker; }
+#endif
 
   /*!
     Get the erosion of the mask used on the Model faces.
@@ -366,7 +389,11 @@ public:
     faces.getMbScanLineRenderer().setMaskBorder(maskBorder);
   }
 
+#if defined(VISP_HAVE_OPENCV)
   virtual void setKltOpencv(const vpKltOpencv& t);
+#else
+  virtual void setKltTracker(const vpKltTracker& t);
+#endif
 
   /*!
     Set the threshold for the acceptation of a point.
@@ -483,6 +510,7 @@ protected:
                             const std::string &name="");
 
   void preTracking(const vpImage<unsigned char> &I);
+  void preTracking(const vpImage<unsigned char> &I, const vpRect &roi);
   bool postTracking(const vpImage<unsigned char>& I, vpColVector &w);
   virtual void reinit(const vpImage<unsigned char>& I);
   //@}
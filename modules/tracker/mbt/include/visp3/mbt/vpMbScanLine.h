@@ -126,6 +126,11 @@ public:
     {
       return a.first < b.first;
     }
+
+    inline bool operator()(const std::pair<double, const vpMbScanLineSegment *> &a, const std::pair<double, const vpMbScanLineSegment *> &b) const
+    {
+      return a.first < b.first;
+    }
   };
 
 private:
@@ -136,6 +141,11 @@ private:
   vpImage<int>            primitive_ids;
   std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator> visibility_samples;
   double                  depthTreshold;
+  // Buffers kept between two calls to drawScene() to avoid reallocating them
+  std::vector<std::vector<vpMbScanLineSegment> > scanlinesX, scanlinesY, localScanlines;
+  vpImage<unsigned char>  maskX, maskY;
+  // Area of the images written by the last call to drawScene(), rows [top, bottom[ and columns [left, right[
+  unsigned int            drawnTop, drawnBottom, drawnLeft, drawnRight;
 
 public:
 #if defined(DEBUG_DISP)
@@ -181,6 +191,13 @@ private:
                                  std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
                                  const unsigned int &size);
 
+  void drawScanLines(const bool rows);
+
+  bool drawScanLine(std::vector<vpMbScanLineSegment> &scanline, const unsigned int index, const bool row,
+                    std::vector<std::pair<double, const vpMbScanLineSegment *> > &stack,
+                    std::vector<std::pair<const vpMbScanLineSegment *, int> > &samples,
+                    unsigned int &first, unsigned int &last);
+
   void drawLineY(const vpColVector &a,
                  const vpColVector &b,
                  const vpMbScanLineEdge &line_ID,
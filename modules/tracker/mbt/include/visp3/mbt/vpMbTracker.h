@@ -66,6 +66,7 @@
 #include <visp3/core/vpPoint.h>
 #include <visp3/mbt/vpMbtPolygon.h>
 #include <visp3/mbt/vpMbHiddenFaces.h>
+#include <visp3/mbt/vpMbtModelCache.h>
 #include <visp3/core/vpPolygon.h>
 #include <visp3/core/vpRobust.h>
 
@@ -187,6 +188,10 @@ protected:
   double m_stopCriteriaEpsilon;
   //! Initial Mu for Levenberg Marquardt optimization loop
   double m_initialMu;
+  //! Directory of the binary model cache files, no cache is used if empty
+  std::string m_modelCacheDirectory;
+  //! Cache filled with the primitives of the model being parsed, NULL if the model is not recorded
+  vpMbtModelCache *m_modelCacheRecorder;
 
 public:
   vpMbTracker();
@@ -251,6 +256,13 @@ public:
    */
   virtual inline unsigned int getMaxIter() const {return m_maxIter;}
 
+  /*!
+    Get the directory of the binary model cache files.
+
+    \sa setModelCacheDirectory()
+  */
+  virtual inline std::string getModelCacheDirectory() const { return m_modelCacheDirectory; }
+
   /*!
     Get the error angle between the gradient direction of the model features projected at the resulting pose and their normal.
     The error is expressed in degree between 0 and 90. This value is computed if setProjectionErrorComputation() is turned on.
@@ -476,6 +488,8 @@ public:
 
   virtual void setMinLineLengthThresh(const double minLineLengthThresh, const std::string &name="");
 
+  virtual void setModelCacheDirectory(const std::string &directory);
+
   virtual void setMinPolygonAreaThresh(const double minPolygonAreaThresh, const std::string &name="");
 
   virtual void setNearClippingDistance(const double &dist);
@@ -663,6 +677,9 @@ protected:
   virtual void computeVVSInteractionMatrixAndResidu()=0;
   virtual void computeVVSPoseEstimation(const bool isoJoIdentity_, const unsigned int iter, vpMatrix &L, vpMatrix &LTL, vpColVector &R, const vpColVector &error,
                                         vpColVector &error_prev, vpColVector &LTR, double &mu, vpColVector &v, const vpColVector * const w=NULL, vpColVector * const m_w_prev=NULL);
+  void computeVVSPoseEstimation(const bool isoJoIdentity_, const unsigned int iter, const vpMatrix &LTL, const vpColVector &LTR, const vpColVector &error,
+                                vpColVector &error_prev, double &mu, vpColVector &v, const vpColVector * const w=NULL, vpColVector * const m_w_prev=NULL);
+  void computeVVSNormalEquations(const vpMatrix &L, const vpColVector &w, const vpColVector &weightedError, vpMatrix &LTL, vpColVector &LTR) const;
   virtual void computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w);
 
 #ifdef VISP_HAVE_COIN3D
@@ -714,6 +731,10 @@ protected:
   virtual void initFaceFromCorners(vpMbtPolygon &polygon)=0;
   virtual void initFaceFromLines(vpMbtPolygon &polygon)=0;
 
+  void addModelPrimitive(const vpMbtModelCache::vpMbtPrimitive &primitive, const int idFaceOffset=0);
+  std::string getModelCacheFilename(const std::string &modelFile) const;
+  bool loadModelFromCache(const std::string &modelFile, const bool caoModel, const bool verbose);
+
   virtual void loadVRMLModel(const std::string& modelFile);
   virtual void loadCAOModel(const std::string& modelFile, std::vector<std::string>& vectorOfModelFilename, int& startIdFace,
                             const bool verbose=false, const bool parent=true);
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bounding volume hierarchy over the polygons of a CAD model.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtBoundingVolumeHierarchy.h
+ \brief Bounding volume hierarchy over the polygons of a CAD model.
+*/
+
+#ifndef vpMbtBoundingVolumeHierarchy_HH
+#define vpMbtBoundingVolumeHierarchy_HH
+
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/mbt/vpMbtPolygon.h>
+
+/*!
+  \class vpMbtBoundingVolumeHierarchy
+
+  \brief Bounding volume hierarchy over the polygons of a CAD model, used by
+  vpMbHiddenFaces to classify whole groups of polygons at once.
+
+  Each node stores, in the object frame, the axis-aligned bounding box of the
+  vertices of its polygons, a sphere bounding their centroids and a cone
+  bounding their normals. For a given pose, the hierarchy gives:
+  - the polygons that are back-facing for a given angle, see cullBackFaces(),
+  - the polygons that lie entirely outside a clipping plane of the camera
+  frustum, see cullFrustum().
+
+  Both tests are conservative: a polygon is reported only when the per-polygon
+  tests done by vpMbtPolygon::isVisible() and vpPolygon3D::computePolygonClipped()
+  would give the same result.
+
+  \ingroup group_mbt_faces
+*/
+class VISP_EXPORT vpMbtBoundingVolumeHierarchy
+{
+public:
+  vpMbtBoundingVolumeHierarchy();
+
+  void build(const std::vector<vpMbtPolygon *> &polygons);
+
+  void clear();
+
+  void cullBackFaces(const vpHomogeneousMatrix &cMo, const double angle, std::vector<bool> &culled) const;
+  void cullFrustum(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, const double nearClippingDistance,
+                   const double farClippingDistance, std::vector<unsigned int> &outside) const;
+
+  /*! Return the number of nodes of the hierarchy. */
+  inline unsigned int getNbNodes() const { return (unsigned int)m_nodes.size(); }
+  /*! Return the number of polygons the hierarchy was built from. */
+  inline unsigned int getNbPolygons() const { return (unsigned int)m_indices.size(); }
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  struct vpBvhPrimitive {
+    double bbMin[3], bbMax[3];
+    double centroid[3];
+    double normal[3];
+    //! Inverse of the number of corners
+    double invNbPoint;
+    bool oriented;
+  };
+
+  struct vpBvhNode {
+    //! Bounding box of the polygon vertices
+    double bbMin[3], bbMax[3];
+    //! Sphere bounding the polygon centroids
+    double center[3], radius;
+    //! Cone bounding the polygon normals
+    double axis[3], coneAngle;
+    //! Bounds of the inverse of the number of corners of the polygons
+    double invNbPointMin, invNbPointMax;
+    //! True if all the polygons have an orientation, i.e. the normal cone is valid
+    bool oriented;
+    //! Range of the polygons of the node in m_indices
+    unsigned int first, last;
+    //! Index of the children nodes, -1 for a leaf
+    int left, right;
+  };
+#endif
+
+  int buildNode(const std::vector<vpBvhPrimitive> &primitives, std::vector<double> &keys, const unsigned int first,
+                const unsigned int last);
+
+  //! Nodes of the hierarchy, the root is the first one
+  std::vector<vpBvhNode> m_nodes;
+  //! Polygon indices, ordered such that the polygons of each node are contiguous
+  std::vector<unsigned int> m_indices;
+  //! Diagonal of the bounding box of the centroids of the model
+  double m_centroidsDiagonal;
+};
+
+#endif
@@ -41,12 +41,16 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 #include <map>
 
 #include <visp3/core/vpPolygon3D.h>
-#include <visp3/klt/vpKltOpencv.h>
+#if defined(VISP_HAVE_OPENCV)
+#  include <visp3/klt/vpKltOpencv.h>
+#else
+#  include <visp3/klt/vpKltTracker.h>
+#endif
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpGEMM.h>
@@ -60,7 +64,8 @@
 
   \brief Implementation of a polygon of the model containing points of interest. It is used by the model-based tracker KLT, and hybrid.
 
-  \warning This class is only available if OpenCV is installed, and used.
+  \warning This class is only available if the klt module is built. Without OpenCV,
+  the points are tracked with vpKltTracker instead of vpKltOpencv.
 
   \ingroup group_mbt_features
 */
@@ -134,7 +139,11 @@ public:
 
   void                buildFrom(const vpPoint &p1, const vpPoint &p2, const double &r);
 
+#if defined(VISP_HAVE_OPENCV)
   unsigned int        computeNbDetectedCurrent(const vpKltOpencv& _tracker);
+#else
+  unsigned int        computeNbDetectedCurrent(const vpKltTracker& _tracker);
+#endif
   void                computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMc0, vpColVector& _R, vpMatrix& _J);
 
   void                display(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, const vpColor &col, const unsigned int thickness = 1, const bool displayFullModel = false);
@@ -187,7 +196,11 @@ public:
   */
   inline  bool        isTracked() const {return isTrackedKltCylinder;}
 
+#if defined(VISP_HAVE_OPENCV)
   void                init(const vpKltOpencv& _tracker, const vpHomogeneousMatrix &cMo);
+#else
+  void                init(const vpKltTracker& _tracker, const vpHomogeneousMatrix &cMo);
+#endif
 
   void                removeOutliers(const vpColVector& weight, const double &threshold_outlier);
 
@@ -205,7 +218,9 @@ public:
   */
   inline void         setTracked(const bool& track) {this->isTrackedKltCylinder = track;}
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+  void updateMask(vpImage<unsigned char> &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   void updateMask(cv::Mat &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
 #else
   void updateMask(IplImage* mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
@@ -42,12 +42,16 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 #include <map>
 
 #include <visp3/core/vpPolygon3D.h>
-#include <visp3/klt/vpKltOpencv.h>
+#if defined(VISP_HAVE_OPENCV)
+#  include <visp3/klt/vpKltOpencv.h>
+#else
+#  include <visp3/klt/vpKltTracker.h>
+#endif
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpGEMM.h>
@@ -59,7 +63,8 @@
 
   \brief Implementation of a polygon of the model containing points of interest. It is used by the model-based tracker KLT, and hybrid.
 
-  \warning This class is only available if OpenCV is installed, and used.
+  \warning This class is only available if the klt module is built. Without OpenCV,
+  the points are tracked with vpKltTracker instead of vpKltOpencv.
 
   \ingroup group_mbt_features
 */
@@ -132,7 +137,11 @@ public:
                       vpMbtDistanceKltPoints();
   virtual             ~vpMbtDistanceKltPoints();
 
+#if defined(VISP_HAVE_OPENCV)
   unsigned int        computeNbDetectedCurrent(const vpKltOpencv& _tracker);
+#else
+  unsigned int        computeNbDetectedCurrent(const vpKltTracker& _tracker);
+#endif
   void                computeHomography(const vpHomogeneousMatrix& _cTc0, vpHomography& cHc0);
   void                computeInteractionMatrixAndResidu(vpColVector& _R, vpMatrix& _J);
 
@@ -177,7 +186,11 @@ public:
 
   inline  bool        hasEnoughPoints() const {return enoughPoints;}
 
+#if defined(VISP_HAVE_OPENCV)
           void        init(const vpKltOpencv& _tracker);
+#else
+          void        init(const vpKltTracker& _tracker);
+#endif
 
   /*!
    Return if the klt points are used for tracking.
@@ -202,7 +215,9 @@ public:
   */
   inline void setTracked(const bool& track) {this->isTrackedKltPoints = track;}
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+  void updateMask(vpImage<unsigned char> &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   void updateMask(cv::Mat &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
 #else
   void updateMask(IplImage* mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
@@ -45,6 +45,7 @@
 #endif
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 
@@ -97,6 +98,12 @@ public:
                               , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
                             #endif
                               );
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                              const vpPointCloud &point_cloud, const unsigned int stepX, const unsigned int stepY
+                            #if DEBUG_DISPLAY_DEPTH_DENSE
+                              , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                            #endif
+                              );
 
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &error);
 
@@ -208,6 +215,14 @@ protected:
 
 
 protected:
+  template<class PointCloud>
+  bool computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                  const PointCloud &point_cloud, const unsigned int stepX, const unsigned int stepY
+                                #if DEBUG_DISPLAY_DEPTH_DENSE
+                                  , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                #endif
+                                  );
+
   void computeROI(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height, std::vector<vpImagePoint> &roiPts
                 #if DEBUG_DISPLAY_DEPTH_DENSE
                   , std::vector<std::vector<vpImagePoint> > &roiPts_vec
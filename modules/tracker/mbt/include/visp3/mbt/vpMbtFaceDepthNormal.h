@@ -45,6 +45,7 @@
 #endif
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 
@@ -105,6 +106,13 @@ public:
                               , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
                             #endif
                               );
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                              const vpPointCloud &point_cloud, vpColVector &desired_features,
+                              const unsigned int stepX, const unsigned int stepY
+                            #if DEBUG_DISPLAY_DEPTH_NORMAL
+                              , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                            #endif
+                              );
 
   void computeInteractionMatrix(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &features);
 
@@ -263,6 +271,14 @@ protected:
   std::vector<PolygonLine> m_polygonLines;
 
 
+  template<class PointCloud>
+  bool computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                  const PointCloud &point_cloud, vpColVector &desired_features,
+                                  const unsigned int stepX, const unsigned int stepY
+                                #if DEBUG_DISPLAY_DEPTH_NORMAL
+                                  , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                #endif
+                                  );
 #ifdef VISP_HAVE_PCL
   bool computeDesiredFeaturesPCL(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud_face, vpColVector &desired_features,
                                  vpColVector &desired_normal, vpColVector &centroid_point);
@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Binary cache of a CAD model loaded by the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtModelCache.h
+ \brief Binary cache of a CAD model loaded by the model-based tracker.
+*/
+
+#ifndef vpMbtModelCache_HH
+#define vpMbtModelCache_HH
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpPoint.h>
+
+/*!
+  \class vpMbtModelCache
+
+  \brief Compiled form of a CAD model (.cao or .wrl file): the list of the
+  primitives added to the tracker when the model is parsed, with their level of
+  detail settings already resolved.
+
+  The cache is saved in a versioned binary file that also stores a hash of the
+  content of each source file (the main model and the included ones). It can be
+  loaded back to instantiate the model without parsing the text files again,
+  see vpMbTracker::setModelCacheDirectory().
+
+  \ingroup group_mbt_faces
+*/
+class VISP_EXPORT vpMbtModelCache
+{
+public:
+  typedef enum {
+    POLYGON_FROM_LINES,   //!< Face defined by its lines (initFaceFromLines()).
+    POLYGON_FROM_CORNERS, //!< Face or line defined by its corners (initFaceFromCorners()).
+    CYLINDER,             //!< Cylinder defined by two points on its axis and its radius.
+    CIRCLE                //!< Circle defined by its center, two points on its plane and its radius.
+  } vpMbtPrimitiveType;
+
+  /*!
+    A primitive of the model, as added to the tracker.
+  */
+  struct vpMbtPrimitive {
+    vpMbtPrimitive();
+
+    //! Type of the primitive
+    vpMbtPrimitiveType type;
+    //! Id of the (first) face associated to the primitive
+    int idFace;
+    //! Corners of a face, axis extremities of a cylinder or center and plane points of a circle
+    std::vector<vpPoint> points;
+    //! Radius of a cylinder or a circle
+    double radius;
+    //! Name of the primitive
+    std::string name;
+    //! True if the level of detail is used for this primitive
+    bool useLod;
+    //! Minimum polygon area threshold for the level of detail
+    double minPolygonAreaThreshold;
+    //! Minimum line length threshold for the level of detail
+    double minLineLengthThreshold;
+  };
+
+  vpMbtModelCache();
+
+  void addPrimitive(const vpMbtPrimitive &primitive);
+  void addSourceFile(const std::string &filename);
+
+  void clear();
+
+  /*! Return the number of points, lines, polygon lines, polygon points, cylinders and circles of the model. */
+  inline const std::vector<unsigned int> &getCounters() const { return m_counters; }
+  /*! Return the id of the first face when the model was recorded. */
+  inline int getFirstIdFace() const { return m_firstIdFace; }
+  /*! Return the primitives in the order they were added. */
+  inline const std::vector<vpMbtPrimitive> &getPrimitives() const { return m_primitives; }
+  /*! Return the files the model was loaded from. */
+  inline const std::vector<std::string> &getSourceFiles() const { return m_sourceFiles; }
+
+  static uint64_t hashFile(const std::string &filename);
+  static uint64_t hashString(const std::string &str);
+
+  bool isUpToDate() const;
+
+  bool load(const std::string &filename);
+
+  bool matchLodSettings(const bool useLod, const bool applyLodSettingInConfig, const double minLineLengthThreshold,
+                        const double minPolygonAreaThreshold) const;
+
+  void save(const std::string &filename) const;
+
+  void setCounters(const unsigned int nbPoints, const unsigned int nbLines, const unsigned int nbPolygonLines,
+                   const unsigned int nbPolygonPoints, const unsigned int nbCylinders, const unsigned int nbCircles);
+  /*!
+    Set the id of the first face of the model. The faces of a cached model keep
+    their relative order when the model is instantiated after other faces.
+  */
+  inline void setFirstIdFace(const int idFace) { m_firstIdFace = idFace; }
+  void setLodSettings(const bool useLod, const bool applyLodSettingInConfig, const double minLineLengthThreshold,
+                      const double minPolygonAreaThreshold);
+
+private:
+  //! Number of points, lines, polygon lines, polygon points, cylinders and circles
+  std::vector<unsigned int> m_counters;
+  //! Id of the first face when the model was recorded
+  int m_firstIdFace;
+  //! General LOD settings used to resolve the default values of the primitives
+  bool m_useLod;
+  bool m_applyLodSettingInConfig;
+  double m_minLineLengthThreshold;
+  double m_minPolygonAreaThreshold;
+  //! Primitives of the model
+  std::vector<vpMbtPrimitive> m_primitives;
+  //! Files the model was loaded from
+  std::vector<std::string> m_sourceFiles;
+  //! Hash of the content of each source file
+  std::vector<uint64_t> m_sourceHashes;
+};
+
+#endif
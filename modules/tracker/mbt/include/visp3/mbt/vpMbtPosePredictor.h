@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Prediction of the pose of the object for the next image.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtPosePredictor.h
+ \brief Prediction of the pose of the object for the next image.
+*/
+
+#ifndef vpMbtPosePredictor_HH
+#define vpMbtPosePredictor_HH
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpLinearKalmanFilterInstantiation.h>
+
+/*!
+  \class vpMbtPosePredictor
+
+  \brief Predict the pose of the object in the next image from the poses
+  estimated in the previous images, assuming a constant velocity.
+
+  The velocity twist \f$ \bf v \f$ between the two last poses is given by the
+  inverse exponential map, such that
+  \f$ {^c}{\bf M}_o(t_k) = \exp({\bf v} (t_k - t_{k-1})) \; {^c}{\bf M}_o(t_{k-1}) \f$.
+  The predicted pose is then
+  \f$ {^c}{\bf M}_o(t) = \exp({\bf v} (t - t_k)) \; {^c}{\bf M}_o(t_k) \f$.
+
+  With the vpMbtPosePredictor::KALMAN_PREDICTION type, the measured velocities
+  are filtered by a vpLinearKalmanFilterInstantiation using a constant velocity
+  model with colored noise, which is less sensitive to the noise of the pose
+  estimation.
+
+  \ingroup group_mbt_trackers
+*/
+class VISP_EXPORT vpMbtPosePredictor
+{
+public:
+  typedef enum {
+    NO_PREDICTION,                /*!< The predicted pose is the last pose. */
+    CONSTANT_VELOCITY_PREDICTION, /*!< The velocity between the two last poses is used. */
+    KALMAN_PREDICTION             /*!< The velocity is filtered by a Kalman filter. */
+  } vpPredictionType;
+
+  explicit vpMbtPosePredictor(const vpPredictionType type = NO_PREDICTION);
+
+  /*! Return the timestamp of the last pose given to update(). */
+  inline double getLastTimestamp() const { return m_timestamp; }
+  /*! Return the type of prediction. */
+  inline vpPredictionType getPredictionType() const { return m_type; }
+  /*! Return the estimated velocity twist, null until two poses have been given to update(). */
+  inline vpColVector getVelocity() const { return m_velocity; }
+
+  bool predict(const vpHomogeneousMatrix &cMo, const double timestamp, vpHomogeneousMatrix &cMo_pred);
+
+  void reset();
+
+  void setKalmanParameters(const double sigmaAcceleration, const double sigmaVelocity, const double rho);
+  void setPredictionType(const vpPredictionType type);
+
+  void update(const vpHomogeneousMatrix &cMo, const double timestamp);
+
+private:
+  //! Type of prediction
+  vpPredictionType m_type;
+  //! Last pose given to update()
+  vpHomogeneousMatrix m_cMo;
+  //! Timestamp of m_cMo
+  double m_timestamp;
+  //! Number of poses given to update() since the last reset, up to 2
+  unsigned int m_nbPoses;
+  //! Estimated velocity twist
+  vpColVector m_velocity;
+  //! Filter of the velocity for the KALMAN_PREDICTION type
+  vpLinearKalmanFilterInstantiation m_kalman;
+  //! Variance of the acceleration noise of the Kalman filter
+  double m_sigmaAcceleration;
+  //! Variance of the velocity measurement noise of the Kalman filter
+  double m_sigmaVelocity;
+  //! Correlation between successive accelerations of the Kalman filter
+  double m_rho;
+};
+
+#endif
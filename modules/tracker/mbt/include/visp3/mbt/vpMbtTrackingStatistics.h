@@ -0,0 +1,163 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Timings and counters of the model-based trackers.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtTrackingStatistics.h
+ \brief Timings and counters of the model-based trackers.
+*/
+
+#ifndef vpMbtTrackingStatistics_HH
+#define vpMbtTrackingStatistics_HH
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpMbtTrackingStatistics
+
+  \brief Rolling statistics of the duration of the tracking stages and of
+  counters (number of features, of iterations...) of a model-based tracker.
+
+  Each quantity is identified by a name and a scope: the name of a camera for
+  the quantities measured by one camera, or an empty scope for the quantities
+  of the whole tracker. The statistics (mean, extrema, percentiles and
+  histogram) are computed over the last values, see setWindowSize(), while
+  the total number of values is kept since the last call to clear().
+
+  The statistics can be written in the JSON format with writeJson() or
+  saveJson().
+
+  \sa vpMbGenericTracker::setUseTrackingStatistics()
+
+  \ingroup group_mbt_trackers
+*/
+class VISP_EXPORT vpMbtTrackingStatistics
+{
+public:
+  /*!
+    \class vpRollingStatistic
+
+    \brief Statistics of the last values of a quantity.
+  */
+  class VISP_EXPORT vpRollingStatistic
+  {
+  public:
+    explicit vpRollingStatistic(const unsigned int windowSize = 100);
+
+    void add(const double value);
+
+    /*! Return the number of values given to add(). */
+    inline unsigned long getCount() const { return m_count; }
+    void getHistogram(const unsigned int nbBins, std::vector<unsigned int> &histogram, double &lower,
+                      double &upper) const;
+    double getLast() const;
+    double getMax() const;
+    double getMean() const;
+    double getMin() const;
+    double getPercentile(const double percentile) const;
+    double getStdev() const;
+    /*! Return the number of values the statistics are computed from. */
+    inline unsigned int getWindowSize() const { return (unsigned int)m_values.size(); }
+
+  private:
+    //! Last values, used as a circular buffer
+    std::vector<double> m_values;
+    //! Maximum number of values in m_values
+    unsigned int m_windowSize;
+    //! Index in m_values of the next value
+    unsigned int m_next;
+    //! Number of values since the creation
+    unsigned long m_count;
+  };
+
+  /*!
+    \class vpScopedTimer
+
+    \brief Add the time in milliseconds spent in the scope of the timer to a
+    duration. Nothing is measured if the pointer to the duration is NULL.
+  */
+  class VISP_EXPORT vpScopedTimer
+  {
+  public:
+    explicit vpScopedTimer(double *duration);
+    ~vpScopedTimer();
+
+  private:
+    vpScopedTimer(const vpScopedTimer &);
+    vpScopedTimer &operator=(const vpScopedTimer &);
+
+    double *m_duration;
+    double m_start;
+  };
+
+  explicit vpMbtTrackingStatistics(const unsigned int windowSize = 100);
+
+  void addCounter(const std::string &scope, const std::string &name, const double value);
+  void addTiming(const std::string &scope, const std::string &name, const double duration);
+
+  void clear();
+
+  const vpRollingStatistic &getCounter(const std::string &scope, const std::string &name) const;
+  std::vector<std::string> getCounterNames(const std::string &scope) const;
+  std::vector<std::string> getScopes() const;
+  const vpRollingStatistic &getTiming(const std::string &scope, const std::string &name) const;
+  std::vector<std::string> getTimingNames(const std::string &scope) const;
+  /*! Return the number of values the statistics are computed from. */
+  inline unsigned int getWindowSize() const { return m_windowSize; }
+
+  bool hasCounter(const std::string &scope, const std::string &name) const;
+  bool hasTiming(const std::string &scope, const std::string &name) const;
+
+  void saveJson(const std::string &filename) const;
+  void setWindowSize(const unsigned int windowSize);
+
+  void writeJson(std::ostream &os) const;
+
+private:
+  typedef std::map<std::string, vpRollingStatistic> vpStatisticMap;
+
+  //! Durations in milliseconds, for each scope
+  std::map<std::string, vpStatisticMap> m_timings;
+  //! Counters, for each scope
+  std::map<std::string, vpStatisticMap> m_counters;
+  //! Number of values the statistics are computed from
+  unsigned int m_windowSize;
+};
+
+#endif
@@ -54,7 +54,7 @@
 
 
 vpMbDepthDenseTracker::vpMbDepthDenseTracker() :
-  m_depthDenseHiddenFacesDisplay(), m_depthDenseI_dummyVisibility(), m_depthDenseListOfActiveFaces(),
+  m_depthDenseHiddenFacesDisplay(), m_depthDenseHiddenFacesDisplayOutdated(false), m_depthDenseI_dummyVisibility(), m_depthDenseListOfActiveFaces(),
   m_denseDepthNbFeatures(0), m_depthDenseNormalFaces(), m_depthDenseSamplingStepX(2), m_depthDenseSamplingStepY(2),
   m_error_depthDense(), m_L_depthDense(), m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense()
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -87,8 +87,8 @@ void vpMbDepthDenseTracker::addFace(vpMbtPolygon &polygon, const bool alreadyClo
     return;
   }
 
-  //Copy hidden faces
-  m_depthDenseHiddenFacesDisplay = faces;
+  //The hidden faces are copied once before being displayed, not each time a face is added
+  m_depthDenseHiddenFacesDisplayOutdated = true;
 
   vpMbtFaceDepthDense *normal_face = new vpMbtFaceDepthDense;
   normal_face->m_hiddenFace = &faces;
@@ -277,6 +277,10 @@ void vpMbDepthDenseTracker::display(const vpImage<unsigned char> &I, const vpHom
   vpCameraParameters c = cam_;
 
   bool changed = false;
+  if (m_depthDenseHiddenFacesDisplayOutdated) {
+    m_depthDenseHiddenFacesDisplay = faces;
+    m_depthDenseHiddenFacesDisplayOutdated = false;
+  }
   m_depthDenseHiddenFacesDisplay.setVisible(I, c, cMo_,  angleAppears, angleDisappears, changed);
 
   if (useScanLine) {
@@ -303,6 +307,10 @@ void vpMbDepthDenseTracker::display(const vpImage<vpRGBa> &I, const vpHomogeneou
   bool changed = false;
   vpImage<unsigned char> I_dummy;
   vpImageConvert::convert(I, I_dummy);
+  if (m_depthDenseHiddenFacesDisplayOutdated) {
+    m_depthDenseHiddenFacesDisplay = faces;
+    m_depthDenseHiddenFacesDisplayOutdated = false;
+  }
   m_depthDenseHiddenFacesDisplay.setVisible(I_dummy, c, cMo_,  angleAppears, angleDisappears, changed);
 
   if (useScanLine) {
@@ -535,7 +543,8 @@ void vpMbDepthDenseTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointXY
 }
 #endif
 
-void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height) {
+template<class PointCloud>
+void vpMbDepthDenseTracker::segmentPointCloudImpl(const PointCloud &point_cloud, const unsigned int width, const unsigned int height) {
   m_depthDenseListOfActiveFaces.clear();
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -586,6 +595,19 @@ void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &po
 #endif
 }
 
+void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height) {
+  segmentPointCloudImpl(point_cloud, width, height);
+}
+
+void vpMbDepthDenseTracker::segmentPointCloud(const vpPointCloud &point_cloud) {
+  segmentPointCloudImpl(point_cloud, point_cloud.getWidth(), point_cloud.getHeight());
+}
+
+// Also used by vpMbGenericTracker::TrackerWrapper
+template void vpMbDepthDenseTracker::segmentPointCloudImpl<std::vector<vpColVector> >(const std::vector<vpColVector> &,
+    const unsigned int, const unsigned int);
+template void vpMbDepthDenseTracker::segmentPointCloudImpl<vpPointCloud>(const vpPointCloud &, const unsigned int, const unsigned int);
+
 void vpMbDepthDenseTracker::setCameraParameters(const vpCameraParameters &camera) {
   this->cam = camera;
 
@@ -645,6 +667,19 @@ void vpMbDepthDenseTracker::track(const std::vector<vpColVector> &point_cloud, c
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object in an organized point cloud.
+
+  \param point_cloud : Point cloud whose size is the size of the depth image. The invalid points are not used.
+*/
+void vpMbDepthDenseTracker::track(const vpPointCloud &point_cloud) {
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthDenseTracker::initCircle(const vpPoint& /*p1*/, const vpPoint &/*p2*/, const vpPoint &/*p3*/, const double /*radius*/,
                                        const int /*idFace*/, const std::string &/*name*/) {
   throw vpException(vpException::fatalError, "vpMbDepthDenseTracker::initCircle() should not be called!");
@@ -55,7 +55,7 @@
 
 vpMbDepthNormalTracker::vpMbDepthNormalTracker() :
   m_depthNormalFeatureEstimationMethod(vpMbtFaceDepthNormal::ROBUST_FEATURE_ESTIMATION),
-  m_depthNormalHiddenFacesDisplay(), m_depthNormalI_dummyVisibility(), m_depthNormalListOfActiveFaces(), m_depthNormalListOfDesiredFeatures(),
+  m_depthNormalHiddenFacesDisplay(), m_depthNormalHiddenFacesDisplayOutdated(false), m_depthNormalI_dummyVisibility(), m_depthNormalListOfActiveFaces(), m_depthNormalListOfDesiredFeatures(),
   m_depthNormalFaces(), m_depthNormalPclPlaneEstimationMethod(2), m_depthNormalPclPlaneEstimationRansacMaxIter(200), m_depthNormalPclPlaneEstimationRansacThreshold(0.001),
   m_depthNormalSamplingStepX(2), m_depthNormalSamplingStepY(2), m_depthNormalUseRobust(false),
   m_error_depthNormal(), m_L_depthNormal(), m_robust_depthNormal(), m_w_depthNormal(), m_weightedError_depthNormal()
@@ -85,8 +85,8 @@ void vpMbDepthNormalTracker::addFace(vpMbtPolygon &polygon, const bool alreadyCl
     return;
   }
 
-  //Copy hidden faces
-  m_depthNormalHiddenFacesDisplay = faces;
+  //The hidden faces are copied once before being displayed, not each time a face is added
+  m_depthNormalHiddenFacesDisplayOutdated = true;
 
   vpMbtFaceDepthNormal *normal_face = new vpMbtFaceDepthNormal;
   normal_face->m_hiddenFace = &faces;
@@ -275,6 +275,10 @@ void vpMbDepthNormalTracker::display(const vpImage<unsigned char> &I, const vpHo
   vpCameraParameters c = cam_;
 
   bool changed = false;
+  if (m_depthNormalHiddenFacesDisplayOutdated) {
+    m_depthNormalHiddenFacesDisplay = faces;
+    m_depthNormalHiddenFacesDisplayOutdated = false;
+  }
   m_depthNormalHiddenFacesDisplay.setVisible(I, c, cMo_,  angleAppears, angleDisappears, changed);
 
   if (useScanLine) {
@@ -301,6 +305,10 @@ void vpMbDepthNormalTracker::display(const vpImage<vpRGBa> &I, const vpHomogeneo
   bool changed = false;
   vpImage<unsigned char> I_dummy;
   vpImageConvert::convert(I, I_dummy);
+  if (m_depthNormalHiddenFacesDisplayOutdated) {
+    m_depthNormalHiddenFacesDisplay = faces;
+    m_depthNormalHiddenFacesDisplayOutdated = false;
+  }
   m_depthNormalHiddenFacesDisplay.setVisible(I_dummy, c, cMo_,  angleAppears, angleDisappears, changed);
 
   if (useScanLine) {
@@ -545,7 +553,8 @@ void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointX
 }
 #endif
 
-void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height) {
+template<class PointCloud>
+void vpMbDepthNormalTracker::segmentPointCloudImpl(const PointCloud &point_cloud, const unsigned int width, const unsigned int height) {
   m_depthNormalListOfActiveFaces.clear();
   m_depthNormalListOfDesiredFeatures.clear();
 
@@ -601,6 +610,19 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
 #endif
 }
 
+void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height) {
+  segmentPointCloudImpl(point_cloud, width, height);
+}
+
+void vpMbDepthNormalTracker::segmentPointCloud(const vpPointCloud &point_cloud) {
+  segmentPointCloudImpl(point_cloud, point_cloud.getWidth(), point_cloud.getHeight());
+}
+
+// Also used by vpMbGenericTracker::TrackerWrapper
+template void vpMbDepthNormalTracker::segmentPointCloudImpl<std::vector<vpColVector> >(const std::vector<vpColVector> &,
+    const unsigned int, const unsigned int);
+template void vpMbDepthNormalTracker::segmentPointCloudImpl<vpPointCloud>(const vpPointCloud &, const unsigned int, const unsigned int);
+
 void vpMbDepthNormalTracker::setCameraParameters(const vpCameraParameters &camera) {
   this->cam = camera;
 
@@ -683,6 +705,19 @@ void vpMbDepthNormalTracker::track(const std::vector<vpColVector> &point_cloud,
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object in an organized point cloud.
+
+  \param point_cloud : Point cloud whose size is the size of the depth image. The invalid points are not used.
+*/
+void vpMbDepthNormalTracker::track(const vpPointCloud &point_cloud) {
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthNormalTracker::initCircle(const vpPoint& /*p1*/, const vpPoint &/*p2*/, const vpPoint &/*p3*/, const double /*radius*/,
                               const int /*idFace*/, const std::string &/*name*/) {
   throw vpException(vpException::fatalError, "vpMbDepthNormalTracker::initCircle() should not be called!");
@@ -48,6 +48,40 @@
 #  define USE_SSE 0
 #endif
 
+namespace {
+  // A point of the cloud is used when its depth is positive
+  inline bool isValidPoint(const std::vector<vpColVector> &point_cloud, const unsigned int index)
+  {
+    return point_cloud[index][2] > 0;
+  }
+
+  inline bool isValidPoint(const vpPointCloud &point_cloud, const unsigned int index)
+  {
+    return point_cloud.isValid(index);
+  }
+
+  // Columns j = left + k*stepX of [left, right) covered by the polygon on the row i
+  void getSampledSpans(const vpPolygon &polygon, const unsigned int i, const unsigned int left, const unsigned int right,
+                       const unsigned int stepX, std::vector<double> &intersections,
+                       std::vector<std::pair<unsigned int, unsigned int> > &spans)
+  {
+    spans.clear();
+    polygon.getScanLineIntersections(i, intersections);
+
+    for (size_t k = 0; k + 1 < intersections.size() && intersections[k] < right; k += 2) {
+      // The pixels inside the polygon are in ]intersections[k], intersections[k+1]]
+      unsigned int first = left;
+      if (intersections[k] >= left) {
+        first = left + ((unsigned int) ((intersections[k] - left) / stepX) + 1) * stepX;
+      }
+      double last = std::min((double) right, std::floor(intersections[k+1]) + 1);
+      if (last > first) {
+        spans.push_back(std::make_pair(first, (unsigned int) last));
+      }
+    }
+  }
+}
+
 
 vpMbtFaceDepthDense::vpMbtFaceDepthDense() :
   m_cam(), m_clippingFlag(vpPolygon3D::NO_CLIPPING), m_distFarClip(100), m_distNearClip(0.001), m_hiddenFace(NULL),
@@ -196,46 +230,53 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 #endif
 
   int totalTheoreticalPoints = 0, totalPoints = 0;
+  std::vector<double> intersections;
+  std::vector<std::pair<unsigned int, unsigned int> > spans(1, std::make_pair(left, right));
   for (unsigned int i = top; i < bottom; i+=stepY) {
-    for (unsigned int j = left; j < right; j+=stepX) {
-      if ( ( m_useScanLine ?
-             (i <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-              j <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-              m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-             : polygon_2d.isInside(vpImagePoint(i,j)) ) ) {
-        totalTheoreticalPoints++;
-
-        if (pcl::isFinite((*point_cloud)(j,i)) && (*point_cloud)(j,i).z > 0) {
-          totalPoints++;
-
-          if (checkSSE2) {
+    if (!m_useScanLine) {
+      getSampledSpans(polygon_2d, i, left, right, stepX, intersections, spans);
+    }
+
+    for (size_t k = 0; k < spans.size(); k++) {
+      for (unsigned int j = spans[k].first; j < spans[k].second; j+=stepX) {
+        if ( ( !m_useScanLine ||
+               (i <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
+                j <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
+                m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex()) ) ) {
+          totalTheoreticalPoints++;
+
+          if (pcl::isFinite((*point_cloud)(j,i)) && (*point_cloud)(j,i).z > 0) {
+            totalPoints++;
+
+            if (checkSSE2) {
   #if USE_SSE
-            if (!push) {
-              push = true;
-              prev_x = (*point_cloud)(j,i).x;
-              prev_y = (*point_cloud)(j,i).y;
-              prev_z = (*point_cloud)(j,i).z;
+              if (!push) {
+                push = true;
+                prev_x = (*point_cloud)(j,i).x;
+                prev_y = (*point_cloud)(j,i).y;
+                prev_z = (*point_cloud)(j,i).z;
+              } else {
+                push = false;
+                m_pointCloudFace.push_back(prev_x);
+                m_pointCloudFace.push_back((*point_cloud)(j,i).x);
+
+                m_pointCloudFace.push_back(prev_y);
+                m_pointCloudFace.push_back((*point_cloud)(j,i).y);
+
+                m_pointCloudFace.push_back(prev_z);
+                m_pointCloudFace.push_back((*point_cloud)(j,i).z);
+              }
+  #endif
             } else {
-              push = false;
-              m_pointCloudFace.push_back(prev_x);
               m_pointCloudFace.push_back((*point_cloud)(j,i).x);
-
-              m_pointCloudFace.push_back(prev_y);
               m_pointCloudFace.push_back((*point_cloud)(j,i).y);
-
-              m_pointCloudFace.push_back(prev_z);
               m_pointCloudFace.push_back((*point_cloud)(j,i).z);
             }
-  #endif
-          } else {
-            m_pointCloudFace.push_back((*point_cloud)(j,i).x);
-            m_pointCloudFace.push_back((*point_cloud)(j,i).y);
-            m_pointCloudFace.push_back((*point_cloud)(j,i).z);
-          }
 
   #if DEBUG_DISPLAY_DEPTH_DENSE
-          debugImage[i][j] = 255;
+            debugImage[i][j] = 255;
   #endif
+          }
         }
       }
     }
@@ -259,12 +300,13 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 }
 #endif
 
-bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
-                                                 const std::vector<vpColVector> &point_cloud, const unsigned int stepX, const unsigned int stepY
-                                               #if DEBUG_DISPLAY_DEPTH_DENSE
-                                                  , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
-                                               #endif
-                                                 ) {
+template<class PointCloud>
+bool vpMbtFaceDepthDense::computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                                     const PointCloud &point_cloud, const unsigned int stepX, const unsigned int stepY
+                                                   #if DEBUG_DISPLAY_DEPTH_DENSE
+                                                      , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                   #endif
+                                                     ) {
   m_pointCloudFace.clear();
 
   if (width == 0 || height == 0)
@@ -315,46 +357,53 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 #endif
 
   int totalTheoreticalPoints = 0, totalPoints = 0;
+  std::vector<double> intersections;
+  std::vector<std::pair<unsigned int, unsigned int> > spans(1, std::make_pair(left, right));
   for (unsigned int i = top; i < bottom; i+=stepY) {
-    for (unsigned int j = left; j < right; j+=stepX) {
-      if ( ( m_useScanLine ?
-             (i <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-             j <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-             : polygon_2d.isInside(vpImagePoint(i,j)) ) ) {
-        totalTheoreticalPoints++;
-
-        if (point_cloud[i*width + j][2] > 0) {
-          totalPoints++;
-
-          if (checkSSE2) {
+    if (!m_useScanLine) {
+      getSampledSpans(polygon_2d, i, left, right, stepX, intersections, spans);
+    }
+
+    for (size_t k = 0; k < spans.size(); k++) {
+      for (unsigned int j = spans[k].first; j < spans[k].second; j+=stepX) {
+        if ( ( !m_useScanLine ||
+               (i <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
+               j <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
+               m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex()) ) ) {
+          totalTheoreticalPoints++;
+
+          if (isValidPoint(point_cloud, i*width + j)) {
+            totalPoints++;
+
+            if (checkSSE2) {
   #if USE_SSE
-            if (!push) {
-              push = true;
-              prev_x = point_cloud[i*width + j][0];
-              prev_y = point_cloud[i*width + j][1];
-              prev_z = point_cloud[i*width + j][2];
+              if (!push) {
+                push = true;
+                prev_x = point_cloud[i*width + j][0];
+                prev_y = point_cloud[i*width + j][1];
+                prev_z = point_cloud[i*width + j][2];
+              } else {
+                push = false;
+                m_pointCloudFace.push_back(prev_x);
+                m_pointCloudFace.push_back( point_cloud[i*width + j][0] );
+
+                m_pointCloudFace.push_back(prev_y);
+                m_pointCloudFace.push_back( point_cloud[i*width + j][1] );
+
+                m_pointCloudFace.push_back(prev_z);
+                m_pointCloudFace.push_back( point_cloud[i*width + j][2] );
+              }
+  #endif
             } else {
-              push = false;
-              m_pointCloudFace.push_back(prev_x);
               m_pointCloudFace.push_back( point_cloud[i*width + j][0] );
-
-              m_pointCloudFace.push_back(prev_y);
               m_pointCloudFace.push_back( point_cloud[i*width + j][1] );
-
-              m_pointCloudFace.push_back(prev_z);
               m_pointCloudFace.push_back( point_cloud[i*width + j][2] );
             }
-  #endif
-          } else {
-            m_pointCloudFace.push_back( point_cloud[i*width + j][0] );
-            m_pointCloudFace.push_back( point_cloud[i*width + j][1] );
-            m_pointCloudFace.push_back( point_cloud[i*width + j][2] );
-          }
 
   #if DEBUG_DISPLAY_DEPTH_DENSE
-          debugImage[i][j] = 255;
+            debugImage[i][j] = 255;
   #endif
+          }
         }
       }
     }
@@ -377,6 +426,57 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
   return true;
 }
 
+/*!
+  Select the points of the point cloud that belong to the face and that are used to compute the residuals.
+
+  \param cMo : Current pose.
+  \param width : Width of the depth image.
+  \param height : Height of the depth image.
+  \param point_cloud : Organized point cloud, the point seen by the pixel (i, j) being at index i*width+j.
+  \param stepX : Sampling step along the columns.
+  \param stepY : Sampling step along the rows.
+
+  \return true if the face has enough depth points to be tracked.
+*/
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                                 const std::vector<vpColVector> &point_cloud, const unsigned int stepX, const unsigned int stepY
+                                               #if DEBUG_DISPLAY_DEPTH_DENSE
+                                                  , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                               #endif
+                                                 ) {
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, stepX, stepY
+                                  #if DEBUG_DISPLAY_DEPTH_DENSE
+                                    , debugImage, roiPts_vec
+                                  #endif
+                                    );
+}
+
+/*!
+  Select the points of the organized point cloud that belong to the face and that are used to compute the residuals.
+  The points marked invalid in the point cloud are not used.
+
+  \param cMo : Current pose.
+  \param width : Width of the depth image, vpPointCloud::getWidth().
+  \param height : Height of the depth image, vpPointCloud::getHeight().
+  \param point_cloud : Organized point cloud.
+  \param stepX : Sampling step along the columns.
+  \param stepY : Sampling step along the rows.
+
+  \return true if the face has enough depth points to be tracked.
+*/
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                                 const vpPointCloud &point_cloud, const unsigned int stepX, const unsigned int stepY
+                                               #if DEBUG_DISPLAY_DEPTH_DENSE
+                                                  , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                               #endif
+                                                 ) {
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, stepX, stepY
+                                  #if DEBUG_DISPLAY_DEPTH_DENSE
+                                    , debugImage, roiPts_vec
+                                  #endif
+                                    );
+}
+
 void vpMbtFaceDepthDense::computeVisibility() {
   m_isVisible = m_polygon->isVisible();
 }
@@ -55,6 +55,40 @@
 #  define USE_SSE 0
 #endif
 
+namespace {
+  // A point of the cloud is used when its depth is positive
+  inline bool isValidPoint(const std::vector<vpColVector> &point_cloud, const unsigned int index)
+  {
+    return point_cloud[index][2] > 0;
+  }
+
+  inline bool isValidPoint(const vpPointCloud &point_cloud, const unsigned int index)
+  {
+    return point_cloud.isValid(index);
+  }
+
+  // Columns j = left + k*stepX of [left, right) covered by the polygon on the row i
+  void getSampledSpans(const vpPolygon &polygon, const unsigned int i, const unsigned int left, const unsigned int right,
+                       const unsigned int stepX, std::vector<double> &intersections,
+                       std::vector<std::pair<unsigned int, unsigned int> > &spans)
+  {
+    spans.clear();
+    polygon.getScanLineIntersections(i, intersections);
+
+    for (size_t k = 0; k + 1 < intersections.size() && intersections[k] < right; k += 2) {
+      // The pixels inside the polygon are in ]intersections[k], intersections[k+1]]
+      unsigned int first = left;
+      if (intersections[k] >= left) {
+        first = left + ((unsigned int) ((intersections[k] - left) / stepX) + 1) * stepX;
+      }
+      double last = std::min((double) right, std::floor(intersections[k+1]) + 1);
+      if (last > first) {
+        spans.push_back(std::make_pair(first, (unsigned int) last));
+      }
+    }
+  }
+}
+
 
 vpMbtFaceDepthNormal::vpMbtFaceDepthNormal() :
   m_cam(), m_clippingFlag(vpPolygon3D::NO_CLIPPING), m_distFarClip(100), m_distNearClip(0.001), m_hiddenFace(NULL), m_planeObject(), m_polygon(NULL), m_useScanLine(false),
@@ -204,59 +238,66 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 #endif
 
   double x = 0.0, y = 0.0;
+  std::vector<double> intersections;
+  std::vector<std::pair<unsigned int, unsigned int> > spans(1, std::make_pair(left, right));
   for (unsigned int i = top; i < bottom; i+=stepY) {
-    for (unsigned int j = left; j < right; j+=stepX) {
-      if ( pcl::isFinite((*point_cloud)(j,i)) && (*point_cloud)(j,i).z > 0
-           &&
-           ( m_useScanLine ?
-           (i <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-           j <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-           m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-           : polygon_2d.isInside(vpImagePoint(i,j)) )
-           ) {
-
-
-        if (m_featureEstimationMethod == PCL_PLANE_ESTIMATION) {
-          point_cloud_face->push_back( (*point_cloud)(j,i) );
-        } else if (m_featureEstimationMethod == ROBUST_SVD_PLANE_ESTIMATION || m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-          point_cloud_face_vec.push_back( (*point_cloud)(j,i).x );
-          point_cloud_face_vec.push_back( (*point_cloud)(j,i).y );
-          point_cloud_face_vec.push_back( (*point_cloud)(j,i).z );
-
-          if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-            //Add point for custom method for plane equation estimation
-            vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
+    if (!m_useScanLine) {
+      getSampledSpans(polygon_2d, i, left, right, stepX, intersections, spans);
+    }
 
-            if (checkSSE2) {
+    for (size_t k = 0; k < spans.size(); k++) {
+      for (unsigned int j = spans[k].first; j < spans[k].second; j+=stepX) {
+        if ( pcl::isFinite((*point_cloud)(j,i)) && (*point_cloud)(j,i).z > 0
+             &&
+             ( !m_useScanLine ||
+             (i <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
+             j <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
+             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex()) )
+             ) {
+
+
+          if (m_featureEstimationMethod == PCL_PLANE_ESTIMATION) {
+            point_cloud_face->push_back( (*point_cloud)(j,i) );
+          } else if (m_featureEstimationMethod == ROBUST_SVD_PLANE_ESTIMATION || m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
+            point_cloud_face_vec.push_back( (*point_cloud)(j,i).x );
+            point_cloud_face_vec.push_back( (*point_cloud)(j,i).y );
+            point_cloud_face_vec.push_back( (*point_cloud)(j,i).z );
+
+            if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
+              //Add point for custom method for plane equation estimation
+              vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
+
+              if (checkSSE2) {
 #if USE_SSE
-              if (!push) {
-                push = true;
-                prev_x = x;
-                prev_y = y;
-                prev_z = (*point_cloud)(j,i).z;
+                if (!push) {
+                  push = true;
+                  prev_x = x;
+                  prev_y = y;
+                  prev_z = (*point_cloud)(j,i).z;
+                } else {
+                  push = false;
+                  point_cloud_face_custom.push_back(prev_x);
+                  point_cloud_face_custom.push_back(x);
+
+                  point_cloud_face_custom.push_back(prev_y);
+                  point_cloud_face_custom.push_back(y);
+
+                  point_cloud_face_custom.push_back(prev_z);
+                  point_cloud_face_custom.push_back((*point_cloud)(j,i).z);
+                }
+#endif
               } else {
-                push = false;
-                point_cloud_face_custom.push_back(prev_x);
                 point_cloud_face_custom.push_back(x);
-
-                point_cloud_face_custom.push_back(prev_y);
                 point_cloud_face_custom.push_back(y);
-
-                point_cloud_face_custom.push_back(prev_z);
                 point_cloud_face_custom.push_back((*point_cloud)(j,i).z);
               }
-#endif
-            } else {
-              point_cloud_face_custom.push_back(x);
-              point_cloud_face_custom.push_back(y);
-              point_cloud_face_custom.push_back((*point_cloud)(j,i).z);
             }
           }
-        }
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-        debugImage[i][j] = 255;
+          debugImage[i][j] = 255;
 #endif
+        }
       }
     }
   }
@@ -296,13 +337,14 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 }
 #endif
 
-bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
-                                                  const std::vector<vpColVector> &point_cloud, vpColVector &desired_features,
-                                                  const unsigned int stepX, const unsigned int stepY
-                                                #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                                  , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
-                                                #endif
-                                                  ) {
+template<class PointCloud>
+bool vpMbtFaceDepthNormal::computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                                      const PointCloud &point_cloud, vpColVector &desired_features,
+                                                      const unsigned int stepX, const unsigned int stepY
+                                                    #if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                      , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                    #endif
+                                                      ) {
   m_faceActivated = false;
 
   if (width == 0 || height == 0)
@@ -354,54 +396,61 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 #endif
 
   double x = 0.0, y = 0.0;
+  std::vector<double> intersections;
+  std::vector<std::pair<unsigned int, unsigned int> > spans(1, std::make_pair(left, right));
   for (unsigned int i = top; i < bottom; i+=stepY) {
-    for (unsigned int j = left; j < right; j+=stepX) {
-      if ( point_cloud[i*width + j][2] > 0
-           &&
-           ( m_useScanLine ?
-           (i <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-           j <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-           m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-           : polygon_2d.isInside(vpImagePoint(i,j)) )
-           ) {
-        //Add point
-        point_cloud_face.push_back(point_cloud[i*width + j][0]);
-        point_cloud_face.push_back(point_cloud[i*width + j][1]);
-        point_cloud_face.push_back(point_cloud[i*width + j][2]);
-
-        if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-          //Add point for custom method for plane equation estimation
-          vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
-
-          if (checkSSE2) {
+    if (!m_useScanLine) {
+      getSampledSpans(polygon_2d, i, left, right, stepX, intersections, spans);
+    }
+
+    for (size_t k = 0; k < spans.size(); k++) {
+      for (unsigned int j = spans[k].first; j < spans[k].second; j+=stepX) {
+        if ( isValidPoint(point_cloud, i*width + j)
+             &&
+             ( !m_useScanLine ||
+             (i <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
+             j <  m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
+             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex()) )
+             ) {
+          //Add point
+          point_cloud_face.push_back(point_cloud[i*width + j][0]);
+          point_cloud_face.push_back(point_cloud[i*width + j][1]);
+          point_cloud_face.push_back(point_cloud[i*width + j][2]);
+
+          if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
+            //Add point for custom method for plane equation estimation
+            vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
+
+            if (checkSSE2) {
 #if USE_SSE
-            if (!push) {
-              push = true;
-              prev_x = x;
-              prev_y = y;
-              prev_z = point_cloud[i*width + j][2];
+              if (!push) {
+                push = true;
+                prev_x = x;
+                prev_y = y;
+                prev_z = point_cloud[i*width + j][2];
+              } else {
+                push = false;
+                point_cloud_face_custom.push_back(prev_x);
+                point_cloud_face_custom.push_back(x);
+
+                point_cloud_face_custom.push_back(prev_y);
+                point_cloud_face_custom.push_back(y);
+
+                point_cloud_face_custom.push_back(prev_z);
+                point_cloud_face_custom.push_back(point_cloud[i*width + j][2]);
+              }
+#endif
             } else {
-              push = false;
-              point_cloud_face_custom.push_back(prev_x);
               point_cloud_face_custom.push_back(x);
-
-              point_cloud_face_custom.push_back(prev_y);
               point_cloud_face_custom.push_back(y);
-
-              point_cloud_face_custom.push_back(prev_z);
               point_cloud_face_custom.push_back(point_cloud[i*width + j][2]);
             }
-#endif
-          } else {
-            point_cloud_face_custom.push_back(x);
-            point_cloud_face_custom.push_back(y);
-            point_cloud_face_custom.push_back(point_cloud[i*width + j][2]);
           }
-        }
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-        debugImage[i][j] = 255;
+          debugImage[i][j] = 255;
 #endif
+        }
       }
     }
   }
@@ -448,6 +497,61 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
   return true;
 }
 
+/*!
+  Estimate the plane of the face from the points of the point cloud that belong to the face.
+
+  \param cMo : Current pose.
+  \param width : Width of the depth image.
+  \param height : Height of the depth image.
+  \param point_cloud : Organized point cloud, the point seen by the pixel (i, j) being at index i*width+j.
+  \param desired_features : Estimated features.
+  \param stepX : Sampling step along the columns.
+  \param stepY : Sampling step along the rows.
+
+  \return true if the features of the face could be estimated.
+*/
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                                  const std::vector<vpColVector> &point_cloud, vpColVector &desired_features,
+                                                  const unsigned int stepX, const unsigned int stepY
+                                                #if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                #endif
+                                                  ) {
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, desired_features, stepX, stepY
+                                  #if DEBUG_DISPLAY_DEPTH_NORMAL
+                                    , debugImage, roiPts_vec
+                                  #endif
+                                    );
+}
+
+/*!
+  Estimate the plane of the face from the points of the organized point cloud that belong to the face.
+  The points marked invalid in the point cloud are not used.
+
+  \param cMo : Current pose.
+  \param width : Width of the depth image, vpPointCloud::getWidth().
+  \param height : Height of the depth image, vpPointCloud::getHeight().
+  \param point_cloud : Organized point cloud.
+  \param desired_features : Estimated features.
+  \param stepX : Sampling step along the columns.
+  \param stepY : Sampling step along the rows.
+
+  \return true if the features of the face could be estimated.
+*/
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                                  const vpPointCloud &point_cloud, vpColVector &desired_features,
+                                                  const unsigned int stepX, const unsigned int stepY
+                                                #if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  , vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                #endif
+                                                  ) {
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, desired_features, stepX, stepY
+                                  #if DEBUG_DISPLAY_DEPTH_NORMAL
+                                    , debugImage, roiPts_vec
+                                  #endif
+                                    );
+}
+
 #ifdef VISP_HAVE_PCL
 bool vpMbtFaceDepthNormal::computeDesiredFeaturesPCL(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud_face, vpColVector &desired_features,
                                                      vpColVector &desired_normal, vpColVector &centroid_point) {
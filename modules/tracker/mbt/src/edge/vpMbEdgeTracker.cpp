@@ -63,6 +63,10 @@
 #include <float.h>
 #include <map>
 
+#ifdef VISP_HAVE_OPENMP
+// Minimum number of lines to track their moving edges in parallel
+const int vpMbEdgeTrackerParallelMinLines = 4;
+#endif
 
 /*!
   Basic constructor
@@ -73,7 +77,8 @@ vpMbEdgeTracker::vpMbEdgeTracker()
     Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0),
     m_factor(), m_robustLines(), m_robustCylinders(), m_robustCircles(),
     m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(), m_errorCylinders(), m_errorCircles(),
-    m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(), m_robust_edge()
+    m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(), m_robust_edge(),
+    m_useParallelMovingEdgeTracking(true)
 {
   angleAppears = vpMath::rad(89);
   angleDisappears = vpMath::rad(89);
@@ -328,14 +333,14 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
         }
       }
 
-      std::list<vpMeSite>::const_iterator itListLine;
+      std::vector<vpMeSite>::const_iterator itListLine;
 
       unsigned int indexFeature = 0;
 
       for(unsigned int a = 0 ; a < l->meline.size() ; a++)
       {
         if (iter == 0 && l->meline[a] != NULL)
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
         for (unsigned int i=0 ; i < l->nbFeature[a] ; i++)
         {
@@ -411,11 +416,11 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
       cy->computeInteractionMatrixError(cMo, _I);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if (iter == 0 && (cy->meline1 != NULL || cy->meline2 != NULL)){
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
       }
 
       for(unsigned int i=0 ; i < cy->nbFeature ; i++){
@@ -517,9 +522,9 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
       ci->computeInteractionMatrixError(cMo);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (iter == 0 && (ci->meEllipse != NULL)) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
       }
 
       for(unsigned int i=0 ; i < ci->nbFeature ; i++){
@@ -612,10 +617,10 @@ vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char>& I, con
 
       unsigned int indexFeature = 0;
       for(unsigned int a = 0 ; a < l->meline.size(); a++){
-        std::list<vpMeSite>::const_iterator itListLine;
+        std::vector<vpMeSite>::const_iterator itListLine;
         if (l->meline[a] != NULL)
         {
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i=0 ; i < l->nbFeature[a] ; i++){
               m_factor[n+i] = fac;
@@ -635,11 +640,11 @@ vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char>& I, con
       cy = *it;
       cy->computeInteractionMatrixError(cMo, I);
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if ((cy->meline1 != NULL || cy->meline2 != NULL)){
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
 
         double fac = 1.0;
         for(unsigned int i=0 ; i < cy->nbFeature ; i++){
@@ -665,9 +670,9 @@ vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char>& I, con
       ci = *it;
       ci->computeInteractionMatrixError(cMo);
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (ci->meEllipse != NULL) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
         double fac = 1.0;
 
         for(unsigned int i=0 ; i < ci->nbFeature ; i++){
@@ -971,7 +976,7 @@ vpMbEdgeTracker::testTracking()
       for(unsigned int a = 0 ; a < l->meline.size() ; a++){
         if(l->meline[a] != NULL){
           nbExpectedPoint += (int)l->meline[a]->expecteddensity;
-          for(std::list<vpMeSite>::const_iterator itme=l->meline[a]->getMeList().begin(); itme!=l->meline[a]->getMeList().end(); ++itme){
+          for(std::vector<vpMeSite>::const_iterator itme=l->meline[a]->getMeSites().begin(); itme!=l->meline[a]->getMeSites().end(); ++itme){
             vpMeSite pix = *itme;
             if (pix.getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoint++;
             else nbBadPoint++;
@@ -986,13 +991,13 @@ vpMbEdgeTracker::testTracking()
     if ((cy->meline1 !=NULL && cy->meline2 != NULL) && cy->isVisible() && cy->isTracked())
     {
       nbExpectedPoint += (int)cy->meline1->expecteddensity;
-      for(std::list<vpMeSite>::const_iterator itme1=cy->meline1->getMeList().begin(); itme1!=cy->meline1->getMeList().end(); ++itme1){
+      for(std::vector<vpMeSite>::const_iterator itme1=cy->meline1->getMeSites().begin(); itme1!=cy->meline1->getMeSites().end(); ++itme1){
         vpMeSite pix = *itme1;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoint++;
         else nbBadPoint++;
       }
       nbExpectedPoint += (int)cy->meline2->expecteddensity;
-      for(std::list<vpMeSite>::const_iterator itme2=cy->meline2->getMeList().begin(); itme2!=cy->meline2->getMeList().end(); ++itme2){
+      for(std::vector<vpMeSite>::const_iterator itme2=cy->meline2->getMeSites().begin(); itme2!=cy->meline2->getMeSites().end(); ++itme2){
         vpMeSite pix = *itme2;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoint++;
         else nbBadPoint++;
@@ -1005,7 +1010,7 @@ vpMbEdgeTracker::testTracking()
     if (ci->isVisible() && ci->isTracked() && ci->meEllipse !=NULL)
     {
       nbExpectedPoint += ci->meEllipse->getExpectedDensity();
-      for(std::list<vpMeSite>::const_iterator itme=ci->meEllipse->getMeList().begin(); itme!=ci->meEllipse->getMeList().end(); ++itme){
+      for(std::vector<vpMeSite>::const_iterator itme=ci->meEllipse->getMeSites().begin(); itme!=ci->meEllipse->getMeSites().end(); ++itme){
         vpMeSite pix = *itme;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoint++;
         else nbBadPoint++;
@@ -1564,6 +1569,45 @@ vpMbEdgeTracker::initMovingEdge(const vpImage<unsigned char> &I, const vpHomogen
 }
 
 
+/*!
+  Check if the moving edges of a line, a cylinder or a circle of one of the
+  used scales are displayed while they are tracked.
+
+  \return True if at least one moving edge display is enabled.
+*/
+bool
+vpMbEdgeTracker::isMovingEdgeDisplayed() const
+{
+  for (unsigned int lvl = 0; lvl < scales.size(); lvl++) {
+    if (!scales[lvl]) {
+      continue;
+    }
+
+    for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[lvl].begin(); it!=lines[lvl].end(); ++it){
+      for (size_t i = 0; i < (*it)->meline.size(); i++) {
+        if ((*it)->meline[i] != NULL && (*it)->meline[i]->getDisplay() != vpMeSite::NONE) {
+          return true;
+        }
+      }
+    }
+
+    for(std::list<vpMbtDistanceCylinder*>::const_iterator it=cylinders[lvl].begin(); it!=cylinders[lvl].end(); ++it){
+      if (((*it)->meline1 != NULL && (*it)->meline1->getDisplay() != vpMeSite::NONE) ||
+          ((*it)->meline2 != NULL && (*it)->meline2->getDisplay() != vpMeSite::NONE)) {
+        return true;
+      }
+    }
+
+    for(std::list<vpMbtDistanceCircle*>::const_iterator it=circles[lvl].begin(); it!=circles[lvl].end(); ++it){
+      if ((*it)->meEllipse != NULL && (*it)->meEllipse->getDisplay() != vpMeSite::NONE) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 /*!
   Track the moving edges in the image.
   
@@ -1572,16 +1616,37 @@ vpMbEdgeTracker::initMovingEdge(const vpImage<unsigned char> &I, const vpHomogen
 void
 vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
 {
+  std::vector<vpMbtDistanceLine *> trackedLines;
+  // The display of the moving edges is not thread-safe
+  bool displayMovingEdges = false;
   for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[scaleLevel].begin(); it!=lines[scaleLevel].end(); ++it){
     vpMbtDistanceLine *l = *it;
     if(l->isVisible() && l->isTracked()){
       if(l->meline.size() == 0){
         l->initMovingEdge(I, cMo);
       }
-      l->trackMovingEdge(I, cMo);
+      trackedLines.push_back(l);
+      for (size_t i = 0; i < l->meline.size(); i++) {
+        if (l->meline[i] != NULL && l->meline[i]->getDisplay() != vpMeSite::NONE) {
+          displayMovingEdges = true;
+        }
+      }
     }
   }
 
+  // The moving edges of each line are tracked independently
+  const int nbLines = (int) trackedLines.size();
+#ifdef VISP_HAVE_OPENMP
+  const bool parallel = m_useParallelMovingEdgeTracking && !displayMovingEdges &&
+                        nbLines >= vpMbEdgeTrackerParallelMinLines;
+#pragma omp parallel for schedule(dynamic) if (parallel)
+#else
+  (void) displayMovingEdges;
+#endif
+  for (int k = 0; k < nbLines; k++) {
+    trackedLines[(size_t) k]->trackMovingEdge(I, cMo);
+  }
+
   for(std::list<vpMbtDistanceCylinder*>::const_iterator it=cylinders[scaleLevel].begin(); it!=cylinders[scaleLevel].end(); ++it){
     vpMbtDistanceCylinder *cy = *it;
     if(cy->isVisible() && cy->isTracked()) {
@@ -1659,8 +1724,8 @@ vpMbEdgeTracker::updateMovingEdgeWeights() {
       for(unsigned int a = 0 ; a < l->meline.size() ; a++)
       {
         if (l->nbFeature[a] > 0) {
-          std::list<vpMeSite>::iterator itListLine;
-          itListLine = l->meline[a]->getMeList().begin();
+          std::vector<vpMeSite>::iterator itListLine;
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i=0 ; i < l->nbFeature[a] ; i++){
             wmean += m_w_edge[n+indexLine];
@@ -1696,12 +1761,12 @@ vpMbEdgeTracker::updateMovingEdgeWeights() {
     if((*it)->isTracked()){
       cy = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCyl1;
-      std::list<vpMeSite>::iterator itListCyl2;
+      std::vector<vpMeSite>::iterator itListCyl1;
+      std::vector<vpMeSite>::iterator itListCyl2;
 
       if (cy->nbFeature > 0){
-        itListCyl1 = cy->meline1->getMeList().begin();
-        itListCyl2 = cy->meline2->getMeList().begin();
+        itListCyl1 = cy->meline1->getMeSites().begin();
+        itListCyl2 = cy->meline2->getMeSites().begin();
 
         for(unsigned int i=0 ; i < cy->nbFeaturel1 ; i++){
           wmean += m_w_edge[n+i];
@@ -1761,10 +1826,10 @@ vpMbEdgeTracker::updateMovingEdgeWeights() {
     if((*it)->isTracked()){
       ci = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCir;
+      std::vector<vpMeSite>::iterator itListCir;
 
       if (ci->nbFeature > 0){
-        itListCir = ci->meEllipse->getMeList().begin();
+        itListCir = ci->meEllipse->getMeSites().begin();
       }
 
       wmean = 0;
@@ -2468,7 +2533,7 @@ vpMbEdgeTracker::getNbPoints(const unsigned int level) const
     {
       for(unsigned int a = 0 ; a < l->meline.size() ; a++){
         if(l->nbFeature[a] != 0)
-          for(std::list<vpMeSite>::const_iterator itme=l->meline[a]->getMeList().begin(); itme!=l->meline[a]->getMeList().end(); ++itme){
+          for(std::vector<vpMeSite>::const_iterator itme=l->meline[a]->getMeSites().begin(); itme!=l->meline[a]->getMeSites().end(); ++itme){
             if (itme->getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoints++;
           }
       }
@@ -2480,10 +2545,10 @@ vpMbEdgeTracker::getNbPoints(const unsigned int level) const
     cy = *it;
     if (cy->isVisible() && cy->isTracked() && (cy->meline1 != NULL || cy->meline2 != NULL))
     {
-      for(std::list<vpMeSite>::const_iterator itme1=cy->meline1->getMeList().begin(); itme1!=cy->meline1->getMeList().end(); ++itme1){
+      for(std::vector<vpMeSite>::const_iterator itme1=cy->meline1->getMeSites().begin(); itme1!=cy->meline1->getMeSites().end(); ++itme1){
         if (itme1->getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoints++;
       }
-      for(std::list<vpMeSite>::const_iterator itme2=cy->meline2->getMeList().begin(); itme2!=cy->meline2->getMeList().end(); ++itme2){
+      for(std::vector<vpMeSite>::const_iterator itme2=cy->meline2->getMeSites().begin(); itme2!=cy->meline2->getMeSites().end(); ++itme2){
         if (itme2->getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoints++;
       }
     }
@@ -2494,7 +2559,7 @@ vpMbEdgeTracker::getNbPoints(const unsigned int level) const
     ci = *it;
     if (ci->isVisible() && ci->isTracked() && ci->meEllipse != NULL)
     {
-      for(std::list<vpMeSite>::const_iterator itme=ci->meEllipse->getMeList().begin(); itme!=ci->meEllipse->getMeList().end(); ++itme){
+      for(std::vector<vpMeSite>::const_iterator itme=ci->meEllipse->getMeSites().begin(); itme!=ci->meEllipse->getMeSites().end(); ++itme){
         if (itme->getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoints++;
       }
     }
@@ -2673,6 +2738,7 @@ vpMbEdgeTracker::initPyramid(const vpImage<unsigned char>& _I, std::vector< cons
 #if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
       IplImage* vpI0 = cvCreateImageHeader(cvSize((int)_I.getWidth(), (int)_I.getHeight()), IPL_DEPTH_8U, 1);
       vpI0->imageData = (char*)(_I.bitmap);
+      vpI0->widthStep = (int)_I.getPitch();
       IplImage* vpI = cvCreateImage(cvSize((int)(_I.getWidth() / cScale), (int)(_I.getHeight() / cScale)), IPL_DEPTH_8U, 1);
       cvResize(vpI0, vpI, CV_INTER_NN);
       vpImageConvert::convert(vpI, *I);
@@ -2873,6 +2939,23 @@ vpMbEdgeTracker::reInitLevel(const unsigned int _lvl)
   scaleLevel = scaleLevel_1;
 }
 
+/*!
+  Enable or disable the parallel tracking of the moving edges of the lines. When enabled
+  and OpenMP is available, the moving edges of each line are tracked in their own thread
+  once at least four lines are tracked. The tracked moving edges are the same as with the
+  sequential tracking.
+
+  \param use : If true, track the lines in parallel. Default is true.
+
+  \note The lines are tracked sequentially when the display of their moving edges is
+  enabled with vpMeTracker::setDisplay(), since the display is not thread-safe.
+*/
+void
+vpMbEdgeTracker::setUseParallelMovingEdgeTracking(const bool use)
+{
+  m_useParallelMovingEdgeTracking = use;
+}
+
 /*!
   Set if the polygons that have the given name have to be considered during the tracking phase.
 
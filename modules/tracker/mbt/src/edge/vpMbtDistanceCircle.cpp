@@ -207,7 +207,7 @@ vpMbtDistanceCircle::trackMovingEdge(const vpImage<unsigned char> &I, const vpHo
     }
 
     // Update the number of features
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
   }
 }
 
@@ -244,7 +244,7 @@ vpMbtDistanceCircle::updateMovingEdge(const vpImage<unsigned char> &I, const vpH
     {
       Reinit = true;
     }
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
   }
 }
 
@@ -366,7 +366,7 @@ vpMbtDistanceCircle::initInteractionMatrixError()
 {
   if (isvisible)
   {
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
     L.resize(nbFeature, 6);
     error.resize(nbFeature);
   }
@@ -405,7 +405,7 @@ vpMbtDistanceCircle::computeInteractionMatrixError(const vpHomogeneousMatrix &cM
 
     unsigned int j = 0;
 
-    for(std::list<vpMeSite>::const_iterator it=meEllipse->getMeList().begin(); it!=meEllipse->getMeList().end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=meEllipse->getMeSites().begin(); it!=meEllipse->getMeSites().end(); ++it){
       vpPixelMeterConversion::convertPoint(cam, it->j, it->i, x, y);
       H[0] = 2*(mu11*(y-yg)+mu02*(xg-x));
       H[1] = 2*(mu20*(yg-y)+mu11*(x-xg));
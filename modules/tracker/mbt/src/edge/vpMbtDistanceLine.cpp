@@ -392,7 +392,7 @@ vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vpHomog
         {
           melinePt->initTracking(I,ip1,ip2,rho,theta);
           meline.push_back(melinePt);
-  //        nbFeature.push_back((unsigned int) melinePt->getMeList().size());
+  //        nbFeature.push_back((unsigned int) melinePt->getMeSites().size());
   //        nbFeatureTotal += nbFeature.back();
         }
         catch(...)
@@ -451,8 +451,8 @@ vpMbtDistanceLine::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomo
       nbFeatureTotal = 0;
       for(unsigned int i = 0 ; i < meline.size() ; i++){
         meline[i]->track(I);
-        nbFeature.push_back((unsigned int) meline[i]->getMeList().size());
-        nbFeatureTotal += (unsigned int) meline[i]->getMeList().size();
+        nbFeature.push_back((unsigned int) meline[i]->getMeSites().size());
+        nbFeatureTotal += (unsigned int) meline[i]->getMeSites().size();
       }
     }
     catch(...)
@@ -551,7 +551,7 @@ vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHom
             if (ip1.get_i()<ip2.get_i()) { meline[i]->imin = (int)ip1.get_i()-marge ; meline[i]->imax = (int)ip2.get_i()+marge ; } else{ meline[i]->imin = (int)ip2.get_i()-marge ; meline[i]->imax = (int)ip1.get_i()+marge ; }
 
               meline[i]->updateParameters(I,ip1,ip2,rho,theta);
-              nbFeature[i] = (unsigned int)meline[i]->getMeList().size();
+              nbFeature[i] = (unsigned int)meline[i]->getMeSites().size();
               nbFeatureTotal += nbFeature[i];
           }
         }
@@ -754,7 +754,7 @@ vpMbtDistanceLine::initInteractionMatrixError()
     for(unsigned int i = 0 ; i < meline.size() ; i++) {
       nbFeature[i] = 0;
       //To be consistent with nbFeature[i] = 0
-      std::list<vpMeSite>& me_site_list = meline[i]->getMeList();
+      std::vector<vpMeSite>& me_site_list = meline[i]->getMeSites();
       me_site_list.clear();
     }
     nbFeatureTotal = 0;
@@ -794,7 +794,7 @@ vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix &cMo)
       unsigned int j = 0;
 
       for(unsigned int i = 0 ; i < meline.size() ; i++){
-        for(std::list<vpMeSite>::const_iterator it=meline[i]->getMeList().begin(); it!=meline[i]->getMeList().end(); ++it){
+        for(std::vector<vpMeSite>::const_iterator it=meline[i]->getMeSites().begin(); it!=meline[i]->getMeSites().end(); ++it){
           x = (double)it->j;
           y = (double)it->i;
 
@@ -820,7 +820,7 @@ vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix &cMo)
 
       unsigned int j = 0;
       for (unsigned int i = 0; i < meline.size(); i++) {
-        for (std::list<vpMeSite>::const_iterator it = meline[i]->getMeList().begin(); it != meline[i]->getMeList().end(); ++it) {
+        for (std::vector<vpMeSite>::const_iterator it = meline[i]->getMeSites().begin(); it != meline[i]->getMeSites().end(); ++it) {
           for (unsigned int k = 0; k < 6; k++) {
             L[j][k] = 0.0;
           }
@@ -849,7 +849,7 @@ vpMbtDistanceLine::closeToImageBorder(const vpImage<unsigned char>& I, const uns
   if (isvisible){
 
     for(unsigned int i = 0 ; i < meline.size() ; i++){
-      for(std::list<vpMeSite>::const_iterator it=meline[i]->getMeList().begin(); it!=meline[i]->getMeList().end(); ++it){
+      for(std::vector<vpMeSite>::const_iterator it=meline[i]->getMeSites().begin(); it!=meline[i]->getMeSites().end(); ++it){
         int i_ = it->i;
         int j_ = it->j;
 
@@ -197,7 +197,7 @@ vpMbtMeEllipse::computeProjectionError(const vpImage<unsigned char>& _I, double
   int height = (int) _I.getHeight();
   int width = (int) _I.getWidth();
 
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     double iSite = it->ifloat;
     double jSite = it->jfloat;
 
@@ -397,7 +397,7 @@ void
 vpMbtMeEllipse::updateTheta()
 {
   vpMeSite p_me;
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     p_me = *it;
     vpImagePoint iP;
     iP.set_i(p_me.ifloat);
@@ -419,14 +419,7 @@ vpMbtMeEllipse::updateTheta()
 void
 vpMbtMeEllipse::suppressPoints()
 {
-  // Loop through list of sites to track
-  for(std::list<vpMeSite>::iterator itList=list.begin(); itList!=list.end();){
-    vpMeSite s = *itList;//current reference pixel
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      itList = list.erase(itList);
-    else
-      ++itList;
-  }
+  removeSuppressedSites();
 }
 
 /*!
@@ -213,8 +213,8 @@ vpMbtMeLine::sample(const vpImage<unsigned char>& I)
 void
 vpMbtMeLine::suppressPoints(const vpImage<unsigned char> & I)
 {
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ){
-    vpMeSite s = *it;//current reference pixel
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+    vpMeSite &s = *it;//current reference pixel
 
     if (fabs(sin(theta)) > 0.9) // Vertical line management
     {
@@ -245,12 +245,9 @@ vpMbtMeLine::suppressPoints(const vpImage<unsigned char> & I)
     {
       s.setState(vpMeSite::TOO_NEAR);
     }
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      it = list.erase(it);
-    else
-      ++it;
   }
+
+  removeSuppressedSites();
 }
 
 
@@ -469,7 +466,7 @@ vpMbtMeLine::computeProjectionError(const vpImage<unsigned char>& _I, double &_s
 
   double offset = std::floor(filterX.getRows() / 2.0f);
 
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     if(iter != 0 && iter+1 != list.size()){
       double gradientX = 0;
       double gradientY = 0;
@@ -624,7 +621,7 @@ vpMbtMeLine::updateDelta()
   delta = - theta + M_PI/2.0;
   normalizeAngle(delta);
 
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     p_me = *it;
     p_me.alpha = delta;
     p_me.mask_sign = sign;
@@ -730,7 +727,7 @@ vpMbtMeLine::setExtremities()
   double j_max = -1;
 
   // Loop through list of sites to track
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
     vpMeSite s = *it;//current reference pixel
     if (s.ifloat < i_min)
     {
@@ -755,7 +752,7 @@ vpMbtMeLine::setExtremities()
 
   if (fabs(i_min-i_max) < 25)
   {
-    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
       vpMeSite s = *it;//current reference pixel
       if (s.jfloat < j_min)
       {
@@ -808,7 +805,7 @@ vpMbtMeLine::bubbleSortI()
     }
   }
 #endif
-  list.sort(sortByI);
+  std::stable_sort(list.begin(), list.end(), sortByI);
 }
 
 
@@ -835,7 +832,7 @@ vpMbtMeLine::bubbleSortJ()
     }
   }
 #endif
-  list.sort(sortByJ);
+  std::stable_sort(list.begin(), list.end(), sortByJ);
 }
 
 #endif
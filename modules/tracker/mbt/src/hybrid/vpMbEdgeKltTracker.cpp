@@ -44,7 +44,7 @@
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 vpMbEdgeKltTracker::vpMbEdgeKltTracker()
   : thresholdKLT(2.), thresholdMBT(2.), m_maxIterKlt(30),
@@ -429,8 +429,8 @@ vpMbEdgeKltTracker::postTrackingMbt(vpColVector &w, const unsigned int lvl)
 
       for(unsigned int a = 0 ; a < l->meline.size() ; a++)
       {
-        std::list<vpMeSite>::iterator itListLine;
-        if (l->nbFeature[a] > 0) itListLine = l->meline[a]->getMeList().begin();
+        std::vector<vpMeSite>::iterator itListLine;
+        if (l->nbFeature[a] > 0) itListLine = l->meline[a]->getMeSites().begin();
 
         for (unsigned int i=0 ; i < l->nbFeature[a] ; i++){
           wmean += w[n+indexLine];
@@ -465,11 +465,11 @@ vpMbEdgeKltTracker::postTrackingMbt(vpColVector &w, const unsigned int lvl)
     if((*it)->isTracked()){
       cy = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCyl1;
-      std::list<vpMeSite>::iterator itListCyl2;
+      std::vector<vpMeSite>::iterator itListCyl1;
+      std::vector<vpMeSite>::iterator itListCyl2;
       if (cy->nbFeature > 0){
-        itListCyl1 = cy->meline1->getMeList().begin();
-        itListCyl2 = cy->meline2->getMeList().begin();
+        itListCyl1 = cy->meline1->getMeSites().begin();
+        itListCyl2 = cy->meline2->getMeSites().begin();
       }
 
       wmean = 0;
@@ -530,10 +530,10 @@ vpMbEdgeKltTracker::postTrackingMbt(vpColVector &w, const unsigned int lvl)
     if((*it)->isTracked()){
       ci = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCir;
+      std::vector<vpMeSite>::iterator itListCir;
 
       if (ci->nbFeature > 0){
-        itListCir = ci->meEllipse->getMeList().begin();
+        itListCir = ci->meEllipse->getMeSites().begin();
       }
 
       wmean = 0;
@@ -897,10 +897,10 @@ vpMbEdgeKltTracker::trackFirstLoop(const vpImage<unsigned char>& I, vpColVector
 
       unsigned int indexFeature = 0;
       for(unsigned int a = 0 ; a < l->meline.size(); a++){
-        std::list<vpMeSite>::const_iterator itListLine;
+        std::vector<vpMeSite>::const_iterator itListLine;
         if (l->meline[a] != NULL)
         {
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i=0 ; i < l->nbFeature[a] ; i++){
               factor[n+i] = fac;
@@ -921,11 +921,11 @@ vpMbEdgeKltTracker::trackFirstLoop(const vpImage<unsigned char>& I, vpColVector
       cy->computeInteractionMatrixError(cMo, I);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if ((cy->meline1 != NULL || cy->meline2 != NULL)){
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
       }
 
       for(unsigned int i=0 ; i < cy->nbFeature ; i++){
@@ -952,9 +952,9 @@ vpMbEdgeKltTracker::trackFirstLoop(const vpImage<unsigned char>& I, vpColVector
       ci->computeInteractionMatrixError(cMo);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (ci->meEllipse != NULL) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
       }
 
       for(unsigned int i=0 ; i < ci->nbFeature ; i++){
@@ -1228,7 +1228,7 @@ vpMbEdgeKltTracker::reInitModel(const vpImage<unsigned char>& I, const char* cad
                                 const vpHomogeneousMatrix& cMo_, const bool verbose)
 {
   // Reinit klt
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
   if(cur != NULL){
     cvReleaseImage(&cur);
     cur = NULL;
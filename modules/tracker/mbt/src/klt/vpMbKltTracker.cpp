@@ -37,12 +37,15 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <cstring>
+
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/mbt/vpMbKltTracker.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 #include <visp3/core/vpTrackingException.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 #if defined(__APPLE__) && defined(__MACH__) // Apple OSX and iOS (Darwin)
 #  include <TargetConditionals.h> // To detect OSX or IOS using TARGET_OS_IPHONE or TARGET_OS_IOS macro
@@ -50,9 +53,9 @@
 
 vpMbKltTracker::vpMbKltTracker()
   :
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
     cur(),
-#else
+#elif defined(VISP_HAVE_OPENCV)
     cur(NULL),
 #endif
     c0Mo(),
@@ -60,7 +63,9 @@ vpMbKltTracker::vpMbKltTracker()
     percentGood(0.6), ctTc0(), tracker(), kltPolygons(), kltCylinders(), circles_disp(),
     m_nbInfos(0), m_nbFaceUsed(0), m_L_klt(), m_error_klt(), m_w_klt(), m_weightedError_klt(), m_robust_klt()
 {
+#if defined(VISP_HAVE_OPENCV)
   tracker.setTrackerId(1);
+#endif
   tracker.setUseHarris(1);
   tracker.setMaxFeatures(10000);
   tracker.setWindowSize(5);
@@ -87,7 +92,7 @@ vpMbKltTracker::vpMbKltTracker()
 */
 vpMbKltTracker::~vpMbKltTracker()
 {
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
   if(cur != NULL){
     cvReleaseImage(&cur);
     cur = NULL;
@@ -162,7 +167,9 @@ vpMbKltTracker::reinit(const vpImage<unsigned char>& I)
   c0Mo = cMo;
   ctTc0.eye();
 
+#if defined(VISP_HAVE_OPENCV)
   vpImageConvert::convert(I, cur);
+#endif
 
   cam.computeFov(I.getWidth(), I.getHeight());
 
@@ -172,7 +179,9 @@ vpMbKltTracker::reinit(const vpImage<unsigned char>& I)
   }
 
   // mask
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+  vpImage<unsigned char> mask(I.getHeight(), I.getWidth(), 0);
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   cv::Mat mask((int)I.getRows(), (int)I.getCols(), CV_8UC1, cv::Scalar(0));
 #else
   IplImage* mask = cvCreateImage(cvSize((int)I.getWidth(), (int)I.getHeight()), IPL_DEPTH_8U, 1);
@@ -182,7 +191,11 @@ vpMbKltTracker::reinit(const vpImage<unsigned char>& I)
   vpMbtDistanceKltPoints *kltpoly;
   vpMbtDistanceKltCylinder *kltPolyCylinder;
   if(useScanLine){
+#if defined(VISP_HAVE_OPENCV)
     vpImageConvert::convert(faces.getMbScanLineRenderer().getMask(), mask);
+#else
+    mask = faces.getMbScanLineRenderer().getMask();
+#endif
   }
   else{
     unsigned char val = 255/* - i*15*/;
@@ -215,7 +228,11 @@ vpMbKltTracker::reinit(const vpImage<unsigned char>& I)
     }
   }
 
+#if defined(VISP_HAVE_OPENCV)
   tracker.initTracking(cur, mask);
+#else
+  tracker.initTracking(I, &mask);
+#endif
 //  tracker.track(cur); // AY: Not sure to be usefull but makes sure that the points are valid for tracking and avoid too fast reinitialisations.
 //  vpCTRACE << "init klt. detected " << tracker.getNbFeatures() << " points" << std::endl;
 
@@ -233,7 +250,7 @@ vpMbKltTracker::reinit(const vpImage<unsigned char>& I)
       kltPolyCylinder->init(tracker, cMo);
   }
 
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
   cvReleaseImage(&mask);
 #endif
 }
@@ -247,7 +264,7 @@ vpMbKltTracker::resetTracker()
 {
   cMo.eye();
 
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
   if(cur != NULL){
     cvReleaseImage(&cur);
     cur = NULL;
@@ -288,7 +305,9 @@ vpMbKltTracker::resetTracker()
   firstInitialisation = true;
   computeCovariance = false;
 
+#if defined(VISP_HAVE_OPENCV)
   tracker.setTrackerId(1);
+#endif
   tracker.setUseHarris(1);
 
   tracker.setMaxFeatures(10000);
@@ -374,7 +393,11 @@ vpMbKltTracker::getKltImagePointsWithId() const
   \param t : Klt tracker containing the new values.
 */
 void
+#if defined(VISP_HAVE_OPENCV)
 vpMbKltTracker::setKltOpencv(const vpKltOpencv& t){
+#else
+vpMbKltTracker::setKltTracker(const vpKltTracker& t){
+#endif
   tracker.setMaxFeatures(t.getMaxFeatures());
   tracker.setWindowSize(t.getWindowSize());
   tracker.setQuality(t.getQuality());
@@ -432,7 +455,11 @@ vpMbKltTracker::setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatr
   {
     vpMbtDistanceKltPoints *kltpoly;
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+    std::vector<vpImagePoint> init_pts;
+    std::vector<long> init_ids;
+    std::vector<vpImagePoint> guess_pts;
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
     std::vector<cv::Point2f> init_pts;
     std::vector<long> init_ids;
     std::vector<cv::Point2f> guess_pts;
@@ -491,7 +518,7 @@ vpMbKltTracker::setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatr
         std::map<int, vpImagePoint>::const_iterator iter = kltpoly->getCurrentPoints().begin();
         //nbCur+= (unsigned int)kltpoly->getCurrentPoints().size();
         for( ; iter != kltpoly->getCurrentPoints().end(); ++iter){
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020408)
 #  if TARGET_OS_IPHONE
           if ( std::find(init_ids.begin(), init_ids.end(), (long) (kltpoly->getCurrentPointsInd())[(int)iter->first]) != init_ids.end() )
 #  else
@@ -506,9 +533,13 @@ vpMbKltTracker::setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatr
           vpColVector cdp(3);
           cdp[0] = iter->second.get_j(); cdp[1] = iter->second.get_i(); cdp[2] = 1.0;
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#  if !defined(VISP_HAVE_OPENCV)
+          init_pts.push_back(vpImagePoint(cdp[1], cdp[0]));
+#  else
           cv::Point2f p((float)cdp[0], (float)cdp[1]);
           init_pts.push_back(p);
+#  endif
 #  if TARGET_OS_IPHONE
           init_ids.push_back((size_t)(kltpoly->getCurrentPointsInd())[(int)iter->first]);
 #  else
@@ -532,7 +563,9 @@ vpMbKltTracker::setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatr
           cdp[1] = (cdp[0] * cdGc[1][0] + cdp[1] * cdGc[1][1] + cdGc[1][2]) / p_mu_t_2;
 
           //Set value to the KLT tracker
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+          guess_pts.push_back(vpImagePoint(cdp[1], cdp[0]));
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
           cv::Point2f p_guess((float)cdp[0], (float)cdp[1]);
           guess_pts.push_back(p_guess);
 #else
@@ -543,9 +576,11 @@ vpMbKltTracker::setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatr
       }
     }
 
+#if defined(VISP_HAVE_OPENCV)
     vpImageConvert::convert(I, cur);
+#endif
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020408)
     tracker.setInitialGuess(init_pts, guess_pts, init_ids);
 #else
     tracker.setInitialGuess(&init_pts, &guess_pts, init_ids, iter_pts);
@@ -630,8 +665,46 @@ vpMbKltTracker::initFaceFromLines(vpMbtPolygon &polygon)
 */
 void
 vpMbKltTracker::preTracking(const vpImage<unsigned char>& I) {
+  preTracking(I, vpRect(0, 0, I.getWidth(), I.getHeight()));
+}
+
+/*!
+  Achieve the tracking of the KLT features and associate the features to the faces.
+
+  Only the pixels of \e roi are copied into the image given to OpenCV when it
+  has the size of the previous image, the rest of the image keeps the content
+  of the previous frames. The region has to contain the tracked features and
+  their search windows, see vpMbGenericTracker::setUsePredictedRoi(). Without
+  OpenCV, \e I is tracked directly by vpKltTracker and \e roi is not used.
+
+  \param I : The input image.
+  \param roi : Region of \e I that has changed since the previous frame.
+*/
+void
+vpMbKltTracker::preTracking(const vpImage<unsigned char>& I, const vpRect &roi) {
+#if !defined(VISP_HAVE_OPENCV)
+  (void) roi;
+  tracker.track(I);
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+  unsigned int left = (unsigned int) std::max(0.0, roi.getLeft());
+  unsigned int top = (unsigned int) std::max(0.0, roi.getTop());
+  unsigned int right = (unsigned int) std::min((double) I.getWidth(), std::max(0.0, roi.getRight() + 1));
+  unsigned int bottom = (unsigned int) std::min((double) I.getHeight(), std::max(0.0, roi.getBottom() + 1));
+
+  if (cur.rows == (int) I.getHeight() && cur.cols == (int) I.getWidth() && cur.type() == CV_8UC1 &&
+      left < right && top < bottom && (right - left) * (bottom - top) < I.getSize()) {
+    for (unsigned int i = top; i < bottom; i++) {
+      memcpy(cur.ptr<unsigned char>((int) i) + left, I[i] + left, right - left);
+    }
+  } else {
+    vpImageConvert::convert(I, cur);
+  }
+  tracker.track(cur);
+#else
+  (void) roi;
   vpImageConvert::convert(I, cur);
   tracker.track(cur);
+#endif
 
   m_nbInfos = 0;
   m_nbFaceUsed = 0;
@@ -1290,7 +1363,7 @@ vpMbKltTracker::reInitModel(const vpImage<unsigned char>& I, const char* cad_nam
 {
   this->cMo.eye();
 
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
   if(cur != NULL){
     cvReleaseImage(&cur);
     cur = NULL;
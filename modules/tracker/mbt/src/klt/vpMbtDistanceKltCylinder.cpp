@@ -41,7 +41,7 @@
 #include <visp3/core/vpPolygon.h>
 
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 #if defined(VISP_HAVE_CLIPPER)
 #  include <clipper.hpp> // clipper private library
@@ -105,11 +105,15 @@ vpMbtDistanceKltCylinder::buildFrom(const vpPoint &p1, const vpPoint &p2, const
   map detected in the image, are parsed in order to extract the id of the points
   that are indeed in the face.
 
-  \param _tracker : ViSP OpenCV KLT Tracker.
+  \param _tracker : ViSP KLT Tracker.
   \param cMo : Pose of the object in the camera frame at initialization.
 */
 void
+#if defined(VISP_HAVE_OPENCV)
 vpMbtDistanceKltCylinder::init(const vpKltOpencv& _tracker, const vpHomogeneousMatrix &cMo)
+#else
+vpMbtDistanceKltCylinder::init(const vpKltTracker& _tracker, const vpHomogeneousMatrix &cMo)
+#endif
 {
   c0Mo = cMo;
   cylinder.changeFrame(cMo);
@@ -201,7 +205,11 @@ vpMbtDistanceKltCylinder::init(const vpKltOpencv& _tracker, const vpHomogeneousM
   \return the number of points that are tracked in this face and in this instanciation of the tracker
 */
 unsigned int
+#if defined(VISP_HAVE_OPENCV)
 vpMbtDistanceKltCylinder::computeNbDetectedCurrent(const vpKltOpencv& _tracker)
+#else
+vpMbtDistanceKltCylinder::computeNbDetectedCurrent(const vpKltTracker& _tracker)
+#endif
 {
   long id;
   float x, y;
@@ -380,14 +388,19 @@ vpMbtDistanceKltCylinder::isTrackedFeature(const int _id)
 */
 void
 vpMbtDistanceKltCylinder::updateMask(
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+    vpImage<unsigned char> &mask,
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
     cv::Mat &mask,
 #else
     IplImage* mask,
 #endif
     unsigned char nb, unsigned int shiftBorder)
 {
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+  int width  = (int) mask.getWidth();
+  int height = (int) mask.getHeight();
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   int width  = mask.cols;
   int height = mask.rows;
 #else
@@ -472,9 +485,14 @@ vpMbtDistanceKltCylinder::updateMask(
             j_max = width;
           }
 
-        #if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+        #if !defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020408)
           for (int i = i_min; i < i_max; i++) {
             double i_d = (double) i;
+        #if defined(VISP_HAVE_OPENCV)
+            unsigned char *mask_row = mask.ptr<uchar>(i);
+        #else
+            unsigned char *mask_row = mask[(unsigned int) i];
+        #endif
 
             for(int j = j_min; j < j_max; j++) {
               double j_d = (double) j;
@@ -482,7 +500,7 @@ vpMbtDistanceKltCylinder::updateMask(
             #if defined (VISP_HAVE_CLIPPER)
               imPt.set_ij(i_d, j_d);
               if (polygon_test.isInside(imPt)) {
-                mask.ptr<uchar>(i)[j] = nb;
+                mask_row[j] = nb;
               }
             #else
               if (shiftBorder != 0) {
@@ -491,12 +509,12 @@ vpMbtDistanceKltCylinder::updateMask(
                     && vpPolygon::isInside(roi, i_d-shiftBorder_d, j_d+shiftBorder_d)
                     && vpPolygon::isInside(roi, i_d+shiftBorder_d, j_d-shiftBorder_d)
                     && vpPolygon::isInside(roi, i_d-shiftBorder_d, j_d-shiftBorder_d) ){
-                  mask.at<unsigned char>(i,j) = nb;
+                  mask_row[j] = nb;
                 }
               }
               else{
                 if(vpPolygon::isInside(roi, i, j)){
-                  mask.at<unsigned char>(i,j) = nb;
+                  mask_row[j] = nb;
                 }
               }
             #endif
@@ -40,7 +40,7 @@
 #include <visp3/mbt/vpMbtDistanceKltPoints.h>
 #include <visp3/core/vpPolygon.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 #if defined(VISP_HAVE_CLIPPER)
 #  include <clipper.hpp> // clipper private library
@@ -74,10 +74,14 @@ vpMbtDistanceKltPoints::~vpMbtDistanceKltPoints()
   map detected in the image, are parsed in order to extract the id of the points
   that are indeed in the face.
 
-  \param _tracker : ViSP OpenCV KLT Tracker.
+  \param _tracker : ViSP KLT Tracker.
 */
 void
+#if defined(VISP_HAVE_OPENCV)
 vpMbtDistanceKltPoints::init(const vpKltOpencv& _tracker)
+#else
+vpMbtDistanceKltPoints::init(const vpKltTracker& _tracker)
+#endif
 {
   // extract ids of the points in the face
   nbPointsInit = 0;
@@ -145,7 +149,11 @@ vpMbtDistanceKltPoints::init(const vpKltOpencv& _tracker)
   \return the number of points that are tracked in this face and in this instanciation of the tracker
 */
 unsigned int
+#if defined(VISP_HAVE_OPENCV)
 vpMbtDistanceKltPoints::computeNbDetectedCurrent(const vpKltOpencv& _tracker)
+#else
+vpMbtDistanceKltPoints::computeNbDetectedCurrent(const vpKltTracker& _tracker)
+#endif
 {
   long id;
   float x, y;
@@ -347,14 +355,19 @@ vpMbtDistanceKltPoints::isTrackedFeature(const int _id)
 */
 void
 vpMbtDistanceKltPoints::updateMask(
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+    vpImage<unsigned char> &mask,
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
     cv::Mat &mask,
 #else
     IplImage* mask,
 #endif
     unsigned char nb, unsigned int shiftBorder)
 {
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV)
+  int width  = (int) mask.getWidth();
+  int height = (int) mask.getHeight();
+#elif (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   int width  = mask.cols;
   int height = mask.rows;
 #else
@@ -435,9 +448,14 @@ vpMbtDistanceKltPoints::updateMask(
     j_max = width;
   }
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   for (int i = i_min; i< i_max; i++) {
     double i_d = (double) i;
+#if defined(VISP_HAVE_OPENCV)
+    unsigned char *mask_row = mask.ptr<uchar>(i);
+#else
+    unsigned char *mask_row = mask[(unsigned int) i];
+#endif
 
     for (int j = j_min; j< j_max; j++) {
       double j_d = (double) j;
@@ -445,7 +463,7 @@ vpMbtDistanceKltPoints::updateMask(
 #if defined (VISP_HAVE_CLIPPER)
       imPt.set_ij(i_d, j_d);
       if (polygon_test.isInside(imPt)) {
-        mask.ptr<uchar>(i)[j] = nb;
+        mask_row[j] = nb;
       }
 #else
       if (shiftBorder != 0) {
@@ -454,12 +472,12 @@ vpMbtDistanceKltPoints::updateMask(
             && vpPolygon::isInside(roi, i_d-shiftBorder_d, j_d+shiftBorder_d)
             && vpPolygon::isInside(roi, i_d+shiftBorder_d, j_d-shiftBorder_d)
             && vpPolygon::isInside(roi, i_d-shiftBorder_d, j_d-shiftBorder_d) ){
-          mask.at<unsigned char>(i,j) = nb;
+          mask_row[j] = nb;
         }
       }
       else{
         if(vpPolygon::isInside(roi, i, j)){
-          mask.at<unsigned char>(i,j) = nb;
+          mask_row[j] = nb;
         }
       }
 #endif
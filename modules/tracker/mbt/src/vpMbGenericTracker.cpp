@@ -35,16 +35,185 @@
 
 #include <visp3/mbt/vpMbGenericTracker.h>
 
+#include <new>
+#include <stdexcept>
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+#include <exception>
+#endif
+
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpMatrixException.h>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 #include <visp3/core/vpTrackingException.h>
 
+namespace {
+/*!
+  Work done for one camera by runPerCamera().
+*/
+class vpMbCameraTask {
+public:
+  virtual ~vpMbCameraTask() { }
+  virtual void run(const size_t camera) = 0;
+};
+
+/*!
+  Exceptions raised by the per-camera threads of the parallel tracking mode. They are
+  kept per camera and the one of the first camera, in the order of the trackers, is
+  rethrown from the calling thread. The reported error does not depend on the thread
+  timing.
+
+  With C++11 the original exception is rethrown. Otherwise it is rebuilt from its type:
+  vpTrackingException, vpMatrixException and std::bad_alloc keep their type, other
+  vpException are rethrown as vpException and other std::exception as
+  std::runtime_error, with the same code and message.
+*/
+class vpMbParallelTrackingError {
+public:
+  explicit vpMbParallelTrackingError(const size_t nbCameras) : m_errors(nbCameras) { }
+
+  //! Record the exception being handled, must be called from a catch block.
+  void capture(const size_t camera) {
+    vpError &error = m_errors[camera];
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+    error.exception = std::current_exception();
+#else
+    try {
+      throw;
+    } catch (vpTrackingException &e) {
+      error.set(TRACKING_EXCEPTION, e.getCode(), e.getStringMessage());
+    } catch (vpMatrixException &e) {
+      error.set(MATRIX_EXCEPTION, e.getCode(), e.getStringMessage());
+    } catch (vpException &e) {
+      error.set(VISP_EXCEPTION, e.getCode(), e.getStringMessage());
+    } catch (const std::bad_alloc &) {
+      error.set(BAD_ALLOC, 0, "");
+    } catch (const std::exception &e) {
+      error.set(STD_EXCEPTION, 0, e.what());
+    } catch (...) {
+      error.set(UNKNOWN_EXCEPTION, 0, "");
+    }
+#endif
+  }
+
+  void rethrow() const {
+    for (size_t i = 0; i < m_errors.size(); i++) {
+      const vpError &error = m_errors[i];
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+      if (error.exception) {
+        std::rethrow_exception(error.exception);
+      }
+#else
+      switch (error.type) {
+      case TRACKING_EXCEPTION:
+        throw vpTrackingException(error.code, error.message);
+      case MATRIX_EXCEPTION:
+        throw vpMatrixException(error.code, error.message);
+      case VISP_EXCEPTION:
+        throw vpException(error.code, error.message);
+      case BAD_ALLOC:
+        throw std::bad_alloc();
+      case STD_EXCEPTION:
+        throw std::runtime_error(error.message);
+      case UNKNOWN_EXCEPTION:
+        throw vpException(vpException::fatalError, "Unknown exception raised by the tracker of camera %d", (int) i);
+      case NO_EXCEPTION:
+        break;
+      }
+#endif
+    }
+  }
+
+private:
+#ifndef VISP_HAVE_CPP11_COMPATIBILITY
+  typedef enum {
+    NO_EXCEPTION,
+    TRACKING_EXCEPTION,
+    MATRIX_EXCEPTION,
+    VISP_EXCEPTION,
+    BAD_ALLOC,
+    STD_EXCEPTION,
+    UNKNOWN_EXCEPTION
+  } vpErrorType;
+#endif
+
+  struct vpError {
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+    std::exception_ptr exception;
+#else
+    vpError() : type(NO_EXCEPTION), code(0), message() { }
+
+    void set(const vpErrorType type_, const int code_, const std::string &message_) {
+      type = type_;
+      code = code_;
+      message = message_;
+    }
+
+    vpErrorType type;
+    int code;
+    std::string message;
+#endif
+  };
+
+  std::vector<vpError> m_errors;
+};
+
+/*!
+  Run the task of each camera, each one on its own thread when OpenMP is available.
+  The exceptions are rethrown once all the cameras are processed, see
+  vpMbParallelTrackingError.
+*/
+void runPerCamera(vpMbCameraTask &task, const size_t nbCameras) {
+  vpMbParallelTrackingError error(nbCameras);
+  const int nbThreads = (int) nbCameras;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for num_threads(nbThreads)
+#endif
+  for (int i = 0; i < nbThreads; i++) {
+    try {
+      task.run((size_t) i);
+    } catch (...) {
+      error.capture((size_t) i);
+    }
+  }
+  error.rethrow();
+}
+
+/*!
+  Project a point of the model in the image, return false if it is behind the camera.
+*/
+bool projectModelPoint(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, const vpPoint &P,
+                       double &u, double &v) {
+  double X = cMo[0][0] * P.get_oX() + cMo[0][1] * P.get_oY() + cMo[0][2] * P.get_oZ() + cMo[0][3];
+  double Y = cMo[1][0] * P.get_oX() + cMo[1][1] * P.get_oY() + cMo[1][2] * P.get_oZ() + cMo[1][3];
+  double Z = cMo[2][0] * P.get_oX() + cMo[2][1] * P.get_oY() + cMo[2][2] * P.get_oZ() + cMo[2][3];
+
+  if (Z <= std::numeric_limits<double>::epsilon()) {
+    return false;
+  }
+
+  vpMeterPixelConversion::convertPoint(cam, X / Z, Y / Z, u, v);
+  return true;
+}
+
+/*!
+  Return the duration of a tracking stage to give to a vpMbtTrackingStatistics::vpScopedTimer,
+  NULL if the tracking statistics are disabled.
+*/
+double *stageTiming(std::map<std::string, double> &stageTimings, const bool useTrackingStatistics, const char *name) {
+  return useTrackingStatistics ? &stageTimings[name] : NULL;
+}
+}
+
 
 vpMbGenericTracker::vpMbGenericTracker() :
   m_error(), m_L(), m_mapOfCameraTransformationMatrix(),
   m_mapOfFeatureFactors(), m_mapOfTrackers(), m_percentageGdPt(0.4), m_referenceCameraName("Camera"),
-  m_thresholdOutlier(0.5), m_w(), m_weightedError()
+  m_thresholdOutlier(0.5), m_useParallelTracking(false), m_w(), m_weightedError(), m_posePredictor(),
+  m_frameTimestamp(0), m_frameTimestampAvailable(false), m_maxMovingEdgeRange(32),
+  m_useTrackingStatistics(false), m_trackingStatistics(), m_stageTimings(), m_nbVVSIterations(0)
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -54,7 +223,7 @@ vpMbGenericTracker::vpMbGenericTracker() :
   //Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -65,7 +234,9 @@ vpMbGenericTracker::vpMbGenericTracker() :
 vpMbGenericTracker::vpMbGenericTracker(const unsigned int nbCameras, const int trackerType) :
   m_error(), m_L(), m_mapOfCameraTransformationMatrix(),
   m_mapOfFeatureFactors(), m_mapOfTrackers(), m_percentageGdPt(0.4), m_referenceCameraName("Camera"),
-  m_thresholdOutlier(0.5), m_w(), m_weightedError()
+  m_thresholdOutlier(0.5), m_useParallelTracking(false), m_w(), m_weightedError(), m_posePredictor(),
+  m_frameTimestamp(0), m_frameTimestampAvailable(false), m_maxMovingEdgeRange(32),
+  m_useTrackingStatistics(false), m_trackingStatistics(), m_stageTimings(), m_nbVVSIterations(0)
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -91,7 +262,7 @@ vpMbGenericTracker::vpMbGenericTracker(const unsigned int nbCameras, const int t
   //Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -102,7 +273,9 @@ vpMbGenericTracker::vpMbGenericTracker(const unsigned int nbCameras, const int t
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes) :
   m_error(), m_L(), m_mapOfCameraTransformationMatrix(),
   m_mapOfFeatureFactors(), m_mapOfTrackers(), m_percentageGdPt(0.4), m_referenceCameraName("Camera"),
-  m_thresholdOutlier(0.5), m_w(), m_weightedError()
+  m_thresholdOutlier(0.5), m_useParallelTracking(false), m_w(), m_weightedError(), m_posePredictor(),
+  m_frameTimestamp(0), m_frameTimestampAvailable(false), m_maxMovingEdgeRange(32),
+  m_useTrackingStatistics(false), m_trackingStatistics(), m_stageTimings(), m_nbVVSIterations(0)
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -130,7 +303,7 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes) :
   //Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -141,7 +314,9 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes) :
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNames, const std::vector<int> &trackerTypes) :
   m_error(), m_L(), m_mapOfCameraTransformationMatrix(),
   m_mapOfFeatureFactors(), m_mapOfTrackers(), m_percentageGdPt(0.4), m_referenceCameraName("Camera"),
-  m_thresholdOutlier(0.5), m_w(), m_weightedError()
+  m_thresholdOutlier(0.5), m_useParallelTracking(false), m_w(), m_weightedError(), m_posePredictor(),
+  m_frameTimestamp(0), m_frameTimestampAvailable(false), m_maxMovingEdgeRange(32),
+  m_useTrackingStatistics(false), m_trackingStatistics(), m_stageTimings(), m_nbVVSIterations(0)
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue, "cameraNames.size() != trackerTypes.size() || cameraNames.empty()");
@@ -160,7 +335,7 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNam
   //Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -226,6 +401,9 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   vpColVector W_true(m_error.getRows());
   vpMatrix L_true, LVJ_true;
 
+  // Weight of each feature, the normal equations being accumulated from the unweighted m_L
+  vpColVector weights(m_error.getRows());
+
   //Create the map of VelocityTwistMatrices
   std::map<std::string, vpVelocityTwistMatrix> mapOfVelocityTwist;
   for(std::map<std::string, vpHomogeneousMatrix>::const_iterator it = m_mapOfCameraTransformationMatrix.begin(); it != m_mapOfCameraTransformationMatrix.end(); ++it) {
@@ -235,7 +413,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   }
 
   double factorEdge = m_mapOfFeatureFactors[EDGE_TRACKER];
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   double factorKlt = m_mapOfFeatureFactors[KLT_TRACKER];
 #endif
   double factorDepth = m_mapOfFeatureFactors[DEPTH_NORMAL_TRACKER];
@@ -252,7 +430,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
 
         tracker->cMo = m_mapOfCameraTransformationMatrix[it->first] * cMo_prev;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
         vpHomogeneousMatrix c_curr_tTc_curr0 = m_mapOfCameraTransformationMatrix[it->first] * cMo_prev * tracker->c0Mo.inverse();
         tracker->ctTc0 = c_curr_tTc_curr0;
 #endif
@@ -314,16 +492,13 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
 
             num += wi*vpMath::sqr(m_error[start_index + i]);
             den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
+            weights[start_index + i] = wi;
           }
 
           start_index += tracker->m_error_edge.getRows();
         }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
         if (tracker->m_trackerType & KLT_TRACKER) {
           for (unsigned int i = 0; i < tracker->m_error_klt.getRows(); i++) {
             double wi = tracker->m_w_klt[i] * factorKlt;
@@ -332,10 +507,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
 
             num += wi*vpMath::sqr(m_error[start_index + i]);
             den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
+            weights[start_index + i] = wi;
           }
 
           start_index += tracker->m_error_klt.getRows();
@@ -349,10 +521,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
 
             num += wi*vpMath::sqr(m_error[start_index + i]);
             den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
+            weights[start_index + i] = wi;
           }
 
           start_index += tracker->m_error_depthNormal.getRows();
@@ -365,10 +534,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
 
             num += wi*vpMath::sqr(m_error[start_index + i]);
             den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
+            weights[start_index + i] = wi;
           }
 
           start_index += tracker->m_error_depthDense.getRows();
@@ -378,13 +544,14 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
       normRes_1 = normRes;
       normRes = sqrt(num/den);
 
-      computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+      computeVVSNormalEquations(m_L, weights, m_weightedError, LTL, LTR);
+      computeVVSPoseEstimation(isoJoIdentity_, iter, LTL, LTR, m_error, error_prev, mu, v);
 
       cMo_prev = cMo;
 
       cMo = vpExponentialMap::direct(v).inverse() * cMo;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
       for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
         TrackerWrapper *tracker = it->second;
 
@@ -403,6 +570,8 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
     iter++;
   }
 
+  m_nbVVSIterations = iter;
+
   computeCovarianceMatrixVVS(isoJoIdentity_, W_true, cMo_prev, L_true, LVJ_true, m_error);
 
   for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
@@ -421,11 +590,36 @@ void vpMbGenericTracker::computeVVSInit() {
 void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages) {
   unsigned int nbFeatures = 0;
 
-  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSInit(mapOfImages[it->first]);
+  if (m_useParallelTracking) {
+    std::vector<TrackerWrapper*> trackers;
+    std::vector<const vpImage<unsigned char> *> images;
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      trackers.push_back(it->second);
+      images.push_back(mapOfImages[it->first]);
+    }
+
+    class vpComputeVVSInitTask : public vpMbCameraTask {
+    public:
+      vpComputeVVSInitTask(const std::vector<TrackerWrapper*> &trackers_,
+                           const std::vector<const vpImage<unsigned char> *> &images_)
+        : trackers(trackers_), images(images_) { }
+      void run(const size_t camera) { trackers[camera]->computeVVSInit(images[camera]); }
 
-    nbFeatures += tracker->m_error.getRows();
+      const std::vector<TrackerWrapper*> &trackers;
+      const std::vector<const vpImage<unsigned char> *> &images;
+    } task(trackers, images);
+    runPerCamera(task, trackers.size());
+
+    for (size_t i = 0; i < trackers.size(); i++) {
+      nbFeatures += trackers[i]->m_error.getRows();
+    }
+  } else {
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->computeVVSInit(mapOfImages[it->first]);
+
+      nbFeatures += tracker->m_error.getRows();
+    }
   }
 
   m_L.resize(nbFeatures, 6, false, false);
@@ -444,11 +638,63 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(std::map<std::stri
                                                               std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist) {
   unsigned int start_index = 0;
 
+  if (m_useParallelTracking) {
+    std::vector<TrackerWrapper*> trackers;
+    std::vector<const vpImage<unsigned char> *> images;
+    std::vector<vpVelocityTwistMatrix> velocityTwists;
+    std::vector<unsigned int> startIndexes;
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+
+      tracker->cMo = m_mapOfCameraTransformationMatrix[it->first]*cMo;
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+      vpHomogeneousMatrix c_curr_tTc_curr0 = m_mapOfCameraTransformationMatrix[it->first] * cMo * tracker->c0Mo.inverse();
+      tracker->ctTc0 = c_curr_tTc_curr0;
+#endif
+
+      trackers.push_back(tracker);
+      images.push_back(mapOfImages[it->first]);
+      velocityTwists.push_back(mapOfVelocityTwist[it->first]);
+      startIndexes.push_back(start_index);
+
+      // The number of features is fixed by computeVVSInit()
+      start_index += tracker->m_error.getRows();
+    }
+
+    // Each tracker fills its own block of rows in the stacked interaction matrix and residual vector
+    class vpComputeVVSInteractionMatrixTask : public vpMbCameraTask {
+    public:
+      vpComputeVVSInteractionMatrixTask(const std::vector<TrackerWrapper*> &trackers_,
+                                        const std::vector<const vpImage<unsigned char> *> &images_,
+                                        const std::vector<vpVelocityTwistMatrix> &velocityTwists_,
+                                        const std::vector<unsigned int> &startIndexes_, vpMatrix &L_, vpColVector &error_)
+        : trackers(trackers_), images(images_), velocityTwists(velocityTwists_), startIndexes(startIndexes_), L(L_),
+          error(error_) { }
+      void run(const size_t camera) {
+        TrackerWrapper *tracker = trackers[camera];
+        tracker->computeVVSInteractionMatrixAndResidu(images[camera]);
+
+        L.insert(tracker->m_L*velocityTwists[camera], startIndexes[camera], 0);
+        error.insert(startIndexes[camera], tracker->m_error);
+      }
+
+      const std::vector<TrackerWrapper*> &trackers;
+      const std::vector<const vpImage<unsigned char> *> &images;
+      const std::vector<vpVelocityTwistMatrix> &velocityTwists;
+      const std::vector<unsigned int> &startIndexes;
+      vpMatrix &L;
+      vpColVector &error;
+    } task(trackers, images, velocityTwists, startIndexes, m_L, m_error);
+    runPerCamera(task, trackers.size());
+
+    return;
+  }
+
   for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
     tracker->cMo = m_mapOfCameraTransformationMatrix[it->first]*cMo;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     vpHomogeneousMatrix c_curr_tTc_curr0 = m_mapOfCameraTransformationMatrix[it->first] * cMo * tracker->c0Mo.inverse();
     tracker->ctTc0 = c_curr_tTc_curr0;
 #endif
@@ -465,6 +711,29 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(std::map<std::stri
 void vpMbGenericTracker::computeVVSWeights() {
   unsigned int start_index = 0;
 
+  if (m_useParallelTracking) {
+    std::vector<TrackerWrapper*> trackers;
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      trackers.push_back(it->second);
+    }
+
+    class vpComputeVVSWeightsTask : public vpMbCameraTask {
+    public:
+      explicit vpComputeVVSWeightsTask(const std::vector<TrackerWrapper*> &trackers_) : trackers(trackers_) { }
+      void run(const size_t camera) { trackers[camera]->computeVVSWeights(); }
+
+      const std::vector<TrackerWrapper*> &trackers;
+    } task(trackers);
+    runPerCamera(task, trackers.size());
+
+    for (size_t i = 0; i < trackers.size(); i++) {
+      m_w.insert(start_index, trackers[i]->m_w);
+      start_index += trackers[i]->m_w.getRows();
+    }
+
+    return;
+  }
+
   for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
     tracker->computeVVSWeights();
@@ -771,7 +1040,7 @@ vpMbHiddenFaces<vpMbtPolygon>& vpMbGenericTracker::getFaces(const std::string &c
   return faces;
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Return the address of the circle feature list for the reference camera.
 */
@@ -824,7 +1093,7 @@ double vpMbGenericTracker::getGoodMovingEdgesRatioThreshold() const {
   return m_percentageGdPt;
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Get the current list of KLT points for the reference camera.
 
@@ -897,6 +1166,7 @@ int vpMbGenericTracker::getKltNbPoints() const {
   return 0;
 }
 
+#if defined(VISP_HAVE_OPENCV)
 /*!
   Get the klt tracker at the current state for the reference camera.
 
@@ -950,14 +1220,73 @@ void vpMbGenericTracker::getKltOpencv(std::map<std::string, vpKltOpencv> &mapOfK
     mapOfKlts[it->first] = tracker->getKltOpencv();
   }
 }
+#else
+/*!
+  Get the klt tracker at the current state for the reference camera.
+
+  \return klt tracker.
+*/
+vpKltTracker vpMbGenericTracker::getKltTracker() const {
+  std::map<std::string, TrackerWrapper*>::const_iterator it_tracker = m_mapOfTrackers.find(m_referenceCameraName);
+
+  if (it_tracker != m_mapOfTrackers.end()) {
+    TrackerWrapper *tracker;
+    tracker = it_tracker->second;
+    return tracker->getKltTracker();
+  } else {
+    std::cerr << "Cannot find the reference camera: " << m_referenceCameraName << "!" << std::endl;
+  }
+
+  return vpKltTracker();
+}
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+/*!
+  Get the klt tracker at the current state.
+
+  \param klt1 : Klt tracker for the first camera.
+  \param klt2 : Klt tracker for the second camera.
+
+  \note This function assumes a stereo configuration of the generic tracker.
+*/
+void vpMbGenericTracker::getKltTracker(vpKltTracker &klt1, vpKltTracker &klt2) const {
+  if (m_mapOfTrackers.size() == 2) {
+    std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin();
+    klt1 = it->second->getKltTracker();
+    ++it;
+
+    klt2 = it->second->getKltTracker();
+  } else {
+    std::cerr << "The tracker is not set as a stereo configuration! There are "
+              << m_mapOfTrackers.size() << " cameras!" << std::endl;
+  }
+}
+
+/*!
+  Get the klt tracker at the current state.
+
+  \param mapOfKlts : Map if klt trackers.
+*/
+void vpMbGenericTracker::getKltTracker(std::map<std::string, vpKltTracker> &mapOfKlts) const {
+  mapOfKlts.clear();
+
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    mapOfKlts[it->first] = tracker->getKltTracker();
+  }
+}
+#endif
+
+#if !defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020408)
 /*!
   Get the current list of KLT points for the reference camera.
 
-   \return the list of KLT points through vpKltOpencv.
+   \return the list of KLT points through vpKltOpencv, or vpKltTracker without OpenCV.
 */
+#  if defined(VISP_HAVE_OPENCV)
 std::vector<cv::Point2f> vpMbGenericTracker::getKltPoints() const {
+#  else
+std::vector<vpImagePoint> vpMbGenericTracker::getKltPoints() const {
+#  endif
   std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.find(m_referenceCameraName);
   if (it != m_mapOfTrackers.end()) {
     TrackerWrapper *tracker = it->second;
@@ -966,7 +1295,11 @@ std::vector<cv::Point2f> vpMbGenericTracker::getKltPoints() const {
     std::cerr << "Cannot find the reference camera: " << m_referenceCameraName << "!" << std::endl;
   }
 
+#if defined(VISP_HAVE_OPENCV)
   return std::vector<cv::Point2f>();
+#else
+  return std::vector<vpImagePoint>();
+#endif
 }
 #endif
 
@@ -1084,7 +1417,7 @@ void vpMbGenericTracker::getMovingEdge(vpMe &me1, vpMe &me2) const {
   }
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 
 #endif
 
@@ -1310,6 +1643,102 @@ void vpMbGenericTracker::getPose(std::map<std::string, vpHomogeneousMatrix> &map
   }
 }
 
+/*!
+  Get the region of the next image of the reference camera where the tracker
+  will extract its features. It is the bounding box of the model projected with
+  the current pose, enlarged by the displacement of the model between the two
+  last frames, the search range of the features and the margin set with
+  setPredictedRoiMargin().
+
+  It can be used to acquire, convert or filter only a part of the next image and
+  of the next point cloud: the tracker does not access the data outside of this
+  region. It is the whole image when the predicted region mode is disabled, when
+  the model is not visible or when a part of the model is behind the camera.
+
+  \return The predicted region of interest, an empty rectangle if the tracker has not been initialized.
+
+  \sa setUsePredictedRoi()
+*/
+vpRect vpMbGenericTracker::getPredictedRoi() const {
+  std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.find(m_referenceCameraName);
+
+  if (it != m_mapOfTrackers.end()) {
+    return it->second->m_predictedRoi;
+  } else {
+    std::cerr << "The reference camera: " << m_referenceCameraName << " does not exist!" << std::endl;
+  }
+
+  return vpRect();
+}
+
+/*!
+  Get the region of the next image of each camera where the tracker will
+  extract its features.
+
+  \param mapOfRois : Map of predicted regions of interest.
+
+  \sa getPredictedRoi()
+*/
+void vpMbGenericTracker::getPredictedRoi(std::map<std::string, vpRect> &mapOfRois) const {
+  mapOfRois.clear();
+
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    mapOfRois[it->first] = it->second->m_predictedRoi;
+  }
+}
+
+/*!
+  Get the margin in pixels added to the predicted region of interest of the reference camera.
+
+  \sa setPredictedRoiMargin()
+*/
+unsigned int vpMbGenericTracker::getPredictedRoiMargin() const {
+  std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.find(m_referenceCameraName);
+
+  if (it != m_mapOfTrackers.end()) {
+    return it->second->m_predictedRoiMargin;
+  } else {
+    std::cerr << "The reference camera: " << m_referenceCameraName << " does not exist!" << std::endl;
+  }
+
+  return 0;
+}
+
+/*!
+  Return true if each camera is processed by its own thread during the tracking.
+
+  \sa setUseParallelTracking
+*/
+bool vpMbGenericTracker::getUseParallelTracking() const {
+  return m_useParallelTracking;
+}
+
+/*!
+  Return true if the features of the reference camera are extracted only in the predicted region of interest.
+
+  \sa setUsePredictedRoi()
+*/
+bool vpMbGenericTracker::getUsePredictedRoi() const {
+  std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.find(m_referenceCameraName);
+
+  if (it != m_mapOfTrackers.end()) {
+    return it->second->m_usePredictedRoi;
+  } else {
+    std::cerr << "The reference camera: " << m_referenceCameraName << " does not exist!" << std::endl;
+  }
+
+  return false;
+}
+
+/*!
+  Return true if the timings and the counters of the tracking are recorded.
+
+  \sa setUseTrackingStatistics()
+*/
+bool vpMbGenericTracker::getUseTrackingStatistics() const {
+  return m_useTrackingStatistics;
+}
+
 void vpMbGenericTracker::init(const vpImage<unsigned char>& I) {
   for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
@@ -1735,6 +2164,22 @@ void vpMbGenericTracker::initFromPose(const std::map<std::string, const vpImage<
   }
 }
 
+/*!
+  Check if the moving edges of one of the cameras are displayed while they are tracked.
+
+  \return True if at least one moving edge display is enabled.
+*/
+bool vpMbGenericTracker::isMovingEdgeDisplayed() const {
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    if ((tracker->m_trackerType & EDGE_TRACKER) && tracker->isMovingEdgeDisplayed()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /*!
   Load the xml configuration file.
   From the configuration file initialize the parameters corresponding to the objects: tracking parameters, camera intrinsic parameters.
@@ -1960,11 +2405,146 @@ void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &map
 }
 
 #ifdef VISP_HAVE_PCL
-void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
-                                     std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds) {
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                      std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds) {
+  // Features are displayed during the post-tracking stage and the display is not thread-safe
+  if (m_useParallelTracking && !displayFeatures) {
+    std::vector<TrackerWrapper*> trackers;
+    std::vector<const vpImage<unsigned char> *> images;
+    std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> pointClouds;
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      trackers.push_back(it->second);
+      images.push_back(mapOfImages[it->first]);
+      pointClouds.push_back(mapOfPointClouds[it->first]);
+    }
+
+    class vpPostTrackingTask : public vpMbCameraTask {
+    public:
+      vpPostTrackingTask(const std::vector<TrackerWrapper*> &trackers_,
+                         const std::vector<const vpImage<unsigned char> *> &images_,
+                         const std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &pointClouds_)
+        : trackers(trackers_), images(images_), pointClouds(pointClouds_) { }
+      void run(const size_t camera) { trackers[camera]->postTracking(images[camera], pointClouds[camera]); }
+
+      const std::vector<TrackerWrapper*> &trackers;
+      const std::vector<const vpImage<unsigned char> *> &images;
+      const std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &pointClouds;
+    } task(trackers, images, pointClouds);
+    runPerCamera(task, trackers.size());
+  } else {
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+    }
+  }
+}
+#endif
+
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                                      std::map<std::string, unsigned int> &mapOfPointCloudHeights) {
+  // Features are displayed during the post-tracking stage and the display is not thread-safe
+  if (m_useParallelTracking && !displayFeatures) {
+    std::vector<TrackerWrapper*> trackers;
+    std::vector<const vpImage<unsigned char> *> images;
+    std::vector<unsigned int> widths, heights;
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      trackers.push_back(it->second);
+      images.push_back(mapOfImages[it->first]);
+      widths.push_back(mapOfPointCloudWidths[it->first]);
+      heights.push_back(mapOfPointCloudHeights[it->first]);
+    }
+
+    class vpPostTrackingTask : public vpMbCameraTask {
+    public:
+      vpPostTrackingTask(const std::vector<TrackerWrapper*> &trackers_,
+                         const std::vector<const vpImage<unsigned char> *> &images_,
+                         const std::vector<unsigned int> &widths_, const std::vector<unsigned int> &heights_)
+        : trackers(trackers_), images(images_), widths(widths_), heights(heights_) { }
+      void run(const size_t camera) { trackers[camera]->postTracking(images[camera], widths[camera], heights[camera]); }
+
+      const std::vector<TrackerWrapper*> &trackers;
+      const std::vector<const vpImage<unsigned char> *> &images;
+      const std::vector<unsigned int> &widths;
+      const std::vector<unsigned int> &heights;
+    } task(trackers, images, widths, heights);
+    runPerCamera(task, trackers.size());
+  } else {
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
+    }
+  }
+}
+
+/*!
+  Replace the current pose by the pose predicted at the timestamp of the new
+  images, and compute the range of the moving edges of each camera from the
+  predicted image motion of the model.
+*/
+void vpMbGenericTracker::predictPose() {
+  const double timestamp = m_frameTimestampAvailable ? m_frameTimestamp : m_posePredictor.getLastTimestamp() + 1;
+  m_frameTimestamp = timestamp;
+  m_frameTimestampAvailable = false;
+
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    it->second->m_predictedMeRange = 0;
+  }
+
+  vpHomogeneousMatrix cMo_pred;
+  if (!m_posePredictor.predict(cMo, timestamp, cMo_pred)) {
+    return;
+  }
+
   for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+    vpHomogeneousMatrix cCurrentMo = m_mapOfCameraTransformationMatrix[it->first] * cMo_pred;
+
+    if (tracker->m_trackerType & EDGE_TRACKER) {
+      const unsigned int range = tracker->me.getRange();
+      const double motion = std::ceil(tracker->computeImageMotion(cCurrentMo));
+      const unsigned int maxRange = std::max(range, m_maxMovingEdgeRange);
+      tracker->m_predictedMeRange = motion < maxRange - range ? range + (unsigned int) motion : maxRange;
+    }
+
+    tracker->cMo = cCurrentMo;
+  }
+
+  cMo = cMo_pred;
+}
+
+#ifdef VISP_HAVE_PCL
+void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                     std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds) {
+  // The moving edges may be displayed while they are tracked and the display is not thread-safe
+  if (m_useParallelTracking && !displayFeatures && !isMovingEdgeDisplayed()) {
+    std::vector<TrackerWrapper*> trackers;
+    std::vector<const vpImage<unsigned char> *> images;
+    std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> pointClouds;
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      trackers.push_back(it->second);
+      images.push_back(mapOfImages[it->first]);
+      pointClouds.push_back(mapOfPointClouds[it->first]);
+    }
+
+    class vpPreTrackingTask : public vpMbCameraTask {
+    public:
+      vpPreTrackingTask(const std::vector<TrackerWrapper*> &trackers_,
+                        const std::vector<const vpImage<unsigned char> *> &images_,
+                        const std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &pointClouds_)
+        : trackers(trackers_), images(images_), pointClouds(pointClouds_) { }
+      void run(const size_t camera) { trackers[camera]->preTracking(images[camera], pointClouds[camera]); }
+
+      const std::vector<TrackerWrapper*> &trackers;
+      const std::vector<const vpImage<unsigned char> *> &images;
+      const std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &pointClouds;
+    } task(trackers, images, pointClouds);
+    runPerCamera(task, trackers.size());
+  } else {
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+    }
   }
 }
 #endif
@@ -1973,9 +2553,51 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
                                      std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
                                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                                      std::map<std::string, unsigned int> &mapOfPointCloudHeights) {
-  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
+  preTrackingImpl(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+}
+
+template<class PointCloud>
+void vpMbGenericTracker::preTrackingImpl(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                         std::map<std::string, const PointCloud *> &mapOfPointClouds,
+                                         std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                                         std::map<std::string, unsigned int> &mapOfPointCloudHeights) {
+  // The moving edges may be displayed while they are tracked and the display is not thread-safe
+  if (m_useParallelTracking && !displayFeatures && !isMovingEdgeDisplayed()) {
+    std::vector<TrackerWrapper*> trackers;
+    std::vector<const vpImage<unsigned char> *> images;
+    std::vector<const PointCloud *> pointClouds;
+    std::vector<unsigned int> widths, heights;
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      trackers.push_back(it->second);
+      images.push_back(mapOfImages[it->first]);
+      pointClouds.push_back(mapOfPointClouds[it->first]);
+      widths.push_back(mapOfPointCloudWidths[it->first]);
+      heights.push_back(mapOfPointCloudHeights[it->first]);
+    }
+
+    class vpPreTrackingTask : public vpMbCameraTask {
+    public:
+      vpPreTrackingTask(const std::vector<TrackerWrapper*> &trackers_,
+                        const std::vector<const vpImage<unsigned char> *> &images_,
+                        const std::vector<const PointCloud *> &pointClouds_, const std::vector<unsigned int> &widths_,
+                        const std::vector<unsigned int> &heights_)
+        : trackers(trackers_), images(images_), pointClouds(pointClouds_), widths(widths_), heights(heights_) { }
+      void run(const size_t camera) {
+        trackers[camera]->preTrackingImpl(images[camera], pointClouds[camera], widths[camera], heights[camera]);
+      }
+
+      const std::vector<TrackerWrapper*> &trackers;
+      const std::vector<const vpImage<unsigned char> *> &images;
+      const std::vector<const PointCloud *> &pointClouds;
+      const std::vector<unsigned int> &widths;
+      const std::vector<unsigned int> &heights;
+    } task(trackers, images, pointClouds, widths, heights);
+    runPerCamera(task, trackers.size());
+  } else {
+    for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->preTrackingImpl(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
+    }
   }
 }
 
@@ -2136,7 +2758,7 @@ void vpMbGenericTracker::resetTracker() {
   //Reset default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -2149,6 +2771,36 @@ void vpMbGenericTracker::resetTracker() {
   }
 }
 
+/*!
+  Remove the timings and the counters of the tracking recorded since the
+  activation of the tracking statistics.
+
+  \sa setUseTrackingStatistics()
+*/
+void vpMbGenericTracker::resetTrackingStatistics() {
+  m_trackingStatistics.clear();
+}
+
+/*!
+  Set the duration of all the tracking stages of the current images to 0.
+*/
+void vpMbGenericTracker::resetStageTimings() {
+  if (!m_useTrackingStatistics) {
+    return;
+  }
+
+  for (std::map<std::string, double>::iterator it = m_stageTimings.begin(); it != m_stageTimings.end(); ++it) {
+    it->second = 0;
+  }
+
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    for (std::map<std::string, double>::iterator it_timing = tracker->m_stageTimings.begin(); it_timing != tracker->m_stageTimings.end(); ++it_timing) {
+      it_timing->second = 0;
+    }
+  }
+}
+
 /*!
   Set the angle used to test polygons appearance.
   If the angle between the normal of the polygon and the line going
@@ -2722,6 +3374,21 @@ void vpMbGenericTracker::setFeatureFactors(const std::map<vpTrackerType, double>
   }
 }
 
+/*!
+  Set the timestamp of the next image given to track(), used by the pose
+  prediction to scale the velocity of the object. It has to be called before
+  each call to track(), otherwise the images are assumed to be equally spaced
+  in time.
+
+  \param timestamp : Acquisition time of the next image, for example in seconds.
+
+  \sa setPosePrediction()
+*/
+void vpMbGenericTracker::setFrameTimestamp(const double timestamp) {
+  m_frameTimestamp = timestamp;
+  m_frameTimestampAvailable = true;
+}
+
 /*!
    Set the threshold value between 0 and 1 over good moving edges ratio. It allows to
    decide if the tracker has enough valid moving edges to compute a pose. 1 means that all
@@ -2780,7 +3447,8 @@ void vpMbGenericTracker::setNbRayCastingAttemptsForVisibility(const unsigned int
 }
 #endif
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_OPENCV)
 /*!
   Set the new value of the klt tracker.
 
@@ -2830,6 +3498,57 @@ void vpMbGenericTracker::setKltOpencv(const std::map<std::string, vpKltOpencv> &
     }
   }
 }
+#else
+/*!
+  Set the new value of the klt tracker.
+
+  \param t : Klt tracker containing the new values.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setKltTracker(const vpKltTracker &t) {
+  for(std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setKltTracker(t);
+  }
+}
+
+/*!
+  Set the new value of the klt tracker.
+
+  \param t1 : Klt tracker containing the new values for the first camera.
+  \param t2 : Klt tracker containing the new values for the second camera.
+
+  \note This function assumes a stereo configuration of the generic tracker.
+*/
+void vpMbGenericTracker::setKltTracker(const vpKltTracker &t1, const vpKltTracker &t2) {
+  if (m_mapOfTrackers.size() == 2) {
+    std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin();
+    it->second->setKltTracker(t1);
+
+    ++it;
+    it->second->setKltTracker(t2);
+  } else {
+    throw vpException(vpTrackingException::fatalError, "Require two cameras! There are %d cameras!", m_mapOfTrackers.size());
+  }
+}
+
+/*!
+  Set the new value of the klt tracker.
+
+  \param mapOfKlts : Map of klt tracker containing the new values.
+*/
+void vpMbGenericTracker::setKltTracker(const std::map<std::string, vpKltTracker> &mapOfKlts) {
+  for (std::map<std::string, vpKltTracker>::const_iterator it = mapOfKlts.begin(); it != mapOfKlts.end(); ++it) {
+    std::map<std::string, TrackerWrapper*>::const_iterator it_tracker = m_mapOfTrackers.find(it->first);
+
+    if (it_tracker != m_mapOfTrackers.end()) {
+      TrackerWrapper *tracker = it_tracker->second;
+      tracker->setKltTracker(it->second);
+    }
+  }
+}
+#endif
 
 /*!
   Set the threshold for the acceptation of a point.
@@ -2866,7 +3585,7 @@ void vpMbGenericTracker::setLod(const bool useLod, const std::string &name) {
   }
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Set the erosion of the mask used on the Model faces.
 
@@ -2953,6 +3672,24 @@ void vpMbGenericTracker::setMinPolygonAreaThresh(const double minPolygonAreaThre
   }
 }
 
+/*!
+  Set the directory where the binary model cache files are stored.
+
+  \param directory : Directory of the cache files, the cache is disabled if it is empty.
+
+  \sa vpMbTracker::setModelCacheDirectory()
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setModelCacheDirectory(const std::string &directory) {
+  vpMbTracker::setModelCacheDirectory(directory);
+
+  for(std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setModelCacheDirectory(directory);
+  }
+}
+
 /*!
   Set the moving edge parameters.
 
@@ -3004,6 +3741,21 @@ void vpMbGenericTracker::setMovingEdge(const std::map<std::string, vpMe> &mapOfM
   }
 }
 
+/*!
+  Set the maximum range of the moving edges when it is adapted to the predicted
+  motion of the object. When a pose prediction is used, see setPosePrediction(),
+  the moving edges of each camera are searched in the range of vpMe increased
+  by the predicted image motion of the model, up to this maximum. A small vpMe
+  range can then be used without losing the tracking during fast motions.
+
+  \param maxRange : Maximum range in pixels, the range of vpMe is used if it is greater. Default is 32.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setMovingEdgeMaxRange(const unsigned int maxRange) {
+  m_maxMovingEdgeRange = maxRange;
+}
+
 /*!
   Set the near distance for clipping.
 
@@ -3248,6 +4000,43 @@ void vpMbGenericTracker::setPose(const std::map<std::string, const vpImage<unsig
   }
 }
 
+/*!
+  Set the prediction of the pose used at the beginning of each call to track().
+  With a prediction, the virtual visual servoing starts from the pose
+  extrapolated from the velocity of the object in the previous images instead of
+  the previous pose, and the range of the moving edges is adapted to the
+  predicted motion, see setMovingEdgeMaxRange(). The timestamps of the images
+  can be given with setFrameTimestamp().
+
+  The previous poses are discarded, as after each initialization of the tracker.
+
+  \param type : Type of prediction. Default is vpMbtPosePredictor::NO_PREDICTION.
+
+  \sa getPosePredictor()
+*/
+void vpMbGenericTracker::setPosePrediction(const vpMbtPosePredictor::vpPredictionType &type) {
+  m_posePredictor.setPredictionType(type);
+}
+
+/*!
+  Set the margin in pixels added to the predicted region of interest, on top
+  of the displacement of the model between the two last frames and of the
+  search range of the features. It has to account for the accelerations of the
+  object.
+
+  \param margin : Margin in pixels. Default is 20.
+
+  \note This function will set the new parameter for all the cameras.
+
+  \sa setUsePredictedRoi()
+*/
+void vpMbGenericTracker::setPredictedRoiMargin(const unsigned int margin) {
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->m_predictedRoiMargin = margin;
+  }
+}
+
 /*!
   Set if the projection error criteria has to be computed. This criteria could be used to
   detect the quality of the tracking. It computes an angle between 0 and 90 degrees that is
@@ -3325,6 +4114,18 @@ void vpMbGenericTracker::setTrackerType(const std::map<std::string, int> &mapOfT
   }
 }
 
+/*!
+  Set the number of images used to compute the statistics of the timings and
+  of the counters of the tracking. The recorded values are removed.
+
+  \param windowSize : Number of last images. Default is 100.
+
+  \sa setUseTrackingStatistics()
+*/
+void vpMbGenericTracker::setTrackingStatisticsWindowSize(const unsigned int windowSize) {
+  m_trackingStatistics.setWindowSize(windowSize);
+}
+
 /*!
   Set if the polygons that have the given name have to be considered during the tracking phase.
 
@@ -3340,7 +4141,7 @@ void vpMbGenericTracker::setUseEdgeTracking(const std::string &name, const bool
   }
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Set if the polygons that have the given name have to be considered during the tracking phase.
 
@@ -3357,6 +4158,108 @@ void vpMbGenericTracker::setUseKltTracking(const std::string &name, const bool &
 }
 #endif
 
+/*!
+  Enable or disable the predicted region of interest mode. When enabled, the
+  tracker computes after each frame the region of the next image where the model
+  is expected, see getPredictedRoi(), and the KLT tracker updates only this
+  region of its image. The moving-edges and the depth features are always
+  extracted around the projection of the model and stay in this region.
+
+  \param use : If true, restrict the processing of the next images to the predicted region. Default is false.
+
+  \note This function will set the new parameter for all the cameras.
+  \note The predicted region is computed from the visible faces, the model has to be initialized
+  with a pose (initClick(), initFromPose() or setPose()) to get it.
+*/
+void vpMbGenericTracker::setUsePredictedRoi(const bool use) {
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->m_usePredictedRoi = use;
+  }
+}
+
+/*!
+  Enable or disable the recording of the timings and the counters of each call
+  to track(), see getTrackingStatistics().
+
+  The duration of the following stages is recorded for the whole tracker:
+  - \e prediction : pose prediction, see setPosePrediction(),
+  - \e pre_tracking : features extraction in all the cameras,
+  - \e vvs : pose estimation by virtual visual servoing,
+  - \e post_tracking : tracking failure test, visibility and features update,
+  - \e projection_error : projection error computation,
+  - \e total : whole call to track().
+
+  The duration of the following stages is recorded for each camera, depending
+  on its tracker type:
+  - \e me_tracking and \e me_update : moving-edges search and update,
+  - \e klt_tracking and \e klt_update : KLT points tracking and update,
+  - \e depth_normal_sampling and \e depth_dense_sampling : point cloud segmentation,
+  - \e visibility : faces visibility test.
+
+  The counters are the number of iterations of the virtual visual servoing
+  \e vvs_iterations, the number of residuals \e features and, if it is computed,
+  the \e projection_error in degrees, for the whole tracker. For each camera, the
+  counters are the number of visible faces \e visible_faces, the moving-edges
+  search range \e me_range and the number of residuals \e edge_features,
+  \e klt_features, \e depth_normal_features and \e depth_dense_features.
+
+  The durations are measured with vpTime::measureTimeMs() only when the
+  statistics are enabled.
+
+  \param use : If true, record the timings and the counters. Default is false.
+
+  \sa vpMbtTrackingStatistics::saveJson()
+*/
+void vpMbGenericTracker::setUseTrackingStatistics(const bool use) {
+  m_useTrackingStatistics = use;
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->m_useTrackingStatistics = use;
+  }
+}
+
+/*!
+  Enable or disable the parallel tracking of the moving edges of the lines, for the edge
+  tracker of each camera.
+
+  \param use : If true, track the lines in parallel. Default is true.
+
+  \sa vpMbEdgeTracker::setUseParallelMovingEdgeTracking()
+*/
+void vpMbGenericTracker::setUseParallelMovingEdgeTracking(const bool use) {
+  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setUseParallelMovingEdgeTracking(use);
+  }
+}
+
+/*!
+  Enable or disable the parallel tracking mode. When enabled, the moving-edges, KLT and depth
+  features extraction and the computation of the interaction matrix of each camera are done
+  in their own thread. Only the resolution of the stacked system is done sequentially.
+  This is useful for multi-camera setups where the per-frame processing time becomes close to
+  the processing time of the slowest camera instead of the sum.
+
+  \param use : If true, use one thread per camera. Default is false.
+
+  \note OpenMP is required, otherwise the cameras are processed sequentially.
+  \note When the display of the features is enabled, the post-tracking stage is done sequentially.
+  \note An exception raised for one camera is rethrown once all the cameras are processed. When
+  several cameras fail, the exception of the first camera in the order of the trackers is rethrown.
+  With C++11 it is the original exception. Otherwise vpTrackingException, vpMatrixException and
+  std::bad_alloc keep their type, other vpException are rethrown as vpException and other
+  std::exception as std::runtime_error.
+*/
+void vpMbGenericTracker::setUseParallelTracking(const bool use) {
+  m_useParallelTracking = use;
+#if !defined(VISP_HAVE_OPENMP)
+  if (use) {
+    std::cerr << "OpenMP is needed to use the parallel tracking mode, cameras are processed sequentially." << std::endl;
+  }
+#endif
+}
+
 void vpMbGenericTracker::testTracking() {
   //Test tracking fails only if all testTracking have failed
   bool isOneTestTrackingOk = false;
@@ -3454,7 +4357,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     TrackerWrapper *tracker = it->second;
 
     if ( (tracker->m_trackerType & (EDGE_TRACKER |
-                                #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                                #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                                     KLT_TRACKER |
                                 #endif
                                     DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0 ) {
@@ -3462,7 +4365,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-                              #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                              #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                                   | KLT_TRACKER
                               #endif
                                   ) && mapOfImages[it->first] == NULL) {
@@ -3474,24 +4377,42 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
   }
 
-  preTracking(mapOfImages, mapOfPointClouds);
+  const double trackingStart = m_useTrackingStatistics ? vpTime::measureTimeMs() : 0;
+  resetStageTimings();
+
+  {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "prediction"));
+    predictPose();
+  }
+
+  {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "pre_tracking"));
+    preTracking(mapOfImages, mapOfPointClouds);
+  }
 
   try {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "vvs"));
     computeVVS(mapOfImages);
   } catch (...) {
     covarianceMatrix = -1;
     throw; // throw the original exception
   }
 
-  testTracking();
+  {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "post_tracking"));
+    testTracking();
 
-  for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
+    postTracking(mapOfImages, mapOfPointClouds);
+  }
 
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+  {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "projection_error"));
+    computeProjectionError();
   }
 
-  computeProjectionError();
+  updatePosePrediction();
+
+  updateTrackingStatistics(trackingStart);
 }
 #endif
 
@@ -3509,11 +4430,44 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
                                std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
                                std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                                std::map<std::string, unsigned int> &mapOfPointCloudHeights) {
+  trackImpl(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+}
+
+/*!
+  Realize the tracking of the object in the image.
+
+  Contrary to a std::vector<vpColVector>, filling a vpPointCloud acquired from a depth camera does not need one
+  memory allocation per point.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfImages : Map of images.
+  \param mapOfPointClouds : Map of organized pointclouds, the width and the height of each depth image being given by
+  vpPointCloud::getWidth() and vpPointCloud::getHeight().
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                               std::map<std::string, const vpPointCloud *> &mapOfPointClouds) {
+  std::map<std::string, unsigned int> mapOfPointCloudWidths, mapOfPointCloudHeights;
+  for (std::map<std::string, const vpPointCloud *>::const_iterator it = mapOfPointClouds.begin(); it != mapOfPointClouds.end(); ++it) {
+    if (it->second != NULL) {
+      mapOfPointCloudWidths[it->first] = it->second->getWidth();
+      mapOfPointCloudHeights[it->first] = it->second->getHeight();
+    }
+  }
+
+  trackImpl(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+}
+
+template<class PointCloud>
+void vpMbGenericTracker::trackImpl(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                   std::map<std::string, const PointCloud *> &mapOfPointClouds,
+                                   std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                                   std::map<std::string, unsigned int> &mapOfPointCloudHeights) {
   for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
     if ( (tracker->m_trackerType & (EDGE_TRACKER |
-                                #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                                #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                                     KLT_TRACKER |
                                 #endif
                                     DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0 ) {
@@ -3521,7 +4475,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-                              #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                              #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                                   | KLT_TRACKER
                               #endif
                                   ) && mapOfImages[it->first] == NULL) {
@@ -3533,30 +4487,110 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
   }
 
-  preTracking(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+  const double trackingStart = m_useTrackingStatistics ? vpTime::measureTimeMs() : 0;
+  resetStageTimings();
+
+  {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "prediction"));
+    predictPose();
+  }
+
+  {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "pre_tracking"));
+    preTrackingImpl(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+  }
 
   try {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "vvs"));
     computeVVS(mapOfImages);
   } catch (...) {
     covarianceMatrix = -1;
     throw; // throw the original exception
   }
 
-  testTracking();
+  {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "post_tracking"));
+    testTracking();
+
+    postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
+  }
+
+  {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "projection_error"));
+    computeProjectionError();
+  }
+
+  updatePosePrediction();
+
+  updateTrackingStatistics(trackingStart);
+}
+
+/*!
+  Give the pose estimated in the current images to the pose predictor.
+*/
+void vpMbGenericTracker::updatePosePrediction() {
+  m_posePredictor.update(cMo, m_frameTimestamp);
+}
+
+/*!
+  Add the timings and the counters of the current images to the tracking
+  statistics.
+
+  \param trackingStart : Time in ms at the beginning of track().
+*/
+void vpMbGenericTracker::updateTrackingStatistics(const double trackingStart) {
+  if (!m_useTrackingStatistics) {
+    return;
+  }
+
+  m_stageTimings["total"] = vpTime::measureTimeMs() - trackingStart;
+  for (std::map<std::string, double>::const_iterator it = m_stageTimings.begin(); it != m_stageTimings.end(); ++it) {
+    m_trackingStatistics.addTiming("", it->first, it->second);
+  }
+  m_trackingStatistics.addCounter("", "vvs_iterations", m_nbVVSIterations);
+  m_trackingStatistics.addCounter("", "features", m_error.getRows());
+  if (computeProjError) {
+    m_trackingStatistics.addCounter("", "projection_error", projectionError);
+  }
 
   for (std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
+    for (std::map<std::string, double>::const_iterator it_timing = tracker->m_stageTimings.begin(); it_timing != tracker->m_stageTimings.end(); ++it_timing) {
+      m_trackingStatistics.addTiming(it->first, it_timing->first, it_timing->second);
+    }
 
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-  }
+    unsigned int nbVisibleFaces = 0;
+    for (unsigned int i = 0; i < tracker->faces.size(); i++) {
+      if (tracker->faces[i]->isVisible()) {
+        nbVisibleFaces++;
+      }
+    }
+    m_trackingStatistics.addCounter(it->first, "visible_faces", nbVisibleFaces);
 
-  computeProjectionError();
+    if (tracker->m_trackerType & EDGE_TRACKER) {
+      m_trackingStatistics.addCounter(it->first, "me_range", std::max(tracker->me.getRange(), tracker->m_predictedMeRange));
+      m_trackingStatistics.addCounter(it->first, "edge_features", tracker->m_error_edge.getRows());
+    }
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+    if (tracker->m_trackerType & KLT_TRACKER) {
+      m_trackingStatistics.addCounter(it->first, "klt_features", tracker->m_error_klt.getRows());
+    }
+#endif
+    if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+      m_trackingStatistics.addCounter(it->first, "depth_normal_features", tracker->m_error_depthNormal.getRows());
+    }
+    if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
+      m_trackingStatistics.addCounter(it->first, "depth_dense_features", tracker->m_error_depthDense.getRows());
+    }
+  }
 }
 
 
 /** TrackerWrapper **/
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper() :
-  m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError()
+  m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError(), m_usePredictedRoi(false),
+  m_predictedRoiMargin(20), m_predictedRoi(), m_predictedRoiPose(), m_predictedRoiPoseAvailable(false),
+  m_predictedMeRange(0), m_useTrackingStatistics(false), m_stageTimings()
 {
   m_lambda = 1.0;
   m_maxIter = 30;
@@ -3567,10 +4601,12 @@ vpMbGenericTracker::TrackerWrapper::TrackerWrapper() :
 }
 
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper(const int trackerType) :
-  m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError()
+  m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError(), m_usePredictedRoi(false),
+  m_predictedRoiMargin(20), m_predictedRoi(), m_predictedRoiPose(), m_predictedRoiPoseAvailable(false),
+  m_predictedMeRange(0), m_useTrackingStatistics(false), m_stageTimings()
 {
   if ( (m_trackerType & (EDGE_TRACKER |
-                      #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                      #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                          KLT_TRACKER |
                       #endif
                          DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0 ) {
@@ -3600,7 +4636,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
   unsigned int iter = 0;
 
   double factorEdge = 1.0;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   double factorKlt = 1.0;
 #endif
   double factorDepth = 1.0;
@@ -3612,7 +4648,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
   double mu = m_initialMu;
   vpHomogeneousMatrix cMo_prev;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   vpHomogeneousMatrix ctTc0_Prev; //Only for KLT
 #endif
   bool isoJoIdentity_ = true;
@@ -3621,8 +4657,11 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
   vpColVector W_true(m_error.getRows());
   vpMatrix L_true, LVJ_true;
 
+  // Weight of each feature, the normal equations being accumulated from the unweighted m_L
+  vpColVector weights(m_error.getRows());
+
   unsigned int nb_edge_features = m_error_edge.getRows();
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   unsigned int nb_klt_features = m_error_klt.getRows();
 #endif
   unsigned int nb_depth_features = m_error_depthNormal.getRows();
@@ -3635,7 +4674,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
     bool reStartFromLastIncrement = false;
     computeVVSCheckLevenbergMarquardt(iter, m_error, error_prev, cMo_prev, mu, reStartFromLastIncrement);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     if (reStartFromLastIncrement) {
       if (m_trackerType & KLT_TRACKER) {
         ctTc0 = ctTc0_Prev;
@@ -3695,16 +4734,13 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
           num += wi*vpMath::sqr(m_error[i]);
           den += wi;
-
-          for (unsigned int j = 0; j < m_L.getCols(); j++) {
-            m_L[i][j] *= wi;
-          }
+          weights[i] = wi;
         }
 
         start_index += nb_edge_features;
       }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
       if (m_trackerType & KLT_TRACKER) {
         for (unsigned int i = 0; i < nb_klt_features; i++) {
           double wi = m_w_klt[i] * factorKlt;
@@ -3713,10 +4749,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
           num += wi*vpMath::sqr(m_error[start_index + i]);
           den += wi;
-
-          for (unsigned int j = 0; j < m_L.getCols(); j++) {
-            m_L[start_index + i][j] *= wi;
-          }
+          weights[start_index + i] = wi;
         }
 
         start_index += nb_klt_features;
@@ -3731,10 +4764,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
           num += wi*vpMath::sqr(m_error[start_index + i]);
           den += wi;
-
-          for (unsigned int j = 0; j < m_L.getCols(); j++) {
-            m_L[start_index + i][j] *= wi;
-          }
+          weights[start_index + i] = wi;
         }
 
         start_index += nb_depth_features;
@@ -3748,20 +4778,18 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
           num += wi*vpMath::sqr(m_error[start_index + i]);
           den += wi;
-
-          for (unsigned int j = 0; j < m_L.getCols(); j++) {
-            m_L[start_index + i][j] *= wi;
-          }
+          weights[start_index + i] = wi;
         }
 
 //        start_index += nb_depth_dense_features;
       }
 
 
-      computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+      computeVVSNormalEquations(m_L, weights, m_weightedError, LTL, LTR);
+      computeVVSPoseEstimation(isoJoIdentity_, iter, LTL, LTR, m_error, error_prev, mu, v);
 
       cMo_prev = cMo;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
       if (m_trackerType & KLT_TRACKER) {
         ctTc0_Prev = ctTc0;
       }
@@ -3769,7 +4797,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
       cMo = vpExponentialMap::direct(v).inverse() * cMo;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
       if (m_trackerType & KLT_TRACKER) {
         ctTc0 = vpExponentialMap::direct(v).inverse() * ctTc0;
       }
@@ -3807,7 +4835,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInit(const vpImage<unsigned c
     m_w_edge.clear();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
     vpMbKltTracker::computeVVSInit();
     nbFeatures += m_error_klt.getRows();
@@ -3856,7 +4884,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
     vpMbEdgeTracker::computeVVSInteractionMatrixAndResidu(*ptr_I);
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
     vpMbKltTracker::computeVVSInteractionMatrixAndResidu();
   }
@@ -3878,7 +4906,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
     start_index += m_error_edge.getRows();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
     m_L.insert(m_L_klt, start_index, 0);
     m_error.insert(start_index, m_error_klt);
@@ -3912,7 +4940,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSWeights() {
     start_index += m_w_edge.getRows();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
     vpMbTracker::computeVVSWeights(m_robust_klt, m_error_klt, m_w_klt);
     m_w.insert(start_index, m_w_klt);
@@ -3942,7 +4970,7 @@ void vpMbGenericTracker::TrackerWrapper::display(const vpImage<unsigned char>& I
                              const vpColor& col , const unsigned int thickness, const bool displayFullModel) {
   if ( m_trackerType == EDGE_TRACKER ) {
     vpMbEdgeTracker::display(I, cMo_, camera, col, thickness, displayFullModel);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   } else if ( m_trackerType == KLT_TRACKER) {
     vpMbKltTracker::display(I, cMo_, camera, col, thickness, displayFullModel);
 #endif
@@ -3971,7 +4999,7 @@ void vpMbGenericTracker::TrackerWrapper::display(const vpImage<unsigned char>& I
       }
     }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     if (m_trackerType & KLT_TRACKER) {
       for(std::list<vpMbtDistanceKltPoints*>::const_iterator it=kltPolygons.begin(); it!=kltPolygons.end(); ++it){
         vpMbtDistanceKltPoints *kltpoly = *it;
@@ -4007,7 +5035,7 @@ void vpMbGenericTracker::TrackerWrapper::display(const vpImage<vpRGBa>& I, const
                              const vpColor& col , const unsigned int thickness, const bool displayFullModel) {
   if ( m_trackerType == EDGE_TRACKER ) {
     vpMbEdgeTracker::display(I, cMo_, camera, col, thickness, displayFullModel);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   } else if ( m_trackerType == KLT_TRACKER ) {
     vpMbKltTracker::display(I, cMo_, camera, col, thickness, displayFullModel);
 #endif
@@ -4036,7 +5064,7 @@ void vpMbGenericTracker::TrackerWrapper::display(const vpImage<vpRGBa>& I, const
       }
     }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     if (m_trackerType & KLT_TRACKER) {
       for(std::list<vpMbtDistanceKltPoints*>::const_iterator it=kltPolygons.begin(); it!=kltPolygons.end(); ++it){
         vpMbtDistanceKltPoints *kltpoly = *it;
@@ -4103,7 +5131,7 @@ void vpMbGenericTracker::TrackerWrapper::init(const vpImage<unsigned char>& I) {
     faces.computeScanLineRender(cam, I.getWidth(), I.getHeight());
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::reinit(I);
 #endif
@@ -4122,6 +5150,8 @@ void vpMbGenericTracker::TrackerWrapper::init(const vpImage<unsigned char>& I) {
 
   if (m_trackerType & DEPTH_DENSE_TRACKER)
     vpMbDepthDenseTracker::computeVisibility(I.getWidth(), I.getHeight()); //vpMbDepthDenseTracker::init(I);
+
+  updatePredictedRoi(I.getWidth(), I.getHeight(), false);
 }
 
 void vpMbGenericTracker::TrackerWrapper::initCircle(const vpPoint& p1, const vpPoint &p2, const vpPoint &p3, const double radius,
@@ -4135,7 +5165,7 @@ void vpMbGenericTracker::TrackerWrapper::initCylinder(const vpPoint& p1, const v
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initCylinder(p1, p2, radius, idFace, name);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initCylinder(p1, p2, radius, idFace, name);
 #endif
@@ -4145,7 +5175,7 @@ void vpMbGenericTracker::TrackerWrapper::initFaceFromCorners(vpMbtPolygon &polyg
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initFaceFromCorners(polygon);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initFaceFromCorners(polygon);
 #endif
@@ -4161,7 +5191,7 @@ void vpMbGenericTracker::TrackerWrapper::initFaceFromLines(vpMbtPolygon &polygon
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initFaceFromLines(polygon);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initFaceFromLines(polygon);
 #endif
@@ -4199,7 +5229,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string& confi
   xmlp.setKltHarrisParam(0.01);
   xmlp.setKltBlockSize(3);
   xmlp.setKltPyramidLevels(3);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   xmlp.setKltMaskBorder(maskBorder);
 #endif
 
@@ -4222,7 +5252,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string& confi
     std::vector<std::string> tracker_names;
     if (m_trackerType & EDGE_TRACKER)
       tracker_names.push_back("Edge");
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     if (m_trackerType & KLT_TRACKER)
       tracker_names.push_back("Klt");
 #endif
@@ -4279,7 +5309,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string& confi
   vpMbEdgeTracker::setMovingEdge(meParser);
 
   //KLT
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   tracker.setMaxFeatures((int)xmlp.getKltMaxFeatures());
   tracker.setWindowSize((int)xmlp.getKltWindowSize());
   tracker.setQuality(xmlp.getKltQuality());
@@ -4315,9 +5345,10 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
     }
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   //KLT
   if (m_trackerType & KLT_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "klt_update"));
     if (vpMbKltTracker::postTracking(*ptr_I, m_w_klt)) {
       vpMbKltTracker::reinit(*ptr_I);
     }
@@ -4326,6 +5357,7 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
 
   // Looking for new visible face
   if (m_trackerType & EDGE_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "visibility"));
     bool newvisibleface = false ;
     vpMbEdgeTracker::visibleFace(*ptr_I, cMo, newvisibleface);
 
@@ -4336,15 +5368,20 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
   }
 
   //Depth normal
-  if (m_trackerType & DEPTH_NORMAL_TRACKER)
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "visibility"));
     vpMbDepthNormalTracker::computeVisibility(point_cloud->width, point_cloud->height);
+  }
 
   //Depth dense
-  if (m_trackerType & DEPTH_DENSE_TRACKER)
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "visibility"));
     vpMbDepthDenseTracker::computeVisibility(point_cloud->width, point_cloud->height);
+  }
 
   //Edge
   if (m_trackerType & EDGE_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "me_update"));
     vpMbEdgeTracker::updateMovingEdge(*ptr_I);
 
     vpMbEdgeTracker::initMovingEdge(*ptr_I, cMo);
@@ -4355,22 +5392,42 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
       vpMbEdgeTracker::computeProjectionError(*ptr_I);
     }
   }
+
+  if (ptr_I != NULL) {
+    updatePredictedRoi(ptr_I->getWidth(), ptr_I->getHeight(), true);
+  } else {
+    updatePredictedRoi(point_cloud->width, point_cloud->height, true);
+  }
 }
 
 void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> * const ptr_I, const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud) {
   if (m_trackerType & EDGE_TRACKER) {
+    // The range of vpMe is shared by all the moving edges
+    const unsigned int range = me.getRange();
+    if (m_predictedMeRange > range) {
+      me.setRange(m_predictedMeRange);
+    }
+
     try {
+      vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "me_tracking"));
       vpMbEdgeTracker::trackMovingEdge(*ptr_I);
     } catch (...) {
+      me.setRange(range);
       std::cerr << "Error in moving edge tracking" << std::endl;
       throw;
     }
+    me.setRange(range);
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
     try {
-      vpMbKltTracker::preTracking(*ptr_I);
+      vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "klt_tracking"));
+      if (m_usePredictedRoi) {
+        vpMbKltTracker::preTracking(*ptr_I, m_predictedRoi);
+      } else {
+        vpMbKltTracker::preTracking(*ptr_I);
+      }
     } catch (vpException &e) {
       std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
       throw;
@@ -4380,6 +5437,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
 
   if (m_trackerType & DEPTH_NORMAL_TRACKER) {
     try {
+      vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "depth_normal_sampling"));
       vpMbDepthNormalTracker::segmentPointCloud(point_cloud);
     } catch (...) {
       std::cerr << "Error in Depth normal tracking" << std::endl;
@@ -4389,6 +5447,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
     try {
+      vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "depth_dense_sampling"));
       vpMbDepthDenseTracker::segmentPointCloud(point_cloud);
     } catch (...) {
       std::cerr << "Error in Depth dense tracking" << std::endl;
@@ -4406,9 +5465,10 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
     }
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   //KLT
   if (m_trackerType & KLT_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "klt_update"));
     if (vpMbKltTracker::postTracking(*ptr_I, m_w_klt)) {
       vpMbKltTracker::reinit(*ptr_I);
     }
@@ -4417,6 +5477,7 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
 
   // Looking for new visible face
   if (m_trackerType & EDGE_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "visibility"));
     bool newvisibleface = false ;
     vpMbEdgeTracker::visibleFace(*ptr_I, cMo, newvisibleface);
 
@@ -4427,15 +5488,20 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
   }
 
   //Depth normal
-  if (m_trackerType & DEPTH_NORMAL_TRACKER)
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "visibility"));
     vpMbDepthNormalTracker::computeVisibility(pointcloud_width, pointcloud_height);
+  }
 
   //Depth dense
-  if (m_trackerType & DEPTH_DENSE_TRACKER)
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "visibility"));
     vpMbDepthDenseTracker::computeVisibility(pointcloud_width, pointcloud_height);
+  }
 
   //Edge
   if (m_trackerType & EDGE_TRACKER) {
+    vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "me_update"));
     vpMbEdgeTracker::updateMovingEdge(*ptr_I);
 
     vpMbEdgeTracker::initMovingEdge(*ptr_I, cMo);
@@ -4446,23 +5512,49 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
       vpMbEdgeTracker::computeProjectionError(*ptr_I);
     }
   }
+
+  if (ptr_I != NULL) {
+    updatePredictedRoi(ptr_I->getWidth(), ptr_I->getHeight(), true);
+  } else {
+    updatePredictedRoi(pointcloud_width, pointcloud_height, true);
+  }
 }
 
 void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> * const ptr_I, const std::vector<vpColVector> * const point_cloud,
                                                      const unsigned int pointcloud_width, const unsigned int pointcloud_height) {
+  preTrackingImpl(ptr_I, point_cloud, pointcloud_width, pointcloud_height);
+}
+
+template<class PointCloud>
+void vpMbGenericTracker::TrackerWrapper::preTrackingImpl(const vpImage<unsigned char> * const ptr_I, const PointCloud * const point_cloud,
+                                                         const unsigned int pointcloud_width, const unsigned int pointcloud_height) {
   if (m_trackerType & EDGE_TRACKER) {
+    // The range of vpMe is shared by all the moving edges
+    const unsigned int range = me.getRange();
+    if (m_predictedMeRange > range) {
+      me.setRange(m_predictedMeRange);
+    }
+
     try {
+      vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "me_tracking"));
       vpMbEdgeTracker::trackMovingEdge(*ptr_I);
     } catch (...) {
+      me.setRange(range);
       std::cerr << "Error in moving edge tracking" << std::endl;
       throw;
     }
+    me.setRange(range);
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
     try {
-      vpMbKltTracker::preTracking(*ptr_I);
+      vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "klt_tracking"));
+      if (m_usePredictedRoi) {
+        vpMbKltTracker::preTracking(*ptr_I, m_predictedRoi);
+      } else {
+        vpMbKltTracker::preTracking(*ptr_I);
+      }
     } catch (vpException &e) {
       std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
       throw;
@@ -4472,7 +5564,8 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
 
   if (m_trackerType & DEPTH_NORMAL_TRACKER) {
     try {
-      vpMbDepthNormalTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
+      vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "depth_normal_sampling"));
+      vpMbDepthNormalTracker::segmentPointCloudImpl(*point_cloud, pointcloud_width, pointcloud_height);
     } catch (...) {
       std::cerr << "Error in Depth tracking" << std::endl;
       throw;
@@ -4481,7 +5574,8 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
     try {
-      vpMbDepthDenseTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
+      vpMbtTrackingStatistics::vpScopedTimer timer(stageTiming(m_stageTimings, m_useTrackingStatistics, "depth_dense_sampling"));
+      vpMbDepthDenseTracker::segmentPointCloudImpl(*point_cloud, pointcloud_width, pointcloud_height);
     } catch (...) {
       std::cerr << "Error in Depth dense tracking" << std::endl;
       throw;
@@ -4531,8 +5625,8 @@ void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char
 
 
   //KLT
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-#  if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#  if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
   if(cur != NULL){
     cvReleaseImage(&cur);
     cur = NULL;
@@ -4597,7 +5691,7 @@ void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char
 
 void vpMbGenericTracker::TrackerWrapper::resetTracker() {
   vpMbEdgeTracker::resetTracker();
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   vpMbKltTracker::resetTracker();
 #endif
   vpMbDepthNormalTracker::resetTracker();
@@ -4608,7 +5702,7 @@ void vpMbGenericTracker::TrackerWrapper::setCameraParameters(const vpCameraParam
   this->cam = camera;
 
   vpMbEdgeTracker::setCameraParameters(cam);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   vpMbKltTracker::setCameraParameters(cam);
 #endif
   vpMbDepthNormalTracker::setCameraParameters(cam);
@@ -4637,7 +5731,7 @@ void vpMbGenericTracker::TrackerWrapper::setOgreVisibilityTest(const bool &v) {
 void vpMbGenericTracker::TrackerWrapper::setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix& cdMo) {
   bool performKltSetPose = false;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
     performKltSetPose = true;
 
@@ -4688,6 +5782,8 @@ void vpMbGenericTracker::TrackerWrapper::setPose(const vpImage<unsigned char> &I
 
   //Depth dense
   vpMbDepthDenseTracker::computeVisibility(I.getWidth(), I.getHeight());
+
+  updatePredictedRoi(I.getWidth(), I.getHeight(), false);
 }
 
 void vpMbGenericTracker::TrackerWrapper::setProjectionErrorComputation(const bool &flag) {
@@ -4696,7 +5792,7 @@ void vpMbGenericTracker::TrackerWrapper::setProjectionErrorComputation(const boo
 
 void vpMbGenericTracker::TrackerWrapper::setScanLineVisibilityTest(const bool &v) {
   vpMbEdgeTracker::setScanLineVisibilityTest(v);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   vpMbKltTracker::setScanLineVisibilityTest(v);
 #endif
   vpMbDepthNormalTracker::setScanLineVisibilityTest(v);
@@ -4705,7 +5801,7 @@ void vpMbGenericTracker::TrackerWrapper::setScanLineVisibilityTest(const bool &v
 
 void vpMbGenericTracker::TrackerWrapper::setTrackerType(const int type) {
   if ( (type & (EDGE_TRACKER |
-              #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+              #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                 KLT_TRACKER |
               #endif
                 DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0 ) {
@@ -4721,13 +5817,112 @@ void vpMbGenericTracker::TrackerWrapper::testTracking() {
   }
 }
 
+/*!
+  Return the largest image displacement, in pixels, of the corners of the
+  visible faces between the current pose and \e cMo_pred.
+*/
+double vpMbGenericTracker::TrackerWrapper::computeImageMotion(const vpHomogeneousMatrix &cMo_pred) const {
+  double motion = 0;
+  for (unsigned int i = 0; i < faces.size(); i++) {
+    const vpMbtPolygon *polygon = faces[i];
+    if (!polygon->isVisible()) {
+      continue;
+    }
+
+    for (unsigned int j = 0; j < polygon->getNbPoint(); j++) {
+      double u = 0, v = 0, u_pred = 0, v_pred = 0;
+      if (projectModelPoint(cMo, cam, polygon->p[j], u, v) &&
+          projectModelPoint(cMo_pred, cam, polygon->p[j], u_pred, v_pred)) {
+        motion = std::max(motion, std::max(std::fabs(u_pred - u), std::fabs(v_pred - v)));
+      }
+    }
+  }
+
+  return motion;
+}
+
+/*!
+  Compute the region of the next image where the features will be extracted,
+  from the visible faces projected with the current pose. The region is
+  enlarged by the search range of the features, by m_predictedRoiMargin and, if
+  \e useMotion is true, by the largest image displacement of the face corners
+  since the previous call.
+*/
+void vpMbGenericTracker::TrackerWrapper::updatePredictedRoi(const unsigned int width, const unsigned int height,
+                                                            const bool useMotion) {
+  const bool motionAvailable = useMotion && m_predictedRoiPoseAvailable;
+  const vpHomogeneousMatrix cMo_prev = m_predictedRoiPose;
+  m_predictedRoiPose = cMo;
+  m_predictedRoiPoseAvailable = true;
+  m_predictedRoi = vpRect(0, 0, width, height);
+
+  if (!m_usePredictedRoi || width == 0 || height == 0) {
+    return;
+  }
+
+  double uMin = std::numeric_limits<double>::max(), uMax = -std::numeric_limits<double>::max();
+  double vMin = std::numeric_limits<double>::max(), vMax = -std::numeric_limits<double>::max();
+  double motion = 0;
+  bool visible = false;
+
+  for (unsigned int i = 0; i < faces.size(); i++) {
+    const vpMbtPolygon *polygon = faces[i];
+    if (!polygon->isVisible()) {
+      continue;
+    }
+
+    for (unsigned int j = 0; j < polygon->getNbPoint(); j++) {
+      double u = 0, v = 0;
+      if (!projectModelPoint(cMo, cam, polygon->p[j], u, v)) {
+        // The model crosses the image plane, its projection is not bounded
+        return;
+      }
+
+      double u_prev = 0, v_prev = 0;
+      if (motionAvailable && projectModelPoint(cMo_prev, cam, polygon->p[j], u_prev, v_prev)) {
+        motion = std::max(motion, std::max(std::fabs(u - u_prev), std::fabs(v - v_prev)));
+      }
+      uMin = std::min(uMin, u);
+      uMax = std::max(uMax, u);
+      vMin = std::min(vMin, v);
+      vMax = std::max(vMax, v);
+      visible = true;
+    }
+  }
+
+  if (!visible) {
+    return;
+  }
+
+  // Search range of the features around the projection of the model
+  double range = 0;
+  if (m_trackerType & EDGE_TRACKER) {
+    range = std::max(range, (double) (me.getRange() + me.getMaskSize() / 2 + 1));
+  }
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+  if (m_trackerType & KLT_TRACKER) {
+    range = std::max(range, (double) ((tracker.getWindowSize() / 2 + 1) << std::max(0, tracker.getPyramidLevels())));
+  }
+#endif
+
+  const double margin = motion + range + m_predictedRoiMargin;
+  const double left = std::max(0.0, std::floor(uMin - margin));
+  const double top = std::max(0.0, std::floor(vMin - margin));
+  const double right = std::min((double) width, std::ceil(uMax + margin) + 1);
+  const double bottom = std::min((double) height, std::ceil(vMax + margin) + 1);
+
+  if (left < right && top < bottom) {
+    m_predictedRoi = vpRect(left, top, right - left, bottom - top);
+  }
+}
+
 void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> &
                                             #ifdef VISP_HAVE_PCL
                                                I
                                             #endif
                                                ) {
   if ( (m_trackerType & (EDGE_TRACKER
-                      #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                      #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                          | KLT_TRACKER
                       #endif
                          )) == 0 ) {
@@ -4743,7 +5938,7 @@ void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> &
 #ifdef VISP_HAVE_PCL
 void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> * const ptr_I, const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud) {
   if ( (m_trackerType & (EDGE_TRACKER |
-                      #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                      #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                          KLT_TRACKER |
                       #endif
                          DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0 ) {
@@ -4752,7 +5947,7 @@ void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> * co
   }
 
   if (m_trackerType & (EDGE_TRACKER
-                    #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                    #if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                        | KLT_TRACKER
                     #endif
                        ) && ptr_I == NULL) {
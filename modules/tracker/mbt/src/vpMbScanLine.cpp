@@ -59,9 +59,15 @@
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+#ifdef VISP_HAVE_OPENMP
+// Minimum image size (in pixels) to resolve the scanlines in parallel
+const unsigned int vpMbScanLineParallelMinSize = 160*120;
+#endif
+
 vpMbScanLine::vpMbScanLine()
   : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(),
-    visibility_samples(), depthTreshold(1e-06)
+    visibility_samples(), depthTreshold(1e-06), scanlinesX(), scanlinesY(), localScanlines(), maskX(), maskY(),
+    drawnTop(0), drawnBottom(0), drawnLeft(0), drawnRight(0)
 #if defined(DEBUG_DISP)
   ,dispMaskDebug(NULL), dispLineDebug(NULL), linedebugImg()
 #endif
@@ -218,8 +224,8 @@ vpMbScanLine::drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> >
     return;
   }
 
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(h);
+  if (localScanlines.size() < h)
+    localScanlines.resize(h);
 
   for(size_t i = 0 ; i < polygon.size() ; ++i)
   {
@@ -227,10 +233,10 @@ vpMbScanLine::drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> >
     createVectorFromPoint(polygon[i].first, p1, K);
     createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
 
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID, local_scanlines);
+    drawLineY(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID, localScanlines);
   }
 
-  createScanLinesFromLocals(scanlines,local_scanlines,h);
+  createScanLinesFromLocals(scanlines,localScanlines,h);
 }
 
 /*!
@@ -262,8 +268,8 @@ vpMbScanLine::drawPolygonX(const std::vector<std::pair<vpPoint, unsigned int> >
     return;
   }
 
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(w);
+  if (localScanlines.size() < w)
+    localScanlines.resize(w);
 
   for(size_t i = 0 ; i < polygon.size() ; ++i)
   {
@@ -271,10 +277,10 @@ vpMbScanLine::drawPolygonX(const std::vector<std::pair<vpPoint, unsigned int> >
     createVectorFromPoint(polygon[i].first, p1, K);
     createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
 
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID, local_scanlines);
+    drawLineX(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID, localScanlines);
   }
 
-  createScanLinesFromLocals(scanlines,local_scanlines,w);
+  createScanLinesFromLocals(scanlines,localScanlines,w);
 }
 
 /*!
@@ -319,217 +325,258 @@ vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegm
           }
           scanlines[j].push_back(s);
       }
+      scanline.clear();
   }
 }
 
 /*!
-  Render a scene of polygons and compute scanlines intersections in order to use queries.
+  Resolve the visibility along all the Y-axis scanlines (rows) or all the X-axis scanlines (columns)
+  of the scene. The scanlines are independent and are processed in parallel when OpenMP is available.
 
-  \param polygons : List of polygons composed by arrays of lines.
-  \param listPolyIndices : List of polygons IDs (has to be know when using queries).
-  \param cam : Camera parameters.
-  \param width : Width of the image (render window).
-  \param height : Height of the image (render window).
+  \param rows : True to process the Y-axis scanlines, false for the X-axis ones.
 */
 void
-vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > * > &polygons,
-                        std::vector<int> listPolyIndices,
-                        const vpCameraParameters &cam, unsigned int width, unsigned int height)
+vpMbScanLine::drawScanLines(const bool rows)
 {
-  this->w = width;
-  this->h = height;
-  this->K = cam;
-
-  visibility_samples.clear();
-
-  std::vector<std::vector<vpMbScanLineSegment> > scanlinesY;
-  scanlinesY.resize(h);
-  std::vector<std::vector<vpMbScanLineSegment> > scanlinesX;
-  scanlinesX.resize(w);
+  const int size = (int) (rows ? h : w);
 
-  mask.resize(h,w,0);
-
-  vpImage<unsigned char> maskY(h,w,0);
-  vpImage<unsigned char> maskX(h,w,0);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (w * h >= vpMbScanLineParallelMinSize)
+#endif
+  {
+    std::vector<std::pair<double, const vpMbScanLineSegment *> > stack;
+    std::vector<std::pair<const vpMbScanLineSegment *, int> > samples;
+    // Pixels written along the scanlines, and scanlines where pixels were written
+    unsigned int first = (std::numeric_limits<unsigned int>::max)(), last = 0;
+    unsigned int firstLine = (std::numeric_limits<unsigned int>::max)(), lastLine = 0;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(dynamic, 8)
+#endif
+    for(int k = 0 ; k < size ; ++k)
+    {
+        const unsigned int index = (unsigned int) k;
+        std::vector<vpMbScanLineSegment> &scanline = rows ? scanlinesY[index] : scanlinesX[index];
+
+        if (!scanline.empty() && drawScanLine(scanline, index, rows, stack, samples, first, last))
+        {
+            firstLine = (std::min)(firstLine, index);
+            lastLine = (std::max)(lastLine, index + 1);
+        }
+    }
 
-  primitive_ids.resize(h, w, -1);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp critical (vpMbScanLine_drawScanLines)
+#endif
+    {
+      for(size_t i = 0 ; i < samples.size() ; ++i)
+          visibility_samples[samples[i].first->edge].insert(samples[i].second);
 
-  for(unsigned int ID = 0 ; ID < polygons.size() ; ++ID)
-  {
-      drawPolygonY(*(polygons[ID]), listPolyIndices[ID], scanlinesY);
-      drawPolygonX(*(polygons[ID]), listPolyIndices[ID], scanlinesX);
+      if (firstLine < lastLine)
+      {
+          if (rows)
+          {
+              drawnTop = (std::min)(drawnTop, firstLine);
+              drawnBottom = (std::max)(drawnBottom, lastLine);
+              drawnLeft = (std::min)(drawnLeft, first);
+              drawnRight = (std::max)(drawnRight, last);
+          }
+          else
+          {
+              drawnLeft = (std::min)(drawnLeft, firstLine);
+              drawnRight = (std::max)(drawnRight, lastLine);
+              drawnTop = (std::min)(drawnTop, first);
+              drawnBottom = (std::max)(drawnBottom, last);
+          }
+      }
+    }
   }
+}
 
-  // Y
+/*!
+  Resolve the visibility along one scanline: fill the primitive IDs and the masks with the closest
+  polygon and collect the visible samples of the lines.
+
+  \param scanline : Intersections of the scanline with the polygons. They are sorted by this function.
+  \param index : Index of the scanline (row or column).
+  \param row : True for a Y-axis scanline (row), false for a X-axis one (column).
+  \param stack : Buffer used to store the polygons crossing the scanline, sorted by depth.
+  \param samples : Visible samples of the lines, appended to the vector.
+  \param first : Updated with the lowest index of the written pixels along the scanline.
+  \param last : Updated with the past-the-end index of the written pixels along the scanline.
+
+  \return true if pixels were written.
+*/
+bool
+vpMbScanLine::drawScanLine(std::vector<vpMbScanLineSegment> &scanline, const unsigned int index, const bool row,
+                           std::vector<std::pair<double, const vpMbScanLineSegment *> > &stack,
+                           std::vector<std::pair<const vpMbScanLineSegment *, int> > &samples,
+                           unsigned int &first, unsigned int &last)
+{
+  sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+
+  bool written = false;
   int last_ID = -1;
-  vpMbScanLineSegment last_visible;
-  for(unsigned int y = 0 ; y < scanlinesY.size() ; ++y)
+  int last_visible_ID = -1;
+  double last_visible_p = 0;
+  stack.clear();
+  for(size_t i = 0 ; i < scanline.size() ; ++i)
   {
-      std::vector<vpMbScanLineSegment> &scanline = scanlinesY[y];
-      sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+      const vpMbScanLineSegment &s = scanline[i];
 
-      std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-      for(size_t i = 0 ; i < scanline.size() ; ++i)
+      switch(s.type)
       {
-          const vpMbScanLineSegment &s = scanline[i];
+      case START:
+          stack.push_back(std::make_pair(s.Z1, &s));
+          break;
+      case END:
+          for(size_t j = 0 ; j < stack.size() ; ++j)
+              if (stack[j].second->ID == s.ID)
+              {
+                  if (j != stack.size()-1)
+                      stack[j] = stack.back();
+                  stack.pop_back();
+                  break;
+              }
+          break;
+      case POINT:
+          break;
+      }
 
-          switch(s.type)
-          {
-          case START:
-              stack.push_back(std::make_pair(s.Z1, s));
-              break;
-          case END:
-              for(size_t j = 0 ; j < stack.size() ; ++j)
-                  if (stack[j].second.ID == s.ID)
-                  {
-                      if (j != stack.size()-1)
-                          stack[j] = stack.back();
-                      stack.pop_back();
-                      break;
-                  }
-              break;
-          case POINT:
-              break;
-          }
+      for(size_t j = 0 ; j < stack.size() ; ++j)
+      {
+          const vpMbScanLineSegment &s0 = *stack[j].second;
+          stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
+      }
+      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
 
-          for(size_t j = 0 ; j < stack.size() ; ++j)
-          {
-              const vpMbScanLineSegment &s0 = stack[j].second;
-              stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
-          }
-          sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
+      int new_ID = stack.empty() ? -1 : stack.front().second->ID;
 
-          int new_ID = stack.empty() ? -1 : stack.front().second.ID;
+      if (new_ID != last_ID || s.type == POINT)
+      {
+          if (s.b_sample_Y == row)
+              switch(s.type)
+              {
+              case POINT:
+                  if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
+                      samples.push_back(std::make_pair(&s, (int)index));
+                  break;
+              case START:
+                  if (new_ID == s.ID)
+                      samples.push_back(std::make_pair(&s, (int)index));
+                  break;
+              case END:
+                  if (last_ID == s.ID)
+                      samples.push_back(std::make_pair(&s, (int)index));
+                  break;
+              }
 
-          if (new_ID != last_ID || s.type == POINT)
+          // The mask is used by MbKltTracking, the primitive IDs are only computed along the rows
+          if (last_ID != -1 && (row || maskBorder != 0))
           {
-              if (s.b_sample_Y)
-                  switch(s.type)
-                  {
-                  case POINT:
-                      if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-                          visibility_samples[s.edge].insert((int)y);
-                      break;
-                  case START:
-                      if (new_ID == s.ID)
-                          visibility_samples[s.edge].insert((int)y);
-                      break;
-                  case END:
-                      if (last_ID == s.ID)
-                          visibility_samples[s.edge].insert((int)y);
-                      break;
-                  }
-
-              // This part will only be used for MbKltTracking
-              if (last_ID != -1)
+              const unsigned int p0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible_p))) + maskBorder;
+              const double p1 = (std::min)((double)(row ? w : h), (double)s.p);
+              unsigned int p = p0;
+              for( ; p < p1 - maskBorder; ++p)
               {
-                  const unsigned int x0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
-                  const double x1 = (std::min)((double)w, (double)s.p);
-                  for(unsigned int x = x0 + maskBorder ; x < x1 - maskBorder; ++x)
+                  if (row)
                   {
-                      primitive_ids[(unsigned int)y][(unsigned int)x] = last_visible.ID;
+                      primitive_ids[index][p] = last_visible_ID;
 
                       if(maskBorder != 0)
-                        maskY[(unsigned int)y][(unsigned int)x] = 255;
+                        maskY[index][p] = 255;
                       else
-                        mask[(unsigned int)y][(unsigned int)x] = 255;
+                        mask[index][p] = 255;
+                  }
+                  else
+                  {
+                      maskX[p][index] = 255;
                   }
               }
 
-              last_ID = new_ID;
-              if (!stack.empty())
+              if (p > p0)
               {
-                  last_visible = stack.front().second;
-                  last_visible.p = s.p;
+                  first = (std::min)(first, p0);
+                  last = (std::max)(last, p);
+                  written = true;
               }
           }
+
+          last_ID = new_ID;
+          if (!stack.empty())
+          {
+              last_visible_ID = stack.front().second->ID;
+              last_visible_p = s.p;
+          }
       }
   }
 
-  // X
-  last_ID = -1;
-  for(unsigned int x = 0 ; x < scanlinesX.size() ; ++x)
-  {
-      std::vector<vpMbScanLineSegment> &scanline = scanlinesX[x];
-      sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+  return written;
+}
 
-      std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-      for(size_t i = 0 ; i < scanline.size() ; ++i)
-      {
-          const vpMbScanLineSegment &s = scanline[i];
+/*!
+  Render a scene of polygons and compute scanlines intersections in order to use queries.
 
-          switch(s.type)
-          {
-          case START:
-              stack.push_back(std::make_pair(s.Z1, s));
-              break;
-          case END:
-              for(size_t j = 0 ; j < stack.size() ; ++j)
-                  if (stack[j].second.ID == s.ID)
-                  {
-                      if (j != stack.size()-1)
-                          stack[j] = stack.back();
-                      stack.pop_back();
-                      break;
-                  }
-              break;
-          case POINT:
-              break;
-          }
+  \param polygons : List of polygons composed by arrays of lines.
+  \param listPolyIndices : List of polygons IDs (has to be know when using queries).
+  \param cam : Camera parameters.
+  \param width : Width of the image (render window).
+  \param height : Height of the image (render window).
+*/
+void
+vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > * > &polygons,
+                        std::vector<int> listPolyIndices,
+                        const vpCameraParameters &cam, unsigned int width, unsigned int height)
+{
+  this->w = width;
+  this->h = height;
+  this->K = cam;
 
-          for(size_t j = 0 ; j < stack.size() ; ++j)
-          {
-              const vpMbScanLineSegment &s0 = stack[j].second;
-              stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
-          }
-          sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
+  visibility_samples.clear();
 
-          int new_ID = stack.empty() ? -1 : stack.front().second.ID;
+  scanlinesY.resize(h);
+  for(unsigned int y = 0 ; y < h ; ++y)
+      scanlinesY[y].clear();
+  scanlinesX.resize(w);
+  for(unsigned int x = 0 ; x < w ; ++x)
+      scanlinesX[x].clear();
 
-          if (new_ID != last_ID || s.type == POINT)
+  if (mask.getHeight() != h || mask.getWidth() != w)
+  {
+      mask.resize(h,w,0);
+      maskY.resize(h,w,0);
+      maskX.resize(h,w,0);
+      primitive_ids.resize(h, w, -1);
+  }
+  else
+  {
+      // Only the area drawn by the previous call has to be cleared
+      for(unsigned int i = drawnTop ; i < drawnBottom ; i++)
+          for(unsigned int j = drawnLeft ; j < drawnRight ; j++)
           {
-              if (!s.b_sample_Y)
-                  switch(s.type)
-                  {
-                  case POINT:
-                      if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-                          visibility_samples[s.edge].insert((int)x);
-                      break;
-                  case START:
-                      if (new_ID == s.ID)
-                          visibility_samples[s.edge].insert((int)x);
-                      break;
-                  case END:
-                      if (last_ID == s.ID)
-                          visibility_samples[s.edge].insert((int)x);
-                      break;
-                  }
-
-              // This part will only be used for MbKltTracking
-              if (maskBorder != 0 && last_ID != -1)
-              {
-                  const unsigned int y0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
-                  const double y1 = (std::min)((double)h, (double)s.p);
-                  for(unsigned int y = y0 + maskBorder ; y < y1 - maskBorder; ++y)
-                  {
-                      //primitive_ids[(unsigned int)y][(unsigned int)x] = last_visible.ID;
-                      maskX[(unsigned int)y][(unsigned int)x] = 255;
-                  }
-              }
-
-              last_ID = new_ID;
-              if (!stack.empty())
-              {
-                  last_visible = stack.front().second;
-                  last_visible.p = s.p;
-              }
+              mask[i][j] = 0;
+              maskY[i][j] = 0;
+              maskX[i][j] = 0;
+              primitive_ids[i][j] = -1;
           }
-      }
   }
+  drawnTop = h;
+  drawnBottom = 0;
+  drawnLeft = w;
+  drawnRight = 0;
+
+  for(unsigned int ID = 0 ; ID < polygons.size() ; ++ID)
+  {
+      drawPolygonY(*(polygons[ID]), listPolyIndices[ID], scanlinesY);
+      drawPolygonX(*(polygons[ID]), listPolyIndices[ID], scanlinesX);
+  }
+
+  drawScanLines(true);
+  drawScanLines(false);
 
   if(maskBorder != 0)
-    for(unsigned int i = 0 ; i < h ; i++)
-      for(unsigned int j = 0 ; j < w ; j++)
+    for(unsigned int i = drawnTop ; i < drawnBottom ; i++)
+      for(unsigned int j = drawnLeft ; j < drawnRight ; j++)
         if(maskX[i][j] == 255 && maskY[i][j] == 255)
           mask[i][j] = 255;
 
@@ -43,6 +43,7 @@
   \brief Generic model based tracker
 */
 
+#include <iomanip>
 #include <iostream>
 #include <limits>
 #include <algorithm>
@@ -95,6 +96,9 @@
 #  define VISP_HAVE_SSE2 1
 #endif
 
+#ifdef VISP_HAVE_OPENMP
+#  include <omp.h>
+#endif
 
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -128,6 +132,53 @@ namespace {
     vpPolygon polygon;
     std::vector<vpPoint> faceCorners;
   };
+
+  vpMbtModelCache::vpMbtPrimitive createPrimitive(const vpMbtModelCache::vpMbtPrimitiveType type, const int idFace,
+                                                 const std::vector<vpPoint> &points, const std::string &name,
+                                                 const bool useLod, const double minPolygonAreaThreshold,
+                                                 const double minLineLengthThreshold, const double radius=0)
+  {
+    vpMbtModelCache::vpMbtPrimitive primitive;
+    primitive.type = type;
+    primitive.idFace = idFace;
+    primitive.points = points;
+    primitive.name = name;
+    primitive.useLod = useLod;
+    primitive.minPolygonAreaThreshold = minPolygonAreaThreshold;
+    primitive.minLineLengthThreshold = minLineLengthThreshold;
+    primitive.radius = radius;
+    return primitive;
+  }
+
+#ifdef VISP_HAVE_OPENMP
+  // Below this number of features, the normal equations are accumulated by a single thread
+  const unsigned int vpMbTrackerParallelMinFeatures = 4096;
+#endif
+
+  /*
+    Accumulate the upper triangle of (WL)^T WL (size 6x6, row major) and (WL)^T We (size 6)
+    over the rows [r0, r1[ of L.
+  */
+  void accumulateNormalEquations(const vpMatrix &L, const vpColVector &w, const vpColVector &weightedError,
+                                 const unsigned int r0, const unsigned int r1, double *LTL, double *LTR)
+  {
+    double lw[6];
+    for (unsigned int i = r0; i < r1; i++) {
+      const double *l = L[i];
+      const double wi = w[i];
+      for (unsigned int j = 0; j < 6; j++) {
+        lw[j] = wi * l[j];
+      }
+      const double ei = weightedError[i];
+      for (unsigned int j = 0; j < 6; j++) {
+        double *ltl = LTL + 6*j;
+        for (unsigned int k = j; k < 6; k++) {
+          ltl[k] += lw[j] * lw[k];
+        }
+        LTR[j] += lw[j] * ei;
+      }
+    }
+  }
 }
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -144,7 +195,8 @@ vpMbTracker::vpMbTracker()
   distFarClip(100), clippingFlag(vpPolygon3D::NO_CLIPPING), useOgre(false), ogreShowConfigDialog(false), useScanLine(false),
   nbPoints(0), nbLines(0), nbPolygonLines(0), nbPolygonPoints(0), nbCylinders(0), nbCircles(0),
   useLodGeneral(false), applyLodSettingInConfig(false), minLineLengthThresholdGeneral(50.0), minPolygonAreaThresholdGeneral(2500.0),
-  mapOfParameterNames(), m_computeInteraction(true), m_lambda(1.0), m_maxIter(30), m_stopCriteriaEpsilon(1e-8), m_initialMu(0.01)
+  mapOfParameterNames(), m_computeInteraction(true), m_lambda(1.0), m_maxIter(30), m_stopCriteriaEpsilon(1e-8), m_initialMu(0.01),
+  m_modelCacheDirectory(), m_modelCacheRecorder(NULL)
 {
     oJo.eye();
     //Map used to parse additional information in CAO model files,
@@ -1112,25 +1164,60 @@ vpMbTracker::loadModel(const std::string& modelFile, const bool verbose)
 
   if(vpIoTools::checkFilename(modelFile)) {
     it = modelFile.end();
-    if((*(it-1) == 'o' && *(it-2) == 'a' && *(it-3) == 'c' && *(it-4) == '.') ||
-       (*(it-1) == 'O' && *(it-2) == 'A' && *(it-3) == 'C' && *(it-4) == '.') ){
-      std::vector<std::string> vectorOfModelFilename;
-      int startIdFace = (int)faces.size();
-      nbPoints = 0;
-      nbLines = 0;
-      nbPolygonLines = 0;
-      nbPolygonPoints = 0;
-      nbCylinders = 0;
-      nbCircles = 0;
-      loadCAOModel(modelFile, vectorOfModelFilename, startIdFace, verbose, true);
-    }
-    else if((*(it-1) == 'l' && *(it-2) == 'r' && *(it-3) == 'w' && *(it-4) == '.') ||
-            (*(it-1) == 'L' && *(it-2) == 'R' && *(it-3) == 'W' && *(it-4) == '.') ){
-      loadVRMLModel(modelFile);
-    }
-    else{
+    const bool caoModel = (*(it-1) == 'o' && *(it-2) == 'a' && *(it-3) == 'c' && *(it-4) == '.') ||
+                          (*(it-1) == 'O' && *(it-2) == 'A' && *(it-3) == 'C' && *(it-4) == '.');
+    const bool vrmlModel = (*(it-1) == 'l' && *(it-2) == 'r' && *(it-3) == 'w' && *(it-4) == '.') ||
+                           (*(it-1) == 'L' && *(it-2) == 'R' && *(it-3) == 'W' && *(it-4) == '.');
+    if (!caoModel && !vrmlModel) {
       throw vpException(vpException::ioError, "Error: File %s doesn't contain a cao or wrl model", modelFile.c_str());
     }
+
+    if (!loadModelFromCache(modelFile, caoModel, verbose)) {
+      // The primitives are recorded while parsing the model to fill the cache
+      vpMbtModelCache cache;
+      cache.setFirstIdFace((int)faces.size());
+      if (!m_modelCacheDirectory.empty()) {
+        m_modelCacheRecorder = &cache;
+      }
+
+      std::vector<std::string> vectorOfModelFilename;
+      try {
+        if (caoModel) {
+          int startIdFace = (int)faces.size();
+          nbPoints = 0;
+          nbLines = 0;
+          nbPolygonLines = 0;
+          nbPolygonPoints = 0;
+          nbCylinders = 0;
+          nbCircles = 0;
+          loadCAOModel(modelFile, vectorOfModelFilename, startIdFace, verbose, true);
+          cache.setCounters(nbPoints, nbLines, nbPolygonLines, nbPolygonPoints, nbCylinders, nbCircles);
+        }
+        else {
+          loadVRMLModel(modelFile);
+          vectorOfModelFilename.push_back(modelFile);
+        }
+      } catch (...) {
+        m_modelCacheRecorder = NULL;
+        throw;
+      }
+      m_modelCacheRecorder = NULL;
+
+      if (!m_modelCacheDirectory.empty()) {
+        try {
+          for (size_t i = 0; i < vectorOfModelFilename.size(); i++) {
+            cache.addSourceFile(vpIoTools::getAbsolutePathname(vectorOfModelFilename[i]));
+          }
+          cache.setLodSettings(useLodGeneral, applyLodSettingInConfig, minLineLengthThresholdGeneral, minPolygonAreaThresholdGeneral);
+          if (!vpIoTools::checkDirectory(m_modelCacheDirectory)) {
+            vpIoTools::makeDirectory(m_modelCacheDirectory);
+          }
+          cache.save(getModelCacheFilename(modelFile));
+        } catch (const vpException &e) {
+          std::cerr << "Cannot save the model cache of " << modelFile << ": " << e.getStringMessage() << std::endl;
+        }
+      }
+    }
   }
   else{
     throw vpException(vpException::ioError, "Error: File %s doesn't exist", modelFile.c_str());
@@ -1140,6 +1227,141 @@ vpMbTracker::loadModel(const std::string& modelFile, const bool verbose)
   this->modelFileName = modelFile;
 }
 
+/*!
+  Add a primitive of the model: the polygons are added to the set of faces and the
+  features to track are created by the child class (initFaceFromLines(),
+  initFaceFromCorners(), initCylinder() or initCircle()).
+
+  If the model is being recorded to be saved in the model cache, the primitive is
+  also added to the cache.
+
+  \throw vpException::dimensionError if the primitive does not have enough points.
+
+  \param primitive : The primitive to add.
+  \param idFaceOffset : Offset added to the face ids of the primitive.
+*/
+void
+vpMbTracker::addModelPrimitive(const vpMbtModelCache::vpMbtPrimitive &primitive, const int idFaceOffset)
+{
+  const int idFace = primitive.idFace + idFaceOffset;
+  const std::vector<vpPoint> &points = primitive.points;
+
+  switch (primitive.type) {
+    case vpMbtModelCache::POLYGON_FROM_LINES:
+      addPolygon(points, idFace, primitive.name, primitive.useLod, primitive.minPolygonAreaThreshold, primitive.minLineLengthThreshold);
+      initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      break;
+
+    case vpMbtModelCache::POLYGON_FROM_CORNERS:
+      addPolygon(points, idFace, primitive.name, primitive.useLod, primitive.minPolygonAreaThreshold, primitive.minLineLengthThreshold);
+      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      break;
+
+    case vpMbtModelCache::CYLINDER:
+      {
+        if (points.size() != 2) {
+          throw vpException(vpException::dimensionError, "A cylinder is defined by 2 points");
+        }
+        // Revolution axis followed by the 4 faces of the bounding box
+        addPolygon(points[0], points[1], idFace, primitive.name, primitive.useLod, primitive.minLineLengthThreshold);
+
+        std::vector<std::vector<vpPoint> > listFaces;
+        createCylinderBBox(points[0], points[1], primitive.radius, listFaces);
+        addPolygon(listFaces, idFace + 1, primitive.name, primitive.useLod, primitive.minLineLengthThreshold);
+
+        initCylinder(points[0], points[1], primitive.radius, idFace, primitive.name);
+        break;
+      }
+
+    case vpMbtModelCache::CIRCLE:
+      if (points.size() != 3) {
+        throw vpException(vpException::dimensionError, "A circle is defined by 3 points");
+      }
+      addPolygon(points[0], points[1], points[2], primitive.radius, idFace, primitive.name, primitive.useLod,
+                 primitive.minPolygonAreaThreshold);
+      initCircle(points[0], points[1], points[2], primitive.radius, idFace, primitive.name);
+      break;
+  }
+
+  if (m_modelCacheRecorder != NULL) {
+    m_modelCacheRecorder->addPrimitive(primitive);
+  }
+}
+
+/*!
+  Get the name of the cache file of a model: the name of the model file followed
+  by the hash of its absolute path, in the model cache directory.
+
+  \param modelFile : The model file.
+  \return The cache file name.
+*/
+std::string
+vpMbTracker::getModelCacheFilename(const std::string &modelFile) const
+{
+  std::ostringstream name;
+  name << vpIoTools::getNameWE(modelFile) << "-" << std::hex << std::setfill('0') << std::setw(16)
+       << vpMbtModelCache::hashString(vpIoTools::getAbsolutePathname(modelFile)) << ".mbcache";
+  return vpIoTools::createFilePath(m_modelCacheDirectory, name.str());
+}
+
+/*!
+  Instantiate a model from its binary cache file, if the cache is enabled (see
+  setModelCacheDirectory()) and up to date. The cache is not used if one of the
+  source files was modified, or if the general LOD settings changed since it was
+  created.
+
+  \param modelFile : The model file.
+  \param caoModel : True for a .cao model, false for a .wrl model.
+  \param verbose : If true, print the cache file that is used and the number
+  of primitives of the model.
+  \return True if the model was loaded from the cache.
+*/
+bool
+vpMbTracker::loadModelFromCache(const std::string &modelFile, const bool caoModel, const bool verbose)
+{
+  if (m_modelCacheDirectory.empty()) {
+    return false;
+  }
+
+  const std::string cacheFile = getModelCacheFilename(modelFile);
+  vpMbtModelCache cache;
+  if (!cache.load(cacheFile) || cache.getSourceFiles().empty() || cache.getSourceFiles().front() != vpIoTools::getAbsolutePathname(modelFile) ||
+      !cache.matchLodSettings(useLodGeneral, applyLodSettingInConfig, minLineLengthThresholdGeneral, minPolygonAreaThresholdGeneral) ||
+      !cache.isUpToDate()) {
+    return false;
+  }
+
+  if (verbose) {
+    std::cout << "Model file : " << modelFile << " (from cache " << cacheFile << ")" << std::endl;
+  }
+
+  const int idFaceOffset = (int)faces.size() - cache.getFirstIdFace();
+  const std::vector<vpMbtModelCache::vpMbtPrimitive> &primitives = cache.getPrimitives();
+  for (size_t i = 0; i < primitives.size(); i++) {
+    addModelPrimitive(primitives[i], idFaceOffset);
+  }
+
+  if (caoModel) {
+    const std::vector<unsigned int> &counters = cache.getCounters();
+    nbPoints = counters[0];
+    nbLines = counters[1];
+    nbPolygonLines = counters[2];
+    nbPolygonPoints = counters[3];
+    nbCylinders = counters[4];
+    nbCircles = counters[5];
+
+    if (verbose) {
+      std::cout << "> " << nbPoints << " points" << std::endl;
+      std::cout << "> " << nbLines << " lines" << std::endl;
+      std::cout << "> " << nbPolygonLines << " polygon lines" << std::endl;
+      std::cout << "> " << nbPolygonPoints << " polygon points" << std::endl;
+      std::cout << "> " << nbCylinders << " cylinders" << std::endl;
+      std::cout << "> " << nbCircles << " circles" << std::endl;
+    }
+  }
+
+  return true;
+}
 
 /*!
   Load the 3D model of the object from a vrml file. Only LineSet and FaceSet are
@@ -1620,17 +1842,16 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
         useLod = parseBoolean(mapOfParams["useLod"]);
       }
 
-      addPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-      initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      addModelPrimitive(createPrimitive(vpMbtModelCache::POLYGON_FROM_LINES, idFace++, corners, polygonName, useLod,
+                                        minPolygonAreaThreshold, minLineLengthThresholdGeneral));
     }
 
     //Add the segments which were not already added in the face segment case
     for(std::map<std::pair<unsigned int, unsigned int>, SegmentInfo >::const_iterator it =
         segmentTemporaryMap.begin(); it != segmentTemporaryMap.end(); ++it) {
       if(std::find(faceSegmentKeyVector.begin(), faceSegmentKeyVector.end(), it->first) == faceSegmentKeyVector.end()) {
-        addPolygon(it->second.extremities, idFace++, it->second.name, it->second.useLod, minPolygonAreaThresholdGeneral,
-                   it->second.minLineLengthThresh);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+        addModelPrimitive(createPrimitive(vpMbtModelCache::POLYGON_FROM_CORNERS, idFace++, it->second.extremities, it->second.name,
+                                          it->second.useLod, minPolygonAreaThresholdGeneral, it->second.minLineLengthThresh));
       }
     }
 
@@ -1694,9 +1915,8 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
         useLod = parseBoolean(mapOfParams["useLod"]);
       }
 
-
-      addPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      addModelPrimitive(createPrimitive(vpMbtModelCache::POLYGON_FROM_CORNERS, idFace++, corners, polygonName, useLod,
+                                        minPolygonAreaThreshold, minLineLengthThresholdGeneral));
     }
 
     //////////////////////////Read the cylinder declaration part//////////////////////////
@@ -1753,15 +1973,13 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
           useLod = parseBoolean(mapOfParams["useLod"]);
         }
 
-        int idRevolutionAxis = idFace;
-        addPolygon(caoPoints[indexP1], caoPoints[indexP2], idFace++, polygonName, useLod, minLineLengthThreshold);
-
-        std::vector<std::vector<vpPoint> > listFaces;
-        createCylinderBBox(caoPoints[indexP1], caoPoints[indexP2], radius,listFaces);
-        addPolygon(listFaces, idFace, polygonName, useLod, minLineLengthThreshold);
-        idFace+=4;
-
-        initCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
+        std::vector<vpPoint> axis;
+        axis.push_back(caoPoints[indexP1]);
+        axis.push_back(caoPoints[indexP2]);
+        addModelPrimitive(createPrimitive(vpMbtModelCache::CYLINDER, idFace, axis, polygonName, useLod,
+                                          minPolygonAreaThresholdGeneral, minLineLengthThreshold, radius));
+        // Revolution axis and the 4 faces of the bounding box
+        idFace += 5;
       }
 
     } catch (...) {
@@ -1826,11 +2044,12 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
           useLod = parseBoolean(mapOfParams["useLod"]);
         }
 
-        addPolygon(caoPoints[indexP1], caoPoints[indexP2],
-                   caoPoints[indexP3], radius, idFace, polygonName, useLod, minPolygonAreaThreshold);
-
-        initCircle(caoPoints[indexP1], caoPoints[indexP2],
-                   caoPoints[indexP3], radius, idFace++, polygonName);
+        std::vector<vpPoint> circlePoints;
+        circlePoints.push_back(caoPoints[indexP1]);
+        circlePoints.push_back(caoPoints[indexP2]);
+        circlePoints.push_back(caoPoints[indexP3]);
+        addModelPrimitive(createPrimitive(vpMbtModelCache::CIRCLE, idFace++, circlePoints, polygonName, useLod,
+                                          minPolygonAreaThreshold, minLineLengthThresholdGeneral, radius));
       }
 
     } catch (...) {
@@ -1986,8 +2205,7 @@ vpMbTracker::extractFaces(SoVRMLIndexedFaceSet* face_set, vpHomogeneousMatrix &t
     {
       if(corners.size() > 1)
       {
-        addPolygon(corners, idFace++, polygonName);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+        addModelPrimitive(createPrimitive(vpMbtModelCache::POLYGON_FROM_CORNERS, idFace++, corners, polygonName, false, 2500.0, 50.0));
         corners.resize(0);
       }
     }
@@ -2080,15 +2298,12 @@ vpMbTracker::extractCylinders(SoVRMLIndexedFaceSet* face_set, vpHomogeneousMatri
   //addPolygon(p1, p2, idFace, polygonName);
   //initCylinder(p1, p2, radius_c1, idFace++);
 
-  int idRevolutionAxis = idFace;
-  addPolygon(p1, p2, idFace++, polygonName);
-
-  std::vector<std::vector<vpPoint> > listFaces;
-  createCylinderBBox(p1, p2, radius_c1, listFaces);
-  addPolygon(listFaces, idFace, polygonName);
-  idFace+=4;
-
-  initCylinder(p1, p2, radius_c1, idRevolutionAxis, polygonName);
+  std::vector<vpPoint> axis;
+  axis.push_back(p1);
+  axis.push_back(p2);
+  addModelPrimitive(createPrimitive(vpMbtModelCache::CYLINDER, idFace, axis, polygonName, false, 2500.0, 50.0, radius_c1));
+  // Revolution axis and the 4 faces of the bounding box
+  idFace += 5;
 }
 
 /*!
@@ -2117,8 +2332,7 @@ vpMbTracker::extractLines(SoVRMLIndexedLineSet* line_set, int &idFace, const std
     {
       if(corners.size() > 1)
       {
-        addPolygon(corners, idFace++, polygonName);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+        addModelPrimitive(createPrimitive(vpMbtModelCache::POLYGON_FROM_CORNERS, idFace++, corners, polygonName, false, 2500.0, 50.0));
         corners.resize(0);
       }
     }
@@ -2325,6 +2539,25 @@ vpMbTracker::setLod(const bool useLod, const std::string &name)
   }
 }
 
+/*!
+  Set the directory where the binary model cache files are stored. When it is set,
+  loadModel() instantiates the model from its cache file if it exists and is up to
+  date, and creates or updates the cache file otherwise. The cache file stores the
+  primitives of the model (faces, lines, cylinders and circles), a hash of the
+  content of the model file and of the files it includes, and the general LOD
+  settings used to parse it. The cache is then not used if one of these changed.
+
+  \param directory : Directory of the cache files, created if needed. The cache is
+  disabled if the directory is empty (default).
+
+  \sa getModelCacheDirectory()
+*/
+void
+vpMbTracker::setModelCacheDirectory(const std::string &directory)
+{
+  m_modelCacheDirectory = directory;
+}
+
 /*!
     Set the threshold for the minimum line length to be considered as visible in the LOD case.
 
@@ -2482,6 +2715,70 @@ vpMbTracker::computeJTR(const vpMatrix& interaction, const vpColVector& error, v
   }
 }
 
+/*!
+  Compute the normal equations \f$ (WL)^T WL \f$ and \f$ (WL)^T We \f$ of the weighted
+  least squares problem, accumulated feature by feature without building the weighted
+  interaction matrix. When there are many features, the rows are split between the threads
+  and the partial sums are added in a fixed order, so that the result does not depend on the
+  scheduling.
+
+  \throw vpMatrixException::incorrectMatrixSizeError if the sizes of the
+  matrices do not allow the computation.
+
+  \param L : The interaction matrix (size Nx6), not weighted.
+  \param w : The weight of each feature (size Nx1).
+  \param weightedError : The weighted residu vector We (size Nx1).
+  \param LTL : The resulting 6x6 matrix.
+  \param LTR : The resulting 6x1 column vector.
+*/
+void
+vpMbTracker::computeVVSNormalEquations(const vpMatrix &L, const vpColVector &w, const vpColVector &weightedError,
+                                       vpMatrix &LTL, vpColVector &LTR) const
+{
+  const unsigned int N = L.getRows();
+  if (L.getCols() != 6 || w.getRows() < N || weightedError.getRows() < N) {
+    throw vpMatrixException(vpMatrixException::incorrectMatrixSizeError,
+                            "Incorrect matrices size in computeVVSNormalEquations.");
+  }
+
+  LTL.resize(6, 6, true);
+  LTR.resize(6, true);
+
+#ifdef VISP_HAVE_OPENMP
+  const int nbThreads = omp_get_max_threads();
+  if (N >= vpMbTrackerParallelMinFeatures && nbThreads > 1) {
+    std::vector<double> partial((size_t) nbThreads * 42, 0.);
+#pragma omp parallel num_threads(nbThreads)
+    {
+      const unsigned int t = (unsigned int) omp_get_thread_num();
+      const unsigned int nt = (unsigned int) omp_get_num_threads();
+      double *p = &partial[(size_t) t * 42];
+      accumulateNormalEquations(L, w, weightedError, (unsigned int) ((size_t) N * t / nt),
+                                (unsigned int) ((size_t) N * (t + 1) / nt), p, p + 36);
+    }
+    for (int t = 0; t < nbThreads; t++) {
+      const double *p = &partial[(size_t) t * 42];
+      for (unsigned int k = 0; k < 36; k++) {
+        LTL.data[k] += p[k];
+      }
+      for (unsigned int k = 0; k < 6; k++) {
+        LTR[k] += p[36 + k];
+      }
+    }
+  }
+  else
+#endif
+  {
+    accumulateNormalEquations(L, w, weightedError, 0, N, LTL.data, LTR.data);
+  }
+
+  for (unsigned int i = 1; i < 6; i++) {
+    for (unsigned int j = 0; j < i; j++) {
+      LTL[i][j] = LTL[j][i];
+    }
+  }
+}
+
 void
 vpMbTracker::computeVVSCheckLevenbergMarquardt(const unsigned int iter, vpColVector &error, const vpColVector &m_error_prev, const vpHomogeneousMatrix &cMoPrev,
                                                double &mu, bool &reStartFromLastIncrement, vpColVector * const w, const vpColVector * const m_w_prev) {
@@ -2509,29 +2806,7 @@ vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsigned
   if (isoJoIdentity_) {
       LTL = L.AtA();
       computeJTR(L, R, LTR);
-
-      switch (m_optimizationMethod) {
-        case vpMbTracker::LEVENBERG_MARQUARDT_OPT:
-          {
-            vpMatrix LMA(LTL.getRows(), LTL.getCols());
-            LMA.eye();
-            vpMatrix LTLmuI = LTL + (LMA*mu);
-            v = -m_lambda*LTLmuI.pseudoInverse(LTLmuI.getRows()*std::numeric_limits<double>::epsilon())*LTR;
-
-            if(iter != 0)
-              mu /= 10.0;
-
-            error_prev = error;
-            if (w != NULL && m_w_prev != NULL)
-              *m_w_prev = *w;
-            break;
-          }
-
-        case vpMbTracker::GAUSS_NEWTON_OPT:
-        default:
-          v = -m_lambda * LTL.pseudoInverse(LTL.getRows()*std::numeric_limits<double>::epsilon()) * LTR;
-          break;
-      }
+      computeVVSPoseEstimation(isoJoIdentity_, iter, LTL, LTR, error, error_prev, mu, v, w, m_w_prev);
   } else {
       vpVelocityTwistMatrix cVo;
       cVo.buildFrom(cMo);
@@ -2566,6 +2841,58 @@ vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsigned
   }
 }
 
+/*!
+  Compute the velocity of the virtual visual servoing from the normal equations
+  \f$ L^T L \f$ and \f$ L^T R \f$, already computed in the object frame for instance
+  by computeVVSNormalEquations(). When some degrees of freedom cannot be estimated
+  (isoJoIdentity_ is false), the normal equations are projected with \f$ J = {^c}V_o {^o}J_o \f$.
+*/
+void
+vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsigned int iter, const vpMatrix &LTL, const vpColVector &LTR,
+                                      const vpColVector &error, vpColVector &error_prev, double &mu, vpColVector &v,
+                                      const vpColVector * const w, vpColVector * const m_w_prev) {
+  vpVelocityTwistMatrix cVo;
+  vpMatrix A;
+  vpColVector b;
+  if (isoJoIdentity_) {
+    A = LTL;
+    b = LTR;
+  } else {
+    cVo.buildFrom(cMo);
+    vpMatrix J = cVo*oJo;
+    vpMatrix JT = J.t();
+    A = JT * LTL * J;
+    b = JT * LTR;
+  }
+
+  switch (m_optimizationMethod) {
+    case vpMbTracker::LEVENBERG_MARQUARDT_OPT:
+      {
+        vpMatrix LMA(A.getRows(), A.getCols());
+        LMA.eye();
+        vpMatrix LTLmuI = A + (LMA*mu);
+        v = -m_lambda*LTLmuI.pseudoInverse(LTLmuI.getRows()*std::numeric_limits<double>::epsilon())*b;
+
+        if(iter != 0)
+          mu /= 10.0;
+
+        error_prev = error;
+        if (w != NULL && m_w_prev != NULL)
+          *m_w_prev = *w;
+        break;
+      }
+
+    case vpMbTracker::GAUSS_NEWTON_OPT:
+    default:
+      v = -m_lambda * A.pseudoInverse(A.getRows()*std::numeric_limits<double>::epsilon()) * b;
+      break;
+  }
+
+  if (!isoJoIdentity_) {
+    v = cVo * v;
+  }
+}
+
 void
 vpMbTracker::computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w) {
   if (error.getRows() > 0)
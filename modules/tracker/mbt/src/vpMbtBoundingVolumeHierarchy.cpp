@@ -0,0 +1,436 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bounding volume hierarchy over the polygons of a CAD model.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtBoundingVolumeHierarchy.cpp
+ \brief Bounding volume hierarchy over the polygons of a CAD model.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbtBoundingVolumeHierarchy.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace {
+  // Maximum number of polygons in a leaf
+  const unsigned int vpBvhMaxLeafSize = 4;
+  // Margin (in radian) added to the back-face angle to be robust to the rounding errors of the per-polygon test
+  const double vpBvhAngleMargin = 1e-6;
+
+  struct vpBvhKeyComparator
+  {
+    explicit vpBvhKeyComparator(const std::vector<double> &keys) : m_keys(keys) {}
+
+    inline bool operator()(const unsigned int a, const unsigned int b) const { return m_keys[a] < m_keys[b]; }
+
+    const std::vector<double> &m_keys;
+  };
+
+  inline double clampCosine(const double c) { return c > 1.0 ? 1.0 : (c < -1.0 ? -1.0 : c); }
+
+  // Minimum over the box [bbMin, bbMax] of n.X + d
+  inline double boxMinimum(const double *n, const double d, const double *bbMin, const double *bbMax)
+  {
+    double value = d;
+    for (unsigned int k = 0; k < 3; k++) {
+      value += n[k] * (n[k] > 0 ? bbMin[k] : bbMax[k]);
+    }
+    return value;
+  }
+
+  // Tolerance on boxMinimum() to be robust to the rounding errors of the clipping
+  inline double boxTolerance(const double *n, const double d, const double *bbMin, const double *bbMax)
+  {
+    double scale = std::fabs(d);
+    for (unsigned int k = 0; k < 3; k++) {
+      scale += std::fabs(n[k]) * std::max(std::fabs(bbMin[k]), std::fabs(bbMax[k]));
+    }
+    return 1e-9 * scale + std::numeric_limits<double>::min();
+  }
+}
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor, the hierarchy is empty.
+*/
+vpMbtBoundingVolumeHierarchy::vpMbtBoundingVolumeHierarchy()
+  : m_nodes(), m_indices(), m_centroidsDiagonal(0)
+{
+}
+
+/*!
+  Build the hierarchy over a list of polygons. The polygons are identified by
+  their position in the list in the results of cullBackFaces() and cullFrustum().
+
+  Only the geometry of the polygons (their corners in the object frame and
+  whether they have an orientation) is used, the hierarchy has to be built again
+  when it changes.
+
+  \param polygons : List of the polygons.
+*/
+void vpMbtBoundingVolumeHierarchy::build(const std::vector<vpMbtPolygon *> &polygons)
+{
+  clear();
+  if (polygons.empty()) {
+    return;
+  }
+
+  std::vector<vpBvhPrimitive> primitives(polygons.size());
+  double cMin[3] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                     std::numeric_limits<double>::max() };
+  double cMax[3] = { -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(),
+                     -std::numeric_limits<double>::max() };
+
+  for (size_t i = 0; i < polygons.size(); i++) {
+    const vpMbtPolygon *polygon = polygons[i];
+    vpBvhPrimitive &primitive = primitives[i];
+    const unsigned int nbpt = polygon->getNbPoint();
+
+    for (unsigned int k = 0; k < 3; k++) {
+      primitive.bbMin[k] = std::numeric_limits<double>::max();
+      primitive.bbMax[k] = -std::numeric_limits<double>::max();
+      primitive.centroid[k] = 0;
+      primitive.normal[k] = 0;
+    }
+
+    for (unsigned int j = 0; j < nbpt; j++) {
+      const vpPoint &cur = polygon->p[j], &next = polygon->p[(j + 1) % nbpt];
+      const double P[3] = { cur.get_oX(), cur.get_oY(), cur.get_oZ() };
+      for (unsigned int k = 0; k < 3; k++) {
+        primitive.bbMin[k] = std::min(primitive.bbMin[k], P[k]);
+        primitive.bbMax[k] = std::max(primitive.bbMax[k], P[k]);
+        primitive.centroid[k] += P[k];
+      }
+
+      // Newell's method, as in vpMbtPolygon::isVisible()
+      primitive.normal[0] += (cur.get_oY() - next.get_oY()) * (cur.get_oZ() + next.get_oZ());
+      primitive.normal[1] += (cur.get_oZ() - next.get_oZ()) * (cur.get_oX() + next.get_oX());
+      primitive.normal[2] += (cur.get_oX() - next.get_oX()) * (cur.get_oY() + next.get_oY());
+    }
+
+    double norm = std::sqrt(primitive.normal[0] * primitive.normal[0] + primitive.normal[1] * primitive.normal[1] +
+                            primitive.normal[2] * primitive.normal[2]);
+    // Lines and polygons without orientation (cylinders) are always tested individually
+    primitive.oriented = nbpt > 2 && polygon->hasOrientation && norm > std::numeric_limits<double>::epsilon();
+    primitive.invNbPoint = nbpt > 0 ? 1.0 / nbpt : 0;
+
+    for (unsigned int k = 0; k < 3; k++) {
+      primitive.centroid[k] = nbpt > 0 ? primitive.centroid[k] / nbpt : 0;
+      primitive.normal[k] = primitive.oriented ? primitive.normal[k] / norm : 0;
+      cMin[k] = std::min(cMin[k], primitive.centroid[k]);
+      cMax[k] = std::max(cMax[k], primitive.centroid[k]);
+    }
+  }
+
+  m_centroidsDiagonal = std::sqrt(vpMath::sqr(cMax[0] - cMin[0]) + vpMath::sqr(cMax[1] - cMin[1]) +
+                                  vpMath::sqr(cMax[2] - cMin[2]));
+
+  m_indices.resize(polygons.size());
+  for (unsigned int i = 0; i < m_indices.size(); i++) {
+    m_indices[i] = i;
+  }
+  m_nodes.reserve(2 * polygons.size() / vpBvhMaxLeafSize + 1);
+  std::vector<double> keys(polygons.size());
+  buildNode(primitives, keys, 0, (unsigned int)m_indices.size());
+}
+
+/*!
+  Build the node containing the polygons m_indices[first, last) and its
+  children, and return its index in m_nodes. \e keys is a buffer of the size of
+  the number of polygons used to sort them.
+
+  The polygons are split at the median along the dimension, among the centroid
+  position and the normal direction, with the largest relative extent. Splitting
+  on the normals first groups the polygons with similar orientations, which is
+  needed for the back-face culling of whole nodes.
+*/
+int vpMbtBoundingVolumeHierarchy::buildNode(const std::vector<vpBvhPrimitive> &primitives, std::vector<double> &keys,
+                                            const unsigned int first, const unsigned int last)
+{
+  vpBvhNode node;
+  node.first = first;
+  node.last = last;
+  node.left = node.right = -1;
+  node.oriented = true;
+  node.invNbPointMin = std::numeric_limits<double>::max();
+  node.invNbPointMax = 0;
+
+  double cMin[3], cMax[3], nMin[3], nMax[3], axisSum[3] = { 0, 0, 0 };
+  for (unsigned int k = 0; k < 3; k++) {
+    node.bbMin[k] = cMin[k] = nMin[k] = std::numeric_limits<double>::max();
+    node.bbMax[k] = cMax[k] = nMax[k] = -std::numeric_limits<double>::max();
+  }
+
+  for (unsigned int i = first; i < last; i++) {
+    const vpBvhPrimitive &primitive = primitives[m_indices[i]];
+    node.oriented = node.oriented && primitive.oriented;
+    node.invNbPointMin = std::min(node.invNbPointMin, primitive.invNbPoint);
+    node.invNbPointMax = std::max(node.invNbPointMax, primitive.invNbPoint);
+    for (unsigned int k = 0; k < 3; k++) {
+      node.bbMin[k] = std::min(node.bbMin[k], primitive.bbMin[k]);
+      node.bbMax[k] = std::max(node.bbMax[k], primitive.bbMax[k]);
+      cMin[k] = std::min(cMin[k], primitive.centroid[k]);
+      cMax[k] = std::max(cMax[k], primitive.centroid[k]);
+      nMin[k] = std::min(nMin[k], primitive.normal[k]);
+      nMax[k] = std::max(nMax[k], primitive.normal[k]);
+      axisSum[k] += primitive.normal[k];
+    }
+  }
+
+  // Sphere bounding the centroids
+  node.radius = 0;
+  for (unsigned int k = 0; k < 3; k++) {
+    node.center[k] = 0.5 * (cMin[k] + cMax[k]);
+  }
+  for (unsigned int i = first; i < last; i++) {
+    const double *c = primitives[m_indices[i]].centroid;
+    node.radius = std::max(node.radius, vpMath::sqr(c[0] - node.center[0]) + vpMath::sqr(c[1] - node.center[1]) +
+                                            vpMath::sqr(c[2] - node.center[2]));
+  }
+  node.radius = std::sqrt(node.radius);
+
+  // Cone bounding the normals
+  node.coneAngle = M_PI;
+  double axisNorm = std::sqrt(axisSum[0] * axisSum[0] + axisSum[1] * axisSum[1] + axisSum[2] * axisSum[2]);
+  for (unsigned int k = 0; k < 3; k++) {
+    node.axis[k] = axisNorm > std::numeric_limits<double>::epsilon() ? axisSum[k] / axisNorm : 0;
+  }
+  if (node.oriented && axisNorm > std::numeric_limits<double>::epsilon()) {
+    double minCos = 1.0;
+    for (unsigned int i = first; i < last; i++) {
+      const double *n = primitives[m_indices[i]].normal;
+      minCos = std::min(minCos, node.axis[0] * n[0] + node.axis[1] * n[1] + node.axis[2] * n[2]);
+    }
+    node.coneAngle = std::acos(clampCosine(minCos));
+  }
+
+  int nodeIndex = (int)m_nodes.size();
+  m_nodes.push_back(node);
+
+  if (last - first <= vpBvhMaxLeafSize) {
+    return nodeIndex;
+  }
+
+  // Choose the split dimension
+  unsigned int dimension = 0;
+  double bestExtent = -1;
+  for (unsigned int k = 0; k < 3; k++) {
+    double spatialExtent = m_centroidsDiagonal > 0 ? (cMax[k] - cMin[k]) / m_centroidsDiagonal : 0;
+    if (spatialExtent > bestExtent) {
+      bestExtent = spatialExtent;
+      dimension = k;
+    }
+    // A normal coordinate is in [-1, 1]
+    double normalExtent = 0.5 * (nMax[k] - nMin[k]);
+    if (normalExtent > bestExtent) {
+      bestExtent = normalExtent;
+      dimension = 3 + k;
+    }
+  }
+
+  for (unsigned int i = first; i < last; i++) {
+    const vpBvhPrimitive &primitive = primitives[m_indices[i]];
+    keys[m_indices[i]] = dimension < 3 ? primitive.centroid[dimension] : primitive.normal[dimension - 3];
+  }
+
+  unsigned int middle = first + (last - first) / 2;
+  std::nth_element(m_indices.begin() + first, m_indices.begin() + middle, m_indices.begin() + last,
+                   vpBvhKeyComparator(keys));
+
+  int left = buildNode(primitives, keys, first, middle);
+  int right = buildNode(primitives, keys, middle, last);
+  m_nodes[(size_t)nodeIndex].left = left;
+  m_nodes[(size_t)nodeIndex].right = right;
+
+  return nodeIndex;
+}
+
+/*!
+  Remove all the nodes of the hierarchy.
+*/
+void vpMbtBoundingVolumeHierarchy::clear()
+{
+  m_nodes.clear();
+  m_indices.clear();
+  m_centroidsDiagonal = 0;
+}
+
+/*!
+  Find the polygons that are back-facing for a given pose.
+
+  A polygon is reported when the angle between its normal and the direction
+  from its centroid to the camera, as computed in vpMbtPolygon::isVisible(), is
+  above \e angle. The test is done on the nodes of the hierarchy using the bounds
+  of their normals and centroids, the polygons are not accessed.
+
+  vpMbtPolygon::isVisible() sums the corners in a vpPoint whose Z coordinate is
+  initialised to 1: the direction to the camera is taken from the centroid
+  shifted by 1/nbpt along the optical axis. The same point is used here so that
+  the results are identical.
+
+  \param cMo : Pose of the camera.
+  \param angle : Angle (in radian) above which a polygon is considered as back-facing.
+  \param culled : For each polygon used to build the hierarchy, true if the polygon is back-facing. A false
+  value means that the polygon has to be tested individually.
+*/
+void vpMbtBoundingVolumeHierarchy::cullBackFaces(const vpHomogeneousMatrix &cMo, const double angle,
+                                                 std::vector<bool> &culled) const
+{
+  culled.assign(m_indices.size(), false);
+  if (m_nodes.empty() || angle + vpBvhAngleMargin >= M_PI) {
+    return;
+  }
+
+  // Position of the camera in the object frame
+  double cameraPos[3];
+  for (unsigned int k = 0; k < 3; k++) {
+    cameraPos[k] = -(cMo[0][k] * cMo[0][3] + cMo[1][k] * cMo[1][3] + cMo[2][k] * cMo[2][3]);
+  }
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (!stack.empty()) {
+    const vpBvhNode &node = m_nodes[(size_t)stack.back()];
+    stack.pop_back();
+
+    if (node.oriented) {
+      // Sphere bounding the centroids shifted along the optical axis
+      double shift = 0.5 * (node.invNbPointMin + node.invNbPointMax);
+      double radius = node.radius + 0.5 * (node.invNbPointMax - node.invNbPointMin);
+      double d[3];
+      for (unsigned int k = 0; k < 3; k++) {
+        d[k] = cameraPos[k] - (node.center[k] + shift * cMo[2][k]);
+      }
+      double distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+      if (distance > radius) {
+        // Lower bound of the angle between a normal of the node and the direction from a centroid to the camera
+        double viewAngle = std::acos(clampCosine((node.axis[0] * d[0] + node.axis[1] * d[1] + node.axis[2] * d[2]) / distance));
+        double minAngle = viewAngle - std::asin(radius / distance) - node.coneAngle;
+        if (minAngle > angle + vpBvhAngleMargin) {
+          for (unsigned int i = node.first; i < node.last; i++) {
+            culled[m_indices[i]] = true;
+          }
+          continue;
+        }
+      }
+    }
+
+    if (node.left >= 0) {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+  }
+}
+
+/*!
+  Find the polygons that lie entirely outside one of the clipping planes of the
+  camera frustum. Such polygons give an empty polygon when they are clipped by
+  vpPolygon3D::computePolygonClipped() with the corresponding clipping flag.
+
+  \param cMo : Pose of the camera.
+  \param cam : Camera parameters. The field of view planes are used only if they have been computed with
+  vpCameraParameters::computeFov().
+  \param nearClippingDistance : Distance of the near clipping plane.
+  \param farClippingDistance : Distance of the far clipping plane.
+  \param outside : For each polygon used to build the hierarchy, the combination of vpPolygon3D::vpPolygon3DClippingType
+  flags of the planes the polygon is outside of. A null value means that the polygon has to be clipped individually.
+*/
+void vpMbtBoundingVolumeHierarchy::cullFrustum(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
+                                               const double nearClippingDistance, const double farClippingDistance,
+                                               std::vector<unsigned int> &outside) const
+{
+  outside.assign(m_indices.size(), 0);
+  if (m_nodes.empty()) {
+    return;
+  }
+
+  // Planes in the object frame, a point X is outside when n.X + d > 0
+  unsigned int nbPlanes = 2;
+  double planes[6][4];
+  unsigned int flags[6] = { vpPolygon3D::NEAR_CLIPPING, vpPolygon3D::FAR_CLIPPING, vpPolygon3D::LEFT_CLIPPING,
+                            vpPolygon3D::RIGHT_CLIPPING, vpPolygon3D::UP_CLIPPING, vpPolygon3D::DOWN_CLIPPING };
+  for (unsigned int k = 0; k < 3; k++) {
+    // Z < near
+    planes[0][k] = -cMo[2][k];
+    // Z > far
+    planes[1][k] = cMo[2][k];
+  }
+  planes[0][3] = nearClippingDistance - cMo[2][3];
+  planes[1][3] = cMo[2][3] - farClippingDistance;
+
+  if (cam.isFovComputed()) {
+    // The normals of the field of view planes point outside
+    std::vector<vpColVector> fovNormals = cam.getFovNormals();
+    for (unsigned int i = 0; i < fovNormals.size() && i < 4; i++) {
+      const vpColVector &n = fovNormals[i];
+      for (unsigned int k = 0; k < 3; k++) {
+        planes[nbPlanes][k] = n[0] * cMo[0][k] + n[1] * cMo[1][k] + n[2] * cMo[2][k];
+      }
+      planes[nbPlanes][3] = n[0] * cMo[0][3] + n[1] * cMo[1][3] + n[2] * cMo[2][3];
+      nbPlanes++;
+    }
+  }
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (!stack.empty()) {
+    const vpBvhNode &node = m_nodes[(size_t)stack.back()];
+    stack.pop_back();
+
+    unsigned int mask = 0;
+    for (unsigned int j = 0; j < nbPlanes; j++) {
+      if (boxMinimum(planes[j], planes[j][3], node.bbMin, node.bbMax) >
+          boxTolerance(planes[j], planes[j][3], node.bbMin, node.bbMax)) {
+        mask |= flags[j];
+      }
+    }
+
+    if (mask != 0) {
+      for (unsigned int i = node.first; i < node.last; i++) {
+        outside[m_indices[i]] = mask;
+      }
+    } else if (node.left >= 0) {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+  }
+}
@@ -0,0 +1,440 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Binary cache of a CAD model loaded by the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtModelCache.cpp
+ \brief Binary cache of a CAD model loaded by the model-based tracker.
+*/
+
+#include <cstring>
+#include <fstream>
+
+#include <visp3/core/vpException.h>
+#include <visp3/mbt/vpMbtModelCache.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace {
+  // "VPMBTMC" followed by the format version. The version must be increased each time the layout changes.
+  const char vpMbtModelCacheMagic[8] = { 'V', 'P', 'M', 'B', 'T', 'M', 'C', '\0' };
+  const uint32_t vpMbtModelCacheVersion = 1;
+  // Written in the native byte order, used to reject a cache created on a machine with another endianness
+  const uint32_t vpMbtModelCacheByteOrder = 0x01020304;
+
+  const uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+  const uint64_t fnvPrime = 1099511628211ULL;
+
+  // 64 bits FNV-1a hash
+  uint64_t fnv1a(const char *data, const size_t size, uint64_t hash = fnvOffsetBasis)
+  {
+    for (size_t i = 0; i < size; i++) {
+      hash ^= (unsigned char) data[i];
+      hash *= fnvPrime;
+    }
+    return hash;
+  }
+
+  class vpCacheWriter
+  {
+  public:
+    template<typename T> void write(const T &value)
+    {
+      const char *p = reinterpret_cast<const char *>(&value);
+      buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+
+    void write(const std::string &value)
+    {
+      write((uint32_t) value.size());
+      buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    std::vector<char> buffer;
+  };
+
+  class vpCacheReader
+  {
+  public:
+    vpCacheReader(const std::vector<char> &data, const size_t size) : buffer(data), end(size), pos(0) {}
+
+    template<typename T> bool read(T &value)
+    {
+      if (pos + sizeof(T) > end) {
+        return false;
+      }
+      memcpy(&value, &buffer[pos], sizeof(T));
+      pos += sizeof(T);
+      return true;
+    }
+
+    bool read(std::string &value)
+    {
+      uint32_t size;
+      if (!read(size) || pos + size > end) {
+        return false;
+      }
+      value.assign(buffer.begin() + (std::ptrdiff_t) pos, buffer.begin() + (std::ptrdiff_t) (pos + size));
+      pos += size;
+      return true;
+    }
+
+    const std::vector<char> &buffer;
+    size_t end;
+    size_t pos;
+  };
+}
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor of a primitive.
+*/
+vpMbtModelCache::vpMbtPrimitive::vpMbtPrimitive()
+  : type(POLYGON_FROM_CORNERS), idFace(-1), points(), radius(0), name(), useLod(false),
+    minPolygonAreaThreshold(2500.0), minLineLengthThreshold(50.0)
+{
+}
+
+/*!
+  Default constructor.
+*/
+vpMbtModelCache::vpMbtModelCache()
+  : m_counters(6, 0), m_firstIdFace(0), m_useLod(false), m_applyLodSettingInConfig(false), m_minLineLengthThreshold(50.0),
+    m_minPolygonAreaThreshold(2500.0), m_primitives(), m_sourceFiles(), m_sourceHashes()
+{
+}
+
+/*!
+  Add a primitive at the end of the model.
+
+  \param primitive : The primitive to add.
+*/
+void vpMbtModelCache::addPrimitive(const vpMbtPrimitive &primitive)
+{
+  m_primitives.push_back(primitive);
+}
+
+/*!
+  Add a file the model is loaded from. The hash of its content is computed now.
+
+  \throw vpException::ioError if the file cannot be read.
+
+  \param filename : The model file.
+*/
+void vpMbtModelCache::addSourceFile(const std::string &filename)
+{
+  m_sourceHashes.push_back(hashFile(filename));
+  m_sourceFiles.push_back(filename);
+}
+
+/*!
+  Remove the primitives and the source files.
+*/
+void vpMbtModelCache::clear()
+{
+  m_counters.assign(6, 0);
+  m_firstIdFace = 0;
+  m_primitives.clear();
+  m_sourceFiles.clear();
+  m_sourceHashes.clear();
+}
+
+/*!
+  Compute the 64 bits FNV-1a hash of the content of a file.
+
+  \throw vpException::ioError if the file cannot be read.
+
+  \param filename : The file to hash.
+  \return The hash of the file.
+*/
+uint64_t vpMbtModelCache::hashFile(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot read file: %s", filename.c_str());
+  }
+
+  uint64_t hash = fnvOffsetBasis;
+  char buffer[1 << 16];
+  while (file) {
+    file.read(buffer, sizeof(buffer));
+    hash = fnv1a(buffer, (size_t) file.gcount(), hash);
+  }
+  return hash;
+}
+
+/*!
+  Compute the 64 bits FNV-1a hash of a string.
+
+  \param str : The string to hash.
+  \return The hash of the string.
+*/
+uint64_t vpMbtModelCache::hashString(const std::string &str)
+{
+  return fnv1a(str.data(), str.size());
+}
+
+/*!
+  Check that the source files still exist and have not been modified since the
+  cache was created.
+
+  \return True if the cache can be used in place of the source files.
+*/
+bool vpMbtModelCache::isUpToDate() const
+{
+  if (m_sourceFiles.empty()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < m_sourceFiles.size(); i++) {
+    try {
+      if (hashFile(m_sourceFiles[i]) != m_sourceHashes[i]) {
+        return false;
+      }
+    } catch (const vpException &) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+  Load the cache from a binary file created by save(). The file is read at once
+  and decoded in memory.
+
+  \param filename : The cache file.
+  \return False if the file does not exist, was created with another version of
+  the format, does not list any source file or is corrupted. In that case the
+  cache is left empty.
+*/
+bool vpMbtModelCache::load(const std::string &filename)
+{
+  clear();
+
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.seekg(0, std::ios::end);
+  const std::streamoff size = file.tellg();
+  // Header and trailing checksum
+  if (size < (std::streamoff) (sizeof(vpMbtModelCacheMagic) + 2*sizeof(uint32_t) + sizeof(uint64_t))) {
+    return false;
+  }
+  std::vector<char> data((size_t) size);
+  file.seekg(0, std::ios::beg);
+  if (!file.read(&data[0], size)) {
+    return false;
+  }
+
+  const size_t payloadSize = (size_t) size - sizeof(uint64_t);
+  uint64_t checksum;
+  memcpy(&checksum, &data[payloadSize], sizeof(uint64_t));
+  if (memcmp(&data[0], vpMbtModelCacheMagic, sizeof(vpMbtModelCacheMagic)) != 0 || fnv1a(&data[0], payloadSize) != checksum) {
+    return false;
+  }
+
+  vpCacheReader reader(data, payloadSize);
+  reader.pos = sizeof(vpMbtModelCacheMagic);
+  uint32_t version, byteOrder;
+  if (!reader.read(version) || version != vpMbtModelCacheVersion || !reader.read(byteOrder) ||
+      byteOrder != vpMbtModelCacheByteOrder) {
+    return false;
+  }
+
+  bool ok = true;
+  unsigned char useLod = 0, applyLodSettingInConfig = 0;
+  ok = ok && reader.read(useLod) && reader.read(applyLodSettingInConfig) && reader.read(m_minLineLengthThreshold) &&
+       reader.read(m_minPolygonAreaThreshold);
+  if (ok) {
+    m_useLod = useLod != 0;
+    m_applyLodSettingInConfig = applyLodSettingInConfig != 0;
+  }
+
+  for (size_t i = 0; i < m_counters.size() && ok; i++) {
+    uint32_t counter = 0;
+    ok = reader.read(counter);
+    m_counters[i] = counter;
+  }
+  int32_t firstIdFace = 0;
+  ok = ok && reader.read(firstIdFace);
+  m_firstIdFace = firstIdFace;
+
+  // The model file itself is always the first source file
+  uint32_t nbSourceFiles = 0;
+  ok = ok && reader.read(nbSourceFiles) && nbSourceFiles > 0;
+  for (uint32_t i = 0; i < nbSourceFiles && ok; i++) {
+    std::string sourceFile;
+    uint64_t hash = 0;
+    ok = reader.read(sourceFile) && reader.read(hash);
+    m_sourceFiles.push_back(sourceFile);
+    m_sourceHashes.push_back(hash);
+  }
+
+  uint32_t nbPrimitives = 0;
+  ok = ok && reader.read(nbPrimitives);
+  if (ok) {
+    m_primitives.resize(nbPrimitives);
+  }
+  for (uint32_t i = 0; i < nbPrimitives && ok; i++) {
+    vpMbtPrimitive &primitive = m_primitives[i];
+    uint32_t type = 0, nbPoints = 0;
+    int32_t idFace = 0;
+    unsigned char primitiveUseLod = 0;
+    ok = reader.read(type) && type <= (uint32_t) CIRCLE && reader.read(idFace) && reader.read(nbPoints) &&
+         reader.pos + (size_t) nbPoints * 3 * sizeof(double) <= reader.end;
+    if (!ok) {
+      break;
+    }
+    primitive.type = (vpMbtPrimitiveType) type;
+    primitive.idFace = idFace;
+    primitive.points.resize(nbPoints);
+    for (uint32_t j = 0; j < nbPoints; j++) {
+      double X, Y, Z;
+      reader.read(X);
+      reader.read(Y);
+      reader.read(Z);
+      primitive.points[j].setWorldCoordinates(X, Y, Z);
+    }
+    ok = reader.read(primitive.radius) && reader.read(primitive.name) && reader.read(primitiveUseLod) &&
+         reader.read(primitive.minPolygonAreaThreshold) && reader.read(primitive.minLineLengthThreshold);
+    primitive.useLod = primitiveUseLod != 0;
+  }
+
+  if (!ok || reader.pos != payloadSize) {
+    clear();
+    return false;
+  }
+  return true;
+}
+
+/*!
+  Check if the general LOD settings used to create the cache are the given ones.
+  These settings give the default values of the primitives that do not set them.
+
+  \return True if the settings are the same.
+*/
+bool vpMbtModelCache::matchLodSettings(const bool useLod, const bool applyLodSettingInConfig,
+                                       const double minLineLengthThreshold, const double minPolygonAreaThreshold) const
+{
+  return m_useLod == useLod && m_applyLodSettingInConfig == applyLodSettingInConfig &&
+         m_minLineLengthThreshold == minLineLengthThreshold && m_minPolygonAreaThreshold == minPolygonAreaThreshold;
+}
+
+/*!
+  Save the cache in a binary file. The numbers are written in the native byte
+  order, a cache file is then only read back on a machine with the same
+  endianness.
+
+  \throw vpException::ioError if the file cannot be written.
+
+  \param filename : The cache file.
+*/
+void vpMbtModelCache::save(const std::string &filename) const
+{
+  vpCacheWriter writer;
+  writer.buffer.insert(writer.buffer.end(), vpMbtModelCacheMagic, vpMbtModelCacheMagic + sizeof(vpMbtModelCacheMagic));
+  writer.write(vpMbtModelCacheVersion);
+  writer.write(vpMbtModelCacheByteOrder);
+
+  writer.write((unsigned char) m_useLod);
+  writer.write((unsigned char) m_applyLodSettingInConfig);
+  writer.write(m_minLineLengthThreshold);
+  writer.write(m_minPolygonAreaThreshold);
+  for (size_t i = 0; i < m_counters.size(); i++) {
+    writer.write((uint32_t) m_counters[i]);
+  }
+  writer.write((int32_t) m_firstIdFace);
+
+  writer.write((uint32_t) m_sourceFiles.size());
+  for (size_t i = 0; i < m_sourceFiles.size(); i++) {
+    writer.write(m_sourceFiles[i]);
+    writer.write(m_sourceHashes[i]);
+  }
+
+  writer.write((uint32_t) m_primitives.size());
+  for (size_t i = 0; i < m_primitives.size(); i++) {
+    const vpMbtPrimitive &primitive = m_primitives[i];
+    writer.write((uint32_t) primitive.type);
+    writer.write((int32_t) primitive.idFace);
+    writer.write((uint32_t) primitive.points.size());
+    for (size_t j = 0; j < primitive.points.size(); j++) {
+      writer.write(primitive.points[j].get_oX());
+      writer.write(primitive.points[j].get_oY());
+      writer.write(primitive.points[j].get_oZ());
+    }
+    writer.write(primitive.radius);
+    writer.write(primitive.name);
+    writer.write((unsigned char) primitive.useLod);
+    writer.write(primitive.minPolygonAreaThreshold);
+    writer.write(primitive.minLineLengthThreshold);
+  }
+  writer.write(fnv1a(&writer.buffer[0], writer.buffer.size()));
+
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open() || !file.write(&writer.buffer[0], (std::streamsize) writer.buffer.size())) {
+    throw vpException(vpException::ioError, "Cannot write model cache file: %s", filename.c_str());
+  }
+}
+
+/*!
+  Set the number of points, lines, polygon lines, polygon points, cylinders and
+  circles of the model, as printed when the model is loaded.
+*/
+void vpMbtModelCache::setCounters(const unsigned int nbPoints, const unsigned int nbLines,
+                                  const unsigned int nbPolygonLines, const unsigned int nbPolygonPoints,
+                                  const unsigned int nbCylinders, const unsigned int nbCircles)
+{
+  m_counters[0] = nbPoints;
+  m_counters[1] = nbLines;
+  m_counters[2] = nbPolygonLines;
+  m_counters[3] = nbPolygonPoints;
+  m_counters[4] = nbCylinders;
+  m_counters[5] = nbCircles;
+}
+
+/*!
+  Set the general LOD settings used when the model was parsed.
+
+  \sa matchLodSettings()
+*/
+void vpMbtModelCache::setLodSettings(const bool useLod, const bool applyLodSettingInConfig,
+                                     const double minLineLengthThreshold, const double minPolygonAreaThreshold)
+{
+  m_useLod = useLod;
+  m_applyLodSettingInConfig = applyLodSettingInConfig;
+  m_minLineLengthThreshold = minLineLengthThreshold;
+  m_minPolygonAreaThreshold = minPolygonAreaThreshold;
+}
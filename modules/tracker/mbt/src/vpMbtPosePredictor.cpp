@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Prediction of the pose of the object for the next image.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtPosePredictor.cpp
+ \brief Prediction of the pose of the object for the next image.
+*/
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/mbt/vpMbtPosePredictor.h>
+
+/*!
+  Default constructor.
+
+  \param type : Type of prediction.
+*/
+vpMbtPosePredictor::vpMbtPosePredictor(const vpPredictionType type)
+  : m_type(type), m_cMo(), m_timestamp(0), m_nbPoses(0), m_velocity(6, 0), m_kalman(), m_sigmaAcceleration(1e-3),
+    m_sigmaVelocity(1e-3), m_rho(0.5)
+{
+  reset();
+}
+
+/*!
+  Predict the pose of the object at a given time.
+
+  The prediction is done only if \e cMo is the last pose given to update(),
+  otherwise the pose has been changed by an initialization of the tracker or by
+  a tracking failure and the previous poses are discarded.
+
+  \param cMo : Current pose.
+  \param timestamp : Time of the prediction, in the unit of the timestamps given to update().
+  \param cMo_pred : Predicted pose, \e cMo if no prediction is done.
+
+  \return true if the pose has been predicted.
+*/
+bool vpMbtPosePredictor::predict(const vpHomogeneousMatrix &cMo, const double timestamp, vpHomogeneousMatrix &cMo_pred)
+{
+  cMo_pred = cMo;
+  for (unsigned int i = 0; i < 3 && m_nbPoses > 0; i++) {
+    for (unsigned int j = 0; j < 4; j++) {
+      if (cMo[i][j] != m_cMo[i][j]) {
+        reset();
+        break;
+      }
+    }
+  }
+
+  if (m_type == NO_PREDICTION || m_nbPoses < 2 || timestamp <= m_timestamp) {
+    return false;
+  }
+
+  cMo_pred = vpExponentialMap::direct(m_velocity, timestamp - m_timestamp) * cMo;
+  return true;
+}
+
+/*!
+  Discard the previous poses.
+*/
+void vpMbtPosePredictor::reset()
+{
+  m_nbPoses = 0;
+  m_velocity = 0;
+
+  m_kalman.setStateModel(vpLinearKalmanFilterInstantiation::stateConstVelWithColoredNoise_MeasureVel);
+  vpColVector sigma_state(2 * 6, m_sigmaAcceleration), sigma_measure(6, m_sigmaVelocity);
+  m_kalman.initFilter(6, sigma_state, sigma_measure, m_rho, 0);
+}
+
+/*!
+  Set the parameters of the Kalman filter used with the
+  vpMbtPosePredictor::KALMAN_PREDICTION type. The same values are used for the
+  translational (in m/s) and rotational (in rad/s) components of the velocity.
+  The previous poses are discarded.
+
+  \param sigmaAcceleration : Variance of the acceleration noise. Default is 1e-3.
+  \param sigmaVelocity : Variance of the measured velocities. Default is 1e-3.
+  \param rho : Degree of correlation between successive accelerations, in [0, 1[. Default is 0.5.
+
+  \sa vpLinearKalmanFilterInstantiation::initStateConstVelWithColoredNoise_MeasureVel()
+*/
+void vpMbtPosePredictor::setKalmanParameters(const double sigmaAcceleration, const double sigmaVelocity,
+                                             const double rho)
+{
+  if (rho < 0 || rho >= 1) {
+    throw vpException(vpException::badValue, "Bad rho value: %f, it has to be in [0, 1[", rho);
+  }
+
+  m_sigmaAcceleration = sigmaAcceleration;
+  m_sigmaVelocity = sigmaVelocity;
+  m_rho = rho;
+  reset();
+}
+
+/*!
+  Set the type of prediction. The previous poses are discarded.
+
+  \param type : Type of prediction.
+*/
+void vpMbtPosePredictor::setPredictionType(const vpPredictionType type)
+{
+  m_type = type;
+  reset();
+}
+
+/*!
+  Add the pose estimated at a given time.
+
+  \param cMo : Estimated pose.
+  \param timestamp : Time of the image used to estimate the pose, in seconds or in any other unit.
+*/
+void vpMbtPosePredictor::update(const vpHomogeneousMatrix &cMo, const double timestamp)
+{
+  if (m_nbPoses > 0 && timestamp > m_timestamp) {
+    vpColVector velocity = vpExponentialMap::inverse(cMo * m_cMo.inverse(), timestamp - m_timestamp);
+
+    if (m_type == KALMAN_PREDICTION) {
+      m_kalman.filter(velocity);
+      for (unsigned int i = 0; i < 6; i++) {
+        m_velocity[i] = m_kalman.Xest[2 * i];
+      }
+    } else {
+      m_velocity = velocity;
+    }
+    m_nbPoses = 2;
+  } else {
+    reset();
+    m_nbPoses = 1;
+  }
+
+  m_cMo = cMo;
+  m_timestamp = timestamp;
+}
@@ -0,0 +1,500 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Timings and counters of the model-based trackers.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtTrackingStatistics.cpp
+ \brief Timings and counters of the model-based trackers.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <limits>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/mbt/vpMbtTrackingStatistics.h>
+
+namespace
+{
+const unsigned int nbHistogramBins = 10;
+
+void writeJsonString(std::ostream &os, const std::string &str)
+{
+  os << '"';
+  for (size_t i = 0; i < str.size(); i++) {
+    const unsigned char c = (unsigned char)str[i];
+    if (c == '"' || c == '\\') {
+      os << '\\' << str[i];
+    } else if (c < 0x20) {
+      const char *hex = "0123456789abcdef";
+      os << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+    } else {
+      os << str[i];
+    }
+  }
+  os << '"';
+}
+
+void writeJson(std::ostream &os, const vpMbtTrackingStatistics::vpRollingStatistic &statistic)
+{
+  std::vector<unsigned int> histogram;
+  double lower = 0, upper = 0;
+  statistic.getHistogram(nbHistogramBins, histogram, lower, upper);
+
+  os << "{\"count\": " << statistic.getCount() << ", \"last\": " << statistic.getLast()
+     << ", \"mean\": " << statistic.getMean() << ", \"stdev\": " << statistic.getStdev()
+     << ", \"min\": " << statistic.getMin() << ", \"max\": " << statistic.getMax()
+     << ", \"median\": " << statistic.getPercentile(50) << ", \"p95\": " << statistic.getPercentile(95)
+     << ", \"histogram\": {\"lower\": " << lower << ", \"upper\": " << upper << ", \"bins\": [";
+  for (size_t i = 0; i < histogram.size(); i++) {
+    os << (i > 0 ? ", " : "") << histogram[i];
+  }
+  os << "]}}";
+}
+
+void writeJson(std::ostream &os, const std::map<std::string, vpMbtTrackingStatistics::vpRollingStatistic> &statistics,
+               const std::string &indent)
+{
+  os << "{";
+  for (std::map<std::string, vpMbtTrackingStatistics::vpRollingStatistic>::const_iterator it = statistics.begin();
+       it != statistics.end(); ++it) {
+    os << (it == statistics.begin() ? "\n" : ",\n") << indent << "  ";
+    writeJsonString(os, it->first);
+    os << ": ";
+    writeJson(os, it->second);
+  }
+  os << (statistics.empty() ? "}" : "\n" + indent + "}");
+}
+}
+
+/*!
+  Default constructor.
+
+  \param windowSize : Number of last values used to compute the statistics.
+*/
+vpMbtTrackingStatistics::vpRollingStatistic::vpRollingStatistic(const unsigned int windowSize)
+  : m_values(), m_windowSize(std::max(1u, windowSize)), m_next(0), m_count(0)
+{
+}
+
+/*!
+  Add a value, the oldest value being discarded if the window is full.
+*/
+void vpMbtTrackingStatistics::vpRollingStatistic::add(const double value)
+{
+  if (m_values.size() < m_windowSize) {
+    m_values.push_back(value);
+  } else {
+    m_values[m_next] = value;
+  }
+  m_next = (m_next + 1) % m_windowSize;
+  m_count++;
+}
+
+/*!
+  Compute the histogram of the last values.
+
+  \param nbBins : Number of bins.
+  \param histogram : Number of values in each bin, empty if there is no value.
+  \param lower : Lower bound of the first bin, the smallest value.
+  \param upper : Upper bound of the last bin, the largest value.
+*/
+void vpMbtTrackingStatistics::vpRollingStatistic::getHistogram(const unsigned int nbBins,
+                                                               std::vector<unsigned int> &histogram, double &lower,
+                                                               double &upper) const
+{
+  histogram.clear();
+  lower = getMin();
+  upper = getMax();
+  if (m_values.empty() || nbBins == 0) {
+    return;
+  }
+
+  histogram.resize(nbBins, 0);
+  const double width = (upper - lower) / nbBins;
+  for (size_t i = 0; i < m_values.size(); i++) {
+    unsigned int bin = width > 0 ? (unsigned int)((m_values[i] - lower) / width) : 0;
+    histogram[std::min(bin, nbBins - 1)]++;
+  }
+}
+
+/*!
+  Return the last value, 0 if there is no value.
+*/
+double vpMbtTrackingStatistics::vpRollingStatistic::getLast() const
+{
+  if (m_values.empty()) {
+    return 0;
+  }
+  return m_values[(m_next + m_windowSize - 1) % m_windowSize];
+}
+
+/*!
+  Return the largest of the last values, 0 if there is no value.
+*/
+double vpMbtTrackingStatistics::vpRollingStatistic::getMax() const
+{
+  return m_values.empty() ? 0 : *std::max_element(m_values.begin(), m_values.end());
+}
+
+/*!
+  Return the mean of the last values, 0 if there is no value.
+*/
+double vpMbtTrackingStatistics::vpRollingStatistic::getMean() const
+{
+  if (m_values.empty()) {
+    return 0;
+  }
+
+  double sum = 0;
+  for (size_t i = 0; i < m_values.size(); i++) {
+    sum += m_values[i];
+  }
+  return sum / m_values.size();
+}
+
+/*!
+  Return the smallest of the last values, 0 if there is no value.
+*/
+double vpMbtTrackingStatistics::vpRollingStatistic::getMin() const
+{
+  return m_values.empty() ? 0 : *std::min_element(m_values.begin(), m_values.end());
+}
+
+/*!
+  Return a percentile of the last values, using the nearest rank, 0 if there
+  is no value.
+
+  \param percentile : Percentile in [0, 100], 50 for the median.
+*/
+double vpMbtTrackingStatistics::vpRollingStatistic::getPercentile(const double percentile) const
+{
+  if (m_values.empty()) {
+    return 0;
+  }
+
+  const double p = std::min(100.0, std::max(0.0, percentile));
+  size_t rank = (size_t)std::ceil(p / 100 * m_values.size());
+  rank = rank > 0 ? rank - 1 : 0;
+
+  std::vector<double> values(m_values);
+  std::nth_element(values.begin(), values.begin() + (std::ptrdiff_t)rank, values.end());
+  return values[rank];
+}
+
+/*!
+  Return the standard deviation of the last values, 0 if there is no value.
+*/
+double vpMbtTrackingStatistics::vpRollingStatistic::getStdev() const
+{
+  if (m_values.empty()) {
+    return 0;
+  }
+
+  const double mean = getMean();
+  double sum = 0;
+  for (size_t i = 0; i < m_values.size(); i++) {
+    sum += (m_values[i] - mean) * (m_values[i] - mean);
+  }
+  return std::sqrt(sum / m_values.size());
+}
+
+/*!
+  Start the timer.
+
+  \param duration : Duration in milliseconds that will be increased by the
+  time spent until the destruction of the timer, NULL to measure nothing.
+*/
+vpMbtTrackingStatistics::vpScopedTimer::vpScopedTimer(double *duration)
+  : m_duration(duration), m_start(duration != NULL ? vpTime::measureTimeMs() : 0)
+{
+}
+
+vpMbtTrackingStatistics::vpScopedTimer::~vpScopedTimer()
+{
+  if (m_duration != NULL) {
+    *m_duration += vpTime::measureTimeMs() - m_start;
+  }
+}
+
+/*!
+  Default constructor.
+
+  \param windowSize : Number of last values used to compute the statistics of each quantity.
+*/
+vpMbtTrackingStatistics::vpMbtTrackingStatistics(const unsigned int windowSize)
+  : m_timings(), m_counters(), m_windowSize(std::max(1u, windowSize))
+{
+}
+
+/*!
+  Add the value of a counter.
+
+  \param scope : Camera name, empty for the whole tracker.
+  \param name : Name of the counter.
+  \param value : Value of the counter.
+*/
+void vpMbtTrackingStatistics::addCounter(const std::string &scope, const std::string &name, const double value)
+{
+  vpStatisticMap &counters = m_counters[scope];
+  vpStatisticMap::iterator it = counters.find(name);
+  if (it == counters.end()) {
+    it = counters.insert(std::make_pair(name, vpRollingStatistic(m_windowSize))).first;
+  }
+  it->second.add(value);
+}
+
+/*!
+  Add the duration of a stage.
+
+  \param scope : Camera name, empty for the whole tracker.
+  \param name : Name of the stage.
+  \param duration : Duration in milliseconds.
+*/
+void vpMbtTrackingStatistics::addTiming(const std::string &scope, const std::string &name, const double duration)
+{
+  vpStatisticMap &timings = m_timings[scope];
+  vpStatisticMap::iterator it = timings.find(name);
+  if (it == timings.end()) {
+    it = timings.insert(std::make_pair(name, vpRollingStatistic(m_windowSize))).first;
+  }
+  it->second.add(duration);
+}
+
+/*!
+  Remove all the values.
+*/
+void vpMbtTrackingStatistics::clear()
+{
+  m_timings.clear();
+  m_counters.clear();
+}
+
+/*!
+  Return the statistics of a counter.
+
+  \throw vpException::badValue if the counter has no value.
+
+  \param scope : Camera name, empty for the whole tracker.
+  \param name : Name of the counter.
+*/
+const vpMbtTrackingStatistics::vpRollingStatistic &vpMbtTrackingStatistics::getCounter(const std::string &scope,
+                                                                                     const std::string &name) const
+{
+  std::map<std::string, vpStatisticMap>::const_iterator it_scope = m_counters.find(scope);
+  if (it_scope != m_counters.end()) {
+    vpStatisticMap::const_iterator it = it_scope->second.find(name);
+    if (it != it_scope->second.end()) {
+      return it->second;
+    }
+  }
+
+  throw vpException(vpException::badValue, "No counter %s for scope \"%s\"", name.c_str(), scope.c_str());
+}
+
+/*!
+  Return the names of the counters of a scope.
+
+  \param scope : Camera name, empty for the whole tracker.
+*/
+std::vector<std::string> vpMbtTrackingStatistics::getCounterNames(const std::string &scope) const
+{
+  std::vector<std::string> names;
+  std::map<std::string, vpStatisticMap>::const_iterator it_scope = m_counters.find(scope);
+  if (it_scope != m_counters.end()) {
+    for (vpStatisticMap::const_iterator it = it_scope->second.begin(); it != it_scope->second.end(); ++it) {
+      names.push_back(it->first);
+    }
+  }
+  return names;
+}
+
+/*!
+  Return the scopes that have timings or counters, the empty scope being the
+  whole tracker.
+*/
+std::vector<std::string> vpMbtTrackingStatistics::getScopes() const
+{
+  std::vector<std::string> scopes;
+  for (std::map<std::string, vpStatisticMap>::const_iterator it = m_timings.begin(); it != m_timings.end(); ++it) {
+    scopes.push_back(it->first);
+  }
+  for (std::map<std::string, vpStatisticMap>::const_iterator it = m_counters.begin(); it != m_counters.end(); ++it) {
+    if (m_timings.find(it->first) == m_timings.end()) {
+      scopes.push_back(it->first);
+    }
+  }
+  std::sort(scopes.begin(), scopes.end());
+  return scopes;
+}
+
+/*!
+  Return the statistics of the duration of a stage, in milliseconds.
+
+  \throw vpException::badValue if the stage has no duration.
+
+  \param scope : Camera name, empty for the whole tracker.
+  \param name : Name of the stage.
+*/
+const vpMbtTrackingStatistics::vpRollingStatistic &vpMbtTrackingStatistics::getTiming(const std::string &scope,
+                                                                                    const std::string &name) const
+{
+  std::map<std::string, vpStatisticMap>::const_iterator it_scope = m_timings.find(scope);
+  if (it_scope != m_timings.end()) {
+    vpStatisticMap::const_iterator it = it_scope->second.find(name);
+    if (it != it_scope->second.end()) {
+      return it->second;
+    }
+  }
+
+  throw vpException(vpException::badValue, "No timing %s for scope \"%s\"", name.c_str(), scope.c_str());
+}
+
+/*!
+  Return the names of the stages of a scope.
+
+  \param scope : Camera name, empty for the whole tracker.
+*/
+std::vector<std::string> vpMbtTrackingStatistics::getTimingNames(const std::string &scope) const
+{
+  std::vector<std::string> names;
+  std::map<std::string, vpStatisticMap>::const_iterator it_scope = m_timings.find(scope);
+  if (it_scope != m_timings.end()) {
+    for (vpStatisticMap::const_iterator it = it_scope->second.begin(); it != it_scope->second.end(); ++it) {
+      names.push_back(it->first);
+    }
+  }
+  return names;
+}
+
+/*!
+  Return true if the counter has values.
+*/
+bool vpMbtTrackingStatistics::hasCounter(const std::string &scope, const std::string &name) const
+{
+  std::map<std::string, vpStatisticMap>::const_iterator it_scope = m_counters.find(scope);
+  return it_scope != m_counters.end() && it_scope->second.find(name) != it_scope->second.end();
+}
+
+/*!
+  Return true if the stage has durations.
+*/
+bool vpMbtTrackingStatistics::hasTiming(const std::string &scope, const std::string &name) const
+{
+  std::map<std::string, vpStatisticMap>::const_iterator it_scope = m_timings.find(scope);
+  return it_scope != m_timings.end() && it_scope->second.find(name) != it_scope->second.end();
+}
+
+/*!
+  Write the statistics in a JSON file, see writeJson().
+
+  \throw vpException::ioError if the file cannot be written.
+*/
+void vpMbtTrackingStatistics::saveJson(const std::string &filename) const
+{
+  std::ofstream file(filename.c_str());
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot open file: %s", filename.c_str());
+  }
+  writeJson(file);
+}
+
+/*!
+  Set the number of last values used to compute the statistics. All the
+  values are removed.
+*/
+void vpMbtTrackingStatistics::setWindowSize(const unsigned int windowSize)
+{
+  m_windowSize = std::max(1u, windowSize);
+  clear();
+}
+
+/*!
+  Write the statistics in the JSON format. The quantities of the whole tracker
+  are in the \e tracker object and the quantities of each camera in the \e
+  cameras object:
+  \code
+{
+  "window_size": 100,
+  "tracker": {
+    "timings_ms": {"total": {"count": 250, "last": 4.1, "mean": 4.3, ...}, ...},
+    "counters": {"vvs_iterations": {...}, ...}
+  },
+  "cameras": {
+    "Camera1": {"timings_ms": {...}, "counters": {...}}
+  }
+}
+  \endcode
+  Each quantity gives the total number of values, and the last value, the
+  mean, the standard deviation, the extrema, the median, the 95th percentile
+  and a histogram of the last values.
+*/
+void vpMbtTrackingStatistics::writeJson(std::ostream &os) const
+{
+  const std::streamsize precision = os.precision(std::numeric_limits<double>::digits10);
+  const vpStatisticMap empty;
+  std::vector<std::string> scopes = getScopes();
+
+  os << "{\n  \"window_size\": " << m_windowSize << ",\n  \"tracker\": {\n    \"timings_ms\": ";
+  std::map<std::string, vpStatisticMap>::const_iterator it_timings = m_timings.find("");
+  ::writeJson(os, it_timings != m_timings.end() ? it_timings->second : empty, "    ");
+  os << ",\n    \"counters\": ";
+  std::map<std::string, vpStatisticMap>::const_iterator it_counters = m_counters.find("");
+  ::writeJson(os, it_counters != m_counters.end() ? it_counters->second : empty, "    ");
+  os << "\n  },\n  \"cameras\": {";
+
+  bool first = true;
+  for (size_t i = 0; i < scopes.size(); i++) {
+    if (scopes[i].empty()) {
+      continue;
+    }
+
+    os << (first ? "\n" : ",\n") << "    ";
+    writeJsonString(os, scopes[i]);
+    os << ": {\n      \"timings_ms\": ";
+    it_timings = m_timings.find(scopes[i]);
+    ::writeJson(os, it_timings != m_timings.end() ? it_timings->second : empty, "      ");
+    os << ",\n      \"counters\": ";
+    it_counters = m_counters.find(scopes[i]);
+    ::writeJson(os, it_counters != m_counters.end() ? it_counters->second : empty, "      ");
+    os << "\n    }";
+    first = false;
+  }
+  os << (first ? "}" : "\n  }") << "\n}\n";
+
+  os.precision(precision);
+}
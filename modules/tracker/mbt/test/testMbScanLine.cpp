@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the scanline visibility renderer.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbScanLine.cpp
+
+  \brief Test that the scanline renderer gives the same result when it is reused
+  from one frame to the next as when it renders the scene from scratch.
+*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbScanLine.h>
+
+namespace {
+  // Faces of a cube of side s with (x0, y0, z0) as corner
+  void addCube(std::vector<std::vector<vpPoint> > &faces, const double x0, const double y0, const double z0,
+               const double s)
+  {
+    const int corners[6][4] = { {0, 1, 3, 2}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 3, 7, 5} };
+    for (int f = 0; f < 6; f++) {
+      std::vector<vpPoint> face;
+      for (int k = 0; k < 4; k++) {
+        const int c = corners[f][k];
+        face.push_back(vpPoint(x0 + ((c & 1) ? s : 0), y0 + ((c & 2) ? s : 0), z0 + ((c & 4) ? s : 0)));
+      }
+      faces.push_back(face);
+    }
+  }
+
+  void render(vpMbScanLine &renderer, const std::vector<std::vector<vpPoint> > &faces, const vpHomogeneousMatrix &cMo,
+              const vpCameraParameters &cam)
+  {
+    std::vector<std::vector<std::pair<vpPoint, unsigned int> > > polygons(faces.size());
+    std::vector<std::vector<std::pair<vpPoint, unsigned int> > *> listPolygons;
+    std::vector<int> listIndices;
+    for (size_t f = 0; f < faces.size(); f++) {
+      for (size_t k = 0; k < faces[f].size(); k++) {
+        vpPoint P = faces[f][k];
+        P.changeFrame(cMo);
+        polygons[f].push_back(std::make_pair(P, 0u));
+      }
+      listPolygons.push_back(&polygons[f]);
+      listIndices.push_back((int) f);
+    }
+
+    renderer.drawScene(listPolygons, listIndices, cam, 640, 480);
+  }
+}
+
+int main()
+{
+  // A small cube partially occluding a bigger one
+  std::vector<std::vector<vpPoint> > faces;
+  addCube(faces, -0.05, -0.05, -0.05, 0.1);
+  addCube(faces, 0.02, 0.0, 0.1, 0.06);
+  vpCameraParameters cam(600, 600, 320, 240);
+
+  for (unsigned int maskBorder = 0; maskBorder <= 3; maskBorder += 3) {
+    vpMbScanLine renderer;
+    renderer.setMaskBorder(maskBorder);
+
+    for (int iter = 0; iter < 10; iter++) {
+      vpHomogeneousMatrix cMo(0.02 * iter - 0.1, -0.01 * iter, 0.5 + 0.03 * iter, vpMath::rad(20 + 7 * iter),
+                              vpMath::rad(-30 + 5 * iter), vpMath::rad(3 * iter));
+      render(renderer, faces, cMo, cam);
+
+      vpMbScanLine reference;
+      reference.setMaskBorder(maskBorder);
+      render(reference, faces, cMo, cam);
+
+      vpImage<int> ids = renderer.getPrimitiveIDs();
+      vpImage<unsigned char> mask = renderer.getMask();
+      if (ids != reference.getPrimitiveIDs() || mask != reference.getMask()) {
+        std::cerr << "Different rendering at iteration " << iter << " with a mask border of " << maskBorder << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "testMbScanLine is ok" << std::endl;
+  return EXIT_SUCCESS;
+}
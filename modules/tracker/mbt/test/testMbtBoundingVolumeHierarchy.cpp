@@ -0,0 +1,198 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the bounding volume hierarchy used to cull the faces of the model.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtBoundingVolumeHierarchy.cpp
+
+  \brief Test that the visibility and the clipping of the faces of a model are
+  the same with and without the bounding volume hierarchy of vpMbHiddenFaces.
+*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbHiddenFaces.h>
+
+namespace {
+  void addFace(vpMbHiddenFaces<vpMbtPolygon> &faces, const std::vector<vpPoint> &corners, const bool oriented,
+               const bool useLod)
+  {
+    vpMbtPolygon polygon;
+    polygon.setIndex((int)faces.size());
+    polygon.setNbPoint((unsigned int)corners.size());
+    for (unsigned int i = 0; i < corners.size(); i++) {
+      polygon.addPoint(i, corners[i]);
+    }
+    polygon.setIsPolygonOriented(oriented);
+    polygon.setLod(useLod);
+    polygon.setMinPolygonAreaThresh(50);
+    polygon.setMinLineLengthThresh(20);
+    faces.addPolygon(&polygon);
+
+    faces.getPolygon().back()->setClipping(vpPolygon3D::ALL_CLIPPING);
+    faces.getPolygon().back()->setNearClippingDistance(0.05);
+    faces.getPolygon().back()->setFarClippingDistance(1.5);
+  }
+
+  // A grid of boxes, each box has quadrilateral faces, a face split in two
+  // triangles, a face without orientation and a line
+  void createModel(vpMbHiddenFaces<vpMbtPolygon> &faces, const unsigned int n)
+  {
+    const double s = 0.01;
+    const int F[6][4] = { { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 }, { 2, 3, 7, 6 }, { 1, 2, 6, 5 }, { 0, 4, 7, 3 } };
+
+    for (unsigned int a = 0; a < n; a++) {
+      for (unsigned int b = 0; b < n; b++) {
+        for (unsigned int c = 0; c < n / 2; c++) {
+          double x = a * 2 * s, y = b * 2 * s, z = c * 2 * s;
+          vpPoint v[8] = { vpPoint(x, y, z),         vpPoint(x + s, y, z),         vpPoint(x + s, y + s, z),
+                           vpPoint(x, y + s, z),     vpPoint(x, y, z + s),         vpPoint(x + s, y, z + s),
+                           vpPoint(x + s, y + s, z + s), vpPoint(x, y + s, z + s) };
+
+          for (unsigned int k = 0; k < 6; k++) {
+            std::vector<vpPoint> corners;
+            for (unsigned int i = 0; i < 4; i++) {
+              corners.push_back(v[F[k][i]]);
+            }
+
+            if (k == 1) {
+              std::vector<vpPoint> triangle1(corners.begin(), corners.begin() + 3), triangle2;
+              triangle2.push_back(corners[0]);
+              triangle2.push_back(corners[2]);
+              triangle2.push_back(corners[3]);
+              addFace(faces, triangle1, true, false);
+              addFace(faces, triangle2, true, false);
+            } else {
+              addFace(faces, corners, k != 5 || (a + b) % 2 == 0, k == 2);
+            }
+          }
+
+          std::vector<vpPoint> line;
+          line.push_back(v[0]);
+          line.push_back(v[6]);
+          addFace(faces, line, true, (a + b + c) % 2 == 0);
+        }
+      }
+    }
+  }
+
+  bool sameResults(vpMbHiddenFaces<vpMbtPolygon> &faces1, vpMbHiddenFaces<vpMbtPolygon> &faces2)
+  {
+    for (unsigned int i = 0; i < faces1.size(); i++) {
+      if (faces1[i]->isVisible() != faces2[i]->isVisible() || faces1[i]->isAppearing() != faces2[i]->isAppearing()) {
+        std::cerr << "Different visibility for face " << i << std::endl;
+        return false;
+      }
+
+      std::vector<std::pair<vpPoint, unsigned int> > clipped1, clipped2;
+      faces1[i]->getPolygonClipped(clipped1);
+      faces2[i]->getPolygonClipped(clipped2);
+      if (clipped1.size() != clipped2.size()) {
+        std::cerr << "Different clipping for face " << i << std::endl;
+        return false;
+      }
+      for (size_t j = 0; j < clipped1.size(); j++) {
+        if (clipped1[j].second != clipped2[j].second || clipped1[j].first.get_X() != clipped2[j].first.get_X() ||
+            clipped1[j].first.get_Y() != clipped2[j].first.get_Y() ||
+            clipped1[j].first.get_Z() != clipped2[j].first.get_Z()) {
+          std::cerr << "Different clipped point for face " << i << std::endl;
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    vpMbHiddenFaces<vpMbtPolygon> faces;
+    createModel(faces, 6);
+    vpMbHiddenFaces<vpMbtPolygon> facesBvh(faces);
+    faces.setUseBoundingVolumeHierarchy(false);
+    facesBvh.setUseBoundingVolumeHierarchy(true);
+
+    vpImage<unsigned char> I(480, 640);
+    vpCameraParameters cam(600, 600, 320, 240);
+    cam.computeFov(I.getWidth(), I.getHeight());
+
+    vpUniRand rand(1234);
+    double t = 0, tBvh = 0;
+    unsigned int nbVisible = 0;
+    for (unsigned int iter = 0; iter < 50; iter++) {
+      // The camera looks at a random point of the model from a random viewpoint, possibly inside the model
+      vpTranslationVector target(rand() * 0.2, rand() * 0.2, rand() * 0.1);
+      vpThetaUVector tu(vpMath::rad(180 * (rand() - 0.5)), vpMath::rad(180 * (rand() - 0.5)),
+                        vpMath::rad(180 * (rand() - 0.5)));
+      vpHomogeneousMatrix cRo(vpTranslationVector(), tu);
+      vpTranslationVector cto = vpTranslationVector(0.02 * (rand() - 0.5), 0.02 * (rand() - 0.5), 0.5 * rand()) -
+                                cRo.getRotationMatrix() * target;
+      vpHomogeneousMatrix cMo(cto, tu);
+
+      double angleAppears = vpMath::rad(60 + 30 * rand());
+      double angleDisappears = vpMath::rad(60 + 30 * rand());
+      bool changed = false, changedBvh = false;
+
+      double t0 = vpTime::measureTimeMs();
+      unsigned int nb = faces.setVisible(I, cam, cMo, angleAppears, angleDisappears, changed);
+      faces.computeClippedPolygons(cMo, cam);
+      double t1 = vpTime::measureTimeMs();
+      unsigned int nbBvh = facesBvh.setVisible(I, cam, cMo, angleAppears, angleDisappears, changedBvh);
+      facesBvh.computeClippedPolygons(cMo, cam);
+      double t2 = vpTime::measureTimeMs();
+      t += t1 - t0;
+      tBvh += t2 - t1;
+      nbVisible += nb;
+
+      if (nb != nbBvh || changed != changedBvh || !sameResults(faces, facesBvh)) {
+        std::cerr << "Different results at iteration " << iter << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << faces.size() << " faces, " << nbVisible / 50 << " visible on average" << std::endl;
+    std::cout << "Visibility and clipping: " << t / 50 << " ms without hierarchy, " << tBvh / 50
+              << " ms with hierarchy" << std::endl;
+    std::cout << "testMbtBoundingVolumeHierarchy is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the KLT and hybrid model-based tracking of a synthetic box.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtKltTracking.cpp
+
+  \brief Track a textured synthetic box with the KLT features alone and with
+  the moving edges and the KLT features, and check the projection of the box
+  with the estimated poses.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_MODULE_KLT) && (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpMbtTeaBox.h"
+
+namespace {
+  // Largest distance in pixels between the corners of the box projected with the two poses
+  double imageError(const vpHomogeneousMatrix &cMo_est, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam)
+  {
+    double error = 0;
+    for (unsigned int i = 0; i < 8; i++) {
+      vpPoint P((i & 1) * vpMbtTeaBox::getSize(0), ((i >> 1) & 1) * vpMbtTeaBox::getSize(1),
+              -((i >> 2) & 1) * vpMbtTeaBox::getSize(2));
+      double u_est = 0, v_est = 0, u = 0, v = 0;
+      P.project(cMo_est);
+      vpMeterPixelConversion::convertPoint(cam, P.get_x(), P.get_y(), u_est, v_est);
+      P.project(cMo);
+      vpMeterPixelConversion::convertPoint(cam, P.get_x(), P.get_y(), u, v);
+      error = std::max(error, std::sqrt(vpMath::sqr(u_est - u) + vpMath::sqr(v_est - v)));
+    }
+    return error;
+  }
+
+  bool checkTracking(const std::string &name, const int trackerType, const std::string &modelFile,
+                     const vpCameraParameters &cam, const double tolerance)
+  {
+    vpImage<unsigned char> I(480, 640);
+    std::vector<vpColVector> pointCloud;
+
+    vpMbGenericTracker tracker(1, trackerType);
+    vpMbtTeaBox::setup(tracker, cam, modelFile);
+
+#if defined(VISP_HAVE_OPENCV)
+    vpKltOpencv klt;
+#else
+    vpKltTracker klt;
+#endif
+    klt.setMaxFeatures(300);
+    // The texture is much less contrasted than the outline of the box
+    klt.setWindowSize(9);
+    klt.setQuality(0.00001);
+    klt.setMinDistance(5);
+    klt.setHarrisFreeParameter(0.01);
+    klt.setBlockSize(3);
+    klt.setPyramidLevels(3);
+#if defined(VISP_HAVE_OPENCV)
+    tracker.setKltOpencv(klt);
+#else
+    tracker.setKltTracker(klt);
+#endif
+    tracker.setKltMaskBorder(5);
+
+    vpHomogeneousMatrix cMo = vpMbtTeaBox::getPose(vpTranslationVector(-0.02, 0, 0.4),
+                                                   vpThetaUVector(vpMath::rad(-30), vpMath::rad(20), vpMath::rad(10)));
+    vpHomogeneousMatrix cdMc(vpTranslationVector(0.002, 0.001, 0.002), vpThetaUVector(0, vpMath::rad(0.5), vpMath::rad(0.3)));
+
+    vpMbtTeaBox::render(cMo, cam, I, pointCloud, true);
+    tracker.initFromPose(I, cMo);
+    int nbPointsInit = tracker.getKltNbPoints();
+
+    double error = 0;
+    for (unsigned int iter = 0; iter < 20; iter++) {
+      cMo = cdMc * cMo;
+      vpMbtTeaBox::render(cMo, cam, I, pointCloud, true);
+      if (iter == 10) {
+        // The KLT points are moved to the given pose to be tracked in the next image
+        tracker.setPose(I, cMo);
+      } else {
+        tracker.track(I);
+      }
+      error = std::max(error, imageError(tracker.getPose(), cMo, cam));
+    }
+
+    std::cout << name << ": " << nbPointsInit << " KLT points at initialization, " << tracker.getKltNbPoints()
+              << " at the end, largest image error " << error << " px" << std::endl;
+    if (nbPointsInit == 0 || tracker.getKltNbPoints() == 0) {
+      std::cerr << "No KLT point with " << name << std::endl;
+      return false;
+    }
+    if (error > tolerance) {
+      std::cerr << "Tracking failure with " << name << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testMbtKltTracking");
+    vpIoTools::makeDirectory(directory);
+    std::string modelFile = vpIoTools::createFilePath(directory, "box.cao");
+    vpMbtTeaBox::writeModel(modelFile);
+
+    vpCameraParameters cam(600, 600, 320, 240);
+    if (!checkTracking("KLT", vpMbGenericTracker::KLT_TRACKER, modelFile, cam, 4)) {
+      return EXIT_FAILURE;
+    }
+    // The moving edges settings of vpMbtTeaBox::setup() are meant for smaller images and limit the accuracy
+    if (!checkTracking("Edge + KLT", vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::KLT_TRACKER, modelFile,
+                       cam, 10)) {
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+    std::cout << "testMbtKltTracking is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+#else
+int main()
+{
+  std::cout << "The KLT model-based tracking needs the klt module." << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,216 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the binary model cache of the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtModelCache.cpp
+
+  \brief Test that a CAD model instantiated from its binary cache gives the same
+  faces and features as the parsed model, and that the cache is rebuilt when an
+  included model file changes.
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+namespace {
+  void writeModels(const std::string &directory, const double boxHeight)
+  {
+    // Included model: a box with named faces
+    std::ofstream box(vpIoTools::createFilePath(directory, "box.cao").c_str());
+    box << "V1\n# 3D Points\n8\n"
+        << "0 0 0\n0 0 " << -boxHeight << "\n0.165 0 " << -boxHeight << "\n0.165 0 0\n"
+        << "0.165 0.068 0\n0.165 0.068 " << -boxHeight << "\n0 0.068 " << -boxHeight << "\n0 0.068 0\n"
+        << "# 3D Lines\n0\n# Faces from 3D lines\n0\n# Faces from 3D points\n6\n"
+        << "4 0 1 2 3 name=front\n4 1 6 5 2\n4 4 5 6 7 useLod=true minPolygonAreaThreshold=100\n"
+        << "4 0 3 4 7\n4 5 4 3 2\n4 0 7 6 1\n"
+        << "# 3D cylinders\n0\n# 3D circles\n0\n";
+    box.close();
+
+    // Main model: the box, lines, a face from lines, a cylinder and a circle
+    std::ofstream model(vpIoTools::createFilePath(directory, "model.cao").c_str());
+    model << "V1\nload(\"box.cao\")\n# 3D Points\n7\n"
+          << "0.3 0 0\n0.4 0 0\n0.4 0.1 0\n0.3 0.1 0\n0.5 0 0\n0.5 0 -0.1\n0.5 0.05 0\n"
+          << "# 3D Lines\n5\n0 1\n1 2\n2 3\n3 0\n0 2 name=diagonal minLineLengthThreshold=20\n"
+          << "# Faces from 3D lines\n1\n4 0 1 2 3 name=top\n"
+          << "# Faces from 3D points\n0\n"
+          << "# 3D cylinders\n1\n4 5 0.02 name=cyl\n"
+          << "# 3D circles\n1\n0.03 4 6 0 name=circle\n";
+  }
+
+  bool sameFaces(vpMbGenericTracker &tracker1, vpMbGenericTracker &tracker2)
+  {
+    if (tracker1.getNbPolygon() != tracker2.getNbPolygon()) {
+      std::cerr << "Different number of faces: " << tracker1.getNbPolygon() << " / " << tracker2.getNbPolygon() << std::endl;
+      return false;
+    }
+    for (unsigned int i = 0; i < tracker1.getNbPolygon(); i++) {
+      vpMbtPolygon *p1 = tracker1.getPolygon(i), *p2 = tracker2.getPolygon(i);
+      if (p1->getIndex() != p2->getIndex() || p1->getName() != p2->getName() || p1->getNbPoint() != p2->getNbPoint() ||
+          p1->useLod != p2->useLod || p1->minLineLengthThresh != p2->minLineLengthThresh ||
+          p1->minPolygonAreaThresh != p2->minPolygonAreaThresh) {
+        std::cerr << "Face " << i << " is different" << std::endl;
+        return false;
+      }
+      for (unsigned int j = 0; j < p1->getNbPoint(); j++) {
+        vpPoint P1 = p1->getPoint(j), P2 = p2->getPoint(j);
+        if (P1.get_oX() != P2.get_oX() || P1.get_oY() != P2.get_oY() || P1.get_oZ() != P2.get_oZ()) {
+          std::cerr << "Point " << j << " of face " << i << " is different" << std::endl;
+          return false;
+        }
+      }
+    }
+
+    std::list<vpMbtDistanceLine *> lines1, lines2;
+    std::list<vpMbtDistanceCylinder *> cylinders1, cylinders2;
+    std::list<vpMbtDistanceCircle *> circles1, circles2;
+    tracker1.getLline("Camera", lines1);
+    tracker2.getLline("Camera", lines2);
+    tracker1.getLcylinder("Camera", cylinders1);
+    tracker2.getLcylinder("Camera", cylinders2);
+    tracker1.getLcircle("Camera", circles1);
+    tracker2.getLcircle("Camera", circles2);
+    if (lines1.size() != lines2.size() || cylinders1.size() != cylinders2.size() || circles1.size() != circles2.size() ||
+        cylinders1.empty() || circles1.empty()) {
+      std::cerr << "Different moving edge features" << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testMbtModelCache");
+    std::string cacheDirectory = vpIoTools::createFilePath(directory, "cache");
+    if (vpIoTools::checkDirectory(directory)) {
+      vpIoTools::remove(directory);
+    }
+    vpIoTools::makeDirectory(directory);
+    writeModels(directory, 0.08);
+    std::string modelFile = vpIoTools::createFilePath(directory, "model.cao");
+
+    vpMbGenericTracker parsed(1, vpMbGenericTracker::EDGE_TRACKER);
+    parsed.loadModel(modelFile);
+
+    // The first load parses the model and creates the cache, the second one uses it
+    vpMbGenericTracker recorded(1, vpMbGenericTracker::EDGE_TRACKER), cached(1, vpMbGenericTracker::EDGE_TRACKER);
+    recorded.setModelCacheDirectory(cacheDirectory);
+    recorded.loadModel(modelFile);
+    std::vector<std::string> cacheFiles = vpIoTools::getDirFiles(cacheDirectory);
+    if (cacheFiles.size() != 1) {
+      std::cerr << "The cache file was not created" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpMbtModelCache cache;
+    if (!cache.load(vpIoTools::createFilePath(cacheDirectory, cacheFiles[0])) || cache.getSourceFiles().size() != 2 ||
+        !cache.isUpToDate()) {
+      std::cerr << "Bad cache file" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    cached.setModelCacheDirectory(cacheDirectory);
+    cached.loadModel(modelFile);
+    if (!sameFaces(parsed, recorded) || !sameFaces(parsed, cached)) {
+      return EXIT_FAILURE;
+    }
+
+    // A change in an included file invalidates the cache
+    writeModels(directory, 0.1);
+    if (cache.isUpToDate()) {
+      std::cerr << "Modified source file not detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpMbGenericTracker parsed2(1, vpMbGenericTracker::EDGE_TRACKER), cached2(1, vpMbGenericTracker::EDGE_TRACKER);
+    parsed2.loadModel(modelFile);
+    cached2.setModelCacheDirectory(cacheDirectory);
+    cached2.loadModel(modelFile);
+    if (!sameFaces(parsed2, cached2) || cached2.getPolygon(0)->getPoint(1).get_oZ() != -0.1) {
+      std::cerr << "Outdated cache used" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A corrupted cache file is ignored
+    std::string cacheFile = vpIoTools::createFilePath(cacheDirectory, cacheFiles[0]);
+    {
+      std::fstream file(cacheFile.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(40);
+      file.put('\x7f');
+    }
+    if (cache.load(cacheFile)) {
+      std::cerr << "Corrupted cache file not detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpMbGenericTracker cached3(1, vpMbGenericTracker::EDGE_TRACKER);
+    cached3.setModelCacheDirectory(cacheDirectory);
+    cached3.loadModel(modelFile);
+    if (!sameFaces(parsed2, cached3)) {
+      return EXIT_FAILURE;
+    }
+
+    // A well-formed cache file without any source file is ignored
+    vpMbtModelCache emptyCache;
+    emptyCache.save(cacheFile);
+    if (cache.load(cacheFile)) {
+      std::cerr << "Cache file without source file not detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpMbGenericTracker cached4(1, vpMbGenericTracker::EDGE_TRACKER);
+    cached4.setModelCacheDirectory(cacheDirectory);
+    cached4.loadModel(modelFile);
+    if (!sameFaces(parsed2, cached4)) {
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+    std::cout << "testMbtModelCache is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
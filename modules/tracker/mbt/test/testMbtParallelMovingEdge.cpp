@@ -0,0 +1,183 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the parallel tracking of the moving edges of the edge tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtParallelMovingEdge.cpp
+
+  \brief Track a synthetic box with the moving edges of the lines tracked
+  sequentially or in parallel, and check that the moving edges and the poses
+  are the same.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpMbtTeaBox.h"
+
+namespace {
+  bool sameMovingEdges(vpMbGenericTracker &tracker1, vpMbGenericTracker &tracker2)
+  {
+    std::list<vpMbtDistanceLine *> lines1, lines2;
+    tracker1.getLline("Camera", lines1);
+    tracker2.getLline("Camera", lines2);
+    if (lines1.size() != lines2.size()) {
+      return false;
+    }
+
+    unsigned int nbSites = 0;
+    for (std::list<vpMbtDistanceLine *>::const_iterator it1 = lines1.begin(), it2 = lines2.begin();
+         it1 != lines1.end(); ++it1, ++it2) {
+      if ((*it1)->meline.size() != (*it2)->meline.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < (*it1)->meline.size(); i++) {
+        const std::vector<vpMeSite> &sites1 = (*it1)->meline[i]->getMeSites();
+        const std::vector<vpMeSite> &sites2 = (*it2)->meline[i]->getMeSites();
+        if (sites1.size() != sites2.size()) {
+          return false;
+        }
+        for (size_t k = 0; k < sites1.size(); k++) {
+          if (sites1[k].i != sites2[k].i || sites1[k].j != sites2[k].j ||
+              sites1[k].getState() != sites2[k].getState()) {
+            return false;
+          }
+        }
+        nbSites += (unsigned int) sites1.size();
+      }
+    }
+    return nbSites > 0;
+  }
+
+  // The lines are independent: the parallel tracking must give exactly the same moving edges, hence the same pose
+  bool sameTracking(vpMbGenericTracker &tracker1, vpMbGenericTracker &tracker2)
+  {
+    vpHomogeneousMatrix cMo1 = tracker1.getPose(), cMo2 = tracker2.getPose();
+    for (unsigned int k = 0; k < 16; k++) {
+      if (std::fabs(cMo1.data[k] - cMo2.data[k]) > 1e-12) {
+        return false;
+      }
+    }
+    return sameMovingEdges(tracker1, tracker2);
+  }
+
+  void setMovingEdgeDisplay(vpMbGenericTracker &tracker, const vpMeSite::vpMeSiteDisplayType display)
+  {
+    std::list<vpMbtDistanceLine *> lines;
+    tracker.getLline("Camera", lines);
+    for (std::list<vpMbtDistanceLine *>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+      for (size_t i = 0; i < (*it)->meline.size(); i++) {
+        (*it)->meline[i]->setDisplay(display);
+      }
+    }
+  }
+}
+
+int main()
+{
+  try {
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testMbtParallelMovingEdge");
+    vpIoTools::makeDirectory(directory);
+    std::string modelFile = vpIoTools::createFilePath(directory, "box.cao");
+    vpMbtTeaBox::writeModel(modelFile);
+
+    vpImage<unsigned char> I(240, 320);
+    vpCameraParameters cam(300, 300, 160, 120);
+    std::vector<vpColVector> pointCloud;
+
+    vpMbGenericTracker sequential(1, vpMbGenericTracker::EDGE_TRACKER), parallel(1, vpMbGenericTracker::EDGE_TRACKER);
+    vpMbGenericTracker displayed(1, vpMbGenericTracker::EDGE_TRACKER);
+    vpMbtTeaBox::setup(sequential, cam, modelFile);
+    vpMbtTeaBox::setup(parallel, cam, modelFile);
+    vpMbtTeaBox::setup(displayed, cam, modelFile);
+    sequential.setUseParallelMovingEdgeTracking(false);
+
+    vpHomogeneousMatrix cMo = vpMbtTeaBox::getPose(vpTranslationVector(-0.03, 0, 0.6),
+                                                   vpThetaUVector(vpMath::rad(-30), vpMath::rad(20), vpMath::rad(10)));
+    vpHomogeneousMatrix cdMc(vpTranslationVector(0.002, 0.001, 0.002), vpThetaUVector(0, vpMath::rad(0.5), vpMath::rad(0.3)));
+
+    vpMbtTeaBox::render(cMo, cam, I, pointCloud);
+    sequential.initFromPose(I, cMo);
+    parallel.initFromPose(I, cMo);
+    displayed.initFromPose(I, cMo);
+    // The moving edges are displayed in the image, that has no display attached, while the lines are tracked
+    // sequentially despite the parallel tracking being enabled
+    setMovingEdgeDisplay(displayed, vpMeSite::RANGE_RESULT);
+
+    for (unsigned int iter = 0; iter < 20; iter++) {
+      cMo = cdMc * cMo;
+      vpMbtTeaBox::render(cMo, cam, I, pointCloud);
+      sequential.track(I);
+      parallel.track(I);
+      displayed.track(I);
+
+      if (!sameTracking(sequential, parallel)) {
+        std::cerr << "Different tracking with the sequential and the parallel moving edges at iteration " << iter
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (!sameTracking(sequential, displayed)) {
+        std::cerr << "Different tracking with the sequential and the displayed moving edges at iteration " << iter
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    double error = (parallel.getPose().getTranslationVector() - cMo.getTranslationVector()).euclideanNorm();
+    std::cout << "Translation error: " << error << " m" << std::endl;
+    // Without depth features the monocular edge tracking is less accurate along the optical axis
+    if (error > 1e-2) {
+      std::cerr << "Tracking failure" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+    std::cout << "testMbtParallelMovingEdge is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
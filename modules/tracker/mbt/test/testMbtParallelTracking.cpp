@@ -0,0 +1,218 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the parallel tracking mode of the generic model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtParallelTracking.cpp
+
+  \brief Track a synthetic box with two cameras, the cameras being processed
+  sequentially or in parallel, and check that the poses are the same and that
+  an exception raised for one camera is propagated with its type and code.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpMbtTeaBox.h"
+
+namespace {
+  const vpCameraParameters cam(300, 300, 160, 120);
+
+  class vpStereoTracker
+  {
+  public:
+    vpStereoTracker(const std::string &modelFile, const vpHomogeneousMatrix &c2Mc1, const bool parallel,
+                    const int trackerType = vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER,
+                    const unsigned int clipping = vpPolygon3D::NO_CLIPPING)
+      : m_tracker(std::vector<int>(2, trackerType)),
+        m_c2Mc1(c2Mc1), m_I1(240, 320), m_I2(240, 320), m_pointCloud1(), m_pointCloud2()
+    {
+      vpMbtTeaBox::setup(m_tracker, cam, modelFile);
+      m_tracker.setClipping(clipping);
+      std::map<std::string, vpHomogeneousMatrix> mapOfCameraTransformations;
+      mapOfCameraTransformations["Camera1"] = vpHomogeneousMatrix();
+      mapOfCameraTransformations["Camera2"] = c2Mc1;
+      m_tracker.setCameraTransformationMatrix(mapOfCameraTransformations);
+      m_tracker.setUseParallelTracking(parallel);
+    }
+
+    void init(const vpHomogeneousMatrix &cMo)
+    {
+      render(cMo);
+      m_tracker.initFromPose(m_I1, m_I2, cMo, m_c2Mc1 * cMo);
+    }
+
+    void track(const vpHomogeneousMatrix &cMo)
+    {
+      render(cMo);
+      std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+      std::map<std::string, const std::vector<vpColVector> *> mapOfPointClouds;
+      std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+      mapOfImages["Camera1"] = &m_I1;
+      mapOfImages["Camera2"] = &m_I2;
+      mapOfPointClouds["Camera1"] = &m_pointCloud1;
+      mapOfPointClouds["Camera2"] = &m_pointCloud2;
+      mapOfWidths["Camera1"] = mapOfWidths["Camera2"] = m_I1.getWidth();
+      mapOfHeights["Camera1"] = mapOfHeights["Camera2"] = m_I1.getHeight();
+      m_tracker.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+    }
+
+    vpHomogeneousMatrix getPose() const { return m_tracker.getPose(); }
+
+    void setMovingEdgeDisplay(const vpMeSite::vpMeSiteDisplayType display)
+    {
+      const char *cameras[] = { "Camera1", "Camera2" };
+      for (unsigned int c = 0; c < 2; c++) {
+        std::list<vpMbtDistanceLine *> lines;
+        m_tracker.getLline(cameras[c], lines);
+        for (std::list<vpMbtDistanceLine *>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+          for (size_t i = 0; i < (*it)->meline.size(); i++) {
+            (*it)->meline[i]->setDisplay(display);
+          }
+        }
+      }
+    }
+
+  private:
+    void render(const vpHomogeneousMatrix &cMo)
+    {
+      vpMbtTeaBox::render(cMo, cam, m_I1, m_pointCloud1);
+      vpMbtTeaBox::render(m_c2Mc1 * cMo, cam, m_I2, m_pointCloud2);
+    }
+
+    vpMbGenericTracker m_tracker;
+    vpHomogeneousMatrix m_c2Mc1;
+    vpImage<unsigned char> m_I1, m_I2;
+    std::vector<vpColVector> m_pointCloud1, m_pointCloud2;
+  };
+
+  // Error code of the vpTrackingException raised by the first tracked frame, -1 for another exception and -2
+  // without exception
+  int trackingErrorCode(const std::string &modelFile, const vpHomogeneousMatrix &c2Mc1, const vpHomogeneousMatrix &cMo,
+                        const bool parallel)
+  {
+    vpStereoTracker tracker(modelFile, c2Mc1, parallel, vpMbGenericTracker::EDGE_TRACKER, vpPolygon3D::FOV_CLIPPING);
+    tracker.init(cMo);
+    try {
+      tracker.track(cMo);
+    } catch (vpTrackingException &e) {
+      return e.getCode();
+    } catch (...) {
+      return -1;
+    }
+    return -2;
+  }
+}
+
+int main()
+{
+  try {
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testMbtParallelTracking");
+    vpIoTools::makeDirectory(directory);
+    std::string modelFile = vpIoTools::createFilePath(directory, "box.cao");
+    vpMbtTeaBox::writeModel(modelFile);
+
+    // The second camera is on the right of the first one and looks at the box
+    vpHomogeneousMatrix c2Mc1(vpTranslationVector(-0.1, 0, 0.01), vpThetaUVector(0, vpMath::rad(-8), 0));
+    vpHomogeneousMatrix cMo = vpMbtTeaBox::getPose(vpTranslationVector(-0.03, 0, 0.6),
+                                                   vpThetaUVector(vpMath::rad(-30), vpMath::rad(20), vpMath::rad(10)));
+    vpHomogeneousMatrix cdMc(vpTranslationVector(0.002, 0.001, 0.002), vpThetaUVector(0, vpMath::rad(0.5), vpMath::rad(0.3)));
+
+    vpStereoTracker sequential(modelFile, c2Mc1, false), parallel(modelFile, c2Mc1, true);
+    vpStereoTracker displayed(modelFile, c2Mc1, true);
+    sequential.init(cMo);
+    parallel.init(cMo);
+    displayed.init(cMo);
+    // The moving edges are displayed in the images, that have no display attached, while the cameras are tracked
+    // sequentially despite the parallel tracking being enabled
+    displayed.setMovingEdgeDisplay(vpMeSite::RANGE_RESULT);
+    for (unsigned int iter = 0; iter < 20; iter++) {
+      cMo = cdMc * cMo;
+      sequential.track(cMo);
+      parallel.track(cMo);
+      displayed.track(cMo);
+
+      vpHomogeneousMatrix cMo_sequential = sequential.getPose(), cMo_parallel = parallel.getPose();
+      vpHomogeneousMatrix cMo_displayed = displayed.getPose();
+      for (unsigned int k = 0; k < 16; k++) {
+        if (std::fabs(cMo_sequential.data[k] - cMo_parallel.data[k]) > 1e-12) {
+          std::cerr << "Different poses with the sequential and the parallel tracking at iteration " << iter << ":\n"
+                    << cMo_sequential << "\n" << cMo_parallel << std::endl;
+          return EXIT_FAILURE;
+        }
+        if (std::fabs(cMo_sequential.data[k] - cMo_displayed.data[k]) > 1e-12) {
+          std::cerr << "Different poses with the sequential and the displayed tracking at iteration " << iter << ":\n"
+                    << cMo_sequential << "\n" << cMo_displayed << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    double error = (sequential.getPose().getTranslationVector() - cMo.getTranslationVector()).euclideanNorm();
+    std::cout << "Translation error: " << error << " m" << std::endl;
+    if (error > 2e-3) {
+      std::cerr << "Tracking failure" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The box is out of the field of view of the second camera: its edge tracker has no feature and raises a
+    // vpTrackingException, that the parallel tracking must propagate with its type and its code
+    vpHomogeneousMatrix c2Mc1_away(vpTranslationVector(1, 0, 0), vpThetaUVector());
+    int codeSequential = trackingErrorCode(modelFile, c2Mc1_away, cMo, false);
+    int codeParallel = trackingErrorCode(modelFile, c2Mc1_away, cMo, true);
+    if (codeSequential != vpTrackingException::notEnoughPointError || codeParallel != codeSequential) {
+      std::cerr << "Bad exception propagation, error code " << codeSequential << " with the sequential tracking and "
+                << codeParallel << " with the parallel tracking" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+    std::cout << "testMbtParallelTracking is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,144 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the depth trackers with a vpPointCloud input.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtPointCloud.cpp
+
+  \brief Test that the depth trackers give the same pose when the depth is given
+  as a vpPointCloud or as a std::vector<vpColVector>.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPointCloud.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpMbtTeaBox.h"
+
+namespace {
+  bool testTracker(const int trackerType, const std::string &modelFile)
+  {
+    const unsigned int width = 320, height = 240;
+    vpCameraParameters cam(300, 300, width / 2., height / 2.);
+    vpHomogeneousMatrix cMo = vpMbtTeaBox::getPose(vpTranslationVector(0, 0, 0.45),
+                                                   vpThetaUVector(vpMath::rad(-35), vpMath::rad(30), vpMath::rad(10)));
+    vpHomogeneousMatrix cMo_init = vpHomogeneousMatrix(0.005, -0.004, 0.008, vpMath::rad(2), vpMath::rad(-1), 0) * cMo;
+
+    vpImage<unsigned char> I(height, width);
+    std::vector<vpColVector> rendered;
+    vpMbtTeaBox::render(cMo, cam, I, rendered);
+    vpPointCloud cloud(rendered, width, height);
+    // Points discarded through the validity mask
+    for (unsigned int i = 0; i < cloud.size(); i += 7) {
+      cloud.setValid(i, false);
+    }
+    std::vector<vpColVector> points;
+    cloud.toVector(points);
+
+    vpMbGenericTracker tracker1(1, trackerType), tracker2(1, trackerType);
+    vpMbGenericTracker *trackers[2] = { &tracker1, &tracker2 };
+    for (unsigned int t = 0; t < 2; t++) {
+      trackers[t]->setCameraParameters(cam);
+      trackers[t]->setAngleAppear(vpMath::rad(70));
+      trackers[t]->setAngleDisappear(vpMath::rad(80));
+      trackers[t]->setNearClippingDistance(0.1);
+      trackers[t]->setFarClippingDistance(2.0);
+      trackers[t]->loadModel(modelFile);
+      trackers[t]->initFromPose(I, cMo_init);
+    }
+
+    std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+    mapOfImages["Camera"] = &I;
+    std::map<std::string, const std::vector<vpColVector> *> mapOfPoints;
+    std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+    mapOfPoints["Camera"] = &points;
+    mapOfWidths["Camera"] = width;
+    mapOfHeights["Camera"] = height;
+    std::map<std::string, const vpPointCloud *> mapOfPointClouds;
+    mapOfPointClouds["Camera"] = &cloud;
+
+    vpHomogeneousMatrix cMo1, cMo2;
+    for (unsigned int iter = 0; iter < 5; iter++) {
+      tracker1.track(mapOfImages, mapOfPoints, mapOfWidths, mapOfHeights);
+      tracker2.track(mapOfImages, mapOfPointClouds);
+      tracker1.getPose(cMo1);
+      tracker2.getPose(cMo2);
+      for (unsigned int k = 0; k < 16; k++) {
+        if (std::fabs(cMo1.data[k] - cMo2.data[k]) > 1e-12) {
+          std::cerr << "Different poses with vpPointCloud and std::vector<vpColVector>" << std::endl;
+          return false;
+        }
+      }
+    }
+
+    double error = (cMo2.getTranslationVector() - cMo.getTranslationVector()).euclideanNorm();
+    std::cout << "Tracker " << trackerType << ": translation error " << error << " m" << std::endl;
+    if (error > 2e-3) {
+      std::cerr << "Tracker did not converge" << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    std::string modelFile = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testMbtPointCloud-teabox.cao");
+    vpMbtTeaBox::writeModel(modelFile);
+
+    if (!testTracker(vpMbGenericTracker::DEPTH_DENSE_TRACKER, modelFile) ||
+        !testTracker(vpMbGenericTracker::DEPTH_NORMAL_TRACKER, modelFile)) {
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testMbtPointCloud is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
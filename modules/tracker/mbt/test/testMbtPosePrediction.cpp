@@ -0,0 +1,197 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the pose prediction of the generic model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtPosePrediction.cpp
+
+  \brief Check that vpMbtPosePredictor extrapolates a constant velocity motion
+  and track a fast moving synthetic box with a small moving-edges range, the
+  tracker being warm started by the predicted pose.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpMbtTeaBox.h"
+
+namespace {
+  double translationError(const vpHomogeneousMatrix &cMo_est, const vpHomogeneousMatrix &cMo)
+  {
+    vpPoseVector error(cMo_est * cMo.inverse());
+    return std::sqrt(error[0] * error[0] + error[1] * error[1] + error[2] * error[2]);
+  }
+
+  // Largest distance in pixels between the corners of the box projected with the two poses
+  double imageError(const vpHomogeneousMatrix &cMo_est, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam)
+  {
+    double error = 0;
+    for (unsigned int i = 0; i < 8; i++) {
+      vpPoint P((i & 1) * vpMbtTeaBox::getSize(0), ((i >> 1) & 1) * vpMbtTeaBox::getSize(1),
+              -((i >> 2) & 1) * vpMbtTeaBox::getSize(2));
+      double u_est = 0, v_est = 0, u = 0, v = 0;
+      P.project(cMo_est);
+      vpMeterPixelConversion::convertPoint(cam, P.get_x(), P.get_y(), u_est, v_est);
+      P.project(cMo);
+      vpMeterPixelConversion::convertPoint(cam, P.get_x(), P.get_y(), u, v);
+      error = std::max(error, std::sqrt(vpMath::sqr(u_est - u) + vpMath::sqr(v_est - v)));
+    }
+    return error;
+  }
+
+  // Displacement along the velocity at time t, the box accelerates until t = 4 and then moves with a constant velocity
+  double displacement(const double t)
+  {
+    const double T = 4;
+    return t < T ? t * t / (2 * T) : t - T / 2;
+  }
+
+  // Track the moving box, return the largest reprojection error of its corners
+  double trackBox(const vpMbtPosePredictor::vpPredictionType type, const vpHomogeneousMatrix &cMo0,
+                  const vpColVector &v, const std::string &modelFile)
+  {
+    vpImage<unsigned char> I(240, 320);
+    vpCameraParameters cam(300, 300, 160, 120);
+    std::vector<vpColVector> pointCloud;
+
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER);
+    vpMbtTeaBox::setup(tracker, cam, modelFile, 4);
+    tracker.setPosePrediction(type);
+    tracker.setMovingEdgeMaxRange(20);
+
+    vpMbtTeaBox::render(cMo0, cam, I, pointCloud);
+    tracker.initFromPose(I, cMo0);
+
+    std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+    std::map<std::string, const std::vector<vpColVector> *> mapOfPointClouds;
+    std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+    mapOfImages["Camera"] = &I;
+    mapOfPointClouds["Camera"] = &pointCloud;
+    mapOfWidths["Camera"] = I.getWidth();
+    mapOfHeights["Camera"] = I.getHeight();
+    tracker.setFrameTimestamp(0);
+    tracker.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+
+    double maxError = 0, t = 0;
+    for (unsigned int iter = 1; iter < 14; iter++) {
+      // Irregular frame rate
+      t += (iter % 3 == 0) ? 1.5 : 1.0;
+      vpHomogeneousMatrix cMo = vpExponentialMap::direct(v, displacement(t)) * cMo0;
+      vpMbtTeaBox::render(cMo, cam, I, pointCloud);
+
+      tracker.setFrameTimestamp(t);
+      try {
+        tracker.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+      } catch (const vpException &) {
+        return std::numeric_limits<double>::max();
+      }
+      maxError = std::max(maxError, imageError(tracker.getPose(), cMo, cam));
+    }
+
+    return maxError;
+  }
+}
+
+int main()
+{
+  try {
+    vpColVector v(6);
+    v[0] = 0.016;
+    v[1] = 0.004;
+    v[2] = 0.004;
+    v[3] = vpMath::rad(0.2);
+    v[4] = vpMath::rad(-0.3);
+    v[5] = vpMath::rad(1.0);
+
+    vpHomogeneousMatrix cMo0 = vpMbtTeaBox::getPose(vpTranslationVector(-0.09, -0.02, 0.6),
+                                                    vpThetaUVector(vpMath::rad(-30), vpMath::rad(20), vpMath::rad(10)));
+
+    // The constant velocity prediction is exact for a constant velocity motion
+    vpMbtPosePredictor predictor(vpMbtPosePredictor::CONSTANT_VELOCITY_PREDICTION);
+    vpHomogeneousMatrix cMo_pred;
+    predictor.update(cMo0, 0.1);
+    if (predictor.predict(cMo0, 0.2, cMo_pred)) {
+      std::cerr << "Prediction without velocity" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpHomogeneousMatrix cMo1 = vpExponentialMap::direct(v, 0.5) * cMo0;
+    predictor.update(cMo1, 0.6);
+    if (!predictor.predict(cMo1, 1.3, cMo_pred) ||
+        translationError(cMo_pred, vpExponentialMap::direct(v, 1.2) * cMo0) > 1e-9) {
+      std::cerr << "Bad constant velocity prediction:\n" << cMo_pred << std::endl;
+      return EXIT_FAILURE;
+    }
+    // A pose that is not the last one, after a reinitialization, discards the velocity
+    if (predictor.predict(cMo0, 1.3, cMo_pred) || predictor.predict(cMo1, 1.3, cMo_pred)) {
+      std::cerr << "Prediction after a reinitialization" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testMbtPosePrediction");
+    vpIoTools::makeDirectory(directory);
+    std::string modelFile = vpIoTools::createFilePath(directory, "box.cao");
+    vpMbtTeaBox::writeModel(modelFile);
+
+    double error = trackBox(vpMbtPosePredictor::NO_PREDICTION, cMo0, v, modelFile);
+    double errorConstantVelocity = trackBox(vpMbtPosePredictor::CONSTANT_VELOCITY_PREDICTION, cMo0, v, modelFile);
+    double errorKalman = trackBox(vpMbtPosePredictor::KALMAN_PREDICTION, cMo0, v, modelFile);
+    vpIoTools::remove(directory);
+
+    std::cout << "Largest reprojection error without prediction: " << error << " px, with constant velocity prediction: "
+              << errorConstantVelocity << " px, with Kalman prediction: " << errorKalman << " px" << std::endl;
+    if (errorConstantVelocity > 3 || errorKalman > 3 || error <= errorConstantVelocity) {
+      std::cerr << "Tracking failure with the pose prediction" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "testMbtPosePrediction is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,156 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the predicted region of interest of the generic model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtPredictedRoi.cpp
+
+  \brief Track a synthetic box with the edge and dense depth features and check
+  that the tracker gives the same poses when the images and the point clouds are
+  erased outside of the predicted region of interest.
+*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpMbtTeaBox.h"
+
+namespace {
+  void eraseOutside(const vpRect &roi, vpImage<unsigned char> &I, std::vector<vpColVector> &pointCloud)
+  {
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        if (!roi.isInside(vpImagePoint(i, j))) {
+          I[i][j] = 0;
+          pointCloud[i * I.getWidth() + j] = 0;
+        }
+      }
+    }
+  }
+}
+
+int main()
+{
+  try {
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testMbtPredictedRoi");
+    vpIoTools::makeDirectory(directory);
+    std::string modelFile = vpIoTools::createFilePath(directory, "box.cao");
+    vpMbtTeaBox::writeModel(modelFile);
+
+    vpImage<unsigned char> I(240, 320), I_roi(240, 320);
+    vpCameraParameters cam(300, 300, 160, 120);
+    std::vector<vpColVector> pointCloud, pointCloud_roi;
+
+    int trackerType = vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER;
+    vpMbGenericTracker tracker(1, trackerType), tracker_roi(1, trackerType);
+    vpMbtTeaBox::setup(tracker, cam, modelFile);
+    vpMbtTeaBox::setup(tracker_roi, cam, modelFile);
+    tracker_roi.setUsePredictedRoi(true);
+
+    // The box moves in front of the camera
+    vpHomogeneousMatrix cMo = vpMbtTeaBox::getPose(vpTranslationVector(-0.03, 0, 0.6),
+                                                   vpThetaUVector(vpMath::rad(-30), vpMath::rad(20), vpMath::rad(10)));
+    vpHomogeneousMatrix cdMc(vpTranslationVector(0.002, 0.001, 0.002), vpThetaUVector(0, vpMath::rad(0.5), vpMath::rad(0.3)));
+
+    vpMbtTeaBox::render(cMo, cam, I, pointCloud);
+    tracker.initFromPose(I, cMo);
+    tracker_roi.initFromPose(I, cMo);
+
+    double meanRoiArea = 0;
+    const unsigned int nbFrames = 30;
+    for (unsigned int iter = 0; iter < nbFrames; iter++) {
+      cMo = cdMc * cMo;
+      vpMbtTeaBox::render(cMo, cam, I, pointCloud);
+
+      vpRect roi = tracker_roi.getPredictedRoi();
+      meanRoiArea += roi.getWidth() * roi.getHeight() / nbFrames;
+      I_roi = I;
+      pointCloud_roi = pointCloud;
+      eraseOutside(roi, I_roi, pointCloud_roi);
+
+      std::map<std::string, const vpImage<unsigned char> *> mapOfImages, mapOfImages_roi;
+      std::map<std::string, const std::vector<vpColVector> *> mapOfPointClouds, mapOfPointClouds_roi;
+      std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+      mapOfImages["Camera"] = &I;
+      mapOfImages_roi["Camera"] = &I_roi;
+      mapOfPointClouds["Camera"] = &pointCloud;
+      mapOfPointClouds_roi["Camera"] = &pointCloud_roi;
+      mapOfWidths["Camera"] = I.getWidth();
+      mapOfHeights["Camera"] = I.getHeight();
+
+      tracker.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+      tracker_roi.track(mapOfImages_roi, mapOfPointClouds_roi, mapOfWidths, mapOfHeights);
+
+      vpHomogeneousMatrix cMo_est = tracker.getPose(), cMo_roi = tracker_roi.getPose();
+      for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 4; j++) {
+          if (std::fabs(cMo_est[i][j] - cMo_roi[i][j]) > 1e-9) {
+            std::cerr << "Different poses at frame " << iter << ":\n" << cMo_est << "\n" << cMo_roi << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+
+      vpPoseVector error(cMo_est * cMo.inverse());
+      if (std::sqrt(error[0] * error[0] + error[1] * error[1] + error[2] * error[2]) > 0.01) {
+        std::cerr << "Tracking failure at frame " << iter << ":\n" << cMo_est << "\n" << cMo << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    if (tracker.getPredictedRoi().getWidth() * tracker.getPredictedRoi().getHeight() != I.getSize() || meanRoiArea > 0.6 * I.getSize()) {
+      std::cerr << "Bad predicted region of interest" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+    std::cout << "Mean area of the predicted region of interest: " << 100 * meanRoiArea / I.getSize() << "% of the image"
+              << std::endl;
+    std::cout << "testMbtPredictedRoi is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
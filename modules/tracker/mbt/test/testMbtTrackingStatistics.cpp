@@ -0,0 +1,199 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the timings and counters of the generic model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtTrackingStatistics.cpp
+
+  \brief Test the rolling statistics of vpMbtTrackingStatistics and the
+  timings and counters recorded by vpMbGenericTracker while tracking a
+  synthetic box.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpMbtTeaBox.h"
+
+namespace {
+  bool checkRollingStatistic()
+  {
+    vpMbtTrackingStatistics::vpRollingStatistic statistic(10);
+    for (unsigned int i = 0; i < 25; i++) {
+      statistic.add(i);
+    }
+
+    // The statistics are computed from the values 15 to 24
+    std::vector<unsigned int> histogram;
+    double lower = 0, upper = 0;
+    statistic.getHistogram(5, histogram, lower, upper);
+    if (statistic.getCount() != 25 || statistic.getWindowSize() != 10 || statistic.getLast() != 24 ||
+        statistic.getMin() != 15 || statistic.getMax() != 24 || std::fabs(statistic.getMean() - 19.5) > 1e-12 ||
+        std::fabs(statistic.getStdev() - std::sqrt(8.25)) > 1e-12 || statistic.getPercentile(50) != 19 ||
+        statistic.getPercentile(95) != 24 || statistic.getPercentile(0) != 15) {
+      std::cerr << "Bad rolling statistics" << std::endl;
+      return false;
+    }
+
+    if (histogram.size() != 5 || lower != 15 || upper != 24 || histogram[0] != 2 || histogram[4] != 2) {
+      std::cerr << "Bad histogram" << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    if (!checkRollingStatistic()) {
+      return EXIT_FAILURE;
+    }
+
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testMbtTrackingStatistics");
+    vpIoTools::makeDirectory(directory);
+    std::string modelFile = vpIoTools::createFilePath(directory, "box.cao");
+    vpMbtTeaBox::writeModel(modelFile);
+
+    vpImage<unsigned char> I(240, 320);
+    vpCameraParameters cam(300, 300, 160, 120);
+    std::vector<vpColVector> pointCloud;
+
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER);
+    vpMbtTeaBox::setup(tracker, cam, modelFile);
+    tracker.setUseTrackingStatistics(true);
+    tracker.setTrackingStatisticsWindowSize(10);
+
+    vpHomogeneousMatrix cMo = vpMbtTeaBox::getPose(vpTranslationVector(-0.03, 0, 0.6),
+                                                   vpThetaUVector(vpMath::rad(-30), vpMath::rad(20), vpMath::rad(10)));
+    vpHomogeneousMatrix cdMc(vpTranslationVector(0.002, 0.001, 0.002), vpThetaUVector(0, vpMath::rad(0.5), vpMath::rad(0.3)));
+
+    vpMbtTeaBox::render(cMo, cam, I, pointCloud);
+    tracker.initFromPose(I, cMo);
+
+    std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+    std::map<std::string, const std::vector<vpColVector> *> mapOfPointClouds;
+    std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+    mapOfImages["Camera"] = &I;
+    mapOfPointClouds["Camera"] = &pointCloud;
+    mapOfWidths["Camera"] = I.getWidth();
+    mapOfHeights["Camera"] = I.getHeight();
+
+    const unsigned int nbFrames = 15;
+    for (unsigned int iter = 0; iter < nbFrames; iter++) {
+      cMo = cdMc * cMo;
+      vpMbtTeaBox::render(cMo, cam, I, pointCloud);
+      tracker.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+    }
+
+    const vpMbtTrackingStatistics &statistics = tracker.getTrackingStatistics();
+    const char *trackerTimings[] = { "prediction", "pre_tracking", "vvs", "post_tracking", "projection_error", "total" };
+    for (unsigned int i = 0; i < sizeof(trackerTimings) / sizeof(trackerTimings[0]); i++) {
+      const vpMbtTrackingStatistics::vpRollingStatistic &timing = statistics.getTiming("", trackerTimings[i]);
+      if (timing.getCount() != nbFrames || timing.getWindowSize() != 10 || timing.getMin() < 0 ||
+          timing.getMax() > statistics.getTiming("", "total").getMax()) {
+        std::cerr << "Bad timing: " << trackerTimings[i] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    const char *cameraTimings[] = { "me_tracking", "depth_dense_sampling", "visibility", "me_update" };
+    for (unsigned int i = 0; i < sizeof(cameraTimings) / sizeof(cameraTimings[0]); i++) {
+      if (statistics.getTiming("Camera", cameraTimings[i]).getCount() != nbFrames) {
+        std::cerr << "Bad camera timing: " << cameraTimings[i] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (statistics.hasTiming("Camera", "depth_normal_sampling") || statistics.hasCounter("Camera", "klt_features")) {
+      std::cerr << "Statistics of an unused feature type" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The features of the camera are all the residuals of the virtual visual servoing
+    double nbFeatures = statistics.getCounter("Camera", "edge_features").getLast() +
+                        statistics.getCounter("Camera", "depth_dense_features").getLast();
+    if (statistics.getCounter("", "features").getLast() != nbFeatures || nbFeatures == 0 ||
+        statistics.getCounter("", "vvs_iterations").getMin() < 1 ||
+        statistics.getCounter("Camera", "visible_faces").getMin() < 1 ||
+        statistics.getCounter("Camera", "me_range").getLast() != 8) {
+      std::cerr << "Bad counters" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::stringstream json;
+    statistics.writeJson(json);
+    std::string str = json.str();
+    int depth = 0;
+    for (size_t i = 0; i < str.size(); i++) {
+      depth += (str[i] == '{' || str[i] == '[') ? 1 : ((str[i] == '}' || str[i] == ']') ? -1 : 0);
+      if (depth < 0) {
+        break;
+      }
+    }
+    if (depth != 0 || str.find("\"cameras\": {\n    \"Camera\": {") == std::string::npos ||
+        str.find("\"vvs_iterations\": {\"count\": 15") == std::string::npos) {
+      std::cerr << "Bad JSON:\n" << str << std::endl;
+      return EXIT_FAILURE;
+    }
+    statistics.saveJson(vpIoTools::createFilePath(directory, "statistics.json"));
+
+    std::cout << "Mean tracking time: " << statistics.getTiming("", "total").getMean() << " ms, "
+              << statistics.getCounter("", "vvs_iterations").getMean() << " iterations" << std::endl;
+
+    tracker.resetTrackingStatistics();
+    if (!statistics.getScopes().empty()) {
+      std::cerr << "The statistics are not reset" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+    std::cout << "testMbtTrackingStatistics is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
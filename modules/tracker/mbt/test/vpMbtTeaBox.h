@@ -0,0 +1,176 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Synthetic tea box used by the model-based tracker tests and benchmark.
+ *
+ *****************************************************************************/
+
+#ifndef __vpMbtTeaBox_h_
+#define __vpMbtTeaBox_h_
+
+/*!
+  \file vpMbtTeaBox.h
+  \brief Synthetic tea box used by the model-based tracker tests and benchmark.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+/*!
+  \class vpMbtTeaBox
+
+  \brief Tea box of the model-based tracking tutorials: its CAD model, a ray casting
+  renderer of its image and point cloud, and the tracker settings used to track it.
+
+  The box spans [0, getSize(0)] x [0, getSize(1)] x [-getSize(2), 0] in the object frame.
+*/
+class vpMbtTeaBox
+{
+public:
+  //! Size in meter of the box along the x, y and z axes of the object frame.
+  static double getSize(const unsigned int axis)
+  {
+    static const double size[3] = { 0.165, 0.068, 0.08 };
+    return size[axis];
+  }
+
+  //! Pose of the box rotated by \e tu around its center, the center being at \e c_center in the camera frame.
+  static vpHomogeneousMatrix getPose(const vpTranslationVector &c_center, const vpThetaUVector &tu)
+  {
+    vpHomogeneousMatrix cRo(vpTranslationVector(), tu);
+    vpTranslationVector o_center(getSize(0) / 2, getSize(1) / 2, -getSize(2) / 2);
+    return vpHomogeneousMatrix(c_center - cRo.getRotationMatrix() * o_center, tu);
+  }
+
+  //! Write the CAD model of the box in the .cao format.
+  static void writeModel(const std::string &modelFile)
+  {
+    std::ofstream model(modelFile.c_str());
+    if (!model) {
+      throw(vpException(vpException::ioError, "Cannot write the model in %s", modelFile.c_str()));
+    }
+    model << "V1\n# 3D Points\n8\n"
+          << "0 0 0\n0 0 " << -getSize(2) << "\n" << getSize(0) << " 0 " << -getSize(2) << "\n" << getSize(0) << " 0 0\n"
+          << getSize(0) << " " << getSize(1) << " 0\n" << getSize(0) << " " << getSize(1) << " " << -getSize(2) << "\n"
+          << "0 " << getSize(1) << " " << -getSize(2) << "\n0 " << getSize(1) << " 0\n"
+          << "# 3D Lines\n0\n# Faces from 3D lines\n0\n# Faces from 3D points\n6\n"
+          << "4 0 1 2 3\n4 1 6 5 2\n4 4 5 6 7\n4 0 3 4 7\n4 5 4 3 2\n4 0 7 6 1\n"
+          << "# 3D cylinders\n0\n# 3D circles\n0\n";
+  }
+
+  /*!
+    Ray casting of the box. Each face has its own intensity, the background is dark.
+    With \e textured, a smooth texture drawn on the box adds corners to track with KLT.
+    The point cloud is in the camera frame, with a null point for the background.
+  */
+  static void render(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, vpImage<unsigned char> &I,
+                     std::vector<vpColVector> &pointCloud, const bool textured = false)
+  {
+    vpHomogeneousMatrix oMc = cMo.inverse();
+    const double bbMin[3] = { 0, 0, -getSize(2) }, bbMax[3] = { getSize(0), getSize(1), 0 };
+    pointCloud.resize(I.getSize());
+
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double d[3] = { (j - cam.get_u0()) / cam.get_px(), (i - cam.get_v0()) / cam.get_py(), 1 };
+        double tNear = -std::numeric_limits<double>::max(), tFar = std::numeric_limits<double>::max();
+        int face = -1;
+        for (unsigned int k = 0; k < 3; k++) {
+          double o = oMc[k][3], dir = oMc[k][0] * d[0] + oMc[k][1] * d[1] + oMc[k][2] * d[2];
+          double t1 = (bbMin[k] - o) / dir, t2 = (bbMax[k] - o) / dir;
+          int face1 = 2 * (int)k, face2 = 2 * (int)k + 1;
+          if (t1 > t2) {
+            std::swap(t1, t2);
+            std::swap(face1, face2);
+          }
+          if (t1 > tNear) {
+            tNear = t1;
+            face = face1;
+          }
+          tFar = std::min(tFar, t2);
+        }
+
+        vpColVector &P = pointCloud[i * I.getWidth() + j];
+        P.resize(3, false);
+        if (tNear < tFar && tNear > 0) {
+          double intensity = 60 + 30 * face;
+          if (textured) {
+            double X[3];
+            for (unsigned int k = 0; k < 3; k++) {
+              X[k] = oMc[k][3] + tNear * (oMc[k][0] * d[0] + oMc[k][1] * d[1] + oMc[k][2] * d[2]);
+            }
+            intensity += 10 * (sin(400 * X[0]) * cos(450 * X[1]) + sin(450 * X[1]) * cos(500 * X[2]) +
+                               sin(500 * X[2]) * cos(400 * X[0]));
+          }
+          I[i][j] = (unsigned char)vpMath::round(intensity);
+          P[0] = tNear * d[0];
+          P[1] = tNear * d[1];
+          P[2] = tNear * d[2];
+        } else {
+          I[i][j] = 20;
+          P = 0;
+        }
+      }
+    }
+  }
+
+  //! Moving-edges, depth and visibility settings used to track the box, then load its model.
+  static void setup(vpMbGenericTracker &tracker, const vpCameraParameters &cam, const std::string &modelFile,
+                    const unsigned int range = 8)
+  {
+    vpMe me;
+    me.setMaskSize(5);
+    me.setMaskNumber(180);
+    me.setRange(range);
+    me.setThreshold(5000);
+    me.setMu1(0.5);
+    me.setMu2(0.5);
+    me.setSampleStep(4);
+    tracker.setMovingEdge(me);
+    tracker.setDepthDenseSamplingStep(2, 2);
+    tracker.setCameraParameters(cam);
+    tracker.setAngleAppear(vpMath::rad(70));
+    tracker.setAngleDisappear(vpMath::rad(80));
+    tracker.loadModel(modelFile);
+  }
+};
+
+#endif
@@ -56,6 +56,7 @@
 
 #include <math.h>
 #include <list>
+#include <vector>
 
 /*!
   \class vpMeEllipse
@@ -273,7 +274,7 @@ protected:
   //! Value of sin(e).
   double se;
   //! Stores the value of the \f$ alpha \f$ angle for each vpMeSite.
-  std::list<double> angle;
+  std::vector<double> angle;
   //! Surface
   double m00;
   //! Second order central moments
@@ -256,6 +256,14 @@ public:
                       const std::list<vpMeSite> &site_list,
                       const double &A, const double &B, const double &C,
                       const vpColor &color = vpColor::green,  unsigned int thickness=1);
+  static void display(const vpImage<unsigned char>& I,const vpMeSite &PExt1, const vpMeSite &PExt2,
+                      const std::vector<vpMeSite> &site_list,
+                      const double &A, const double &B, const double &C,
+                      const vpColor &color = vpColor::green,  unsigned int thickness=1);
+  static void display(const vpImage<vpRGBa>& I,const vpMeSite &PExt1, const vpMeSite &PExt2,
+                      const std::vector<vpMeSite> &site_list,
+                      const double &A, const double &B, const double &C,
+                      const vpColor &color = vpColor::green,  unsigned int thickness=1);
 };
 
 #endif
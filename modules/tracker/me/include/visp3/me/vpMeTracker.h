@@ -53,6 +53,7 @@
 #include <math.h>
 #include <iostream>
 #include <list>
+#include <vector>
 
 /*!
   \class vpMeTracker
@@ -70,16 +71,22 @@ public:
 protected:
 #endif
   //! Tracking dependent variables/functions
-  //! List of tracked moving edges points.
-  std::list<vpMeSite> list ;
   //! Moving edges initialisation parameters
   vpMe *me ;
   unsigned int init_range;
   int nGoodElement;
 
 protected:
+  //! Tracked moving edges points, stored contiguously in the order of the
+  //! feature. Suppressed sites are only marked by their state until
+  //! removeSuppressedSites() compacts the storage. Unlike the former
+  //! std::list member, it is not public even with deprecated functions: use
+  //! getMeSites(), or the deprecated getMeList() that returns a copy.
+  std::vector<vpMeSite> list ;
   vpMeSite::vpMeSiteDisplayType selectDisplay ;
 
+  void removeSuppressedSites();
+
 public:
   // Constructor/Destructor
   vpMeTracker() ;
@@ -99,10 +106,26 @@ public:
   virtual void  display(const vpImage<unsigned char>& I);
   void          display(const vpImage<unsigned char>& I, vpColVector &w, unsigned int &index_w);
 
+  /*!
+    Set the display of the moving edges sites, for the sites already tracked
+    and for the next sampled ones.
+
+    \param select : Display type of the sites.
+  */
   void setDisplay(vpMeSite::vpMeSiteDisplayType select)  {
     selectDisplay = select ;
+    for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+      it->setDisplay(select);
+    }
   }
 
+  /*!
+    Return the display type of the moving edges sites.
+
+    \sa setDisplay()
+  */
+  inline vpMeSite::vpMeSiteDisplayType getDisplay() const { return selectDisplay; }
+
   vpMeTracker& operator =(vpMeTracker& f);
 
   int outOfImage(int i, int j, int half, int row , int cols);
@@ -146,16 +169,42 @@ public:
     Set the list of moving edges
 
     \param l : list of Moving Edges.
+
+    \sa setMeSites()
   */
-  void setMeList(const std::list<vpMeSite> &l) { list = l; }
+  void setMeList(const std::list<vpMeSite> &l) { list.assign(l.begin(), l.end()); }
+
+  /*!
+    Set the moving edges.
 
+    \param sites : Moving Edges.
+  */
+  void setMeSites(const std::vector<vpMeSite> &sites) { list = sites; }
+
+  /*!
+    Return the moving edges, in the order of the tracked feature. The sites
+    can be modified through the returned reference.
+
+    \return Moving Edges.
+  */
+  inline std::vector<vpMeSite>& getMeSites() { return list; }
+  inline const std::vector<vpMeSite>& getMeSites() const { return list; }
+
+#ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
+  /*!
+    @name Deprecated functions
+  */
+  //@{
   /*!
-    Return the list of moving edges
+    \deprecated Use getMeSites() instead. The moving edges are no more stored
+    in a std::list: this function returns a copy of them, so that the changes
+    made on the returned list are not applied to the tracker.
 
-    \return List of Moving Edges.
+    \return Copy of the list of Moving Edges.
   */
-  inline std::list<vpMeSite>& getMeList() { return list; }
-  inline std::list<vpMeSite> getMeList() const { return list; }
+  vp_deprecated inline std::list<vpMeSite> getMeList() const { return std::list<vpMeSite>(list.begin(), list.end()); }
+  //@}
+#endif //VISP_BUILD_DEPRECATED_FUNCTIONS
 
   /*!
     Return the number of points that has not been suppressed.
@@ -368,7 +368,7 @@ vpMeEllipse::updateTheta()
 {
   vpMeSite p_me;
   double theta;
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     p_me = *it;
     vpImagePoint iP;
     iP.set_i(p_me.ifloat);
@@ -385,21 +385,20 @@ vpMeEllipse::updateTheta()
 void
 vpMeEllipse::suppressPoints()
 {
-  // Loop through list of sites to track
-  std::list<vpMeSite>::iterator itList = list.begin();
-  for(std::list<double>::iterator it=angle.begin(); it!=angle.end(); ){
-    vpMeSite s = *itList;//current reference pixel
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
+  // Compact the sites and their alpha angle in a single pass
+  size_t nbKept = 0;
+  for(size_t k = 0; k < list.size(); k++){
+    if (list[k].getState() == vpMeSite::NO_SUPPRESSION)
     {
-      itList = list.erase(itList);
-      it = angle.erase(it);
-    }
-    else
-    {
-      ++itList;
-      ++it;
+      if (nbKept != k) {
+        list[nbKept] = list[k];
+        angle[nbKept] = angle[k];
+      }
+      nbKept++;
     }
   }
+  list.resize(nbKept);
+  angle.resize(nbKept);
 }
 
 
@@ -537,9 +536,9 @@ vpMeEllipse::setExtremities()
   double jmax = 0;
 
   // Loop through list of sites to track
-  std::list<double>::const_iterator itAngle = angle.begin();
+  std::vector<double>::const_iterator itAngle = angle.begin();
 
-  for(std::list<vpMeSite>::const_iterator itList=list.begin(); itList!=list.end(); ++itList){
+  for(std::vector<vpMeSite>::const_iterator itList=list.begin(); itList!=list.end(); ++itList){
     vpMeSite s = *itList;//current reference pixel
     double alpha = *itAngle;
     if (alpha < alphamin)
@@ -603,7 +602,7 @@ vpMeEllipse::leastSquare()
   vpColVector x(5);
 
   unsigned int k =0;
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
     p_me = *it;
     if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
     {
@@ -640,7 +639,7 @@ vpMeEllipse::leastSquare()
   }
 
   k =0;
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     p_me = *it;
     if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
     {
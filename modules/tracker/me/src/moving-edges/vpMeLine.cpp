@@ -323,7 +323,7 @@ vpMeLine::leastSquare()
   {
     nos_1 = numberOfSignal() ;
     unsigned int k =0 ;
-    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
       {
@@ -356,7 +356,7 @@ vpMeLine::leastSquare()
     }
 
     k =0 ;
-    for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
       {
@@ -388,7 +388,7 @@ vpMeLine::leastSquare()
   {
     nos_1 = numberOfSignal() ;
     unsigned int k =0 ;
-    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
       {
@@ -421,7 +421,7 @@ vpMeLine::leastSquare()
     }
 
     k =0 ;
-    for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
       {
@@ -522,15 +522,7 @@ vpMeLine::initTracking(const vpImage<unsigned char> &I,
 void
 vpMeLine::suppressPoints()
 {
-  // Loop through list of sites to track
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ){
-    vpMeSite s = *it;//current reference pixel
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      it = list.erase(it);
-    else
-      ++it;
-  }
+  removeSuppressedSites();
 }
 
 
@@ -547,7 +539,7 @@ vpMeLine::setExtremities()
 
 
   // Loop through list of sites to track
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
     vpMeSite s = *it;//current reference pixel
     if (s.ifloat < imin)
     {
@@ -569,7 +561,7 @@ vpMeLine::setExtremities()
 
   if (fabs(imin-imax) < 25)
   {
-    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
       vpMeSite s = *it;//current reference pixel
       if (s.jfloat < jmin)
       {
@@ -793,7 +785,7 @@ vpMeLine::updateDelta()
 
   angle_1 = angle_;
 
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     p_me = *it;
     p_me.alpha = delta ;
     p_me.mask_sign = sign;
@@ -1301,13 +1293,13 @@ void vpMeLine::display(const vpImage<vpRGBa>& I,const vpMeSite &PExt1, const vpM
   \param thickness : Thickness of the line.
 */
 void vpMeLine::display(const vpImage<unsigned char>& I,const vpMeSite &PExt1, const vpMeSite &PExt2,
-                       const std::list<vpMeSite> &site_list,
+                       const std::vector<vpMeSite> &site_list,
                        const double &A, const double &B, const double &C,
                        const vpColor &color,  unsigned int thickness)
 {
   vpImagePoint ip;
   
-  for(std::list<vpMeSite>::const_iterator it=site_list.begin(); it!=site_list.end(); ++it){
+  for(std::vector<vpMeSite>::const_iterator it=site_list.begin(); it!=site_list.end(); ++it){
     vpMeSite pix = *it;
     ip.set_i( pix.ifloat );
     ip.set_j( pix.jfloat );
@@ -1383,13 +1375,13 @@ void vpMeLine::display(const vpImage<unsigned char>& I,const vpMeSite &PExt1, co
   \param thickness : Thickness of the line.
 */
 void vpMeLine::display(const vpImage<vpRGBa>& I,const vpMeSite &PExt1, const vpMeSite &PExt2,
-                       const std::list<vpMeSite> &site_list,
+                       const std::vector<vpMeSite> &site_list,
                        const double &A, const double &B, const double &C,
                        const vpColor &color,  unsigned int thickness)
 {
   vpImagePoint ip;
 
-  for(std::list<vpMeSite>::const_iterator it=site_list.begin(); it!=site_list.end(); ++it){
+  for(std::vector<vpMeSite>::const_iterator it=site_list.begin(); it!=site_list.end(); ++it){
     vpMeSite pix = *it;
     ip.set_i( pix.ifloat );
     ip.set_j( pix.jfloat );
@@ -1443,3 +1435,60 @@ void vpMeLine::display(const vpImage<vpRGBa>& I,const vpMeSite &PExt1, const vpM
   vpDisplay::displayCross(I, ip1, 10, vpColor::green,thickness);
 }
 
+/*!
+  Display of a moving line thanks to its equation parameters and its extremities with all the site list.
+
+  \param I : The image used as background.
+
+  \param PExt1 : First extrimity
+
+  \param PExt2 : Second extrimity
+
+  \param site_list : vpMeSite list
+
+  \param A : Parameter a of the line equation a*i + b*j + c = 0
+
+  \param B : Parameter b of the line equation a*i + b*j + c = 0
+
+  \param C : Parameter c of the line equation a*i + b*j + c = 0
+
+  \param color : Color used to display the line.
+
+  \param thickness : Thickness of the line.
+*/
+void vpMeLine::display(const vpImage<unsigned char>& I,const vpMeSite &PExt1, const vpMeSite &PExt2,
+                       const std::list<vpMeSite> &site_list,
+                       const double &A, const double &B, const double &C,
+                       const vpColor &color,  unsigned int thickness)
+{
+  vpMeLine::display(I, PExt1, PExt2, std::vector<vpMeSite>(site_list.begin(), site_list.end()), A, B, C, color, thickness);
+}
+
+/*!
+  Display of a moving line thanks to its equation parameters and its extremities with all the site list.
+
+  \param I : The image used as background.
+
+  \param PExt1 : First extrimity
+
+  \param PExt2 : Second extrimity
+
+  \param site_list : vpMeSite list
+
+  \param A : Parameter a of the line equation a*i + b*j + c = 0
+
+  \param B : Parameter b of the line equation a*i + b*j + c = 0
+
+  \param C : Parameter c of the line equation a*i + b*j + c = 0
+
+  \param color : Color used to display the line.
+
+  \param thickness : Thickness of the line.
+*/
+void vpMeLine::display(const vpImage<vpRGBa>& I,const vpMeSite &PExt1, const vpMeSite &PExt2,
+                       const std::list<vpMeSite> &site_list,
+                       const double &A, const double &B, const double &C,
+                       const vpColor &color,  unsigned int thickness)
+{
+  vpMeLine::display(I, PExt1, PExt2, std::vector<vpMeSite>(site_list.begin(), site_list.end()), A, B, C, color, thickness);
+}
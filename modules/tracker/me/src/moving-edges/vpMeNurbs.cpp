@@ -355,16 +355,7 @@ vpMeNurbs::sample(const vpImage<unsigned char>& I)
 void
 vpMeNurbs::suppressPoints()
 {
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ){
-    vpMeSite s = *it;//current reference pixel
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-    {
-      it = list.erase(it);
-    }
-    else
-      ++it;
-  }
+  removeSuppressedSites();
 }
 
 
@@ -378,7 +369,7 @@ vpMeNurbs::updateDelta()
   double u = 0.0;
   double d = 1e6;
   double d_1 = 1e6;
-  std::list<vpMeSite>::iterator it=list.begin();
+  std::vector<vpMeSite>::iterator it=list.begin();
 
   vpImagePoint Cu;
   vpImagePoint* der = NULL;
@@ -467,7 +458,7 @@ vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
 
         if (P.getState() == vpMeSite::NO_SUPPRESSION)
         {
-          list.push_front(P) ;
+          list.insert(list.begin(), P) ;
           beginPtAdded = true;
           pt_max = pt;
           if (vpDEBUG_ENABLE(3)) {
@@ -523,7 +514,7 @@ vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
   }
   else
   {
-    list.pop_front();
+    list.erase(list.begin());
   }
   /*if(begin != NULL)*/ delete[] begin;
   /*if(end != NULL)  */ delete[] end;
@@ -631,7 +622,7 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 
     if (findCenterPoint(&ip_edges_list))
     {
-      for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); /*++it*/){
+      for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); /*++it*/){
         vpMeSite s = *it;
         vpImagePoint iP(s.ifloat,s.jfloat);
         if (inRectangle(iP,rect))
@@ -640,13 +631,14 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
           break;
       }
 
-      std::list<vpMeSite>::iterator itList=list.begin();
+      // Index of the first site before the added ones
+      size_t firstSite = 0;
       double convlt;
       double delta = 0;
       int nbr = 0;
       std::list<vpMeSite> addedPt;
       for(std::list<vpImagePoint>::const_iterator itEdges=ip_edges_list.begin(); itEdges!=ip_edges_list.end(); ++itEdges){
-        vpMeSite s = *itList;
+        vpMeSite s = list[firstSite];
         vpImagePoint iPtemp = *itEdges + topLeft;
         vpMeSite pix;
         pix.init(iPtemp.get_i(), iPtemp.get_j(), delta);
@@ -664,9 +656,8 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
             findAngle(I, iPtemp, me, delta, convlt);
             pix.init(iPtemp.get_i(), iPtemp.get_j(), delta, convlt);
             pix.setDisplay(selectDisplay);
-            --itList;
-            list.insert(itList, pix);
-            ++itList;
+            list.insert(list.begin(), pix);
+            firstSite++;
             addedPt.push_front(pix);
             nbr++;
           }
@@ -675,13 +666,11 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 
       unsigned int  memory_range = me->getRange();
       me->setRange(3);
-      std::list<vpMeSite>::iterator itList2=list.begin();
       for (int j = 0; j < nbr; j++)
       {
-        vpMeSite s = *itList2;
+        vpMeSite s = list[(size_t)j];
         s.track(I,me,false);
-        *itList2 = s;
-        ++itList2;
+        list[(size_t)j] = s;
       }
       me->setRange(memory_range);
     }
@@ -778,21 +767,21 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
         vpImagePoint iP(s.ifloat,s.jfloat);
         if (inRectangle(iP,rect))
         {
-          list.erase(list.end()) ;
+          list.pop_back() ;
 //          list.end();
         }
         else
           break;
       }
 
-      std::list<vpMeSite>::iterator itList = list.end();
-      --itList; // Move on the last element
+      // Index of the last site before the added ones
+      size_t lastSite = list.size() - 1;
       double convlt;
       double delta;
       int nbr = 0;
       std::list<vpMeSite> addedPt;
       for(std::list<vpImagePoint>::const_iterator itEdges=ip_edges_list.begin(); itEdges!=ip_edges_list.end(); ++itEdges){
-        s = *itList;
+        s = list[lastSite];
         vpImagePoint iPtemp = *itEdges + topLeft;
         vpMeSite pix;
         pix.init(iPtemp.get_i(), iPtemp.get_j(), 0);
@@ -819,14 +808,11 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 
       unsigned int  memory_range = me->getRange();
       me->setRange(3);
-      std::list<vpMeSite>::iterator itList2 = list.end();
-      --itList2; // Move to the last element
       for (int j = 0; j < nbr; j++)
       {
-        vpMeSite me_s = *itList2;
+        vpMeSite me_s = list[list.size() - 1 - (size_t)j];
         me_s.track(I,me,false);
-        *itList2 = me_s;
-        --itList2;
+        list[list.size() - 1 - (size_t)j] = me_s;
       }
       me->setRange(memory_range);
     }
@@ -880,17 +866,16 @@ vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
   int n = (int)numberOfSignal();
 
 //  list.front();
-  std::list<vpMeSite>::iterator it=list.begin();
-  std::list<vpMeSite>::iterator itNext=list.begin();
-  ++itNext;
+  // Indexes rather than iterators since the insertions invalidate them
+  size_t k = 0;
 
   unsigned int range_tmp = me->getRange();
   me->setRange(2);
 
-  while(itNext!=list.end() && n <= me->getPointsToTrack())
+  while(k+1 < list.size() && n <= me->getPointsToTrack())
   {
-    vpMeSite s = *it;//current reference pixel
-    vpMeSite s_next = *itNext;//current reference pixel
+    vpMeSite s = list[k];//current reference pixel
+    vpMeSite s_next = list[k+1];//current reference pixel
 
     double d = vpMeSite::sqrDistance(s,s_next);
     if(d > 4 * vpMath::sqr(me->getSampleStep()) && d < 1600)
@@ -947,7 +932,8 @@ vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
             pix.track(I,me,false);
             if (pix.getState() == vpMeSite::NO_SUPPRESSION)
             {
-              list.insert(it, pix);
+              list.insert(list.begin() + (std::ptrdiff_t)k, pix);
+              ++k;
               iP_1 = iP[0];
             }
           }
@@ -958,8 +944,7 @@ vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
         }
       }
     }
-    ++it;
-    ++itNext;
+    ++k;
   }
   me->setRange(range_tmp);
 }
@@ -993,8 +978,8 @@ vpMeNurbs::supressNearPoints()
       list.next() ;
   }
 #endif
-  std::list<vpMeSite>::const_iterator it=list.begin();
-  std::list<vpMeSite>::iterator itNext=list.begin();
+  std::vector<vpMeSite>::const_iterator it=list.begin();
+  std::vector<vpMeSite>::iterator itNext=list.begin();
   ++itNext;
   for(;itNext!=list.end();){
     vpMeSite s = *it;//current reference pixel
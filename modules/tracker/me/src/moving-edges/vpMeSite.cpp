@@ -64,6 +64,47 @@ bool horsImage(int i , int j, int half, int rows, int cols)
   //return((i < half + 1) || ( i > (rows - half - 3) )||(j < half + 1) || (j > (cols - half - 3) )) ;
   return( (0 < (half_1 - i) ) || ( (i - rows + half_3) > 0 ) || ( 0 < (half_1 -j) ) || ( (j - cols + half_3)  > 0 ) ) ;
 }
+
+// Index of the convolution mask corresponding to the normal direction alpha
+static
+unsigned int getMaskIndex(double alpha, const vpMe *me)
+{
+  // Calculate tangent angle from normal
+  double theta  = alpha+M_PI/2;
+  // Move tangent angle to within 0->M_PI for a positive
+  // mask index
+  while (theta<0) theta += M_PI;
+  while (theta>M_PI) theta -= M_PI;
+
+  // Convert radians to degrees
+  int thetadeg = vpMath::round(theta * 180 / M_PI) ;
+
+  if(abs(thetadeg) == 180 )
+  {
+    thetadeg= 0 ;
+  }
+
+  return (unsigned int)(thetadeg/(double)me->getAngleStep());
+}
+
+// Convolution of the msize x msize neighbourhood of (i, j) with a row-major mask
+static inline
+double convolutionAt(const vpImage<unsigned char> &I, unsigned int i, unsigned int j, const double *mask,
+                     unsigned int msize, unsigned int half, int mask_sign)
+{
+  double conv = 0.0 ;
+  for(unsigned int a = 0 ; a < msize ; a++ )
+  {
+    const unsigned char *row = I[i-half+a] + j - half;
+    const double *mask_row = mask + a*msize;
+    for(unsigned int b = 0 ; b < msize ; b++ )
+    {
+      conv += mask_sign * mask_row[b] * row[b] ;
+    }
+  }
+
+  return conv;
+}
 #endif
 
 void
@@ -322,41 +363,10 @@ vpMeSite::convolution(const vpImage<unsigned char>&I, const  vpMe *me)
   }
   else
   {
-    // Calculate tangent angle from normal
-    double theta  = alpha+M_PI/2;
-    // Move tangent angle to within 0->M_PI for a positive
-    // mask index
-    while (theta<0) theta += M_PI;
-    while (theta>M_PI) theta -= M_PI;
-
-    // Convert radians to degrees
-    int thetadeg = vpMath::round(theta * 180 / M_PI) ;
-
-    if(abs(thetadeg) == 180 )
-    {
-      thetadeg= 0 ;
-    }
-
-    unsigned int index_mask = (unsigned int)(thetadeg/(double)me->getAngleStep());
-
-    unsigned int i_ = static_cast<unsigned int>(i);
-    unsigned int j_ = static_cast<unsigned int>(j);
-    unsigned int half_ = static_cast<unsigned int>(half);
-
-    unsigned int ihalf = i_-half_ ;
-    unsigned int jhalf = j_-half_ ;
-
-    for(unsigned int a = 0 ; a < msize ; a++ )
-    {
-      unsigned int ihalfa = ihalf+a ;
-      for(unsigned int b = 0 ; b < msize ; b++ )
-      {
-        conv += mask_sign* me->getMask()[index_mask][a][b] *
-            //	  I(i-half+a,j-half+b) ;
-            I(ihalfa,jhalf+b) ;
-      }
-    }
+    unsigned int index_mask = getMaskIndex(alpha, me);
 
+    conv = convolutionAt(I, static_cast<unsigned int>(i), static_cast<unsigned int>(j), me->getMask()[index_mask].data,
+                         msize, static_cast<unsigned int>(half), mask_sign);
   }
 
   return(conv) ;
@@ -498,30 +508,18 @@ vpMeSite::track(const vpImage<unsigned char>& I,
   //       delete []likelihood; // modif portage
   //     }
 
-  vpMeSite  *list_query_pixels ;
   int  max_rank =-1 ;
-  //   int max_rank1=-1 ;
-  //   int max_rank2 = -1;
   double  max_convolution = 0 ;
   double max = 0 ;
   double contraste = 0;
-  //  vpDisplay::display(I) ;
-  //  vpERROR_TRACE("getclcik %d",me->range) ;
-  //  vpDisplay::getClick(I) ;
 
   // range = +/- range of pixels within which the correspondent
   // of the current pixel will be sought
-  unsigned int range  = me->getRange() ;
-
-  //  std::cout << i << "  " << j<<"  " << range << "  " << suppress  << std::endl ;
-  list_query_pixels = getQueryList(I, (int)range) ;
+  const int range  = (int) me->getRange() ;
 
   double  contraste_max = 1 + me->getMu2();
   double  contraste_min = 1 - me->getMu1();
 
-  // array in which likelihood ratios will be stored
-  double  *likelihood= new double[ 2 * range + 1 ] ;
-
   int ii_1 = i ;
   int jj_1 = j ;
   i_1 = i ;
@@ -530,77 +528,115 @@ vpMeSite::track(const vpImage<unsigned char>& I,
   threshold = me->getThreshold() ;
   double diff = 1e6;
 
-  //    std::cout <<"---------------------"<<std::endl ;
-  for(unsigned int n = 0 ; n < 2 * range + 1 ; n++)
+  // The query sites along the normal are processed in place, all of them sharing the mask of the
+  // normal direction, instead of building a list of vpMeSite
+  const double salpha = sin(alpha);
+  const double calpha = cos(alpha);
+  const unsigned int msize = me->getMaskSize();
+  const int half = (static_cast<int>(msize) - 1) >> 1 ;
+  const int half_strip = half + (int) me->getStrip();
+  const int height_ = static_cast<int>(I.getHeight());
+  const int width_  = static_cast<int>(I.getWidth());
+  const double *mask = me->getMask()[getMaskIndex(alpha, me)].data;
+  vpImagePoint ip;
+
+  for(int k = -range ; k <= range ; k++)
   {
+    const double ii = ifloat+k*salpha;
+    const double jj = jfloat+k*calpha;
+
+    // Display
+    if    ((selectDisplay==RANGE_RESULT)||(selectDisplay==RANGE)) {
+      ip.set_i( ii );
+      ip.set_j( jj );
+      vpDisplay::displayCross(I, ip, 1, vpColor::yellow) ;
+    }
+
     //   convolution results
-    double convolution_ = list_query_pixels[n].convolution(I, me) ;
+    const int qi = (int)ii;
+    const int qj = (int)jj;
+    double convolution_ = 0.0;
+    if (!horsImage(qi, qj, half_strip, height_, width_)) {
+      convolution_ = convolutionAt(I, (unsigned int) qi, (unsigned int) qj, mask, msize, (unsigned int) half, mask_sign);
+    }
 
     // luminance ratio of reference pixel to potential correspondent pixel
     // the luminance must be similar, hence the ratio value should
     // lay between, for instance, 0.5 and 1.5 (parameter tolerance)
     if( test_contraste )
     {
-      likelihood[n] = fabs(convolution_ + convlt );
-      if (likelihood[n]> threshold)
+      double likelihood = fabs(convolution_ + convlt );
+      if (likelihood > threshold)
       {
         contraste = convolution_ / convlt;
         if((contraste > contraste_min) && (contraste < contraste_max) && fabs(1-contraste) < diff)
         {
           diff = fabs(1-contraste);
           max_convolution= convolution_;
-          max = likelihood[n] ;
-          max_rank = (int)n ;
-          // 	    max_rank2 = max_rank1;
-          // 	    max_rank1 = max_rank;
+          max = likelihood ;
+          max_rank = k + range ;
         }
       }
     }
 
     else
     {
-      likelihood[n] = fabs(2*convolution_) ;
-      if (likelihood[n] > max  && likelihood[n] > threshold)
+      double likelihood = fabs(2*convolution_) ;
+      if (likelihood > max  && likelihood > threshold)
       {
         max_convolution= convolution_;
-        max = likelihood[n] ;
-        max_rank = (int)n ;
-        //           max_rank2 = max_rank1;
-        //           max_rank1 = max_rank;
+        max = likelihood ;
+        max_rank = k + range ;
       }
     }
   }
-  
+
   // test on the likelihood threshold if threshold==-1 then
   // the me->threshold is  selected
 
-  vpImagePoint ip;
-
-  //  if (test_contrast)
   if(max_rank >= 0)
   {
+    //The vpMeSite is replaced by the query site of max likelihood
+    const int k = max_rank - range;
+    ifloat = ifloat+k*salpha;
+    jfloat = jfloat+k*calpha;
+    i = (int)ifloat;
+    j = (int)jfloat;
+    if (horsImage(i, j, half_strip, height_, width_)) {
+      i = 0 ; j = 0 ;
+    }
+    v = 0;
+    weight = 1;
+    state = NO_SUPPRESSION;
+#ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
+    suppress = 0;
+#endif
+
     if ((selectDisplay==RANGE_RESULT)||(selectDisplay==RESULT))
     {
-      ip.set_i( list_query_pixels[max_rank].i );
-      ip.set_j( list_query_pixels[max_rank].j );
+      ip.set_i( i );
+      ip.set_j( j );
       vpDisplay::displayPoint(I, ip, vpColor::red);
     }
-		
-    *this = list_query_pixels[max_rank] ;//The vpMeSite2 is replaced by the vpMeSite2 of max likelihood
+
     normGradient =  vpMath::sqr(max_convolution);
 
     convlt = max_convolution;
     i_1 = ii_1; //list_query_pixels[max_rank].i ;
     j_1 = jj_1; //list_query_pixels[max_rank].j ;
-    delete []list_query_pixels ;
-    delete []likelihood;
   }
   else //none of the query sites is better than the threshold
   {
     if ((selectDisplay==RANGE_RESULT)||(selectDisplay==RESULT))
     {
-      ip.set_i( list_query_pixels[0].i );
-      ip.set_j( list_query_pixels[0].j );
+      // First query site
+      int qi = (int)(ifloat-range*salpha);
+      int qj = (int)(jfloat-range*calpha);
+      if (horsImage(qi, qj, half_strip, height_, width_)) {
+        qi = 0 ; qj = 0 ;
+      }
+      ip.set_i( qi );
+      ip.set_j( qj );
       vpDisplay::displayPoint(I, ip, vpColor::green);
     }
     normGradient = 0 ;
@@ -609,9 +645,6 @@ vpMeSite::track(const vpImage<unsigned char>& I,
       state = CONSTRAST; // contrast suppression
     else
       state = THRESHOLD; // threshold suppression
-
-    delete []list_query_pixels ;
-    delete []likelihood; // modif portage
   }
 }
 
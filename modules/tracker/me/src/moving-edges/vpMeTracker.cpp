@@ -63,7 +63,7 @@ vpMeTracker::init()
 }
 
 vpMeTracker::vpMeTracker()
-  : list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE)
+  : me(NULL), init_range(1), nGoodElement(0), list(), selectDisplay(vpMeSite::NONE)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
   , query_range (0), display_point(false)
 #endif
@@ -73,7 +73,7 @@ vpMeTracker::vpMeTracker()
 
 vpMeTracker::vpMeTracker(const vpMeTracker& meTracker)
   : vpTracker(meTracker),
-    list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE)
+    me(NULL), init_range(1), nGoodElement(0), list(), selectDisplay(vpMeSite::NONE)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , query_range (0), display_point(false)
 #endif
@@ -125,6 +125,20 @@ static bool isSuppressZero(const vpMeSite& P){
   return (P.getState() == vpMeSite::NO_SUPPRESSION);
 }
 
+static bool isSuppressed(const vpMeSite& P){
+  return (P.getState() != vpMeSite::NO_SUPPRESSION);
+}
+
+/*!
+  Remove the moving edges whose state is not vpMeSite::NO_SUPPRESSION, in a
+  single pass over the sites and keeping the order of the remaining ones.
+*/
+void
+vpMeTracker::removeSuppressedSites()
+{
+  list.erase(std::remove_if(list.begin(), list.end(), isSuppressed), list.end());
+}
+
 unsigned int
 vpMeTracker::numberOfSignal()
 {
@@ -189,7 +203,7 @@ vpMeTracker::initTracking(const vpImage<unsigned char>& I)
   vpImagePoint ip1, ip2;
 
   // Loop through list of sites to track
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     vpMeSite refp = *it;//current reference pixel
 
     d++ ;
@@ -277,7 +291,7 @@ vpMeTracker::track(const vpImage<unsigned char>& I)
   nGoodElement=0;
   //  int d =0;
   // Loop through list of sites to track
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     vpMeSite s = *it;//current reference pixel
 
     //    d++ ;
@@ -342,7 +356,7 @@ vpMeTracker::display(const vpImage<unsigned char>& I)
     std::cout<<" There are "<<list.size()<< " sites in the list " << std::endl ;
   }
 #endif
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
     vpMeSite p_me = *it;
     p_me.display(I);
   }
@@ -357,7 +371,7 @@ vpMeTracker::display(const vpImage<unsigned char>& I)
 void
 vpMeTracker::display(const vpImage<unsigned char>& I,vpColVector &w, unsigned int &index_w)
 {
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
     vpMeSite P = *it;
 
     if(P.getState() == vpMeSite::NO_SUPPRESSION)
@@ -825,14 +825,14 @@ void vpNurbs::globalCurveInterp(const std::list<vpImagePoint> &l_crossingPoints)
 
   \param l_crossingPoints : The list of data points which have to be interpolated.
 */
-void vpNurbs::globalCurveInterp(const std::list<vpMeSite> &l_crossingPoints)
+void vpNurbs::globalCurveInterp(const std::vector<vpMeSite> &l_crossingPoints)
 {
   std::vector<vpImagePoint> v_crossingPoints;
   vpMeSite s = l_crossingPoints.front();
   vpImagePoint pt(s.ifloat,s.jfloat);
   vpImagePoint pt_1 = pt;
   v_crossingPoints.push_back(pt);
-  std::list<vpMeSite>::const_iterator it = l_crossingPoints.begin();
+  std::vector<vpMeSite>::const_iterator it = l_crossingPoints.begin();
   ++it;
   for(; it!=l_crossingPoints.end(); ++it){
     vpImagePoint pt_tmp(it->ifloat, it->jfloat);
@@ -844,6 +844,18 @@ void vpNurbs::globalCurveInterp(const std::list<vpMeSite> &l_crossingPoints)
   globalCurveInterp(v_crossingPoints, p, knots, controlPoints, weights);
 }
 
+/*!
+  Method which enables to compute a NURBS curve passing through a set of data points.
+
+  The result of the method is composed by a knot vector, a set of control points and a set of associated weights.
+
+  \param l_crossingPoints : The list of data points which have to be interpolated.
+*/
+void vpNurbs::globalCurveInterp(const std::list<vpMeSite> &l_crossingPoints)
+{
+  globalCurveInterp(std::vector<vpMeSite>(l_crossingPoints.begin(), l_crossingPoints.end()));
+}
+
 /*!
   Method which enables to compute a NURBS curve passing through a set of data points.
   
@@ -1055,16 +1067,37 @@ void vpNurbs::globalCurveApprox(const std::list<vpImagePoint> &l_crossingPoints,
   \param n : The desired number of control points. This parameter \e n
   must be under or equal to the number of data points.
 */
-void vpNurbs::globalCurveApprox(const std::list<vpMeSite> &l_crossingPoints, unsigned int n)
+void vpNurbs::globalCurveApprox(const std::vector<vpMeSite> &l_crossingPoints, unsigned int n)
 {
   std::vector<vpImagePoint> v_crossingPoints;
-  for(std::list<vpMeSite>::const_iterator it=l_crossingPoints.begin(); it!=l_crossingPoints.end(); ++it){
+  for(std::vector<vpMeSite>::const_iterator it=l_crossingPoints.begin(); it!=l_crossingPoints.end(); ++it){
     vpImagePoint pt(it->ifloat, it->jfloat);
     v_crossingPoints.push_back(pt);
   }
   globalCurveApprox(v_crossingPoints, p, n, knots, controlPoints, weights);
 }
 
+/*!
+
+  Method which enables to compute a NURBS curve approximating a set of
+  data points.
+
+  The data points are approximated thanks to a least square method.
+
+  The result of the method is composed by a knot vector, a set of
+  control points and a set of associated weights.
+
+  \param l_crossingPoints : The list of data points which have to be
+  interpolated.
+
+  \param n : The desired number of control points. This parameter \e n
+  must be under or equal to the number of data points.
+*/
+void vpNurbs::globalCurveApprox(const std::list<vpMeSite> &l_crossingPoints, unsigned int n)
+{
+  globalCurveApprox(std::vector<vpMeSite>(l_crossingPoints.begin(), l_crossingPoints.end()), n);
+}
+
 
 /*!
   Method which enables to compute a NURBS curve approximating a set of data points.
@@ -0,0 +1,198 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the tracking of a line with moving edges.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMeLine.cpp
+
+  \brief Track a moving straight edge in synthetic images with vpMeLine and
+  check the estimated line and the moving edges sites.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/me/vpMeLine.h>
+
+namespace {
+  // Edge j = j0 + slope * i, dark on the left side, bright on the right side.
+  // The rows between occludedBegin and occludedEnd are uniform.
+  void render(double j0, double slope, unsigned int occludedBegin, unsigned int occludedEnd,
+              vpImage<unsigned char> &I)
+  {
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        if (i >= occludedBegin && i < occludedEnd) {
+          I[i][j] = 120;
+        } else {
+          // Anti-aliased step edge
+          double d = j - (j0 + slope * i);
+          double w = std::max(0.0, std::min(1.0, d + 0.5));
+          I[i][j] = (unsigned char)(50 + w * 150);
+        }
+      }
+    }
+  }
+
+  bool checkSites(const vpMeLine &line, double j0, double slope)
+  {
+    const std::vector<vpMeSite> &sites = line.getMeSites();
+    if (sites.size() < 10) {
+      std::cerr << "Bad number of sites: " << sites.size() << std::endl;
+      return false;
+    }
+
+    for (size_t k = 0; k < sites.size(); k++) {
+      if (sites[k].getState() == vpMeSite::NO_SUPPRESSION &&
+          std::fabs(sites[k].jfloat - (j0 + slope * sites[k].ifloat)) > 2.5) {
+        std::cerr << "Site " << k << " is not on the edge" << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The sites are modified in place through getMeSites(), and setMeList() and
+  // getMeList() keep the order of the sites.
+  bool checkSitesAccess(vpMeLine &line)
+  {
+    std::vector<vpMeSite> &sites = line.getMeSites();
+    const unsigned int nbSignals = line.numberOfSignal();
+    size_t k = 0;
+    while (k < sites.size() && sites[k].getState() != vpMeSite::NO_SUPPRESSION) {
+      k++;
+    }
+    if (k == sites.size()) {
+      std::cerr << "No valid site" << std::endl;
+      return false;
+    }
+
+    const vpMeSite saved = sites[k];
+    sites[k].setState(vpMeSite::M_ESTIMATOR);
+    if (line.getMeSites()[k].getState() != vpMeSite::M_ESTIMATOR || line.numberOfSignal() != nbSignals - 1) {
+      std::cerr << "The site was not modified in the tracker" << std::endl;
+      return false;
+    }
+    sites[k] = saved;
+
+    const std::vector<vpMeSite> copy = sites;
+    std::list<vpMeSite> siteList(copy.begin(), copy.end());
+    line.setMeList(siteList);
+    if (line.getMeSites().size() != copy.size() || line.numberOfSignal() != nbSignals) {
+      std::cerr << "Bad sites after setMeList()" << std::endl;
+      return false;
+    }
+    for (size_t n = 0; n < copy.size(); n++) {
+      if (line.getMeSites()[n].i != copy[n].i || line.getMeSites()[n].j != copy[n].j) {
+        std::cerr << "setMeList() changed the order of the sites" << std::endl;
+        return false;
+      }
+    }
+
+#ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
+    // The deprecated getMeList() returns a copy of the sites, in the same order
+    siteList = line.getMeList();
+    if (siteList.size() != copy.size()) {
+      std::cerr << "Bad number of sites with getMeList()" << std::endl;
+      return false;
+    }
+    std::list<vpMeSite>::const_iterator it = siteList.begin();
+    for (size_t n = 0; n < copy.size(); n++, ++it) {
+      if (it->i != copy[n].i || it->j != copy[n].j) {
+        std::cerr << "getMeList() changed the order of the sites" << std::endl;
+        return false;
+      }
+    }
+#endif
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    vpImage<unsigned char> I(240, 320);
+    const double slope = 0.2;
+    double j0 = 140;
+    render(j0, slope, 0, 0, I);
+
+    vpMe me;
+    me.setRange(10);
+    me.setSampleStep(5);
+    me.setThreshold(5000);
+    me.setPointsToTrack(200);
+
+    vpMeLine line;
+    line.setMe(&me);
+    line.setDisplay(vpMeSite::NONE);
+    line.initTracking(I, vpImagePoint(40, j0 + slope * 40), vpImagePoint(200, j0 + slope * 200));
+    if (!checkSites(line, j0, slope) || !checkSitesAccess(line)) {
+      return EXIT_FAILURE;
+    }
+
+    for (unsigned int iter = 0; iter < 10; iter++) {
+      j0 += 2;
+      // Hide a part of the edge during a few frames to suppress some sites
+      if (iter >= 3 && iter < 6) {
+        render(j0, slope, 160, 190, I);
+      } else {
+        render(j0, slope, 0, 0, I);
+      }
+      line.track(I);
+
+      if (!checkSites(line, j0, slope)) {
+        std::cerr << "Failure at iteration " << iter << std::endl;
+        return EXIT_FAILURE;
+      }
+      // Distance of the image center row point of the line to the edge
+      double A, B, C;
+      line.getEquationParam(A, B, C);
+      double jLine = -(A * 120 + C) / B;
+      if (std::fabs(jLine - (j0 + slope * 120)) > 1) {
+        std::cerr << "Bad line at iteration " << iter << ": " << jLine << " instead of " << j0 + slope * 120
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    std::cout << "testMeLine is ok" << std::endl;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
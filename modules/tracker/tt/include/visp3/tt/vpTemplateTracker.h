@@ -46,11 +46,13 @@
 #define vpTemplateTracker_hh
 
 #include <math.h>
+#include <vector>
 
 #include <visp3/tt/vpTemplateTrackerHeader.h>
 #include <visp3/tt/vpTemplateTrackerZone.h>
 #include <visp3/tt/vpTemplateTrackerWarp.h>
 #include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImagePyramid.h>
 
 /*!
   \class vpTemplateTracker
@@ -137,6 +139,17 @@ class VISP_EXPORT vpTemplateTracker
     vpImage<double>             dIy ;
     vpTemplateTrackerZone       zoneRef_; // Reference zone
 
+    //batched evaluation of the template points, see warpTemplate()
+    const vpTemplateTrackerPoint *ptTemplateSoA; // ptTemplate the coordinates below are taken from
+    std::vector<double>         ptTemplateX;
+    std::vector<double>         ptTemplateY;
+    std::vector<double>         ptWarpedX;
+    std::vector<double>         ptWarpedY;
+    std::vector<double>         ptWarpedI;
+    std::vector<double>         ptWarpedDx;
+    std::vector<double>         ptWarpedDy;
+    std::vector<unsigned char>  ptWarpedInside;
+
 //private:
 //#ifndef DOXYGEN_SHOULD_SKIP_THIS
 //    vpTemplateTracker(const vpTemplateTracker &)
@@ -173,7 +186,9 @@ class VISP_EXPORT vpTemplateTracker
         blur(false), useBrent(false), nbIterBrent(0), taillef(0), fgG(NULL), fgdG(NULL),
         ratioPixelIn(0), mod_i(0), mod_j(0), nbParam(), lambdaDep(0), iterationMax(0),
         iterationGlobale(0), diverge(false), nbIteration(0), useCompositionnal(false),
-        useInverse(false), Warp(NULL), p(), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_()
+        useInverse(false), Warp(NULL), p(), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_(),
+        ptTemplateSoA(NULL), ptTemplateX(), ptTemplateY(), ptWarpedX(), ptWarpedY(), ptWarpedI(),
+        ptWarpedDx(), ptWarpedDy(), ptWarpedInside()
     {}
     explicit vpTemplateTracker(vpTemplateTrackerWarp *_warp);
     virtual        ~vpTemplateTracker();
@@ -254,6 +269,7 @@ class VISP_EXPORT vpTemplateTracker
     void    setUseBrent(bool b){useBrent = b;}
 
     void    track(const vpImage<unsigned char> &I);
+    void    track(vpImagePyramid &pyramid);
     void    trackRobust(const vpImage<unsigned char> &I);
 
   protected:
@@ -261,6 +277,7 @@ class VISP_EXPORT vpTemplateTracker
     void            computeOptimalBrentGain(const vpImage<unsigned char> &I,vpColVector &tp,double tMI,vpColVector &direction,double &alpha);
     virtual double  getCost(const vpImage<unsigned char> &I, const vpColVector &tp) = 0;
     void            getGaussianBluredImage(const vpImage<unsigned char> &I){ vpImageFilter::filter(I, BI,fgG,taillef); }
+    int             getNbThreads() const;
     virtual void    initHessienDesired(const vpImage<unsigned char> &I)=0;
     virtual void    initHessienDesiredPyr(const vpImage<unsigned char> &I);
     virtual void    initPyramidal(unsigned int nbLvl,unsigned int l0);
@@ -268,6 +285,8 @@ class VISP_EXPORT vpTemplateTracker
     virtual void    initTrackingPyr(const vpImage<unsigned char>& I,vpTemplateTrackerZone &zone);
     virtual void    trackNoPyr(const vpImage<unsigned char> &I) = 0;
     virtual void    trackPyr(const vpImage<unsigned char> &I);
+    virtual void    trackPyr(vpImagePyramid &pyramid);
+    unsigned int    warpTemplate(const vpImage<unsigned char> &I, const vpColVector &tp, bool withGradient=false);
 };
 #endif
 
@@ -183,6 +183,11 @@ class VISP_EXPORT vpTemplateTrackerWarp
     /*!
       Warp a list of points.
 
+      The default implementation warps the points one by one with warpX(). The
+      warping functions of the module override it with a loop on the coordinates
+      where the coefficients of the warp are computed once, which is the way the
+      template trackers warp all the points of the template at each iteration.
+
       \param ut0 : List of u coordinates of the points.
       \param vt0 : List of v coordinates of the points.
       \param nb_pt : Number of points to consider.
@@ -190,7 +195,7 @@ class VISP_EXPORT vpTemplateTrackerWarp
       \param u : Resulting u coordinates.
       \param v : resulting v coordinates.
     */
-    void warp(const double *ut0,const double *vt0,int nb_pt,const vpColVector& p,double *u,double *v);
+    virtual void warp(const double *ut0,const double *vt0,int nb_pt,const vpColVector& p,double *u,double *v);
 
     /*!
       Warp a point.
@@ -58,30 +58,15 @@ vpTemplateTrackerSSD::vpTemplateTrackerSSD(vpTemplateTrackerWarp *warp)
 double vpTemplateTrackerSSD::getCost(const vpImage<unsigned char> &I, const vpColVector &tp)
 {
   double erreur=0;
-  double IW;
-  int Nbpoint=0;
+  unsigned int Nbpoint=warpTemplate(I,tp);
 
-  Warp->computeCoeff(tp);
   for(unsigned int point=0;point<templateSize;point++)
   {
-    int i=ptTemplate[point].y;
-    int j=ptTemplate[point].x;
-    X1[0]=j;X1[1]=i;
-    Warp->computeDenom(X1,tp);
-    Warp->warpX(X1,X2,tp);
-
-    double j2=X2[0];
-    double i2=X2[1];
-    if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+    if(ptWarpedInside[point])
     {
       double Tij=ptTemplate[point].val;
-      if(!blur)
-        IW=I.getValue(i2,j2);
-      else
-        IW=BI.getValue(i2,j2);
-      //IW=getSubPixBspline4(I,i2,j2);
-      erreur+=((double)Tij-IW)*((double)Tij-IW);
-      Nbpoint++;
+      double IW=ptWarpedI[point];
+      erreur+=(Tij-IW)*(Tij-IW);
     }
   }
   ratioPixelIn=(double)Nbpoint/(double)templateSize;
@@ -37,6 +37,8 @@
  * Fabien Spindler
  *
  *****************************************************************************/
+#include <vector>
+
 #include <visp3/tt/vpTemplateTrackerSSDESM.h>
 #include <visp3/core/vpImageFilter.h>
 
@@ -108,12 +110,11 @@ void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
   vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
   vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
 
-  double IW,dIWx,dIWy;
+  double dIWx,dIWy;
   double Tij;
   unsigned int iteration=0;
-  int i,j;
-  double i2,j2;
   double alpha=2.;
+  std::vector<double> tempt(nbParam);
   do
   {
     unsigned int Nbpoint=0;
@@ -122,44 +123,35 @@ void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
     HDir=0;
     GDir=0;
     GInv=0;
+    // The warp and the interpolation of the image and of its gradient are batched, the
+    // compositional derivative of the warp is computed point by point
+    warpTemplate(I,p,true);
     Warp->computeCoeff(p);
     for(unsigned int point=0;point<templateSize;point++)
     {
-      i=ptTemplate[point].y;
-      j=ptTemplate[point].x;
-      X1[0]=j;X1[1]=i;
-
-      Warp->computeDenom(X1,p);
-      Warp->warpX(X1,X2,p);
-
-      j2=X2[0];i2=X2[1];
-      if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+      if(ptWarpedInside[point])
       {
+        X1[0]=ptTemplateX[point];X1[1]=ptTemplateY[point];
+        X2[0]=ptWarpedX[point];X2[1]=ptWarpedY[point];
+        Warp->computeDenom(X1,p);
+
         //INVERSE
         Tij=ptTemplate[point].val;
-        if(!blur)
-          IW=I.getValue(i2,j2);
-        else
-          IW=BI.getValue(i2,j2);
         Nbpoint++;
-        double er=(Tij-IW);
+        double er=(Tij-ptWarpedI[point]);
         for(unsigned int it=0;it<nbParam;it++)
           GInv[it]+=er*ptTemplate[point].dW[it];
 
         erreur+=er*er;
 
         //DIRECT
-        //dIWx=dIx.getValue(i2,j2);
-        //dIWy=dIy.getValue(i2,j2);
-
-        dIWx=dIx.getValue(i2,j2)+ptTemplate[point].dx;
-        dIWy=dIy.getValue(i2,j2)+ptTemplate[point].dy;
+        dIWx=ptWarpedDx[point]+ptTemplate[point].dx;
+        dIWy=ptWarpedDy[point]+ptTemplate[point].dy;
 
         //Calcul du Hessien
         //Warp->dWarp(X1,X2,p,dW);
         Warp->dWarpCompo(X1,X2,p,ptTemplateCompo[point].dW,dW);
 
-        double *tempt=new double[nbParam];
         for(unsigned int it=0;it<nbParam;it++)
           tempt[it]=dW[0][it]*dIWx+dW[1][it]*dIWy;
 
@@ -169,10 +161,7 @@ void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
 
         for(unsigned int it=0;it<nbParam;it++)
           GDir[it]+=er*tempt[it];
-        delete[] tempt;
       }
-
-
     }
     if(Nbpoint==0) {
       //std::cout<<"plus de point dans template suivi"<<std::endl;
@@ -37,9 +37,15 @@
  * Fabien Spindler
  *
  *****************************************************************************/
+#include <algorithm>
+
 #include <visp3/tt/vpTemplateTrackerSSDInverseCompositional.h>
 #include <visp3/core/vpImageTools.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 vpTemplateTrackerSSDInverseCompositional::vpTemplateTrackerSSDInverseCompositional(vpTemplateTrackerWarp *warp)
   : vpTemplateTrackerSSD(warp), compoInitialised(false), HInv(), HCompInverse(), useTemplateSelect(false),
     evolRMS(0), x_pos(), y_pos(), threshold_RMS(1e-8)
@@ -113,52 +119,58 @@ void vpTemplateTrackerSSDInverseCompositional::trackNoPyr(const vpImage<unsigned
     vpImageFilter::filter(I, BI,fgG,taillef);
 
   vpColVector dpinv(nbParam);
-  double IW;
-  double Tij;
   unsigned int iteration=0;
-  int i,j;
-  double i2,j2;
   double alpha=2.;
-  //vpTemplateTrackerPointtest *pt;
   initPosEvalRMS(p);
 
-  vpTemplateTrackerPoint *pt;
+  // Per thread sums of er*HiG and of er*er, and number of points
+  const int nbThreads=getNbThreads();
+  std::vector<double> partial((size_t)nbThreads*(nbParam+1));
+  std::vector<unsigned int> partialNbpoint((size_t)nbThreads);
   do
   {
     unsigned int Nbpoint=0;
     double erreur=0;
     dp=0;
-    Warp->computeCoeff(p);
-    for(unsigned int point=0;point<templateSize;point++)
+    warpTemplate(I,p);
+    std::fill(partial.begin(),partial.end(),0.);
+    std::fill(partialNbpoint.begin(),partialNbpoint.end(),0u);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel num_threads(nbThreads)
+#endif
     {
-      if((!useTemplateSelect)||(ptTemplateSelect[point]))
+      unsigned int t=0,nt=1;
+#ifdef VISP_HAVE_OPENMP
+      t=(unsigned int)omp_get_thread_num();
+      nt=(unsigned int)omp_get_num_threads();
+#endif
+      const unsigned int begin=(unsigned int)((size_t)templateSize*t/nt);
+      const unsigned int end=(unsigned int)((size_t)templateSize*(t+1)/nt);
+      double *sum=&partial[(size_t)t*(nbParam+1)];
+      unsigned int nb=0;
+      for(unsigned int point=begin;point<end;point++)
       {
-        //pt=&ptTemplatetest[point];
-        pt=&ptTemplate[point];
-        i=pt->y;
-        j=pt->x;
-        X1[0]=j;X1[1]=i;
-        Warp->computeDenom(X1,p);
-        Warp->warpX(X1,X2,p);
-        j2=X2[0];i2=X2[1];
-
-        if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+        if(ptWarpedInside[point]&&((!useTemplateSelect)||(ptTemplateSelect[point])))
         {
-          Tij=pt->val;
-          if(!blur)
-            IW=I.getValue(i2,j2);
-          else
-            IW=BI.getValue(i2,j2);
-          Nbpoint++;
-          double er=(Tij-IW);
+          const double er=(ptTemplate[point].val-ptWarpedI[point]);
+          const double *HiG=ptTemplate[point].HiG;
           for(unsigned int it=0;it<nbParam;it++)
-            dp[it]+=er*pt->HiG[it];
+            sum[it]+=er*HiG[it];
 
-          erreur+=er*er;
+          sum[nbParam]+=er*er;
+          nb++;
         }
       }
+      partialNbpoint[t]=nb;
+    }
+    for(int t=0;t<nbThreads;t++)
+    {
+      const double *sum=&partial[(size_t)t*(nbParam+1)];
+      for(unsigned int it=0;it<nbParam;it++)
+        dp[it]+=sum[it];
+      erreur+=sum[nbParam];
+      Nbpoint+=partialNbpoint[(size_t)t];
     }
-    //std::cout << "npoint: " << Nbpoint << std::endl;
     if(Nbpoint==0) {
       //std::cout<<"plus de point dans template suivi"<<std::endl;
       deletePosEvalRMS();
@@ -41,6 +41,32 @@
 #include <visp3/tt/vpTemplateTracker.h>
 #include <visp3/tt/vpTemplateTrackerBSpline.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+  // Minimum number of template points to split their evaluation between threads
+  const unsigned int vpTemplateTrackerParallelMinPoints = 2048;
+
+  // Bilinear interpolation as done by vpImage::getValue(double, double), the point being
+  // inside the image: i in [0, height-1[ and j in [0, width-1[
+  template <class Type>
+  inline double getBilinear(const vpImage<Type> &I, const double i, const double j)
+  {
+    const unsigned int iround = (unsigned int)i;
+    const unsigned int jround = (unsigned int)j;
+    const double rratio = i - (double)iround;
+    const double cratio = j - (double)jround;
+    const double rfrac = 1.0 - rratio;
+    const double cfrac = 1.0 - cratio;
+    const Type *r0 = I[iround] + jround;
+    const Type *r1 = I[iround + 1] + jround;
+    return ((double)r0[0] * rfrac + (double)r1[0] * rratio) * cfrac
+        + ((double)r0[1] * rfrac + (double)r1[1] * rratio) * cratio;
+  }
+}
+
 vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
   : nbLvlPyr(1), l0Pyr(0), pyrInitialised(false), ptTemplate(NULL), ptTemplatePyr(NULL),
     ptTemplateInit(false), templateSize(0), templateSizePyr(NULL),
@@ -53,7 +79,8 @@ vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
     taillef(7), fgG(NULL), fgdG(NULL), ratioPixelIn(0), mod_i(1), mod_j(1), nbParam(0),
     lambdaDep(0.001), iterationMax(30), iterationGlobale(0), diverge(false), nbIteration(0),
     useCompositionnal(true), useInverse(false), Warp(_warp), p(0), dp(), X1(), X2(),
-    dW(), BI(), dIx(), dIy(), zoneRef_()
+    dW(), BI(), dIx(), dIy(), zoneRef_(), ptTemplateSoA(NULL), ptTemplateX(), ptTemplateY(),
+    ptWarpedX(), ptWarpedY(), ptWarpedI(), ptWarpedDx(), ptWarpedDy(), ptWarpedInside()
 {
   nbParam = Warp->getNbParam() ;
   p.resize(nbParam);
@@ -105,6 +132,7 @@ void vpTemplateTracker::initTracking(const vpImage<unsigned char>& I, vpTemplate
 
   templateSize=NbPointDsZone;
   ptTemplate = new vpTemplateTrackerPoint[templateSize];ptTemplateInit=true;
+  ptTemplateSoA = NULL;
   ptTemplateSelect = new bool[templateSize];ptTemplateSelectInit=true;
 
   Hdesire.resize(nbParam,nbParam);
@@ -179,6 +207,7 @@ void vpTemplateTracker::resetTracker()
 {
   // reset the tracker parameters
   p = 0;
+  ptTemplateSoA = NULL;
 
   // 	vpTRACE("resetTracking");
   if(pyrInitialised)
@@ -221,6 +250,7 @@ void vpTemplateTracker::resetTracker()
             delete[] ptTemplateSuppPyr[i][point].Bt;
             delete[] ptTemplateSuppPyr[i][point].BtInit;
             delete[] ptTemplateSuppPyr[i][point].dBt;
+            delete[] ptTemplateSuppPyr[i][point].d2Bt;
             delete[] ptTemplateSuppPyr[i][point].d2W;
             delete[] ptTemplateSuppPyr[i][point].d2Wx;
             delete[] ptTemplateSuppPyr[i][point].d2Wy;
@@ -298,6 +328,7 @@ void vpTemplateTracker::resetTracker()
         delete[] ptTemplateSupp[point].Bt;
         delete[] ptTemplateSupp[point].BtInit;
         delete[] ptTemplateSupp[point].dBt;
+        delete[] ptTemplateSupp[point].d2Bt;
         delete[] ptTemplateSupp[point].d2W;
         delete[] ptTemplateSupp[point].d2Wx;
         delete[] ptTemplateSupp[point].d2Wy;
@@ -822,48 +853,49 @@ void vpTemplateTracker::track(const vpImage<unsigned char> &I)
     trackNoPyr(I);
 }
 
+/*!
+   Track the template using a Gaussian pyramid of the image to process.
+
+   The pyramid may be shared with other trackers processing the same frame, its levels
+   being computed only once. It should have at least the number of levels set with
+   setPyramidal().
+
+   \param pyramid: Pyramid of the image to process.
+   \exception vpTrackingException::badValue : The pyramid has not enough levels.
+ */
+void vpTemplateTracker::track(vpImagePyramid &pyramid)
+{
+  if (nbLvlPyr > 1)
+    trackPyr(pyramid);
+  else
+    trackNoPyr(pyramid.getLevel(0));
+}
+
 void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
+{
+  vpImagePyramid pyramid(I, nbLvlPyr);
+  trackPyr(pyramid);
+}
+
+void vpTemplateTracker::trackPyr(vpImagePyramid &pyramid)
 {
   //vpTRACE("trackPyr");
-  vpImage<unsigned char> *pyr_I;
-//  pyr_I=new vpImage<unsigned char>[nbLvlPyr+1]; // Why +1 ?
-  pyr_I=new vpImage<unsigned char>[nbLvlPyr]; // Why +1 ?
-  pyr_I[0]=I;
+  if (pyramid.getNbLevels() < nbLvlPyr) {
+    throw(vpTrackingException(vpTrackingException::badValue,
+                              "The image pyramid has %u levels while %u are required",
+                              pyramid.getNbLevels(), nbLvlPyr));
+  }
 
   try
   {
       vpColVector ptemp(nbParam);
       if(nbLvlPyr>1)
       {
-    //    vpColVector *p_sauv=new vpColVector[nbLvlPyr];
-    //    for(unsigned int i=0;i<nbLvlPyr;i++)p_sauv[i].resize(nbParam);
-
-    //    p_sauv[0]=p;
         for(unsigned int i=1;i<nbLvlPyr;i++)
         {
-          vpImageFilter::getGaussPyramidal(pyr_I[i-1],pyr_I[i]);
-          //test getParamPyramidDown
-          /*vpColVector vX_test(2);vX_test[0]=15.;vX_test[1]=30.;
-          vpColVector vX_test2(2);
-          Warp->computeCoeff(p);
-          Warp->computeDenom(vX_test,p);
-          Warp->warpX(vX_test,vX_test2,p);
-          std::cout<<"p = "<<p.t()<<std::endl;*/
-          //std::cout<<"get p down"<<std::endl;
           Warp->getParamPyramidDown(p,ptemp);
           p=ptemp;
           zoneTracked=&zoneTrackedPyr[i];
-
-    //      p_sauv[i]=p;
-          /*std::cout<<"p_down = "<<p.t()<<std::endl;
-
-          vpColVector vX_testd(2);vX_testd[0]=15./2.;vX_testd[1]=30./2.;
-          vpColVector vX_testd2(2);
-          Warp->computeCoeff(p);
-          Warp->computeDenom(vX_testd,p);
-          Warp->warpX(vX_testd,vX_testd2,p);
-          std::cout<<2.*vX_testd2[0]<<","<<2.*vX_testd2[1]<<" <=> "<<vX_test2[0]<<","<<vX_test2[1]<<std::endl;*/
-
         }
 
         for(int i=(int)nbLvlPyr-1;i>=0;i--)
@@ -878,51 +910,21 @@ void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
             H=HdesirePyr[i];
             HLM=HLMdesirePyr[i];
             HLMdesireInverse=HLMdesireInversePyr[i];
-    //        zoneTracked=&zoneTrackedPyr[i];
-            trackRobust(pyr_I[i]);
+            trackRobust(pyramid.getLevel((unsigned int)i));
           }
-          //std::cout<<"get p up"<<std::endl;
-    //      ptemp=p_sauv[i-1];
           if (i > 0) {
             Warp->getParamPyramidUp(p,ptemp);
             p=ptemp;
             zoneTracked=&zoneTrackedPyr[i-1];
           }
         }
-    #if 0
-        if(l0Pyr==0)
-        {
-          templateSize=templateSizePyr[0];
-          ptTemplate=ptTemplatePyr[0];
-          ptTemplateSelect=ptTemplateSelectPyr[0];
-          ptTemplateSupp=ptTemplateSuppPyr[0];
-          ptTemplateCompo=ptTemplateCompoPyr[0];
-          H=HdesirePyr[0];
-          HLM=HLMdesirePyr[0];
-          HLMdesireInverse=HLMdesireInversePyr[0];
-          zoneTracked=&zoneTrackedPyr[0];
-          trackRobust(pyr_I[0]);
-        }
-
-        if (l0Pyr > 0) {
-    //      for (int l=(int)l0Pyr; l >=0; l--) {
-    //        Warp->getParamPyramidUp(p,ptemp);
-    //        p=ptemp;
-    //      }
-          zoneTracked=&zoneTrackedPyr[0];
-        }
-    #endif
-        //    delete [] p_sauv;
       }
       else
       {
-        //std::cout<<"reviens a tracker de base"<<std::endl;
-        trackRobust(I);
+        trackRobust(pyramid.getLevel(0));
       }
-      delete[] pyr_I;
   }
   catch(vpException &e){
-      delete[] pyr_I;
       throw(vpTrackingException(vpTrackingException::badValue, e.getMessage()));
   }
 }
@@ -946,3 +948,82 @@ void vpTemplateTracker::trackRobust(const vpImage<unsigned char> &I)
   else
     trackNoPyr(I);
 }
+
+/*!
+  Return the number of threads used to evaluate the current template points:
+  one if OpenMP is not available or if the template is too small to be worth splitting.
+ */
+int vpTemplateTracker::getNbThreads() const
+{
+#ifdef VISP_HAVE_OPENMP
+  if (templateSize >= vpTemplateTrackerParallelMinPoints)
+    return omp_get_max_threads();
+#endif
+  return 1;
+}
+
+/*!
+  Warp all the points of the current template (ptTemplate) with the parameters \e tp and
+  interpolate the image at the warped positions.
+
+  The coordinates of the template points are kept in contiguous arrays that are warped
+  at once by vpTemplateTrackerWarp::warp(), then the image (or its blurred version BI
+  if blur is enabled) is interpolated in parallel. For each point, ptWarpedInside tells
+  if the warped point is inside the image; if so ptWarpedI is the interpolated intensity
+  and, when \e withGradient is true, ptWarpedDx and ptWarpedDy the interpolated image
+  gradients dIx and dIy that have to be computed before.
+
+  \return The number of template points warped inside the image.
+ */
+unsigned int vpTemplateTracker::warpTemplate(const vpImage<unsigned char> &I, const vpColVector &tp, bool withGradient)
+{
+  if (ptTemplateSoA != ptTemplate || ptTemplateX.size() != templateSize) {
+    ptTemplateX.resize(templateSize);
+    ptTemplateY.resize(templateSize);
+    for (unsigned int point = 0; point < templateSize; point++) {
+      ptTemplateX[point] = ptTemplate[point].x;
+      ptTemplateY[point] = ptTemplate[point].y;
+    }
+    ptWarpedX.resize(templateSize);
+    ptWarpedY.resize(templateSize);
+    ptWarpedI.resize(templateSize);
+    ptWarpedInside.resize(templateSize);
+    ptTemplateSoA = ptTemplate;
+  }
+  if (withGradient) {
+    ptWarpedDx.resize(templateSize);
+    ptWarpedDy.resize(templateSize);
+  }
+  if (templateSize == 0)
+    return 0;
+
+  Warp->warp(&ptTemplateX[0], &ptTemplateY[0], (int)templateSize, tp, &ptWarpedX[0], &ptWarpedY[0]);
+
+  const double height = (double)I.getHeight() - 1;
+  const double width = (double)I.getWidth() - 1;
+  const int nbPoints = (int)templateSize;
+  int nbInside = 0;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static) reduction(+:nbInside) num_threads(getNbThreads())
+#endif
+  for (int point = 0; point < nbPoints; point++) {
+    const double i2 = ptWarpedY[(size_t)point];
+    const double j2 = ptWarpedX[(size_t)point];
+    if ((i2 >= 0) && (j2 >= 0) && (i2 < height) && (j2 < width)) {
+      ptWarpedInside[(size_t)point] = 1;
+      if (!blur)
+        ptWarpedI[(size_t)point] = vpMath::round(getBilinear(I, i2, j2));
+      else
+        ptWarpedI[(size_t)point] = getBilinear(BI, i2, j2);
+      if (withGradient) {
+        ptWarpedDx[(size_t)point] = getBilinear(dIx, i2, j2);
+        ptWarpedDy[(size_t)point] = getBilinear(dIy, i2, j2);
+      }
+      nbInside++;
+    }
+    else
+      ptWarpedInside[(size_t)point] = 0;
+  }
+
+  return (unsigned int)nbInside;
+}
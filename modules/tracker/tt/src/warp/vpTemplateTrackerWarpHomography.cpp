@@ -110,6 +110,23 @@ void vpTemplateTrackerWarpHomography::warpX(const int &i,const int &j,double &i2
 }
 
 
+void vpTemplateTrackerWarpHomography::warp(const double *ut0,const double *vt0,int nb_pt,const vpColVector& p,double *u,double *v)
+{
+  const double h00=1.+p[0], h01=p[3], h02=p[6];
+  const double h10=p[1], h11=1.+p[4], h12=p[7];
+  const double h20=p[2], h21=p[5];
+  bool inFront=true;
+  for(int i=0;i<nb_pt;i++)
+  {
+    const double d=1./(h20*ut0[i]+h21*vt0[i]+1.);
+    inFront=inFront&&(d>0);
+    u[i]=(h00*ut0[i]+h01*vt0[i]+h02)*d;
+    v[i]=(h10*ut0[i]+h11*vt0[i]+h12)*d;
+  }
+  if(!inFront)
+    throw(vpTrackingException(vpTrackingException::fatalError,"Division by zero in vpTemplateTrackerWarpHomography::warp()"));
+}
+
 void vpTemplateTrackerWarpHomography::warpX(const vpColVector &vX,vpColVector &vXres,const vpColVector &ParamM)
 {
   //if((ParamM[2]*vX[0]+ParamM[5]*vX[1]+1)>0)//si dans le plan image reel
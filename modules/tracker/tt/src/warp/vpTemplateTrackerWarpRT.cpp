@@ -89,6 +89,16 @@ void vpTemplateTrackerWarpRT::warpX(const int &i,const int &j,double &i2,double
 }
 
 
+void vpTemplateTrackerWarpRT::warp(const double *ut0,const double *vt0,int nb_pt,const vpColVector& p,double *u,double *v)
+{
+  const double c=cos(p[0]), s=sin(p[0]);
+  for(int i=0;i<nb_pt;i++)
+  {
+    u[i]=(c*ut0[i]) - (s*vt0[i]) + p[1];
+    v[i]=(s*ut0[i]) + (c*vt0[i]) + p[2];
+  }
+}
+
 void vpTemplateTrackerWarpRT::warpX(const vpColVector &vX,vpColVector &vXres,const vpColVector &ParamM)
 {
   vXres[0]=(cos(ParamM[0])*vX[0]) - (sin(ParamM[0])*vX[1]) + ParamM[1];
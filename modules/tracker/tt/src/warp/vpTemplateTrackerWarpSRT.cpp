@@ -92,6 +92,16 @@ void vpTemplateTrackerWarpSRT::warpX(const int &i,const int &j,double &i2,double
 }
 
 
+void vpTemplateTrackerWarpSRT::warp(const double *ut0,const double *vt0,int nb_pt,const vpColVector& p,double *u,double *v)
+{
+  const double c=(1.0+p[0])*cos(p[1]), s=(1.0+p[0])*sin(p[1]);
+  for(int i=0;i<nb_pt;i++)
+  {
+    u[i]=(c*ut0[i]) - (s*vt0[i]) + p[2];
+    v[i]=(s*ut0[i]) + (c*vt0[i]) + p[3];
+  }
+}
+
 void vpTemplateTrackerWarpSRT::warpX(const vpColVector &vX,vpColVector &vXres,const vpColVector &ParamM)
 {
   vXres[0]=((1.0+ParamM[0])*cos(ParamM[1])*vX[0]) - ((1.0+ParamM[0])*sin(ParamM[1])*vX[1]) + ParamM[2];
@@ -84,6 +84,16 @@ void vpTemplateTrackerWarpTranslation::warpX(const int &i,const int &j,double &i
 }
 
 
+void vpTemplateTrackerWarpTranslation::warp(const double *ut0,const double *vt0,int nb_pt,const vpColVector& p,double *u,double *v)
+{
+  const double tu=p[0], tv=p[1];
+  for(int i=0;i<nb_pt;i++)
+  {
+    u[i]=ut0[i]+tu;
+    v[i]=vt0[i]+tv;
+  }
+}
+
 void vpTemplateTrackerWarpTranslation::warpX(const vpColVector &vX,vpColVector &vXres,const vpColVector &ParamM)
 {
   vXres[0]=vX[0]+ParamM[0];
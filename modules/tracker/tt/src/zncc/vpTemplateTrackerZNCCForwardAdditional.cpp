@@ -37,6 +37,8 @@
  * Fabien Spindler
  *
  *****************************************************************************/
+#include <vector>
+
 #include <visp3/tt/vpTemplateTrackerZNCCForwardAdditional.h>
 #include <visp3/core/vpImageFilter.h>
 
@@ -175,41 +177,28 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
   double IW,dIWx,dIWy;
   double Tij;
   unsigned int iteration=0;
-  int i,j;
-  double i2,j2;
   double alpha=2.;
+  std::vector<double> tempt(nbParam);
   do
   {
     int Nbpoint=0;
     double erreur=0;
     G=0;
     H=0 ;
-    Warp->computeCoeff(p);
     double moyTij=0;
     double moyIW=0;
     double denom=0;
+    // The warp and the interpolation of the image and of its gradient are batched, the
+    // derivative of the warp is computed point by point
+    warpTemplate(I,p,true);
+    Warp->computeCoeff(p);
     for(unsigned int point=0;point<templateSize;point++)
     {
-      i=ptTemplate[point].y;
-      j=ptTemplate[point].x;
-      X1[0]=j;X1[1]=i;
-
-      Warp->computeDenom(X1,p);
-      Warp->warpX(X1,X2,p);
-
-      j2=X2[0];i2=X2[1];
-      if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+      if(ptWarpedInside[point])
       {
-        Tij=ptTemplate[point].val;
-
-        if(!blur)
-          IW=I.getValue(i2,j2);
-        else
-          IW=BI.getValue(i2,j2);
-
         Nbpoint++;
-        moyTij+=Tij;
-        moyIW+=IW;
+        moyTij+=ptTemplate[point].val;
+        moyIW+=ptWarpedI[point];
       }
     }
 
@@ -224,28 +213,19 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
     //vpMatrix d2Wy(nbParam,nbParam);
     for(unsigned int point=0;point<templateSize;point++)
     {
-      i=ptTemplate[point].y;
-      j=ptTemplate[point].x;
-      X1[0]=j;X1[1]=i;
-
-      Warp->computeDenom(X1,p);
-      Warp->warpX(X1,X2,p);
-
-      j2=X2[0];i2=X2[1];
-      if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+      if(ptWarpedInside[point])
       {
-        Tij=ptTemplate[point].val;
+        X1[0]=ptTemplateX[point];X1[1]=ptTemplateY[point];
+        X2[0]=ptWarpedX[point];X2[1]=ptWarpedY[point];
+        Warp->computeDenom(X1,p);
 
-        if(!blur)
-          IW=I.getValue(i2,j2);
-        else
-          IW=BI.getValue(i2,j2);
+        Tij=ptTemplate[point].val;
+        IW=ptWarpedI[point];
 
-        dIWx=dIx.getValue(i2,j2);
-        dIWy=dIy.getValue(i2,j2);
+        dIWx=ptWarpedDx[point];
+        dIWy=ptWarpedDy[point];
         //Calcul du Hessien
         Warp->dWarp(X1,X2,p,dW);
-        double *tempt=new double[nbParam];
         for(unsigned int it=0;it<nbParam;it++)
           tempt[it]=dW[0][it]*dIWx+dW[1][it]*dIWy;
 
@@ -254,30 +234,10 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
         for(unsigned int it=0;it<nbParam;it++)
           G[it]+=prod*tempt[it];
 
-        /*	Warp->d2Warp(X1,X2,p,d2Wx,d2Wy);
-        for(int it=0;it<nbParam;it++)
-          for(int jt=0;jt<nbParam;jt++)
-            H[it][jt]+=prod*(d2Wx[it][jt]*dIWx+d2Wx[it][jt]*dIWy);*/
-        /*double d_Ixx=dIxx.getValue(i2,j2);
-        double d_Iyy=dIyy.getValue(i2,j2);
-        double d_Ixy=dIxy.getValue(i2,j2);
-
-        for(int it=0;it<nbParam;it++)
-          for(int jt=0;jt<nbParam;jt++)
-            H[it][jt] +=prod*(dW[0][it]*(dW[0][jt]*d_Ixx+dW[1][jt]*d_Ixy)
-                +dW[1][it]*(dW[0][jt]*d_Ixy+dW[1][jt]*d_Iyy));*/
-        /*H[0][0]+=prod*d_Ixx;
-        H[1][0]+=prod*d_Ixy;
-        H[0][1]+=prod*d_Ixy;
-        H[1][1]+=prod*d_Iyy;*/
-
         double er=(Tij-IW);
         erreur+=(er*er);
         denom+=(Tij-moyTij)*(Tij-moyTij)*(IW-moyIW)*(IW-moyIW);
-        delete[] tempt;
       }
-
-
     }
     /*std::cout<<"G="<<G<<std::endl;
     std::cout<<"H="<<H<<std::endl;
@@ -37,11 +37,16 @@
  * Fabien Spindler
  *
  *****************************************************************************/
+#include <algorithm>
 #include <limits>   // numeric_limits
 
 #include <visp3/tt/vpTemplateTrackerZNCCInverseCompositional.h>
 #include <visp3/core/vpImageFilter.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 vpTemplateTrackerZNCCInverseCompositional::vpTemplateTrackerZNCCInverseCompositional(vpTemplateTrackerWarp *warp)
   : vpTemplateTrackerZNCC(warp), compoInitialised(false),
     evolRMS(0), x_pos(), y_pos(), threshold_RMS(1e-8), moydIrefdp()
@@ -248,45 +253,29 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
 
   //double erreur=0;
   vpColVector dpinv(nbParam);
-  double Ic;
-  double Iref;
   unsigned int iteration=0;
-  int i,j;
-  double i2,j2;
   initPosEvalRMS(p);
+
+  // Per thread sums of sIcdIref, sIrefdIref, covarIref, covarIc and sIcIref
+  const int nbThreads=getNbThreads();
+  const unsigned int nbSums=2*nbParam+3;
+  std::vector<double> partial((size_t)nbThreads*nbSums);
   do
   {
     unsigned int Nbpoint=0;
     //erreur=0;
     G=0;
-    Warp->computeCoeff(p);
     double moyIref=0;
     double moyIc=0;
+    warpTemplate(I,p);
     for(unsigned int point=0;point<templateSize;point++)
     {
-      i=ptTemplate[point].y;
-      j=ptTemplate[point].x;
-      X1[0]=j;X1[1]=i;
-
-      Warp->computeDenom(X1,p);
-      Warp->warpX(X1,X2,p);
-
-      j2=X2[0];i2=X2[1];
-      if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+      if(ptWarpedInside[point])
       {
-        Iref=ptTemplate[point].val;
-
-        if(!blur)
-          Ic=I.getValue(i2,j2);
-        else
-          Ic=BI.getValue(i2,j2);
-
         Nbpoint++;
-        moyIref+=Iref;
-        moyIc+=Ic;
+        moyIref+=ptTemplate[point].val;
+        moyIc+=ptWarpedI[point];
       }
-
-
     }
     if(Nbpoint > 0)
     {
@@ -297,42 +286,54 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
       vpColVector sIcdIref(nbParam);sIcdIref=0;
       vpColVector sIrefdIref(nbParam);sIrefdIref=0;
 
-
-      for(unsigned int point=0;point<templateSize;point++)
+      std::fill(partial.begin(),partial.end(),0.);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel num_threads(nbThreads)
+#endif
       {
-        i=ptTemplate[point].y;
-        j=ptTemplate[point].x;
-        X1[0]=j;X1[1]=i;
-
-        Warp->computeDenom(X1,p);
-        Warp->warpX(X1,X2,p);
-
-        j2=X2[0];i2=X2[1];
-        if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+        unsigned int t=0,nt=1;
+#ifdef VISP_HAVE_OPENMP
+        t=(unsigned int)omp_get_thread_num();
+        nt=(unsigned int)omp_get_num_threads();
+#endif
+        const unsigned int begin=(unsigned int)((size_t)templateSize*t/nt);
+        const unsigned int end=(unsigned int)((size_t)templateSize*(t+1)/nt);
+        double *sum=&partial[(size_t)t*nbSums];
+        const double *moydW=moydIrefdp.data;
+        for(unsigned int point=begin;point<end;point++)
         {
-          Iref=ptTemplate[point].val;
-
-          if(!blur)
-            Ic=I.getValue(i2,j2);
-          else
-            Ic=BI.getValue(i2,j2);
-
-
-          double prod=(Ic-moyIc);
-          for(unsigned int it=0;it<nbParam;it++)
-            sIcdIref[it]+=prod*(ptTemplate[point].dW[it]-moydIrefdp[it]);
-          for(unsigned int it=0;it<nbParam;it++)
-            sIrefdIref[it]+=(Iref-moyIref)*(ptTemplate[point].dW[it]-moydIrefdp[it]);
-
-          //double er=(Iref-Ic);
-          //erreur+=(er*er);
-          //denom+=(Iref-moyIref)*(Iref-moyIref)*(Ic-moyIc)*(Ic-moyIc);
-          covarIref+=(Iref-moyIref)*(Iref-moyIref);
-          covarIc+=(Ic-moyIc)*(Ic-moyIc);
-          sIcIref+=(Iref-moyIref)*(Ic-moyIc);
+          if(ptWarpedInside[point])
+          {
+            const double Iref=ptTemplate[point].val;
+            const double Ic=ptWarpedI[point];
+            const double *dWref=ptTemplate[point].dW;
+
+            double prod=(Ic-moyIc);
+            for(unsigned int it=0;it<nbParam;it++)
+              sum[it]+=prod*(dWref[it]-moydW[it]);
+            for(unsigned int it=0;it<nbParam;it++)
+              sum[nbParam+it]+=(Iref-moyIref)*(dWref[it]-moydW[it]);
+
+            //double er=(Iref-Ic);
+            //erreur+=(er*er);
+            //denom+=(Iref-moyIref)*(Iref-moyIref)*(Ic-moyIc)*(Ic-moyIc);
+            sum[2*nbParam]+=(Iref-moyIref)*(Iref-moyIref);
+            sum[2*nbParam+1]+=(Ic-moyIc)*(Ic-moyIc);
+            sum[2*nbParam+2]+=(Iref-moyIref)*(Ic-moyIc);
+          }
         }
-
-
+      }
+      for(int t=0;t<nbThreads;t++)
+      {
+        const double *sum=&partial[(size_t)t*nbSums];
+        for(unsigned int it=0;it<nbParam;it++)
+        {
+          sIcdIref[it]+=sum[it];
+          sIrefdIref[it]+=sum[nbParam+it];
+        }
+        covarIref+=sum[2*nbParam];
+        covarIc+=sum[2*nbParam+1];
+        sIcIref+=sum[2*nbParam+2];
       }
       covarIref=sqrt(covarIref);
       covarIc=sqrt(covarIc);
@@ -0,0 +1,170 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the template trackers on synthetic images.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testTemplateTracker.cpp
+
+  \brief Test that the batched warp of the warping functions gives the same
+  points than warpX(), and that the SSD and ZNCC template trackers recover a
+  known motion between two synthetic images.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <visp3/tt/vpTemplateTrackerSSDESM.h>
+#include <visp3/tt/vpTemplateTrackerSSDInverseCompositional.h>
+#include <visp3/tt/vpTemplateTrackerWarpAffine.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomographySL3.h>
+#include <visp3/tt/vpTemplateTrackerWarpRT.h>
+#include <visp3/tt/vpTemplateTrackerWarpSRT.h>
+#include <visp3/tt/vpTemplateTrackerWarpTranslation.h>
+#include <visp3/tt/vpTemplateTrackerZNCCForwardAdditional.h>
+#include <visp3/tt/vpTemplateTrackerZNCCInverseCompositional.h>
+
+#include "vpTemplateTrackerTexture.h"
+
+namespace {
+  bool checkBatchedWarp(vpTemplateTrackerWarp &warp, const vpColVector &p, const std::string &name)
+  {
+    std::vector<double> u0, v0;
+    for (int i = 0; i < 20; i++) {
+      for (int j = 0; j < 30; j++) {
+        u0.push_back(50 + 3 * j);
+        v0.push_back(40 + 2 * i);
+      }
+    }
+    std::vector<double> u(u0.size()), v(v0.size());
+    warp.warp(&u0[0], &v0[0], (int)u0.size(), p, &u[0], &v[0]);
+
+    warp.computeCoeff(p);
+    vpColVector X1(2), X2(2);
+    for (size_t k = 0; k < u0.size(); k++) {
+      X1[0] = u0[k];
+      X1[1] = v0[k];
+      warp.computeDenom(X1, p);
+      warp.warpX(X1, X2, p);
+      if (std::fabs(X2[0] - u[k]) > 1e-9 || std::fabs(X2[1] - v[k]) > 1e-9) {
+        std::cerr << "Bad batched warp for " << name << ": (" << u[k] << ", " << v[k] << ") instead of (" << X2[0]
+                  << ", " << X2[1] << ")" << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    // Batched warp against warpX() for each warping function
+    {
+      vpTemplateTrackerWarpTranslation translation;
+      vpTemplateTrackerWarpRT rt;
+      vpTemplateTrackerWarpSRT srt;
+      vpTemplateTrackerWarpAffine affine;
+      vpTemplateTrackerWarpHomography homography;
+      vpTemplateTrackerWarpHomographySL3 sl3;
+      vpTemplateTrackerWarp *warps[] = { &translation, &rt, &srt, &affine, &homography, &sl3 };
+      const char *names[] = { "translation", "RT", "SRT", "affine", "homography", "SL3 homography" };
+      const double params[] = { 0.02, -0.03, 1e-4, 0.01, 0.02, -2e-4, 3.5, -2.5 };
+      for (unsigned int w = 0; w < sizeof(warps) / sizeof(warps[0]); w++) {
+        vpColVector p(warps[w]->getNbParam());
+        for (unsigned int k = 0; k < p.size(); k++) {
+          p[k] = params[k];
+        }
+        if (!checkBatchedWarp(*warps[w], p, names[w])) {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    // Reference and current images related by a small affine motion
+    vpImage<unsigned char> I0(240, 320), I1(240, 320);
+    const double A0[2][2] = { { 1, 0 }, { 0, 1 } }, t0[2] = { 0, 0 };
+    const double A[2][2] = { { 1.02, 0.015 }, { -0.01, 0.99 } }, t[2] = { 2.5, -1.5 };
+    vpTemplateTrackerTexture::render(A0, t0, I0);
+    vpTemplateTrackerTexture::render(A, t, I1);
+
+    {
+      vpTemplateTrackerWarpAffine warp;
+      vpTemplateTrackerSSDInverseCompositional tracker(&warp);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t, "SSD inverse compositional, affine", 0.1)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      vpTemplateTrackerWarpHomography warp;
+      vpTemplateTrackerSSDInverseCompositional tracker(&warp);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t,
+                                                  "SSD inverse compositional, homography", 0.1)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      vpTemplateTrackerWarpHomographySL3 warp;
+      vpTemplateTrackerSSDESM tracker(&warp);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t, "SSD ESM, SL3 homography", 0.1)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      vpTemplateTrackerWarpHomographySL3 warp;
+      vpTemplateTrackerZNCCInverseCompositional tracker(&warp);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t,
+                                                  "ZNCC inverse compositional, SL3 homography", 0.1)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      vpTemplateTrackerWarpAffine warp;
+      vpTemplateTrackerZNCCForwardAdditional tracker(&warp);
+      // The forward additional scheme uses the Hessian of the reference image and converges slowly
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t, "ZNCC forward additional, affine", 1.)) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << "testTemplateTracker is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
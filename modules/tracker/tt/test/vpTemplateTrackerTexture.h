@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Synthetic texture used by the template tracker tests.
+ *
+ *****************************************************************************/
+
+#ifndef __vpTemplateTrackerTexture_h_
+#define __vpTemplateTrackerTexture_h_
+
+/*!
+  \file vpTemplateTrackerTexture.h
+  \brief Synthetic texture used by the template tracker tests.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/tt/vpTemplateTracker.h>
+
+/*!
+  \class vpTemplateTrackerTexture
+
+  \brief Smooth texture seen through an affine motion, and the check that a template
+  tracker recovers this motion.
+*/
+class vpTemplateTrackerTexture
+{
+public:
+  //! Intensity of the texture at (u, v).
+  static double texture(double u, double v)
+  {
+    return 128 + 50 * sin(u / 7.) * cos(v / 9.) + 40 * sin((u + 2 * v) / 13.) + 20 * cos((3 * u - v) / 11.);
+  }
+
+  //! Image of the texture seen through the affine motion x' = A x + t, with the intensity change a I + b.
+  static void render(const double A[2][2], const double t[2], vpImage<unsigned char> &I, double a = 1., double b = 0.)
+  {
+    const double det = A[0][0] * A[1][1] - A[0][1] * A[1][0];
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        const double du = j - t[0], dv = i - t[1];
+        const double u = (A[1][1] * du - A[0][1] * dv) / det;
+        const double v = (-A[1][0] * du + A[0][0] * dv) / det;
+        I[i][j] = (unsigned char)vpMath::round(a * texture(u, v) + b);
+      }
+    }
+  }
+
+  /*!
+    Track a 120x120 square of \e I0 in \e I1 and check that the corners of the square are
+    warped by the affine motion (A, t) up to \e tolerance pixels.
+  */
+  static bool checkTracker(vpTemplateTracker &tracker, const vpImage<unsigned char> &I0,
+                           const vpImage<unsigned char> &I1, const double A[2][2], const double t[2],
+                           const std::string &name, const double tolerance)
+  {
+    // Two triangles covering a 120x120 square
+    std::vector<vpImagePoint> corners;
+    corners.push_back(vpImagePoint(60, 70));
+    corners.push_back(vpImagePoint(60, 190));
+    corners.push_back(vpImagePoint(180, 190));
+    corners.push_back(vpImagePoint(60, 70));
+    corners.push_back(vpImagePoint(180, 190));
+    corners.push_back(vpImagePoint(180, 70));
+
+    tracker.setSampling(2, 2);
+    tracker.setLambda(0.001);
+    tracker.setIterationMax(200);
+    tracker.setPyramidal(2, 1);
+    tracker.initFromPoints(I0, corners);
+
+    double t0 = vpTime::measureTimeMs();
+    tracker.track(I1);
+    double duration = vpTime::measureTimeMs() - t0;
+
+    vpTemplateTrackerWarp *warp = tracker.getWarp();
+    vpColVector p = tracker.getp();
+    warp->computeCoeff(p);
+    vpColVector X1(2), X2(2);
+    double error = 0;
+    for (size_t k = 0; k < corners.size(); k++) {
+      X1[0] = corners[k].get_j();
+      X1[1] = corners[k].get_i();
+      warp->computeDenom(X1, p);
+      warp->warpX(X1, X2, p);
+      const double u = A[0][0] * X1[0] + A[0][1] * X1[1] + t[0];
+      const double v = A[1][0] * X1[0] + A[1][1] * X1[1] + t[1];
+      error = std::max(error, std::sqrt((X2[0] - u) * (X2[0] - u) + (X2[1] - v) * (X2[1] - v)));
+    }
+
+    std::cout << name << ": corner error " << error << " px, " << duration << " ms" << std::endl;
+    if (error > tolerance) {
+      std::cerr << "Bad tracking with " << name << std::endl;
+      return false;
+    }
+    return true;
+  }
+};
+
+#endif
@@ -112,6 +112,23 @@ protected:
   vpMatrix    covarianceMatrix;
   bool        computeCovariance;
 
+  //contribution of a template point to the joint probability, see putProbabilities()
+  typedef enum {
+    PROBA_NONE,     // point outside of the image or not used
+    PROBA_PRT,      // joint probability only
+    PROBA_NOSECOND, // joint probability and its first derivatives
+    PROBA_TOTAL     // joint probability and its first and second derivatives
+  } vpProbaContributionType;
+
+  //per point bins and derivatives filled by the trackers before putProbabilities()
+  std::vector<unsigned char> ptProbaType;
+  std::vector<int>           ptProbaCr;
+  std::vector<double>        ptProbaEr;
+  std::vector<int>           ptProbaCt;
+  std::vector<double>        ptProbaEt;
+  std::vector<double>        ptProbaVal;
+  std::vector<double>        probaThreads; //per thread histograms
+
 protected:
   void    computeGradient();
   void    computeHessien(vpMatrix &H);
@@ -123,6 +140,7 @@ protected:
   double  getNormalizedCost(const vpImage<unsigned char> &I, const vpColVector &tp);
   double  getNormalizedCost(const vpImage<unsigned char> &I){return getNormalizedCost(I,p);}
   virtual void    initHessienDesired(const vpImage<unsigned char> &I)=0;
+  void    putProbabilities(bool tout, bool useTemplateBspline=false);
   virtual void    trackNoPyr(const vpImage<unsigned char> &I)=0;
   void    zeroProbabilities();
 
@@ -151,7 +169,8 @@ public:
       temp(NULL), Prt(NULL), dPrt(NULL), Pt(NULL), Pr(NULL), d2Prt(NULL), PrtTout(NULL),
       dprtemp(NULL), PrtD(NULL), dPrtD(NULL), influBspline(0), bspline(0), Nc(0), Ncb(0),
       d2Ix(), d2Iy(), d2Ixy(), MI_preEstimation(0), MI_postEstimation(0),
-      NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false)
+      NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false),
+      ptProbaType(), ptProbaCr(), ptProbaEr(), ptProbaCt(), ptProbaEt(), ptProbaVal(), probaThreads()
   {}
   explicit vpTemplateTrackerMI(vpTemplateTrackerWarp *_warp);
   ~vpTemplateTrackerMI();
@@ -82,6 +82,11 @@ public:
   static void PutTotPVBspline4NoSecond(double *Prt, int &cr, double &er, int &ct, double &et,int &Nc, double *val, unsigned int &NbParam);
   static void PutTotPVBspline4NoSecond(double *Prt, double *dPrt, int &cr, double &er, int &ct, double &et,int &Ncb, double *val, unsigned int &NbParam);
 
+  // Template B-spline weights computed once per point, see vpTemplateTrackerMIInverseCompositional
+  static void computeBsplineWeights(double et, int degree, double *Bt, double *dBt, double *d2Bt);
+  static void PutTotPVBspline(double *Prt, double *dPrt, double *d2Prt, int cr, double er, int ct, double et, const double *Bt, const double *dBt, const double *d2Bt, int Ncb, const double *val, unsigned int NbParam, int degree);
+  static void PutTotPVBsplineNoSecond(double *Prt, double *dPrt, int cr, double er, int ct, double et, const double *Bt, const double *dBt, int Ncb, const double *val, unsigned int NbParam, int degree);
+
   static void PutTotPVBsplinePrtTout(double *Prt, int &cr, double &er, int &ct, double &et,int &Nc, unsigned int &NbParam, int &degree);
   static void PutTotPVBspline3PrtTout(double *Prt, int &cr, double &er, int &ct, double &et,int &Nc, unsigned int &NbParam);
   static void PutTotPVBspline4PrtTout(double *Prt, int &cr, double &er, int &ct, double &et,int &Nc, unsigned int &NbParam);
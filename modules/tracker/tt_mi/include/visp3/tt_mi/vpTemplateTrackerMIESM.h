@@ -75,6 +75,8 @@ protected:
 protected:
   void initCompInverse();
   void initHessienDesired(const vpImage<unsigned char> &I);
+  void putProbabilitiesDirect();
+  void putProbabilitiesInverse();
   void trackNoPyr(const vpImage<unsigned char> &I);
 
 //private:
@@ -37,10 +37,22 @@
  * Fabien Spindler
  *
  *****************************************************************************/
+#include <algorithm>
+
 #include <visp3/core/vpException.h>
 #include <visp3/tt_mi/vpTemplateTrackerMI.h>
 #include <visp3/tt_mi/vpTemplateTrackerMIBSpline.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+  // Maximum number of doubles of the per thread histograms (32 MB): with a large number of
+  // bins Nc, fewer threads fill their own histograms
+  const size_t vpTemplateTrackerMIMaxProbaThreadsSize = (size_t)1 << 22;
+}
+
 void vpTemplateTrackerMI::setBspline(const vpBsplineType &newbs)
 {
   bspline=(int)newbs;
@@ -76,7 +88,8 @@ vpTemplateTrackerMI::vpTemplateTrackerMI(vpTemplateTrackerWarp *_warp)
     temp(NULL), Prt(NULL), dPrt(NULL), Pt(NULL), Pr(NULL), d2Prt(NULL), PrtTout(NULL),
     dprtemp(NULL), PrtD(NULL), dPrtD(NULL), influBspline(0), bspline(3), Nc(8), Ncb(0),
     d2Ix(), d2Iy(), d2Ixy(), MI_preEstimation(0), MI_postEstimation(0),
-    NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false)
+    NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false),
+    ptProbaType(), ptProbaCr(), ptProbaEr(), ptProbaCt(), ptProbaEt(), ptProbaVal(), probaThreads()
 {
   Ncb=Nc+bspline;
   influBspline=bspline*bspline;
@@ -653,12 +666,137 @@ void vpTemplateTrackerMI::zeroProbabilities()
   memset(d2Prt, 0, Ncb_*Ncb_*nbParam*nbParam*sizeof(double));
   memset(PrtTout, 0, Nc_*Nc_*influBspline_*(1+nbParam+nbParam*nbParam)*sizeof(double));
 
+  ptProbaType.resize(templateSize);
+  ptProbaCr.resize(templateSize);
+  ptProbaEr.resize(templateSize);
+  ptProbaCt.resize(templateSize);
+  ptProbaEt.resize(templateSize);
+  ptProbaVal.resize(templateSize*nbParam);
+
   //    std::cout << Ncb*Ncb << std::endl;
   //    std::cout << Ncb*Ncb*nbParam << std::endl;
   //    std::cout << Ncb*Ncb*nbParam*nbParam << std::endl;
   //    std::cout << Ncb*Ncb*influBspline*(1+nbParam+nbParam*nbParam) << std::endl;
 }
 
+/*!
+  Add the contributions of the template points described by ptProbaType, ptProbaCr,
+  ptProbaEr, ptProbaCt, ptProbaEt and ptProbaVal (nbParam values per point) to the
+  joint probability.
+
+  \param tout : If true, the contributions are added to PrtTout, that computeProba()
+  folds into Prt, dPrt and d2Prt. Otherwise they are directly added to Prt, dPrt and d2Prt.
+  \param useTemplateBspline : If true and \e tout is false, the B-spline weights of the
+  template intensities are the ones precomputed in ptTemplateSupp.
+
+  With a large template, the points are split between the threads that fill their own
+  histograms. These histograms are then added in thread order, so that the result only
+  depends on the number of threads. The number of threads is limited so that their
+  histograms take at most 32 MB, a single thread being used with a large number of bins.
+ */
+void vpTemplateTrackerMI::putProbabilities(bool tout, bool useTemplateBspline)
+{
+  const unsigned int nbPoints = (unsigned int)ptProbaType.size();
+  const size_t sizePrt = tout ? (size_t)Nc*Nc*influBspline*(1+nbParam+nbParam*nbParam) : (size_t)Ncb*Ncb;
+  const size_t sizedPrt = tout ? 0 : sizePrt*nbParam;
+  const size_t sized2Prt = tout ? 0 : sizePrt*nbParam*nbParam;
+  const size_t size = sizePrt+sizedPrt+sized2Prt;
+
+  const size_t maxThreads = std::max((size_t)1, vpTemplateTrackerMIMaxProbaThreadsSize/size);
+  const int nbThreads = (int)std::min((size_t)getNbThreads(), maxThreads);
+  if (nbThreads > 1) {
+    probaThreads.resize((size_t)nbThreads*size);
+    std::fill(probaThreads.begin(), probaThreads.end(), 0.);
+  }
+  else {
+    std::vector<double>().swap(probaThreads);
+  }
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel num_threads(nbThreads)
+#endif
+  {
+    unsigned int t = 0, nt = 1;
+#ifdef VISP_HAVE_OPENMP
+    t = (unsigned int)omp_get_thread_num();
+    nt = (unsigned int)omp_get_num_threads();
+#endif
+    double *prt = tout ? PrtTout : Prt;
+    double *dprt = dPrt;
+    double *d2prt = d2Prt;
+    if (nbThreads > 1) {
+      prt = &probaThreads[(size_t)t*size];
+      dprt = prt+sizePrt;
+      d2prt = dprt+sizedPrt;
+    }
+
+    int nc = tout ? Nc : Ncb;
+    int degree = bspline;
+    unsigned int nbParam_ = nbParam;
+    const unsigned int begin = (unsigned int)((size_t)nbPoints*t/nt);
+    const unsigned int end = (unsigned int)((size_t)nbPoints*(t+1)/nt);
+    for (unsigned int point = begin; point < end; point++)
+    {
+      const unsigned char type = ptProbaType[point];
+      if (type == PROBA_NONE)
+        continue;
+
+      int cr = ptProbaCr[point];
+      double er = ptProbaEr[point];
+      int ct = ptProbaCt[point];
+      double et = ptProbaEt[point];
+      double *val = &ptProbaVal[(size_t)point*nbParam];
+
+      if (tout) {
+        if (type == PROBA_PRT)
+          vpTemplateTrackerMIBSpline::PutTotPVBsplinePrtTout(prt, cr, er, ct, et, nc, nbParam_, degree);
+        else if (type == PROBA_NOSECOND)
+          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(prt, cr, er, ct, et, nc, val, nbParam_, degree);
+        else
+          vpTemplateTrackerMIBSpline::PutTotPVBspline(prt, cr, er, ct, et, nc, val, nbParam_, degree);
+      }
+      else if (type == PROBA_PRT) {
+        if (degree == 4)
+          vpTemplateTrackerMIBSpline::PutTotPVBspline4Prt(prt, cr, er, ct, et, nc);
+        else
+          vpTemplateTrackerMIBSpline::PutTotPVBspline3Prt(prt, cr, er, ct, et, nc);
+      }
+      else if (useTemplateBspline) {
+        const vpTemplateTrackerPointSuppMIInv &supp = ptTemplateSupp[point];
+        if (type == PROBA_NOSECOND)
+          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(prt, dprt, cr, er, ct, et, supp.Bt, supp.dBt, nc, val, nbParam, degree);
+        else
+          vpTemplateTrackerMIBSpline::PutTotPVBspline(prt, dprt, d2prt, cr, er, ct, et, supp.Bt, supp.dBt, supp.d2Bt, nc, val, nbParam, degree);
+      }
+      else {
+        if (type == PROBA_NOSECOND)
+          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(prt, dprt, cr, er, ct, et, nc, val, nbParam_, degree);
+        else
+          vpTemplateTrackerMIBSpline::PutTotPVBspline(prt, dprt, d2prt, cr, er, ct, et, nc, val, nbParam_, degree);
+      }
+    }
+  }
+
+  if (nbThreads > 1) {
+    double *dest[3] = { tout ? PrtTout : Prt, dPrt, d2Prt };
+    const size_t destSize[3] = { sizePrt, sizedPrt, sized2Prt };
+    size_t offset = 0;
+    for (unsigned int c = 0; c < 3; c++) {
+      double *d = dest[c];
+      const double *partial = &probaThreads[offset];
+      const int n = (int)destSize[c];
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+      for (int k = 0; k < n; k++) {
+        for (int t = 0; t < nbThreads; t++)
+          d[k] += partial[(size_t)t*size+(size_t)k];
+      }
+      offset += destSize[c];
+    }
+  }
+}
+
 double vpTemplateTrackerMI::getMI(const vpImage<unsigned char> &I,int &nc, const int &bspline_,vpColVector &tp)
 {
   unsigned int tNcb = (unsigned int)(nc+bspline_);
@@ -40,9 +40,7 @@
 
 #include <visp3/tt_mi/vpTemplateTrackerMIESM.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
+#include <algorithm>
 
 vpTemplateTrackerMIESM::vpTemplateTrackerMIESM(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), CompoInitialised(false),
@@ -61,58 +59,21 @@ void vpTemplateTrackerMIESM::initHessienDesired(const vpImage<unsigned char> &I)
 
   dW=0;
 
-  //double erreur=0;
-  int Nbpoint=0;
-
-  double i2,j2;
-  //double Tij;
-  double /*IW,*/dx,dy;
-  //int cr,ct;
-  //double er,et;
-  int i,j;
-
-  Nbpoint=0;
-  //erreur=0;
-
   if(blur)
     vpImageFilter::filter(I, BI,fgG,taillef);
-
-  zeroProbabilities();
-
-  Warp->computeCoeff(p);
-  for(unsigned int point=0;point<templateSize;point++)
+  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
+  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
+  if(ApproxHessian!=HESSIAN_NONSECOND && ApproxHessian!=HESSIAN_0 && ApproxHessian!=HESSIAN_NEW && ApproxHessian!=HESSIAN_YOUCEF)
   {
-    i=ptTemplate[point].y;
-    j=ptTemplate[point].x;
-    X1[0]=j;X1[1]=i;
-
-    Warp->computeDenom(X1,p);
-    Warp->warpX(X1,X2,p);
-
-    j2=X2[0];i2=X2[1];
-
-    if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
-    {
-      Nbpoint++;
-//      if(blur)
-//        IW=BI.getValue(i2,j2);
-//      else
-//        IW=I.getValue(i2,j2);
-
-      //ct=ptTemplateSupp[point].ct;
-      //et=ptTemplateSupp[point].et;
-      //cr=(int)((IW*(Nc-1))/255.);
-      //er=((double)IW*(Nc-1))/255.-cr;
-
-      //            if(ApproxHessian==vpTemplateTrackerMI::HESSIAN_NONSECOND) // cas à tester AY
-      //                vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout,cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam, bspline);
-      //            else
-      //                vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout,cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam, bspline);
-
-      //            vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout,cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam,bspline,ApproxHessian,false);
-    }
+    vpImageFilter::getGradX(dIx, d2Ix,fgdG,taillef);
+    vpImageFilter::getGradY(dIx, d2Ixy,fgdG,taillef);
+    vpImageFilter::getGradY(dIy, d2Iy,fgdG,taillef);
   }
 
+  int Nbpoint=(int)warpTemplate(I,p,true);
+
+  zeroProbabilities();
+  putProbabilitiesInverse();
 
   double MI;
   computeProba(Nbpoint);
@@ -123,70 +84,8 @@ void vpTemplateTrackerMIESM::initHessienDesired(const vpImage<unsigned char> &I)
   /////////////////////////////////////////////////////////////////////////
   // DIRECT COMPO
 
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
-  if(ApproxHessian!=HESSIAN_NONSECOND && ApproxHessian!=HESSIAN_0 && ApproxHessian!=HESSIAN_NEW && ApproxHessian!=HESSIAN_YOUCEF)
-  {
-    vpImageFilter::getGradX(dIx, d2Ix,fgdG,taillef);
-    vpImageFilter::getGradY(dIx, d2Ixy,fgdG,taillef);
-    vpImageFilter::getGradY(dIy, d2Iy,fgdG,taillef);
-  }
-
-  Nbpoint=0;
-  //erreur=0;
   zeroProbabilities();
-
-  Warp->computeCoeff(p);
-  for(unsigned int point=0;point<templateSize;point++)
-  {
-    i=ptTemplate[point].y;
-    j=ptTemplate[point].x;
-    X1[0]=j;X1[1]=i;
-
-    Warp->computeDenom(X1,p);
-    Warp->warpX(X1,X2,p);
-
-    j2=X2[0];i2=X2[1];
-
-    if((i2>=0)&&(j2>=0)&&(i2<I.getHeight())&&(j2<I.getWidth()))
-    {
-      Nbpoint++;
-      //Tij=ptTemplate[point].val;
-      //if(!blur)
-      //  IW=I.getValue(i2,j2);
-      //else
-      //  IW=BI.getValue(i2,j2);
-
-      dx=1.*dIx.getValue(i2,j2)*(Nc-1)/255.;
-      dy=1.*dIy.getValue(i2,j2)*(Nc-1)/255.;
-
-      //cr=ptTemplateSupp[point].ct;
-      //er=ptTemplateSupp[point].et;
-      //ct=(int)((IW*(Nc-1))/255.);
-      //et=((double)IW*(Nc-1))/255.-ct;
-
-      Warp->dWarpCompo(X1,X2,p,ptTemplateCompo[point].dW,dW);
-
-      double *tptemp=new double[nbParam];
-      for(unsigned int it=0;it<nbParam;it++)
-        tptemp[it] =dW[0][it]*dx+dW[1][it]*dy;
-
-
-      //                vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout,cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam,bspline,ApproxHessian,
-      //                                                         hessianComputation== vpTemplateTrackerMI::USE_HESSIEN_DESIRE);
-      //calcul de l'erreur
-      //erreur+=(Tij-IW)*(Tij-IW);
-
-      //          if(ApproxHessian==vpTemplateTrackerMI::HESSIAN_NONSECOND) // cas à tester AY
-      //              vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout,cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-      //          else
-      //              vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout,cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-      //      vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout,cr, er, ct, et, Nc, tptemp, nbParam,bspline,ApproxHessian,false);
-
-      delete[] tptemp;
-    }
-  }
+  putProbabilitiesDirect();
 
   computeProba(Nbpoint);
   computeMI(MI);
@@ -252,6 +151,78 @@ void vpTemplateTrackerMIESM::initCompInverse()
   CompoInitialised=true;
 }
 
+/*!
+  Add to the joint probability the contributions of the template points warped by
+  warpTemplate(), with the derivatives taken on the template (inverse compositional part
+  of the ESM).
+ */
+void vpTemplateTrackerMIESM::putProbabilitiesInverse()
+{
+  for(unsigned int point=0;point<templateSize;point++)
+  {
+    ptProbaType[point]=PROBA_NONE;
+    if(ptWarpedInside[point])
+    {
+      double IW=ptWarpedI[point];
+
+      int cr=(int)((IW*(Nc-1))/255.);
+      ptProbaCr[point]=cr;
+      ptProbaEr[point]=((double)IW*(Nc-1))/255.-cr;
+      ptProbaCt[point]=ptTemplateSupp[point].ct;
+      ptProbaEt[point]=ptTemplateSupp[point].et;
+      std::copy(ptTemplate[point].dW, ptTemplate[point].dW+nbParam, &ptProbaVal[point*nbParam]);
+
+      if(ApproxHessian==vpTemplateTrackerMI::HESSIAN_NONSECOND||hessianComputation==vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
+        ptProbaType[point]=PROBA_NOSECOND;
+      else
+        ptProbaType[point]=PROBA_TOTAL;
+    }
+  }
+  putProbabilities(true);
+}
+
+/*!
+  Add to the joint probability the contributions of the template points warped by
+  warpTemplate(), with the derivatives taken on the current image (forward compositional
+  part of the ESM). The image gradient has to be interpolated by warpTemplate().
+ */
+void vpTemplateTrackerMIESM::putProbabilitiesDirect()
+{
+  Warp->computeCoeff(p);
+  for(unsigned int point=0;point<templateSize;point++)
+  {
+    ptProbaType[point]=PROBA_NONE;
+    if(ptWarpedInside[point])
+    {
+      X1[0]=ptTemplateX[point];X1[1]=ptTemplateY[point];
+      X2[0]=ptWarpedX[point];X2[1]=ptWarpedY[point];
+      Warp->computeDenom(X1,p);
+
+      double IW=ptWarpedI[point];
+      double dx=1.*ptWarpedDx[point]*(Nc-1)/255.;
+      double dy=1.*ptWarpedDy[point]*(Nc-1)/255.;
+
+      int ct=(int)((IW*(Nc-1))/255.);
+      ptProbaCt[point]=ct;
+      ptProbaEt[point]=((double)IW*(Nc-1))/255.-ct;
+      ptProbaCr[point]=ptTemplateSupp[point].ct;
+      ptProbaEr[point]=ptTemplateSupp[point].et;
+
+      Warp->dWarpCompo(X1,X2,p,ptTemplateCompo[point].dW,dW);
+
+      double *tptemp=&ptProbaVal[point*nbParam];
+      for(unsigned int it=0;it<nbParam;it++)
+        tptemp[it] =dW[0][it]*dx+dW[1][it]*dy;
+
+      if(ApproxHessian==vpTemplateTrackerMI::HESSIAN_NONSECOND||hessianComputation==vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
+        ptProbaType[point]=PROBA_NOSECOND;
+      else
+        ptProbaType[point]=PROBA_TOTAL;
+    }
+  }
+  putProbabilities(true);
+}
+
 void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if(!CompoInitialised)
@@ -269,69 +240,24 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
     getGradY(dIy, d2Iy,fgdG,taillef);
   }*/
 
-  //double erreur=0;
-  int point;
-
   MI_preEstimation=-getCost(I,p);
 
   lambda=lambdaDep;
-  //double MIprec=-1000;
-
-  double i2,j2;
-  //double Tij;
-  //double IW;
-  //int cr,ct;
-  //double er,et;
 
   vpColVector dpinv(nbParam);
 
   double alpha=2.;
 
-  int i,j;
   unsigned int iteration=0;
   do
   {
-    int Nbpoint=0;
-    //MIprec=MI;
     double MI=0;
-    //erreur=0;
 
-    zeroProbabilities();
+    // The inverse and direct joint histograms use the same warped points
+    int Nbpoint=(int)warpTemplate(I,p,true);
 
-    /////////////////////////////////////////////////////////////////////////
-    // Inverse
-    Warp->computeCoeff(p);
-    for(point=0;point<(int)templateSize;point++)
-    {
-      i=ptTemplate[point].y;
-      j=ptTemplate[point].x;
-      X1[0]=j;X1[1]=i;
-
-      Warp->computeDenom(X1,p);
-      Warp->warpX(X1,X2,p);
-
-      j2=X2[0];i2=X2[1];
-
-      if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
-      {
-        Nbpoint++;
-        //Tij=ptTemplate[point].val;
-        //if(!blur)
-        //  IW=I.getValue(i2,j2);
-        //else
-        //  IW=BI.getValue(i2,j2);
-
-        //ct=ptTemplateSupp[point].ct;
-        //et=ptTemplateSupp[point].et;
-        //cr=(int)((IW*(Nc-1))/255.);
-        //er=((double)IW*(Nc-1))/255.-cr;
-
-        //                if(ApproxHessian==vpTemplateTrackerMI::HESSIAN_NONSECOND||hessianComputation==vpTemplateTrackerMI::USE_HESSIEN_DESIRE) // cas à tester AY
-        //                    vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam, bspline);
-        //                else
-        //                    vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam, bspline);
-      }
-    }
+    zeroProbabilities();
+    putProbabilitiesInverse();
 
     if(Nbpoint==0)
     {
@@ -352,68 +278,10 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
       /////////////////////////////////////////////////////////////////////////
       // DIRECT
 
-      Nbpoint=0;
-      //MIprec=MI;
       MI=0;
-      //erreur=0;
 
       zeroProbabilities();
-
-      Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-      int nthreads = omp_get_num_procs() ;
-      //std::cout << "file: " __FILE__ << " line: " << __LINE__ << " function: " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-      omp_set_num_threads(nthreads);
-#pragma omp parallel for private(point, i,j,i2,j2) default(shared)
-#endif
-      for(point=0;point<(int)templateSize;point++)
-      {
-        i=ptTemplate[point].y;
-        j=ptTemplate[point].x;
-        X1[0]=j;X1[1]=i;
-        Warp->computeDenom(X1,p);
-        Warp->warpX(i,j,i2,j2,p);
-        X2[0]=j2;X2[1]=i2;
-
-        //Warp->computeDenom(X1,p);
-        if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
-        {
-          Nbpoint++;
-          //Tij=ptTemplate[point].val;
-          //Tij=Iterateurvecteur->val;
-          //if(!blur)
-          //  IW=I.getValue(i2,j2);
-          //else
-          //  IW=BI.getValue(i2,j2);
-
-          double dx=1.*dIx.getValue(i2,j2)*(Nc-1)/255.;
-          double dy=1.*dIy.getValue(i2,j2)*(Nc-1)/255.;
-
-          //ct=(int)((IW*(Nc-1))/255.);
-          //et=((double)IW*(Nc-1))/255.-ct;
-          //cr=ptTemplateSupp[point].ct;
-          //er=ptTemplateSupp[point].et;
-
-          Warp->dWarpCompo(X1,X2,p,ptTemplateCompo[point].dW,dW);
-
-          double *tptemp=new double[nbParam];
-          for(unsigned int it=0;it<nbParam;it++)
-            tptemp[it] =dW[0][it]*dx+dW[1][it]*dy;
-
-
-          //calcul de l'erreur
-          //erreur+=(Tij-IW)*(Tij-IW);
-          //                    if(bspline==3)
-          //                        vpTemplateTrackerMIBSpline::PutTotPVBspline3NoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam);
-          //                    else
-          //                        vpTemplateTrackerMIBSpline::PutTotPVBspline4NoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam);
-          //					vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout,cr, er, ct, et, Nc, tptemp, nbParam,bspline,ApproxHessian,
-          //                               hessianComputation==vpHessienType::USE_HESSIEN_DESIRE);
-
-          delete[] tptemp;
-
-        }
-      }
+      putProbabilitiesDirect();
 
       computeProba(Nbpoint);
       computeMI(MI);
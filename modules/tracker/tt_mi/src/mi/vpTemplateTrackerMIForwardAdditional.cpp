@@ -40,10 +40,6 @@
 
 #include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
-
 vpTemplateTrackerMIForwardAdditional::vpTemplateTrackerMIForwardAdditional(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), evolRMS(0), x_pos(NULL), y_pos(NULL),
     threshold_RMS(0), p_prec(), G_prec(), KQuasiNewton()
@@ -73,51 +69,44 @@ void vpTemplateTrackerMIForwardAdditional::initHessienDesired(const vpImage<unsi
   Nbpoint=0;
 
   zeroProbabilities();
+  Nbpoint=(int)warpTemplate(I,p,true);
   Warp->computeCoeff(p);
   for(unsigned int point=0;point<templateSize;point++)
   {
-    int i=ptTemplate[point].y;
-    int j=ptTemplate[point].x;
-    X1[0]=j;X1[1]=i;
-    X2[0]=j;X2[1]=i;
-
-    Warp->computeDenom(X1,p);
-    Warp->warpX(X1,X2,p);
-
-    double j2=X2[0];
-    double i2=X2[1];
-
-    if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+    ptProbaType[point]=PROBA_NONE;
+    if(ptWarpedInside[point])
     {
-      Nbpoint++;
+      X1[0]=ptTemplateX[point];X1[1]=ptTemplateY[point];
+      X2[0]=ptWarpedX[point];X2[1]=ptWarpedY[point];
+      Warp->computeDenom(X1,p);
+
       Tij=ptTemplate[point].val;
-      if(!blur)
-        IW=I.getValue(i2,j2);
-      else
-        IW=BI.getValue(i2,j2);
+      IW=ptWarpedI[point];
 
-      dx=1.*dIx.getValue(i2,j2)*(Nc-1)/255.;
-      dy=1.*dIy.getValue(i2,j2)*(Nc-1)/255.;
+      dx=1.*ptWarpedDx[point]*(Nc-1)/255.;
+      dy=1.*ptWarpedDy[point]*(Nc-1)/255.;
 
       ct=(int)((IW*(Nc-1))/255.);
       cr=(int)((Tij*(Nc-1))/255.);
       et=(IW*(Nc-1))/255.-ct;
       er=((double)Tij*(Nc-1))/255.-cr;
-      //std::cout<<"test"<<std::endl;
       Warp->dWarp(X1,X2,p,dW);
 
-      double *tptemp=new double[nbParam];
+      double *tptemp=&ptProbaVal[point*nbParam];
       for(unsigned int it=0;it<nbParam;it++)
         tptemp[it] =dW[0][it]*dx+dW[1][it]*dy;
 
+      ptProbaCr[point]=cr;
+      ptProbaEr[point]=er;
+      ptProbaCt[point]=ct;
+      ptProbaEt[point]=et;
       if(ApproxHessian==HESSIAN_NONSECOND)
-        vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
+        ptProbaType[point]=PROBA_NOSECOND;
       else if(ApproxHessian==HESSIAN_0 || ApproxHessian==HESSIAN_NEW)
-        vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-      delete[] tptemp;
+        ptProbaType[point]=PROBA_TOTAL;
     }
   }
+  putProbabilities(true);
 
   if(Nbpoint>0)
   {
@@ -176,63 +165,44 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
 
     zeroProbabilities();
 
+    // The Jacobian of the warp is computed sequentially, the joint histogram in parallel
+    Nbpoint=(int)warpTemplate(I,p,true);
     Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-    int nthreads = omp_get_num_procs() ;
-    //std::cout << "file: " __FILE__ << " line: " << __LINE__ << " function: " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-    omp_set_num_threads(nthreads);
-#pragma omp parallel for default(shared)
-#endif
-    for(int point=0;point<(int)templateSize;point++)
+    for(unsigned int point=0;point<templateSize;point++)
     {
-      int i=ptTemplate[point].y;
-      int j=ptTemplate[point].x;
-      X1[0]=j;X1[1]=i;
-
-      Warp->computeDenom(X1,p);
-      Warp->warpX(X1,X2,p);
-
-      double j2=X2[0];
-      double i2=X2[1];
-
-      if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+      ptProbaType[point]=PROBA_NONE;
+      if(ptWarpedInside[point])
       {
-        Nbpoint++;
+        X1[0]=ptTemplateX[point];X1[1]=ptTemplateY[point];
+        X2[0]=ptWarpedX[point];X2[1]=ptWarpedY[point];
+        Warp->computeDenom(X1,p);
+
         double Tij=ptTemplate[point].val;
-        double IW;
-        if(!blur)
-          IW=I.getValue(i2,j2);
-        else
-          IW=BI.getValue(i2,j2);
+        double IW=ptWarpedI[point];
 
-        double dx=1.*dIx.getValue(i2,j2)*(Nc-1)/255.;
-        double dy=1.*dIy.getValue(i2,j2)*(Nc-1)/255.;
+        double dx=1.*ptWarpedDx[point]*(Nc-1)/255.;
+        double dy=1.*ptWarpedDy[point]*(Nc-1)/255.;
 
         int ct=(int)((IW*(Nc-1))/255.);
         int cr=(int)((Tij*(Nc-1))/255.);
-        double et=(IW*(Nc-1))/255.-ct;
-        double er=((double)Tij*(Nc-1))/255.-cr;
-
-        //calcul de l'erreur
-        //erreur+=(Tij-IW)*(Tij-IW);
+        ptProbaCt[point]=ct;
+        ptProbaCr[point]=cr;
+        ptProbaEt[point]=(IW*(Nc-1))/255.-ct;
+        ptProbaEr[point]=((double)Tij*(Nc-1))/255.-cr;
 
-        //Calcul de l'histogramme joint par interpolation bilinÃaire (Bspline ordre 1)
         Warp->dWarp(X1,X2,p,dW);
 
-        //double *tptemp=temp;
-        double *tptemp=new double[nbParam];;
+        double *tptemp=&ptProbaVal[point*nbParam];
         for(unsigned int it=0;it<nbParam;it++)
           tptemp[it] =(dW[0][it]*dx+dW[1][it]*dy);
-        //*tptemp++ =dW[0][it]*dIWx+dW[1][it]*dIWy;
-        //std::cout<<cr<<"   "<<ct<<"  ; ";
+
         if(ApproxHessian==HESSIAN_NONSECOND||hessianComputation==vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
+          ptProbaType[point]=PROBA_NOSECOND;
         else if(ApproxHessian==HESSIAN_0 || ApproxHessian==HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
+          ptProbaType[point]=PROBA_TOTAL;
       }
     }
+    putProbabilities(true);
 
     if(Nbpoint==0)
     {
@@ -99,31 +99,21 @@ void vpTemplateTrackerMIForwardCompositional::initHessienDesired(const vpImage<u
 
   zeroProbabilities();
 
+  Nbpoint=(int)warpTemplate(I,p,true);
   Warp->computeCoeff(p);
   for(unsigned int point=0;point<templateSize;point++)
   {
-    int i=ptTemplate[point].y;
-    int j=ptTemplate[point].x;
-    X1[0]=j;
-    X1[1]=i;
-
-    Warp->computeDenom(X1,p);
-    Warp->warpX(X1,X2,p);
-
-    double j2=X2[0];
-    double i2=X2[1];
-
-    if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+    ptProbaType[point]=PROBA_NONE;
+    if(ptWarpedInside[point])
     {
-      Nbpoint++;
-      //Tij=ptTemplate[point].val;
-      if(!blur)
-        IW=I.getValue(i2,j2);
-      else
-        IW=BI.getValue(i2,j2);
+      X1[0]=ptTemplateX[point];X1[1]=ptTemplateY[point];
+      X2[0]=ptWarpedX[point];X2[1]=ptWarpedY[point];
+      Warp->computeDenom(X1,p);
+
+      IW=ptWarpedI[point];
 
-      dx=1.*dIx.getValue(i2,j2)*(Nc-1)/255.;
-      dy=1.*dIy.getValue(i2,j2)*(Nc-1)/255.;
+      dx=1.*ptWarpedDx[point]*(Nc-1)/255.;
+      dy=1.*ptWarpedDy[point]*(Nc-1)/255.;
 
       cr=ptTemplateSupp[point].ct;
       er=ptTemplateSupp[point].et;
@@ -132,18 +122,19 @@ void vpTemplateTrackerMIForwardCompositional::initHessienDesired(const vpImage<u
 
       Warp->dWarpCompo(X1,X2,p,ptTemplate[point].dW,dW);
 
-      double *tptemp=new double[nbParam];
+      double *tptemp=&ptProbaVal[point*nbParam];
       for(unsigned int it=0;it<nbParam;it++)
         tptemp[it] =dW[0][it]*dx+dW[1][it]*dy;
 
-      //calcul de l'erreur
-      //erreur+=(Tij-IW)*(Tij-IW);
-
-      vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc,tptemp, nbParam, bspline);
-
-      delete[] tptemp;
+      ptProbaCr[point]=cr;
+      ptProbaEr[point]=er;
+      ptProbaCt[point]=ct;
+      ptProbaEt[point]=et;
+      ptProbaType[point]=PROBA_TOTAL;
     }
   }
+  putProbabilities(true);
+
   double MI;
   computeProba(Nbpoint);
   computeMI(MI);
@@ -176,7 +167,6 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
 
   MI_preEstimation=-getCost(I,p);
 
-  double i2,j2;
   //double Tij;
   double IW;
   //unsigned
@@ -187,7 +177,6 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
   vpColVector dpinv(nbParam);
   double alpha=2.;
 
-  int i,j;
   unsigned int iteration=0;
   do
   {
@@ -198,28 +187,22 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
 
     zeroProbabilities();
 
+    // The Jacobian of the warp is computed sequentially, the joint histogram in parallel
+    Nbpoint=(int)warpTemplate(I,p,true);
     Warp->computeCoeff(p);
-
     for(unsigned int point=0;point<templateSize;point++)
     {
-      i=ptTemplate[point].y;
-      j=ptTemplate[point].x;
-      X1[0]=j;X1[1]=i;
-      Warp->warpX(i,j,i2,j2,p);
-      X2[0]=j2;X2[1]=i2;
-
-      Warp->computeDenom(X1,p);
-      if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+      ptProbaType[point]=PROBA_NONE;
+      if(ptWarpedInside[point])
       {
-        Nbpoint++;
-        //Tij=ptTemplate[point].val;
-        if(!blur)
-          IW=I.getValue(i2,j2);
-        else
-          IW=BI.getValue(i2,j2);
+        X1[0]=ptTemplateX[point];X1[1]=ptTemplateY[point];
+        X2[0]=ptWarpedX[point];X2[1]=ptWarpedY[point];
+        Warp->computeDenom(X1,p);
+
+        IW=ptWarpedI[point];
 
-        dx=1.*dIx.getValue(i2,j2)*(Nc-1)/255.;
-        dy=1.*dIy.getValue(i2,j2)*(Nc-1)/255.;
+        dx=1.*ptWarpedDx[point]*(Nc-1)/255.;
+        dy=1.*ptWarpedDy[point]*(Nc-1)/255.;
 
         ct=(int)((IW*(Nc-1))/255.);
         et=((double)IW*(Nc-1))/255.-ct;
@@ -228,23 +211,22 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
 
         Warp->dWarpCompo(X1,X2,p,ptTemplate[point].dW,dW);
 
-        double *tptemp=new double[nbParam];
+        double *tptemp=&ptProbaVal[point*nbParam];
         for(unsigned int it=0;it<nbParam;it++)
           tptemp[it] =dW[0][it]*dx+dW[1][it]*dy;
 
-
-        //calcul de l'erreur
-        //erreur+=(Tij-IW)*(Tij-IW);
-
+        ptProbaCr[point]=cr;
+        ptProbaEr[point]=er;
+        ptProbaCt[point]=ct;
+        ptProbaEt[point]=et;
         if(ApproxHessian==HESSIAN_NONSECOND||hessianComputation==vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
+          ptProbaType[point]=PROBA_NOSECOND;
         else if(ApproxHessian==HESSIAN_0|| ApproxHessian==HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
-
+          ptProbaType[point]=PROBA_TOTAL;
       }
     }
+    putProbabilities(true);
+
     if(Nbpoint==0)
     {
       //std::cout<<"plus de point dans template suivi"<<std::endl;
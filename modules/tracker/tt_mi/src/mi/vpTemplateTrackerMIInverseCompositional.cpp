@@ -40,6 +40,7 @@
 #include <visp3/tt_mi/vpTemplateTrackerMIInverseCompositional.h>
 #include <visp3/core/vpTrackingException.h>
 
+#include <algorithm>
 #include <memory>
 
 vpTemplateTrackerMIInverseCompositional::vpTemplateTrackerMIInverseCompositional(vpTemplateTrackerWarp *_warp)
@@ -122,6 +123,11 @@ void vpTemplateTrackerMIInverseCompositional::initCompInverse(const vpImage<unsi
 
     ptTemplateSupp[point].et=et;
     ptTemplateSupp[point].ct=ct;
+    // The template intensities do not change while tracking: their B-spline weights are computed once
+    ptTemplateSupp[point].Bt=new double[bspline];
+    ptTemplateSupp[point].dBt=new double[bspline];
+    ptTemplateSupp[point].d2Bt=new double[bspline];
+    vpTemplateTrackerMIBSpline::computeBsplineWeights(et, bspline, ptTemplateSupp[point].Bt, ptTemplateSupp[point].dBt, ptTemplateSupp[point].d2Bt);
 
     // ###### AY Optim
     //        if(useAYOptim)
@@ -151,76 +157,35 @@ void vpTemplateTrackerMIInverseCompositional::initHessienDesired(const vpImage<u
     vpImageFilter::filter(I, BI,fgG,taillef);
 
   zeroProbabilities();
-  Warp->computeCoeff(p);
-
-  // AY : Optim
-  //    unsigned int totParam = (bspline * bspline)*(1+nbParam+nbParam*nbParam);
-  //    unsigned int size = (1 + nbParam + nbParam*nbParam)*bspline;
-  //    double *ptb;
+  Nbpoint=(int)warpTemplate(I,p);
 
   for(unsigned int point=0;point<templateSize;point++)
   {
-    int i=ptTemplate[point].y;
-    int j=ptTemplate[point].x;
-    X1[0]=j;
-    X1[1]=i;
-
-    Warp->computeDenom(X1,p);
-    Warp->warpX(X1,X2,p);
-
-    double j2=X2[0];
-    double i2=X2[1];
-
-    if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+    ptProbaType[point]=PROBA_NONE;
+    if(ptWarpedInside[point])
     {
-      Nbpoint++;
-      //Tij=ptTemplate[point].val;
-
-      if(blur)
-        IW=BI.getValue(i2,j2);
-      else
-        IW=I.getValue(i2,j2);
+      IW=ptWarpedI[point];
 
       ct=ptTemplateSupp[point].ct;
       et=ptTemplateSupp[point].et;
       cr=(int)((IW*(Nc-1))/255.);
       er=((double)IW*(Nc-1))/255.-cr;
 
-      //calcul de l'erreur
-      //erreur+=(Tij-IW)*(Tij-IW);
+      ptProbaCr[point]=cr;
+      ptProbaEr[point]=er;
+      ptProbaCt[point]=ct;
+      ptProbaEt[point]=et;
+      std::copy(ptTemplate[point].dW, ptTemplate[point].dW+nbParam, &ptProbaVal[point*nbParam]);
 
       if( ApproxHessian==HESSIAN_NONSECOND && (ptTemplateSelect[point] || !useTemplateSelect) )
-      {
-        vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam, bspline);
-      }
+        ptProbaType[point]=PROBA_NOSECOND;
       else if ((ApproxHessian==HESSIAN_0||ApproxHessian==HESSIAN_NEW) && (ptTemplateSelect[point] || !useTemplateSelect))
-      {
-        if(bspline==3){
-          vpTemplateTrackerMIBSpline::PutTotPVBspline3(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam);
-          //                    {
-          //                        if(et>0.5){ct++;}
-          //                        if(er>0.5){cr++;}
-          //                        int index = (cr*Nc+ct)*totParam;
-          //                        double *ptb = &PrtTout[index];
-          //                        vpTemplateTrackerMIBSpline::PutTotPVBspline3(ptb, er, ptTemplateSupp[point].BtInit, size);
-          //                    }
-        }
-        else{
-          vpTemplateTrackerMIBSpline::PutTotPVBspline4(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam);
-
-          //                    {
-          //                        // ################### AY : Optim
-          //                        unsigned int index = (cr*Nc+ct)*totParam;
-          //                        ptb = &PrtTout[index];
-          //                        vpTemplateTrackerMIBSpline::PutTotPVBspline4(ptb, er, ptTemplateSupp[point].BtInit, size);
-          //                        // ###################
-          //                    }
-        }
-      }
+        ptProbaType[point]=PROBA_TOTAL;
       else if (ptTemplateSelect[point] || !useTemplateSelect)
-        vpTemplateTrackerMIBSpline::PutTotPVBsplinePrt(PrtTout, cr, er, ct, et, Nc,nbParam, bspline);
+        ptProbaType[point]=PROBA_PRT;
     }
   }
+  putProbabilities(true);
 
   double MI;
   computeProba(Nbpoint);
@@ -274,61 +239,31 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
 
     zeroProbabilities();
 
-    Warp->computeCoeff(p);
-
+    Nbpoint=(int)warpTemplate(I,p);
+    for(unsigned int point=0;point<templateSize;point++)
     {
-      for(int point=0;point<(int)templateSize;point++)
+      ptProbaType[point]=PROBA_NONE;
+      if(ptWarpedInside[point])
       {
-        vpColVector x1(2),x2(2);
-        double i2,j2;
-
-        x1[0]=(double)ptTemplate[point].x;
-        x1[1]=(double)ptTemplate[point].y;
-
-        Warp->computeDenom(x1,p); // A modif pour parallelisation mais ne pose pas de pb avec warp utilises dans DECSA
-        Warp->warpX(x1,x2,p);
-
-        j2=x2[0];
-        i2=x2[1];
-
-        if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
-        {
-          //if(m_ptCurrentMask == NULL ||(m_ptCurrentMask->getWidth() == I.getWidth() && m_ptCurrentMask->getHeight() == I.getHeight() && (*m_ptCurrentMask)[(unsigned int)i2][(unsigned int)j2] > 128))
-          {
-            Nbpoint++;
-            double IW;
-            if(!blur)
-              IW=(double)I.getValue(i2,j2);
-            else
-              IW=BI.getValue(i2,j2);
-
-            int ct=ptTemplateSupp[point].ct;
-            double et=ptTemplateSupp[point].et;
-            double tmp = IW*(((double)Nc)-1.f)/255.f;
-            int cr=(int)tmp;
-            double er=tmp-(double)cr;
-
-            if( (ApproxHessian==HESSIAN_NONSECOND||hessianComputation==vpTemplateTrackerMI::USE_HESSIEN_DESIRE) && (ptTemplateSelect[point] || !useTemplateSelect) )
-            {
-              vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(Prt, dPrt, cr, er, ct, et, Ncb, ptTemplate[point].dW, nbParam, bspline);
-            }
-            else if (ptTemplateSelect[point] || !useTemplateSelect)
-            {
-              if(bspline==3){
-                vpTemplateTrackerMIBSpline::PutTotPVBspline3(Prt, dPrt, d2Prt, cr, er, ct, et, Ncb, ptTemplate[point].dW, nbParam);
-              }
-              else{
-                vpTemplateTrackerMIBSpline::PutTotPVBspline4(Prt, dPrt, d2Prt, cr, er, ct, et, Ncb, ptTemplate[point].dW, nbParam);
-              }
-            }
-            else{
-              vpTemplateTrackerMIBSpline::PutTotPVBsplinePrt(Prt, cr, er, ct, et, Ncb,nbParam, bspline);
-            }
-          }
-
-        }
+        double IW=ptWarpedI[point];
+
+        double tmp = IW*(((double)Nc)-1.f)/255.f;
+        int cr=(int)tmp;
+        ptProbaCr[point]=cr;
+        ptProbaEr[point]=tmp-(double)cr;
+        ptProbaCt[point]=ptTemplateSupp[point].ct;
+        ptProbaEt[point]=ptTemplateSupp[point].et;
+        std::copy(ptTemplate[point].dW, ptTemplate[point].dW+nbParam, &ptProbaVal[point*nbParam]);
+
+        if( (ApproxHessian==HESSIAN_NONSECOND||hessianComputation==vpTemplateTrackerMI::USE_HESSIEN_DESIRE) && (ptTemplateSelect[point] || !useTemplateSelect) )
+          ptProbaType[point]=PROBA_NOSECOND;
+        else if (ptTemplateSelect[point] || !useTemplateSelect)
+          ptProbaType[point]=PROBA_TOTAL;
+        else
+          ptProbaType[point]=PROBA_PRT;
       }
     }
+    putProbabilities(false, true);
 
     if(Nbpoint==0)
     {
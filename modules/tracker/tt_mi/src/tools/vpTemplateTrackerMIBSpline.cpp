@@ -239,12 +239,13 @@ void vpTemplateTrackerMIBSpline::PutTotPVBspline3(double *Prt, int cr, double &e
       *pt++ += Br * (Bti[it]);
 
       double v1 = Br * (dBti[it]);
-      for(short unsigned int ip=0;ip<NbParam;++ip)
+      for(unsigned int ip=0;ip<NbParam;++ip)
       {
         *pt++ -= v1*val[ip];
         double v2 = Br * (d2Bti[it]) * val[ip];
-        for(short unsigned int ip2=0;ip2<NbParam;++ip2)
-          *pt++ += v2*val[ip2];
+        for(unsigned int ip2=0;ip2<NbParam;++ip2)
+          pt[ip2] += v2*val[ip2];
+        pt+=NbParam;
       }
     }
   }
@@ -252,48 +253,12 @@ void vpTemplateTrackerMIBSpline::PutTotPVBspline3(double *Prt, int cr, double &e
 
 void vpTemplateTrackerMIBSpline::PutTotPVBspline3(double *Prt, double *dPrt, double *d2Prt, int cr, double &er, int ct, double &et,int Ncb, double *val, unsigned int &NbParam)
 {
-  short int sr=0;
-  short int st=0;
-  if(er>0.5){sr=1;er=er-1;}
-  if(et>0.5){st=1;et=et-1;}
-
   double Bti[3];
   double dBti[3];
   double d2Bti[3];
 
-  double *ptBti=&Bti[0];
-  double *ptdBti=&dBti[0];
-  double *ptd2Bti=&d2Bti[0];
-
-  for(short int it=1;it>=-1;it--)
-  {
-    *ptBti++ =Bspline3(it+et);
-    *ptdBti++ =dBspline3(it+et);
-    *ptd2Bti++ =d2Bspline3(it+et);
-  }
-
-  int NbParam_ = (int)NbParam;
-  for(short int ir=-1;ir<=1;++ir)
-  {
-    double Br=Bspline3(-ir+er);
-    short int irInd = ir + 1;
-    short int ind = (cr+sr+irInd)*Ncb;
-    for(short int it=0;it<=2;++it)
-    {
-      Prt[ind+(ct+st+it)] += Br * (Bti[it]);
-
-      double v1 = Br * (dBti[it]);
-      int ind1 = ((cr+sr+irInd)*Ncb+(ct+st+it))*NbParam_;
-      for (int ip=0;ip<NbParam_;++ip)
-      {
-        dPrt[ind1+ip]-= v1*val[ip];
-        double v2 = Br * (d2Bti[it]) * val[ip];
-        int ind2 = ((cr+sr+irInd)*Ncb+(ct+st+it))*NbParam_*NbParam_+ip*NbParam_;
-        for(short int ip2=0;ip2<NbParam_;++ip2)
-          d2Prt[ind2+ip2] += v2*val[ip2];
-      }
-    }
-  }
+  computeBsplineWeights(et, 3, Bti, dBti, d2Bti);
+  PutTotPVBspline(Prt, dPrt, d2Prt, cr, er, ct, et, Bti, dBti, d2Bti, Ncb, val, NbParam, 3);
 }
 
 void vpTemplateTrackerMIBSpline::PutTotPVBspline3(double *Prt, double &er, double *bt, unsigned int size)
@@ -369,11 +334,15 @@ void vpTemplateTrackerMIBSpline::PutTotPVBspline4(double *Prt, int cr, double er
     for(char it=-1;it<=2;it++)
     {
       *pt++ +=Br**ptBti;
-      for(short int ip=0;ip<NbParam_;ip++)
+      double v1=Br**ptdBti;
+      double v2=Br**ptd2Bti;
+      for(int ip=0;ip<NbParam_;ip++)
       {
-        *pt++ -=Br**ptdBti*val[ip];
-        for(short int ip2=0;ip2<NbParam_;ip2++)
-          *pt++ +=Br**ptd2Bti*val[ip]*val[ip2];
+        *pt++ -=v1*val[ip];
+        double v=v2*val[ip];
+        for(int ip2=0;ip2<NbParam_;ip2++)
+          pt[ip2] +=v*val[ip2];
+        pt+=NbParam_;
       }
       ptBti++;
       ptdBti++;
@@ -388,44 +357,8 @@ void vpTemplateTrackerMIBSpline::PutTotPVBspline4(double *Prt, double *dPrt, dou
   double dBti[4];
   double d2Bti[4];
 
-  double *ptBti=&Bti[0];
-  double *ptdBti=&dBti[0];
-  double *ptd2Bti=&d2Bti[0];
-  for(char it=-1;it<=2;it++)
-  {
-    *ptBti++ =vpTemplateTrackerBSpline::Bspline4(-it+et);
-    *ptdBti++ =dBspline4(-it+et);
-    *ptd2Bti++ =d2Bspline4(-it+et);
-  }
-
-  int NbParam_ = (int)NbParam;
-
-  for(int ir=-1;ir<=2;ir++)
-  {
-    double Br=vpTemplateTrackerBSpline::Bspline4(-ir+er);
-    int irInd = ir + 1;
-    int ind = (cr+irInd)*Ncb+ct;
-
-    ptBti=&Bti[0];
-    ptdBti=&dBti[0];
-    ptd2Bti=&d2Bti[0];
-
-    for(int it=-1;it<=2;it++)
-    {
-      Prt[ind+it] += Br * *ptBti;
-      int ind1 = ((cr+irInd)*Ncb+(ct+it))*NbParam_;
-      for(int ip=0;ip<NbParam_;ip++)
-      {
-        dPrt[ind1+ip]-= Br**ptdBti*val[ip];
-        int ind2 = ((cr+irInd)*Ncb+(ct+it))*NbParam_*NbParam_+ip*NbParam_;
-        for(int ip2=0;ip2<NbParam_;ip2++)
-          d2Prt[ind2+ip2] += Br**ptd2Bti*val[ip]*val[ip2];
-      }
-      ptBti++;
-      ptdBti++;
-      ptd2Bti++;
-    }
-  }
+  computeBsplineWeights(et, 4, Bti, dBti, d2Bti);
+  PutTotPVBspline(Prt, dPrt, d2Prt, cr, er, ct, et, Bti, dBti, d2Bti, Ncb, val, NbParam, 4);
 }
 
 void vpTemplateTrackerMIBSpline::PutTotPVBspline4(double *Prt, double &er, double *bt, unsigned int size)
@@ -528,45 +461,11 @@ void vpTemplateTrackerMIBSpline::PutTotPVBspline3NoSecond(double *Prt, int &cr,
 
 void vpTemplateTrackerMIBSpline::PutTotPVBspline3NoSecond(double *Prt, double *dPrt, int &cr, double &er, int &ct, double &et,int &Ncb, double *val, unsigned int &NbParam)
 {
-  int sr=0;
-  int st=0;
-  if(er>0.5){sr=1;er=er-1;}
-  if(et>0.5){st=1;et=et-1;}
-
   double Bti[3];
   double dBti[3];
 
-  double *ptBti=&Bti[0];
-  double *ptdBti=&dBti[0];
-  for(char it=-1;it<=1;it++)
-  {
-    *ptBti++ =Bspline3(-it+et);
-    *ptdBti++ =dBspline3(-it+et);
-  }
-
-  int NbParam_ = (int)NbParam;
-
-  for(char ir=-1;ir<=1;ir++)
-  {
-    double Br=Bspline3(-ir+er);
-
-    int irInd = ir + 1;
-    int ind = (cr+sr+irInd)*Ncb;
-
-    ptBti=&Bti[0];
-    ptdBti=&dBti[0];
-    for(char it=-1;it<=1;it++)
-    {
-      Prt[ind+(ct+st+it)] += Br**ptBti;
-      int ind1 = ((cr+sr+irInd)*Ncb+(ct+st+it))*NbParam_;
-      for(short int ip=0;ip<NbParam_;ip++)
-      {
-        dPrt[ind1+ip]-= Br**ptdBti*val[ip];
-      }
-      ptBti++;
-      ptdBti++;
-    }
-  }
+  computeBsplineWeights(et, 3, Bti, dBti, NULL);
+  PutTotPVBsplineNoSecond(Prt, dPrt, cr, er, ct, et, Bti, dBti, Ncb, val, NbParam, 3);
 }
 
 
@@ -603,36 +502,121 @@ void vpTemplateTrackerMIBSpline::PutTotPVBspline4NoSecond(double *Prt, int &cr,
 
 void vpTemplateTrackerMIBSpline::PutTotPVBspline4NoSecond(double *Prt, double *dPrt, int &cr, double &er, int &ct, double &et,int &Ncb, double *val, unsigned int &NbParam)
 {
-  double Bti[4] = {0, 0, 0, 0};
-  double dBti[4] = {0, 0, 0, 0};
+  double Bti[4];
+  double dBti[4];
 
-  for(char it=-1;it<=2;it++)
+  computeBsplineWeights(et, 4, Bti, dBti, NULL);
+  PutTotPVBsplineNoSecond(Prt, dPrt, cr, er, ct, et, Bti, dBti, Ncb, val, NbParam, 4);
+}
+
+// Weights of the degree bins of a template intensity of fractional part et, and their
+// derivatives (d2Bt can be NULL). With the third order B-spline, the bin shift for et>0.5
+// is done by the functions below that use the weights.
+void vpTemplateTrackerMIBSpline::computeBsplineWeights(double et, int degree, double *Bt, double *dBt, double *d2Bt)
+{
+  if(degree==4)
   {
-    Bti[it+1] =vpTemplateTrackerBSpline::Bspline4(-it+et);
-    dBti[it+1] = dBspline4(-it+et);
+    for(int it=-1;it<=2;it++)
+    {
+      Bt[it+1]=vpTemplateTrackerBSpline::Bspline4(-it+et);
+      dBt[it+1]=dBspline4(-it+et);
+      if(d2Bt)
+        d2Bt[it+1]=d2Bspline4(-it+et);
+    }
   }
+  else
+  {
+    if(et>0.5){et=et-1;}
+    for(int it=-1;it<=1;it++)
+    {
+      Bt[it+1]=Bspline3(-it+et);
+      dBt[it+1]=dBspline3(-it+et);
+      if(d2Bt)
+        d2Bt[it+1]=d2Bspline3(-it+et);
+    }
+  }
+}
 
-  int NbParam_ = (int)NbParam;
-
-  for(int ir=-1;ir<=2;ir++)
+// Same as PutTotPVBspline3() and PutTotPVBspline4() with the template weights given by
+// computeBsplineWeights()
+void vpTemplateTrackerMIBSpline::PutTotPVBspline(double *Prt, double *dPrt, double *d2Prt, int cr, double er, int ct, double et, const double *Bt, const double *dBt, const double *d2Bt, int Ncb, const double *val, unsigned int NbParam, int degree)
+{
+  int sr=0;
+  int st=0;
+  double Br[4];
+  if(degree==4)
   {
-    double Br=vpTemplateTrackerBSpline::Bspline4(-ir+er);
-    int irInd = ir + 1;
-    int ind = (cr+irInd)*Ncb+ct;
+    for(int ir=-1;ir<=2;ir++)
+      Br[ir+1]=vpTemplateTrackerBSpline::Bspline4(-ir+er);
+  }
+  else
+  {
+    if(er>0.5){sr=1;er=er-1;}
+    if(et>0.5){st=1;}
+    for(int ir=-1;ir<=1;ir++)
+      Br[ir+1]=Bspline3(-ir+er);
+  }
 
-    for(int it=0;it<=3;it++)
+  int NbParam_ = (int)NbParam;
+  for(int ir=0;ir<degree;ir++)
+  {
+    for(int it=0;it<degree;it++)
     {
-      Prt[ind+it] += Br*Bti[it];
-      int ind1 = ((cr+irInd)*Ncb+(ct+it))*NbParam_;
+      int ind=(cr+sr+ir)*Ncb+(ct+st+it);
+      Prt[ind] += Br[ir]*Bt[it];
 
+      double v1=Br[ir]*dBt[it];
+      double v2=Br[ir]*d2Bt[it];
+      double *pdPrt=&dPrt[ind*NbParam_];
+      double *pd2Prt=&d2Prt[ind*NbParam_*NbParam_];
       for(int ip=0;ip<NbParam_;ip++)
       {
-        dPrt[ind1+ip]-= Br*dBti[it]*val[ip];
+        pdPrt[ip] -= v1*val[ip];
+        double v=v2*val[ip];
+        for(int ip2=0;ip2<NbParam_;ip2++)
+          pd2Prt[ip2] += v*val[ip2];
+        pd2Prt+=NbParam_;
       }
     }
   }
 }
 
+// Same as PutTotPVBspline3NoSecond() and PutTotPVBspline4NoSecond() with the template
+// weights given by computeBsplineWeights()
+void vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(double *Prt, double *dPrt, int cr, double er, int ct, double et, const double *Bt, const double *dBt, int Ncb, const double *val, unsigned int NbParam, int degree)
+{
+  int sr=0;
+  int st=0;
+  double Br[4];
+  if(degree==4)
+  {
+    for(int ir=-1;ir<=2;ir++)
+      Br[ir+1]=vpTemplateTrackerBSpline::Bspline4(-ir+er);
+  }
+  else
+  {
+    if(er>0.5){sr=1;er=er-1;}
+    if(et>0.5){st=1;}
+    for(int ir=-1;ir<=1;ir++)
+      Br[ir+1]=Bspline3(-ir+er);
+  }
+
+  int NbParam_ = (int)NbParam;
+  for(int ir=0;ir<degree;ir++)
+  {
+    for(int it=0;it<degree;it++)
+    {
+      int ind=(cr+sr+ir)*Ncb+(ct+st+it);
+      Prt[ind] += Br[ir]*Bt[it];
+
+      double v1=Br[ir]*dBt[it];
+      double *pdPrt=&dPrt[ind*NbParam_];
+      for(int ip=0;ip<NbParam_;ip++)
+        pdPrt[ip] -= v1*val[ip];
+    }
+  }
+}
+
 void vpTemplateTrackerMIBSpline::PutTotPVBsplinePrtTout(double *PrtTout, int &cr, double &er, int &ct, double &et,int &Nc, unsigned int &NbParam, int &degree)
 {
   switch(degree)
@@ -0,0 +1,123 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the mutual information template trackers on synthetic images.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testTemplateTrackerMI.cpp
+
+  \brief Test that the mutual information template trackers recover a known
+  motion between two synthetic images with different lighting.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <visp3/tt/vpTemplateTrackerWarpAffine.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomographySL3.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIESM.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIForwardCompositional.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIInverseCompositional.h>
+
+#include "vpTemplateTrackerTexture.h"
+
+int main()
+{
+  try {
+    // Reference and current images related by a small affine motion and a lighting change
+    vpImage<unsigned char> I0(240, 320), I1(240, 320);
+    const double A0[2][2] = { { 1, 0 }, { 0, 1 } }, t0[2] = { 0, 0 };
+    const double A[2][2] = { { 1.02, 0.015 }, { -0.01, 0.99 } }, t[2] = { 2.5, -1.5 };
+    vpTemplateTrackerTexture::render(A0, t0, I0);
+    vpTemplateTrackerTexture::render(A, t, I1, 0.8, 30.);
+
+    {
+      vpTemplateTrackerWarpAffine warp;
+      vpTemplateTrackerMIInverseCompositional tracker(&warp);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t, "MI inverse compositional, affine", 0.5)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      // With many bins, the histograms are large and at most two threads fill their own histograms
+      vpTemplateTrackerWarpHomography warp;
+      vpTemplateTrackerMIInverseCompositional tracker(&warp);
+      tracker.setNc(48);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t, "MI inverse compositional, homography, 48 bins",
+                                                  0.5)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      vpTemplateTrackerWarpHomography warp;
+      vpTemplateTrackerMIInverseCompositional tracker(&warp);
+      tracker.setBspline(vpTemplateTrackerMI::BSPLINE_FOURTH_ORDER);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t,
+                                                  "MI inverse compositional, homography, fourth order B-spline", 0.5)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      vpTemplateTrackerWarpAffine warp;
+      vpTemplateTrackerMIForwardAdditional tracker(&warp);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t, "MI forward additional, affine", 0.5)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      vpTemplateTrackerWarpAffine warp;
+      vpTemplateTrackerMIForwardCompositional tracker(&warp);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t, "MI forward compositional, affine", 0.5)) {
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      vpTemplateTrackerWarpHomographySL3 warp;
+      vpTemplateTrackerMIESM tracker(&warp);
+      if (!vpTemplateTrackerTexture::checkTracker(tracker, I0, I1, A, t, "MI ESM, SL3 homography", 0.5)) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << "testTemplateTrackerMI is ok" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch(const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
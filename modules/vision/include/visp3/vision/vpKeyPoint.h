@@ -70,6 +70,7 @@
 
 #include <opencv2/features2d/features2d.hpp>
 #include <opencv2/calib3d/calib3d.hpp>
+#include <opencv2/flann/flann.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
 #if defined(VISP_HAVE_OPENCV_XFEATURES2D) // OpenCV >= 3.0.0
@@ -213,6 +214,12 @@ int main()
 }
   \endcode
 
+  For large reference databases, the matching of the query descriptors against all the train descriptors
+  can be replaced by an approximate nearest neighbour search with setUseNearestNeighbourIndex(). The index
+  (a hierarchical clustering tree for binary descriptors, a randomized kd-forest for floating point
+  descriptors) is built once when the reference is built or loaded, and is saved alongside the learning data
+  by saveLearningData().
+
   This class is also described in \ref tutorial-matching.
 */
 class VISP_EXPORT vpKeyPoint : public vpBasicKeyPoint {
@@ -889,6 +896,28 @@ public:
     }
   }
 
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  /*!
+    Set the number of leaves to visit when searching the approximate nearest neighbour index.
+    Higher values give better matches but take more time.
+
+    \param checks : Number of leaves to visit (default is 64).
+  */
+  inline void setNearestNeighbourIndexChecks(const int checks) {
+    m_nearestNeighbourIndexChecks = checks;
+  }
+
+  /*!
+    Set the number of trees of the approximate nearest neighbour index. It must be set before
+    building the reference or loading the learning data.
+
+    \param trees : Number of randomized trees (default is 4).
+  */
+  inline void setNearestNeighbourIndexTrees(const int trees) {
+    m_nearestNeighbourIndexTrees = trees;
+  }
+#endif
+
   /*!
     Set the percentage value for defining the cardinality of the consensus group.
 
@@ -989,6 +1018,10 @@ public:
     m_useMatchTrainToQuery = useMatchTrainToQuery;
   }
 
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  void setUseNearestNeighbourIndex(const bool useIndex);
+#endif
+
   /*!
     Set the flag to choose between a percentage value of inliers for the cardinality of the consensus group
     or a minimum number.
@@ -1072,6 +1105,14 @@ private:
   double m_matchingRatioThreshold;
   //! Elapsed time to do the matching.
   double m_matchingTime;
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  //! Approximate nearest neighbour index built on the train descriptors.
+  cv::Ptr<cv::flann::Index> m_nearestNeighbourIndex;
+  //! Number of leaves to visit when searching the approximate nearest neighbour index.
+  int m_nearestNeighbourIndexChecks;
+  //! Number of randomized trees of the approximate nearest neighbour index.
+  int m_nearestNeighbourIndexTrees;
+#endif
   //! List of pairs between the keypoint and the 3D point after the Ransac.
   std::vector<std::pair<cv::KeyPoint, cv::Point3f> > m_matchRansacKeyPointsToPoints;
   //! Maximum number of iterations for the Ransac method.
@@ -1117,6 +1158,10 @@ private:
 #endif
   //! Flag set if a percentage value is used to determine the number of inliers for the Ransac method.
   bool m_useConsensusPercentage;
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  //! Flag set if the approximate nearest neighbour index must be used for the matching.
+  bool m_useNearestNeighbourIndex;
+#endif
   //! Flag set if a knn matching method must be used.
   bool m_useKnn;
   //! Flag set if we want to match the train keypoints to the query keypoints, useful when there is only one train image
@@ -1145,6 +1190,11 @@ private:
 
   void initFeatureNames();
 
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  void initNearestNeighbourIndex(const std::string &indexFilename="");
+  void matchNearestNeighbourIndex(const cv::Mat &queryDescriptors, std::vector<cv::DMatch> &matches);
+#endif
+
   inline size_t myKeypointHash(const cv::KeyPoint &kp) {
     size_t _Val = 2166136261U, scale = 16777619U;
     Cv32suf u;
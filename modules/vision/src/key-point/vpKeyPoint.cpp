@@ -308,6 +308,9 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
     m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
     m_matcher(), m_matcherName(matcherName),
     m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+    m_nearestNeighbourIndex(), m_nearestNeighbourIndexChecks(64), m_nearestNeighbourIndexTrees(4),
+#endif
     m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100), m_objectFilteredPoints(),
     m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacInliers(), m_ransacOutliers(), m_ransacReprojectionError(6.0),
@@ -317,6 +320,9 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
     m_useBruteForceCrossCheck(true),
 #endif
     m_useConsensusPercentage(false),
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+    m_useNearestNeighbourIndex(false),
+#endif
     m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
@@ -343,6 +349,9 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
     m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
     m_matcher(), m_matcherName(matcherName),
     m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+    m_nearestNeighbourIndex(), m_nearestNeighbourIndexChecks(64), m_nearestNeighbourIndexTrees(4),
+#endif
     m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100), m_objectFilteredPoints(),
     m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacInliers(), m_ransacOutliers(), m_ransacReprojectionError(6.0),
@@ -352,6 +361,9 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
     m_useBruteForceCrossCheck(true),
 #endif
     m_useConsensusPercentage(false),
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+    m_useNearestNeighbourIndex(false),
+#endif
     m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
@@ -378,6 +390,9 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
     m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
     m_matcher(),
     m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+    m_nearestNeighbourIndex(), m_nearestNeighbourIndexChecks(64), m_nearestNeighbourIndexTrees(4),
+#endif
     m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100), m_objectFilteredPoints(),
     m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacInliers(), m_ransacOutliers(), m_ransacReprojectionError(6.0),
@@ -387,6 +402,9 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
     m_useBruteForceCrossCheck(true),
 #endif
     m_useConsensusPercentage(false),
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+    m_useNearestNeighbourIndex(false),
+#endif
     m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
@@ -537,6 +555,9 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I,
   //Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  initNearestNeighbourIndex();
+#endif
 
   return static_cast<unsigned int>(m_trainKeyPoints.size());
 }
@@ -638,6 +659,9 @@ void vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const std::vect
   //Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  initNearestNeighbourIndex();
+#endif
 
   _reference_computed = true;
 }
@@ -2338,6 +2362,73 @@ void vpKeyPoint::initMatcher(const std::string &matcherName) {
   }
 }
 
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+namespace {
+  //Empty approximate nearest neighbour index, cv::makePtr() is not available before OpenCV 3
+  cv::Ptr<cv::flann::Index> createNearestNeighbourIndex() {
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+    return cv::makePtr<cv::flann::Index>();
+#else
+    return cv::Ptr<cv::flann::Index>(new cv::flann::Index());
+#endif
+  }
+}
+
+/*!
+   Initialize the approximate nearest neighbour index on the train descriptors. The index is loaded from
+   the file saved by saveLearningData() when it corresponds to the train descriptors, otherwise it is built:
+   a hierarchical clustering tree with the Hamming distance for binary descriptors, a randomized kd-forest with
+   the L2 distance for floating point descriptors.
+
+   \param indexFilename : Path of the saved index (can be empty).
+ */
+void vpKeyPoint::initNearestNeighbourIndex(const std::string &indexFilename) {
+  m_nearestNeighbourIndex = cv::Ptr<cv::flann::Index>();
+  if(!m_useNearestNeighbourIndex || m_trainDescriptors.empty()) {
+    return;
+  }
+
+  if(m_trainDescriptors.type() != CV_8U && m_trainDescriptors.type() != CV_32F) {
+    throw vpException(vpException::badValue, "The nearest neighbour index requires binary (CV_8U) or "
+                      "floating point (CV_32F) descriptors !");
+  }
+
+  //The index refers to the train descriptors without copying them, and requires continuous data
+  if(!m_trainDescriptors.isContinuous()) {
+    m_trainDescriptors = m_trainDescriptors.clone();
+  }
+
+  if(!indexFilename.empty() && vpIoTools::checkFilename(indexFilename)) {
+    cv::Ptr<cv::flann::Index> index = createNearestNeighbourIndex();
+    bool loaded = false;
+    try {
+      //Returns false if the index was saved for other descriptors, throws if the saved index type cannot
+      //be loaded by this OpenCV version
+      loaded = index->load(m_trainDescriptors, indexFilename);
+    } catch(const std::exception &e) {
+      std::cerr << "Cannot load the nearest neighbour index " << indexFilename << ": " << e.what() << std::endl;
+    }
+
+    if(loaded) {
+      m_nearestNeighbourIndex = index;
+      return;
+    }
+  }
+
+  //A failed load may leave the index partially initialized, build a new one
+  cv::Ptr<cv::flann::Index> index = createNearestNeighbourIndex();
+  if(m_trainDescriptors.type() == CV_8U) {
+    index->build(m_trainDescriptors, cv::flann::HierarchicalClusteringIndexParams(32, cvflann::FLANN_CENTERS_RANDOM,
+                                                                                  m_nearestNeighbourIndexTrees),
+                 cvflann::FLANN_DIST_HAMMING);
+  } else {
+    index->build(m_trainDescriptors, cv::flann::KDTreeIndexParams(m_nearestNeighbourIndexTrees),
+                 cvflann::FLANN_DIST_L2);
+  }
+  m_nearestNeighbourIndex = index;
+}
+#endif
+
 /*!
    Insert a reference image and a current image side-by-side.
 
@@ -2492,7 +2583,8 @@ void vpKeyPoint::loadConfigFile(const std::string &configFile) {
 #endif
 
 /*!
-   Load learning data saved on disk.
+   Load learning data saved on disk. If the approximate nearest neighbour index is used, the index saved
+   alongside the learning data is reloaded, otherwise it is built.
 
    \param filename : Path of the learning file.
    \param binaryMode : If true, the learning file is in a binary mode, otherwise it is in XML mode.
@@ -2929,6 +3021,10 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
   //Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  //The index saved with the learning data is not valid anymore when the data are appended
+  initNearestNeighbourIndex(append ? "" : filename + ".index");
+#endif
 
   //Set _reference_computed to true as we load a learning file
   _reference_computed = true;
@@ -2938,7 +3034,9 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
 }
 
 /*!
-   Match keypoints based on distance between their descriptors.
+   Match keypoints based on distance between their descriptors. When the approximate nearest neighbour
+   index is used (see setUseNearestNeighbourIndex()), the query descriptors are matched to the train
+   descriptors with the index instead of the matcher.
 
    \param trainDescriptors : Train descriptors (or reference descriptors).
    \param queryDescriptors : Query descriptors.
@@ -2971,9 +3069,16 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     } else {
       //Match query descriptors to train descriptors
-      m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
-      matches.resize(m_knnMatches.size());
-      std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+      if(!m_nearestNeighbourIndex.empty()) {
+        matchNearestNeighbourIndex(queryDescriptors, matches);
+      } else
+#endif
+      {
+        m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+        matches.resize(m_knnMatches.size());
+        std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
+      }
     }
   } else {
     matches.clear();
@@ -2989,12 +3094,62 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       }
     } else {
       //Match query descriptors to train descriptors
-      m_matcher->match(queryDescriptors, matches);
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+      if(!m_nearestNeighbourIndex.empty()) {
+        matchNearestNeighbourIndex(queryDescriptors, matches);
+      } else
+#endif
+      {
+        m_matcher->match(queryDescriptors, matches);
+      }
     }
   }
   elapsedTime = vpTime::measureTimeMs() - t;
 }
 
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+/*!
+   Match the query descriptors to the train descriptors with the approximate nearest neighbour index.
+   When a knn filtering method is used, the two nearest neighbors are also stored in m_knnMatches. As with
+   cv::DescriptorMatcher::knnMatch(), only one neighbor is stored when there is a single train descriptor, and
+   the ratio filtering rejects the match.
+
+   \param queryDescriptors : Query descriptors.
+   \param matches : Output list of matches with the nearest neighbor of each query descriptor.
+ */
+void vpKeyPoint::matchNearestNeighbourIndex(const cv::Mat &queryDescriptors, std::vector<cv::DMatch> &matches) {
+  matches.clear();
+  if(queryDescriptors.empty()) {
+    return;
+  }
+
+  //knnSearch() asserts that knn does not exceed the number of train descriptors
+  int knn = (std::min)(m_useKnn ? 2 : 1, m_trainDescriptors.rows);
+  cv::Mat indices, dists;
+  m_nearestNeighbourIndex->knnSearch(queryDescriptors, indices, dists, knn,
+                                     cv::flann::SearchParams(m_nearestNeighbourIndexChecks));
+
+  for(int i = 0; i < indices.rows; i++) {
+    std::vector<cv::DMatch> knnMatches;
+    for(int k = 0; k < knn; k++) {
+      int trainIdx = indices.at<int>(i, k);
+      if(trainIdx >= 0) {
+        //Hamming distances are integers, L2 distances are squared
+        float distance = dists.type() == CV_32S ? (float) dists.at<int>(i, k) : std::sqrt(dists.at<float>(i, k));
+        knnMatches.push_back(cv::DMatch(i, trainIdx, 0, distance));
+      }
+    }
+
+    if(!knnMatches.empty()) {
+      matches.push_back(knnMatches.front());
+      if(m_useKnn) {
+        m_knnMatches.push_back(knnMatches);
+      }
+    }
+  }
+}
+#endif
+
 /*!
    Match keypoints detected in the image with those built in the reference list.
 
@@ -3661,6 +3816,10 @@ void vpKeyPoint::reset() {
   m_useBruteForceCrossCheck = true;
 #endif
   m_useConsensusPercentage = false;
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  m_nearestNeighbourIndex = cv::Ptr<cv::flann::Index>(); m_nearestNeighbourIndexChecks = 64;
+  m_nearestNeighbourIndexTrees = 4; m_useNearestNeighbourIndex = false;
+#endif
   m_useKnn = true; //as m_filterType == ratioDistanceThreshold
   m_useMatchTrainToQuery = false; m_useRansacVVS = true; m_useSingleMatchFilter = true;
 
@@ -4104,7 +4263,34 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
     std::cerr << "Error: libxml2 is required !" << std::endl;
 #endif
   }
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+  //Save the nearest neighbour index alongside the learning data, a previous index would not match them
+  std::string indexFilename = filename + ".index";
+  if(!m_nearestNeighbourIndex.empty()) {
+    m_nearestNeighbourIndex->save(indexFilename);
+  } else if(vpIoTools::checkFilename(indexFilename)) {
+    vpIoTools::remove(indexFilename);
+  }
+#endif
+}
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+/*!
+   Set if the approximate nearest neighbour index must be used to match the query descriptors to the train
+   descriptors instead of the matcher. This is much faster than a brute-force matching with large reference
+   databases, at the cost of some missed nearest neighbors (see setNearestNeighbourIndexChecks()).
+   The index is built on the current train descriptors and rebuilt each time the reference is built or the
+   learning data are loaded. It is saved by saveLearningData() in a file with the ".index" extension appended
+   to the learning file name, and reloaded by loadLearningData() instead of being built again.
+
+   \param useIndex : True to use the approximate nearest neighbour index.
+ */
+void vpKeyPoint::setUseNearestNeighbourIndex(const bool useIndex) {
+  m_useNearestNeighbourIndex = useIndex;
+  initNearestNeighbourIndex();
 }
+#endif
 
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
 //From OpenCV 2.4.11 source code.
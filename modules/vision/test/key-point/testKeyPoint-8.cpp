@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the approximate nearest neighbour index of vpKeyPoint class.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testKeyPoint-8.cpp
+
+  \brief Test that the approximate nearest neighbour index of vpKeyPoint finds the same matches
+  than the brute-force matcher for binary and floating point descriptors, also with a single train
+  descriptor, and that it is saved and reloaded with the learning data.
+*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020400)
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/vision/vpKeyPoint.h>
+
+namespace {
+  // Reference data with random descriptors, and query descriptors close to the first train descriptors
+  void createData(int type, int nbTrain, int nbQuery, cv::Mat &trainDescriptors, cv::Mat &queryDescriptors,
+                  std::vector<cv::KeyPoint> &trainKeyPoints, std::vector<cv::Point3f> &trainPoints)
+  {
+    cv::RNG rng(12345);
+    const int nbCols = type == CV_8U ? 32 : 64;
+    trainDescriptors.create(nbTrain, nbCols, type);
+    if (type == CV_8U) {
+      rng.fill(trainDescriptors, cv::RNG::UNIFORM, 0, 256);
+    } else {
+      rng.fill(trainDescriptors, cv::RNG::UNIFORM, 0.f, 1.f);
+    }
+
+    queryDescriptors = trainDescriptors.rowRange(0, nbQuery).clone();
+    for (int i = 0; i < nbQuery; i++) {
+      for (int k = 0; k < 4; k++) {
+        int j = rng.uniform(0, nbCols);
+        if (type == CV_8U) {
+          // Flip one bit
+          queryDescriptors.at<unsigned char>(i, j) ^= (unsigned char)(1 << rng.uniform(0, 8));
+        } else {
+          queryDescriptors.at<float>(i, j) += rng.uniform(-0.05f, 0.05f);
+        }
+      }
+    }
+
+    trainKeyPoints.clear();
+    trainPoints.clear();
+    for (int i = 0; i < nbTrain; i++) {
+      trainKeyPoints.push_back(cv::KeyPoint((float)(i % 640), (float)(i / 640), 7.f));
+      trainPoints.push_back(cv::Point3f((float)i, 0.f, 1.f));
+    }
+  }
+
+  // Percentage of the query descriptors matched to the same train descriptor
+  double matchingAgreement(const std::vector<cv::DMatch> &matches, const std::vector<cv::DMatch> &reference,
+                           int nbQuery)
+  {
+    std::vector<int> referenceTrainIdx((size_t)nbQuery, -1);
+    for (size_t i = 0; i < reference.size(); i++) {
+      referenceTrainIdx[(size_t)reference[i].queryIdx] = reference[i].trainIdx;
+    }
+
+    int nbSame = 0;
+    for (size_t i = 0; i < matches.size(); i++) {
+      if (referenceTrainIdx[(size_t)matches[i].queryIdx] == matches[i].trainIdx) {
+        nbSame++;
+      }
+    }
+    return 100.0 * nbSame / nbQuery;
+  }
+
+  bool checkIndex(int type, const std::string &matcherName, const std::string &directory)
+  {
+    cv::Mat trainDescriptors, queryDescriptors;
+    std::vector<cv::KeyPoint> trainKeyPoints;
+    std::vector<cv::Point3f> trainPoints;
+    const int nbQuery = 500;
+    createData(type, 20000, nbQuery, trainDescriptors, queryDescriptors, trainKeyPoints, trainPoints);
+    const std::string name = type == CV_8U ? "binary" : "floating point";
+
+    vpImage<unsigned char> I(480, 640, 0);
+    vpKeyPoint keypoints("ORB", "ORB", matcherName, vpKeyPoint::ratioDistanceThreshold);
+    keypoints.buildReference(I, trainKeyPoints, trainDescriptors, trainPoints);
+
+    std::vector<cv::DMatch> bruteForceMatches, indexMatches, loadedIndexMatches;
+    double bruteForceTime = 0, indexTime = 0, elapsedTime = 0;
+    keypoints.match(trainDescriptors, queryDescriptors, bruteForceMatches, bruteForceTime);
+
+    keypoints.setUseNearestNeighbourIndex(true);
+    keypoints.match(trainDescriptors, queryDescriptors, indexMatches, indexTime);
+
+    double agreement = matchingAgreement(indexMatches, bruteForceMatches, nbQuery);
+    std::cout << name << " descriptors: " << agreement << "% of the brute-force matches, " << indexTime
+              << " ms instead of " << bruteForceTime << " ms" << std::endl;
+    if (agreement < 90.0) {
+      std::cerr << "Bad nearest neighbour index with " << name << " descriptors" << std::endl;
+      return false;
+    }
+
+    // The index saved with the learning data is reloaded instead of being built again
+    std::string filename = vpIoTools::createFilePath(directory, "learning_data.bin");
+    keypoints.saveLearningData(filename, true, false);
+    if (!vpIoTools::checkFilename(filename + ".index")) {
+      std::cerr << "The nearest neighbour index is not saved" << std::endl;
+      return false;
+    }
+
+    vpKeyPoint keypointsLoaded("ORB", "ORB", matcherName, vpKeyPoint::ratioDistanceThreshold);
+    keypointsLoaded.setUseNearestNeighbourIndex(true);
+    keypointsLoaded.loadLearningData(filename, true);
+    keypointsLoaded.match(keypointsLoaded.getTrainDescriptors(), queryDescriptors, loadedIndexMatches, elapsedTime);
+
+    bool sameMatches = loadedIndexMatches.size() == indexMatches.size();
+    for (size_t i = 0; i < indexMatches.size() && sameMatches; i++) {
+      sameMatches = loadedIndexMatches[i].queryIdx == indexMatches[i].queryIdx &&
+                    loadedIndexMatches[i].trainIdx == indexMatches[i].trainIdx;
+    }
+    if (!sameMatches) {
+      std::cerr << "The loaded nearest neighbour index is not the saved one" << std::endl;
+      return false;
+    }
+
+    // Without the index, the learning data are saved without it
+    keypoints.setUseNearestNeighbourIndex(false);
+    keypoints.saveLearningData(filename, true, false);
+    if (vpIoTools::checkFilename(filename + ".index")) {
+      std::cerr << "A stale nearest neighbour index is kept" << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+
+  // With a single train descriptor, the knn filtering gets a single neighbor as with the brute-force matcher
+  bool checkSingleTrainDescriptor(int type, const std::string &matcherName)
+  {
+    cv::Mat trainDescriptors, queryDescriptors;
+    std::vector<cv::KeyPoint> trainKeyPoints;
+    std::vector<cv::Point3f> trainPoints;
+    const int nbQuery = 10;
+    createData(type, nbQuery, nbQuery, trainDescriptors, queryDescriptors, trainKeyPoints, trainPoints);
+    trainDescriptors = trainDescriptors.rowRange(0, 1).clone();
+    trainKeyPoints.resize(1);
+    trainPoints.resize(1);
+
+    vpImage<unsigned char> I(480, 640, 0);
+    vpKeyPoint keypoints("ORB", "ORB", matcherName, vpKeyPoint::ratioDistanceThreshold);
+    keypoints.buildReference(I, trainKeyPoints, trainDescriptors, trainPoints);
+
+    std::vector<cv::DMatch> bruteForceMatches, indexMatches;
+    double elapsedTime = 0;
+    keypoints.match(trainDescriptors, queryDescriptors, bruteForceMatches, elapsedTime);
+    keypoints.setUseNearestNeighbourIndex(true);
+    keypoints.match(trainDescriptors, queryDescriptors, indexMatches, elapsedTime);
+
+    bool sameMatches = indexMatches.size() == bruteForceMatches.size() && indexMatches.size() == (size_t)nbQuery;
+    for (size_t i = 0; i < indexMatches.size() && sameMatches; i++) {
+      sameMatches = indexMatches[i].queryIdx == bruteForceMatches[i].queryIdx && indexMatches[i].trainIdx == 0 &&
+                    bruteForceMatches[i].trainIdx == 0;
+    }
+    if (!sameMatches) {
+      std::cerr << "Bad nearest neighbour index matches with a single train descriptor" << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    std::string directory = vpIoTools::createFilePath(
+#if defined(_WIN32)
+          "C:/temp",
+#else
+          "/tmp",
+#endif
+          "testKeyPoint-8");
+    vpIoTools::makeDirectory(directory);
+
+    if (!checkIndex(CV_8U, "BruteForce-Hamming", directory) || !checkIndex(CV_32F, "BruteForce", directory)) {
+      return EXIT_FAILURE;
+    }
+    if (!checkSingleTrainDescriptor(CV_8U, "BruteForce-Hamming") || !checkSingleTrainDescriptor(CV_32F, "BruteForce")) {
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+  } catch(const vpException &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testKeyPoint-8 is ok !" << std::endl;
+  return EXIT_SUCCESS;
+}
+#else
+int main() {
+  std::cerr << "You need OpenCV library." << std::endl;
+
+  return 0;
+}
+
+#endif